@@ -0,0 +1,161 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Benchmark of the ASCII readers: stdio reader (fscanf per
+ * value) versus chunked reader (_MMG5_loadMeshAscii/_MMG5_loadMetAscii).
+ * A structured mesh of n^3 vertices (6 tetra per cube) and a scalar
+ * solution are written in the current directory, read with both readers,
+ * and the read data are compared.
+ *
+ * Usage: bench_asciiload [n] [nthreads]
+ */
+
+#include "mmg3d.h"
+#include "../grid.h"
+
+/* write the structured mesh and a solution */
+static long long writeFiles(int n,const char *meshname,const char *solname) {
+    FILE      *out;
+    long long  siz;
+    MMG5_int   v[4];
+    double     c[3];
+    int        i,j,k,l;
+
+    if ( !(out = fopen(meshname,"w")) )  exit(EXIT_FAILURE);
+    fprintf(out,"MeshVersionFormatted 2\n\nDimension 3\n\nVertices\n%d\n",GRID_NP(n));
+    for (k=0; k<n; k++)
+        for (j=0; j<n; j++)
+            for (i=0; i<n; i++) {
+                gridCoor(n,i,j,k,1.e-3,c);
+                fprintf(out,"%.15lg %.15lg %.15lg %d\n",c[0],c[1],c[2],(i+j+k)%3);
+            }
+
+    /* corners of the cube */
+    fprintf(out,"\nCorners\n8\n");
+    for (l=0; l<8; l++)
+        fprintf(out,"%d\n",1 + (l&1)*(n-1) + n*(((l>>1)&1)*(n-1) + n*((l>>2)&1)*(n-1)));
+
+    fprintf(out,"\nTetrahedra\n%d\n",GRID_NE(n));
+    for (k=0; k<n-1; k++)
+        for (j=0; j<n-1; j++)
+            for (i=0; i<n-1; i++)
+                for (l=0; l<6; l++) {
+                    gridTetra(n,i,j,k,l,v);
+                    fprintf(out,"%" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %"
+                            MMG5_PRId " %d\n",v[0],v[1],v[2],v[3],l);
+                }
+    fprintf(out,"\nEnd\n");
+    siz = ftell(out);
+    fclose(out);
+
+    if ( !(out = fopen(solname,"w")) )  exit(EXIT_FAILURE);
+    fprintf(out,"MeshVersionFormatted 2\n\nDimension 3\n\nSolAtVertices\n%d\n1 1\n",n*n*n);
+    for (k=0; k<n*n*n; k++)
+        fprintf(out,"%.15lg\n",0.1+1.e-2*sin(0.1*k));
+    fprintf(out,"\nEnd\n");
+    siz += ftell(out);
+    fclose(out);
+
+    return(siz);
+}
+
+/* read the files with the stdio (fast=0) or chunked (fast=1) reader */
+static double readFiles(MMG5_pMesh *mesh,MMG5_pSol *met,int nthr,int fast,
+                        char *meshname,char *solname) {
+    mytime  ctim;
+
+    *mesh = NULL;
+    *met  = NULL;
+    MMG5_Init_mesh(mesh,met);
+    MMG5_Set_iparameter(*mesh,*met,MMG5_IPARAM_verbose,-1);
+#ifndef PATTERN
+    MMG5_Set_iparameter(*mesh,*met,MMG5_IPARAM_threads,nthr);
+#endif
+    (*mesh)->memMax = 16LL*1024*1024*1024;
+    MMG5_Set_inputMeshName(*mesh,meshname);
+    MMG5_Set_inputSolName(*mesh,*met,solname);
+
+    chrono(RESET,&ctim);
+    chrono(ON,&ctim);
+    if ( !_MMG5_loadMesh(*mesh,fast) )  exit(EXIT_FAILURE);
+    if ( _MMG5_loadMet(*mesh,*met,fast) != 1 )  exit(EXIT_FAILURE);
+    chrono(OFF,&ctim);
+
+    return(ctim.gdif);
+}
+
+int main(int argc,char *argv[]) {
+    MMG5_pMesh      mesh[2];
+    MMG5_pSol       met[2];
+    MMG5_pPoint     p0,p1;
+    MMG5_pTetra     pt0,pt1;
+    double          t[2];
+    long long       siz;
+    int             n,nthr,k,i,ndiff;
+    char            meshname[] = "bench_asciiload.mesh";
+    char            solname[]  = "bench_asciiload.sol";
+
+    n    = argc > 1 ? atoi(argv[1]) : 64;
+    nthr = argc > 2 ? atoi(argv[2]) : 1;
+    if ( n < 2 )  n = 2;
+    if ( nthr < 1 )  nthr = 1;
+
+    siz = writeFiles(n,meshname,solname);
+    fprintf(stdout,"  -- ASCII READER BENCHMARK: %d vertices, %d tetra, %.1f MB,"
+            " %d thread(s)\n",n*n*n,6*(n-1)*(n-1)*(n-1),siz/1048576.,nthr);
+
+    t[0] = readFiles(&mesh[0],&met[0],nthr,0,meshname,solname);
+    t[1] = readFiles(&mesh[1],&met[1],nthr,1,meshname,solname);
+
+    /* compare the read data */
+    ndiff = 0;
+    if ( mesh[0]->np != mesh[1]->np || mesh[0]->ne != mesh[1]->ne )  ndiff++;
+    for (k=1; !ndiff && k<=mesh[0]->np; k++) {
+        p0 = &mesh[0]->point[k];
+        p1 = &mesh[1]->point[k];
+        if ( memcmp(p0->c,p1->c,3*sizeof(double)) || p0->ref != p1->ref
+             || p0->tag != p1->tag || met[0]->m[k] != met[1]->m[k] )  ndiff++;
+    }
+    for (k=1; !ndiff && k<=mesh[0]->ne; k++) {
+        pt0 = &mesh[0]->tetra[k];
+        pt1 = &mesh[1]->tetra[k];
+        for (i=0; i<4; i++)
+            if ( pt0->v[i] != pt1->v[i] )  ndiff++;
+        if ( pt0->ref != pt1->ref || pt0->qual != pt1->qual )  ndiff++;
+    }
+
+    fprintf(stdout,"     %-16s %10s %10s\n","reader","time (s)","MB/s");
+    fprintf(stdout,"     %-16s %10.3f %10.1f\n","stdio",t[0],siz/1048576./t[0]);
+    fprintf(stdout,"     %-16s %10.3f %10.1f\n","chunked",t[1],siz/1048576./t[1]);
+
+    for (k=0; k<2; k++)
+        MMG5_Free_all(mesh[k],met[k]);
+    remove(meshname);
+    remove(solname);
+
+    if ( ndiff ) {
+        fprintf(stdout,"  ## Error: readers disagree.\n");
+        return(EXIT_FAILURE);
+    }
+    return(EXIT_SUCCESS);
+}
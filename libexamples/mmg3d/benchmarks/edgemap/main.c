@@ -0,0 +1,157 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Micro-benchmark of the edge hash tables: chained table
+ * (_MMG5_Hash) versus open-addressing table (_MMG5_EdgeMap). The edges of a
+ * structured mesh of n^3 vertices (6 tetra per cube) are stored, searched
+ * and removed as in MMG5_searchlen.
+ *
+ * Usage: bench_edgemap [n]
+ */
+
+#include <time.h>
+#include "mmg3d.h"
+#include "../grid.h"
+
+/* tetra list of the structured mesh */
+static MMG5_int *buildTetra(int n,int *ne) {
+    MMG5_int  *tet;
+    int        i,j,k,l,m;
+
+    *ne = GRID_NE(n);
+    tet = (MMG5_int*)malloc(4*(*ne)*sizeof(MMG5_int));
+    if ( !tet )  exit(EXIT_FAILURE);
+
+    m = 0;
+    for (k=0; k<n-1; k++)
+        for (j=0; j<n-1; j++)
+            for (i=0; i<n-1; i++)
+                for (l=0; l<6; l++, m+=4)
+                    gridTetra(n,i,j,k,l,&tet[m]);
+    return(tet);
+}
+
+static double elapsed(clock_t t0) {
+    return( (double)(clock()-t0) / CLOCKS_PER_SEC );
+}
+
+int main(int argc,char *argv[]) {
+    MMG5_pMesh      mesh;
+    MMG5_pSol       met;
+    _MMG5_Hash      hash;
+    _MMG5_EdgeMap   map;
+    clock_t         t0;
+    double          tadd[2],tget[2],tpop[2];
+    long long       mem0,mem[2];
+    MMG5_int       *tet,np,nq;
+    int             n,ne,k,ia,nget[2],npop[2];
+
+    n = argc > 1 ? atoi(argv[1]) : 64;
+    if ( n < 2 )  n = 2;
+
+    mesh = NULL;
+    met  = NULL;
+    MMG5_Init_mesh(&mesh,&met);
+    mesh->memMax = 16LL*1024*1024*1024;
+    mesh->np     = n*n*n;
+    mem0         = mesh->memCur;
+
+    tet = buildTetra(n,&ne);
+    fprintf(stdout,"  -- EDGE HASH BENCHMARK: %" MMG5_PRId " vertices, %d tetra\n",mesh->np,ne);
+
+    /* chained table */
+    t0 = clock();
+    if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) )  exit(EXIT_FAILURE);
+    for (k=0; k<ne; k++)
+        for (ia=0; ia<6; ia++) {
+            np = tet[4*k+_MMG5_iare[ia][0]];
+            nq = tet[4*k+_MMG5_iare[ia][1]];
+            if ( !_MMG5_hashEdge(mesh,&hash,np,nq,k+1) )  exit(EXIT_FAILURE);
+        }
+    tadd[0] = elapsed(t0);
+    mem[0]  = mesh->memCur-mem0;
+
+    t0 = clock();
+    nget[0] = 0;
+    for (k=0; k<ne; k++)
+        for (ia=0; ia<6; ia++)
+            if ( _MMG5_hashGet(&hash,tet[4*k+_MMG5_iare[ia][0]],
+                               tet[4*k+_MMG5_iare[ia][1]]) )  nget[0]++;
+    tget[0] = elapsed(t0);
+
+    t0 = clock();
+    npop[0] = 0;
+    for (k=0; k<ne; k++)
+        for (ia=0; ia<6; ia++)
+            npop[0] += _MMG5_hashPop(&hash,tet[4*k+_MMG5_iare[ia][0]],
+                                     tet[4*k+_MMG5_iare[ia][1]]);
+    tpop[0] = elapsed(t0);
+    _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+
+    /* open-addressing table */
+    t0 = clock();
+    if ( !_MMG5_edgeMapNew(mesh,&map,7*mesh->np) )  exit(EXIT_FAILURE);
+    for (k=0; k<ne; k++)
+        for (ia=0; ia<6; ia++) {
+            np = tet[4*k+_MMG5_iare[ia][0]];
+            nq = tet[4*k+_MMG5_iare[ia][1]];
+            if ( !_MMG5_edgeMapAdd(mesh,&map,np,nq,k+1) )  exit(EXIT_FAILURE);
+        }
+    tadd[1] = elapsed(t0);
+    mem[1]  = mesh->memCur-mem0;
+
+    t0 = clock();
+    nget[1] = 0;
+    for (k=0; k<ne; k++)
+        for (ia=0; ia<6; ia++)
+            if ( _MMG5_edgeMapGet(&map,tet[4*k+_MMG5_iare[ia][0]],
+                                  tet[4*k+_MMG5_iare[ia][1]]) )  nget[1]++;
+    tget[1] = elapsed(t0);
+
+    t0 = clock();
+    npop[1] = 0;
+    for (k=0; k<ne; k++)
+        for (ia=0; ia<6; ia++)
+            npop[1] += _MMG5_edgeMapPop(&map,tet[4*k+_MMG5_iare[ia][0]],
+                                        tet[4*k+_MMG5_iare[ia][1]]);
+    tpop[1] = elapsed(t0);
+    _MMG5_edgeMapFree(mesh,&map);
+
+    fprintf(stdout,"     %-16s %10s %10s %10s %12s\n","table","add (s)",
+            "get (s)","pop (s)","memory (MB)");
+    fprintf(stdout,"     %-16s %10.3f %10.3f %10.3f %12.1f\n","_MMG5_Hash",
+            tadd[0],tget[0],tpop[0],mem[0]/1048576.);
+    fprintf(stdout,"     %-16s %10.3f %10.3f %10.3f %12.1f\n","_MMG5_EdgeMap",
+            tadd[1],tget[1],tpop[1],mem[1]/1048576.);
+
+    free(tet);
+    mesh->np = 0;
+    MMG5_Free_all(mesh,met);
+
+    if ( nget[0] != nget[1] || npop[0] != npop[1] ) {
+        fprintf(stdout,"  ## Error: tables disagree (%d/%d found, %d/%d removed)\n",
+                nget[0],nget[1],npop[0],npop[1]);
+        return(EXIT_FAILURE);
+    }
+    return(EXIT_SUCCESS);
+}
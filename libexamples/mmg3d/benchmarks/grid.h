@@ -0,0 +1,94 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Structured mesh of the unit cube used by the benchmarks and the
+ * library examples: n^3 vertices numbered along x, then y, then z, and
+ * each cube of the grid split in 6 positively oriented tetra. The x and y
+ * coordinates may be perturbed by eps to avoid the exact ties.
+ */
+
+#ifndef _MMG5_GRID_H
+#define _MMG5_GRID_H
+
+#include <math.h>
+#include "libmmg3d.h"
+
+/** number of vertices of the grid of n^3 vertices */
+#define GRID_NP(n) ((n)*(n)*(n))
+/** number of tetra of the grid of n^3 vertices */
+#define GRID_NE(n) (6*((n)-1)*((n)-1)*((n)-1))
+
+/* vertices of the 6 positively oriented tetra of a cube (bit 0: x,
+ * bit 1: y, bit 2: z) */
+static const int gridKuhn[6][4] = { {0,1,3,7}, {0,1,7,5}, {0,2,7,3},
+                                    {0,2,6,7}, {0,4,5,7}, {0,4,7,6} };
+
+/* coordinates of the vertex (i,j,k) */
+static inline void gridCoor(int n,int i,int j,int k,double eps,double c[3]) {
+    double h;
+
+    h    = 1./(n-1);
+    c[0] = i*h+eps*sin(j+k);
+    c[1] = j*h+eps*cos(i+k);
+    c[2] = k*h;
+}
+
+/* vertices (numbered from 1) of the l-th tetra of the cube (i,j,k) */
+static inline void gridTetra(int n,int i,int j,int k,int l,MMG5_int v[4]) {
+    int c,m;
+
+    for (c=0; c<4; c++) {
+        m    = gridKuhn[l][c];
+        v[c] = 1 + (i+(m&1)) + n*((j+((m>>1)&1)) + n*(k+((m>>2)&1)));
+    }
+}
+
+/* set the grid as the mesh (the mesh size is set too), return 0 if fail */
+static inline int gridSetMesh(MMG5_pMesh mesh,int n,double eps) {
+    MMG5_int  v[4],ip,ie;
+    double    c[3];
+    int       i,j,k,l;
+
+    if ( !MMG5_Set_meshSize(mesh,GRID_NP(n),GRID_NE(n),0,0) )  return(0);
+
+    ip = 0;
+    for (k=0; k<n; k++)
+        for (j=0; j<n; j++)
+            for (i=0; i<n; i++) {
+                gridCoor(n,i,j,k,eps,c);
+                if ( !MMG5_Set_vertex(mesh,c[0],c[1],c[2],0,++ip) )  return(0);
+            }
+
+    ie = 0;
+    for (k=0; k<n-1; k++)
+        for (j=0; j<n-1; j++)
+            for (i=0; i<n-1; i++)
+                for (l=0; l<6; l++) {
+                    gridTetra(n,i,j,k,l,v);
+                    if ( !MMG5_Set_tetrahedron(mesh,v[0],v[1],v[2],v[3],0,++ie) )
+                        return(0);
+                }
+    return(1);
+}
+
+#endif
@@ -0,0 +1,150 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Benchmark of the analysis of the remeshing sweeps (shortest and
+ * longest edges, quality of each tetrahedron) with the metric kernels called
+ * through the \a mesh->lenedg and \a mesh->caltet pointers versus the
+ * kernels inlined by the iso instance of the templates (see
+ * metric_kernels.h). The mesh is a structured mesh of n^3 vertices (6 tetra
+ * per cube) with a varying isotropic size map.
+ *
+ * Usage: bench_metric [n] [nrepeat]
+ */
+
+#include <time.h>
+#include "mmg3d.h"
+#include "metric_kernels.h"
+#include "../grid.h"
+
+#define _MMG5_TMET iso
+
+/* structured mesh and isotropic size map */
+static void buildMesh(MMG5_pMesh mesh,MMG5_pSol met,int n) {
+    MMG5_int  ip;
+
+    if ( !gridSetMesh(mesh,n,1.e-3) )  exit(EXIT_FAILURE);
+    if ( !MMG5_Set_solSize(mesh,met,MMG5_Vertex,mesh->np,MMG5_Scalar) )
+        exit(EXIT_FAILURE);
+    for (ip=1; ip<=mesh->np; ip++)
+        met->m[ip] = 0.1+1.e-2*sin(0.1*ip);
+}
+
+static double elapsed(clock_t t0) {
+    return( (double)(clock()-t0) / CLOCKS_PER_SEC );
+}
+
+int main(int argc,char *argv[]) {
+    MMG5_pMesh   mesh;
+    MMG5_pSol    met;
+    MMG5_pTetra  pt;
+    clock_t      t0;
+    MMG5_int     k;
+    double       tlen[2],tqua[2],s[2][2],len,lmin,lmax;
+    int          n,nrep,r,ia;
+
+    n    = argc > 1 ? atoi(argv[1]) : 64;
+    nrep = argc > 2 ? atoi(argv[2]) : 5;
+    if ( n < 2 )  n = 2;
+    if ( nrep < 1 )  nrep = 1;
+
+    mesh = NULL;
+    met  = NULL;
+    MMG5_Init_mesh(&mesh,&met);
+    MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_verbose,-1);
+    mesh->memMax = 16LL*1024*1024*1024;
+    buildMesh(mesh,met,n);
+    mesh->caltet = _MMG5_caltet_iso;
+    mesh->lenedg = _MMG5_lenedg_iso;
+
+    fprintf(stdout,"  -- METRIC KERNELS BENCHMARK: %" MMG5_PRId " vertices, %"
+            MMG5_PRId " tetra, %d repetition(s)\n",mesh->np,mesh->ne,nrep);
+
+    memset(s,0,sizeof(s));
+
+    /* function pointers */
+    t0 = clock();
+    for (r=0; r<nrep; r++)
+        for (k=1; k<=mesh->ne; k++) {
+            pt   = &mesh->tetra[k];
+            lmin = DBL_MAX;
+            lmax = 0.0;
+            for (ia=0; ia<6; ia++) {
+                len  = _MMG5_lenedg(mesh,met,pt->v[_MMG5_iare[ia][0]],
+                                    pt->v[_MMG5_iare[ia][1]]);
+                lmin = MG_MIN(lmin,len);
+                lmax = MG_MAX(lmax,len);
+            }
+            s[0][0] += lmax - lmin;
+        }
+    tlen[0] = elapsed(t0);
+
+    t0 = clock();
+    for (r=0; r<nrep; r++)
+        for (k=1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            s[1][0] += _MMG5_caltet(mesh,met,pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
+        }
+    tqua[0] = elapsed(t0);
+
+    /* inlined kernels */
+    t0 = clock();
+    for (r=0; r<nrep; r++)
+        for (k=1; k<=mesh->ne; k++) {
+            pt   = &mesh->tetra[k];
+            lmin = DBL_MAX;
+            lmax = 0.0;
+            for (ia=0; ia<6; ia++) {
+                len  = _MMG5_TLENEDG(mesh,met,pt->v[_MMG5_iare[ia][0]],
+                                     pt->v[_MMG5_iare[ia][1]]);
+                lmin = MG_MIN(lmin,len);
+                lmax = MG_MAX(lmax,len);
+            }
+            s[0][1] += lmax - lmin;
+        }
+    tlen[1] = elapsed(t0);
+
+    t0 = clock();
+    for (r=0; r<nrep; r++)
+        for (k=1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            s[1][1] += _MMG5_TCALTET(mesh,met,pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
+        }
+    tqua[1] = elapsed(t0);
+
+    fprintf(stdout,"     %-18s %10s %10s\n","kernels","len (s)","qual (s)");
+    fprintf(stdout,"     %-18s %10.3f %10.3f\n","function pointers",tlen[0],tqua[0]);
+    fprintf(stdout,"     %-18s %10.3f %10.3f\n","inlined (iso)",tlen[1],tqua[1]);
+    fprintf(stdout,"     %-18s %10.2f %10.2f\n","speedup",
+            tlen[0]/MG_MAX(tlen[1],1.e-9),tqua[0]/MG_MAX(tqua[1],1.e-9));
+
+    MMG5_Free_all(mesh,met);
+
+    for (ia=0; ia<2; ia++) {
+        if ( s[ia][0] != s[ia][1] ) {
+            fprintf(stdout,"  ## Error: kernels disagree (%.15e/%.15e)\n",
+                    s[ia][0],s[ia][1]);
+            return(EXIT_FAILURE);
+        }
+    }
+    return(EXIT_SUCCESS);
+}
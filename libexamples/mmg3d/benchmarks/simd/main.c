@@ -0,0 +1,139 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Micro-benchmark of the batched kernels (see _MMG5_batchOrvol,
+ * _MMG5_batchCaltet, _MMG5_batchLenedg) for each instruction set supported
+ * by the host. The batches are filled with random tetrahedra (a third of
+ * them inverted) and random edges whose sizes are constant in one edge out
+ * of two. The results of each instruction set are compared to the scalar
+ * ones.
+ *
+ * Usage: bench_simd [nbatch] [nrepeat]
+ */
+
+#include <time.h>
+#include "mmg3d.h"
+
+static const char *isaName[4] = { "scalar","SSE2","AVX2","AVX-512" };
+
+static double elapsed(clock_t t0) {
+    return( (double)(clock()-t0) / CLOCKS_PER_SEC );
+}
+
+static double rnd(void) {
+    return( (double)rand() / (double)RAND_MAX );
+}
+
+int main(int argc,char *argv[]) {
+    _MMG5_pTetBatch      tb;
+    _MMG5_pEdgBatch      eb;
+    const _MMG5_SimdKer *ker;
+    clock_t              t0;
+    double              *ref[3],*res[3],t[3],tsca[3],c[4][3],h0,h1;
+    long                 nb,nrep,n,k,r,ndiff;
+    int                  isa,i,j;
+
+    nb   = argc > 1 ? atol(argv[1]) : 1024;
+    nrep = argc > 2 ? atol(argv[2]) : 200;
+    if ( nb < 1 )  nb = 1;
+    if ( nrep < 1 )  nrep = 1;
+    n = nb*_MMG5_BATCH;
+
+    tb = (_MMG5_pTetBatch)malloc(nb*sizeof(_MMG5_TetBatch));
+    eb = (_MMG5_pEdgBatch)malloc(nb*sizeof(_MMG5_EdgBatch));
+    if ( !tb || !eb )  exit(EXIT_FAILURE);
+    for (i=0; i<3; i++) {
+        ref[i] = (double*)malloc(n*sizeof(double));
+        res[i] = (double*)malloc(n*sizeof(double));
+        if ( !ref[i] || !res[i] )  exit(EXIT_FAILURE);
+    }
+
+    srand(12345);
+    for (k=0; k<nb; k++) {
+        tb[k].n = eb[k].n = 0;
+        for (r=0; r<_MMG5_BATCH; r++) {
+            for (j=0; j<4; j++)
+                for (i=0; i<3; i++)  c[j][i] = rnd();
+            _MMG5_BATCH_TET(&tb[k],c[0],c[1],c[2],c[3]);
+
+            h0 = 0.01+rnd();
+            h1 = r%2 ? h0 : 0.01+rnd();
+            _MMG5_BATCH_EDG(&eb[k],c[0],c[1],h0,h1);
+        }
+    }
+
+    fprintf(stdout,"  -- BATCHED KERNELS BENCHMARK: %ld tetra and edges,"
+            " %ld repetition(s)\n",n,nrep);
+    fprintf(stdout,"     %-10s %10s %10s %10s   %s\n","kernels","vol (s)",
+            "qual (s)","len (s)","speedup (vol/qual/len)");
+
+    ndiff = 0;
+    for (isa=_MMG5_SIMD_SCALAR; isa<=_MMG5_SIMD_AVX512; isa++) {
+        ker = _MMG5_simdKernels(isa);
+        if ( !ker )  continue;
+
+        t0 = clock();
+        for (r=0; r<nrep; r++)
+            for (k=0; k<nb; k++)  ker->orvol(&tb[k],&res[0][k*_MMG5_BATCH]);
+        t[0] = elapsed(t0);
+
+        t0 = clock();
+        for (r=0; r<nrep; r++)
+            for (k=0; k<nb; k++)  ker->caltet(&tb[k],&res[1][k*_MMG5_BATCH]);
+        t[1] = elapsed(t0);
+
+        t0 = clock();
+        for (r=0; r<nrep; r++)
+            for (k=0; k<nb; k++)  ker->lenedg(&eb[k],&res[2][k*_MMG5_BATCH]);
+        t[2] = elapsed(t0);
+
+        if ( isa == _MMG5_SIMD_SCALAR ) {
+            for (i=0; i<3; i++) {
+                memcpy(ref[i],res[i],n*sizeof(double));
+                tsca[i] = t[i];
+            }
+        }
+        else {
+            for (i=0; i<3; i++)
+                for (k=0; k<n; k++)
+                    if ( res[i][k] != ref[i][k] )  ndiff++;
+        }
+
+        fprintf(stdout,"     %-10s %10.3f %10.3f %10.3f   %.2f/%.2f/%.2f\n",
+                isaName[isa],t[0],t[1],t[2],tsca[0]/MG_MAX(t[0],1.e-9),
+                tsca[1]/MG_MAX(t[1],1.e-9),tsca[2]/MG_MAX(t[2],1.e-9));
+    }
+
+    for (i=0; i<3; i++) {
+        free(ref[i]);
+        free(res[i]);
+    }
+    free(tb);
+    free(eb);
+
+    if ( ndiff ) {
+        fprintf(stdout,"  ## Error: %ld results differ from the scalar kernels\n",ndiff);
+        return(EXIT_FAILURE);
+    }
+    return(EXIT_SUCCESS);
+}
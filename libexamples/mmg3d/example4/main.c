@@ -0,0 +1,176 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Example for using mmg3dlib (local remeshing): the tetra of a
+ * corner of a structured cube are remeshed with MMG5_mmg3dlib_local and we
+ * check that the tetra far from this region are left unchanged (the tetra
+ * are renumbered by the library, thus they are compared by their vertex
+ * coordinates). */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "libmmg3d.h"
+#include "../benchmarks/grid.h"
+
+/** number of cubes per direction */
+#define NCUB   8
+/** the tetra whose vertices all have \f$x \geq XFAR\f$ are far from the
+ * remeshed region (\f$x < 0.25\f$ and one layer of neighbours) */
+#define XFAR   0.6
+
+/* sort the 4 vertices of a tetra in lexicographic order of their
+ * coordinates, to compare the tetra independently of their numbering */
+static int cmpVert(const void *a,const void *b) {
+  const double *ca = (const double*)a, *cb = (const double*)b;
+  int          i;
+
+  for (i=0; i<3; i++) {
+    if ( ca[i] < cb[i] ) return(-1);
+    if ( ca[i] > cb[i] ) return(1);
+  }
+  return(0);
+}
+
+static int cmpTet(const void *a,const void *b) {
+  const double *ca = (const double*)a, *cb = (const double*)b;
+  int          i;
+
+  for (i=0; i<12; i++) {
+    if ( ca[i] < cb[i] ) return(-1);
+    if ( ca[i] > cb[i] ) return(1);
+  }
+  return(0);
+}
+
+/* store in far the sorted coordinates of the far tetra of the mesh (whose
+ * vertices and tetra are returned in c and tet), return their number */
+static MMG5_int farTetra(MMG5_pMesh mesh,double **c,MMG5_int **tet,
+                         double **far) {
+  MMG5_int np,ne,nt,na,k,nf,*v;
+  int      *req,i,j,isfar;
+
+  MMG5_Get_meshSize(mesh,&np,&ne,&nt,&na);
+  *c   = (double*)malloc(3*np*sizeof(double));
+  *tet = (MMG5_int*)malloc(4*ne*sizeof(MMG5_int));
+  *far = (double*)malloc(12*ne*sizeof(double));
+  req  = (int*)malloc(ne*sizeof(int));
+  if ( !*c || !*tet || !*far || !req ) {
+    perror("  ## Memory problem: malloc");
+    exit(EXIT_FAILURE);
+  }
+  if ( !MMG5_Get_vertices(mesh,*c,NULL,NULL,NULL) )  exit(EXIT_FAILURE);
+  if ( !MMG5_Get_tetrahedra(mesh,*tet,NULL,req) )    exit(EXIT_FAILURE);
+
+  nf = 0;
+  for (k=0; k<ne; k++) {
+    if ( req[k] ) {
+      fprintf(stdout,"  ## Error: tetra %" MMG5_PRId " left required.\n",k+1);
+      exit(EXIT_FAILURE);
+    }
+    v = &(*tet)[4*k];
+    isfar = 1;
+    for (i=0; i<4; i++)
+      if ( (*c)[3*(v[i]-1)] < XFAR )  isfar = 0;
+    if ( !isfar )  continue;
+
+    for (i=0; i<4; i++)
+      for (j=0; j<3; j++)
+        (*far)[12*nf+3*i+j] = (*c)[3*(v[i]-1)+j];
+    qsort(&(*far)[12*nf],4,3*sizeof(double),cmpVert);
+    nf++;
+  }
+  qsort(*far,nf,12*sizeof(double),cmpTet);
+  free(req);
+  return(nf);
+}
+
+int main(int argc,char *argv[]) {
+  MMG5_pMesh      mmgMesh;
+  MMG5_pSol       mmgSol;
+  MMG5_int        np,ne,nt,na,k,nfar0,nfar1,*tet;
+  int             i,ier,*eltab;
+  double          *c,*far0,*far1,x;
+
+  fprintf(stdout,"  -- TEST MMG3DLIB (LOCAL REMESHING) \n");
+
+  mmgMesh = NULL;
+  mmgSol  = NULL;
+  MMG5_Init_mesh(&mmgMesh,&mmgSol);
+
+  /** 1) Structured mesh of the unit cube */
+  if ( !gridSetMesh(mmgMesh,NCUB+1,0.) )  exit(EXIT_FAILURE);
+  ne = GRID_NE(NCUB+1);
+
+  if ( !MMG5_Set_iparameter(mmgMesh,mmgSol,MMG5_IPARAM_verbose,-1) )
+    exit(EXIT_FAILURE);
+  if ( !MMG5_Set_dparameter(mmgMesh,mmgSol,MMG5_DPARAM_hmax,0.05) )
+    exit(EXIT_FAILURE);
+
+  /** 2) Far tetra of the input mesh and region to remesh */
+  nfar0 = farTetra(mmgMesh,&c,&tet,&far0);
+
+  eltab = (int*)calloc(ne+1,sizeof(int));
+  if ( !eltab ) {
+    perror("  ## Memory problem: calloc");
+    exit(EXIT_FAILURE);
+  }
+  for (k=0; k<ne; k++) {
+    x = 0.;
+    for (i=0; i<4; i++)  x += 0.25*c[3*(tet[4*k+i]-1)];
+    if ( x < 0.25 )  eltab[k+1] = 1;
+  }
+  free(c);
+  free(tet);
+
+  /** 3) Local remeshing */
+  ier = MMG5_mmg3dlib_local(mmgMesh,mmgSol,eltab,1);
+  if ( ier != MMG5_SUCCESS ) {
+    fprintf(stdout,"BAD ENDING OF MMG3DLIB_LOCAL\n");
+    exit(EXIT_FAILURE);
+  }
+
+  /** 4) Comparison of the far tetra */
+  nfar1 = farTetra(mmgMesh,&c,&tet,&far1);
+  MMG5_Get_meshSize(mmgMesh,&np,&ne,&nt,&na);
+
+  ier = ( nfar0 == nfar1 && nfar0 > 0 ) ? 0 : 1;
+  for (k=0; !ier && k<12*nfar0; k++)
+    if ( fabs(far0[k]-far1[k]) > 1.e-12 )  ier = 1;
+
+  fprintf(stdout,"  FAR TETRA: %" MMG5_PRId " BEFORE, %" MMG5_PRId
+          " AFTER (%" MMG5_PRId " TETRA): %s\n",nfar0,nfar1,ne,
+          ier ? "MODIFIED" : "UNCHANGED");
+
+  MMG5_Free_all(mmgMesh,mmgSol);
+  free(c);
+  free(tet);
+  free(far0);
+  free(far1);
+  free(eltab);
+
+  return(ier ? EXIT_FAILURE : EXIT_SUCCESS);
+}
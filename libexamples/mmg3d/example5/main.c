@@ -0,0 +1,154 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/** \include Example for using mmg3dlib from several threads: the same
+ * remeshings (isotropic and anisotropic size maps) are run one after the
+ * other, then concurrently in NTHR threads, and the concurrent results must
+ * be identical to the serial ones. */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "libmmg3d.h"
+#include "../benchmarks/grid.h"
+
+/** number of vertices per direction of the input meshes */
+#define NGRID  7
+/** number of remeshings (each one is run in its own thread) */
+#define NTHR   6
+
+/** a remeshing and its result */
+typedef struct {
+  double    hmax;  /*!< maximal size */
+  int       aniso; /*!< 1 for an anisotropic size map */
+  int       ier;   /*!< return value of MMG5_mmg3dlib */
+  MMG5_int  np,ne; /*!< size of the output mesh */
+  double   *c;     /*!< output vertices */
+  MMG5_int *tet;   /*!< output tetra */
+} Run;
+
+static void *remesh(void *arg) {
+  Run         *run = (Run*)arg;
+  MMG5_pMesh   mmgMesh;
+  MMG5_pSol    mmgSol;
+  MMG5_int     k,nt,na;
+
+  mmgMesh = NULL;
+  mmgSol  = NULL;
+  MMG5_Init_mesh(&mmgMesh,&mmgSol);
+
+  run->ier = MMG5_STRONGFAILURE;
+  if ( !gridSetMesh(mmgMesh,NGRID,0.) )  return(NULL);
+
+  if ( run->aniso ) {
+    /* the size is divided by 2 along x */
+    if ( !MMG5_Set_solSize(mmgMesh,mmgSol,MMG5_Vertex,mmgMesh->np,MMG5_Tensor) )
+      return(NULL);
+    for (k=1; k<=mmgMesh->np; k++)
+      if ( !MMG5_Set_tensorSol(mmgSol,4./(run->hmax*run->hmax),0.,0.,
+                               1./(run->hmax*run->hmax),0.,
+                               1./(run->hmax*run->hmax),k) )
+        return(NULL);
+  }
+  else if ( !MMG5_Set_dparameter(mmgMesh,mmgSol,MMG5_DPARAM_hmax,run->hmax) )
+    return(NULL);
+
+  if ( !MMG5_Set_iparameter(mmgMesh,mmgSol,MMG5_IPARAM_verbose,0) )
+    return(NULL);
+
+  run->ier = MMG5_mmg3dlib(mmgMesh,mmgSol);
+
+  if ( run->ier == MMG5_SUCCESS ) {
+    MMG5_Get_meshSize(mmgMesh,&run->np,&run->ne,&nt,&na);
+    run->c   = (double*)malloc(3*run->np*sizeof(double));
+    run->tet = (MMG5_int*)malloc(4*run->ne*sizeof(MMG5_int));
+    if ( !run->c || !run->tet ) {
+      perror("  ## Memory problem: malloc");
+      exit(EXIT_FAILURE);
+    }
+    for (k=0; k<run->np; k++)
+      MMG5_Get_vertex(mmgMesh,&run->c[3*k],&run->c[3*k+1],&run->c[3*k+2],
+                      NULL,NULL,NULL);
+    for (k=0; k<run->ne; k++)
+      MMG5_Get_tetrahedron(mmgMesh,&run->tet[4*k],&run->tet[4*k+1],
+                           &run->tet[4*k+2],&run->tet[4*k+3],NULL,NULL);
+  }
+
+  MMG5_Free_all(mmgMesh,mmgSol);
+  return(NULL);
+}
+
+int main(int argc,char *argv[]) {
+  pthread_t  thr[NTHR];
+  Run        ser[NTHR],par[NTHR];
+  int        i,ier;
+
+  fprintf(stdout,"  -- TEST MMG3DLIB (CONCURRENT REMESHINGS) \n");
+
+  memset(ser,0,NTHR*sizeof(Run));
+  for (i=0; i<NTHR; i++) {
+    ser[i].hmax  = 0.1 + 0.05*(i/2);
+    ser[i].aniso = i%2;
+  }
+  memcpy(par,ser,NTHR*sizeof(Run));
+
+  /** 1) Serial remeshings */
+  for (i=0; i<NTHR; i++)
+    remesh(&ser[i]);
+
+  /** 2) Concurrent remeshings */
+  for (i=0; i<NTHR; i++)
+    if ( pthread_create(&thr[i],NULL,remesh,&par[i]) ) {
+      fprintf(stdout,"  ## Error: unable to create thread %d.\n",i);
+      exit(EXIT_FAILURE);
+    }
+  for (i=0; i<NTHR; i++)
+    pthread_join(thr[i],NULL);
+
+  /** 3) Comparison */
+  ier = 0;
+  for (i=0; i<NTHR; i++) {
+    if ( ser[i].ier != MMG5_SUCCESS || par[i].ier != MMG5_SUCCESS ||
+         ser[i].np != par[i].np || ser[i].ne != par[i].ne ||
+         memcmp(ser[i].c,par[i].c,3*ser[i].np*sizeof(double)) ||
+         memcmp(ser[i].tet,par[i].tet,4*ser[i].ne*sizeof(MMG5_int)) ) {
+      fprintf(stdout,"  ## Error: remeshing %d (hmax %g, %s) differs from"
+              " the serial one.\n",i,ser[i].hmax,ser[i].aniso ? "aniso" : "iso");
+      ier = 1;
+    }
+    else
+      fprintf(stdout,"  REMESHING %d (HMAX %g, %s): %" MMG5_PRId " VERTICES, %"
+              MMG5_PRId " TETRA\n",i,ser[i].hmax,ser[i].aniso ? "ANISO" : "ISO",
+              ser[i].np,ser[i].ne);
+    free(ser[i].c);
+    free(ser[i].tet);
+    free(par[i].c);
+    free(par[i].tet);
+  }
+
+  return(ier ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -127,6 +127,7 @@ sub Convert {
     my $tabcount = 0;
     my $interfaceprinted = 0;
     my $startdef = 0;
+    my $startint = 0;
 
     open (APIc, $fichier);
 
@@ -163,6 +164,17 @@ sub Convert {
                     # Discard line and replace it by a white line
                     print "\n";
                 }
+                elsif ($line =~ /^\s*\#ifdef\s+MMG5\_INT64/)
+                {
+                    # Keep the index size switch active in the Fortran header
+                    $startint = 1;
+                    print $line;
+                }
+                elsif ($startint == 1 && $line =~ /^\s*\#(else|endif)/)
+                {
+                    $startint = 0 if ($line =~ /endif/);
+                    print $line;
+                }
                 elsif ($line =~ /\#define/)
                 {
                     if ($line =~ /\_MMG3DLIB\_H/ )
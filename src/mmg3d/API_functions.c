@@ -156,6 +156,9 @@ void MMG5_Init_parameters(MMG5_pMesh mesh) {
 
     /* initial value for memMax and gap */
     mesh->gap = 0.2;
+    /** MMG5_IPARAM_growth = 1 */
+    mesh->info.growth = 1;
+    chrono(RESET,&mesh->ctrealloc);
     mesh->memMax = _MMG5_memSize();
     if ( mesh->memMax )
         /* maximal memory = 50% of total physical memory */
@@ -169,6 +172,10 @@ void MMG5_Init_parameters(MMG5_pMesh mesh) {
 #ifndef PATTERN
     /** MMG5_IPARAM_bucket = 64 */
     mesh->info.bucket = 64;
+    /** MMG5_IPARAM_threads = 1 */
+    mesh->info.threads = 1;
+    /** MMG5_IPARAM_queue = 0 */
+    mesh->info.queue = 0;
 #endif
 }
 
@@ -391,7 +398,7 @@ int MMG5_Set_outputSolName(MMG5_pMesh mesh,MMG5_pSol sol, char* solout) {
  * Set the solution number, dimension and type.
  *
  */
-int MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int typSol) {
+int MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, MMG5_int np, int typSol) {
 
     if ( ( (mesh->info.imprim > 5) || mesh->info.ddebug ) && sol->m )
         fprintf(stdout,"  ## Warning: new solution\n");
@@ -400,11 +407,14 @@ int MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int
         fprintf(stdout,"  ## Error: MMG3D5 need a solution imposed on vertices\n");
         return(0);
     }
-    if ( typSol != MMG5_Scalar ) {
-        fprintf(stdout,"  ## Error: anisotropic adaptation not yet implemented\n");
+    if ( typSol == MMG5_Scalar )
+        sol->size = 1;
+    else if ( typSol == MMG5_Tensor )
+        sol->size = 6;
+    else {
+        fprintf(stdout,"  ## Error: vectorial solutions are not used by MMG3D5\n");
         return(0);
     }
-    else sol->size = 1;
 
     sol->dim = 3;
     if ( np ) {
@@ -435,8 +445,8 @@ int MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int
  * whole mesh to realloc it at the new size
  *
  */
-int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
-    int k;
+int MMG5_Set_meshSize(MMG5_pMesh mesh, MMG5_int np, MMG5_int ne, MMG5_int nt, MMG5_int na) {
+    MMG5_int k;
 
     if ( ( (mesh->info.imprim > 5) || mesh->info.ddebug ) &&
          ( mesh->point || mesh->tria || mesh->tetra || mesh->edge) )
@@ -468,7 +478,7 @@ int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
             //     mesh->ntmax,mesh->nt,mesh->nemax,mesh->ne,mesh->info.mem);
             if((mesh->npmax < mesh->np || mesh->ntmax < mesh->nt
                 || mesh->nemax < mesh->ne)) {
-                fprintf(stdout,"mem insuffisante np : %d %d nt : %d %d ne :%d %d\n"
+                fprintf(stdout,"mem insuffisante np : %" MMG5_PRId " %" MMG5_PRId " nt : %" MMG5_PRId " %" MMG5_PRId " ne :%" MMG5_PRId " %" MMG5_PRId "\n"
                         ,mesh->npmax,mesh->np,
                         mesh->ntmax,mesh->nt,mesh->nemax,mesh->ne);
                 return(0);
@@ -521,13 +531,13 @@ int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
 
     /* stats */
     if ( abs(mesh->info.imprim) > 6 ) {
-        fprintf(stdout,"     NUMBER OF VERTICES     %8d\n",mesh->np);
+        fprintf(stdout,"     NUMBER OF VERTICES     %8" MMG5_PRId "\n",mesh->np);
         if ( mesh->na ) {
-            fprintf(stdout,"     NUMBER OF EDGES        %8d\n",mesh->na);
+            fprintf(stdout,"     NUMBER OF EDGES        %8" MMG5_PRId "\n",mesh->na);
         }
         if ( mesh->nt )
-            fprintf(stdout,"     NUMBER OF TRIANGLES    %8d\n",mesh->nt);
-        fprintf(stdout,"     NUMBER OF ELEMENTS     %8d\n",mesh->ne);
+            fprintf(stdout,"     NUMBER OF TRIANGLES    %8" MMG5_PRId "\n",mesh->nt);
+        fprintf(stdout,"     NUMBER OF ELEMENTS     %8" MMG5_PRId "\n",mesh->ne);
     }
     return(1);
 }
@@ -544,10 +554,10 @@ int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
  * Get the solution number, dimension and type.
  *
  */
-int MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, int* np, int* typSol) {
+int MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, MMG5_int* np, int* typSol) {
 
     *typEntity = MMG5_Vertex;
-    *typSol    = sol->size;
+    *typSol    = sol->size == 6 ? MMG5_Tensor : MMG5_Scalar;
 
     assert(sol->np = mesh->np);
 
@@ -568,7 +578,7 @@ int MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, int* np, in
  * Get the number of vertices, tetrahedra, triangles and edges of the mesh.
  *
  */
-int MMG5_Get_meshSize(MMG5_pMesh mesh, int* np, int* ne, int* nt, int* na) {
+int MMG5_Get_meshSize(MMG5_pMesh mesh, MMG5_int* np, MMG5_int* ne, MMG5_int* nt, MMG5_int* na) {
 
     if ( np != NULL )
         *np = mesh->np;
@@ -587,6 +597,30 @@ int MMG5_Get_meshSize(MMG5_pMesh mesh, int* np, int* ne, int* nt, int* na) {
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np pointer toward the estimated final number of vertices.
+ * \param ne pointer toward the estimated final number of tetrahedra.
+ * \return 1 if success, 0 if the size map is undefined (no metric and no
+ * \a hmax value): \a np and \a ne are then the current mesh sizes.
+ *
+ * Estimate the sizes of the adapted mesh by integration of the metric over
+ * the input mesh (see \ref MMG5_IPARAM_threads), for example to plan the
+ * memory of a run. Must be called once the mesh and the metric are set.
+ *
+ */
+int MMG5_Get_estimatedSize(MMG5_pMesh mesh, MMG5_pSol met, MMG5_int* np,
+                           MMG5_int* ne) {
+
+    if ( !_MMG5_countelt(mesh,met,NULL,np,ne) ) {
+        *np = mesh->np;
+        *ne = mesh->ne;
+        return(0);
+    }
+    return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param c0 coordinate of the point along the first dimension.
@@ -600,7 +634,7 @@ int MMG5_Get_meshSize(MMG5_pMesh mesh, int* np, int* ne, int* nt, int* na) {
  * at position \a pos in mesh structure
  *
  */
-int MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1, double c2, int ref, int pos) {
+int MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1, double c2, int ref, MMG5_int pos) {
 
     if ( !mesh->np ) {
         fprintf(stdout,"  ## Error: You must set the number of points with the");
@@ -610,14 +644,14 @@ int MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1, double c2, int ref, i
 
     if ( pos > mesh->npmax ) {
         fprintf(stdout,"  ## Error: unable to allocate a new point.\n");
-        fprintf(stdout,"    max number of points: %d\n",mesh->npmax);
+        fprintf(stdout,"    max number of points: %" MMG5_PRId "\n",mesh->npmax);
         _MMG5_INCREASE_MEM_MESSAGE();
         return(0);
     }
 
     if ( pos > mesh->np ) {
-        fprintf(stdout,"  ## Error: attempt to set new vertex at position %d.",pos);
-        fprintf(stdout," Overflow of the given number of vertices: %d\n",mesh->np);
+        fprintf(stdout,"  ## Error: attempt to set new vertex at position %" MMG5_PRId ".",pos);
+        fprintf(stdout," Overflow of the given number of vertices: %" MMG5_PRId "\n",mesh->np);
         fprintf(stdout,"  ## Check the mesh size, its compactness or the position");
         fprintf(stdout," of the vertex.\n");
         return(0);
@@ -656,7 +690,7 @@ int MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* re
     if ( mesh->npi > mesh->np ) {
         fprintf(stdout,"  ## Error: unable to get point.\n");
         fprintf(stdout,"     The number of call of MMG5_Get_vertex function");
-        fprintf(stdout," can not exceed the number of points: %d\n ",mesh->np);
+        fprintf(stdout," can not exceed the number of points: %" MMG5_PRId "\n ",mesh->np);
         return(0);
     }
 
@@ -683,6 +717,91 @@ int MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* re
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices table of the points coor. The coordinates of the
+ * \f$i^{th}\f$ point are stored in vertices[(i-1)*3]\@3.
+ * \param refs table of points references (may be NULL).
+ * The ref of the \f$i^th\f$ point is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set vertices coordinates and references in mesh structure in one pass.
+ *
+ */
+int MMG5_Set_vertices(MMG5_pMesh mesh, double *vertices,int *refs) {
+    MMG5_pPoint ppt;
+    MMG5_int    i,j;
+
+    if ( !mesh->np ) {
+        fprintf(stdout,"  ## Error: You must set the number of points with the");
+        fprintf(stdout," MMG5_Set_meshSize function before setting vertices in mesh\n");
+        return(0);
+    }
+
+    if ( mesh->np > mesh->npmax ) {
+        fprintf(stdout,"  ## Error: unable to allocate a new point.\n");
+        fprintf(stdout,"    max number of points: %" MMG5_PRId "\n",mesh->npmax);
+        _MMG5_INCREASE_MEM_MESSAGE();
+        return(0);
+    }
+
+    for (i=1; i<=mesh->np; i++) {
+        ppt = &mesh->point[i];
+        j   = 3*(i-1);
+        ppt->c[0] = vertices[j];
+        ppt->c[1] = vertices[j+1];
+        ppt->c[2] = vertices[j+2];
+        ppt->ref  = refs ? refs[i-1] : 0;
+        ppt->tag  = MG_NUL;
+        ppt->flag = 0;
+        ppt->tmp  = 0;
+    }
+
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices pointer toward the table of the points coordinates.
+ * The coordinates of the \f$i^{th}\f$ point are stored in
+ * vertices[(i-1)*3]\@3.
+ * \param refs pointer to the table of the point references (may be NULL).
+ * The ref of the \f$i^th\f$ point is stored in refs[i-1].
+ * \param areCorners pointer toward the table of the flags saying if
+ * points are corners (may be NULL).
+ * areCorners[i-1]=1 if the \f$i^{th}\f$ point is corner.
+ * \param areRequired pointer toward the table of flags saying if points
+ * are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ point is required.
+ * \return 1.
+ *
+ * Get the coordinates and references of all the mesh vertices in one pass.
+ *
+ */
+int MMG5_Get_vertices(MMG5_pMesh mesh, double* vertices, int* refs,
+                      int* areCorners, int* areRequired) {
+    MMG5_pPoint ppt;
+    MMG5_int    i,j;
+
+    for (i=1; i<=mesh->np; i++) {
+        ppt = &mesh->point[i];
+        j   = 3*(i-1);
+        vertices[j]   = ppt->c[0];
+        vertices[j+1] = ppt->c[1];
+        vertices[j+2] = ppt->c[2];
+
+        if ( refs != NULL )
+            refs[i-1] = ppt->ref;
+        if ( areCorners != NULL )
+            areCorners[i-1] = (ppt->tag & MG_CRN) ? 1 : 0;
+        if ( areRequired != NULL )
+            areRequired[i-1] = (ppt->tag & MG_REQ) ? 1 : 0;
+    }
+    mesh->npi = mesh->np;
+
+    return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of tetrahedron.
@@ -697,7 +816,7 @@ int MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* re
  * \a ref at position \a pos in mesh structure.
  *
  */
-int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int ref, int pos) {
+int MMG5_Set_tetrahedron(MMG5_pMesh mesh, MMG5_int v0, MMG5_int v1, MMG5_int v2, MMG5_int v3, int ref, MMG5_int pos) {
     MMG5_pTetra pt;
     MMG5_pPoint ppt;
     double aux, vol;
@@ -711,14 +830,14 @@ int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int re
 
     if ( pos > mesh->nemax ) {
         fprintf(stdout,"  ## Error: unable to allocate a new element.\n");
-        fprintf(stdout,"    max number of element: %d\n",mesh->nemax);
+        fprintf(stdout,"    max number of element: %" MMG5_PRId "\n",mesh->nemax);
         _MMG5_INCREASE_MEM_MESSAGE();
         return(0);
     }
 
     if ( pos > mesh->ne ) {
-        fprintf(stdout,"  ## Error: attempt to set new tetrahedron at position %d.",pos);
-        fprintf(stdout," Overflow of the given number of tetrahedron: %d\n",mesh->ne);
+        fprintf(stdout,"  ## Error: attempt to set new tetrahedron at position %" MMG5_PRId ".",pos);
+        fprintf(stdout," Overflow of the given number of tetrahedron: %" MMG5_PRId "\n",mesh->ne);
         fprintf(stdout,"  ## Check the mesh size, its compactness or the position");
         fprintf(stdout," of the tetrahedron.\n");
         return(0);
@@ -738,7 +857,7 @@ int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int re
 
     vol = _MMG5_orvol(mesh->point,pt->v);
     if ( vol == 0.0 ) {
-        fprintf(stdout,"  ## Error: tetrahedron %d has volume null.\n",pos);
+        fprintf(stdout,"  ## Error: tetrahedron %" MMG5_PRId " has volume null.\n",pos);
         for ( ip=0; ip<4; ip++ ) {
             ppt = &mesh->point[pt->v[ip]];
             for ( j=0; j<3; j++ ) {
@@ -761,7 +880,7 @@ int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int re
         mesh->xt++;
     }
 
-    pt->qual = _MMG5_orcal(mesh,pos);
+    pt->qual = _MMG5_orcal(mesh,NULL,pos);
 
     return(1);
 }
@@ -780,7 +899,7 @@ int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int re
  * next tetra of mesh.
  *
  */
-int MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
+int MMG5_Get_tetrahedron(MMG5_pMesh mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, MMG5_int* v3,
                     int* ref, int* isRequired) {
 
     mesh->nei++;
@@ -788,7 +907,7 @@ int MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
     if ( mesh->nei > mesh->ne ) {
         fprintf(stdout,"  ## Error: unable to get tetra.\n");
         fprintf(stdout,"    The number of call of MMG5_Get_tetrahedron function");
-        fprintf(stdout," can not exceed the number of tetra: %d\n ",mesh->ne);
+        fprintf(stdout," can not exceed the number of tetra: %" MMG5_PRId "\n ",mesh->ne);
         return(0);
     }
 
@@ -810,6 +929,120 @@ int MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra vertices of the tetras of the mesh. Vertices of the
+ * \f$i^{th}\f$ tetra are stored in tetra[(i-1)*4]\@4.
+ * \param refs table of the tetrahedra references (may be NULL).
+ * References of the \f$i^{th}\f$ tetra is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set vertices and references of all the mesh tetrahedra in one pass.
+ * Badly oriented tetrahedra are reoriented and counted only once for
+ * the whole array.
+ *
+ */
+int MMG5_Set_tetrahedra(MMG5_pMesh mesh, MMG5_int *tetra, int *refs) {
+    MMG5_pTetra pt;
+    MMG5_pPoint ppt;
+    double      vol;
+    MMG5_int    aux, ip;
+    MMG5_int    i,j;
+
+    if ( !mesh->ne ) {
+        fprintf(stdout,"  ## Error: You must set the number of elements with the");
+        fprintf(stdout," MMG5_Set_meshSize function before setting elements in mesh\n");
+        return(0);
+    }
+
+    if ( mesh->ne > mesh->nemax ) {
+        fprintf(stdout,"  ## Error: unable to allocate a new element.\n");
+        fprintf(stdout,"    max number of element: %" MMG5_PRId "\n",mesh->nemax);
+        _MMG5_INCREASE_MEM_MESSAGE();
+        return(0);
+    }
+
+    for (i=1; i<=mesh->ne; i++) {
+        pt = &mesh->tetra[i];
+        j  = 4*(i-1);
+        pt->v[0] = tetra[j];
+        pt->v[1] = tetra[j+1];
+        pt->v[2] = tetra[j+2];
+        pt->v[3] = tetra[j+3];
+        pt->ref  = refs ? refs[i-1] : 0;
+
+        mesh->point[pt->v[0]].tag &= ~MG_NUL;
+        mesh->point[pt->v[1]].tag &= ~MG_NUL;
+        mesh->point[pt->v[2]].tag &= ~MG_NUL;
+        mesh->point[pt->v[3]].tag &= ~MG_NUL;
+
+        vol = _MMG5_orvol(mesh->point,pt->v);
+        if ( vol == 0.0 ) {
+            fprintf(stdout,"  ## Error: tetrahedron %" MMG5_PRId " has volume null.\n",i);
+            for ( ip=0; ip<4; ip++ ) {
+                ppt = &mesh->point[pt->v[ip]];
+                for ( j=0; j<3; j++ ) {
+                    if ( fabs(ppt->c[j])>0. ) {
+                        fprintf(stdout," Check that you don't have a sliver tetrahedron.\n");
+                        return(0);
+                    }
+                }
+            }
+            fprintf(stdout,"  All vertices have zero coordinates.");
+            fprintf(stdout," Check that you have set the vertices before the tetrahedra.\n");
+            return(0);
+        }
+        else if ( vol < 0.0 ) {
+            /* Possibly switch 2 vertices number so that each tet is positively oriented */
+            aux = pt->v[2];
+            pt->v[2] = pt->v[3];
+            pt->v[3] = aux;
+            /* mesh->xt temporary used to count reoriented tetra */
+            mesh->xt++;
+        }
+
+        pt->qual = _MMG5_orcal(mesh,NULL,i);
+    }
+
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra pointer toward the table of the tetrahedra vertices.
+ * Vertices of the \f$i^{th}\f$ tetra are stored in tetra[(i-1)*4]\@4.
+ * \param refs pointer toward the table of the tetrahedron references
+ * (may be NULL). References of the \f$i^{th}\f$ tetra is stored in refs[i-1].
+ * \param areRequired pointer toward the table of the flags saying if the
+ * tetrahedra are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ tetra is required.
+ * \return 1.
+ *
+ * Get vertices and references of all the mesh tetrahedra in one pass.
+ *
+ */
+int MMG5_Get_tetrahedra(MMG5_pMesh mesh, MMG5_int* tetra, int* refs, int* areRequired) {
+    MMG5_pTetra pt;
+    MMG5_int    i,j;
+
+    for (i=1; i<=mesh->ne; i++) {
+        pt = &mesh->tetra[i];
+        j  = 4*(i-1);
+        tetra[j]   = pt->v[0];
+        tetra[j+1] = pt->v[1];
+        tetra[j+2] = pt->v[2];
+        tetra[j+3] = pt->v[3];
+
+        if ( refs != NULL )
+            refs[i-1] = pt->ref;
+        if ( areRequired != NULL )
+            areRequired[i-1] = (pt->tag & MG_REQ) ? 1 : 0;
+    }
+    mesh->nei = mesh->ne;
+
+    return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of triangle.
@@ -823,7 +1056,7 @@ int MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
  * at position \a pos in mesh structure.
  *
  */
-int MMG5_Set_triangle(MMG5_pMesh mesh, int v0, int v1, int v2, int ref,int pos) {
+int MMG5_Set_triangle(MMG5_pMesh mesh, MMG5_int v0, MMG5_int v1, MMG5_int v2, int ref,MMG5_int pos) {
 
     if ( !mesh->nt ) {
         fprintf(stdout,"  ## Error: You must set the number of triangles with the");
@@ -833,14 +1066,14 @@ int MMG5_Set_triangle(MMG5_pMesh mesh, int v0, int v1, int v2, int ref,int pos)
 
     if ( pos > mesh->ntmax ) {
         fprintf(stdout,"  ## Error: unable to allocate a new triangle.\n");
-        fprintf(stdout,"    max number of triangle: %d\n",mesh->ntmax);
+        fprintf(stdout,"    max number of triangle: %" MMG5_PRId "\n",mesh->ntmax);
         _MMG5_INCREASE_MEM_MESSAGE();
         return(0);
     }
 
     if ( pos > mesh->nt ) {
-        fprintf(stdout,"  ## Error: attempt to set new triangle at position %d.",pos);
-        fprintf(stdout," Overflow of the given number of triangles: %d\n",mesh->nt);
+        fprintf(stdout,"  ## Error: attempt to set new triangle at position %" MMG5_PRId ".",pos);
+        fprintf(stdout," Overflow of the given number of triangles: %" MMG5_PRId "\n",mesh->nt);
         fprintf(stdout,"  ## Check the mesh size, its compactness or the position");
         fprintf(stdout," of the triangle.\n");
         return(0);
@@ -867,7 +1100,7 @@ int MMG5_Set_triangle(MMG5_pMesh mesh, int v0, int v1, int v2, int ref,int pos)
  * triangle of mesh.
  *
  */
-int MMG5_Get_triangle(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* ref
+int MMG5_Get_triangle(MMG5_pMesh mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, int* ref
                  ,int* isRequired) {
     MMG5_pTria  ptt;
 
@@ -876,7 +1109,7 @@ int MMG5_Get_triangle(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* ref
     if ( mesh->nti > mesh->nt ) {
         fprintf(stdout,"  ## Error: unable to get triangle.\n");
         fprintf(stdout,"    The number of call of MMG5_Get_triangle function");
-        fprintf(stdout," can not exceed the number of triangles: %d\n ",mesh->nt);
+        fprintf(stdout," can not exceed the number of triangles: %" MMG5_PRId "\n ",mesh->nt);
         return(0);
     }
 
@@ -898,6 +1131,79 @@ int MMG5_Get_triangle(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* ref
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tria pointer toward the table of the triangles vertices.
+ * Vertices of the \f$i^{th}\f$ tria are stored in tria[(i-1)*3]\@3.
+ * \param refs pointer toward the table of the triangle references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ tria.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set vertices and references of all the mesh triangles in one pass.
+ *
+ */
+int MMG5_Set_triangles(MMG5_pMesh mesh, MMG5_int *tria, int *refs) {
+    MMG5_pTria ptt;
+    MMG5_int   i,j;
+
+    if ( !mesh->nt ) {
+        fprintf(stdout,"  ## Error: You must set the number of triangles with the");
+        fprintf(stdout," MMG5_Set_meshSize function before setting triangles in mesh\n");
+        return(0);
+    }
+
+    for (i=1; i<=mesh->nt; i++) {
+        ptt = &mesh->tria[i];
+        j   = 3*(i-1);
+        ptt->v[0] = tria[j];
+        ptt->v[1] = tria[j+1];
+        ptt->v[2] = tria[j+2];
+        ptt->ref  = refs ? refs[i-1] : 0;
+    }
+
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tria pointer toward the table of the triangles vertices.
+ * Vertices of the \f$i^{th}\f$ tria are stored in tria[(i-1)*3]\@3.
+ * \param refs pointer toward the table of the triangles references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ tria.
+ * \param areRequired pointer toward table of the flags saying if
+ * triangles are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ tria is required.
+ * \return 1.
+ *
+ * Get vertices and references of all the mesh triangles in one pass.
+ *
+ */
+int MMG5_Get_triangles(MMG5_pMesh mesh, MMG5_int* tria, int* refs, int* areRequired) {
+    MMG5_pTria ptt;
+    MMG5_int   i,j;
+
+    for (i=1; i<=mesh->nt; i++) {
+        ptt = &mesh->tria[i];
+        j   = 3*(i-1);
+        tria[j]   = ptt->v[0];
+        tria[j+1] = ptt->v[1];
+        tria[j+2] = ptt->v[2];
+
+        if ( refs != NULL )
+            refs[i-1] = ptt->ref;
+        if ( areRequired != NULL ) {
+            if ( (ptt->tag[0] & MG_REQ) && (ptt->tag[1] & MG_REQ) &&
+                 (ptt->tag[2] & MG_REQ) )
+                areRequired[i-1] = 1;
+            else
+                areRequired[i-1] = 0;
+        }
+    }
+    mesh->nti = mesh->nt;
+
+    return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first extremity of the edge.
@@ -910,7 +1216,7 @@ int MMG5_Get_triangle(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* ref
  * position \a pos in mesh structure
  *
  */
-int MMG5_Set_edge(MMG5_pMesh mesh, int v0, int v1, int ref, int pos) {
+int MMG5_Set_edge(MMG5_pMesh mesh, MMG5_int v0, MMG5_int v1, int ref, MMG5_int pos) {
 
     if ( !mesh->na ) {
         fprintf(stdout,"  ## Error: You must set the number of edges with the");
@@ -919,13 +1225,13 @@ int MMG5_Set_edge(MMG5_pMesh mesh, int v0, int v1, int ref, int pos) {
     }
     if ( pos > mesh->namax ) {
         fprintf(stdout,"  ## Error: unable to allocate a new edge.\n");
-        fprintf(stdout,"    max number of edge: %d\n",mesh->namax);
+        fprintf(stdout,"    max number of edge: %" MMG5_PRId "\n",mesh->namax);
         _MMG5_INCREASE_MEM_MESSAGE();
         return(0);
     }
     if ( pos > mesh->na ) {
-        fprintf(stdout,"  ## Error: attempt to set new edge at position %d.",pos);
-        fprintf(stdout," Overflow of the given number of edges: %d\n",mesh->na);
+        fprintf(stdout,"  ## Error: attempt to set new edge at position %" MMG5_PRId ".",pos);
+        fprintf(stdout," Overflow of the given number of edges: %" MMG5_PRId "\n",mesh->na);
         fprintf(stdout,"  ## Check the mesh size, its compactness or the position");
         fprintf(stdout," of the edge.\n");
         return(0);
@@ -951,7 +1257,7 @@ int MMG5_Set_edge(MMG5_pMesh mesh, int v0, int v1, int ref, int pos) {
  * Get extremities \a e0, \a e1 and reference \a ref of next edge of mesh.
  *
  */
-int MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref
+int MMG5_Get_edge(MMG5_pMesh mesh, MMG5_int* e0, MMG5_int* e1, int* ref
              ,int* isRidge, int* isRequired) {
 
     mesh->nai++;
@@ -959,7 +1265,7 @@ int MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref
     if ( mesh->nai > mesh->na ) {
         fprintf(stdout,"  ## Error: unable to get edge.\n");
         fprintf(stdout,"    The number of call of MMG5_Get_edge function");
-        fprintf(stdout," can not exceed the number of edges: %d\n ",mesh->na);
+        fprintf(stdout," can not exceed the number of edges: %" MMG5_PRId "\n ",mesh->na);
         return(0);
     }
 
@@ -985,6 +1291,79 @@ int MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param edges pointer toward the table of the edges extremities.
+ * Extremities of the \f$i^{th}\f$ edge are stored in edges[(i-1)*2]\@2.
+ * \param refs pointer toward the table of the edges references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ edge.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set extremities and references of all the mesh edges in one pass.
+ *
+ */
+int MMG5_Set_edges(MMG5_pMesh mesh, MMG5_int *edges, int *refs) {
+    MMG5_pEdge pa;
+    MMG5_int   i,j;
+
+    if ( !mesh->na ) {
+        fprintf(stdout,"  ## Error: You must set the number of edges with the");
+        fprintf(stdout," MMG5_Set_meshSize function before setting edges in mesh\n");
+        return(0);
+    }
+
+    for (i=1; i<=mesh->na; i++) {
+        pa  = &mesh->edge[i];
+        j   = 2*(i-1);
+        pa->a    = edges[j];
+        pa->b    = edges[j+1];
+        pa->ref  = refs ? refs[i-1] : 0;
+        pa->tag |= MG_REF;
+    }
+
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param edges pointer toward the table of the edges extremities.
+ * Extremities of the \f$i^{th}\f$ edge are stored in edges[(i-1)*2]\@2.
+ * \param refs pointer toward the table of the edges references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ edge.
+ * \param areRidges pointer toward the table of the flags saying if the
+ * edges are ridges (may be NULL).
+ * areRidges[i-1]=1 if the \f$i^{th}\f$ edge is ridge.
+ * \param areRequired pointer toward the table of the flags saying if the
+ * edges are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ edge is required.
+ * \return 1.
+ *
+ * Get extremities and references of all the mesh edges in one pass.
+ *
+ */
+int MMG5_Get_edges(MMG5_pMesh mesh, MMG5_int* edges, int* refs,
+                   int* areRidges, int* areRequired) {
+    MMG5_pEdge pa;
+    MMG5_int   i,j;
+
+    for (i=1; i<=mesh->na; i++) {
+        pa = &mesh->edge[i];
+        j  = 2*(i-1);
+        edges[j]   = pa->a;
+        edges[j+1] = pa->b;
+
+        if ( refs != NULL )
+            refs[i-1] = pa->ref;
+        if ( areRidges != NULL )
+            areRidges[i-1] = (pa->tag & MG_GEO) ? 1 : 0;
+        if ( areRequired != NULL )
+            areRequired[i-1] = (pa->tag & MG_REQ) ? 1 : 0;
+    }
+    mesh->nai = mesh->na;
+
+    return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param k vertex index.
@@ -993,7 +1372,7 @@ int MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref
  * Set corner at point \a k.
  *
  */
-int MMG5_Set_corner(MMG5_pMesh mesh, int k) {
+int MMG5_Set_corner(MMG5_pMesh mesh, MMG5_int k) {
     assert ( k <= mesh->np );
     mesh->point[k].tag |= MG_CRN;
     return(1);
@@ -1007,7 +1386,7 @@ int MMG5_Set_corner(MMG5_pMesh mesh, int k) {
  * Set point \a k as required.
  *
  */
-int MMG5_Set_requiredVertex(MMG5_pMesh mesh, int k) {
+int MMG5_Set_requiredVertex(MMG5_pMesh mesh, MMG5_int k) {
     assert ( k <= mesh->np );
     mesh->point[k].tag |= MG_REQ;
     return(1);
@@ -1021,7 +1400,7 @@ int MMG5_Set_requiredVertex(MMG5_pMesh mesh, int k) {
  * Set element \a k as required.
  *
  */
-int MMG5_Set_requiredTetrahedron(MMG5_pMesh mesh, int k) {
+int MMG5_Set_requiredTetrahedron(MMG5_pMesh mesh, MMG5_int k) {
     assert ( k <= mesh->ne );
     mesh->tetra[k].tag |= MG_REQ;
     return(1);
@@ -1035,7 +1414,7 @@ int MMG5_Set_requiredTetrahedron(MMG5_pMesh mesh, int k) {
  * Set triangle \a k as required.
  *
  */
-int MMG5_Set_requiredTriangle(MMG5_pMesh mesh, int k) {
+int MMG5_Set_requiredTriangle(MMG5_pMesh mesh, MMG5_int k) {
     assert ( k <= mesh->nt );
     mesh->tria[k].tag[0] |= MG_REQ;
     mesh->tria[k].tag[1] |= MG_REQ;
@@ -1051,7 +1430,7 @@ int MMG5_Set_requiredTriangle(MMG5_pMesh mesh, int k) {
  * Set ridge at edge \a k.
  *
  */
-int MMG5_Set_ridge(MMG5_pMesh mesh, int k) {
+int MMG5_Set_ridge(MMG5_pMesh mesh, MMG5_int k) {
     assert ( k <= mesh->na );
     mesh->edge[k].tag |= MG_GEO;
     return(1);
@@ -1065,7 +1444,7 @@ int MMG5_Set_ridge(MMG5_pMesh mesh, int k) {
  * Set edge \a k as required.
  *
  */
-int MMG5_Set_requiredEdge(MMG5_pMesh mesh, int k) {
+int MMG5_Set_requiredEdge(MMG5_pMesh mesh, MMG5_int k) {
     assert ( k <= mesh->na );
     mesh->edge[k].tag |= MG_REQ;
     return(1);
@@ -1080,7 +1459,7 @@ int MMG5_Set_requiredEdge(MMG5_pMesh mesh, int k) {
  * Set scalar value \a s at position \a pos in solution structure
  *
  */
-int MMG5_Set_scalarSol(MMG5_pSol met, double s, int pos) {
+int MMG5_Set_scalarSol(MMG5_pSol met, double s, MMG5_int pos) {
 
     if ( !met->np ) {
         fprintf(stdout,"  ## Error: You must set the number of solution with the");
@@ -1091,13 +1470,13 @@ int MMG5_Set_scalarSol(MMG5_pSol met, double s, int pos) {
 
     if ( pos >= met->npmax ) {
         fprintf(stdout,"  ## Error: unable to set a new solution.\n");
-        fprintf(stdout,"    max number of solutions: %d\n",met->npmax);
+        fprintf(stdout,"    max number of solutions: %" MMG5_PRId "\n",met->npmax);
         return(0);
     }
 
     if ( pos > met->np ) {
-        fprintf(stdout,"  ## Error: attempt to set new solution at position %d.",pos);
-        fprintf(stdout," Overflow of the given number of solutions: %d\n",met->np);
+        fprintf(stdout,"  ## Error: attempt to set new solution at position %" MMG5_PRId ".",pos);
+        fprintf(stdout," Overflow of the given number of solutions: %" MMG5_PRId "\n",met->np);
         fprintf(stdout,"  ## Check the solution size, its compactness or the position");
         fprintf(stdout," of the solution.\n");
         return(0);
@@ -1122,7 +1501,7 @@ int MMG5_Get_scalarSol(MMG5_pSol met, double* s) {
     if ( met->npi > met->np ) {
         fprintf(stdout,"  ## Error: unable to get solution.\n");
         fprintf(stdout,"     The number of call of MMG5_Get_scalarSol function");
-        fprintf(stdout," can not exceed the number of points: %d\n ",met->np);
+        fprintf(stdout," can not exceed the number of points: %" MMG5_PRId "\n ",met->np);
         return(0);
     }
 
@@ -1131,6 +1510,97 @@ int MMG5_Get_scalarSol(MMG5_pSol met, double* s) {
     return(1);
 }
 
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 value of the tensorial solution at position (1,1) in the tensor.
+ * \param m12 value of the tensorial solution at position (1,2) in the tensor.
+ * \param m13 value of the tensorial solution at position (1,3) in the tensor.
+ * \param m22 value of the tensorial solution at position (2,2) in the tensor.
+ * \param m23 value of the tensorial solution at position (2,3) in the tensor.
+ * \param m33 value of the tensorial solution at position (3,3) in the tensor.
+ * \param pos position of the solution in the mesh (begin to 1).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set tensorial values at position \a pos in solution structure.
+ *
+ */
+int MMG5_Set_tensorSol(MMG5_pSol met, double m11,double m12, double m13,
+                       double m22,double m23, double m33, MMG5_int pos) {
+    MMG5_int iadr;
+
+    if ( met->size != 6 ) {
+        fprintf(stdout,"  ## Error: the solution is not tensorial.\n");
+        return(0);
+    }
+
+    if ( !met->np ) {
+        fprintf(stdout,"  ## Error: You must set the number of solution with the");
+        fprintf(stdout," MMG5_Set_solSize function before setting values");
+        fprintf(stdout," in solution structure \n");
+        return(0);
+    }
+
+    if ( pos >= met->npmax ) {
+        fprintf(stdout,"  ## Error: unable to set a new solution.\n");
+        fprintf(stdout,"    max number of solutions: %" MMG5_PRId "\n",met->npmax);
+        return(0);
+    }
+
+    if ( pos > met->np ) {
+        fprintf(stdout,"  ## Error: attempt to set new solution at position %" MMG5_PRId ".",pos);
+        fprintf(stdout," Overflow of the given number of solutions: %" MMG5_PRId "\n",met->np);
+        fprintf(stdout,"  ## Check the solution size, its compactness or the position");
+        fprintf(stdout," of the solution.\n");
+        return(0);
+    }
+
+    iadr = (pos-1)*met->size + 1;
+    met->m[iadr]   = m11;
+    met->m[iadr+1] = m12;
+    met->m[iadr+2] = m13;
+    met->m[iadr+3] = m22;
+    met->m[iadr+4] = m23;
+    met->m[iadr+5] = m33;
+    return(1);
+}
+
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 pointer toward the position (1,1) in the solution tensor.
+ * \param m12 pointer toward the position (1,2) in the solution tensor.
+ * \param m13 pointer toward the position (1,3) in the solution tensor.
+ * \param m22 pointer toward the position (2,2) in the solution tensor.
+ * \param m23 pointer toward the position (2,3) in the solution tensor.
+ * \param m33 pointer toward the position (3,3) in the solution tensor.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get tensorial solution of next vertex of mesh.
+ *
+ */
+int MMG5_Get_tensorSol(MMG5_pSol met, double *m11,double *m12, double *m13,
+                       double *m22,double *m23, double *m33) {
+    MMG5_int iadr;
+
+    met->npi++;
+
+    if ( met->npi > met->np ) {
+        fprintf(stdout,"  ## Error: unable to get solution.\n");
+        fprintf(stdout,"     The number of call of MMG5_Get_tensorSol function");
+        fprintf(stdout," can not exceed the number of points: %" MMG5_PRId "\n ",met->np);
+        return(0);
+    }
+
+    iadr = (met->npi-1)*met->size + 1;
+    *m11 = met->m[iadr];
+    *m12 = met->m[iadr+1];
+    *m13 = met->m[iadr+2];
+    *m22 = met->m[iadr+3];
+    *m23 = met->m[iadr+4];
+    *m33 = met->m[iadr+5];
+
+    return(1);
+}
+
 
 /**
  * \param mesh pointer toward the mesh structure.
@@ -1140,7 +1610,7 @@ int MMG5_Get_scalarSol(MMG5_pSol met, double* s) {
  *
  */
 void MMG5_Set_handGivenMesh(MMG5_pMesh mesh) {
-    int k, aux;
+    MMG5_int k, aux;
 
     /* Possibly switch 2 vertices number so that each tet is positively oriented */
     for (k=1; k<=mesh->ne; k++) {
@@ -1218,7 +1688,7 @@ static inline
 int MMG5_skipIso(MMG5_pMesh mesh) {
     MMG5_pTria  ptt,ptt1;
     MMG5_pEdge  pa,pa1;
-    int    k;
+    MMG5_int k;
 
     if ( (mesh->info.imprim > 5) || mesh->info.ddebug )
         fprintf(stdout,"  ## Warning: skip of all entites with %d reference.\n",MG_ISO);
@@ -1322,7 +1792,30 @@ int MMG5_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam, int val){
     case MMG5_IPARAM_bucket :
         mesh->info.bucket   = val;
         break;
+    case MMG5_IPARAM_threads :
+#ifdef USE_OPENMP
+        if ( val <= 0 ) {
+            fprintf(stdout,"  ## Warning: number of threads must be strictly positive.\n");
+            fprintf(stdout,"  Reset to default value.\n");
+            mesh->info.threads = 1;
+        }
+        else
+            mesh->info.threads  = val;
+#else
+        if ( val > 1 ) {
+            fprintf(stdout,"  ## Warning: multithreading not available (compile");
+            fprintf(stdout," with the USE_OPENMP option). Ignored.\n");
+        }
+        mesh->info.threads  = 1;
+#endif
+        break;
+    case MMG5_IPARAM_queue :
+        mesh->info.queue    = val ? 1 : 0;
+        break;
 #endif
+    case MMG5_IPARAM_growth :
+        mesh->info.growth   = val ? 1 : 0;
+        break;
     case MMG5_IPARAM_debug :
         mesh->info.ddebug   = val;
         break;
@@ -1377,11 +1870,20 @@ int MMG5_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam, int val){
         }
 
         break;
-#ifdef USE_SCOTCH
     case MMG5_IPARAM_renum :
+#ifndef USE_SCOTCH
+        if ( val == _MMG5_RENUM_SCOTCH ) {
+            fprintf(stdout,"  ## Warning: Scotch renumbering not available (compile");
+            fprintf(stdout," with the USE_SCOTCH option). Ignored.\n");
+            val = 0;
+        }
+#endif
+        if ( val < 0 || val > _MMG5_RENUM_MORTON ) {
+            fprintf(stdout,"  ## Warning: unknown renumbering %d. Ignored.\n",val);
+            val = 0;
+        }
         mesh->info.renum    = val;
         break;
-#endif
     default :
         fprintf(stdout,"  ## Error: unknown type of parameter\n");
         return(0);
@@ -1555,7 +2057,7 @@ void MMG5_Free_structures(MMG5_pMesh mesh,MMG5_pSol met
         _MMG5_DEL_MEM(mesh,mesh->edge,(mesh->na+1)*sizeof(MMG5_Edge));
 
     if ( mesh->adja )
-        _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+        _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(MMG5_int));
 
     if ( mesh->xpoint )
         _MMG5_DEL_MEM(mesh,mesh->xpoint,(mesh->xpmax+1)*sizeof(MMG5_xPoint));
@@ -204,7 +204,7 @@ FORTRAN_NAME(MMG5_SET_INPUTSINGULNAME,mmg5_set_inputsingulname,
  */
 FORTRAN_NAME(MMG5_SET_SOLSIZE,mmg5_set_solsize,
              (MMG5_pMesh *mesh, MMG5_pSol *sol, int* typEntity,
-              int* np, int* typSol, int* retval),
+              MMG5_int* np, int* typSol, int* retval),
              (mesh, sol, typEntity, np, typSol, retval)) {
     *retval = MMG5_Set_solSize(*mesh,*sol,*typEntity,*np,*typSol);
     return;
@@ -214,7 +214,7 @@ FORTRAN_NAME(MMG5_SET_SOLSIZE,mmg5_set_solsize,
  * See \ref MMG5_Set_meshSize function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_MESHSIZE,mmg5_set_meshsize,
-             (MMG5_pMesh *mesh, int *np, int *ne, int *nt, int *na, int *retval),
+             (MMG5_pMesh *mesh, MMG5_int *np, MMG5_int *ne, MMG5_int *nt, MMG5_int *na, int *retval),
              (mesh,np,ne,nt,na,retval)) {
     *retval = MMG5_Set_meshSize(*mesh,*np,*ne,*nt,*na);
     return;
@@ -236,7 +236,7 @@ FORTRAN_NAME(MMG5_SET_SINGULSIZE,mmg5_set_singulsze,
  * See \ref MMG5_Get_solSize function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_GET_SOLSIZE,mmg5_get_solsize,
-             (MMG5_pMesh *mesh, MMG5_pSol *sol, int* typEntity, int* np, int* typSol, int* retval),
+             (MMG5_pMesh *mesh, MMG5_pSol *sol, int* typEntity, MMG5_int* np, int* typSol, int* retval),
              (mesh,sol,typEntity,np,typSol,retval)) {
 
     *retval = MMG5_Get_solSize(*mesh,*sol,typEntity,np,typSol);
@@ -247,19 +247,30 @@ FORTRAN_NAME(MMG5_GET_SOLSIZE,mmg5_get_solsize,
  * See \ref MMG5_Get_meshSize function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_GET_MESHSIZE,mmg5_get_meshsize,
-             (MMG5_pMesh *mesh, int* np, int* ne, int* nt, int* na, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int* np, MMG5_int* ne, MMG5_int* nt, MMG5_int* na, int* retval),
              (mesh,np,ne,nt, na,retval)) {
 
     *retval = MMG5_Get_meshSize(*mesh,np,ne,nt,na);
     return;
 }
 
+/**
+ * See \ref MMG5_Get_estimatedSize function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_ESTIMATEDSIZE,mmg5_get_estimatedsize,
+             (MMG5_pMesh *mesh, MMG5_pSol *met, MMG5_int* np, MMG5_int* ne, int* retval),
+             (mesh,met,np,ne,retval)) {
+
+    *retval = MMG5_Get_estimatedSize(*mesh,*met,np,ne);
+    return;
+}
+
 /**
  * See \ref MMG5_Set_vertex function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_VERTEX,mmg5_set_vertex,
              (MMG5_pMesh *mesh, double* c0, double* c1, double* c2, int* ref,
-              int* pos, int* retval),
+              MMG5_int* pos, int* retval),
              (mesh,c0,c1,c2,ref,pos,retval)) {
 
     *retval = MMG5_Set_vertex(*mesh,*c0,*c1,*c2,*ref,*pos);
@@ -277,12 +288,33 @@ FORTRAN_NAME(MMG5_GET_VERTEX,mmg5_get_vertex,
     return;
 }
 
+/**
+ * See \ref MMG5_Set_vertices function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_VERTICES,mmg5_set_vertices,
+             (MMG5_pMesh *mesh, double* vertices, int* refs, int* retval),
+             (mesh,vertices,refs,retval)) {
+    *retval = MMG5_Set_vertices(*mesh,vertices,refs);
+    return;
+}
+
+/**
+ * See \ref MMG5_Get_vertices function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_VERTICES,mmg5_get_vertices,
+             (MMG5_pMesh *mesh, double* vertices, int* refs,
+              int* areCorners, int* areRequired, int* retval),
+             (mesh,vertices,refs,areCorners,areRequired, retval)) {
+    *retval = MMG5_Get_vertices(*mesh,vertices,refs,areCorners,areRequired);
+    return;
+}
+
 /**
  * See \ref MMG5_Set_tetrahedron function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_TETRAHEDRON,mmg5_set_tetrahedron,
-             (MMG5_pMesh *mesh, int *v0, int *v1, int *v2, int *v3, int *ref,
-              int *pos, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *v0, MMG5_int *v1, MMG5_int *v2, MMG5_int *v3, int *ref,
+              MMG5_int *pos, int* retval),
              (mesh,v0,v1,v2,v3,ref,pos,retval)){
     *retval = MMG5_Set_tetrahedron(*mesh,*v0,*v1,*v2,*v3,*ref,*pos);
     return;
@@ -292,18 +324,39 @@ FORTRAN_NAME(MMG5_SET_TETRAHEDRON,mmg5_set_tetrahedron,
  * See \ref MMG5_Get_tetrahedron function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_GET_TETRAHEDRON,mmg5_get_tetrahedron,
-             (MMG5_pMesh *mesh, int* v0, int* v1, int* v2, int* v3,
+             (MMG5_pMesh *mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, MMG5_int* v3,
               int* ref, int* isRequired, int* retval),
              (mesh,v0,v1,v2,v3,ref,isRequired,retval)) {
     *retval = MMG5_Get_tetrahedron(*mesh,v0,v1,v2,v3,ref,isRequired);
     return;
 }
 
+/**
+ * See \ref MMG5_Set_tetrahedra function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_TETRAHEDRA,mmg5_set_tetrahedra,
+             (MMG5_pMesh *mesh, MMG5_int *tetra, int *refs, int* retval),
+             (mesh,tetra,refs,retval)) {
+    *retval = MMG5_Set_tetrahedra(*mesh,tetra,refs);
+    return;
+}
+
+/**
+ * See \ref MMG5_Get_tetrahedra function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_TETRAHEDRA,mmg5_get_tetrahedra,
+             (MMG5_pMesh *mesh, MMG5_int* tetra, int* refs, int* areRequired,
+              int* retval),
+             (mesh,tetra,refs,areRequired,retval)) {
+    *retval = MMG5_Get_tetrahedra(*mesh,tetra,refs,areRequired);
+    return;
+}
+
 /**
  * See \ref MMG5_Set_triangle function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_TRIANGLE,mmg5_set_triangle,
-             (MMG5_pMesh *mesh, int* v0, int* v1, int* v2, int* ref,int* pos,
+             (MMG5_pMesh *mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, int* ref,MMG5_int* pos,
               int* retval),
              (mesh,v0,v1,v2,ref,pos,retval)) {
     *retval = MMG5_Set_triangle(*mesh, *v0, *v1, *v2, *ref, *pos);
@@ -314,18 +367,39 @@ FORTRAN_NAME(MMG5_SET_TRIANGLE,mmg5_set_triangle,
  * See \ref MMG5_Get_triangle function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_GET_TRIANGLE,mmg5_get_triangle,
-             (MMG5_pMesh *mesh, int* v0, int* v1, int* v2, int* ref
+             (MMG5_pMesh *mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, int* ref
               ,int* isRequired, int* retval),
              (mesh,v0,v1,v2,ref,isRequired,retval)) {
     *retval = MMG5_Get_triangle(*mesh,v0,v1,v2,ref,isRequired);
     return;
 }
 
+/**
+ * See \ref MMG5_Set_triangles function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_TRIANGLES,mmg5_set_triangles,
+             (MMG5_pMesh *mesh, MMG5_int* tria, int* refs, int* retval),
+             (mesh,tria,refs,retval)) {
+    *retval = MMG5_Set_triangles(*mesh,tria,refs);
+    return;
+}
+
+/**
+ * See \ref MMG5_Get_triangles function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_TRIANGLES,mmg5_get_triangles,
+             (MMG5_pMesh *mesh, MMG5_int* tria, int* refs, int* areRequired,
+              int* retval),
+             (mesh,tria,refs,areRequired,retval)) {
+    *retval = MMG5_Get_triangles(*mesh,tria,refs,areRequired);
+    return;
+}
+
 /**
  * See \ref MMG5_Set_edge function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_EDGE,mmg5_set_edge,
-             (MMG5_pMesh *mesh, int *v0, int *v1, int *ref, int *pos, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *v0, MMG5_int *v1, int *ref, MMG5_int *pos, int* retval),
              (mesh,v0,v1,ref,pos,retval)){
     *retval = MMG5_Set_edge(*mesh,*v0,*v1,*ref,*pos);
     return;
@@ -334,17 +408,38 @@ FORTRAN_NAME(MMG5_SET_EDGE,mmg5_set_edge,
 /**
  * See \ref MMG5_Get_edge function in \ref mmg3d/libmmg3d.h file.
  */
-FORTRAN_NAME(MMG5_GET_EDGE,mmg5_get_edge,(MMG5_pMesh *mesh, int* e0, int* e1, int* ref
+FORTRAN_NAME(MMG5_GET_EDGE,mmg5_get_edge,(MMG5_pMesh *mesh, MMG5_int* e0, MMG5_int* e1, int* ref
                                           ,int* isRidge, int* isRequired, int* retval),
              (mesh,e0,e1,ref,isRidge,isRequired,retval)) {
     *retval = MMG5_Get_edge(*mesh,e0,e1,ref,isRidge,isRequired);
     return;
 }
 
+/**
+ * See \ref MMG5_Set_edges function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_EDGES,mmg5_set_edges,
+             (MMG5_pMesh *mesh, MMG5_int *edges, int *refs, int* retval),
+             (mesh,edges,refs,retval)) {
+    *retval = MMG5_Set_edges(*mesh,edges,refs);
+    return;
+}
+
+/**
+ * See \ref MMG5_Get_edges function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_EDGES,mmg5_get_edges,
+             (MMG5_pMesh *mesh, MMG5_int* edges, int* refs, int* areRidges,
+              int* areRequired, int* retval),
+             (mesh,edges,refs,areRidges,areRequired,retval)) {
+    *retval = MMG5_Get_edges(*mesh,edges,refs,areRidges,areRequired);
+    return;
+}
+
 /**
  * See \ref MMG5_Set_corner function in \ref mmg3d/libmmg3d.h file.
  */
-FORTRAN_NAME(MMG5_SET_CORNER,mmg5_set_corner,(MMG5_pMesh *mesh, int *k, int* retval),
+FORTRAN_NAME(MMG5_SET_CORNER,mmg5_set_corner,(MMG5_pMesh *mesh, MMG5_int *k, int* retval),
              (mesh,k,retval)) {
     *retval =  MMG5_Set_corner(*mesh,*k);
     return;
@@ -354,7 +449,7 @@ FORTRAN_NAME(MMG5_SET_CORNER,mmg5_set_corner,(MMG5_pMesh *mesh, int *k, int* ret
  * See \ref MMG5_Set_requiredVertex function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_REQUIREDVERTEX,mmg5_set_requiredvertex,
-             (MMG5_pMesh *mesh, int *k, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *k, int* retval),
              (mesh,k,retval)) {
     *retval =  MMG5_Set_requiredVertex(*mesh,*k);
     return;
@@ -364,7 +459,7 @@ FORTRAN_NAME(MMG5_SET_REQUIREDVERTEX,mmg5_set_requiredvertex,
  * See \ref MMG5_Set_requiredTetrahedron function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_REQUIREDTETRAHEDRON,mmg5_set_requiredtetrahedron,
-             (MMG5_pMesh *mesh, int *k, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *k, int* retval),
              (mesh,k,retval)) {
     *retval = MMG5_Set_requiredTetrahedron(*mesh,*k);
     return;
@@ -374,7 +469,7 @@ FORTRAN_NAME(MMG5_SET_REQUIREDTETRAHEDRON,mmg5_set_requiredtetrahedron,
  * See \ref MMG5_Set_requiredTriangle function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_REQUIREDTRIANGLE,mmg5_set_requiredtriangle,
-             (MMG5_pMesh *mesh, int *k, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *k, int* retval),
              (mesh,k,retval)) {
     *retval = MMG5_Set_requiredTriangle(*mesh, *k);
     return;
@@ -384,7 +479,7 @@ FORTRAN_NAME(MMG5_SET_REQUIREDTRIANGLE,mmg5_set_requiredtriangle,
  * See \ref MMG5_Set_ridge function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_RIDGE,mmg5_set_ridge,
-             (MMG5_pMesh *mesh, int *k, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *k, int* retval),
              (mesh,k,retval)) {
     *retval = MMG5_Set_ridge(*mesh,*k);
     return;
@@ -394,7 +489,7 @@ FORTRAN_NAME(MMG5_SET_RIDGE,mmg5_set_ridge,
  * See \ref MMG5_Set_requiredEdge function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_REQUIREDEDGE,mmg5_set_requirededge,
-             (MMG5_pMesh *mesh, int *k, int* retval),
+             (MMG5_pMesh *mesh, MMG5_int *k, int* retval),
              (mesh,k,retval)) {
     *retval = MMG5_Set_requiredEdge(*mesh,*k);
     return;
@@ -404,7 +499,7 @@ FORTRAN_NAME(MMG5_SET_REQUIREDEDGE,mmg5_set_requirededge,
  * See \ref MMG5_Set_scalarSol function in \ref mmg3d/libmmg3d.h file.
  */
 FORTRAN_NAME(MMG5_SET_SCALARSOL,mmg5_set_scalarsol,
-             (MMG5_pSol *met, double *s, int *pos, int* retval),
+             (MMG5_pSol *met, double *s, MMG5_int *pos, int* retval),
              (met,s,pos,retval)) {
     *retval = MMG5_Set_scalarSol(*met,*s,*pos);
     return;
@@ -420,6 +515,28 @@ FORTRAN_NAME(MMG5_GET_SCALARSOL,mmg5_get_scalarsol,
     return;
 }
 
+/**
+ * See \ref MMG5_Set_tensorSol function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_TENSORSOL,mmg5_set_tensorsol,
+             (MMG5_pSol *met, double* m11,double *m12, double *m13,
+              double *m22,double *m23, double *m33, MMG5_int *pos, int* retval),
+             (met,m11,m12,m13,m22,m23,m33,pos,retval)) {
+    *retval = MMG5_Set_tensorSol(*met,*m11,*m12,*m13,*m22,*m23,*m33,*pos);
+    return;
+}
+
+/**
+ * See \ref MMG5_Get_tensorSol function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_TENSORSOL,mmg5_get_tensorsol,
+             (MMG5_pSol *met, double* m11,double *m12, double *m13,
+              double *m22,double *m23, double *m33, int* retval),
+             (met,m11,m12,m13,m22,m23,m33,retval)) {
+    *retval = MMG5_Get_tensorSol(*met,m11,m12,m13,m22,m23,m33);
+    return;
+}
+
 #ifdef SINGUL
 /**
  * See \ref MMG5_Set_singulVertex function in \ref mmg3d/libmmg3d.h file.
@@ -45,12 +45,13 @@
 static int _MMG5_setadj(MMG5_pMesh mesh){
     MMG5_pTria   pt,pt1;
     MMG5_pPoint  ppt;
-    int    *adja,*adjb,adji1,adji2,*pile,iad,ipil,ip1,ip2,gen;
-    int     k,kk,iel,jel,nf,np,nr,nt,nre,nreq,ncc,ned,nvf,edg;
+    MMG5_int *adja,*adjb,adji1,adji2,*pile,iad,ipil,ip1,ip2,gen;
+    MMG5_int k,kk,iel,jel,nf,np,nr,nt,nre,nreq,ncc,ned,nvf;
+    int      edg;
     char    i,ii,i1,i2,ii1,ii2,voy,tag;
 
     nvf = nf = ncc = ned = 0;
-    _MMG5_SAFE_MALLOC(pile,mesh->nt+1,int);
+    _MMG5_SAFE_MALLOC(pile,mesh->nt+1,MMG5_int);
 
     pile[1] = 1;
     ipil    = 1;
@@ -105,7 +106,7 @@ static int _MMG5_setadj(MMG5_pMesh mesh){
                 }
 
                 if ( pt1->flag == 0 ) {
-                    pt1->flag    = ncc;
+                    pt1->flag    = (int)ncc;
                     pile[++ipil] = kk;
                 }
 
@@ -163,7 +164,7 @@ static int _MMG5_setadj(MMG5_pMesh mesh){
             if ( MG_EOK(pt) && (pt->flag == 0) ) {
                 ipil = 1;
                 pile[ipil] = kk;
-                pt->flag   = ncc+1;
+                pt->flag   = (int)(ncc+1);
                 break;
             }
         }
@@ -192,15 +193,15 @@ static int _MMG5_setadj(MMG5_pMesh mesh){
         }
     }
     if ( mesh->info.ddebug ) {
-        fprintf(stdout,"  a- ridges: %d found.\n",nr);
-        fprintf(stdout,"  a- requir: %d found.\n",nreq);
-        fprintf(stdout,"  a- connex: %d connected component(s)\n",ncc);
-        fprintf(stdout,"  a- orient: %d flipped\n",nf);
+        fprintf(stdout,"  a- ridges: %" MMG5_PRId " found.\n",nr);
+        fprintf(stdout,"  a- requir: %" MMG5_PRId " found.\n",nreq);
+        fprintf(stdout,"  a- connex: %" MMG5_PRId " connected component(s)\n",ncc);
+        fprintf(stdout,"  a- orient: %" MMG5_PRId " flipped\n",nf);
     }
     else if ( abs(mesh->info.imprim) > 3 ) {
         gen = (2 - nvf + ned - nt) / 2;
-        fprintf(stdout,"     Connected component: %d,  genus: %d,   reoriented: %d\n",ncc,gen,nf);
-        fprintf(stdout,"     Edges: %d,  tagged: %d,  ridges: %d, required: %d, refs: %d\n",
+        fprintf(stdout,"     Connected component: %" MMG5_PRId ",  genus: %" MMG5_PRId ",   reoriented: %" MMG5_PRId "\n",ncc,gen,nf);
+        fprintf(stdout,"     Edges: %" MMG5_PRId ",  tagged: %" MMG5_PRId ",  ridges: %" MMG5_PRId ", required: %" MMG5_PRId ", refs: %" MMG5_PRId "\n",
                 ned,nr+nre+nreq,nr,nreq,nre);
     }
     _MMG5_SAFE_FREE(pile);
@@ -211,7 +212,7 @@ static int _MMG5_setadj(MMG5_pMesh mesh){
 static int _MMG5_setdhd(MMG5_pMesh mesh) {
     MMG5_pTria    pt,pt1;
     double   n1[3],n2[3],dhd;
-    int     *adja,k,kk,ne,nr;
+    MMG5_int *adja,k,kk,ne,nr;
     char     i,ii,i1,i2;
 
     ne = nr = 0;
@@ -261,7 +262,7 @@ static int _MMG5_setdhd(MMG5_pMesh mesh) {
         }
     }
     if ( abs(mesh->info.imprim) > 3 && nr > 0 )
-        fprintf(stdout,"     %d ridges, %d edges updated\n",nr,ne);
+        fprintf(stdout,"     %" MMG5_PRId " ridges, %" MMG5_PRId " edges updated\n",nr,ne);
 
     return(1);
 }
@@ -271,7 +272,8 @@ static int _MMG5_singul(MMG5_pMesh mesh) {
     MMG5_pTria     pt;
     MMG5_pPoint    ppt,p1,p2;
     double    ux,uy,uz,vx,vy,vz,dd;
-    int       list[_MMG5_LMAX+2],k,nc,ng,nr,ns,nre;
+    MMG5_int  list[_MMG5_LMAX+2],k,nc,nre;
+    int       ng,nr,ns;
     char      i;
 
     nre = nc = 0;
@@ -329,7 +331,7 @@ static int _MMG5_singul(MMG5_pMesh mesh) {
     }
 
     if ( abs(mesh->info.imprim) > 3 && nre > 0 )
-        fprintf(stdout,"     %d corners, %d singular points detected\n",nc,nre);
+        fprintf(stdout,"     %" MMG5_PRId " corners, %" MMG5_PRId " singular points detected\n",nc,nre);
     return(1);
 }
 
@@ -339,7 +341,7 @@ static int _MMG5_norver(MMG5_pMesh mesh) {
     MMG5_pPoint    ppt;
     MMG5_xPoint   *pxp;
     double    n[3],dd;
-    int      *adja,k,kk,ng,nn,nt,nf;
+    MMG5_int *adja,k,kk,ng,nn,nt,nf;
     char      i,ii,i1;
     /* recomputation of normals only if mesh->xpoint has been freed */
     if ( mesh->xpoint ) {
@@ -474,7 +476,7 @@ static int _MMG5_norver(MMG5_pMesh mesh) {
         }
     }
     if ( abs(mesh->info.imprim) > 3 && nn+nt > 0 )
-        fprintf(stdout,"     %d normals,  %d tangents updated  (%d failed)\n",nn,nt,nf);
+        fprintf(stdout,"     %" MMG5_PRId " normals,  %" MMG5_PRId " tangents updated  (%" MMG5_PRId " failed)\n",nn,nt,nf);
 
     return(1);
 }
@@ -484,8 +486,9 @@ static void _MMG5_nmgeom(MMG5_pMesh mesh){
     MMG5_pTetra     pt;
     MMG5_pPoint     p0;
     MMG5_pxPoint    pxp;
-    int        k,base;
-    int        *adja;
+    MMG5_int   k;
+    int        base;
+    MMG5_int   *adja;
     double     n[3],t[3];
     char       i,j,ip,ier;
 
@@ -631,7 +634,7 @@ int _MMG5_analys(MMG5_pMesh mesh) {
 
     /* release memory */
     _MMG5_DEL_MEM(mesh,mesh->htab.geom,(mesh->htab.max+1)*sizeof(MMG5_hgeom));
-    _MMG5_DEL_MEM(mesh,mesh->adjt,(3*mesh->nt+4)*sizeof(int));
+    _MMG5_DEL_MEM(mesh,mesh->adjt,(3*mesh->nt+4)*sizeof(MMG5_int));
     _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
 
     return(1);
@@ -0,0 +1,370 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/anisosiz.c
+ * \brief Fonctions for anisotropic size map computation.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The metrics are stored as m11 m12 m13 m22 m23 m33 at the address
+ * (ip-1)*met->size+1 of point ip. The interpolation and the gradation of two
+ * metrics are made in the basis of their simultaneous reduction, where both
+ * metrics are diagonal: the sizes along each vector of this basis are
+ * interpolated (or graded) as isotropic sizes.
+ *
+ */
+
+#include "mmg3d.h"
+#include "eigenv.h"
+
+/** relative tolerance on the sizes updated by the gradation */
+#define _MMG5_GRADTOL 1.e-3
+
+/**
+ * \param m first metric.
+ * \param n second metric.
+ * \param hm sizes of \a m along the vectors of the reduction basis.
+ * \param hn sizes of \a n along the vectors of the reduction basis.
+ * \param q rows of the inverse of the reduction basis.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Simultaneous reduction of the metrics \a m and \a n: the vectors
+ * \f$p_i\f$ of the basis \f$P = M^{-1/2} V\f$ are orthonormal for \a m
+ * and orthogonal for \a n (\a V being the eigenvectors of
+ * \f$M^{-1/2} N M^{-1/2}\f$), \a q stores the rows of \f$P^{-1} = {}^tV M^{1/2}\f$.
+ *
+ */
+static int
+_MMG5_simred(double *m,double *n,double hm[3],double hn[3],double q[3][3]) {
+    double   lambda[3],vp[3][3],sq[6],isq[6],mt[9],isnis[6],p[3],l;
+    int      i;
+
+    /* square root and inverse square root of m */
+    if ( !eigenv(1,m,lambda,vp) )  return(0);
+    for (i=0; i<6; i++)  sq[i] = isq[i] = 0.0;
+    for (i=0; i<3; i++) {
+        if ( lambda[i] < _MMG5_EPSD )  return(0);
+        l = sqrt(lambda[i]);
+        sq[0] += l*vp[i][0]*vp[i][0];
+        sq[1] += l*vp[i][0]*vp[i][1];
+        sq[2] += l*vp[i][0]*vp[i][2];
+        sq[3] += l*vp[i][1]*vp[i][1];
+        sq[4] += l*vp[i][1]*vp[i][2];
+        sq[5] += l*vp[i][2]*vp[i][2];
+        l = 1.0 / l;
+        isq[0] += l*vp[i][0]*vp[i][0];
+        isq[1] += l*vp[i][0]*vp[i][1];
+        isq[2] += l*vp[i][0]*vp[i][2];
+        isq[3] += l*vp[i][1]*vp[i][1];
+        isq[4] += l*vp[i][1]*vp[i][2];
+        isq[5] += l*vp[i][2]*vp[i][2];
+    }
+
+    /* M^{-1/2} N M^{-1/2} */
+    mt[0] = n[0]*isq[0] + n[1]*isq[1] + n[2]*isq[2];
+    mt[1] = n[0]*isq[1] + n[1]*isq[3] + n[2]*isq[4];
+    mt[2] = n[0]*isq[2] + n[1]*isq[4] + n[2]*isq[5];
+    mt[3] = n[1]*isq[0] + n[3]*isq[1] + n[4]*isq[2];
+    mt[4] = n[1]*isq[1] + n[3]*isq[3] + n[4]*isq[4];
+    mt[5] = n[1]*isq[2] + n[3]*isq[4] + n[4]*isq[5];
+    mt[6] = n[2]*isq[0] + n[4]*isq[1] + n[5]*isq[2];
+    mt[7] = n[2]*isq[1] + n[4]*isq[3] + n[5]*isq[4];
+    mt[8] = n[2]*isq[2] + n[4]*isq[4] + n[5]*isq[5];
+
+    isnis[0] = isq[0]*mt[0] + isq[1]*mt[3] + isq[2]*mt[6];
+    isnis[1] = isq[0]*mt[1] + isq[1]*mt[4] + isq[2]*mt[7];
+    isnis[2] = isq[0]*mt[2] + isq[1]*mt[5] + isq[2]*mt[8];
+    isnis[3] = isq[1]*mt[1] + isq[3]*mt[4] + isq[4]*mt[7];
+    isnis[4] = isq[1]*mt[2] + isq[3]*mt[5] + isq[4]*mt[8];
+    isnis[5] = isq[2]*mt[2] + isq[4]*mt[5] + isq[5]*mt[8];
+
+    if ( !eigenv(1,isnis,lambda,vp) )  return(0);
+
+    for (i=0; i<3; i++) {
+        if ( lambda[i] < _MMG5_EPSD )  return(0);
+
+        /* p_i = M^{-1/2} v_i is a unit vector of m */
+        p[0] = isq[0]*vp[i][0] + isq[1]*vp[i][1] + isq[2]*vp[i][2];
+        p[1] = isq[1]*vp[i][0] + isq[3]*vp[i][1] + isq[4]*vp[i][2];
+        p[2] = isq[2]*vp[i][0] + isq[4]*vp[i][1] + isq[5]*vp[i][2];
+        hm[i] = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+        hn[i] = hm[i] / sqrt(lambda[i]);
+
+        q[i][0] = sq[0]*vp[i][0] + sq[1]*vp[i][1] + sq[2]*vp[i][2];
+        q[i][1] = sq[1]*vp[i][0] + sq[3]*vp[i][1] + sq[4]*vp[i][2];
+        q[i][2] = sq[2]*vp[i][0] + sq[4]*vp[i][1] + sq[5]*vp[i][2];
+    }
+    return(1);
+}
+
+/**
+ * \param q rows of the inverse of the reduction basis.
+ * \param hm sizes of the first metric along the vectors of the basis.
+ * \param h prescribed sizes along the vectors of the basis.
+ * \param mr computed metric.
+ *
+ * Metric of sizes \a h along the vectors of the reduction basis
+ * computed by \ref _MMG5_simred.
+ *
+ */
+static void _MMG5_simmet(double q[3][3],double hm[3],double h[3],double *mr) {
+    double   mu;
+    int      i;
+
+    for (i=0; i<6; i++)  mr[i] = 0.0;
+    for (i=0; i<3; i++) {
+        mu = hm[i] / h[i];
+        mu = mu*mu;
+        mr[0] += mu*q[i][0]*q[i][0];
+        mr[1] += mu*q[i][0]*q[i][1];
+        mr[2] += mu*q[i][0]*q[i][2];
+        mr[3] += mu*q[i][1]*q[i][1];
+        mr[4] += mu*q[i][1]*q[i][2];
+        mr[5] += mu*q[i][2]*q[i][2];
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param ip1 first extremity of the edge.
+ * \param ip2 second extremity of the edge.
+ * \param ip new point.
+ * \param s parameter of the new point along the edge (0 at \a ip1).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Metric at the point \a ip of parameter \a s along the edge \f$[ip1,ip2]\f$:
+ * the sizes are linearly interpolated in the simultaneous reduction basis of
+ * the metrics of \a ip1 and \a ip2. The metric of \a ip1 or \a ip2 is copied
+ * when the reduction fails.
+ *
+ */
+int _MMG5_intmet_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ip1,MMG5_int ip2,
+                     MMG5_int ip,double s) {
+    double   *m,*n,*mr,hm[3],hn[3],h[3],q[3][3];
+    int      i;
+
+    m  = &met->m[(ip1-1)*met->size+1];
+    n  = &met->m[(ip2-1)*met->size+1];
+    mr = &met->m[(ip-1)*met->size+1];
+
+    if ( !_MMG5_simred(m,n,hm,hn,q) ) {
+        memcpy(mr,s < 0.5 ? m : n,6*sizeof(double));
+        return(0);
+    }
+    for (i=0; i<3; i++)
+        h[i] = (1.0-s)*hm[i] + s*hn[i];
+    _MMG5_simmet(q,hm,h,mr);
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Truncation of the metric: the sizes prescribed by the metric in its
+ * principal directions are bounded by \a hmin and \a hmax and by the
+ * isotropic size of the geometric approximation of the boundary (see
+ * \ref _MMG5_defsiz_iso). A metric of size \a hmax is created when
+ * no metric is given.
+ *
+ */
+int _MMG5_defsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+    MMG5_Sol       iso;
+    MMG5_pPoint    ppt;
+    double         *m,lambda[3],vp[3][3],isqhmin,isqhmax,isqh;
+    MMG5_int       k,iadr;
+    int            i;
+
+    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+        fprintf(stdout,"  ** Defining anisotropic map\n");
+
+    if ( mesh->info.hmax < 0.0 )  mesh->info.hmax = 0.5 * mesh->info.delta;
+
+    isqhmax = 1.0 / (mesh->info.hmax*mesh->info.hmax);
+    isqhmin = mesh->info.hmin > 0.0 ?
+        1.0 / (mesh->info.hmin*mesh->info.hmin) : DBL_MAX;
+
+    /* alloc structure */
+    if ( !met->m ) {
+        met->np    = mesh->np;
+        met->npmax = mesh->npmax;
+        met->size  = 6;
+        met->dim   = 3;
+        _MMG5_ADD_MEM(mesh,(met->size*met->npmax+1)*sizeof(double),"solution",
+                      return(0));
+        _MMG5_SAFE_CALLOC(met->m,met->size*met->npmax+1,double);
+
+        /* init constant size */
+        for (k=1; k<=mesh->np; k++) {
+            iadr = (k-1)*met->size + 1;
+            met->m[iadr] = met->m[iadr+3] = met->m[iadr+5] = isqhmax;
+        }
+    }
+
+    /* isotropic sizes of the geometric approximation */
+    memset(&iso,0,sizeof(MMG5_Sol));
+    iso.size = 1;
+    if ( !_MMG5_defsiz_iso(mesh,&iso) ) {
+        if ( iso.m )  _MMG5_DEL_MEM(mesh,iso.m,(iso.npmax+1)*sizeof(double));
+        return(0);
+    }
+
+    for (k=1; k<=mesh->np; k++) {
+        ppt = &mesh->point[k];
+        if ( !MG_VOK(ppt) )  continue;
+
+        iadr = (k-1)*met->size + 1;
+        m    = &met->m[iadr];
+        if ( !eigenv(1,m,lambda,vp) ) {
+            fprintf(stdout,"  ## Error: unable to diagonalize the metric of"
+                    " the point %" MMG5_PRId ".\n",k);
+            _MMG5_DEL_MEM(mesh,iso.m,(iso.npmax+1)*sizeof(double));
+            return(0);
+        }
+
+        isqh = iso.m[k] > _MMG5_EPSD ? 1.0 / (iso.m[k]*iso.m[k]) : isqhmin;
+        for (i=0; i<3; i++) {
+            lambda[i] = MG_MAX(lambda[i],isqh);
+            lambda[i] = MG_MAX(isqhmax,MG_MIN(isqhmin,lambda[i]));
+        }
+
+        m[0] = lambda[0]*vp[0][0]*vp[0][0] + lambda[1]*vp[1][0]*vp[1][0]
+            + lambda[2]*vp[2][0]*vp[2][0];
+        m[1] = lambda[0]*vp[0][0]*vp[0][1] + lambda[1]*vp[1][0]*vp[1][1]
+            + lambda[2]*vp[2][0]*vp[2][1];
+        m[2] = lambda[0]*vp[0][0]*vp[0][2] + lambda[1]*vp[1][0]*vp[1][2]
+            + lambda[2]*vp[2][0]*vp[2][2];
+        m[3] = lambda[0]*vp[0][1]*vp[0][1] + lambda[1]*vp[1][1]*vp[1][1]
+            + lambda[2]*vp[2][1]*vp[2][1];
+        m[4] = lambda[0]*vp[0][1]*vp[0][2] + lambda[1]*vp[1][1]*vp[1][2]
+            + lambda[2]*vp[2][1]*vp[2][2];
+        m[5] = lambda[0]*vp[0][2]*vp[0][2] + lambda[1]*vp[1][2]*vp[1][2]
+            + lambda[2]*vp[2][2]*vp[2][2];
+    }
+
+    _MMG5_DEL_MEM(mesh,iso.m,(iso.npmax+1)*sizeof(double));
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 1.
+ *
+ * Enforce mesh gradation by truncating the metric: along each vector of the
+ * simultaneous reduction basis of the metrics of the extremities of an edge
+ * of length \a l, the sizes \a h0 and \a h1 are bounded as in the isotropic
+ * case (\f$h_1 \leq h_0 + hgrad \times l\f$).
+ *
+ */
+int _MMG5_gradsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+    MMG5_pTetra    pt;
+    MMG5_pPoint    p0,p1;
+    double         *m0,*m1,l,hn,hm[3],h0[3],h1[3],q[3][3];
+    MMG5_int       ip0,ip1,nu,nup,k;
+    int            it,maxit,up0,up1;
+    char           i,j,ia,i0,i1,l0;
+
+    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+        fprintf(stdout,"  ** Grading anisotropic mesh\n");
+
+    for (k=1; k<=mesh->np; k++)
+        mesh->point[k].flag = mesh->base;
+
+    it  = 0;
+    nup = 0;
+    maxit = 100;
+    do {
+        mesh->base++;
+        nu = 0;
+        for (k=1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+
+            for (i=0; i<4; i++) {
+                for (j=0; j<3; j++) {
+                    ia  = _MMG5_iarf[i][j];
+                    i0  = _MMG5_iare[ia][0];
+                    i1  = _MMG5_iare[ia][1];
+                    ip0 = pt->v[i0];
+                    ip1 = pt->v[i1];
+                    p0  = &mesh->point[ip0];
+                    p1  = &mesh->point[ip1];
+                    if ( p0->flag < mesh->base-1 && p1->flag < mesh->base-1 )  continue;
+
+                    l = (p1->c[0]-p0->c[0])*(p1->c[0]-p0->c[0]) + (p1->c[1]-p0->c[1])*(p1->c[1]-p0->c[1])\
+                        + (p1->c[2]-p0->c[2])*(p1->c[2]-p0->c[2]);
+                    l = sqrt(l);
+
+                    m0 = &met->m[(ip0-1)*met->size+1];
+                    m1 = &met->m[(ip1-1)*met->size+1];
+                    if ( !_MMG5_simred(m0,m1,hm,h1,q) )  continue;
+                    memcpy(h0,hm,3*sizeof(double));
+
+                    /* the sizes are only updated beyond a relative tolerance
+                     * (the reduction is not exact) */
+                    up0 = up1 = 0;
+                    for (l0=0; l0<3; l0++) {
+                        if ( hm[l0] < h1[l0] ) {
+                            hn = hm[l0] + mesh->info.hgrad*l;
+                            if ( h1[l0] > (1.0+_MMG5_GRADTOL)*hn ) {
+                                h1[l0] = hn;
+                                up1 = 1;
+                            }
+                        }
+                        else {
+                            hn = h1[l0] + mesh->info.hgrad*l;
+                            if ( h0[l0] > (1.0+_MMG5_GRADTOL)*hn ) {
+                                h0[l0] = hn;
+                                up0 = 1;
+                            }
+                        }
+                    }
+                    if ( up1 ) {
+                        _MMG5_simmet(q,hm,h1,m1);
+                        p1->flag = mesh->base;
+                        nu++;
+                    }
+                    if ( up0 ) {
+                        _MMG5_simmet(q,hm,h0,m0);
+                        p0->flag = mesh->base;
+                        nu++;
+                    }
+                }
+            }
+        }
+        nup += nu;
+    }
+    while( ++it < maxit && nu > 0 );
+
+    if ( abs(mesh->info.imprim) > 3 )
+        fprintf(stdout,"     gradation: %7" MMG5_PRId " updated, %d iter.\n",nup,it);
+    return(1);
+}
@@ -35,13 +35,11 @@
 
 #include "mmg3d.h"
 
-extern MMG5_Info  info;
-
 /** return average normal of triangles sharing P without crossing ridge */
-int _MMG5_boulen(MMG5_pMesh mesh,int start,int ip,double *nn) {
+int _MMG5_boulen(MMG5_pMesh mesh,MMG5_int start,int ip,double *nn) {
     MMG5_pTria    pt;
     double   n[3],dd;
-    int     *adja,k;
+    MMG5_int *adja,k;
     char     i,i1,i2;
 
     pt = &mesh->tria[start];
@@ -105,11 +103,11 @@ int _MMG5_boulen(MMG5_pMesh mesh,int start,int ip,double *nn) {
 
 
 /** return tangent to curve at ip */
-int _MMG5_boulec(MMG5_pMesh mesh,int start,int ip,double *tt) {
+int _MMG5_boulec(MMG5_pMesh mesh,MMG5_int start,int ip,double *tt) {
     MMG5_pTria    pt;
     MMG5_pPoint   p0,p1,p2;
     double   dd;
-    int     *adja,k;
+    MMG5_int *adja,k;
     char     i,i1,i2;
 
     pt = &mesh->tria[start];
@@ -179,9 +177,10 @@ int _MMG5_boulec(MMG5_pMesh mesh,int start,int ip,double *tt) {
 
 
 /** store edges and return number (ref+geo) incident to ip */
-int _MMG5_bouler(MMG5_pMesh mesh,int start,int ip,int *list,int *ng,int *nr) {
+int _MMG5_bouler(MMG5_pMesh mesh,MMG5_int start,int ip,MMG5_int *list,int *ng,int *nr) {
     MMG5_pTria    pt;
-    int     *adja,k,ns;
+    MMG5_int *adja,k;
+    int      ns;
     char     i,i1,i2;
 
     pt  = &mesh->tria[start];
@@ -240,9 +239,10 @@ int _MMG5_bouler(MMG5_pMesh mesh,int start,int ip,int *list,int *ng,int *nr) {
 /** Return volumic ball (i.e. filled with tetrahedra) of point ip in tetra start.
     Results are stored under the form 4*kel + jel , kel = number of the tetra, jel = local
     index of p within kel */
-int _MMG5_boulevolp (MMG5_pMesh mesh, int start, int ip, int * list){
+int _MMG5_boulevolp (MMG5_pMesh mesh, MMG5_int start, int ip, MMG5_int * list){
     MMG5_pTetra  pt,pt1;
-    int    *adja,nump,ilist,base,cur,k,k1;
+    MMG5_int *adja,nump,k,k1;
+    int     ilist,base,cur;
     char    j,l,i;
 
     base = ++mesh->base;
@@ -285,13 +285,14 @@ int _MMG5_boulevolp (MMG5_pMesh mesh, int start, int ip, int * list){
 /** Define normal and tangent vectors at a non manifold point (ip in start, supported by
     face iface), enumerating its (outer)surfacic ball ; return sng = whether point is singular
     or not */
-int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
+int _MMG5_boulenm(MMG5_pMesh mesh,MMG5_int start,int ip,int iface,
                   double n[3],double t[3]) {
     MMG5_pTetra   pt;
     MMG5_pPoint   p0,p1,ppt;
     double   dd,nt[3],l0,l1;
-    int      base,nump,nr,nnm,k,piv,na,nb,adj,nvstart,fstart,aux,ip0,ip1;
-    int     *adja;
+    MMG5_int nump,k,piv,na,nb,adj,nvstart,fstart,aux,ip0,ip1;
+    int      base,nr,nnm;
+    MMG5_int *adja;
     char     iopp,ipiv,indb,inda,i,ipa,ipb,isface,tag;
     char     indedg[4][4] = { {-1,0,1,2}, {0,-1,3,4}, {1,3,-1,5}, {2,4,5,-1} };
 
@@ -450,9 +451,10 @@ int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
     supported in the outer boundary starting from tet start, with point ip, and face if in tetra
     volumic ball ; list[k] = 4*number of tet + index of point
     surfacic ball : list[k] = 4*number of tet + index of FACE */
-int _MMG5_bouleext(MMG5_pMesh mesh, int start, int ip, int iface, int *listv, int *ilistv, int *lists, int*ilists){
+int _MMG5_bouleext(MMG5_pMesh mesh, MMG5_int start, int ip, int iface, MMG5_int *listv, int *ilistv, MMG5_int *lists, int*ilists){
     MMG5_pTetra pt,pt1;
-    int base,nump,k,k1,*adja,piv,na,nb,adj,cur,nvstart,fstart,aux;
+    MMG5_int nump,k,k1,*adja,piv,na,nb,adj,nvstart,fstart,aux;
+    int base,cur;
     char iopp,ipiv,i,j,l,ipa,ipb,isface;
 
     base = ++mesh->base;
@@ -476,7 +478,7 @@ int _MMG5_bouleext(MMG5_pMesh mesh, int start, int ip, int iface, int *listv, in
         (*ilists)++;
         if ( *ilists >= _MMG5_LMAX ) {
             fprintf(stdout,"  ## Warning: problem in surface remesh process.");
-            fprintf(stdout," Surface ball of point %d contains too many elts.\n",
+            fprintf(stdout," Surface ball of point %" MMG5_PRId " contains too many elts.\n",
                     _MMG5_indPt(mesh,nump));
             fprintf(stdout,"  ##          Try to modify the hausdorff number,");
             fprintf(stdout," or/and the maximum mesh.\n");
@@ -552,7 +554,7 @@ int _MMG5_bouleext(MMG5_pMesh mesh, int start, int ip, int iface, int *listv, in
             /* overflow */
             if ( *ilistv > _MMG5_LMAX-3 ) {
                 fprintf(stdout,"  ## Warning: problem in remesh process.");
-                fprintf(stdout," Volumic ball of point %d contains too many elts.\n",
+                fprintf(stdout," Volumic ball of point %" MMG5_PRId " contains too many elts.\n",
                         _MMG5_indPt(mesh,nump));
                 fprintf(stdout,"  ##          Try to modify the hausdorff number,");
                 fprintf(stdout," or/and the maximum mesh.\n");
@@ -571,11 +573,12 @@ int _MMG5_bouleext(MMG5_pMesh mesh, int start, int ip, int iface, int *listv, in
     start, with point ip, and face if in tetra
     volumic ball ; list[k] = 4*number of tet + index of point
     surfacic ball : list[k] = 4*number of tet + index of FACE */
-int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
-                        int *listv,int *ilistv,int *lists,int*ilists) {
+int _MMG5_boulesurfvolp(MMG5_pMesh mesh,MMG5_int start,int ip,int iface,
+                        MMG5_int *listv,int *ilistv,MMG5_int *lists,int*ilists) {
     MMG5_pTetra  pt,pt1;
     MMG5_pxTetra pxt;
-    int base,nump,k,k1,*adja,piv,na,nb,adj,cur,nvstart,fstart,aux;
+    MMG5_int nump,k,k1,*adja,piv,na,nb,adj,nvstart,fstart,aux;
+    int base,cur;
     char iopp,ipiv,i,j,l,ipa,ipb,isface;
 
     base = ++mesh->base;
@@ -599,7 +602,7 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
         (*ilists)++;
         if ( *ilists >= _MMG5_LMAX ) {
             fprintf(stdout,"  ## Warning: problem in surface remesh process.");
-            fprintf(stdout," Surface ball of point %d contains too many elts.\n",
+            fprintf(stdout," Surface ball of point %" MMG5_PRId " contains too many elts.\n",
                     _MMG5_indPt(mesh,nump));
             fprintf(stdout,"  ##          Try to modify the hausdorff number,");
             fprintf(stdout," or/and the maximum mesh.\n");
@@ -680,7 +683,7 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
             /* overflow */
             if ( *ilistv > _MMG5_LMAX-3 ) {
                 fprintf(stdout,"  ## Warning: problem in remesh process.");
-                fprintf(stdout," Volumic ball of point %d contains too many elts.\n",
+                fprintf(stdout," Volumic ball of point %" MMG5_PRId " contains too many elts.\n",
                         _MMG5_indPt(mesh,nump));
                 fprintf(stdout,"  ##          Try to modify the hausdorff number,");
                 fprintf(stdout," or/and the maximum mesh.\n");
@@ -697,10 +700,10 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
 
 /** Get tag of edge ia in tetra start by travelling its shell until meeting a boundary face */
 static inline int
-_MMG5_gettag(MMG5_pMesh mesh,int start,int ia,int *tag,int *edg) {
+_MMG5_gettag(MMG5_pMesh mesh,MMG5_int start,int ia,int *tag,int *edg) {
     MMG5_pTetra        pt;
     MMG5_pxTetra       pxt;
-    int           na,nb,*adja,adj,piv;
+    MMG5_int      na,nb,*adja,adj,piv;
     unsigned char i,ipa,ipb;
 
     if ( start < 1 )  return(0);
@@ -758,10 +761,10 @@ _MMG5_gettag(MMG5_pMesh mesh,int start,int ia,int *tag,int *edg) {
 
 /** Set tag and edg of edge ia (if need be) in tetra start by travelling its shell */
 inline int
-_MMG5_settag(MMG5_pMesh mesh,int start,int ia,int tag,int edg) {
+_MMG5_settag(MMG5_pMesh mesh,MMG5_int start,int ia,int tag,int edg) {
     MMG5_pTetra        pt;
     MMG5_pxTetra       pxt;
-    int           na,nb,*adja,adj,piv;
+    MMG5_int      na,nb,*adja,adj,piv;
     unsigned char i,ipa,ipb;
 
     assert( start >= 1 );
@@ -854,12 +857,108 @@ _MMG5_settag(MMG5_pMesh mesh,int start,int ia,int tag,int edg) {
     return(1);
 }
 
+/** Remove the tag \a tag of edge ia in tetra start by travelling its shell */
+inline int
+_MMG5_deltag(MMG5_pMesh mesh,MMG5_int start,int ia,int tag) {
+    MMG5_pTetra        pt;
+    MMG5_pxTetra       pxt;
+    MMG5_int      na,nb,*adja,adj,piv;
+    unsigned char i,ipa,ipb;
+
+    assert( start >= 1 );
+    pt = &mesh->tetra[start];
+    assert ( MG_EOK(pt) );
+
+    na   = pt->v[ _MMG5_iare[ia][0] ];
+    nb   = pt->v[ _MMG5_iare[ia][1] ];
+
+    adja = &mesh->adja[4*(start-1)+1];
+    adj = adja[_MMG5_ifar[ia][0]] / 4;
+    piv = pt->v[_MMG5_ifar[ia][1]];
+
+    if ( pt->xt ) {
+        pxt = &mesh->xtetra[pt->xt];
+        if ( (pxt->ftag[_MMG5_ifar[ia][0]] & MG_BDY) ||
+             (pxt->ftag[_MMG5_ifar[ia][1]] & MG_BDY) ) {
+            pxt->tag[ia] &= ~tag;
+        }
+    }
+    while ( adj && (adj != start) ) {
+        pt = &mesh->tetra[adj];
+        /* identification of edge number in tetra adj */
+        for (i=0; i<6; i++) {
+            ipa = _MMG5_iare[i][0];
+            ipb = _MMG5_iare[i][1];
+            if ( (pt->v[ipa] == na && pt->v[ipb] == nb) ||
+                 (pt->v[ipa] == nb && pt->v[ipb] == na))  break;
+        }
+        assert(i<6);
+        if ( pt->xt ) {
+            pxt = &mesh->xtetra[pt->xt];
+            if ( (pxt->ftag[_MMG5_ifar[i][0]] & MG_BDY) ||
+                 (pxt->ftag[_MMG5_ifar[i][1]] & MG_BDY) ) {
+                pxt->tag[i] &= ~tag;
+            }
+        }
+        /* set new triangle for travel */
+        adja = &mesh->adja[4*(adj-1)+1];
+        if ( pt->v[ _MMG5_ifar[i][0] ] == piv ) {
+            adj = adja[ _MMG5_ifar[i][0] ] / 4;
+            piv = pt->v[ _MMG5_ifar[i][1] ];
+        }
+        else {
+            adj = adja[ _MMG5_ifar[i][1] ] /4;
+            piv = pt->v[ _MMG5_ifar[i][0] ];
+        }
+    }
+
+    /* If all shell has been travelled, stop, else, travel it the other sense */
+    if ( adj == start )  return(1);
+    assert(!adj);
+
+    pt = &mesh->tetra[start];
+    adja = &mesh->adja[4*(start-1)+1];
+    adj = adja[_MMG5_ifar[ia][1]] / 4;
+    piv = pt->v[_MMG5_ifar[ia][0]];
+
+    while ( adj && (adj != start) ) {
+        pt = &mesh->tetra[adj];
+        /* identification of edge number in tetra adj */
+        for (i=0; i<6; i++) {
+            ipa = _MMG5_iare[i][0];
+            ipb = _MMG5_iare[i][1];
+            if ( (pt->v[ipa] == na && pt->v[ipb] == nb) ||
+                 (pt->v[ipa] == nb && pt->v[ipb] == na))  break;
+        }
+        assert(i<6);
+        if ( pt->xt ) {
+            pxt = &mesh->xtetra[pt->xt];
+            if ( (pxt->ftag[_MMG5_ifar[i][0]] & MG_BDY) ||
+                 (pxt->ftag[_MMG5_ifar[i][1]] & MG_BDY) ) {
+                pxt->tag[i] &= ~tag;
+            }
+        }
+        /* set new triangle for travel */
+        adja = &mesh->adja[4*(adj-1)+1];
+        if ( pt->v[ _MMG5_ifar[i][0] ] == piv ) {
+            adj = adja[ _MMG5_ifar[i][0] ] / 4;
+            piv = pt->v[ _MMG5_ifar[i][1] ];
+        }
+        else {
+            adj = adja[ _MMG5_ifar[i][1] ] /4;
+            piv = pt->v[ _MMG5_ifar[i][0] ];
+        }
+    }
+    return(1);
+}
+
 /** Find all tets sharing edge ia of tetra start
     return 2*ilist if shell is closed, 2*ilist +1 otherwise
     return 0 if one of the tet of the shell is required */
-int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
+int _MMG5_coquil(MMG5_pMesh mesh,MMG5_int start,int ia,MMG5_int * list) {
     MMG5_pTetra  pt;
-    int     ilist,*adja,piv,adj,na,nb,ipa,ipb;
+    MMG5_int *adja,piv,adj,na,nb;
+    int      ilist,ipa,ipb;
     char    i;
 
     assert ( start >= 1 );
@@ -892,7 +991,7 @@ int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
         /* overflow */
         if ( ilist > _MMG5_LMAX-3 ) {
             fprintf(stdout,"  ## Warning: problem in remesh process.");
-            fprintf(stdout," Coquil of edge %d-%d contains too many elts.\n",
+            fprintf(stdout," Coquil of edge %" MMG5_PRId "-%" MMG5_PRId " contains too many elts.\n",
                     _MMG5_indPt(mesh,na),_MMG5_indPt(mesh,nb));
             fprintf(stdout,"  ##          Try to modify the hausdorff number,");
             fprintf(stdout," or/and the maximum mesh.\n");
@@ -927,7 +1026,7 @@ int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
     /* overflow */
     if ( ilist > _MMG5_LMAX-3 ) {
         fprintf(stdout,"  ## Warning: problem in remesh process.");
-        fprintf(stdout," Coquil of edge %d-%d contains too many elts.\n",
+        fprintf(stdout," Coquil of edge %" MMG5_PRId "-%" MMG5_PRId " contains too many elts.\n",
                 _MMG5_indPt(mesh,na),_MMG5_indPt(mesh,nb));
         fprintf(stdout,"  ##          Try to modify the hausdorff number,");
         fprintf(stdout," or/and the maximum mesh.\n");
@@ -960,7 +1059,7 @@ int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
         /* overflow */
         if ( ilist > _MMG5_LMAX-2 ) {
             fprintf(stdout,"  ## Warning: problem in surface remesh process.");
-            fprintf(stdout," Coquil of edge %d-%d contains too many elts.\n",
+            fprintf(stdout," Coquil of edge %" MMG5_PRId "-%" MMG5_PRId " contains too many elts.\n",
                     _MMG5_indPt(mesh,na),_MMG5_indPt(mesh,nb));
             fprintf(stdout,"  ##          Try to modify the hausdorff number,");
             fprintf(stdout," or/and the maximum mesh.\n");
@@ -983,10 +1082,10 @@ int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
 }
 
 /** Identify whether edge ia in start is a boundary edge by unfolding its shell */
-int _MMG5_srcbdy(MMG5_pMesh mesh,int start,int ia) {
+int _MMG5_srcbdy(MMG5_pMesh mesh,MMG5_int start,int ia) {
     MMG5_pTetra      pt;
     MMG5_pxTetra     pxt;
-    int         na,nb,adj,piv,*adja;
+    MMG5_int    na,nb,adj,piv,*adja;
     char        ipa,ipb,iadj,i;
 
     pt = &mesh->tetra[start];
@@ -1044,10 +1143,10 @@ int _MMG5_srcbdy(MMG5_pMesh mesh,int start,int ia) {
 
 /** print an error message if _MMG5_coquilFace detect a boundary topology problem */
 static inline void
-_MMG5_errorMessage(MMG5_pMesh mesh, int k1, int k2) {
+_MMG5_errorMessage(MMG5_pMesh mesh, MMG5_int k1, MMG5_int k2) {
     MMG5_pPoint ppt;
     MMG5_pTetra pt;
-    int    np, ne, k, kel1, kel2;
+    MMG5_int np, ne, k, kel1, kel2;
 
     np = ne = kel1 = kel2 = 0;
     for (k=1; k<=mesh->np; k++) {
@@ -1068,20 +1167,20 @@ _MMG5_errorMessage(MMG5_pMesh mesh, int k1, int k2) {
 
     if ( kel1 != 0 ) {
         pt = &mesh->tetra[k1];
-        fprintf(stdout,"            look at elt %d:",kel1);
-        fprintf(stdout," %d %d %d %d.\n", mesh->point[pt->v[0]].tmp,
+        fprintf(stdout,"            look at elt %" MMG5_PRId ":",kel1);
+        fprintf(stdout," %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId ".\n", mesh->point[pt->v[0]].tmp,
                 mesh->point[pt->v[1]].tmp,mesh->point[pt->v[2]].tmp,
                 mesh->point[pt->v[3]].tmp);
-        fprintf(stdout,"adj %d %d %d %d\n",(&mesh->adja[3*(kel1-1)+1])[0],
+        fprintf(stdout,"adj %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",(&mesh->adja[3*(kel1-1)+1])[0],
                 (&mesh->adja[3*(kel1-1)+1])[1],(&mesh->adja[3*(kel1-1)+1])[2],
                 (&mesh->adja[3*(kel1-1)+1])[3]);
         fprintf(stdout,"req %d %d %d %d\n",mesh->point[pt->v[0]].tag & MG_REQ,
                 mesh->point[pt->v[1]].tag & MG_REQ,
                 mesh->point[pt->v[2]].tag & MG_REQ,mesh->point[pt->v[3]].tag & MG_REQ);
     } else if ( kel2 != 0 ) {
-        fprintf(stdout,"            look at elt %d:",kel2);
+        fprintf(stdout,"            look at elt %" MMG5_PRId ":",kel2);
         mesh->tetra[kel2].ref=5;
-        fprintf(stdout," %d %d %d %d.\n", mesh->point[pt->v[0]].tmp,
+        fprintf(stdout," %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId ".\n", mesh->point[pt->v[0]].tmp,
                 mesh->point[pt->v[1]].tmp,mesh->point[pt->v[2]].tmp,
                 mesh->point[pt->v[3]].tmp);
     }
@@ -1093,11 +1192,13 @@ _MMG5_errorMessage(MMG5_pMesh mesh, int k1, int k2) {
 
 /** Find all tets sharing edge ia of tetra start, and stores boundary faces when met
     it1 & it2 = 6*iel + iface, iel = index of tetra, iface = index of face in tetra
-    return 2*ilist if shell is closed, 2*ilist +1 otherwise */
-int _MMG5_coquilface(MMG5_pMesh mesh,int start,int ia,int *list,int *it1,int *it2) {
+    return 2*ilist if shell is closed, 2*ilist +1 otherwise, 0 if the shell
+    contains a required tetra */
+int _MMG5_coquilface(MMG5_pMesh mesh,MMG5_int start,int ia,MMG5_int *list,MMG5_int *it1,MMG5_int *it2) {
     MMG5_pTetra   pt;
     MMG5_pxTetra  pxt;
-    int     *adja,piv,adj,na,nb,ipa,ipb,ilist,pradj;
+    MMG5_int *adja,piv,adj,na,nb,pradj;
+    int      ipa,ipb,ilist;
     char     i,iface,isbdy;
 
     pt = &mesh->tetra[start];
@@ -1125,6 +1226,7 @@ int _MMG5_coquilface(MMG5_pMesh mesh,int start,int ia,int *list,int *it1,int *it
 
     while ( adj && (adj != start) ) {
         pt = &mesh->tetra[adj];
+        if ( pt->tag & MG_REQ )  return(0);
         pxt = 0;
         if ( pt->xt )
             pxt = &mesh->xtetra[pt->xt];
@@ -1142,7 +1244,7 @@ int _MMG5_coquilface(MMG5_pMesh mesh,int start,int ia,int *list,int *it1,int *it
         /* overflow */
         if ( ilist > _MMG5_LMAX-2 ) {
             fprintf(stdout,"  ## Warning: problem in surface remesh process.");
-            fprintf(stdout," Coquil of edge %d-%d contains too many elts.\n",
+            fprintf(stdout," Coquil of edge %" MMG5_PRId "-%" MMG5_PRId " contains too many elts.\n",
                     _MMG5_indPt(mesh,na),_MMG5_indPt(mesh,nb));
             fprintf(stdout,"  ##          Try to modify the hausdorff number,");
             fprintf(stdout," or/and the maximum mesh.\n");
@@ -1201,7 +1303,7 @@ int _MMG5_coquilface(MMG5_pMesh mesh,int start,int ia,int *list,int *it1,int *it
     /* overflow */
     if ( ilist > _MMG5_LMAX-2 ) {
         fprintf(stdout,"  ## Warning: problem in surface remesh process.");
-        fprintf(stdout," Coquil of edge %d-%d contains too many elts.\n",
+        fprintf(stdout," Coquil of edge %" MMG5_PRId "-%" MMG5_PRId " contains too many elts.\n",
                 _MMG5_indPt(mesh,na),_MMG5_indPt(mesh,nb));
         fprintf(stdout,"  ##          Try to modify the hausdorff number,");
         fprintf(stdout," or/and the maximum mesh.\n");
@@ -1226,6 +1328,7 @@ int _MMG5_coquilface(MMG5_pMesh mesh,int start,int ia,int *list,int *it1,int *it
 
     while ( adj ) {
         pt = &mesh->tetra[adj];
+        if ( pt->tag & MG_REQ )  return(0);
 
         /* identification of edge number in tetra adj */
         for (i=0; i<6; i++) {
@@ -1240,7 +1343,7 @@ int _MMG5_coquilface(MMG5_pMesh mesh,int start,int ia,int *list,int *it1,int *it
         /* overflow */
         if ( ilist > _MMG5_LMAX-2 ) {
             fprintf(stdout,"  ## Warning: problem in surface remesh process.");
-            fprintf(stdout," Coquil of edge %d-%d contains too many elts.\n",
+            fprintf(stdout," Coquil of edge %" MMG5_PRId "-%" MMG5_PRId " contains too many elts.\n",
                     _MMG5_indPt(mesh,na),_MMG5_indPt(mesh,nb));
             fprintf(stdout,"  ##          Try to modify the hausdorff number,");
             fprintf(stdout," or/and the maximum mesh.\n");
@@ -36,21 +36,297 @@
 #define PRECI 1
 #define LFILT    0.2//0.7
 
-/* create bucket structure and store initial vertices */
-_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh mesh,int nmax) {
+/** ratio hmax/hmin above which we use the adaptive mode */
+#define _MMG5_BUCKRATIO  100.
+/** finest level of the adaptive mode (cells of size \f$2^{-17}\f$) */
+#define _MMG5_BUCKLMAX   17
+
+/** key of the cell (i,j,k) of level l of the adaptive mode */
+#define _MMG5_BUCKKEY(l,i,j,k)  ( ((unsigned long long)((l)+1) << 54)     \
+                                  | ((unsigned long long)(i) << 36)       \
+                                  | ((unsigned long long)(j) << 18)       \
+                                  | (unsigned long long)(k) )
+
+/**
+ * \param h local size at a point.
+ * \return the level of the point.
+ *
+ * Level of the adaptive mode in which we store a point of size \a h: the
+ * finest level whose cells are larger than the filter radius of the point.
+ *
+ */
+static inline int _MMG5_buckLevel(double h) {
+    double  r,s;
+    int     l;
+
+    r = LFILT * h;
+    s = 1.0;
+    for (l=0; l<_MMG5_BUCKLMAX && 0.5*s >= r; l++)
+        s *= 0.5;
+    return(l);
+}
+
+/**
+ * \param c point coordinates.
+ * \param l level.
+ * \param i pointer toward the cell indices.
+ *
+ * Indices of the cell of level \a l containing the point \a c.
+ *
+ */
+static inline void _MMG5_buckCell(double *c,int l,int *i) {
+    int  n,d;
+
+    n = 1 << l;
+    for (d=0; d<3; d++)
+        i[d] = MG_MIN(n-1,MG_MAX(0,(int)(c[d] * n)));
+}
+
+/**
+ * \param bucket pointer toward the bucket structure.
+ * \param key key of a cell.
+ * \return the position of the cell in the hash table, or of the empty slot
+ * in which it must be inserted.
+ *
+ */
+static inline int _MMG5_buckSlot(_MMG5_pBucket bucket,unsigned long long key) {
+    int  h;
+
+    h = (int)((key * 0x9E3779B97F4A7C15ULL) >> 33) & (bucket->hsiz-1);
+    while ( bucket->hkey[h] && bucket->hkey[h] != key )
+        h = (h+1) & (bucket->hsiz-1);
+    return(h);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Double the size of the hash table of cells of the adaptive mode.
+ *
+ */
+static int _MMG5_buckGrow(MMG5_pMesh mesh,_MMG5_pBucket bucket) {
+    unsigned long long *okey;
+    MMG5_int           *ohead;
+    int                 osiz,k,h;
+
+    _MMG5_ADD_MEM(mesh,bucket->hsiz*(sizeof(unsigned long long)+sizeof(MMG5_int)),
+                  "bucket cells",return(0));
+    okey  = bucket->hkey;
+    ohead = bucket->hhead;
+    osiz  = bucket->hsiz;
+
+    bucket->hsiz *= 2;
+    _MMG5_SAFE_CALLOC(bucket->hkey,bucket->hsiz,unsigned long long);
+    _MMG5_SAFE_CALLOC(bucket->hhead,bucket->hsiz,MMG5_int);
+
+    for (k=0; k<osiz; k++) {
+        if ( !okey[k] )  continue;
+        h = _MMG5_buckSlot(bucket,okey[k]);
+        bucket->hkey[h]  = okey[k];
+        bucket->hhead[h] = ohead[k];
+    }
+    _MMG5_DEL_MEM(mesh,okey,osiz*sizeof(unsigned long long));
+    _MMG5_DEL_MEM(mesh,ohead,osiz*sizeof(MMG5_int));
+
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param ip index of the point to store.
+ * \return 1.
+ *
+ * Store the point \a ip in the cell of its level (adaptive mode).
+ *
+ */
+static int _MMG5_addBucket_adp(MMG5_pMesh mesh,_MMG5_pBucket bucket,MMG5_int ip) {
+    unsigned long long  key;
+    int                 l,h,i[3];
+
+    l = _MMG5_buckLevel(bucket->met->m[ip]);
+    _MMG5_buckCell(mesh->point[ip].c,l,i);
+    key = _MMG5_BUCKKEY(l,i[0],i[1],i[2]);
+
+    h = _MMG5_buckSlot(bucket,key);
+    if ( !bucket->hkey[h] ) {
+        /* new cell: keep the table half empty */
+        if ( 2*(bucket->hnum+1) > bucket->hsiz ) {
+            if ( !_MMG5_buckGrow(mesh,bucket) && bucket->hnum+2 > bucket->hsiz )
+                return(1);
+            h = _MMG5_buckSlot(bucket,key);
+        }
+        bucket->hkey[h] = key;
+        bucket->hnum++;
+    }
+    bucket->link[ip] = bucket->hhead[h];
+    bucket->hhead[h] = ip;
+    bucket->levs    |= 1 << l;
+
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param ip index of the point to remove.
+ * \return 1.
+ *
+ * Remove the point \a ip from the cell of its level (adaptive mode). Empty
+ * cells stay in the hash table.
+ *
+ */
+static int _MMG5_delBucket_adp(MMG5_pMesh mesh,_MMG5_pBucket bucket,MMG5_int ip) {
+    unsigned long long  key;
+    MMG5_int            ip1;
+    int                 l,h,i[3];
+
+    l = _MMG5_buckLevel(bucket->met->m[ip]);
+    _MMG5_buckCell(mesh->point[ip].c,l,i);
+    key = _MMG5_BUCKKEY(l,i[0],i[1],i[2]);
+
+    h = _MMG5_buckSlot(bucket,key);
+    if ( !bucket->hkey[h] || !bucket->hhead[h] )  return(1);
+
+    if ( bucket->hhead[h] == ip ) {
+        bucket->hhead[h] = bucket->link[ip];
+        bucket->link[ip] = 0;
+    }
+    else {
+        ip1 = bucket->hhead[h];
+        while ( ip1 && bucket->link[ip1] != ip )
+            ip1 = bucket->link[ip1];
+        if ( ip1 ) {
+            bucket->link[ip1] = bucket->link[ip];
+            bucket->link[ip]  = 0;
+        }
+        else
+            printf("point non trouve %" MMG5_PRId " %c -- %d\n",ip,mesh->point[ip].tag,h);
+    }
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the solution structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param ip index of the point to check.
+ * \return 0 if the point is too close to a stored point, 1 otherwise.
+ *
+ * Filter of the isotropic case in adaptive mode. The points of level \a l
+ * have a filter radius smaller than the cell size of the level so we explore
+ * the cells closer than the cell size or the radius of \a ip. The levels
+ * whose cells are smaller than half the radius of \a ip are skipped: with a
+ * graded size map, such small points are not in the neighbourhood of \a ip.
+ *
+ */
+static int
+_MMG5_buckin_iso_adp(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,MMG5_int ip) {
+    MMG5_pPoint   ppt,pp1;
+    double        d2,ux,uy,uz,hpi,hp1,hp2,s,r;
+    MMG5_int      ip1;
+    int           l,h,i,j,k,n,imin[3],imax[3];
+
+    ppt = &mesh->point[ip];
+    hpi = LFILT * sol->m[ip];
+    hp1 = hpi*hpi;
+
+    s = 1.0;
+    for (l=0; l<=_MMG5_BUCKLMAX; l++,s*=0.5) {
+        if ( s < 0.5*hpi )  break;
+        if ( !(bucket->levs & (1 << l)) )  continue;
+
+        n = 1 << l;
+        r = MG_MAX(s,hpi);
+        for (i=0; i<3; i++) {
+            imin[i] = MG_MAX(0,(int)((ppt->c[i]-r) * n));
+            imax[i] = MG_MIN(n-1,(int)((ppt->c[i]+r) * n));
+        }
+
+        for (k=imin[2]; k<=imax[2]; k++)
+            for (j=imin[1]; j<=imax[1]; j++)
+                for (i=imin[0]; i<=imax[0]; i++) {
+                    h = _MMG5_buckSlot(bucket,_MMG5_BUCKKEY(l,i,j,k));
+                    if ( !bucket->hkey[h] )  continue;
+
+                    for (ip1=bucket->hhead[h]; ip1; ip1=bucket->link[ip1]) {
+                        pp1 = &mesh->point[ip1];
+                        hp2 = LFILT * sol->m[ip1];
+                        ux = pp1->c[0] - ppt->c[0];
+                        uy = pp1->c[1] - ppt->c[1];
+                        uz = pp1->c[2] - ppt->c[2];
+                        d2 = ux*ux + uy*uy + uz*uz;
+                        if ( d2 < hp1 || d2 < hp2*hp2 )  return(0);
+                    }
+                }
+    }
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param nmax number of cells per direction of the uniform grid.
+ * \return a pointer toward the bucket, NULL if fail.
+ *
+ * Create the bucket structure and store the initial internal vertices. If
+ * the isotropic size map is strongly graded (\f$h_{max}/h_{min}\f$ greater
+ * than \ref _MMG5_BUCKRATIO), the uniform grid is replaced by the adaptive
+ * mode.
+ *
+ */
+_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh mesh,MMG5_pSol met,int nmax) {
     MMG5_pPoint        ppt;
     _MMG5_pBucket       bucket;
-    double        dd;
-    int           k,ic,ii,jj,kk;
+    double        dd,hmin,hmax;
+    MMG5_int      k;
+    int           ic,ii,jj,kk;
 
     /* memory alloc */
     _MMG5_ADD_MEM(mesh,sizeof(_MMG5_Bucket),"bucket",return(NULL));
-    _MMG5_SAFE_MALLOC(bucket,1,_MMG5_Bucket);
+    _MMG5_SAFE_CALLOC(bucket,1,_MMG5_Bucket);
     bucket->size = nmax;
-    _MMG5_ADD_MEM(mesh,(nmax*nmax*nmax+1)*sizeof(int),"bucket->head",return(NULL));
-    _MMG5_SAFE_CALLOC(bucket->head,nmax*nmax*nmax+1,int);
-    _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(int),"bucket->link",return(NULL));
-    _MMG5_SAFE_CALLOC(bucket->link,mesh->npmax+1,int);
+    bucket->met  = met;
+    _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(MMG5_int),"bucket->link",return(NULL));
+    _MMG5_SAFE_CALLOC(bucket->link,mesh->npmax+1,MMG5_int);
+
+    /* range of the size map */
+    hmin = DBL_MAX;
+    hmax = 0.;
+    if ( met && met->m && met->size == 1 ) {
+        for (k=1; k<=mesh->np; k++) {
+            ppt = &mesh->point[k];
+            if ( !MG_VOK(ppt) )  continue;
+            hmin = MG_MIN(hmin,met->m[k]);
+            hmax = MG_MAX(hmax,met->m[k]);
+        }
+    }
+    if ( hmin > 0. && hmax > _MMG5_BUCKRATIO*hmin ) {
+        bucket->nlev = _MMG5_BUCKLMAX+1;
+        bucket->hsiz = 1024;
+        while ( bucket->hsiz < mesh->np )  bucket->hsiz *= 2;
+        _MMG5_ADD_MEM(mesh,bucket->hsiz*(sizeof(unsigned long long)+sizeof(MMG5_int)),
+                      "bucket cells",bucket->nlev = 0);
+    }
+    if ( bucket->nlev ) {
+        _MMG5_SAFE_CALLOC(bucket->hkey,bucket->hsiz,unsigned long long);
+        _MMG5_SAFE_CALLOC(bucket->hhead,bucket->hsiz,MMG5_int);
+        if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+            fprintf(stdout,"     adaptive bucket (hmax/hmin %e)\n",hmax/hmin);
+
+        for (k=1; k<=mesh->np; k++) {
+            ppt = &mesh->point[k];
+            if ( !MG_VOK(ppt) )  continue;
+            if (ppt->tag & MG_BDY) continue;
+            _MMG5_addBucket_adp(mesh,bucket,k);
+        }
+        return(bucket);
+    }
+
+    _MMG5_ADD_MEM(mesh,(nmax*nmax*nmax+1)*sizeof(MMG5_int),"bucket->head",return(NULL));
+    _MMG5_SAFE_CALLOC(bucket->head,nmax*nmax*nmax+1,MMG5_int);
 
     /* insert vertices */
     dd = nmax / (double)PRECI;
@@ -74,14 +350,71 @@ _MMG5_pBucket _MMG5_newBucket(MMG5_pMesh mesh,int nmax) {
     return(bucket);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ *
+ * Free the bucket structure.
+ *
+ */
+void _MMG5_freeBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket) {
+
+    if ( bucket->nlev ) {
+        _MMG5_DEL_MEM(mesh,bucket->hkey,bucket->hsiz*sizeof(unsigned long long));
+        _MMG5_DEL_MEM(mesh,bucket->hhead,bucket->hsiz*sizeof(MMG5_int));
+    }
+    else
+        _MMG5_DEL_MEM(mesh,bucket->head,(bucket->size*bucket->size*bucket->size+1)*sizeof(MMG5_int));
+    _MMG5_DEL_MEM(mesh,bucket->link,(mesh->npmax+1)*sizeof(MMG5_int));
+    _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
+}
+
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param perm new index of each point (0 for removed points).
+ * \param np number of points before the renumbering.
+ * \return 1 if success, 0 if fail (the bucket is unchanged).
+ *
+ * Update the points stored in the bucket after a renumbering of the mesh.
+ *
+ */
+int _MMG5_permBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,MMG5_int *perm,
+                     MMG5_int np) {
+    MMG5_int *head,*link,nc,k;
+
+    if ( bucket->nlev ) {
+        head = bucket->hhead;
+        nc   = bucket->hsiz;
+    }
+    else {
+        head = bucket->head;
+        nc   = bucket->size*bucket->size*bucket->size+1;
+    }
+    _MMG5_ADD_MEM(mesh,(np+1)*sizeof(MMG5_int),"bucket renumbering",return(0));
+    _MMG5_SAFE_CALLOC(link,np+1,MMG5_int);
+
+    for (k=0; k<nc; k++)
+        if ( head[k] )  head[k] = perm[head[k]];
+
+    for (k=1; k<=np; k++)
+        if ( perm[k] && bucket->link[k] )
+            link[perm[k]] = perm[bucket->link[k]];
+    memcpy(&bucket->link[1],&link[1],np*sizeof(MMG5_int));
+    _MMG5_DEL_MEM(mesh,link,(np+1)*sizeof(MMG5_int));
+    return(1);
+}
+
 
 /* check and eventually insert vertex */
-int _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
+int _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,MMG5_int ip) {
     MMG5_pPoint        ppt,pp1;
     double        dd,d2,det,ux,uy,uz,dmi,m1,m2,m3,dx,dy,dz;
     double        *ma,*mb;
-    int           i,j,k,ii,jj,kk,ic,icc,siz,ip1;
-    int           iadr,imin,imax,jmin,jmax,kmin,kmax;
+    MMG5_int      ip1,iadr;
+    int           i,j,k,ii,jj,kk,ic,icc,siz;
+    int           imin,imax,jmin,jmax,kmin,kmax;
 
     ppt = &mesh->point[ip];
     siz = bucket->size;
@@ -205,12 +538,15 @@ int _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip)
 }
 
 
-int _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
+int _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,MMG5_int ip) {
     MMG5_pPoint        ppt,pp1;
     double        dd,d2,ux,uy,uz,hpi,hp1,hp2;
-    int           i,j,k,ii,jj,kk,ic,icc,siz,ip1;
+    MMG5_int      ip1;
+    int           i,j,k,ii,jj,kk,ic,icc,siz;
     int           imin,imax,jmin,jmax,kmin,kmax;
 
+    if ( bucket->nlev )  return(_MMG5_buckin_iso_adp(mesh,sol,bucket,ip));
+
     ppt = &mesh->point[ip];
     siz = bucket->size;
     dd  = siz / (double)PRECI;
@@ -304,11 +640,13 @@ int _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip)
 }
 
 
-int _MMG5_addBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip) {
+int _MMG5_addBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,MMG5_int ip) {
     MMG5_pPoint        ppt;
     double        dd;
     int           ic,ii,jj,kk,siz;
 
+    if ( bucket->nlev )  return(_MMG5_addBucket_adp(mesh,bucket,ip));
+
     ppt = &mesh->point[ip];
     siz = bucket->size;
     dd  = siz / (double)PRECI;
@@ -334,10 +672,13 @@ int _MMG5_addBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip) {
 }
 
 
-int _MMG5_delBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip) {
+int _MMG5_delBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,MMG5_int ip) {
     MMG5_pPoint        ppt;
     double        dd;
-    int           ic,ii,jj,kk,siz,ip1;
+    MMG5_int      ip1;
+    int           ic,ii,jj,kk,siz;
+
+    if ( bucket->nlev )  return(_MMG5_delBucket_adp(mesh,bucket,ip));
 
     ppt = &mesh->point[ip];
     siz = bucket->size;
@@ -363,7 +704,7 @@ int _MMG5_delBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip) {
                 bucket->link[ip1] = bucket->link[ip];
                 bucket->link[ip] = 0;
             } else {
-                printf("point non trouve %d %c -- %d\n",ip,mesh->point[ip].tag,ic);
+                printf("point non trouve %" MMG5_PRId " %c -- %d\n",ip,mesh->point[ip].tag,ic);
             }
         }
     }
@@ -38,15 +38,13 @@
 #define  _MMG5_EPSLOC   1.00005
 #define  IEDG(a,b) (((a) > 0) && ((b) > 0)) ? ((a)+(b)) : (((a)+(b))-(1))
 
-extern char ddb;
-
 /**
  *
  * \warning Not used.
  */
 void _MMG5_chkvol(MMG5_pMesh mesh) {
     MMG5_pTetra    pt;
-    int       k;
+    MMG5_int  k;
 #ifdef DEBUG
     int       ier=1;
 #endif
@@ -55,7 +53,7 @@ void _MMG5_chkvol(MMG5_pMesh mesh) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) )  continue;
         if ( _MMG5_orvol(mesh->point,pt->v) < _MMG5_NULKAL ) {
-            printf("  tetra %d  volume %e\n",k,_MMG5_orvol(mesh->point,pt->v));
+            printf("  tetra %" MMG5_PRId "  volume %e\n",k,_MMG5_orvol(mesh->point,pt->v));
 #ifdef DEBUG
             ier = 0;
 #endif
@@ -72,8 +70,8 @@ void _MMG5_chkvol(MMG5_pMesh mesh) {
  */
 int _MMG5_chkmshsurf(MMG5_pMesh mesh){
     MMG5_pTria      pt;
-    int        k,k1;
-    int        *adja,*adja1;
+    MMG5_int   k,k1;
+    MMG5_int   *adja,*adja1;
     char       i,voy;
 
     for (k=1; k<=mesh->nt; k++) {
@@ -88,7 +86,7 @@ int _MMG5_chkmshsurf(MMG5_pMesh mesh){
             adja1 = &mesh->adjt[3*(k1-1)+1];
 
             if(adja1[voy] / 3 != k){
-                printf("Wrong adjacency relation for triangles : %d %d \n",k,k1);
+                printf("Wrong adjacency relation for triangles : %" MMG5_PRId " %" MMG5_PRId " \n",k,k1);
                 exit(EXIT_FAILURE);
             }
         }
@@ -96,17 +94,20 @@ int _MMG5_chkmshsurf(MMG5_pMesh mesh){
     return(1);
 }
 
-int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
+int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,MMG5_int base) {
     MMG5_pTetra    pt,pt1,pt2;
     MMG5_pxTetra   pxt;
-    int       *adja,*adja1,adj,adj1,k,i,iadr;
-    int       iel,a0,a1,a2,b0,b1,b2;
+    MMG5_int  *adja,*adja1,adj,adj1,k,iadr;
+    int        i;
+    MMG5_int   iel,a0,a1,a2,b0,b1,b2;
     unsigned char voy,voy1;
     /* commentated part variables
        MMG5_pTetra        pt0;
        MMG5_xTetra       pxt0,pxt1,pxt2;
-       int           ilists,ilistv,lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2];
-       int           ielprv,ielnxt,l,nump,np,nq;
+       MMG5_int      lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2];
+       int           ilists,ilistv;
+       MMG5_int      ielprv,ielnxt,nump,np,nq;
+       int           l;
        unsigned char j,iface,ifaceprv,ifacenxt,indp,indpprv,indpnxt,tag0,tag1,tag2,ia;
     */
 
@@ -122,17 +123,17 @@ int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
             if ( !adj )  continue;
 
             if ( adj == k ) {
-                fprintf(stdout,"  1. Wrong adjacency %d %d\n",k,adj);
-                printf("k %d: %d %d %d %d\n",k,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);
-                printf("adj (%d): %d %d %d %d\n",k,adja[0]/4,adja[1]/4,adja[2]/4,adja[3]/4);
+                fprintf(stdout,"  1. Wrong adjacency %" MMG5_PRId " %" MMG5_PRId "\n",k,adj);
+                printf("k %" MMG5_PRId ": %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);
+                printf("adj (%" MMG5_PRId "): %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,adja[0]/4,adja[1]/4,adja[2]/4,adja[3]/4);
                 exit(EXIT_FAILURE);
             }
             pt2 = &mesh->tetra[adj];
             if ( !MG_EOK(pt2) || pt2->ref < 0 ){
-                fprintf(stdout,"  4. Invalid adjacent %d %d\n",adj,k);
-                printf("sommets k   %d: %d %d %d %d\n",k,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);
-                printf("sommets adj %d: %d %d %d %d\n",adj,pt2->v[0],pt2->v[1],pt2->v[2],pt2->v[3]);
-                printf("numeros adj %d: %d %d %d %d\n",k,adja[0]/4,adja[1]/4,adja[2]/4,adja[3]/4);
+                fprintf(stdout,"  4. Invalid adjacent %" MMG5_PRId " %" MMG5_PRId "\n",adj,k);
+                printf("sommets k   %" MMG5_PRId ": %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);
+                printf("sommets adj %" MMG5_PRId ": %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",adj,pt2->v[0],pt2->v[1],pt2->v[2],pt2->v[3]);
+                printf("numeros adj %" MMG5_PRId ": %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,adja[0]/4,adja[1]/4,adja[2]/4,adja[3]/4);
                 exit(EXIT_FAILURE);
             }
             iadr  = (adj-1)*4 + 1;
@@ -140,11 +141,11 @@ int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
             adj1  = adja1[voy] / 4;
             voy1  = adja1[voy] % 4;
             if ( adj1 != k || voy1 != i ) {
-                fprintf(stdout,"  2. Wrong adjacency %d %d\n",k,adj1);
-                printf("k %d: %d %d %d %d\n",k,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);
-                printf("a %d: %d %d %d %d\n",adj,pt2->v[0],pt2->v[1],pt2->v[2],pt2->v[3]);
-                printf("adj(%d): %d %d %d %d\n",k,adja[0]/4,adja[1]/4,adja[2]/4,adja[3]/4);
-                printf("adj(%d): %d %d %d %d\n",adj,adja1[0]/4,adja1[1]/4,adja1[2]/4,adja1[3]/4);
+                fprintf(stdout,"  2. Wrong adjacency %" MMG5_PRId " %" MMG5_PRId "\n",k,adj1);
+                printf("k %" MMG5_PRId ": %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);
+                printf("a %" MMG5_PRId ": %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",adj,pt2->v[0],pt2->v[1],pt2->v[2],pt2->v[3]);
+                printf("adj(%" MMG5_PRId "): %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,adja[0]/4,adja[1]/4,adja[2]/4,adja[3]/4);
+                printf("adj(%" MMG5_PRId "): %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",adj,adja1[0]/4,adja1[1]/4,adja1[2]/4,adja1[3]/4);
                 exit(EXIT_FAILURE);
             }
 
@@ -159,9 +160,9 @@ int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
             if(!(((a0 == b0)&&(a1 == b1)&&(a2 ==b2))||((a0 == b0)&&(a1 == b2)&&(a2 ==b1))\
                  || ((a0 == b1)&&(a1 == b0)&&(a2 ==b2)) || ((a0 == b1)&&(a1 == b2)&&(a2 ==b0))\
                  || ((a0 == b2)&&(a1 == b0)&&(a2 ==b1)) || ((a0 == b2)&&(a1 == b1)&&(a2 ==b0)) )){
-                printf("Inconsistent faces : tetra %d face %d ; tetra %d face %i \n",k,i,adj,voy);
-                printf("Tet 1 : %d %d %d \n",a0,a1,a2);
-                printf("Tet 2 : %d %d %d \n",b0,b1,b2);
+                printf("Inconsistent faces : tetra %" MMG5_PRId " face %d ; tetra %" MMG5_PRId " face %i \n",k,i,adj,voy);
+                printf("Tet 1 : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " \n",a0,a1,a2);
+                printf("Tet 2 : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " \n",b0,b1,b2);
                 exit(EXIT_FAILURE);
             }
         }
@@ -176,14 +177,14 @@ int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
         for(i=0;i<4;i++){
             if(!adja[i]){
                 if(!pt->xt){
-                    printf("Tetra %d : boundary face not tagged : %d \n",k,i);
+                    printf("Tetra %" MMG5_PRId " : boundary face not tagged : %d \n",k,i);
                     MMG5_saveMesh(mesh);
                     exit(EXIT_FAILURE);
                 }
                 else{
                     pxt = &mesh->xtetra[pt->xt];
                     if(!(pxt->ftag[i] & MG_BDY)){
-                        printf("Tetra %d : boundary face not tagged : %d \n",k,i);
+                        printf("Tetra %" MMG5_PRId " : boundary face not tagged : %d \n",k,i);
                         MMG5_saveMesh(mesh);
                         exit(EXIT_FAILURE);
                     }
@@ -206,14 +207,14 @@ int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
 
             if(pt->ref != pt1->ref){
                 if(!pt->xt){
-                    printf("Tetra %d face %d : common face is a limit of two subdomains and has not xt : %d %d %d  \n",k,i,pt->v[_MMG5_idir[i][0]],pt->v[_MMG5_idir[i][1]],pt->v[_MMG5_idir[i][2]]);
+                    printf("Tetra %" MMG5_PRId " face %d : common face is a limit of two subdomains and has not xt : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "  \n",k,i,pt->v[_MMG5_idir[i][0]],pt->v[_MMG5_idir[i][1]],pt->v[_MMG5_idir[i][2]]);
                     MMG5_saveMesh(mesh);
                     exit(EXIT_FAILURE);
                 }
                 else{
                     pxt = &mesh->xtetra[pt->xt];
                     if(!(pxt->ftag[i] & MG_BDY)){
-                        printf("Tetra %d %d : common face is a limit of two subdomains and is not tagged %d %d %d -->%d\n",k,i,pt->v[_MMG5_idir[i][0]],pt->v[_MMG5_idir[i][1]],pt->v[_MMG5_idir[i][2]], pxt->ftag[i]);
+                        printf("Tetra %" MMG5_PRId " %d : common face is a limit of two subdomains and is not tagged %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " -->%d\n",k,i,pt->v[_MMG5_idir[i][0]],pt->v[_MMG5_idir[i][1]],pt->v[_MMG5_idir[i][2]], pxt->ftag[i]);
                         MMG5_saveMesh(mesh);
                         exit(EXIT_FAILURE);
                     }
@@ -430,11 +431,11 @@ int _MMG5_chkmsh(MMG5_pMesh mesh,int severe,int base) {
  *
  * \warning Not used.
  **/
-int _MMG5_chkptonbdy(MMG5_pMesh mesh,int np){
+int _MMG5_chkptonbdy(MMG5_pMesh mesh,MMG5_int np){
     MMG5_pTetra      pt;
     MMG5_pxTetra     pxt;
     MMG5_pPoint      p0;
-    int         k;
+    MMG5_int    k;
     char        i,j,ip;
 
     for(k=1;k<=mesh->np;k++)
@@ -450,7 +451,7 @@ int _MMG5_chkptonbdy(MMG5_pMesh mesh,int np){
             if(!(pxt->ftag[i] & MG_BDY)) continue;
             for(j=0; j<3; j++){
                 ip = _MMG5_idir[i][j];
-                if(pt->v[ip] == np) printf("Le pt : %d sur la face %d du tetra %d : %d %d %d %d \n",pt->v[ip],i,k,pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
+                if(pt->v[ip] == np) printf("Le pt : %" MMG5_PRId " sur la face %d du tetra %" MMG5_PRId " : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " \n",pt->v[ip],i,k,pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
                 p0 = &mesh->point[pt->v[ip]];
                 p0->flag = 1;
             }
@@ -463,7 +464,7 @@ int _MMG5_chkptonbdy(MMG5_pMesh mesh,int np){
         if(!MG_VOK(p0)) continue;
         if(p0->flag) continue;
         if(p0->tag & MG_BDY){
-            printf("      Fct. chkptonbdy : point %d tagged bdy while belonging to no BDY face\n",k);
+            printf("      Fct. chkptonbdy : point %" MMG5_PRId " tagged bdy while belonging to no BDY face\n",k);
             exit(EXIT_FAILURE);
         }
     }
@@ -477,10 +478,11 @@ int _MMG5_chkptonbdy(MMG5_pMesh mesh,int np){
  *
  * \warning Not used.
  */
-int _MMG5_cntbdypt(MMG5_pMesh mesh, int nump){
+int _MMG5_cntbdypt(MMG5_pMesh mesh, MMG5_int nump){
     MMG5_pTetra  pt;
     MMG5_pxTetra pxt;
-    int k,nf;
+    MMG5_int k;
+    int nf;
     char i,j,ip;
 
     nf = 0;
@@ -495,7 +497,7 @@ int _MMG5_cntbdypt(MMG5_pMesh mesh, int nump){
             for(j=0; j<3; j++){
                 ip = _MMG5_idir[i][j];
                 if(pt->v[ip] == nump){
-                    printf("La face : %d %d %d \n dans le tetra : %d %d %d %d \n",pt->v[_MMG5_idir[i][0]],pt->v[_MMG5_idir[i][1]],pt->v[_MMG5_idir[i][2]],pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
+                    printf("La face : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " \n dans le tetra : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " \n",pt->v[_MMG5_idir[i][0]],pt->v[_MMG5_idir[i][1]],pt->v[_MMG5_idir[i][2]],pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
                     nf++;
                 }
             }
@@ -510,7 +512,8 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
     MMG5_pTetra      pt,pt1;
     MMG5_pxTetra     pxt;
     MMG5_pPoint      p0,p1;
-    int         k,nf,ntet,ned,np,ischk,ilist,list[_MMG5_LMAX+2],l,np1,npchk,iel;
+    MMG5_int    k,ntet,ned,np,list[_MMG5_LMAX+2],np1,npchk,iel;
+    int         nf,ischk,ilist,l;
     char        i0,j,i,i1,ia;
 
     ntet = ned = 0;
@@ -530,7 +533,7 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
         }
         if ( nf >= 2 )  ntet++;
     }
-    if ( ntet )  printf("  *** %d tetras with at least 2 boundary faces.\n",ntet);
+    if ( ntet )  printf("  *** %" MMG5_PRId " tetras with at least 2 boundary faces.\n",ntet);
 
     /* Count internal edges connecting two points of the boundary */
     for (k=1; k<=mesh->ne; k++) {
@@ -542,7 +545,7 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
             p0 = &mesh->point[np];
             if ( !(p0->tag & MG_BDY) )  continue;
 
-            ischk = p0->flag % 2;
+            ischk = (int)(p0->flag % 2);
             if ( ischk )  continue;
             p0->flag += 1;
 
@@ -560,7 +563,7 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
                     p1 = &mesh->point[np1];
                     if ( !(p1->tag & MG_BDY) )  continue;
 
-                    ischk = p1->flag % 2;
+                    ischk = (int)(p1->flag % 2);
                     npchk = p1->flag / 2;
                     if ( npchk == np )  continue;
 
@@ -571,7 +574,7 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
             }
         }
     }
-    if ( ned )  printf("  *** %d internal edges connecting boundary points.\n",ned);
+    if ( ned )  printf("  *** %" MMG5_PRId " internal edges connecting boundary points.\n",ned);
     return(1);
 }
 
@@ -582,10 +585,11 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
  *
  * \warning Not used.
  */
-int srcface(MMG5_pMesh mesh,int n0,int n1,int n2) {
+int srcface(MMG5_pMesh mesh,MMG5_int n0,MMG5_int n1,MMG5_int n2) {
     MMG5_pTetra    pt;
     MMG5_pxTetra   pxt;
-    int       k,ip0,ip1,ip2,minn,maxn,sn,mins,maxs,sum,ref;
+    MMG5_int  k,ip0,ip1,ip2,minn,maxn,sn,mins,maxs,sum;
+    int       ref;
     char      i,tag;
 
     minn = MG_MIN(n0,MG_MIN(n1,n2));
@@ -610,7 +614,7 @@ int srcface(MMG5_pMesh mesh,int n0,int n1,int n2) {
             ref  = pt->xt ? pxt->ref[i] : 0;
 
             if( mins == minn && maxs == maxn && sum == sn ) {
-                printf("Face %d in tetra %d with ref %d : corresponding ref %d , tag : %d\n",i,k,pt->ref,ref,tag);
+                printf("Face %d in tetra %" MMG5_PRId " with ref %d : corresponding ref %d , tag : %d\n",i,k,pt->ref,ref,tag);
             }
         }
     }
@@ -34,81 +34,40 @@
  */
 
 #include "mmg3d.h"
+#include "metric_kernels.h"
+
+#define _MMG5_TMET iso
+#include "colver_tpl.h"
+#undef  _MMG5_TMET
+
+#define _MMG5_TMET ani
+#include "colver_tpl.h"
+#undef  _MMG5_TMET
+
+/** Call the instance of \ref _MMG5_chkcol_int_iso matching the metric type */
+int _MMG5_chkcol_int(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,char iface,
+                     char iedg,MMG5_int *list,char typchk) {
+    if ( met->size < 6 )
+        return(_MMG5_chkcol_int_iso(mesh,met,k,iface,iedg,list,typchk));
+    return(_MMG5_chkcol_int_ani(mesh,met,k,iface,iedg,list,typchk));
+}
 
-extern char  ddb;
-
-/** Check whether collapse ip -> iq could be performed, ip internal ;
- *  'mechanical' tests (positive jacobian) are not performed here */
-int _MMG5_chkcol_int(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
-                     char iedg,int *list,char typchk) {
-    MMG5_pTetra   pt,pt0;
-    MMG5_pPoint   p0;
-    double   calold,calnew,caltmp,lon;
-    int      j,iel,ilist,nq;
-    char     i,jj,ip,iq;
-
-    ip  = _MMG5_idir[iface][_MMG5_inxt2[iedg]];
-    iq  = _MMG5_idir[iface][_MMG5_iprv2[iedg]];
-    pt  = &mesh->tetra[k];
-    pt0 = &mesh->tetra[0];
-    nq  = pt->v[iq];
-    ilist = _MMG5_boulevolp(mesh,k,ip,list);
-    lon = 1.e20;
-    if ( typchk == 2 && met->m ) {
-        lon = _MMG5_lenedg(mesh,met,pt->v[ip],nq);
-        lon = MG_MIN(lon,_MMG5_LSHRT);
-        lon = MG_MAX(1.0/lon,_MMG5_LLONG);
-    }
-    calold = calnew = DBL_MAX;
-    for (j=0; j<ilist; j++) {
-        iel = list[j] / 4;
-        ip  = list[j] % 4;
-        pt  = &mesh->tetra[iel];
-        /* exclude elements from shell */
-        for (jj=0; jj<4; jj++)  if ( pt->v[jj] == nq )  break;
-        if ( jj < 4 )  continue;
-        memcpy(pt0,pt,sizeof(MMG5_Tetra));
-
-        /* prevent from recreating internal edge between boundaries */
-        if ( mesh->info.fem ) {
-            p0 = &mesh->point[nq];
-            if ( p0->tag & MG_BDY ) {
-                i = ip;
-                for (jj=0; jj<3; jj++) {
-                    i = _MMG5_inxt3[i];
-                    p0 = &mesh->point[pt->v[i]];
-                    if ( p0->tag & MG_BDY )  return(0);
-                }
-            }
-        }
-
-        pt0->v[ip] = nq;
-        calold = MG_MIN(calold,pt->qual);
-        caltmp = _MMG5_orcal(mesh,0);
-        if ( caltmp < _MMG5_EPSD )  return(0);
-        calnew = MG_MIN(calnew,caltmp);
-        /* check length */
-        if ( typchk == 2 && met->m ) {
-            for (jj=0; jj<6; jj++) {
-                if ( _MMG5_lenedg(mesh,met,pt0->v[_MMG5_iare[jj][0]],
-                                  pt0->v[_MMG5_iare[jj][1]]) > lon )  return(0);
-            }
-        }
-    }
-    if ( calold < _MMG5_NULKAL && calnew <= calold )  return(0);
-    else if ( calnew < _MMG5_NULKAL || calnew < 0.3*calold )  return(0);
-
-    return(ilist);
+/** Call the instance of \ref _MMG5_chkcol_ball_iso matching the metric type */
+int _MMG5_chkcol_ball(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,char iface,
+                      char iedg,MMG5_int *list,int ilist,char typchk) {
+    if ( met->size < 6 )
+        return(_MMG5_chkcol_ball_iso(mesh,met,k,iface,iedg,list,ilist,typchk));
+    return(_MMG5_chkcol_ball_ani(mesh,met,k,iface,iedg,list,ilist,typchk));
 }
 
 /** Topological check on the surface ball of np and nq in collapsing np->nq ;
  *  iface = boundary face on which lie edge iedg - in local face num.
  *  (pq, or ia in local tet notation) */
 static int
-_MMG5_topchkcol_bdy(MMG5_pMesh mesh,int k,int iface,char iedg,int *lists,int ilists) {
+_MMG5_topchkcol_bdy(MMG5_pMesh mesh,MMG5_int k,int iface,char iedg,MMG5_int *lists,int ilists) {
     MMG5_pTetra   pt;
     MMG5_pxTetra  pxt;
-    int      nump,numq,piv0,piv,iel,jel,nap,nbp,naq,nbq,nro,adj,*adja;
+    MMG5_int nump,numq,piv0,piv,iel,jel,nap,nbp,naq,nbq,nro,adj,*adja;
     char     ip,iq,ipiv,iopp,i,j,jface,ipa,ipb,isface;
 
     pt = &mesh->tetra[k];
@@ -389,13 +348,14 @@ _MMG5_topchkcol_bdy(MMG5_pMesh mesh,int k,int iface,char iedg,int *lists,int ili
  *  'mechanical' tests (positive jacobian) are not performed here ;
  *  iface = boundary face on which lie edge iedg - in local face num.
  *  (pq, or ia in local tet notation) */
-int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
+int _MMG5_chkcol_bdy(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,char iface,char iedg,MMG5_int *listv) {
     MMG5_pTetra        pt,pt0;
     MMG5_pxTetra       pxt;
     MMG5_pPoint        p0;
     MMG5_Tria          tt;
     double        calold,calnew,caltmp,nprvold[3],nprvnew[3],ncurold[3],ncurnew[3],ps,devold,devnew;
-    int           ipp,ilistv,nump,numq,ilists,lists[_MMG5_LMAX+2],l,iel,nbbdy,ndepmin,ndepplus;
+    MMG5_int      nump,numq,lists[_MMG5_LMAX+2],iel,ndepmin,ndepplus;
+    int           ipp,ilistv,ilists,l,nbbdy;
     char          iopp,ia,ip,tag,i,iq,i0,i1,ier,isminp,isplp;
 
     pt   = &mesh->tetra[k];
@@ -487,7 +447,7 @@ int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
         pt0->v[ipp] = numq;
 
         calold = MG_MIN(calold, pt->qual);
-        caltmp = _MMG5_orcal(mesh,0);
+        caltmp = _MMG5_orcal(mesh,met,0);
 
         if ( caltmp < _MMG5_EPSD )  return(0);
         calnew = MG_MIN(calnew,caltmp);
@@ -588,14 +548,15 @@ int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
 /** Collapse vertex p = list[0]%4 of tetra list[0]/4 over vertex indq of tetra list[0]/4.
  *  Only physical tests (positive jacobian) are done (i.e. approximation of the surface,
  *  etc... must be performed outside). */
-int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
+MMG5_int _MMG5_colver(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ilist,char indq) {
     MMG5_pTetra          pt,pt1;
     MMG5_pxTetra         pxt,pxt1;
     MMG5_xTetra          xt,xts;
-    int             i,iel,jel,pel,qel,k,np,nq,*adja,p0,p1;
+    MMG5_int        iel,jel,pel,qel,np,nq,*adja,p0,p1;
+    int             i,k;
     unsigned char   ip,iq,j,voy,voyp,voyq,ia,iav;
     unsigned char   ind[ilist][2];
-    int             p0_c[ilist],p1_c[ilist];
+    MMG5_int        p0_c[ilist],p1_c[ilist];
     char            indar[4][4][2] = {
         /* indar[ip][iq][0/1]: indices of edges which have iq for extremity but not ip*/
         { {-1,-1}, { 3, 4}, { 3, 5}, { 4, 5} },
@@ -609,8 +570,8 @@ int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
     np  = pt->v[ip];
     nq  = pt->v[indq];
 
-    memset(p0_c,0,ilist*sizeof(int));
-    memset(p1_c,0,ilist*sizeof(int));
+    memset(p0_c,0,ilist*sizeof(MMG5_int));
+    memset(p1_c,0,ilist*sizeof(MMG5_int));
     /* Mark elements of the shell of edge (pq) */
     for (k=0; k<ilist; k++) {
         iel = list[k] / 4;
@@ -1021,7 +982,7 @@ int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
         ip  = list[k] % 4;
         pt  = &mesh->tetra[iel];
         pt->v[ip] = nq;
-        pt->qual=_MMG5_orcal(mesh,iel);
+        pt->qual=_MMG5_orcal(mesh,met,iel);
     }
     return(np);
 }
@@ -0,0 +1,168 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/colver_tpl.h
+ * \brief Check of the collapses of colver.c, instantiated for each metric
+ * type.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by colver.c after the definition of
+ * \a _MMG5_TMET (see metric_kernels.h).
+ *
+ */
+
+/** Check whether collapse ip -> iq could be performed, ip internal, list
+ *  being the ilist elements of the ball of ip (see _MMG5_boulevolp) ;
+ *  'mechanical' tests (positive jacobian) are not performed here */
+int _MMG5_TNAME(_MMG5_chkcol_ball)(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,
+                                   char iface,char iedg,MMG5_int *list,
+                                   int ilist,char typchk) {
+    MMG5_pTetra   pt;
+    MMG5_pPoint   p0;
+#if _MMG5_TBATCH
+    _MMG5_TetBatch tb;
+    _MMG5_EdgBatch eb;
+    double   qual[_MMG5_BATCH],len[_MMG5_BATCH],*c[4];
+    int      l;
+#else
+    double   caltmp;
+#endif
+    double   calold,calnew,lon;
+    MMG5_int iel,nq,v[4];
+    int      j,islen;
+    char     i,jj,ip,iq;
+
+    ip  = _MMG5_idir[iface][_MMG5_inxt2[iedg]];
+    iq  = _MMG5_idir[iface][_MMG5_iprv2[iedg]];
+    pt  = &mesh->tetra[k];
+    nq  = pt->v[iq];
+    lon = 1.e20;
+    islen = 0;
+    if ( typchk == 2 && met->m ) {
+        lon = _MMG5_TLENEDG(mesh,met,pt->v[ip],nq);
+        lon = MG_MIN(lon,_MMG5_LSHRT);
+        lon = MG_MAX(1.0/lon,_MMG5_LLONG);
+        islen = 1;
+    }
+    calold = calnew = DBL_MAX;
+#if _MMG5_TBATCH
+    tb.n = eb.n = 0;
+#endif
+    for (j=0; j<ilist; j++) {
+        iel = list[j] / 4;
+        ip  = list[j] % 4;
+        pt  = &mesh->tetra[iel];
+        /* exclude elements from shell */
+        for (jj=0; jj<4; jj++)  if ( pt->v[jj] == nq )  break;
+        if ( jj < 4 )  continue;
+
+        /* prevent from recreating internal edge between boundaries */
+        if ( mesh->info.fem ) {
+            p0 = &mesh->point[nq];
+            if ( p0->tag & MG_BDY ) {
+                i = ip;
+                for (jj=0; jj<3; jj++) {
+                    i = _MMG5_inxt3[i];
+                    p0 = &mesh->point[pt->v[i]];
+                    if ( p0->tag & MG_BDY )  return(0);
+                }
+            }
+        }
+
+        calold = MG_MIN(calold,pt->qual);
+        memcpy(v,pt->v,4*sizeof(MMG5_int));
+        v[ip] = nq;
+#if _MMG5_TBATCH
+        for (jj=0; jj<4; jj++)  c[jj] = mesh->point[v[jj]].c;
+        _MMG5_BATCH_TET(&tb,c[0],c[1],c[2],c[3]);
+
+        /* check length */
+        if ( islen ) {
+            if ( eb.n > _MMG5_BATCH-6 ) {
+                _MMG5_batchLenedg(&eb,len);
+                for (l=0; l<eb.n; l++)  if ( len[l] > lon )  return(0);
+                eb.n = 0;
+            }
+            for (jj=0; jj<6; jj++)
+                _MMG5_BATCH_EDG(&eb,c[_MMG5_iare[jj][0]],c[_MMG5_iare[jj][1]],
+                                met->m[v[_MMG5_iare[jj][0]]],
+                                met->m[v[_MMG5_iare[jj][1]]]);
+        }
+
+        /* evaluation of the full batches */
+        if ( tb.n == _MMG5_BATCH ) {
+            _MMG5_batchCaltet(&tb,qual);
+            for (l=0; l<tb.n; l++) {
+                if ( qual[l] < _MMG5_EPSD )  return(0);
+                calnew = MG_MIN(calnew,qual[l]);
+            }
+            tb.n = 0;
+        }
+#else
+        caltmp = _MMG5_TCALTET(mesh,met,v[0],v[1],v[2],v[3]);
+        if ( caltmp < _MMG5_EPSD )  return(0);
+        calnew = MG_MIN(calnew,caltmp);
+
+        /* check length */
+        if ( islen ) {
+            for (jj=0; jj<6; jj++) {
+                if ( _MMG5_TLENEDG(mesh,met,v[_MMG5_iare[jj][0]],
+                                   v[_MMG5_iare[jj][1]]) > lon )  return(0);
+            }
+        }
+#endif
+    }
+#if _MMG5_TBATCH
+    if ( tb.n ) {
+        _MMG5_batchCaltet(&tb,qual);
+        for (l=0; l<tb.n; l++) {
+            if ( qual[l] < _MMG5_EPSD )  return(0);
+            calnew = MG_MIN(calnew,qual[l]);
+        }
+    }
+    if ( eb.n ) {
+        _MMG5_batchLenedg(&eb,len);
+        for (l=0; l<eb.n; l++)  if ( len[l] > lon )  return(0);
+    }
+#endif
+    if ( calold < _MMG5_NULKAL && calnew <= calold )  return(0);
+    else if ( calnew < _MMG5_NULKAL || calnew < 0.3*calold )  return(0);
+
+    return(ilist);
+}
+
+/** Check whether collapse ip -> iq could be performed, ip internal ;
+ *  'mechanical' tests (positive jacobian) are not performed here */
+int _MMG5_TNAME(_MMG5_chkcol_int)(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,
+                                  char iface,char iedg,MMG5_int *list,
+                                  char typchk) {
+    int      ilist;
+    char     ip;
+
+    ip    = _MMG5_idir[iface][_MMG5_inxt2[iedg]];
+    ilist = _MMG5_boulevolp(mesh,k,ip,list);
+    return(_MMG5_TNAME(_MMG5_chkcol_ball)(mesh,met,k,iface,iedg,list,ilist,
+                                          typchk));
+}
@@ -42,15 +42,13 @@
 #define  VOLMIN       1e-15//1.e-10//1.0e-15  --> vol negatif qd on rejoue
 #define LONMAX     4096
 
-int MMG_cas;
-extern int MMG_npuiss,MMG_nvol,MMG_npres;
 #define KTA     7
 #define KTB    11
 #define KTC    13
 
 /* hash mesh edge v[0],v[1] (face i of iel) */
-int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v) {
-    int             *adja,iadr,jel,j,key,mins,maxs;
+int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int iel,int i,MMG5_int *v) {
+    MMG5_int        *adja,iadr,jel,j,key,mins,maxs;
     _MMG5_hedge     *ha;
 
     /* compute key */
@@ -121,42 +119,174 @@ int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v)
     return(1);
 }
 
-/* cavity -> ball */
-int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return a pointer toward the scratch structure, NULL if fail.
+ *
+ * Allocate the scratch memory reused by \ref _MMG5_delone between two
+ * insertions. It is sized for the largest cavity accepted by the kernel so
+ * the insertion of a point doesn't allocate memory.
+ *
+ */
+_MMG5_pScratch _MMG5_newScratch(MMG5_pMesh mesh) {
+    _MMG5_pScratch  scr;
+
+    _MMG5_ADD_MEM(mesh,sizeof(_MMG5_Scratch),"delaunay scratch",return(NULL));
+    _MMG5_SAFE_CALLOC(scr,1,_MMG5_Scratch);
+
+    if ( !_MMG5_hashNew(mesh,&scr->hedg,3*LONMAX,9*LONMAX) ) {
+        _MMG5_DEL_MEM(mesh,scr,sizeof(_MMG5_Scratch));
+        return(NULL);
+    }
+    _MMG5_ADD_MEM(mesh,(3*LONMAX+1)*sizeof(MMG5_int),"new elements list",
+                  _MMG5_freeScratch(mesh,scr);
+                  return(NULL));
+    _MMG5_SAFE_CALLOC(scr->ielnum,3*LONMAX+1,MMG5_int);
+    _MMG5_ADD_MEM(mesh,(_MMG5_LMAX+2)*sizeof(MMG5_int),"cavity list",
+                  _MMG5_freeScratch(mesh,scr);
+                  return(NULL));
+    _MMG5_SAFE_CALLOC(scr->list,_MMG5_LMAX+2,MMG5_int);
+
+    /* circumsphere cache: optional */
+    _MMG5_growScratch(mesh,scr);
+
+    return(scr);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param scr pointer toward the scratch structure.
+ *
+ * Resize the circumsphere cache to the size of the tetra table. If we lack
+ * memory, the cache keeps its size (the spheres of the tetrahedra
+ * out of the cache are not stored).
+ *
+ */
+void _MMG5_growScratch(MMG5_pMesh mesh,_MMG5_pScratch scr) {
+    int  ier;
+
+    if ( scr->nsph >= mesh->nemax+1 )  return;
+
+    ier = 1;
+    _MMG5_ADD_MEM(mesh,(mesh->nemax+1-scr->nsph)*sizeof(_MMG5_Sphere),
+                  "circumsphere cache",ier = 0);
+    if ( !ier )  return;
+
+    if ( !scr->sph ) {
+        _MMG5_SAFE_CALLOC(scr->sph,mesh->nemax+1,_MMG5_Sphere);
+    }
+    else {
+        _MMG5_SAFE_RECALLOC(scr->sph,scr->nsph,mesh->nemax+1,_MMG5_Sphere,
+                            "circumsphere cache");
+    }
+    scr->nsph = mesh->nemax+1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param scr pointer toward the scratch structure.
+ *
+ * Free the scratch memory of the delaunay kernel.
+ *
+ */
+void _MMG5_freeScratch(MMG5_pMesh mesh,_MMG5_pScratch scr) {
+
+    if ( scr->sph )
+        _MMG5_DEL_MEM(mesh,scr->sph,scr->nsph*sizeof(_MMG5_Sphere));
+    if ( scr->list )
+        _MMG5_DEL_MEM(mesh,scr->list,(_MMG5_LMAX+2)*sizeof(MMG5_int));
+    if ( scr->ielnum )
+        _MMG5_DEL_MEM(mesh,scr->ielnum,(3*LONMAX+1)*sizeof(MMG5_int));
+    if ( scr->hedg.item )
+        _MMG5_DEL_MEM(mesh,scr->hedg.item,(scr->hedg.max+1)*sizeof(_MMG5_hedge));
+    _MMG5_DEL_MEM(mesh,scr,sizeof(_MMG5_Scratch));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param hash pointer toward the face hash table of the scratch structure.
+ * \param ip index of the inserted point.
+ * \param ielnum list of the \a ielnum[0] elements of the ball of \a ip.
+ *
+ * Empty the face hash table by visiting only the entries filled by the
+ * retriangulation of the cavity (the internal faces of the ball of \a ip).
+ *
+ */
+static void
+_MMG5_resetHashDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int ip,MMG5_int *ielnum) {
+    MMG5_pTetra  pt;
+    MMG5_int     k,v[3],key;
+    int          j,l,m;
+
+    for (k=1; k<=ielnum[0]; k++) {
+        pt = &mesh->tetra[ielnum[k]];
+        for (j=0; j<4; j++) {
+            if ( pt->v[j] == ip )  continue;
+            m = 0;
+            for (l=0; l<3; l++)
+                if ( pt->v[ _MMG5_idir[j][l] ] != ip )  v[m++] = pt->v[ _MMG5_idir[j][l] ];
+            key = KTA*MG_MIN(v[0],v[1]) + KTB*MG_MAX(v[0],v[1]);
+            key = key % hash->siz;
+            hash->item[key].a   = 0;
+            hash->item[key].nxt = 0;
+        }
+    }
+    /* overflow entries are taken in order from hash->siz */
+    for (k=hash->siz; k<hash->nxt; k++) {
+        hash->item[k].a   = 0;
+        hash->item[k].nxt = k+1;
+    }
+    hash->nxt = hash->siz;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param list cavity of the point to insert (elements marked with \a base).
+ * \param ilist number of elements in the cavity.
+ * \param base mark of the cavity.
+ * \param nxt pointer to store the number of xtetra to create.
+ * \return the number of elements of the ball (one by external face of the
+ * cavity), 0 if the cavity is rejected.
+ *
+ * Count the elements and the new xtetra of the ball replacing the cavity. The
+ * cavity is rejected if one of its vertices does not lie on an external face
+ * (it would be isolated) or if it has too many external faces.
+ *
+ */
+int _MMG5_delone_size(MMG5_pMesh mesh,MMG5_int *list,int ilist,int base,int *nxt) {
     MMG5_pPoint ppt;
-    MMG5_pTetra      pt,pt1;
-    MMG5_xTetra           xt;
-    MMG5_pxTetra          pxt0;
-    int             *adja,*adjb,i,j,k,l,m,iel,jel,old,v[3],iadr,base,size;
-    int              vois[4],iadrold;/*,ii,kk,_MMG5_iare1,_MMG5_iare2;*/
+    MMG5_pTetra      pt1;
+    MMG5_pxTetra     pxt;
+    MMG5_int        *adja,old,iadr;
+    int              i,j,k,size,nf;
+    MMG5_int         vois[4];
     short            i1;
     char             alert;
-    int              tref,isused=0,ixt,ielnum[3*LONMAX+1],ll;
-    _MMG5_Hash       hedg;
 
-    //obsolete avec la realloc
-    // if ( mesh->ne + 2*ilist > mesh->nemax )  {printf("on passe ici boum\n");return(0);}
-    base = mesh->mark;
     /* external faces */
     size = 0;
+    *nxt = 0;
     for (k=0; k<ilist; k++) {
         old  = list[k];
         pt1  = &mesh->tetra[old];
+        pxt  = pt1->xt ? &mesh->xtetra[pt1->xt] : 0;
         iadr = (old-1)*4 + 1;
         adja = &mesh->adja[iadr];
         vois[0]  = adja[0] >> 2;
         vois[1]  = adja[1] >> 2;
         vois[2]  = adja[2] >> 2;
         vois[3]  = adja[3] >> 2;
+        nf = 0;
         for (i=0; i<4; i++) {
-            jel = vois[i];
-            if ( !jel || mesh->tetra[jel].mark != base ) {
+            if ( !vois[i] || mesh->tetra[vois[i]].mark != base ) {
                 for (j=0; j<3; j++) {
                     i1  = _MMG5_idir[i][j];
                     ppt = &mesh->point[ pt1->v[i1] ];
                     ppt->tagdel |= MG_NOM;
                 }
                 size++;
+                /* the first boundary face reuses the xtetra of old */
+                if ( pxt && (pxt->ref[i] || pxt->ftag[i]) && nf++ )  (*nxt)++;
             }
         }
     }
@@ -179,30 +309,43 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
             ppt->tagdel &= ~MG_NOM;
         }
     }
-    if ( alert )  {return(0);}
+    if ( alert )  return(0);
     /* hash table params */
     if ( size > 3*LONMAX )  return(0);
-    if ( !_MMG5_hashNew(mesh,&hedg,size,3*size) ) { /*3*size suffit */
-        fprintf(stdout,"  ## Unable to complete mesh.\n");
-        return(-1);
-    }
 
-    /*tetra allocation : we create "size" tetra*/
-    ielnum[0] = size;
-    for (k=1 ; k<=size ; k++) {
-        ielnum[k] = _MMG5_newElt(mesh);
+    return(size);
+}
 
-        if ( !ielnum[k] ) {
-            _MMG5_TETRA_REALLOC(mesh,ielnum[k],mesh->gap,
-                                printf("  ## Warning: unable to allocate a new element but the mesh will be valid.\n");
-                                for(ll=1 ; ll<k ; ll++) {
-                                    mesh->tetra[ielnum[ll]].v[0] = 1;
-                                    _MMG5_delElt(mesh,ielnum[ll]);
-                                }
-                                return(-1);
-                );
-        }
-    }
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the solution structure.
+ * \param ip index of the point to insert.
+ * \param list cavity of \a ip (elements marked with \a base).
+ * \param ilist number of elements in the cavity.
+ * \param base mark of the cavity.
+ * \param hedg hash table of the faces (empty on input and output).
+ * \param ielnum list of the \a ielnum[0] elements of the ball, allocated by
+ * the caller (see \ref _MMG5_delone_size).
+ * \param ixt first of the xtetra allocated by the caller for the ball.
+ *
+ * Build the ball of \a ip in the elements \a ielnum. The elements of the
+ * cavity are left to the caller, only their external faces are updated. Only
+ * the elements of the cavity and their neighbours are modified, so disjoint
+ * cavities that share no vertex may be retriangulated concurrently (with
+ * their own hash tables).
+ *
+ */
+void _MMG5_delone_fill(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int ip,MMG5_int *list,
+                       int ilist,int base,_MMG5_Hash *hedg,MMG5_int *ielnum,
+                       MMG5_int ixt) {
+    MMG5_pTetra      pt,pt1;
+    MMG5_xTetra           xt;
+    MMG5_pxTetra          pxt0;
+    MMG5_int        *adja,*adjb,iel,jel,old,v[3],iadr;
+    int              i,j,k,l,m,size;
+    MMG5_int         vois[4],iadrold;
+    MMG5_int         hasxt;
+    int              isused=0;
 
     size = 1;
     for (k=0; k<ilist; k++) {
@@ -220,9 +363,9 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
             pxt0 = &mesh->xtetra[pt->xt];
             memcpy(&xt,pxt0,sizeof(MMG5_xTetra));
             isused=0;
-            ixt = 1;
+            hasxt = 1;
         } else {
-            ixt = 0;
+            hasxt = 0;
         }
 
         for (i=0; i<4; i++) {
@@ -237,57 +380,33 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
                 pt1 = &mesh->tetra[iel];
                 memcpy(pt1,pt,sizeof(MMG5_Tetra));
                 pt1->v[i] = ip;
-                pt1->qual = _MMG5_orcal(mesh,iel);
+                pt1->qual = _MMG5_orcal(mesh,sol,iel);
                 pt1->ref = mesh->tetra[old].ref;
-                if(pt1->qual < 1e-10) {printf("argggg (%d) %d : %e\n",ip,iel,pt1->qual);
-                    printf("pt1 : %d %d %d %d\n",pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);/*exit(0);*/}
+                if(pt1->qual < 1e-10) {printf("argggg (%" MMG5_PRId ") %" MMG5_PRId " : %e\n",ip,iel,pt1->qual);
+                    printf("pt1 : %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);/*exit(0);*/}
                 iadr = (iel-1)*4 + 1;
                 adjb = &mesh->adja[iadr];
                 adjb[i] = adja[i];
 
-                if(ixt) {
+                if(hasxt) {
                     if( xt.ref[i] || xt.ftag[i]) {
-                        // if(!adja[i] || (mesh->tetra[jel].ref != pt1->ref)) {
-                        /*  if((old==20329) || (iel==20329)) { */
-                        /*  printf("eh eh on en a un!!!"); */
-                        /*  printf("adj of %d : %d %d %d %d\n",old,adja[0],adja[1],adja[2],adja[3]); */
-                        /*  printf("adj of %d : %d %d %d %d\n",iel,adjb[0],adjb[1],adjb[2],adjb[3]); */
-                        /* printf("on traite %d\n",i); */
-                        /*  } */
                         if(!isused) {
                             pt1->xt = pt->xt;
                             pt->xt = 0;
-                            pxt0 = &mesh->xtetra[pt1->xt];
-                            memset(pxt0,0,sizeof(MMG5_xTetra));
-                            pxt0->ref[i]   = xt.ref[i] ; pxt0->ftag[i]  = xt.ftag[i];
-                            pxt0->edg[_MMG5_iarf[i][0]] = xt.edg[_MMG5_iarf[i][0]];
-                            pxt0->edg[_MMG5_iarf[i][1]] = xt.edg[_MMG5_iarf[i][1]];
-                            pxt0->edg[_MMG5_iarf[i][2]] = xt.edg[_MMG5_iarf[i][2]];
-                            pxt0->tag[_MMG5_iarf[i][0]] = xt.tag[_MMG5_iarf[i][0]];
-                            pxt0->tag[_MMG5_iarf[i][1]] = xt.tag[_MMG5_iarf[i][1]];
-                            pxt0->tag[_MMG5_iarf[i][2]] = xt.tag[_MMG5_iarf[i][2]];
-                            pxt0->ori = xt.ori;
                             isused=1;
                         } else {
-                            mesh->xt++;
-                            if ( mesh->xt > mesh->xtmax ) {
-                                _MMG5_TAB_RECALLOC(mesh,mesh->xtetra,mesh->xtmax,0.2,MMG5_xTetra,
-                                             "larger xtetra table",
-                                             mesh->xt--;
-                                             printf("  Exit program.\n");
-                                             exit(EXIT_FAILURE));
-                            }
-                            pt1->xt = mesh->xt;
-                            pxt0 = &mesh->xtetra[pt1->xt];
-                            pxt0->ref[i]   = xt.ref[i] ; pxt0->ftag[i]  = xt.ftag[i];
-                            pxt0->edg[_MMG5_iarf[i][0]] = xt.edg[_MMG5_iarf[i][0]];
-                            pxt0->edg[_MMG5_iarf[i][1]] = xt.edg[_MMG5_iarf[i][1]];
-                            pxt0->edg[_MMG5_iarf[i][2]] = xt.edg[_MMG5_iarf[i][2]];
-                            pxt0->tag[_MMG5_iarf[i][0]] = xt.tag[_MMG5_iarf[i][0]];
-                            pxt0->tag[_MMG5_iarf[i][1]] = xt.tag[_MMG5_iarf[i][1]];
-                            pxt0->tag[_MMG5_iarf[i][2]] = xt.tag[_MMG5_iarf[i][2]];
-                            pxt0->ori = xt.ori;
+                            pt1->xt = ixt++;
                         }
+                        pxt0 = &mesh->xtetra[pt1->xt];
+                        memset(pxt0,0,sizeof(MMG5_xTetra));
+                        pxt0->ref[i]   = xt.ref[i] ; pxt0->ftag[i]  = xt.ftag[i];
+                        pxt0->edg[_MMG5_iarf[i][0]] = xt.edg[_MMG5_iarf[i][0]];
+                        pxt0->edg[_MMG5_iarf[i][1]] = xt.edg[_MMG5_iarf[i][1]];
+                        pxt0->edg[_MMG5_iarf[i][2]] = xt.edg[_MMG5_iarf[i][2]];
+                        pxt0->tag[_MMG5_iarf[i][0]] = xt.tag[_MMG5_iarf[i][0]];
+                        pxt0->tag[_MMG5_iarf[i][1]] = xt.tag[_MMG5_iarf[i][1]];
+                        pxt0->tag[_MMG5_iarf[i][2]] = xt.tag[_MMG5_iarf[i][2]];
+                        pxt0->ori = xt.ori;
                     }
                     else {
                         pt1->xt = 0;
@@ -309,13 +428,70 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
                                 v[m] = pt1->v[ _MMG5_idir[j][l] ];
                                 m++;
                             }
-                        _MMG5_hashEdgeDelone(mesh,&hedg,iel,j,v);
+                        _MMG5_hashEdgeDelone(mesh,hedg,iel,j,v);
                     }
                 }
             }
         }
     }
 
+    _MMG5_resetHashDelone(mesh,hedg,ip,ielnum);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the solution structure.
+ * \param ip index of the point to insert.
+ * \param list cavity of \a ip (elements marked with \a mesh->mark).
+ * \param ilist number of elements in the cavity.
+ * \param scr pointer toward the scratch memory of the kernel.
+ * \return 1 if success, 0 if the cavity is rejected, -1 if fail.
+ *
+ * Retriangulate the cavity of \a ip into the ball of \a ip (cavity -> ball).
+ *
+ */
+int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int ip,MMG5_int *list,int ilist,
+                 _MMG5_pScratch scr) {
+    MMG5_int        *ielnum,ixt;
+    int              k,base,size,nxt,tref,ll;
+
+    //obsolete avec la realloc
+    // if ( mesh->ne + 2*ilist > mesh->nemax )  {printf("on passe ici boum\n");return(0);}
+    base = mesh->mark;
+    size = _MMG5_delone_size(mesh,list,ilist,base,&nxt);
+    if ( !size )  return(0);
+    ielnum = scr->ielnum;
+
+    /*tetra allocation : we create "size" tetra*/
+    ielnum[0] = size;
+    for (k=1 ; k<=size ; k++) {
+        ielnum[k] = _MMG5_newElt(mesh);
+
+        if ( !ielnum[k] ) {
+            _MMG5_TETRA_REALLOC(mesh,ielnum[k],mesh->gap,
+                                printf("  ## Warning: unable to allocate a new element but the mesh will be valid.\n");
+                                for(ll=1 ; ll<k ; ll++) {
+                                    mesh->tetra[ielnum[ll]].v[0] = 1;
+                                    _MMG5_delElt(mesh,ielnum[ll]);
+                                }
+                                ielnum[0] = 0;
+                                return(-1);
+                );
+        }
+    }
+
+    /* xtetra allocation */
+    while ( mesh->xt+nxt > mesh->xtmax ) {
+        _MMG5_TAB_RECALLOC(mesh,mesh->xtetra,mesh->xtmax,0.2,MMG5_xTetra,
+                           "larger xtetra table",
+                           printf("  Exit program.\n");
+                           exit(EXIT_FAILURE));
+    }
+    ixt       = mesh->xt+1;
+    mesh->xt += nxt;
+
+    _MMG5_delone_fill(mesh,sol,ip,list,ilist,base,&scr->hedg,ielnum,ixt);
+
     /* remove old tetra */
     tref = mesh->tetra[list[0]].ref;
     for (k=0; k<ilist; k++) {
@@ -324,25 +500,39 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
         _MMG5_delElt(mesh,list[k]);
     }
 
-    //ppt = &mesh->point[ip];
-    //  ppt->flag = mesh->flag;
-    _MMG5_DEL_MEM(mesh,hedg.item,(hedg.max+1)*sizeof(_MMG5_hedge));
     return(1);
 }
 
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the tetrahedron.
+ * \param preg region of each point (NULL in sequential mode).
+ * \param reg region of the current thread.
+ * \return 1 if the tetrahedron belongs to the region \a reg, 0 otherwise.
+ *
+ * A tetrahedron belongs to a region if its four vertices belong to it. In
+ * sequential mode, all the tetrahedra are owned by the caller.
+ *
+ */
+static inline int
+_MMG5_owntet(MMG5_pMesh mesh,MMG5_pTetra pt,int *preg,int reg) {
+    if ( !preg )  return(1);
+    return( preg[pt->v[0]] == reg && preg[pt->v[1]] == reg &&
+            preg[pt->v[2]] == reg && preg[pt->v[3]] == reg );
+}
+
 /* cavity correction for quality */
 static int
-_MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
-    MMG5_pPoint ppt,p1,p2,p3;
+_MMG5_correction_iso(MMG5_pMesh mesh,double *c,int base,MMG5_int *list,int ilist,
+                     int nedep,int *preg,int reg,int *cas) {
+    MMG5_pPoint p1,p2,p3;
     MMG5_pTetra      pt;
     double           dd,nn,eps,eps2,ux,uy,uz,vx,vy,vz,v1,v2,v3;
-    int             *adja,i,ipil,iel,lon,iadr,adj,ib,ic,id,base,ncor;
-    int              vois[4];
+    MMG5_int        *adja,iel,iadr,adj,ib,ic,id;
+    int              i,ipil,lon,ncor;
+    MMG5_int         vois[4];
 
-    ppt  = &mesh->point[ip];
-    if ( ppt->tag & MG_NUL )  return(ilist);
-    base = mesh->mark;
     lon  = ilist;
     eps  = _MMG5_EPSCON;
     eps2 = eps*eps;
@@ -359,11 +549,12 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
             vois[2]  = adja[2] >> 2;
             vois[3]  = adja[3] >> 2;
             pt   = &mesh->tetra[iel];
-            MMG_cas=0;
+            *cas=0;
             for (i=0; i<4; i++) {
                 adj = vois[i];
-                MMG_cas = 0;
-                if ( adj && mesh->tetra[adj].mark == base )  continue;
+                *cas = 0;
+                if ( adj && _MMG5_owntet(mesh,&mesh->tetra[adj],preg,reg)
+                     && mesh->tetra[adj].mark == base )  continue;
 
                 ib = pt->v[ _MMG5_idir[i][0] ];
                 ic = pt->v[ _MMG5_idir[i][1] ];
@@ -385,18 +576,18 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
                 v1 = uz*vy - uy*vz;
                 v2 = ux*vz - uz*vx;
                 v3 = uy*vx - ux*vy;
-                dd = v1*(ppt->c[0]-p1->c[0]) + v2*(ppt->c[1]-p1->c[1]) \
-                    + v3*(ppt->c[2]-p1->c[2]);
-                MMG_cas=1;
+                dd = v1*(c[0]-p1->c[0]) + v2*(c[1]-p1->c[1]) \
+                    + v3*(c[2]-p1->c[2]);
+                *cas=1;
                 //printf("on trouve vol %e <? %e\n",dd,VOLMIN);
                 if ( dd < VOLMIN )  break;
 
                 /* point close to face */
                 nn = (v1*v1 + v2*v2 + v3*v3);
-                MMG_cas=2;
+                *cas=2;
                 //printf("on trouve close ? %e %e\n",dd*dd,nn*eps2);
                 if ( dd*dd < nn * eps2 )  break;
-                MMG_cas=0;
+                *cas=0;
             }
             if ( i < 4 ||  pt->tag & MG_REQ ) {
                 if ( ipil <= nedep )  {/*printf("on veut tout retirer ? %d %d\n",ipil,nedep);*/return(0);   }
@@ -417,138 +608,127 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
 }
 
 
-/* /\* mark elements in cavity *\/ */
-/* int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,pList list,int lon) { */
-/*   MMG5_pPoint    ppt; */
-/*   MMG5_pTetra    pt,pt1,ptc; */
-/*   double    c[3],eps,dd,ray,ux,uy,uz,crit; */
-/*   double    *mj,*mp,ct[12]; */
-/*   int       *adja,*adjb,k,adj,adi,voy,i,j,ia,ilist,ipil,jel,iadr,base; */
-/*   int       vois[4],l; */
-
-/*   if ( lon < 1 )  return(0); */
-/*   ppt = &mesh->point[ip]; */
-/*   if ( ppt->tag & M_UNUSED )  return(0); */
-
-/*   for (k=1; k<=lon; k++) */
-/*     list->tetra[k] = list->tetra[k] / 6; */
-
-/*   /\* grow cavity by adjacency *\/ */
-/*   base  = mesh->mark; */
-/*   eps   = _MMG5_EPSRAD * _MMG5_EPSRAD; */
-/*   ilist = lon; */
-/*   ipil  = 1; */
-/*   iadr  = (ip-1)*sol->offset + 1; */
-/*   mp    = &sol->met[iadr]; */
-
-/*   do { */
-/*     jel  = list->tetra[ipil]; */
-/*     iadr = (jel-1)*4 + 1; */
-/*     adja = &mesh->adja[iadr]; */
-/*     vois[0]  = adja[0]; */
-/*     vois[1]  = adja[1]; */
-/*     vois[2]  = adja[2]; */
-/*     vois[3]  = adja[3]; */
-/*     ptc  = &mesh->tetra[jel]; */
-
-/*     for (i=0; i<4; i++) { */
-/*       adj = vois[i] >> 2; */
-/*       voy = vois[i] % 4; */
-/*       if ( !adj )  continue; */
-/*       pt  = &mesh->tetra[adj]; */
-/*       /\* boundary face *\/ */
-/*       if ( pt->mark == base || pt->ref != ptc->ref )  continue; */
-/*       for (j=0,l=0; j<4; j++,l+=3) { */
-/*      memcpy(&ct[l],mesh->point[pt->v[j]].c,3*sizeof(double)); */
-/*       } */
-
-
-/*       /\* Delaunay kernel *\/ */
-/*       if ( !_MMG5_cenrad_ani(mesh,ct,mp,c,&ray) )  continue; */
-
-/*       ux = ppt->c[0] - c[0]; */
-/*       uy = ppt->c[1] - c[1]; */
-/*       uz = ppt->c[2] - c[2]; */
-/*       dd =      mp[0]*ux*ux + mp[3]*uy*uy + mp[5]*uz*uz \ */
-/*      + 2.0*(mp[1]*ux*uy + mp[2]*ux*uz + mp[4]*uy*uz); */
-/*       crit = eps * ray; */
-/*       if ( dd > crit )  continue; */
-
-/*       /\* mixed metrics *\/ */
-/*       crit = sqrt(dd/ray); */
-/*       for (j=0; j<4; j++) { */
-/*      ia   = pt->v[j]; */
-/*      iadr = (ia-1)*sol->offset + 1; */
-/*      mj   = &sol->met[iadr]; */
-/*      if ( !_MMG5_cenrad_ani(mesh,ct,mj,c,&ray) )  continue; */
-/*      ux = ppt->c[0] - c[0]; */
-/*      uy = ppt->c[1] - c[1]; */
-/*      uz = ppt->c[2] - c[2]; */
-/*      dd =      mj[0]*ux*ux + mj[3]*uy*uy + mj[5]*uz*uz \ */
-/*        + 2.0*(mj[1]*ux*uy + mj[2]*ux*uz + mj[4]*uy*uz); */
-/*      crit += sqrt(dd/ray); */
-/*       } */
-/*       crit *= _MMG5_EPSRAD; */
-/*       if ( crit > 5.0 ) continue; */
-
-/*       /\* lost face(s) *\/ */
-/*       iadr = (adj-1)*4 + 1; */
-/*       adjb = &mesh->adja[iadr]; */
-
-/*       for (j=0; j<4; j++) { */
-/*      if ( j == voy )  continue; */
-/*      adi = adjb[j] >> 2; */
-/*      if ( !adi )  continue; */
-/*      pt1 = &mesh->tetra[adi]; */
-/*      if ( pt1->mark == base && adi != jel ) { */
-/*        if ( !adi || pt1->ref != mesh->tetra[adi].ref )  break; */
-/*      } */
-/*       } */
-/*       /\* store tetra *\/ */
-/*       if ( j == 4 ) { */
-/*      pt->mark = base; */
-/*      ++ilist; */
-/*      list->tetra[ilist] = adj; */
-/*       } */
-/*     } */
-/*     if ( ilist > LONMAX - 3 )  return(-1); */
-/*     ++ipil; */
-/*   } */
-/*   while ( ipil <= ilist ); */
-
-/*   /\* global overflow *\/ */
-/*   if ( mesh->ne + 2*ilist >= mesh->nemax ) */
-/*     ilist = -ilist; */
-/*   else */
-/*     ilist = _MMG5_correction_ani(mesh,sol,ip,list,ilist,lon); */
-
-/*   if(MMG_cas==1) MMG_nvol++; */
-/*   else if(MMG_cas==2 || MMG_cas>20) { */
-/*     MMG_npuiss++; */
-/*     if(MMG_cas>20) MMG_npres++; */
-/*   } */
-
-/*   return(ilist); */
-/* } */
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sph circumsphere cache (NULL if we don't use it).
+ * \param nsph size of the cache.
+ * \param k index of the tetrahedron.
+ * \param c pointer toward the center of the circumsphere.
+ * \param ray pointer toward the squared radius of the circumsphere.
+ * \param nhit pointer toward the number of cache hits.
+ * \return 0 if the element is flat, 1 otherwise.
+ *
+ * Circumsphere of the tetrahedron \a k. A cache entry is valid while the
+ * vertices and the quality of the element are unchanged: all the operators
+ * (delaunay kernel, splits, collapse, swaps and point relocations) update
+ * the quality of the elements that they create or modify.
+ *
+ */
+static inline int
+_MMG5_cenradCache(MMG5_pMesh mesh,_MMG5_Sphere *sph,MMG5_int nsph,MMG5_int k,
+                  double *c,double *ray,int *nhit) {
+    MMG5_pTetra   pt;
+    _MMG5_Sphere *ps;
+    double        ct[12];
+    int           j,l,ier;
+
+    pt = &mesh->tetra[k];
+    ps = ( sph && k < nsph ) ? &sph[k] : NULL;
+
+    if ( ps && ps->v[0] == pt->v[0] && ps->v[1] == pt->v[1]
+         && ps->v[2] == pt->v[2] && ps->v[3] == pt->v[3]
+         && ps->qual == pt->qual ) {
+        (*nhit)++;
+        if ( ps->rad < 0. )  return(0);
+        memcpy(c,ps->c,3*sizeof(double));
+        *ray = ps->rad;
+        return(1);
+    }
 
+    for (j=0,l=0; j<4; j++,l+=3) {
+        memcpy(&ct[l],mesh->point[pt->v[j]].c,3*sizeof(double));
+    }
+    ier = _MMG5_cenrad_iso(mesh,ct,c,ray);
+
+    if ( ps ) {
+        memcpy(ps->v,pt->v,4*sizeof(MMG5_int));
+        ps->qual = pt->qual;
+        if ( ier ) {
+            memcpy(ps->c,c,3*sizeof(double));
+            ps->rad = *ray;
+        }
+        else  ps->rad = -1.;
+    }
+    return(ier);
+}
 
-/** Return a negative value for ilist if one of the tet of the cavity is required */
-int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon) {
-    MMG5_pPoint ppt;
-    MMG5_pTetra      pt,pt1,ptc;
-    double           c[3],crit,dd,eps,ray,ct[12];
-    int             *adja,*adjb,k,adj,adi,voy,i,j,ilist,ipil,jel,iadr,base;
-    int              vois[4],l;
-    int              tref,isreq;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward a tetrahedron of the region \a reg.
+ * \param base mark of the current cavity.
+ * \param mark0 value of \a mesh->mark before the first cavity of the
+ * concurrent pass.
+ * \return 1 if \a pt is already stored in another cavity of the current pass.
+ *
+ * During a concurrent pass, the cavity \a n is marked with the even value
+ * \f$mark0+2(n+1)\f$ (the odd values being used for the removed tetrahedra).
+ *
+ */
+static inline int
+_MMG5_cavtaken(MMG5_pTetra pt,int base,int mark0) {
+    return( pt->mark > mark0 && pt->mark != base && !((pt->mark-mark0)%2) );
+}
 
-    if ( lon < 1 )  return(0);
-    ppt = &mesh->point[ip];
-    if ( ppt->tag & MG_NUL )  return(0);
-    base  = ++mesh->mark;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param scr pointer toward the scratch memory of the kernel (may be NULL).
+ * \param c coordinates of the point to insert.
+ * \param mp metric at the point to insert (NULL for the euclidean cavity).
+ * \param base mark used to store the cavity tetrahedra.
+ * \param list pointer toward the shell of the edge on input, cavity on output.
+ * \param lon size of the shell.
+ * \param preg region of each point (NULL in sequential mode).
+ * \param reg region to which belongs the cavity.
+ * \param mark0 value of \a mesh->mark before the concurrent pass.
+ * \param cas pointer toward the reason of the last cavity correction.
+ * \return the size of the cavity (negative if it contains a required
+ * tetrahedron or if the cavity is too large), 0 if fail.
+ *
+ * Cavity of the point \a c. In concurrent mode (\a preg non NULL), the
+ * cavity may only contains tetrahedra of the region \a reg not yet used by
+ * another cavity and the marks of its tetrahedra are released if we fail.
+ * With a metric \a mp, the Delaunay criterion is evaluated with the
+ * circumspheres in this metric (which are not cached).
+ *
+ */
+static inline int
+_MMG5_cavity_met(MMG5_pMesh mesh,_MMG5_pScratch scr,double *c0,double *mp,
+                 int base,MMG5_int *list,int lon,int *preg,int reg,int mark0,
+                 int *cas) {
+    MMG5_pTetra      pt,pt1,ptc;
+    _MMG5_Sphere    *sph;
+    double           c[3],ct[12],crit,dd,eps,ray,ux,uy,uz;
+    MMG5_int        *adja,*adjb,adj,adi,jel,iadr;
+    int              k,voy,i,j,l,ilist,ipil;
+    MMG5_int         vois[4],nsph;
+    int              ret,nhit,nlook;
+    int              tref,isreq,own;
 
     isreq = 0;
+    *cas  = 0;
+    sph   = scr ? scr->sph  : NULL;
+    nsph  = scr ? scr->nsph : 0;
+    nhit  = nlook = 0;
 
     tref = mesh->tetra[list[0]/6].ref;
+    if ( preg ) {
+        for (k=0; k<lon; k++) {
+            pt = &mesh->tetra[list[k]/6];
+            if ( !_MMG5_owntet(mesh,pt,preg,reg) || _MMG5_cavtaken(pt,base,mark0)
+                 || tref!=pt->ref )
+                return(0);
+        }
+    }
     for (k=0; k<lon; k++) {
         mesh->tetra[list[k]/6].mark = base;
 
@@ -580,22 +760,43 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
             voy = vois[i] % 4;
             if ( !adj )  continue;
             pt  = &mesh->tetra[adj];
+            own = _MMG5_owntet(mesh,pt,preg,reg);
             /* boundary face */
-            if ( pt->mark == base || pt->ref != ptc->ref )  continue;
-
-            for (j=0,l=0; j<4; j++,l+=3) {
-                memcpy(&ct[l],mesh->point[pt->v[j]].c,3*sizeof(double));
+            if ( (own && pt->mark == base) || pt->ref != ptc->ref )  continue;
+
+            /* in concurrent mode, the cache entries of the tetra of the
+             * other regions may be written by another thread */
+            if ( mp ) {
+                for (j=0,l=0; j<4; j++,l+=3)
+                    memcpy(&ct[l],mesh->point[pt->v[j]].c,3*sizeof(double));
+                if ( !_MMG5_cenrad_ani(mesh,ct,mp,c,&ray) )  continue;
+
+                /* Delaunay criterion in the metric */
+                ux = c0[0] - c[0];
+                uy = c0[1] - c[1];
+                uz = c0[2] - c[2];
+                dd =      mp[0]*ux*ux + mp[3]*uy*uy + mp[5]*uz*uz \
+                    + 2.0*(mp[1]*ux*uy + mp[2]*ux*uz + mp[4]*uy*uz);
+            }
+            else {
+                nlook++;
+                if ( !_MMG5_cenradCache(mesh,own ? sph : NULL,nsph,adj,c,&ray,
+                                        &nhit) )  continue;
+
+                /* Delaunay criterion */
+                dd = (c0[0] - c[0]) * (c0[0] - c[0]) \
+                    + (c0[1] - c[1]) * (c0[1] - c[1]) \
+                    + (c0[2] - c[2]) * (c0[2] - c[2]);
             }
-
-            if ( !_MMG5_cenrad_iso(mesh,ct,c,&ray) )  continue;
             crit = eps * ray;
-
-            /* Delaunay criterion */
-            dd = (ppt->c[0] - c[0]) * (ppt->c[0] - c[0]) \
-                + (ppt->c[1] - c[1]) * (ppt->c[1] - c[1]) \
-                + (ppt->c[2] - c[2]) * (ppt->c[2] - c[2]);
             if ( dd > crit )  continue;
 
+            /* the cavity cross the region boundary or another cavity */
+            if ( !own || (preg && _MMG5_cavtaken(pt,base,mark0)) ) {
+                ret = 0;
+                goto release;
+            }
+
             /* lost face(s) */
             iadr = (adj-1)*4 + 1;
             adjb = &mesh->adja[iadr];
@@ -605,6 +806,7 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
                 adi = adjb[j] >> 2;
                 if ( !adi )  continue;
                 pt1 = &mesh->tetra[adi];
+                if ( !_MMG5_owntet(mesh,pt1,preg,reg) )  continue;
                 if ( pt1->mark == base && adi != jel ) {
                     if ( !adi || pt1->ref != tref )  break;
                 }
@@ -616,7 +818,10 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
                 list[ilist++] = adj;
             }
         }
-        if ( ilist > LONMAX - 3 ) return(-1);
+        if ( ilist > LONMAX - 3 ) {
+            ret = -1;
+            goto release;
+        }
 
         ++ipil;
     }
@@ -625,14 +830,69 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
     /* global overflow: obsolete avec la reallocation */
     //if ( mesh->ne + 2*ilist >= mesh->nemax ) {
 
-    ilist = _MMG5_correction_iso(mesh,ip,list,ilist,lon);
+    ret = _MMG5_correction_iso(mesh,c0,base,list,ilist,lon,preg,reg,cas);
+
+    if ( isreq ) ret = -abs(ret);
+
+    if ( preg && ret < 1 )  goto release;
+
+    goto count;
+
+release:
+    /* concurrent mode: the tetra of the cavity may be used by another point */
+    if ( preg ) {
+        for (k=0; k<ilist; k++)
+            mesh->tetra[list[k]].mark = base-1;
+    }
+
+count:
+    if ( sph ) {
+#ifdef USE_OPENMP
+#pragma omp atomic
+#endif
+        scr->nhit  += nhit;
+#ifdef USE_OPENMP
+#pragma omp atomic
+#endif
+        scr->nmiss += nlook-nhit;
+    }
+    return(ret);
+}
+
+/** Euclidean cavity of the point \a c0 (see \ref _MMG5_cavity_met) */
+int _MMG5_cavity_iso(MMG5_pMesh mesh,_MMG5_pScratch scr,double *c0,int base,
+                     MMG5_int *list,int lon,int *preg,int reg,int mark0,int *cas) {
+    return(_MMG5_cavity_met(mesh,scr,c0,NULL,base,list,lon,preg,reg,mark0,cas));
+}
+
+/** Cavity of the point \a c0 in the metric \a mp (see \ref _MMG5_cavity_met) */
+int _MMG5_cavity_ani(MMG5_pMesh mesh,_MMG5_pScratch scr,double *c0,double *mp,
+                     int base,MMG5_int *list,int lon,int *preg,int reg,int mark0,
+                     int *cas) {
+    return(_MMG5_cavity_met(mesh,scr,c0,mp,base,list,lon,preg,reg,mark0,cas));
+}
+
+/** Return a negative value for ilist if one of the tet of the cavity is required */
+int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int iel,MMG5_int ip,MMG5_int *list,int lon,
+                 _MMG5_pScratch scr) {
+    MMG5_pPoint ppt;
+    int         ilist,base;
+
+    if ( lon < 1 )  return(0);
+    ppt = &mesh->point[ip];
+    if ( ppt->tag & MG_NUL )  return(0);
+    base  = ++mesh->mark;
 
-    if ( isreq ) ilist = -fabs(ilist);
+    if ( sol->m && sol->size == 6 )
+        ilist = _MMG5_cavity_ani(mesh,scr,ppt->c,&sol->m[(ip-1)*sol->size+1],base,
+                                 list,lon,NULL,0,0,&scr->cas);
+    else
+        ilist = _MMG5_cavity_iso(mesh,scr,ppt->c,base,list,lon,NULL,0,0,&scr->cas);
 
-    if(MMG_cas==1) MMG_nvol++;
-    else if(MMG_cas==2 || MMG_cas>20) {
-        MMG_npuiss++;
-        if(MMG_cas>20) MMG_npres++;
+    if(scr->cas==1) scr->nvol++;
+    else if(scr->cas==2 || scr->cas>20) {
+        scr->npuiss++;
+        if(scr->cas>20) scr->npres++;
     }
     return(ilist);
 }
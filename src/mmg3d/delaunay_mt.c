@@ -0,0 +1,524 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/delaunay_mt.c
+ * \brief Concurrent insertion of points by the delaunay kernel.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ * \remark Delaunay mode only (\a PATTERN flag set to \a OFF) with the
+ * \a USE_OPENMP flag.
+ *
+ * The domain is split in regions made of blocks of bucket cells. A
+ * tetrahedron belongs to a region if its four vertices belong to it. Each
+ * thread builds the cavities of the points to insert in its regions, marking
+ * each cavity with its own value. Cavities that cross a region boundary or
+ * another cavity are deferred.
+ *
+ * The points, the elements and the xtetra of the balls are then taken from
+ * the free lists of the mesh in a sequential pass, since these lists are not
+ * shared between threads. Last, each thread retriangulates the cavities of
+ * its regions with its own face hash table. Two regions share no vertex, so
+ * the cavities of two regions, and their neighbours, share no element. The
+ * old elements are freed at the end, in the order of the candidates.
+ *
+ * A cavity only reads and marks the tetrahedra of its region, and each
+ * region has its own part of the cavity buffer, so the cavities kept in a
+ * region do not depend on the thread that processes it: the resulting mesh
+ * only depends on the number of threads (through the size of the regions).
+ *
+ * The passes alternate the regions and the regions shifted by half a region,
+ * so the cavities deferred at a region boundary lie inside a region of the
+ * next pass, and the deferred cavities are retried on the new mesh. The
+ * edges that remain are processed by the sequential sweep.
+ *
+ */
+
+#ifdef USE_OPENMP
+
+#include <omp.h>
+#include "mmg3d.h"
+
+#define PRECI 1
+
+/** maximal number of concurrent passes */
+#define _MMG5_MTPASS   8
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param shift 1 to shift the regions by half a region, 0 otherwise.
+ * \param preg pointer toward the region of each point (to free).
+ * \return the number of regions, 0 if fail.
+ *
+ * Partition the points in regions of the grid of the bucket: a tetrahedron
+ * belongs to a region if its four vertices belong to it, thus two
+ * tetrahedra of two regions share no vertex. There are about 8 regions per
+ * thread to balance the load. The shifted partition has one more region
+ * along each axis, the first and the last ones being half regions.
+ *
+ */
+int _MMG5_regions(MMG5_pMesh mesh,_MMG5_pBucket bucket,int shift,int **preg) {
+    MMG5_pPoint   ppt;
+    double        dd;
+    MMG5_int      k;
+    int           ii,jj,kk,nr,nrs,siz,nthr;
+
+    nthr = mesh->info.threads;
+    siz  = bucket->size;
+    nr   = (int)ceil(cbrt(8.0*nthr));
+    nr   = MG_MIN(nr,siz);
+    nrs  = nr + shift;
+
+    _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"point regions",return(0));
+    _MMG5_SAFE_MALLOC(*preg,mesh->np+1,int);
+
+    dd = siz / (double)PRECI;
+#pragma omp parallel for num_threads(nthr) schedule(static) private(ppt,ii,jj,kk)
+    for (k=1; k<=mesh->np; k++) {
+        ppt = &mesh->point[k];
+        ii = MG_MAX(0,(int)(dd * ppt->c[0])-1);
+        jj = MG_MAX(0,(int)(dd * ppt->c[1])-1);
+        kk = MG_MAX(0,(int)(dd * ppt->c[2])-1);
+        ii = MG_MIN(nrs-1,(2*ii*nr+shift*siz)/(2*siz));
+        jj = MG_MIN(nrs-1,(2*jj*nr+shift*siz)/(2*siz));
+        kk = MG_MIN(nrs-1,(2*kk*nr+shift*siz)/(2*siz));
+        (*preg)[k] = (kk*nrs + jj)*nrs + ii;
+    }
+    return(nrs*nrs*nrs);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param cedg edge to split in each tetrahedron (-1 if none).
+ * \param k index of the tetrahedron.
+ * \param list shell of the edge \a cedg[k] of \a k (see \ref _MMG5_coquil).
+ * \param ilist size of the shell.
+ * \return 1 if a tetrahedron of smaller index of the shell splits the same
+ * edge, 0 otherwise.
+ *
+ * The midpoint of an edge is inserted only once, by the first tetrahedron of
+ * its shell that splits it.
+ *
+ */
+static inline int
+_MMG5_dupedg(MMG5_pMesh mesh,char *cedg,MMG5_int k,MMG5_int *list,int ilist) {
+    MMG5_pTetra   pt,pt1;
+    MMG5_int      k1,a,b,a1,b1;
+    int           i;
+
+    pt = &mesh->tetra[k];
+    a  = pt->v[_MMG5_iare[(int)cedg[k]][0]];
+    b  = pt->v[_MMG5_iare[(int)cedg[k]][1]];
+    for (i=0; i<ilist; i++) {
+        k1 = list[i] / 6;
+        if ( k1 >= k || cedg[k1] < 0 )  continue;
+        pt1 = &mesh->tetra[k1];
+        a1  = pt1->v[_MMG5_iare[(int)cedg[k1]][0]];
+        b1  = pt1->v[_MMG5_iare[(int)cedg[k1]][1]];
+        if ( (a1 == a && b1 == b) || (a1 == b && b1 == a) )  return(1);
+    }
+    return(0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param lopt edges longer than \a lopt are splitted.
+ * \param shift 1 to use the shifted regions, 0 otherwise.
+ * \param ne number of tetrahedra before the first pass.
+ * \param done 1 for the tetrahedra created by the previous passes.
+ * \param ifilt pointer toward the number of points filtered by the bucket.
+ * \param ns pointer toward the number of inserted points.
+ * \param nins pointer toward the number of points inserted by the pass.
+ * \param ndef pointer toward the number of cavities deferred by the pass.
+ * \param warn pointer toward a flag set if we fail to allocate a point.
+ * \return -1 if fail and we don't save the mesh, 0 if fail but we try to
+ * save the mesh, 1 otherwise.
+ *
+ * One concurrent pass of insertion of the midpoints of the longest internal
+ * edges of the tetrahedra of the regions. As in the sequential sweep, the
+ * tetrahedra created during the current sweep are not candidates.
+ *
+ */
+static int
+_MMG5_delone_pass(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                  _MMG5_pScratch scr,double lopt,int shift,MMG5_int ne,
+                  char *done,MMG5_int *ifilt,MMG5_int *ns,MMG5_int *nins,
+                  MMG5_int *ndef,int *warn) {
+    MMG5_pTetra   pt;
+    MMG5_pPoint   p0,p1;
+    double        len,lmax,o[3],mp[6],*m0,*m1;
+    _MMG5_Hash   *hedg;
+    MMG5_int     *work,*cand,*coff,*clon,*csiz,*cxt,*cip,*celn,*cnt,*used,*buf;
+    MMG5_int     *eln,*ielnum;
+    int          *preg;
+    MMG5_int      k,c,ip,ip1,ip2,ncand,cap,nd,nel,neln,nwork;
+    int           r,t,i,ie,ilist,lon,base,mark0,ret,nx,nbal;
+    int           nreg,nthr,nvol,npuiss,npres,npd,cas;
+    MMG5_int      list[_MMG5_LMAX+2];
+    char         *cedg,imax;
+
+    nthr  = mesh->info.threads;
+    ret   = 1;
+    *nins = *ndef = 0;
+
+    /* region of each point */
+    nreg = _MMG5_regions(mesh,bucket,shift,&preg);
+    if ( !nreg )  return(1);
+
+    /* longest edge to split in each internal tetra of a region */
+    _MMG5_ADD_MEM(mesh,(ne+1)*sizeof(char),"edges to split",
+                  _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+                  return(1));
+    _MMG5_SAFE_MALLOC(cedg,ne+1,char);
+
+#pragma omp parallel for num_threads(nthr) schedule(static) \
+    private(pt,len,lmax,imax,ie,r)
+    for (k=mesh->nefrz+1; k<=ne; k++) {
+        cedg[k] = -1;
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || pt->xt || done[k] )  continue;
+        r = preg[pt->v[0]];
+        if ( preg[pt->v[1]] != r || preg[pt->v[2]] != r || preg[pt->v[3]] != r )
+            continue;
+
+        imax = -1; lmax = 0.0;
+        for (ie=0; ie<6; ie++) {
+            len = _MMG5_lenedg(mesh,met,pt->v[_MMG5_iare[ie][0]],
+                               pt->v[_MMG5_iare[ie][1]]);
+            if ( len > lmax ) {
+                lmax = len;
+                imax = ie;
+            }
+        }
+        if ( lmax >= lopt )  cedg[k] = imax;
+    }
+
+    ncand = 0;
+    for (k=mesh->nefrz+1; k<=ne; k++)
+        if ( cedg[k] >= 0 )  ncand++;
+
+    /* each cavity uses 2 marks: leave the pass to the sequential sweep if the
+     * marks of the pass cannot be represented */
+    if ( !ncand || ncand >= INT_MAX/2-1 ) {
+        _MMG5_DEL_MEM(mesh,cedg,(ne+1)*sizeof(char));
+        _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+        return(1);
+    }
+
+    /* the marks of the pass would overflow: restart the marks from 0 (the
+     * cavities of the previous insertions are no more used) */
+    if ( mesh->mark > INT_MAX - 2*(int)(ncand+1) ) {
+#pragma omp parallel for num_threads(nthr) schedule(static)
+        for (k=1; k<=mesh->ne; k++)
+            mesh->tetra[k].mark = 0;
+        mesh->mark = 0;
+    }
+
+    /* work arrays: candidates sorted by region, cavities and balls of the
+     * candidates, cavities of each region (32 tetra per candidate) */
+    nwork = 7*ncand+2*nreg+1+32*(ncand+nreg);
+    _MMG5_ADD_MEM(mesh,nwork*sizeof(MMG5_int),"concurrent cavities",
+                  _MMG5_DEL_MEM(mesh,cedg,(ne+1)*sizeof(char));
+                  _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+                  return(1));
+    _MMG5_SAFE_CALLOC(work,nwork,MMG5_int);
+    cand = work;
+    coff = &cand[ncand];
+    clon = &coff[ncand];
+    csiz = &clon[ncand];
+    cxt  = &csiz[ncand];
+    cip  = &cxt[ncand];
+    celn = &cip[ncand];
+    cnt  = &celn[ncand];
+    used = &cnt[nreg+1];
+    buf  = &used[nreg];
+
+    for (k=mesh->nefrz+1; k<=ne; k++)
+        if ( cedg[k] >= 0 )  cnt[preg[mesh->tetra[k].v[0]]+1]++;
+    for (r=0; r<nreg; r++)
+        cnt[r+1] += cnt[r];
+    for (k=mesh->nefrz+1; k<=ne; k++)
+        if ( cedg[k] >= 0 )  cand[cnt[preg[mesh->tetra[k].v[0]]]++] = k;
+    for (r=nreg; r>0; r--)
+        cnt[r] = cnt[r-1];
+    cnt[0] = 0;
+
+    /* concurrent computation of the cavities: the cavities of the region r
+     * are stored from buf[32*(cnt[r]+r)] */
+    mark0  = mesh->mark;
+    nd     = nvol = npuiss = npres = npd = 0;
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,1) \
+    private(c,k,pt,ie,ilist,p0,p1,o,mp,m0,m1,i,base,lon,cas,list,nbal,nx,cap) \
+    reduction(+:nd,nvol,npuiss,npres,npd)
+    for (r=0; r<nreg; r++) {
+        cap = 32*(cnt[r+1]-cnt[r]+1);
+        for (c=cnt[r]; c<cnt[r+1]; c++) {
+            k  = cand[c];
+            pt = &mesh->tetra[k];
+            ie = cedg[k];
+
+            ilist = _MMG5_coquil(mesh,k,ie,list);
+            if ( ilist <= 0 || ilist%2 )  continue;
+            if ( _MMG5_dupedg(mesh,cedg,k,list,ilist/2) )  continue;
+
+            p0 = &mesh->point[pt->v[_MMG5_iare[ie][0]]];
+            p1 = &mesh->point[pt->v[_MMG5_iare[ie][1]]];
+            o[0] = 0.5*(p0->c[0] + p1->c[0]);
+            o[1] = 0.5*(p0->c[1] + p1->c[1]);
+            o[2] = 0.5*(p0->c[2] + p1->c[2]);
+
+            base = mark0 + 2*(int)(c+1);
+            if ( met->size == 6 ) {
+                /* mean metric of the edge at the point to insert */
+                m0 = &met->m[(pt->v[_MMG5_iare[ie][0]]-1)*met->size+1];
+                m1 = &met->m[(pt->v[_MMG5_iare[ie][1]]-1)*met->size+1];
+                for (i=0; i<6; i++)  mp[i] = 0.5*(m0[i]+m1[i]);
+                lon = _MMG5_cavity_ani(mesh,scr,o,mp,base,list,ilist/2,preg,r,
+                                       mark0,&cas);
+            }
+            else
+                lon = _MMG5_cavity_iso(mesh,scr,o,base,list,ilist/2,preg,r,mark0,&cas);
+
+            if(cas==1) nvol++;
+            else if(cas==2 || cas>20) {
+                npuiss++;
+                if(cas>20) npres++;
+            }
+
+            if ( lon < 1 ) {
+                nd++;
+                continue;
+            }
+            /* size of the ball */
+            nbal = _MMG5_delone_size(mesh,list,lon,base,&nx);
+            if ( !nbal ) {
+                npd++;
+                continue;
+            }
+            if ( used[r]+lon > cap || 3*nbal >= scr->hedg.max-scr->hedg.siz ) {
+                /* no more room or the hash table would be reallocated:
+                 * release the cavity */
+                for (ilist=0; ilist<lon; ilist++)
+                    mesh->tetra[list[ilist]].mark = base-1;
+                nd++;
+                continue;
+            }
+            coff[c] = 32*(cnt[r]+r) + used[r];
+            clon[c] = lon;
+            csiz[c] = nbal;
+            cxt[c]  = nx;
+            memcpy(&buf[coff[c]],list,lon*sizeof(MMG5_int));
+            used[r] += lon;
+        }
+    }
+    scr->nvol   += nvol;
+    scr->npuiss += npuiss;
+    scr->npres  += npres;
+    scr->npd    += npd;
+
+    neln = 0;
+    for (c=0; c<ncand; c++)
+        if ( clon[c] )  neln += csiz[c]+1;
+    hedg = NULL;
+    eln  = NULL;
+    if ( !neln )  goto end;
+
+    /* face hash table of each thread and elements of the balls */
+    _MMG5_ADD_MEM(mesh,nthr*sizeof(_MMG5_Hash)+neln*sizeof(MMG5_int),
+                  "concurrent balls",goto end);
+    _MMG5_SAFE_CALLOC(hedg,nthr,_MMG5_Hash);
+    _MMG5_SAFE_MALLOC(eln,neln,MMG5_int);
+    for (t=0; t<nthr; t++) {
+        if ( !_MMG5_hashNew(mesh,&hedg[t],scr->hedg.siz,scr->hedg.max-1) ) {
+            /* the cavities are left to the sequential sweep */
+            for (c=0; c<ncand; c++)  clon[c] = 0;
+            goto end;
+        }
+    }
+
+    /* sequential creation of the points and allocation of the balls */
+    nel = 0;
+    for (c=0; c<ncand; c++) {
+        if ( !clon[c] )  continue;
+
+        k   = cand[c];
+        pt  = &mesh->tetra[k];
+        ie  = cedg[k];
+        ip1 = pt->v[_MMG5_iare[ie][0]];
+        ip2 = pt->v[_MMG5_iare[ie][1]];
+        p0  = &mesh->point[ip1];
+        p1  = &mesh->point[ip2];
+        o[0] = 0.5*(p0->c[0] + p1->c[0]);
+        o[1] = 0.5*(p0->c[1] + p1->c[1]);
+        o[2] = 0.5*(p0->c[2] + p1->c[2]);
+
+        ielnum    = &eln[nel];
+        ielnum[0] = 0;
+        ip = _MMG5_newPt(mesh,o,MG_NOTAG);
+        if ( !ip ) {
+            /* reallocation of point table */
+            _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
+                                           *warn=1;
+                                           goto nomem,
+                                           o,MG_NOTAG);
+        }
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+
+        if ( !_MMG5_buckin(mesh,met,bucket,ip) ) {
+            _MMG5_delPt(mesh,ip);
+            (*ifilt)++;
+            clon[c] = 0;
+            continue;
+        }
+
+        for (k=1; k<=csiz[c]; k++) {
+            ielnum[k] = _MMG5_newElt(mesh);
+            if ( !ielnum[k] ) {
+                _MMG5_TETRA_REALLOC(mesh,ielnum[k],mesh->gap,
+                                    printf("  ## Warning: unable to allocate a new element but the mesh will be valid.\n");
+                                    _MMG5_delPt(mesh,ip);
+                                    ret = 0;
+                                    goto nomem);
+            }
+            ielnum[0] = k;
+        }
+        while ( mesh->xt+cxt[c] > mesh->xtmax ) {
+            _MMG5_TAB_RECALLOC(mesh,mesh->xtetra,mesh->xtmax,0.2,MMG5_xTetra,
+                               "larger xtetra table",
+                               printf("  Exit program.\n");
+                               exit(EXIT_FAILURE));
+        }
+        nx        = (int)cxt[c];
+        cxt[c]    = mesh->xt+1;
+        mesh->xt += nx;
+
+        _MMG5_addBucket(mesh,bucket,ip);
+        (*ns)++;
+        (*nins)++;
+        cip[c]  = ip;
+        celn[c] = nel;
+        nel    += csiz[c]+1;
+    }
+    goto retri;
+
+nomem:
+    /* release the elements of the last ball, the remaining cavities are left
+     * to the sequential sweep */
+    for (k=1; k<=ielnum[0]; k++) {
+        mesh->tetra[ielnum[k]].v[0] = 1;
+        _MMG5_delElt(mesh,ielnum[k]);
+    }
+    for ( ; c<ncand; c++)  clon[c] = 0;
+
+retri:
+    /* concurrent retriangulation of the cavities of each region */
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,1) private(c,t)
+    for (r=0; r<nreg; r++) {
+        t = omp_get_thread_num();
+        for (c=cnt[r]; c<cnt[r+1]; c++) {
+            if ( !clon[c] )  continue;
+            _MMG5_delone_fill(mesh,met,cip[c],&buf[coff[c]],(int)clon[c],
+                              mark0+2*(int)(c+1),&hedg[t],&eln[celn[c]],cxt[c]);
+        }
+    }
+
+    /* removal of the old elements, the new ones are no more candidates */
+    for (c=0; c<ncand; c++) {
+        if ( !clon[c] )  continue;
+        for (k=0; k<clon[c]; k++)
+            _MMG5_delElt(mesh,buf[coff[c]+k]);
+        for (k=1; k<=csiz[c]; k++)
+            if ( eln[celn[c]+k] <= ne )  done[eln[celn[c]+k]] = 1;
+    }
+
+end:
+    mesh->mark = mark0 + 2*(int)(ncand+1);
+    *ndef      = nd;
+
+    if ( hedg ) {
+        for (t=0; t<nthr; t++) {
+            if ( hedg[t].item )
+                _MMG5_DEL_MEM(mesh,hedg[t].item,(hedg[t].max+1)*sizeof(_MMG5_hedge));
+        }
+        _MMG5_DEL_MEM(mesh,hedg,nthr*sizeof(_MMG5_Hash));
+        _MMG5_DEL_MEM(mesh,eln,neln*sizeof(MMG5_int));
+    }
+    _MMG5_DEL_MEM(mesh,work,nwork*sizeof(MMG5_int));
+    _MMG5_DEL_MEM(mesh,cedg,(ne+1)*sizeof(char));
+    _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+
+    return(ret);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param lopt edges longer than \a lopt are splitted.
+ * \param ifilt pointer toward the number of points filtered by the bucket.
+ * \param ns pointer toward the number of inserted points.
+ * \param warn pointer toward a flag set if we fail to allocate a point.
+ * \return -1 if fail and we don't save the mesh, 0 if fail but we try to
+ * save the mesh, 1 otherwise.
+ *
+ * Concurrent insertion of the midpoints of the longest internal edges
+ * of the tetrahedra. Uses \a mesh->info.threads threads. The passes stop
+ * when a pass and the previous one insert less than one point per thread.
+ *
+ */
+int _MMG5_delone_mt(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                    _MMG5_pScratch scr,double lopt,MMG5_int *ifilt,MMG5_int *ns,int *warn) {
+    MMG5_int      ne,nins,nprev,ntot,ndef;
+    int           pass,ret;
+    char         *done;
+
+    ne = mesh->ne;
+    _MMG5_ADD_MEM(mesh,(ne+1)*sizeof(char),"new tetra",return(1));
+    _MMG5_SAFE_CALLOC(done,ne+1,char);
+
+    ntot  = ndef = 0;
+    nprev = mesh->info.threads;
+    ret   = 1;
+    for (pass=0; pass<_MMG5_MTPASS; pass++) {
+        ret = _MMG5_delone_pass(mesh,met,bucket,scr,lopt,pass%2,ne,done,ifilt,
+                                ns,&nins,&ndef,warn);
+        ntot += nins;
+        if ( ret < 1 )  break;
+        if ( nins < mesh->info.threads && nprev < mesh->info.threads )  break;
+        nprev = nins;
+    }
+    _MMG5_DEL_MEM(mesh,done,(ne+1)*sizeof(char));
+
+    if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+        fprintf(stdout,"     %8" MMG5_PRId " concurrent insertions (%d passes), %8"
+                MMG5_PRId " deferred\n",ntot,MG_MIN(pass+1,_MMG5_MTPASS),ndef);
+
+    return(ret);
+}
+
+#endif
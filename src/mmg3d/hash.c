@@ -39,26 +39,33 @@
 #define KB    11
 #define KC    13
 
-extern char  ddb;
-
 /**
  * \param mesh pointer toward the mesh structure.
  *
- * tetra packing.
+ * tetra packing. The adjacency table is updated if allocated.
  *
  */
-static void
-_MMG5_paktet(MMG5_pMesh mesh) {
+void _MMG5_paktet(MMG5_pMesh mesh) {
     MMG5_pTetra   pt,pt1;
-    int      k;
+    MMG5_int k,*adja,*adja1;
+    int      i;
 
-    k = 1;
+    k = mesh->nefrz + 1;
     do {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) ) {
             pt1 = &mesh->tetra[mesh->ne];
             assert(MG_EOK(pt1));
             memcpy(pt,pt1,sizeof(MMG5_Tetra));
+            if ( mesh->adja ) {
+                adja  = &mesh->adja[4*(k-1)+1];
+                adja1 = &mesh->adja[4*(mesh->ne-1)+1];
+                for (i=0; i<4; i++) {
+                    adja[i] = adja1[i];
+                    if ( adja[i] )
+                        mesh->adja[4*(adja[i]/4-1)+1+adja[i]%4] = 4*k+i;
+                }
+            }
             _MMG5_delElt(mesh,mesh->ne);
         }
     }
@@ -72,52 +79,183 @@ _MMG5_paktet(MMG5_pMesh mesh) {
     }
 }
 
+/** Face of a tetra in the sorted face table: sorted vertices and address. */
+typedef struct {
+    MMG5_int mid,max,iadr;
+} _MMG5_sface;
+
+/**
+ * \param a pointer toward the first face.
+ * \param b pointer toward the second face.
+ * \return -1, 0 or 1.
+ *
+ * Lexicographic comparison of two faces sharing the same smallest vertex.
+ *
+ */
+static int _MMG5_cmpsface(const void *a,const void *b) {
+    const _MMG5_sface *fa = (const _MMG5_sface*)a;
+    const _MMG5_sface *fb = (const _MMG5_sface*)b;
+
+    if ( fa->mid != fb->mid )  return(fa->mid < fb->mid ? -1 : 1);
+    if ( fa->max != fb->max )  return(fa->max < fb->max ? -1 : 1);
+    if ( fa->iadr != fb->iadr )  return(fa->iadr < fb->iadr ? -1 : 1);
+    return(0);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
- * \param pack we pack the mesh at function begining if \f$pack=1\f$.
- * \return 0 if failed, 1 otherwise.
+ * \param first pointer toward the first face of each bucket.
+ * \param pos pointer toward a work array of size \a np+2.
+ * \param face pointer toward a work array of size \a 4*ne.
  *
- * Create table of adjacency. Set pack variable to 0 for a compact
- * mesh and to 1 for a mesh that need to be packed.
+ * Sort-based construction of the adjacency table. Faces are distributed in
+ * buckets by their smallest vertex (counting sort), each bucket is then
+ * sorted by middle and largest vertex and consecutive identical faces are
+ * paired. Buckets are independent and processed concurrently with the
+ * \a USE_OPENMP flag. The adjacency table must be allocated and zeroed.
+ *
+ * When more than 2 tetra share a face, faces are paired by decreasing
+ * address, as in the hash chains of \ref _MMG5_hashTetra_chain.
  *
  */
-int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
-    MMG5_pTetra    pt,pt1;
-    int            k,kk,pp,l,ll,mins,mins1,maxs,maxs1,sum,sum1,iadr;
-    int           *hcode,*link,hsize,inival;
-    unsigned char  i,ii,i1,i2,i3;
-    unsigned int   key;
+static void
+_MMG5_hashTetra_sort(MMG5_pMesh mesh,MMG5_int *first,MMG5_int *pos,MMG5_int *face) {
+    MMG5_pTetra    pt;
+    _MMG5_sface    loc[64],tmp,*sf;
+    MMG5_int       k,l,m,n,v,a,b,c,mins;
+    unsigned char  i,i1,i2,i3;
+#ifdef USE_OPENMP
+    int            nthr;
+
+    nthr = MG_MAX(1,mesh->info.threads);
+#endif
+
+    /* stage 1: number of faces per smallest vertex */
+    if ( mesh->info.ddebug )  fprintf(stdout,"  h- stage 1: init\n");
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) \
+    private(pt,i,a,b,c,mins)
+#endif
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        for (i=0; i<4; i++) {
+            a = pt->v[_MMG5_idir[i][0]];
+            b = pt->v[_MMG5_idir[i][1]];
+            c = pt->v[_MMG5_idir[i][2]];
+            mins = MG_MIN(a,MG_MIN(b,c));
+#ifdef USE_OPENMP
+#pragma omp atomic
+#endif
+            first[mins+1]++;
+        }
+    }
+    for (v=0; v<=mesh->np; v++) {
+        first[v+1] += first[v];
+        pos[v]      = first[v];
+    }
 
-    /* default */
-    if ( mesh->adja ) {
-        if( !mesh->info.sing ) {
-            if ( abs(mesh->info.imprim) > 3 || mesh->info.ddebug ) {
-                fprintf(stdout,"  ## Warning: no re-build of adjacencies of mesh. ");
-                fprintf(stdout,"mesh->adja must be freed to enforce analysis.\n");
-            }
+    /* scatter the faces in their bucket */
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) \
+    private(pt,i,a,b,c,mins,l)
+#endif
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        for (i=0; i<4; i++) {
+            a = pt->v[_MMG5_idir[i][0]];
+            b = pt->v[_MMG5_idir[i][1]];
+            c = pt->v[_MMG5_idir[i][2]];
+            mins = MG_MIN(a,MG_MIN(b,c));
+#ifdef USE_OPENMP
+#pragma omp atomic capture
+#endif
+            l = pos[mins]++;
+            face[l] = 4*k+i;
         }
-        return(1);
     }
 
-    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
-        fprintf(stdout,"  ** SETTING STRUCTURE\n");
+    /* stage 2: sort each bucket and pair identical faces */
+    if ( mesh->info.ddebug )  fprintf(stdout,"  h- stage 2: adjacencies\n");
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,256) \
+    private(pt,sf,loc,tmp,n,l,m,k,i,i1,i2,i3,a,b,c,mins)
+#endif
+    for (v=1; v<=mesh->np; v++) {
+        n = first[v+1]-first[v];
+        if ( n < 2 )  continue;
+
+        sf = loc;
+        if ( n > 64 )  _MMG5_SAFE_MALLOC(sf,n,_MMG5_sface);
+
+        for (l=0; l<n; l++) {
+            k  = face[first[v]+l] / 4;
+            i  = face[first[v]+l] % 4;
+            i1 = _MMG5_idir[i][0];
+            i2 = _MMG5_idir[i][1];
+            i3 = _MMG5_idir[i][2];
+            pt = &mesh->tetra[k];
+            a  = pt->v[i1];
+            b  = pt->v[i2];
+            c  = pt->v[i3];
+            mins = MG_MIN(a,MG_MIN(b,c));
+            sf[l].max  = MG_MAX(a,MG_MAX(b,c));
+            sf[l].mid  = a+b+c-mins-sf[l].max;
+            sf[l].iadr = 4*(k-1)+1+i;
+        }
 
-    /* packing : if not hash does not work */
-    if ( pack )  _MMG5_paktet(mesh);
+        /* insertion sort for the usual small buckets */
+        if ( n > 64 )
+            qsort(sf,n,sizeof(_MMG5_sface),_MMG5_cmpsface);
+        else {
+            for (l=1; l<n; l++) {
+                for (m=l; m>0 && _MMG5_cmpsface(&sf[m-1],&sf[m])>0; m--) {
+                    tmp = sf[m]; sf[m] = sf[m-1]; sf[m-1] = tmp;
+                }
+            }
+        }
 
-    /* memory alloc */
-    _MMG5_ADD_MEM(mesh,(4*mesh->nemax+5)*sizeof(int),"adjacency table",
-                  printf("  Exit program.\n");
-                  exit(EXIT_FAILURE));
-    _MMG5_SAFE_CALLOC(mesh->adja,4*mesh->nemax+5,int);
-    _MMG5_SAFE_CALLOC(hcode,mesh->ne+5,int);
+        /* pair runs of identical faces from the largest address */
+        l = n-1;
+        while ( l > 0 ) {
+            if ( sf[l-1].mid == sf[l].mid && sf[l-1].max == sf[l].max ) {
+                a = sf[l].iadr;
+                b = sf[l-1].iadr;
+                mesh->adja[a] = 4*((b-1)/4+1) + (b-1)%4;
+                mesh->adja[b] = 4*((a-1)/4+1) + (a-1)%4;
+                l -= 2;
+            }
+            else
+                l--;
+        }
+
+        if ( sf != loc )  _MMG5_SAFE_FREE(sf);
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param hcode pointer toward a work array of size \a ne+5.
+ *
+ * Hash-chain construction of the adjacency table, used when the memory
+ * for the sorted face table is not available. The mesh must be packed.
+ *
+ */
+static void
+_MMG5_hashTetra_chain(MMG5_pMesh mesh,MMG5_int *hcode) {
+    MMG5_pTetra    pt,pt1;
+    MMG5_int       k,kk,pp,l,ll,mins,mins1,maxs,maxs1,sum,sum1,iadr;
+    MMG5_int      *link,hsize,inival;
+    unsigned char  i,ii,i1,i2,i3;
+    _MMG5_uint     key;
 
     link  = mesh->adja;
     hsize = mesh->ne;
 
     /* init */
     if ( mesh->info.ddebug )  fprintf(stdout,"  h- stage 1: init\n");
-    inival = 2147483647;
+    inival = MMG5_INTMAX;
     iadr   = 0;
     for (k=0; k<=mesh->ne; k++)
         hcode[k] = -inival;
@@ -187,7 +325,57 @@ int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
             ll = -link[ll];
         }
     }
-    _MMG5_SAFE_FREE(hcode);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pack we pack the mesh at function begining if \f$pack=1\f$.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Create table of adjacency. Set pack variable to 0 for a compact
+ * mesh and to 1 for a mesh that need to be packed.
+ *
+ */
+int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
+    MMG5_int      *hcode,*work;
+    long long      siz;
+
+    /* default */
+    if ( mesh->adja ) {
+        if( !mesh->info.sing ) {
+            if ( abs(mesh->info.imprim) > 3 || mesh->info.ddebug ) {
+                fprintf(stdout,"  ## Warning: no re-build of adjacencies of mesh. ");
+                fprintf(stdout,"mesh->adja must be freed to enforce analysis.\n");
+            }
+        }
+        return(1);
+    }
+
+    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+        fprintf(stdout,"  ** SETTING STRUCTURE\n");
+
+    /* packing : if not hash does not work */
+    if ( pack )  _MMG5_paktet(mesh);
+
+    /* memory alloc */
+    _MMG5_ADD_MEM(mesh,(4*mesh->nemax+5)*sizeof(MMG5_int),"adjacency table",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(mesh->adja,4*mesh->nemax+5,MMG5_int);
+
+    /* sorted face table if the memory allows it */
+    siz = 2*(long long)(mesh->np+2) + 4*(long long)mesh->ne;
+    if ( mesh->memCur + siz*sizeof(MMG5_int) <= mesh->memMax && 4*(long long)mesh->ne+4 < MMG5_INTMAX ) {
+        _MMG5_ADD_MEM(mesh,siz*sizeof(MMG5_int),"face table",);
+        _MMG5_SAFE_CALLOC(work,siz,MMG5_int);
+        _MMG5_hashTetra_sort(mesh,work,&work[mesh->np+2],&work[2*(mesh->np+2)]);
+        _MMG5_DEL_MEM(mesh,work,siz*sizeof(MMG5_int));
+    }
+    else {
+        _MMG5_SAFE_CALLOC(hcode,mesh->ne+5,MMG5_int);
+        _MMG5_hashTetra_chain(mesh,hcode);
+        _MMG5_SAFE_FREE(hcode);
+    }
     return(1);
 }
 
@@ -196,12 +384,13 @@ int _MMG5_hashTria(MMG5_pMesh mesh) {
     MMG5_pTria     pt,pt1;
     _MMG5_Hash     hash;
     _MMG5_hedge    *ph;
-    int      *adja,k,jel,lel,hmax,dup,nmf,ia,ib;
+    MMG5_int *adja,k,jel,lel,hmax,ia,ib;
+    int       dup,nmf;
     char      i,i1,i2,j,l,ok;
-    unsigned int key;
+    _MMG5_uint key;
 
-    _MMG5_ADD_MEM(mesh,(3*mesh->nt+4)*sizeof(int),"surfacic adjacency table",return(0));
-    _MMG5_SAFE_CALLOC(mesh->adjt,3*mesh->nt+4,int);
+    _MMG5_ADD_MEM(mesh,(3*mesh->nt+4)*sizeof(MMG5_int),"surfacic adjacency table",return(0));
+    _MMG5_SAFE_CALLOC(mesh->adjt,3*mesh->nt+4,MMG5_int);
 
     /* adjust hash table params */
     hmax = 3.71*mesh->np;
@@ -326,9 +515,9 @@ int _MMG5_hashTria(MMG5_pMesh mesh) {
     return(1);
 }
 
-int _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash, int a,int b,int k) {
+int _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash, MMG5_int a,MMG5_int b,MMG5_int k) {
     _MMG5_hedge  *ph;
-    int          key,ia,ib,j;
+    MMG5_int     key,ia,ib,j;
 
     ia  = MG_MIN(a,b);
     ib  = MG_MAX(a,b);
@@ -350,7 +539,7 @@ int _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash, int a,int b,int k) {
         ph->nxt   = 0;
         if ( hash->nxt >= hash->max ) {
             if ( mesh->info.ddebug )
-                fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",hash->max);
+                fprintf(stdout,"  ## Memory alloc problem (edge): %" MMG5_PRId "\n",hash->max);
             _MMG5_TAB_RECALLOC(mesh,hash->item,hash->max,0.2,_MMG5_hedge,"edge",return(0));
             for (j=hash->nxt; j<hash->max; j++)  hash->item[j].nxt = j+1;
         }
@@ -364,9 +553,9 @@ int _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash, int a,int b,int k) {
 }
 
 /** return index of point stored along (ia,ib) */
-int _MMG5_hashGet(_MMG5_Hash *hash,int a,int b) {
+MMG5_int _MMG5_hashGet(_MMG5_Hash *hash,MMG5_int a,MMG5_int b) {
     _MMG5_hedge  *ph;
-    int          key,ia,ib;
+    MMG5_int     key,ia,ib;
 
     ia  = MG_MIN(a,b);
     ib  = MG_MAX(a,b);
@@ -383,9 +572,9 @@ int _MMG5_hashGet(_MMG5_Hash *hash,int a,int b) {
 }
 
 /** remove edge from hash table */
-int _MMG5_hashPop(_MMG5_Hash *hash,int a,int b) {
+int _MMG5_hashPop(_MMG5_Hash *hash,MMG5_int a,MMG5_int b) {
     _MMG5_hedge  *ph,*php;
-    int          key,ia,ib,iph,iphp;
+    MMG5_int     key,ia,ib,iph,iphp;
 
     ia  = MG_MIN(a,b);
     ib  = MG_MAX(a,b);
@@ -434,8 +623,8 @@ int _MMG5_hashPop(_MMG5_Hash *hash,int a,int b) {
 }
 
 /** used to hash edges or faces */
-int _MMG5_hashNew(MMG5_pMesh mesh,_MMG5_Hash *hash,int hsiz,int hmax) {
-    int   k;
+int _MMG5_hashNew(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int hsiz,MMG5_int hmax) {
+    MMG5_int k;
 
     /* adjust hash table params */
     _MMG5_ADD_MEM(mesh,(hmax+2)*sizeof(_MMG5_hedge),"hash table",
@@ -451,10 +640,269 @@ int _MMG5_hashNew(MMG5_pMesh mesh,_MMG5_Hash *hash,int hsiz,int hmax) {
     return(1);
 }
 
+/**
+ * \param a first extremity of the edge.
+ * \param b second extremity of the edge.
+ * \return the key of the edge.
+ */
+#ifdef MMG5_INT64
+static inline _MMG5_ekey _MMG5_edgeKey(MMG5_int a,MMG5_int b) {
+    _MMG5_ekey key;
+
+    key.a = MG_MIN(a,b);
+    key.b = MG_MAX(a,b);
+    return(key);
+}
+#define _MMG5_EKEY_A(key)     ((key).a)
+#define _MMG5_EKEY_B(key)     ((key).b)
+#define _MMG5_EKEY_EQ(k1,k2)  ((k1).a == (k2).a && (k1).b == (k2).b)
+#else
+static inline _MMG5_ekey _MMG5_edgeKey(int a,int b) {
+    if ( a < b )
+        return( ((unsigned long long)a << 32) | (unsigned int)b );
+    return( ((unsigned long long)b << 32) | (unsigned int)a );
+}
+#define _MMG5_EKEY_A(key)     ((int)((key) >> 32))
+#define _MMG5_EKEY_B(key)     ((int)((key) & 0xFFFFFFFFULL))
+#define _MMG5_EKEY_EQ(k1,k2)  ((k1) == (k2))
+#endif
+
+/**
+ * \param map pointer toward the edge map.
+ * \param key key of the edge.
+ * \return the home slot of the edge. As for \ref _MMG5_Hash, the slot is a
+ * linear function of the vertices so edges of close vertices are stored in
+ * close slots.
+ */
+static inline MMG5_int _MMG5_edgeHome(_MMG5_EdgeMap *map,_MMG5_ekey key) {
+    return( (MMG5_int)((KA*(unsigned long long)_MMG5_EKEY_A(key)
+                        + KB*(unsigned long long)_MMG5_EKEY_B(key)) % map->siz) );
+}
+
+/**
+ * \param map pointer toward the edge map.
+ * \param key key of the edge.
+ * \return the slot of the edge or of the empty slot where it must be stored.
+ */
+static inline MMG5_int _MMG5_edgeSlot(_MMG5_EdgeMap *map,_MMG5_ekey key) {
+    MMG5_int  h;
+
+    h = _MMG5_edgeHome(map,key);
+    while ( _MMG5_EKEY_A(map->key[h]) && !_MMG5_EKEY_EQ(map->key[h],key) )
+        if ( ++h == map->siz )  h = 0;
+    return(h);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param map pointer toward the edge map.
+ * \param siz new size of the table.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Allocate the table of the edge map with \a siz slots and move the stored
+ * edges into it.
+ *
+ */
+static int _MMG5_edgeMapResize(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int siz) {
+    _MMG5_ekey *okey;
+    MMG5_int   *oval,osiz,k,h;
+
+    _MMG5_ADD_MEM(mesh,siz*(sizeof(_MMG5_ekey)+sizeof(MMG5_int)),"edge map",
+                  return(0));
+    okey = map->key;
+    oval = map->val;
+    osiz = map->siz;
+
+    map->siz = siz;
+    _MMG5_SAFE_CALLOC(map->key,siz,_MMG5_ekey);
+    _MMG5_SAFE_MALLOC(map->val,siz,MMG5_int);
+
+    if ( okey ) {
+        for (k=0; k<osiz; k++) {
+            if ( !_MMG5_EKEY_A(okey[k]) )  continue;
+            h = _MMG5_edgeSlot(map,okey[k]);
+            map->key[h] = okey[k];
+            map->val[h] = oval[k];
+        }
+        _MMG5_DEL_MEM(mesh,okey,osiz*sizeof(_MMG5_ekey));
+        _MMG5_DEL_MEM(mesh,oval,osiz*sizeof(MMG5_int));
+    }
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param map pointer toward the edge map.
+ * \param nedge expected number of edges.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Create an edge map. The table grows if we store more than \a nedge edges.
+ *
+ */
+int _MMG5_edgeMapNew(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int nedge) {
+    MMG5_int  siz;
+
+    memset(map,0,sizeof(_MMG5_EdgeMap));
+    siz = MG_MAX(16,3*(nedge/2)+1);
+    return(_MMG5_edgeMapResize(mesh,map,siz));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param map pointer toward the edge map.
+ *
+ * Free the edge map.
+ *
+ */
+void _MMG5_edgeMapFree(MMG5_pMesh mesh,_MMG5_EdgeMap *map) {
+    if ( !map->key )  return;
+    _MMG5_DEL_MEM(mesh,map->key,map->siz*sizeof(_MMG5_ekey));
+    _MMG5_DEL_MEM(mesh,map->val,map->siz*sizeof(MMG5_int));
+    map->siz = map->nitem = 0;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param map pointer toward the edge map.
+ * \param a first extremity of the edge.
+ * \param b second extremity of the edge.
+ * \param val value to store along the edge.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Store the edge \a ab with the value \a val. If the edge is already stored,
+ * its value is unchanged (same behaviour as \ref _MMG5_hashEdge).
+ *
+ */
+int _MMG5_edgeMapAdd(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int a,MMG5_int b,
+                     MMG5_int val) {
+    _MMG5_ekey  key;
+    MMG5_int    h;
+
+    key = _MMG5_edgeKey(a,b);
+    h   = _MMG5_edgeSlot(map,key);
+    if ( _MMG5_EKEY_A(map->key[h]) )  return(1);
+
+    /* keep the table at most 3/4 full */
+    if ( 4*(map->nitem+1) > 3*map->siz ) {
+        if ( !_MMG5_edgeMapResize(mesh,map,2*map->siz) ) {
+            if ( mesh->info.ddebug )
+                fprintf(stdout,"  ## Memory alloc problem (edge): %" MMG5_PRId "\n",
+                        map->siz);
+            return(0);
+        }
+        h = _MMG5_edgeSlot(map,key);
+    }
+    map->key[h] = key;
+    map->val[h] = val;
+    map->nitem++;
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param map pointer toward the edge map.
+ * \param n number of edges to store.
+ * \param edg extremities of the edges (\a edg[2i], \a edg[2i+1]).
+ * \param val values to store along the edges (NULL to store 0).
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Store \a n edges, the table being resized only once.
+ *
+ */
+int _MMG5_edgeMapBulk(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int n,MMG5_int *edg,
+                      MMG5_int *val) {
+    MMG5_int  k,siz;
+
+    siz = map->siz;
+    while ( 3*siz < 4*(map->nitem+n) )  siz *= 2;
+    if ( siz > map->siz && !_MMG5_edgeMapResize(mesh,map,siz) )  return(0);
+
+    for (k=0; k<n; k++) {
+        if ( !_MMG5_edgeMapAdd(mesh,map,edg[2*k],edg[2*k+1],val ? val[k] : 0) )
+            return(0);
+    }
+    return(1);
+}
+
+/**
+ * \param map pointer toward the edge map.
+ * \param a first extremity of the edge.
+ * \param b second extremity of the edge.
+ * \return the value stored along the edge \a ab, 0 if not found.
+ */
+MMG5_int _MMG5_edgeMapGet(_MMG5_EdgeMap *map,MMG5_int a,MMG5_int b) {
+    MMG5_int  h;
+
+    h = _MMG5_edgeSlot(map,_MMG5_edgeKey(a,b));
+    return( _MMG5_EKEY_A(map->key[h]) ? map->val[h] : 0 );
+}
+
+/**
+ * \param map pointer toward the edge map.
+ * \param a first extremity of the edge.
+ * \param b second extremity of the edge.
+ * \return 1 if the edge has been removed, 0 if not found.
+ *
+ * Remove the edge \a ab. The following entries of the probing sequence are
+ * shifted backward so the table doesn't need tombstones.
+ *
+ */
+int _MMG5_edgeMapPop(_MMG5_EdgeMap *map,MMG5_int a,MMG5_int b) {
+    MMG5_int  h,j,i,siz;
+
+    h = _MMG5_edgeSlot(map,_MMG5_edgeKey(a,b));
+    if ( !_MMG5_EKEY_A(map->key[h]) )  return(0);
+
+    siz = map->siz;
+    j   = h;
+    while ( 1 ) {
+        if ( ++j == siz )  j = 0;
+        if ( !_MMG5_EKEY_A(map->key[j]) )  break;
+        /* home slot of the entry j */
+        i = _MMG5_edgeHome(map,map->key[j]);
+        /* the entry j may fill the hole h if h is between i and j */
+        if ( ((long long)j-i+siz) % siz >= ((long long)j-h+siz) % siz ) {
+            map->key[h] = map->key[j];
+            map->val[h] = map->val[j];
+            h = j;
+        }
+    }
+    memset(&map->key[h],0,sizeof(_MMG5_ekey));
+    map->nitem--;
+    return(1);
+}
+
+/**
+ * \param map pointer toward the edge map.
+ * \param pos pointer toward the iterator (set to 0 before the first call).
+ * \param a pointer toward the first extremity of the edge.
+ * \param b pointer toward the second extremity of the edge.
+ * \param val pointer toward the value stored along the edge.
+ * \return 1 if an edge has been found, 0 at the end of the table.
+ *
+ * Iterate over the stored edges (\a a < \a b).
+ *
+ */
+int _MMG5_edgeMapNext(_MMG5_EdgeMap *map,MMG5_int *pos,MMG5_int *a,MMG5_int *b,
+                      MMG5_int *val) {
+
+    while ( *pos < map->siz ) {
+        if ( _MMG5_EKEY_A(map->key[*pos]) ) {
+            *a   = _MMG5_EKEY_A(map->key[*pos]);
+            *b   = _MMG5_EKEY_B(map->key[*pos]);
+            *val = map->val[*pos];
+            (*pos)++;
+            return(1);
+        }
+        (*pos)++;
+    }
+    return(0);
+}
+
 /** set tag to edge on geometry */
-int _MMG5_hTag(MMG5_HGeom *hash,int a,int b,int ref,char tag) {
+int _MMG5_hTag(MMG5_HGeom *hash,MMG5_int a,MMG5_int b,int ref,char tag) {
     MMG5_hgeom  *ph;
-    int     key,ia,ib;
+    MMG5_int key,ia,ib;
 
     ia  = MG_MIN(a,b);
     ib  = MG_MAX(a,b);
@@ -480,9 +928,9 @@ int _MMG5_hTag(MMG5_HGeom *hash,int a,int b,int ref,char tag) {
 }
 
 /** remove edge from hash table */
-int _MMG5_hPop(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
+int _MMG5_hPop(MMG5_HGeom *hash,MMG5_int a,MMG5_int b,int *ref,char *tag) {
     MMG5_hgeom  *ph,*php;
-    int     key,ia,ib,iph,iphp;
+    MMG5_int key,ia,ib,iph,iphp;
 
     *ref = 0;
     *tag = 0;
@@ -538,9 +986,9 @@ int _MMG5_hPop(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
 }
 
 /** get ref and tag to edge on geometry */
-int _MMG5_hGet(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
+int _MMG5_hGet(MMG5_HGeom *hash,MMG5_int a,MMG5_int b,int *ref,char *tag) {
     MMG5_hgeom  *ph;
-    int     key,ia,ib;
+    MMG5_int key,ia,ib;
 
     *tag = 0;
     *ref = 0;
@@ -568,9 +1016,9 @@ int _MMG5_hGet(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
 }
 
 /** store edge on geometry */
-void _MMG5_hEdge(MMG5_pMesh mesh,int a,int b,int ref,char tag) {
+void _MMG5_hEdge(MMG5_pMesh mesh,MMG5_int a,MMG5_int b,int ref,char tag) {
     MMG5_hgeom  *ph;
-    int     key,ia,ib,j;
+    MMG5_int key,ia,ib,j;
 
     if ( !mesh->htab.siz )  return;
     ia  = MG_MIN(a,b);
@@ -593,7 +1041,7 @@ void _MMG5_hEdge(MMG5_pMesh mesh,int a,int b,int ref,char tag) {
         ph->nxt = 0;
         if ( mesh->htab.nxt >= mesh->htab.max ) {
             if ( mesh->info.ddebug )
-                fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",mesh->htab.max);
+                fprintf(stdout,"  ## Memory alloc problem (edge): %" MMG5_PRId "\n",mesh->htab.max);
             _MMG5_TAB_RECALLOC(mesh,mesh->htab.geom,mesh->htab.max,0.2,MMG5_hgeom,
                                "larger htab table",
                                printf("  Exit program.\n");
@@ -610,8 +1058,8 @@ void _MMG5_hEdge(MMG5_pMesh mesh,int a,int b,int ref,char tag) {
 }
 
 /** to store edge on geometry */
-int _MMG5_hNew(MMG5_HGeom *hash,int hsiz,int hmax,int secure) {
-    int   k;
+int _MMG5_hNew(MMG5_HGeom *hash,MMG5_int hsiz,MMG5_int hmax,int secure) {
+    MMG5_int k;
 
     /* adjust hash table params */
     hash->geom = (MMG5_hgeom*)calloc(hmax+2,sizeof(MMG5_hgeom));
@@ -638,7 +1086,8 @@ int _MMG5_hNew(MMG5_HGeom *hash,int hsiz,int hmax,int secure) {
 int _MMG5_hGeom(MMG5_pMesh mesh) {
     MMG5_pTria   pt;
     MMG5_pEdge   pa;
-    int         *adja,k,kk,edg;
+    MMG5_int    *adja,k,kk;
+    int          edg;
     char         i,i1,i2,tag;
 
     /* if edges exist in mesh, hash special edges from existing field */
@@ -756,7 +1205,8 @@ int _MMG5_hGeom(MMG5_pMesh mesh) {
  */
 int _MMG5_chkNumberOfTri(MMG5_pMesh mesh) {
     MMG5_pTetra    pt,pt1;
-    int      *adja,adj,k,i,nttmp;
+    MMG5_int *adja,adj,k,nttmp;
+    int       i;
 
     nttmp = 0;
     for (k=1; k<=mesh->ne; k++) {
@@ -776,7 +1226,7 @@ int _MMG5_chkNumberOfTri(MMG5_pMesh mesh) {
             fprintf(stdout,"  ## WARNING: INITIAL TRIANGLES ARE _MMG5_DELETED.\n");
             fprintf(stdout,"  Not enough or too much triangles for geometry (maybe");
             fprintf(stdout," you have 2 domains but only boundary/interface triangles).\n");
-            fprintf(stdout," %d given triangles and %d counted triangles.\n",mesh->nt,nttmp);
+            fprintf(stdout," %" MMG5_PRId " given triangles and %" MMG5_PRId " counted triangles.\n",mesh->nt,nttmp);
         }
         _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
     }
@@ -796,7 +1246,7 @@ int _MMG5_bdryTria(MMG5_pMesh mesh) {
     MMG5_pTria     ptt;
     MMG5_pPoint    ppt;
     MMG5_pxTetra   pxt;
-    int      *adja,adj,k;
+    MMG5_int *adja,adj,k;
     char      i;
 
     /* create triangles */
@@ -852,9 +1302,10 @@ int _MMG5_bdryTria(MMG5_pMesh mesh) {
     return(1);
 }
 
-static int _MMG5_hashFace(MMG5_pMesh mesh,_MMG5_Hash *hash,int ia,int ib,int ic,int k) {
+static MMG5_int _MMG5_hashFace(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int ia,
+                                MMG5_int ib,MMG5_int ic,MMG5_int k) {
     _MMG5_hedge     *ph;
-    int        key,mins,maxs,sum,j;
+    MMG5_int   key,mins,maxs,sum,j;
 
     mins = MG_MIN(ia,MG_MIN(ib,ic));
     maxs = MG_MAX(ia,MG_MAX(ib,ic));
@@ -899,10 +1350,105 @@ static int _MMG5_hashFace(MMG5_pMesh mesh,_MMG5_Hash *hash,int ia,int ib,int ic,
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param hash pointer toward the hash table of pending faces.
+ * \param ia first vertex of the face.
+ * \param ib second vertex of the face.
+ * \param ic third vertex of the face.
+ * \param code encoded face (\f$4*k+i\f$) to store.
+ * \return the code stored with the face if found (and consume it), 0 if the
+ * face is inserted, -1 if fail.
+ *
+ * Match a face with a face previously stored or store it.
+ *
+ */
+MMG5_int _MMG5_hashPendFace(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int ia,MMG5_int ib,
+                       MMG5_int ic,MMG5_int code) {
+    _MMG5_hedge  *ph;
+    MMG5_int      key,mins,maxs,sum,j;
+
+    mins = MG_MIN(ia,MG_MIN(ib,ic));
+    maxs = MG_MAX(ia,MG_MAX(ib,ic));
+    sum  = ia + ib + ic;
+    key  = (KA*mins + KB*maxs) % hash->siz;
+    ph   = &hash->item[key];
+
+    if ( ph->a ) {
+        if ( ph->k && ph->a == mins && ph->b == maxs && ph->s == sum ) {
+            j = ph->k;
+            ph->k = 0;
+            return(j);
+        }
+        while ( ph->nxt && ph->nxt < hash->max ) {
+            ph = &hash->item[ph->nxt];
+            if ( ph->k && ph->a == mins && ph->b == maxs && ph->s == sum ) {
+                j = ph->k;
+                ph->k = 0;
+                return(j);
+            }
+        }
+        ph->nxt   = hash->nxt;
+        ph        = &hash->item[hash->nxt];
+        ph->a     = mins;
+        ph->b     = maxs;
+        ph->s     = sum;
+        ph->k     = code;
+        hash->nxt = ph->nxt;
+        ph->nxt   = 0;
+
+        if ( hash->nxt >= hash->max ) {
+            _MMG5_TAB_RECALLOC(mesh,hash->item,hash->max,0.2,_MMG5_hedge,"face",return(-1));
+            for (j=hash->nxt; j<hash->max; j++)  hash->item[j].nxt = j+1;
+        }
+        return(0);
+    }
+
+    ph->a   = mins;
+    ph->b   = maxs;
+    ph->s   = sum;
+    ph->k   = code;
+    ph->nxt = 0;
+    return(0);
+}
+
+/**
+ * \param hash pointer toward the hash table of pending faces.
+ * \param ia first vertex of the face.
+ * \param ib second vertex of the face.
+ * \param ic third vertex of the face.
+ * \param code encoded face (\f$4*k+i\f$) stored with the face.
+ * \return 1 if the face is found, 0 otherwise.
+ *
+ * Remove a pending face that no longer exists.
+ *
+ */
+int _MMG5_hashPendDel(_MMG5_Hash *hash,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int code) {
+    _MMG5_hedge  *ph;
+    MMG5_int      key,mins,maxs,sum;
+
+    mins = MG_MIN(ia,MG_MIN(ib,ic));
+    maxs = MG_MAX(ia,MG_MAX(ib,ic));
+    sum  = ia + ib + ic;
+    key  = (KA*mins + KB*maxs) % hash->siz;
+    ph   = &hash->item[key];
+
+    if ( !ph->a )  return(0);
+    while ( 1 ) {
+        if ( ph->k == code && ph->a == mins && ph->b == maxs && ph->s == sum ) {
+            ph->k = 0;
+            return(1);
+        }
+        if ( !ph->nxt || ph->nxt >= hash->max )  break;
+        ph = &hash->item[ph->nxt];
+    }
+    return(0);
+}
+
 /** return index of triangle ia ib ic */
-static int _MMG5_hashGetFace(_MMG5_Hash *hash,int ia,int ib,int ic) {
+static MMG5_int _MMG5_hashGetFace(_MMG5_Hash *hash,MMG5_int ia,MMG5_int ib,MMG5_int ic) {
     _MMG5_hedge  *ph;
-    int     key,mins,maxs,sum;
+    MMG5_int key,mins,maxs,sum;
 
     if ( !hash->item )  return(0);
     mins = MG_MIN(ia,MG_MIN(ib,ic));
@@ -939,7 +1485,7 @@ int _MMG5_bdrySet(MMG5_pMesh mesh) {
     MMG5_pTria    ptt;
     MMG5_pxTetra  pxt;
     _MMG5_Hash     hash;
-    int      *adja,adj,k,kt,ia,ib,ic,j,na;
+    MMG5_int *adja,adj,k,kt,ia,ib,ic,j,na;
     char     i,tag;
 
     if ( !mesh->nt )  return(1);
@@ -1045,7 +1591,7 @@ int _MMG5_bdryUpdate(MMG5_pMesh mesh) {
     MMG5_pTria    ptt;
     MMG5_pxTetra  pxt;
     _MMG5_Hash     hash;
-    int      k,kt,ia,ib,ic,j;
+    MMG5_int k,kt,ia,ib,ic,j;
     char     i,tag;
 
     if ( !mesh->nt )  return(1);
@@ -1114,7 +1660,7 @@ int _MMG5_bdryPerm(MMG5_pMesh mesh) {
     MMG5_pTria    ptt;
     MMG5_pPoint   ppt;
     _MMG5_Hash    hash;
-    int     *adja,adj,k,kt,ia,ib,ic,nf;
+    MMG5_int *adja,adj,k,kt,ia,ib,ic,nf;
     char     i;
 
     assert(mesh->nt);
@@ -1149,7 +1695,7 @@ int _MMG5_bdryPerm(MMG5_pMesh mesh) {
             if ( !kt ) {
                 fprintf(stdout,"%s:%d: Error: function _MMG5_hashGetFace return 0.\n",__FILE__,__LINE__);
                 fprintf(stdout," Maybe you have non-boundary triangles.");
-                fprintf(stdout," Check triangle of vertices %d %d %d.\n",ia,ib,ic);
+                fprintf(stdout," Check triangle of vertices %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId ".\n",ia,ib,ic);
                 exit(EXIT_FAILURE);
             }
 
@@ -1166,7 +1712,7 @@ int _MMG5_bdryPerm(MMG5_pMesh mesh) {
         }
     }
     if ( mesh->info.ddebug && nf > 0 )
-        fprintf(stdout,"  ## %d faces reoriented\n",nf);
+        fprintf(stdout,"  ## %" MMG5_PRId " faces reoriented\n",nf);
 
     _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
     return(1);
@@ -35,6 +35,8 @@
 
 #include "mmg3d.h"
 
+#include <stdint.h>
+
 
 #define sw 4
 #define sd 8
@@ -89,6 +91,505 @@ static double _MMG5_swapd(double sbin)
     return(out);
 }
 
+/**
+ * \param inm pointer toward the file.
+ * \param iswp 1 if the bytes must be swapped.
+ * \param val pointer toward the integer to fill.
+ *
+ * Read a 32 bits integer of a binary file into a \a MMG5_int.
+ *
+ */
+static void _MMG5_freadi(FILE *inm,int iswp,MMG5_int *val) {
+    int tmp;
+
+    tmp = 0;
+    fread(&tmp,sw,1,inm);
+    if(iswp) tmp=_MMG5_swapbin(tmp);
+    *val = tmp;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param nr number of ridges.
+ * \param npreq number of required vertices.
+ * \param nedreq number of required edges.
+ * \param ntreq number of required triangles.
+ * \param nereq number of required tetrahedra.
+ * \param ncor number of corners.
+ *
+ * Print the statistics of a loaded mesh.
+ *
+ */
+static void _MMG5_loadMeshStats(MMG5_pMesh mesh,MMG5_int nr,MMG5_int npreq,MMG5_int nedreq,
+                                MMG5_int ntreq,MMG5_int nereq,MMG5_int ncor) {
+
+    if ( abs(mesh->info.imprim) > 3 ) {
+        fprintf(stdout,"     NUMBER OF VERTICES     %8" MMG5_PRId "\n",mesh->np);
+        if ( mesh->na ) {
+            fprintf(stdout,"     NUMBER OF EDGES        %8" MMG5_PRId "\n",mesh->na);
+            if ( nr )
+                fprintf(stdout,"     NUMBER OF RIDGES       %8" MMG5_PRId "\n",nr);
+        }
+        if ( mesh->nt )
+            fprintf(stdout,"     NUMBER OF TRIANGLES    %8" MMG5_PRId "\n",mesh->nt);
+        fprintf(stdout,"     NUMBER OF ELEMENTS     %8" MMG5_PRId "\n",mesh->ne);
+
+        if ( npreq || nedreq || ntreq || nereq ) {
+            fprintf(stdout,"     NUMBER OF REQUIRED ENTITIES: \n");
+            if ( npreq )
+                fprintf(stdout,"                  VERTICES    %8" MMG5_PRId " \n",npreq);
+            if ( nedreq )
+                fprintf(stdout,"                  EDGES       %8" MMG5_PRId " \n",nedreq);
+            if ( ntreq )
+                fprintf(stdout,"                  TRIANGLES   %8" MMG5_PRId " \n",ntreq);
+            if ( nereq )
+                fprintf(stdout,"                  TETRAHEDRAS %8" MMG5_PRId " \n",nereq);
+        }
+        if(ncor) fprintf(stdout,"     NUMBER OF CORNERS        %8" MMG5_PRId " \n",ncor);
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param lst lists of vertices, triangles, edges and tetrahedra indices
+ * (see \ref _MMG5_LST_VERREQ and following), possibly NULL.
+ * \param nlst sizes of the lists.
+ * \return 1.
+ *
+ * End the reading of a mesh whose vertices, triangles, edges and
+ * tetrahedra have been stored as they appear in the file (used by the
+ * fast readers): set the vertex tags, remove the MG_ISO triangles and
+ * edges in iso mode, apply the required, corner and ridge lists, orient
+ * the tetrahedra and compute their qualities.
+ *
+ */
+int _MMG5_loadMeshEnd(MMG5_pMesh mesh,MMG5_int *lst[],MMG5_int nlst[]) {
+    MMG5_pTetra pt;
+    MMG5_pTria  pt1;
+    MMG5_pEdge  pa;
+    MMG5_int    *ina,k,i,nt,na,nrev,aux;
+#ifdef USE_OPENMP
+    int         nthr;
+
+    nthr = MG_MAX(1,mesh->info.threads);
+#endif
+    ina  = NULL;
+
+    /* required vertices and corners */
+    for (k=0; k<nlst[_MMG5_LST_VERREQ]; k++) {
+        i = lst[_MMG5_LST_VERREQ][k];
+        if ( i>mesh->np || i<1 )
+            fprintf(stdout,"   Warning: Required Vertices number %8" MMG5_PRId " IGNORED\n",i);
+        else
+            mesh->point[i].tag |= MG_REQ;
+    }
+    for (k=0; k<nlst[_MMG5_LST_CRN]; k++) {
+        i = lst[_MMG5_LST_CRN][k];
+        if ( i>mesh->np || i<1 )
+            fprintf(stdout,"   Warning: Corner number %8" MMG5_PRId " IGNORED\n",i);
+        else
+            mesh->point[i].tag |= MG_CRN;
+    }
+
+    /* triangles, skipping the MG_ISO ones in iso mode */
+    if ( mesh->nt ) {
+        nt = mesh->nt;
+        if ( mesh->info.iso ) {
+            mesh->nt = 0;
+            _MMG5_SAFE_CALLOC(ina,nt+1,MMG5_int);
+            for (k=1; k<=nt; k++) {
+                if ( abs(mesh->tria[k].ref) == MG_ISO )  continue;
+                ina[k] = ++mesh->nt;
+                if ( mesh->nt < k )
+                    memcpy(&mesh->tria[mesh->nt],&mesh->tria[k],sizeof(MMG5_Tria));
+            }
+            if( !mesh->nt )
+                _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
+            else if ( mesh->nt < nt ) {
+                _MMG5_ADD_MEM(mesh,(mesh->nt+1)*sizeof(MMG5_Tria),"triangles",
+                              printf("  Exit program.\n");
+                              exit(EXIT_FAILURE));
+                _MMG5_SAFE_RECALLOC(mesh->tria,nt+1,(mesh->nt+1),MMG5_Tria,"triangles");
+            }
+        }
+
+        for (k=0; k<nlst[_MMG5_LST_TRIREQ]; k++) {
+            i = lst[_MMG5_LST_TRIREQ][k];
+            if ( i>nt || i<1 ) {
+                fprintf(stdout,"   Warning: Required MMG5_Triangles number %8" MMG5_PRId " IGNORED\n",i);
+                continue;
+            }
+            if ( mesh->info.iso ) {
+                if ( !ina[i] )  continue;
+                i = ina[i];
+            }
+            pt1 = &mesh->tria[i];
+            pt1->tag[0] |= MG_REQ;
+            pt1->tag[1] |= MG_REQ;
+            pt1->tag[2] |= MG_REQ;
+        }
+        if ( mesh->info.iso )
+            _MMG5_SAFE_FREE(ina);
+    }
+
+    /* edges, skipping the MG_ISO ones in iso mode */
+    if ( mesh->na ) {
+        na = mesh->na;
+        if ( mesh->info.iso ) {
+            mesh->na = 0;
+            _MMG5_SAFE_CALLOC(ina,na+1,MMG5_int);
+        }
+        for (k=1; k<=na; k++) {
+            pa = &mesh->edge[k];
+            pa->tag |= MG_REF;
+            if ( mesh->info.iso ) {
+                if( abs(pa->ref) != MG_ISO ) {
+                    ++mesh->na;
+                    pa->ref = abs(pa->ref);
+                    memmove(&mesh->edge[mesh->na],&mesh->edge[k],sizeof(MMG5_Edge));
+                    ina[k] = mesh->na;
+                }
+            }
+        }
+
+        for (k=0; k<nlst[_MMG5_LST_RID]; k++) {
+            i = lst[_MMG5_LST_RID][k];
+            if ( i>na || i<1 ) {
+                fprintf(stdout,"   Warning Ridge number %8" MMG5_PRId " IGNORED\n",i);
+                continue;
+            }
+            if ( mesh->info.iso ) {
+                if ( !ina[i] )  continue;
+                i = ina[i];
+            }
+            mesh->edge[i].tag |= MG_GEO;
+        }
+        for (k=0; k<nlst[_MMG5_LST_EDGREQ]; k++) {
+            i = lst[_MMG5_LST_EDGREQ][k];
+            if ( i>na || i<1 ) {
+                fprintf(stdout,"   Warning Required Edges number %8" MMG5_PRId "/%8" MMG5_PRId " IGNORED\n",i,na);
+                continue;
+            }
+            if ( mesh->info.iso ) {
+                if ( !ina[i] )  continue;
+                i = ina[i];
+            }
+            mesh->edge[i].tag |= MG_REQ;
+        }
+        if ( mesh->info.iso )
+            _MMG5_SAFE_FREE(ina);
+    }
+
+    /* tetrahedra: quality and orientation */
+    nrev = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) \
+    private(pt,aux) reduction(+:nrev)
+#endif
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( mesh->info.iso )  pt->ref = 0;
+        pt->qual = _MMG5_orcal(mesh,NULL,k);
+
+        /* Possibly switch 2 vertices number so that each tet is positively oriented */
+        if ( _MMG5_orvol(mesh->point,pt->v) < 0.0 ) {
+            nrev++;
+            aux = pt->v[2];
+            pt->v[2] = pt->v[3];
+            pt->v[3] = aux;
+        }
+    }
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        for (i=0; i<4; i++)
+            mesh->point[pt->v[i]].tag &= ~MG_NUL;
+    }
+    if ( nrev ) {
+        fprintf(stdout,"\n     $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ \n");
+        fprintf(stdout,"         BAD ORIENTATION : vol < 0 -- %8" MMG5_PRId " tetra reoriented\n",nrev);
+        fprintf(stdout,"     $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ \n\n");
+    }
+    mesh->xt = 0;
+
+    for (k=0; k<nlst[_MMG5_LST_TETREQ]; k++) {
+        i = lst[_MMG5_LST_TETREQ][k];
+        if ( i>mesh->ne || i<1 ) {
+            fprintf(stdout,"   Warning Required Tetra number %8" MMG5_PRId " IGNORED\n",i);
+            continue;
+        }
+        mesh->tetra[i].tag |= MG_REQ;
+    }
+
+    _MMG5_loadMeshStats(mesh,nlst[_MMG5_LST_RID],nlst[_MMG5_LST_VERREQ],
+                        nlst[_MMG5_LST_EDGREQ],nlst[_MMG5_LST_TRIREQ],
+                        nlst[_MMG5_LST_TETREQ],nlst[_MMG5_LST_CRN]);
+    return(1);
+}
+
+/** Keywords of the binary mesh format used by \ref _MMG5_loadMeshb. */
+#define _MMG5_KW_DIM     3
+#define _MMG5_KW_VER     4
+#define _MMG5_KW_EDG     5
+#define _MMG5_KW_TRI     6
+#define _MMG5_KW_TET     8
+#define _MMG5_KW_TETREQ 12
+#define _MMG5_KW_CRN    13
+#define _MMG5_KW_RID    14
+#define _MMG5_KW_VERREQ 15
+#define _MMG5_KW_EDGREQ 16
+#define _MMG5_KW_TRIREQ 17
+#define _MMG5_KW_END    54
+#define _MMG5_KW_MAX    55
+
+/**
+ * \param p pointer toward the first byte of the value.
+ * \param isz size of the value (4 or 8 bytes).
+ * \param swp 1 if the bytes must be swapped.
+ * \return the integer value.
+ *
+ * Read an integer of size \a isz at a possibly unaligned address.
+ *
+ */
+static inline int64_t _MMG5_mgeti(const char *p,int isz,int swp) {
+    uint32_t i;
+    uint64_t l;
+
+    if ( isz == 4 ) {
+        memcpy(&i,p,4);
+        if ( swp )  i = __builtin_bswap32(i);
+        return((int64_t)(int32_t)i);
+    }
+    memcpy(&l,p,8);
+    if ( swp )  l = __builtin_bswap64(l);
+    return((int64_t)l);
+}
+
+/**
+ * \param p pointer toward the first byte of the value.
+ * \param dsz size of the value (4 for float, 8 for double).
+ * \param swp 1 if the bytes must be swapped.
+ * \return the real value.
+ *
+ * Read a real of size \a dsz at a possibly unaligned address.
+ *
+ */
+static inline double _MMG5_mgetd(const char *p,int dsz,int swp) {
+    uint32_t i;
+    uint64_t l;
+    float    f;
+    double   d;
+
+    if ( dsz == 4 ) {
+        memcpy(&i,p,4);
+        if ( swp )  i = __builtin_bswap32(i);
+        memcpy(&f,&i,4);
+        return((double)f);
+    }
+    memcpy(&l,p,8);
+    if ( swp )  l = __builtin_bswap64(l);
+    memcpy(&d,&l,8);
+    return(d);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param base pointer toward the file content (see \ref _MMG5_mapFile).
+ * \param len size of the file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read binary mesh data from the mapped file. The keywords are located in
+ * a single walk over the keyword chain, then each section is converted in
+ * one pass into the mesh arrays, swapping the bytes on the fly if the file
+ * endianness differs. File versions 1 to 4 are accepted (64 bits
+ * positions for versions >= 3 and 64 bits integers for version 4).
+ *
+ */
+static int _MMG5_loadMeshb(MMG5_pMesh mesh,const char *base,size_t len) {
+    MMG5_pTetra pt;
+    MMG5_pTria  pt1;
+    MMG5_pEdge  pa;
+    MMG5_pPoint ppt;
+    const char  *end,*p,*sec[_MMG5_KW_MAX];
+    int64_t     next,siz;
+    size_t      rec;
+    MMG5_int    nsec[_MMG5_KW_MAX],*lst[_MMG5_LST_NUM],nlst[_MMG5_LST_NUM],k;
+    int         swp,isz,psz,dsz,kw,ier,l;
+    static const int lkw[_MMG5_LST_NUM] = {
+        _MMG5_KW_VERREQ,_MMG5_KW_CRN,_MMG5_KW_TRIREQ,
+        _MMG5_KW_EDGREQ,_MMG5_KW_RID,_MMG5_KW_TETREQ };
+#ifdef USE_OPENMP
+    int         nthr;
+#endif
+
+    end = base + len;
+    ier = 0;
+    memset(lst,0,_MMG5_LST_NUM*sizeof(MMG5_int*));
+    memset(nlst,0,_MMG5_LST_NUM*sizeof(MMG5_int));
+
+    /* header: endianness code and version */
+    swp = 0;
+    if ( len < 8 ) {
+        fprintf(stdout,"BAD FILE ENCODING\n");
+        return(0);
+    }
+    if ( _MMG5_mgeti(base,4,0) == 16777216 )
+        swp = 1;
+    else if ( _MMG5_mgeti(base,4,0) != 1 ) {
+        fprintf(stdout,"BAD FILE ENCODING\n");
+        return(0);
+    }
+    mesh->ver = (int)_MMG5_mgeti(base+4,4,swp);
+    if ( mesh->ver < 1 || mesh->ver > 4 ) {
+        fprintf(stdout,"  ** UNSUPPORTED MESH VERSION %d.\n",mesh->ver);
+        return(0);
+    }
+    dsz = mesh->ver < 2 ? 4 : 8;
+    psz = mesh->ver < 3 ? 4 : 8;
+    isz = mesh->ver < 4 ? 4 : 8;
+
+    /* locate the sections */
+    memset(sec,0,_MMG5_KW_MAX*sizeof(char*));
+    memset(nsec,0,_MMG5_KW_MAX*sizeof(MMG5_int));
+    mesh->dim = 0;
+    p = base + 8;
+    while ( p + 4 + psz <= end ) {
+        kw = (int)_MMG5_mgeti(p,4,swp);
+        if ( kw == _MMG5_KW_END )  break;
+        next = _MMG5_mgeti(p+4,psz,swp);
+        p   += 4 + psz;
+
+        if ( kw == _MMG5_KW_DIM ) {
+            if ( !mesh->dim && p + 4 <= end )
+                mesh->dim = (int)_MMG5_mgeti(p,4,swp);
+        }
+        else if ( kw > 0 && kw < _MMG5_KW_MAX && !sec[kw] && p + isz <= end ) {
+            siz = _MMG5_mgeti(p,isz,swp);
+            if ( siz < 0 || siz > MMG5_INTMAX ) {
+                fprintf(stdout,"  ** SECTION %d: UNSUPPORTED SIZE %lld.\n",kw,
+                        (long long)siz);
+                return(0);
+            }
+            nsec[kw] = (MMG5_int)siz;
+            sec[kw]  = p + isz;
+        }
+        if ( next <= (int64_t)(p - base) || next >= (int64_t)len )  break;
+        p = base + next;
+    }
+    if ( mesh->dim != 3 ) {
+        fprintf(stdout,"BAD SOL DIMENSION : %d\n",mesh->dim);
+        fprintf(stdout," Exit program.\n");
+        return(0);
+    }
+
+    /* check that each section fits in the file */
+    for (kw=0; kw<_MMG5_KW_MAX; kw++) {
+        if ( !sec[kw] )  continue;
+        switch ( kw ) {
+        case _MMG5_KW_VER: rec = 3*dsz+isz; break;
+        case _MMG5_KW_EDG: rec = 3*isz;     break;
+        case _MMG5_KW_TRI: rec = 4*isz;     break;
+        case _MMG5_KW_TET: rec = 5*isz;     break;
+        default:           rec = isz;       break;
+        }
+        if ( (size_t)(end - sec[kw]) / rec < (size_t)nsec[kw] ) {
+            fprintf(stdout,"  ** TRUNCATED FILE: SECTION %d OVERFLOWS.\n",kw);
+            return(0);
+        }
+    }
+
+    mesh->npi = nsec[_MMG5_KW_VER];
+    mesh->nti = nsec[_MMG5_KW_TRI];
+    mesh->nei = nsec[_MMG5_KW_TET];
+    mesh->nai = nsec[_MMG5_KW_EDG];
+    if ( !mesh->npi || !mesh->nei ) {
+        fprintf(stdout,"  ** MISSING DATA.\n");
+        fprintf(stdout," Check that your mesh contains points and tetrahedra.\n");
+        fprintf(stdout," Exit program.\n");
+        return(0);
+    }
+
+    /* memory allocation */
+    mesh->np = mesh->npi;
+    mesh->nt = mesh->nti;
+    mesh->ne = mesh->nei;
+    mesh->na = mesh->nai;
+    if ( !_MMG5_zaldy(mesh) )  return(0);
+    if (mesh->npmax < mesh->np || mesh->ntmax < mesh->nt || mesh->nemax < mesh->ne)
+        return(0);
+
+#ifdef USE_OPENMP
+    nthr = MG_MAX(1,mesh->info.threads);
+#endif
+
+    /* vertices */
+    rec = 3*dsz+isz;
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) private(ppt,p)
+#endif
+    for (k=1; k<=mesh->np; k++) {
+        ppt = &mesh->point[k];
+        p   = sec[_MMG5_KW_VER] + (size_t)(k-1)*rec;
+        ppt->c[0] = _MMG5_mgetd(p,      dsz,swp);
+        ppt->c[1] = _MMG5_mgetd(p+  dsz,dsz,swp);
+        ppt->c[2] = _MMG5_mgetd(p+2*dsz,dsz,swp);
+        ppt->ref  = (int)_MMG5_mgeti(p+3*dsz,isz,swp);
+        ppt->tag  = MG_NUL;
+        ppt->tmp  = 0;
+    }
+
+    /* triangles */
+    rec = 4*isz;
+    for (k=1; k<=mesh->nt; k++) {
+        p   = sec[_MMG5_KW_TRI] + (size_t)(k-1)*rec;
+        pt1 = &mesh->tria[k];
+        pt1->v[0] = (MMG5_int)_MMG5_mgeti(p,      isz,swp);
+        pt1->v[1] = (MMG5_int)_MMG5_mgeti(p+  isz,isz,swp);
+        pt1->v[2] = (MMG5_int)_MMG5_mgeti(p+2*isz,isz,swp);
+        pt1->ref  = (int)_MMG5_mgeti(p+3*isz,isz,swp);
+    }
+
+    /* edges */
+    rec = 3*isz;
+    for (k=1; k<=mesh->na; k++) {
+        p  = sec[_MMG5_KW_EDG] + (size_t)(k-1)*rec;
+        pa = &mesh->edge[k];
+        pa->a   = (MMG5_int)_MMG5_mgeti(p,      isz,swp);
+        pa->b   = (MMG5_int)_MMG5_mgeti(p+  isz,isz,swp);
+        pa->ref = (int)_MMG5_mgeti(p+2*isz,isz,swp);
+    }
+
+    /* tetrahedra */
+    rec = 5*isz;
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) private(pt,p)
+#endif
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        p  = sec[_MMG5_KW_TET] + (size_t)(k-1)*rec;
+        pt->v[0] = (MMG5_int)_MMG5_mgeti(p,      isz,swp);
+        pt->v[1] = (MMG5_int)_MMG5_mgeti(p+  isz,isz,swp);
+        pt->v[2] = (MMG5_int)_MMG5_mgeti(p+2*isz,isz,swp);
+        pt->v[3] = (MMG5_int)_MMG5_mgeti(p+3*isz,isz,swp);
+        pt->ref  = (int)_MMG5_mgeti(p+4*isz,isz,swp);
+    }
+
+    /* lists of required entities, corners and ridges */
+    for (l=0; l<_MMG5_LST_NUM; l++) {
+        if ( !sec[lkw[l]] || !nsec[lkw[l]] )  continue;
+        nlst[l] = nsec[lkw[l]];
+        _MMG5_SAFE_MALLOC(lst[l],nlst[l],MMG5_int);
+        for (k=0; k<nlst[l]; k++)
+            lst[l][k] = (MMG5_int)_MMG5_mgeti(sec[lkw[l]]+(size_t)k*isz,isz,swp);
+    }
+
+    ier = _MMG5_loadMeshEnd(mesh,lst,nlst);
+
+    for (l=0; l<_MMG5_LST_NUM; l++)
+        if ( lst[l] )  _MMG5_SAFE_FREE(lst[l]);
+
+    return(ier);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \return 0 if failed, 1 otherwise.
@@ -97,18 +598,35 @@ static double _MMG5_swapd(double sbin)
  *
  */
 int MMG5_loadMesh(MMG5_pMesh mesh) {
+    return(_MMG5_loadMesh(mesh,1));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fast 1 to use the fast readers (\ref _MMG5_loadMeshb and \ref
+ * _MMG5_loadMeshAscii), 0 to read the file with the stdio functions.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read mesh data.
+ *
+ */
+int _MMG5_loadMesh(MMG5_pMesh mesh,int fast) {
     FILE*       inm;
     MMG5_pTetra pt;
     MMG5_pTria  pt1;
     MMG5_pEdge  pa;
     MMG5_pPoint ppt;
-    int         posnp,posnt,posne,posned,posncor,posnpreq,posntreq,posnereq,posnedreq;
-    int         posnr;
-    int         npreq,ntreq,nereq,nedreq,ncor,ned,bin,iswp;
-    int         binch,bdim,bpos,i,k;
-    int         *ina,v[3],ref,nt,na,nr,ia,aux;
+    long        posnp,posnt,posne,posned,posncor,posnpreq,posntreq,posnereq,posnedreq;
+    long        posnr;
+    MMG5_int    npreq,ntreq,nereq,nedreq,ncor,ned;
+    int         bin,iswp;
+    int         binch,bdim,bpos;
+    MMG5_int    *ina,v[3],nt,na,nr,ia,aux,i,k;
+    int         ref;
     float            fc;
-    char        *ptr,*name,data[128],chaine[128];
+    char        *ptr,*name,*buf,data[128],chaine[128];
+    size_t      len;
+    int         mapped;
 
     posnp = posnt = posne = posncor = 0;
     posnpreq = posntreq = posnereq = posned = posnedreq = posnr = 0;
@@ -171,6 +689,16 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
     }
     fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+    if ( fast && (buf = _MMG5_mapFile(inm,&len,&mapped)) ) {
+        fclose(inm);
+        if ( bin )
+            k = _MMG5_loadMeshb(mesh,buf,len);
+        else
+            k = _MMG5_loadMeshAscii(mesh,buf,len);
+        _MMG5_unmapFile(buf,len,mapped);
+        return((int)k);
+    }
+
     if (!bin) {
         strcpy(chaine,"D");
         while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
@@ -185,43 +713,43 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
                 }
                 continue;
             } else if(!strncmp(chaine,"Vertices",strlen("Vertices"))) {
-                fscanf(inm,"%d",&mesh->npi);
+                fscanf(inm,"%" MMG5_SCNd,&mesh->npi);
                 posnp = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"RequiredVertices",strlen("RequiredVertices"))) {
-                fscanf(inm,"%d",&npreq);
+                fscanf(inm,"%" MMG5_SCNd,&npreq);
                 posnpreq = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"Triangles",strlen("Triangles"))) {
-                fscanf(inm,"%d",&mesh->nti);
+                fscanf(inm,"%" MMG5_SCNd,&mesh->nti);
                 posnt = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"RequiredTriangles",strlen("RequiredTriangles"))) {
-                fscanf(inm,"%d",&ntreq);
+                fscanf(inm,"%" MMG5_SCNd,&ntreq);
                 posntreq = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"Tetrahedra",strlen("Tetrahedra"))) {
-                fscanf(inm,"%d",&mesh->nei);
+                fscanf(inm,"%" MMG5_SCNd,&mesh->nei);
                 posne = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"RequiredTetrahedra",strlen("RequiredTetrahedra"))) {
-                fscanf(inm,"%d",&nereq);
+                fscanf(inm,"%" MMG5_SCNd,&nereq);
                 posnereq = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"Corners",strlen("Corners"))) {
-                fscanf(inm,"%d",&ncor);
+                fscanf(inm,"%" MMG5_SCNd,&ncor);
                 posncor = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"Edges",strlen("Edges"))) {
-                fscanf(inm,"%d",&mesh->nai);
+                fscanf(inm,"%" MMG5_SCNd,&mesh->nai);
                 posned = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"RequiredEdges",strlen("RequiredEdges"))) {
-                fscanf(inm,"%d",&nedreq);
+                fscanf(inm,"%" MMG5_SCNd,&nedreq);
                 posnedreq = ftell(inm);
                 continue;
             } else if(!strncmp(chaine,"Ridges",strlen("Ridges"))) {
-                fscanf(inm,"%d",&nr);
+                fscanf(inm,"%" MMG5_SCNd,&nr);
                 posnr = ftell(inm);
                 continue;
             }
@@ -255,8 +783,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(!mesh->npi && binch==4) {  //Vertices
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&mesh->npi,sw,1,inm);
-                if(iswp) mesh->npi=_MMG5_swapbin(mesh->npi);
+                _MMG5_freadi(inm,iswp,&mesh->npi);
                 posnp = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -264,8 +791,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(binch==15) {  //RequiredVertices
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&npreq,sw,1,inm);
-                if(iswp) npreq=_MMG5_swapbin(npreq);
+                _MMG5_freadi(inm,iswp,&npreq);
                 posnpreq = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -273,8 +799,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(!mesh->nti && binch==6) {//Triangles
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&mesh->nti,sw,1,inm);
-                if(iswp) mesh->nti=_MMG5_swapbin(mesh->nti);
+                _MMG5_freadi(inm,iswp,&mesh->nti);
                 posnt = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -282,8 +807,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(binch==17) {  //RequiredTriangles
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&ntreq,sw,1,inm);
-                if(iswp) ntreq=_MMG5_swapbin(ntreq);
+                _MMG5_freadi(inm,iswp,&ntreq);
                 posntreq = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -291,8 +815,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(!mesh->nei && binch==8) {//Tetra
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&mesh->nei,sw,1,inm);
-                if(iswp) mesh->nei=_MMG5_swapbin(mesh->nei);
+                _MMG5_freadi(inm,iswp,&mesh->nei);
                 posne = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -300,8 +823,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(binch==12) {  //RequiredTetra
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&nereq,sw,1,inm);
-                if(iswp) nereq=_MMG5_swapbin(nereq);
+                _MMG5_freadi(inm,iswp,&nereq);
                 posnereq = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -309,8 +831,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(!ncor && binch==13) { //Corners
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&ncor,sw,1,inm);
-                if(iswp) ncor=_MMG5_swapbin(ncor);
+                _MMG5_freadi(inm,iswp,&ncor);
                 posncor = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -318,8 +839,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(!mesh->nai && binch==5) { //Edges
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&mesh->nai,sw,1,inm);
-                if(iswp) mesh->nai=_MMG5_swapbin(mesh->nai);
+                _MMG5_freadi(inm,iswp,&mesh->nai);
                 posned = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -327,8 +847,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             } else if(binch==16) {  //RequiredEdges
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&nedreq,sw,1,inm);
-                if(iswp) nedreq=_MMG5_swapbin(nedreq);
+                _MMG5_freadi(inm,iswp,&nedreq);
                 posnedreq = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -336,8 +855,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             }  else if(binch==14) {  //Ridges
                 fread(&bpos,sw,1,inm); //NulPos
                 if(iswp) bpos=_MMG5_swapbin(bpos);
-                fread(&nr,sw,1,inm);
-                if(iswp) nr=_MMG5_swapbin(nr);
+                _MMG5_freadi(inm,iswp,&nr);
                 posnr = ftell(inm);
                 rewind(inm);
                 fseek(inm,bpos,SEEK_SET);
@@ -410,13 +928,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
         fseek(inm,posnpreq,SEEK_SET);
         for (k=1; k<=npreq; k++) {
             if(!bin)
-                fscanf(inm,"%d",&i);
+                fscanf(inm,"%" MMG5_SCNd,&i);
             else {
-                fread(&i,sw,1,inm);
-                if(iswp) i=_MMG5_swapbin(i);
+                _MMG5_freadi(inm,iswp,&i);
             }
             if(i>mesh->np) {
-                fprintf(stdout,"   Warning: Required Vertices number %8d IGNORED\n",i);
+                fprintf(stdout,"   Warning: Required Vertices number %8" MMG5_PRId " IGNORED\n",i);
             } else {
                 ppt = &mesh->point[i];
                 ppt->tag |= MG_REQ;
@@ -430,13 +947,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
         fseek(inm,posncor,SEEK_SET);
         for (k=1; k<=ncor; k++) {
             if(!bin)
-                fscanf(inm,"%d",&i);
+                fscanf(inm,"%" MMG5_SCNd,&i);
             else {
-                fread(&i,sw,1,inm);
-                if(iswp) i=_MMG5_swapbin(i);
+                _MMG5_freadi(inm,iswp,&i);
             }
             if(i>mesh->np) {
-                fprintf(stdout,"   Warning: Corner number %8d IGNORED\n",i);
+                fprintf(stdout,"   Warning: Corner number %8" MMG5_PRId " IGNORED\n",i);
             } else {
                 ppt = &mesh->point[i];
                 ppt->tag |= MG_CRN;
@@ -453,15 +969,14 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
         if( mesh->info.iso ) {
             nt = mesh->nt;
             mesh->nt = 0;
-            _MMG5_SAFE_CALLOC(ina,nt+1,int);
+            _MMG5_SAFE_CALLOC(ina,nt+1,MMG5_int);
 
             for (k=1; k<=nt; k++) {
                 if (!bin)
-                    fscanf(inm,"%d %d %d %d",&v[0],&v[1],&v[2],&ref);
+                    fscanf(inm,"%" MMG5_SCNd " %" MMG5_SCNd " %" MMG5_SCNd " %d",&v[0],&v[1],&v[2],&ref);
                 else {
                     for (i=0 ; i<3 ; i++) {
-                        fread(&v[i],sw,1,inm);
-                        if(iswp) v[i]=_MMG5_swapbin(v[i]);
+                        _MMG5_freadi(inm,iswp,&v[i]);
                     }
                     fread(&ref,sw,1,inm);
                     if(iswp) ref=_MMG5_swapbin(ref);
@@ -489,11 +1004,10 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             for (k=1; k<=mesh->nt; k++) {
                 pt1 = &mesh->tria[k];
                 if (!bin)
-                    fscanf(inm,"%d %d %d %d",&pt1->v[0],&pt1->v[1],&pt1->v[2],&pt1->ref);
+                    fscanf(inm,"%" MMG5_SCNd " %" MMG5_SCNd " %" MMG5_SCNd " %d",&pt1->v[0],&pt1->v[1],&pt1->v[2],&pt1->ref);
                 else {
                     for (i=0 ; i<3 ; i++) {
-                        fread(&pt1->v[i],sw,1,inm);
-                        if(iswp) pt1->v[i]=_MMG5_swapbin(pt1->v[i]);
+                        _MMG5_freadi(inm,iswp,&pt1->v[i]);
                     }
                     fread(&pt1->ref,sw,1,inm);
                     if(iswp) pt1->ref=_MMG5_swapbin(pt1->ref);
@@ -506,13 +1020,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             fseek(inm,posntreq,SEEK_SET);
             for (k=1; k<=ntreq; k++) {
                 if(!bin)
-                    fscanf(inm,"%d",&i);
+                    fscanf(inm,"%" MMG5_SCNd,&i);
                 else {
-                    fread(&i,sw,1,inm);
-                    if(iswp) i=_MMG5_swapbin(i);
+                    _MMG5_freadi(inm,iswp,&i);
                 }
                 if ( i>mesh->nt ) {
-                    fprintf(stdout,"   Warning: Required MMG5_Triangles number %8d IGNORED\n",i);
+                    fprintf(stdout,"   Warning: Required MMG5_Triangles number %8" MMG5_PRId " IGNORED\n",i);
                 } else {
                     if( mesh->info.iso ){
                         if( ina[i] == 0 ) continue;
@@ -541,7 +1054,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
         na = mesh->na;
         if (mesh->info.iso ) {
             mesh->na = 0;
-            _MMG5_SAFE_CALLOC(ina,na+1,int);
+            _MMG5_SAFE_CALLOC(ina,na+1,MMG5_int);
         }
 
         rewind(inm);
@@ -550,12 +1063,10 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
         for (k=1; k<=na; k++) {
             pa = &mesh->edge[k];
             if (!bin)
-                fscanf(inm,"%d %d %d",&pa->a,&pa->b,&pa->ref);
+                fscanf(inm,"%" MMG5_SCNd " %" MMG5_SCNd " %d",&pa->a,&pa->b,&pa->ref);
             else {
-                fread(&pa->a,sw,1,inm);
-                if(iswp) pa->a=_MMG5_swapbin(pa->a);
-                fread(&pa->b,sw,1,inm);
-                if(iswp) pa->b=_MMG5_swapbin(pa->b);
+                _MMG5_freadi(inm,iswp,&pa->a);
+                _MMG5_freadi(inm,iswp,&pa->b);
                 fread(&pa->ref,sw,1,inm);
                 if(iswp) pa->ref=_MMG5_swapbin(pa->ref);
             }
@@ -576,13 +1087,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             fseek(inm,posnr,SEEK_SET);
             for (k=1; k<=nr; k++) {
                 if(!bin)
-                    fscanf(inm,"%d",&ia);
+                    fscanf(inm,"%" MMG5_SCNd,&ia);
                 else {
-                    fread(&ia,sw,1,inm);
-                    if(iswp) ia=_MMG5_swapbin(ia);
+                    _MMG5_freadi(inm,iswp,&ia);
                 }
                 if(ia>na) {
-                    fprintf(stdout,"   Warning Ridge number %8d IGNORED\n",ia);
+                    fprintf(stdout,"   Warning Ridge number %8" MMG5_PRId " IGNORED\n",ia);
                     continue;
                 }
                 if( mesh->info.iso ){
@@ -605,13 +1115,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
             fseek(inm,posnedreq,SEEK_SET);
             for (k=1; k<=nedreq; k++) {
                 if(!bin)
-                    fscanf(inm,"%d",&ia);
+                    fscanf(inm,"%" MMG5_SCNd,&ia);
                 else {
-                    fread(&ia,sw,1,inm);
-                    if(iswp) ia=_MMG5_swapbin(ia);
+                    _MMG5_freadi(inm,iswp,&ia);
                 }
                 if(ia>na) {
-                    fprintf(stdout,"   Warning Required Edges number %8d/%8d IGNORED\n",ia,na);
+                    fprintf(stdout,"   Warning Required Edges number %8" MMG5_PRId "/%8" MMG5_PRId " IGNORED\n",ia,na);
                     continue;
                 }
                 if( mesh->info.iso ){
@@ -639,17 +1148,16 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
     for (k=1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
         if (!bin)
-            fscanf(inm,"%d %d %d %d %d",&pt->v[0],&pt->v[1],&pt->v[2],&pt->v[3],&ref);
+            fscanf(inm,"%" MMG5_SCNd " %" MMG5_SCNd " %" MMG5_SCNd " %" MMG5_SCNd " %d",&pt->v[0],&pt->v[1],&pt->v[2],&pt->v[3],&ref);
         else {
             for (i=0 ; i<4 ; i++) {
-                fread(&pt->v[i],sw,1,inm);
-                if(iswp) pt->v[i]=_MMG5_swapbin(pt->v[i]);
+                _MMG5_freadi(inm,iswp,&pt->v[i]);
             }
             fread(&ref,sw,1,inm);
             if(iswp) ref=_MMG5_swapbin(ref);
         }
         pt->ref  = ref;//0;//ref ;
-        pt->qual = _MMG5_orcal(mesh,k);
+        pt->qual = _MMG5_orcal(mesh,NULL,k);
         for (i=0; i<4; i++) {
             ppt = &mesh->point[pt->v[i]];
             ppt->tag &= ~MG_NUL;
@@ -668,7 +1176,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
     }
     if(mesh->xt) {
         fprintf(stdout,"\n     $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ \n");
-        fprintf(stdout,"         BAD ORIENTATION : vol < 0 -- %8d tetra reoriented\n",mesh->xt);
+        fprintf(stdout,"         BAD ORIENTATION : vol < 0 -- %8" MMG5_PRId " tetra reoriented\n",mesh->xt);
         fprintf(stdout,"     $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ \n\n");
     }
     mesh->xt = 0;
@@ -678,13 +1186,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
         fseek(inm,posnereq,SEEK_SET);
         for (k=1; k<=nereq; k++) {
             if(!bin)
-                fscanf(inm,"%d",&i);
+                fscanf(inm,"%" MMG5_SCNd,&i);
             else {
-                fread(&i,sw,1,inm);
-                if(iswp) i=_MMG5_swapbin(i);
+                _MMG5_freadi(inm,iswp,&i);
             }
             if(i>mesh->ne) {
-                fprintf(stdout,"   Warning Required Tetra number %8d IGNORED\n",i);
+                fprintf(stdout,"   Warning Required Tetra number %8" MMG5_PRId " IGNORED\n",i);
                 continue;
             }
             pt = &mesh->tetra[i];
@@ -694,30 +1201,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
 
 
     /* stats */
-    if ( abs(mesh->info.imprim) > 3 ) {
-        fprintf(stdout,"     NUMBER OF VERTICES     %8d\n",mesh->np);
-        if ( mesh->na ) {
-            fprintf(stdout,"     NUMBER OF EDGES        %8d\n",mesh->na);
-            if ( nr )
-                fprintf(stdout,"     NUMBER OF RIDGES       %8d\n",nr);
-        }
-        if ( mesh->nt )
-            fprintf(stdout,"     NUMBER OF TRIANGLES    %8d\n",mesh->nt);
-        fprintf(stdout,"     NUMBER OF ELEMENTS     %8d\n",mesh->ne);
-
-        if ( npreq || nedreq || ntreq || nereq ) {
-            fprintf(stdout,"     NUMBER OF REQUIRED ENTITIES: \n");
-            if ( npreq )
-                fprintf(stdout,"                  VERTICES    %8d \n",npreq);
-            if ( nedreq )
-                fprintf(stdout,"                  EDGES       %8d \n",nedreq);
-            if ( ntreq )
-                fprintf(stdout,"                  TRIANGLES   %8d \n",ntreq);
-            if ( nereq )
-                fprintf(stdout,"                  TETRAHEDRAS %8d \n",nereq);
-        }
-        if(ncor) fprintf(stdout,"     NUMBER OF CORNERS        %8d \n",ncor);
-    }
+    _MMG5_loadMeshStats(mesh,nr,npreq,nedreq,ntreq,nereq,ncor);
     fclose(inm);
     return(1);
 }
@@ -725,72 +1209,330 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
 /**
  * \param mesh pointer toward the mesh structure.
  * \return 0 if failed, 1 otherwise.
- * \remark Function call through the function pointer \ref MMG5_saveMesh.
  *
- * Save mesh data.
+ * Save mesh data with the function set by \ref MMG5_Set_saveFunc.
  *
  */
-int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
-    FILE*        inm;
+int MMG5_saveMesh(MMG5_pMesh mesh) {
+    if ( !mesh->saveMesh )  MMG5_Set_saveFunc(mesh);
+    return(mesh->saveMesh(mesh));
+}
+
+/* formatting functions of the sections (see _MMG5_wfunc) */
+
+/* vertices */
+static int _MMG5_wVertex(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pPoint  ppt;
+    int          n;
+
+    ppt = &mesh->point[k];
+    if ( !out )  return( MG_VOK(ppt) ? _MMG5_WBASE|_MMG5_WSEL : 0 );
+
+    n  = _MMG5_wdbl(w,out,ppt->c[0]," ");
+    n += _MMG5_wdbl(w,out+n,ppt->c[1]," ");
+    n += _MMG5_wdbl(w,out+n,ppt->c[2]," ");
+    n += _MMG5_wint(w,out+n,abs(ppt->ref),"\n");
+    return(n);
+}
+
+/* vertices with the tag w->tag (corners or required vertices) */
+static int _MMG5_wVertexLst(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pPoint  ppt;
+
+    ppt = &mesh->point[k];
+    if ( !out )
+        return( MG_VOK(ppt) && (ppt->tag & w->tag) ? _MMG5_WBASE|_MMG5_WSEL : 0 );
+
+    return(_MMG5_wint(w,out,ppt->tmp," \n"));
+}
+
+/* normals at the boundary vertices */
+static int _MMG5_wNormal(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
     MMG5_pPoint  ppt;
-    MMG5_pTetra  pt;
-    MMG5_pTria   ptt;
     MMG5_xPoint *pxp;
-    MMG5_hgeom  *ph;
-    int          k,i,na,nc,np,ne,nn,nr,nre,nedreq,ntreq,nt,nereq;
-    int          bin,binch,bpos;
-    char         data[128],chaine[128],*ptr;
+    int          n;
 
-    mesh->ver = 2;
-    bin = 0;
-    strcpy(data,mesh->nameout);
-    ptr = strstr(data,".mesh");
-    if ( !ptr ) {
-        strcat(data,".meshb");
-        if( !(inm = fopen(data,"wb")) ) {
-            ptr  = strstr(data,".mesh");
-            *ptr = '\0';
-            strcat(data,".mesh");
+    ppt = &mesh->point[k];
+    if ( !out ) {
+        if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  return(0);
+        return( (ppt->tag & MG_BDY) && (!(ppt->tag & MG_GEO) || (ppt->tag & MG_NOM)) ?
+                _MMG5_WBASE|_MMG5_WSEL : 0 );
+    }
+
+    pxp = &mesh->xpoint[ppt->xp];
+    n  = _MMG5_wdbl(w,out,pxp->n1[0]," ");
+    n += _MMG5_wdbl(w,out+n,pxp->n1[1]," ");
+    n += _MMG5_wdbl(w,out+n,pxp->n1[2]," \n");
+    return(n);
+}
+
+/* vertex and normal indices */
+static int _MMG5_wNormalAt(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    int          n;
+
+    if ( !out )  return(_MMG5_wNormal(mesh,w,k,idx,out));
+
+    n  = _MMG5_wint(w,out,mesh->point[k].tmp," ");
+    n += _MMG5_wint(w,out+n,idx,"\n");
+    return(n);
+}
+
+/* tangents at the ridge and non-manifold vertices */
+static int _MMG5_wTangent(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pPoint  ppt;
+    MMG5_xPoint *pxp;
+    int          n;
+
+    ppt = &mesh->point[k];
+    if ( !out ) {
+        if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  return(0);
+        return( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) ? _MMG5_WBASE|_MMG5_WSEL : 0 );
+    }
+
+    pxp = &mesh->xpoint[ppt->xp];
+    n  = _MMG5_wdbl(w,out,pxp->t[0]," ");
+    n += _MMG5_wdbl(w,out+n,pxp->t[1]," ");
+    n += _MMG5_wdbl(w,out+n,pxp->t[2]," \n");
+    return(n);
+}
+
+/* vertex and tangent indices */
+static int _MMG5_wTangentAt(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    int          n;
+
+    if ( !out )  return(_MMG5_wTangent(mesh,w,k,idx,out));
+
+    n  = _MMG5_wint(w,out,mesh->point[k].tmp," ");
+    n += _MMG5_wint(w,out+n,idx,"\n");
+    return(n);
+}
+
+/* triangles */
+static int _MMG5_wTria(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pTria   ptt;
+    int          n;
+
+    if ( !out )  return(_MMG5_WBASE|_MMG5_WSEL);
+
+    ptt = &mesh->tria[k];
+    n  = _MMG5_wint(w,out,mesh->point[ptt->v[0]].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[ptt->v[1]].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[ptt->v[2]].tmp," ");
+    n += _MMG5_wint(w,out+n,ptt->ref,"\n");
+    return(n);
+}
+
+/* required triangles */
+static int _MMG5_wTriaReq(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pTria   ptt;
+
+    if ( !out ) {
+        ptt = &mesh->tria[k];
+        if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ )
+            return(_MMG5_WBASE|_MMG5_WSEL);
+        return(_MMG5_WBASE);
+    }
+    return(_MMG5_wint(w,out,idx," \n"));
+}
+
+/* edges of the mesh */
+static int _MMG5_wEdge(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pEdge   pa;
+    int          n;
+
+    if ( !out )  return(_MMG5_WBASE|_MMG5_WSEL);
+
+    pa = &mesh->edge[k];
+    n  = _MMG5_wint(w,out,mesh->point[pa->a].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[pa->b].tmp," ");
+    n += _MMG5_wint(w,out+n,pa->ref," \n");
+    return(n);
+}
+
+/* edges of the mesh with the tag w->tag (ridges or required edges) */
+static int _MMG5_wEdgeLst(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+
+    if ( !out )
+        return( mesh->edge[k].tag & w->tag ? _MMG5_WBASE|_MMG5_WSEL : _MMG5_WBASE );
+    return(_MMG5_wint(w,out,idx," \n"));
+}
+
+/* packed edges of the geometric hash table w->data */
+static int _MMG5_wHEdge(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_hgeom  *ph;
+    int          n;
+
+    if ( !out )  return(_MMG5_WBASE|_MMG5_WSEL);
+
+    ph = &((MMG5_hgeom*)w->data)[k];
+    n  = _MMG5_wint(w,out,mesh->point[ph->a].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[ph->b].tmp," ");
+    n += _MMG5_wint(w,out+n,ph->ref," \n");
+    return(n);
+}
+
+/* packed edges of w->data with the tag w->tag (ridges or required edges) */
+static int _MMG5_wHEdgeLst(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+
+    if ( !out )
+        return( ((MMG5_hgeom*)w->data)[k].tag & w->tag ?
+                _MMG5_WBASE|_MMG5_WSEL : _MMG5_WBASE );
+    return(_MMG5_wint(w,out,idx," \n"));
+}
+
+/* tetrahedra */
+static int _MMG5_wTetra(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pTetra  pt;
+    int          n;
+
+    pt = &mesh->tetra[k];
+    if ( !out )  return( MG_EOK(pt) ? _MMG5_WBASE|_MMG5_WSEL : 0 );
+
+    n  = _MMG5_wint(w,out,mesh->point[pt->v[0]].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[pt->v[1]].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[pt->v[2]].tmp," ");
+    n += _MMG5_wint(w,out+n,mesh->point[pt->v[3]].tmp," ");
+    n += _MMG5_wint(w,out+n,pt->ref,"\n");
+    return(n);
+}
+
+/* required tetrahedra */
+static int _MMG5_wTetraReq(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    MMG5_pTetra  pt;
+
+    if ( !out ) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  return(0);
+        return( pt->tag & MG_REQ ? _MMG5_WBASE|_MMG5_WSEL : _MMG5_WBASE );
+    }
+    return(_MMG5_wint(w,out,idx," \n"));
+}
+
+/* isotropic metric w->data */
+static int _MMG5_wSol(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+
+    if ( !out )  return( MG_VOK(&mesh->point[k]) ? _MMG5_WBASE|_MMG5_WSEL : 0 );
+    return(_MMG5_wdbl(w,out,((MMG5_pSol)w->data)->m[k]," \n "));
+}
+
+/* anisotropic metric w->data (m11 m12 m22 m13 m23 m33 in the file) */
+static int _MMG5_wSolAni(MMG5_pMesh mesh,_MMG5_wfile *w,MMG5_int k,MMG5_int idx,char *out) {
+    double *m;
+    int     n;
+
+    if ( !out )  return( MG_VOK(&mesh->point[k]) ? _MMG5_WBASE|_MMG5_WSEL : 0 );
+    m  = &((MMG5_pSol)w->data)->m[(k-1)*6+1];
+    n  = _MMG5_wdbl(w,out,m[0]," ");
+    n += _MMG5_wdbl(w,out+n,m[1]," ");
+    n += _MMG5_wdbl(w,out+n,m[3]," ");
+    n += _MMG5_wdbl(w,out+n,m[2]," ");
+    n += _MMG5_wdbl(w,out+n,m[4]," ");
+    n += _MMG5_wdbl(w,out+n,m[5]," \n ");
+    return(n);
+}
+
+/* sections: name, separator, code, integers, doubles, solutions, optional */
+static const _MMG5_wkwd _MMG5_kwVer    = {"Vertices",           "\n",  4,1,3,0,0,_MMG5_wVertex};
+static const _MMG5_wkwd _MMG5_kwCrn    = {"Corners",            "\n", 13,1,0,0,1,_MMG5_wVertexLst};
+static const _MMG5_wkwd _MMG5_kwVerReq = {"RequiredVertices",   "\n", 15,1,0,0,1,_MMG5_wVertexLst};
+static const _MMG5_wkwd _MMG5_kwNor    = {"Normals",            "\n", 60,0,3,0,0,_MMG5_wNormal};
+static const _MMG5_wkwd _MMG5_kwNorAt  = {"NormalAtVertices",   "\n", 20,2,0,0,0,_MMG5_wNormalAt};
+static const _MMG5_wkwd _MMG5_kwTan    = {"Tangents",           "\n", 59,0,3,0,1,_MMG5_wTangent};
+static const _MMG5_wkwd _MMG5_kwTanAt  = {"TangentAtVertices",  "\n", 61,2,0,0,1,_MMG5_wTangentAt};
+static const _MMG5_wkwd _MMG5_kwTri    = {"Triangles",          " \n", 6,4,0,0,0,_MMG5_wTria};
+static const _MMG5_wkwd _MMG5_kwTriReq = {"RequiredTriangles",  " \n",17,1,0,0,1,_MMG5_wTriaReq};
+static const _MMG5_wkwd _MMG5_kwEdg    = {"Edges",              "\n",  5,3,0,0,1,_MMG5_wEdge};
+static const _MMG5_wkwd _MMG5_kwRid    = {"Ridges",             "\n", 14,1,0,0,1,_MMG5_wEdgeLst};
+static const _MMG5_wkwd _MMG5_kwEdgReq = {"RequiredEdges",      "\n", 16,1,0,0,1,_MMG5_wEdgeLst};
+static const _MMG5_wkwd _MMG5_kwHEdg   = {"Edges",              "\n",  5,3,0,0,1,_MMG5_wHEdge};
+static const _MMG5_wkwd _MMG5_kwHRid   = {"Ridges",             "\n", 14,1,0,0,1,_MMG5_wHEdgeLst};
+static const _MMG5_wkwd _MMG5_kwHEdgReq= {"RequiredEdges",      "\n", 16,1,0,0,1,_MMG5_wHEdgeLst};
+static const _MMG5_wkwd _MMG5_kwTet    = {"Tetrahedra",         "\n",  8,5,0,0,0,_MMG5_wTetra};
+static const _MMG5_wkwd _MMG5_kwTetReq = {"RequiredTetrahedra", "\n", 12,1,0,0,1,_MMG5_wTetraReq};
+static const _MMG5_wkwd _MMG5_kwSol    = {"SolAtVertices",      "\n", 62,0,1,1,0,_MMG5_wSol};
+static const _MMG5_wkwd _MMG5_kwSolAni = {"SolAtVertices",      "\n", 62,0,6,1,0,_MMG5_wSolAni};
+
+/**
+ * \param np number of vertices.
+ * \param nt upper bound of the number of triangles.
+ * \param na upper bound of the number of edges.
+ * \param ne number of tetrahedra.
+ * \return an upper bound of the size of the binary mesh file.
+ *
+ * Estimate the binary file size to select the file version.
+ *
+ */
+static long long _MMG5_wsizMesh(MMG5_int np,MMG5_int nt,MMG5_int na,MMG5_int ne) {
+    /* vertices, corners, required vertices, normals and tangents */
+    return( 1024 + 100LL*np + 20LL*nt + 20LL*na + 24LL*ne );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param data file name.
+ * \param bin set to 1 for a binary file.
+ * \return the opened file, NULL if failed.
+ *
+ * Open the output mesh file (".meshb" if the name has no extension).
+ *
+ */
+static FILE* _MMG5_openMeshOut(MMG5_pMesh mesh,char *data,int *bin) {
+    FILE        *inm;
+    char        *ptr;
+
+    *bin = 0;
+    strcpy(data,mesh->nameout);
+    ptr = strstr(data,".mesh");
+    if ( !ptr ) {
+        strcat(data,".meshb");
+        if( !(inm = fopen(data,"wb")) ) {
+            ptr  = strstr(data,".mesh");
+            *ptr = '\0';
+            strcat(data,".mesh");
             if( !(inm = fopen(data,"w")) ) {
                 fprintf(stderr,"  ** UNABLE TO OPEN %s.\n",data);
-                return(0);
+                return(NULL);
             }
         } else {
-            bin = 1;
+            *bin = 1;
         }
     }
     else {
         ptr = strstr(data,".meshb");
-        if( ptr ) bin = 1;
+        if( ptr ) *bin = 1;
         if( !(inm = fopen(data,"w")) ) {
             fprintf(stderr,"  ** UNABLE TO OPEN %s.\n",data);
-            return(0);
+            return(NULL);
         }
     }
     fprintf(stdout,"  %%%% %s OPENED\n",data);
+    return(inm);
+}
 
-    /*entete fichier*/
-    binch=0; bpos=10;
-    if(!bin) {
-        strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-        fprintf(inm,"%s",chaine);
-        strcpy(&chaine[0],"\n\nDimension 3\n");
-        fprintf(inm,"%s ",chaine);
-    } else {
-        binch = 1; //MeshVersionFormatted
-        fwrite(&binch,sw,1,inm);
-        binch = 2; //version
-        fwrite(&binch,sw,1,inm);
-        binch = 3; //Dimension
-        fwrite(&binch,sw,1,inm);
-        bpos = 20; //Pos
-        fwrite(&bpos,sw,1,inm);
-        binch = 3;
-        fwrite(&binch,sw,1,inm);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 0 if failed, 1 otherwise.
+ * \remark Function call through \ref MMG5_saveMesh.
+ *
+ * Save mesh data.
+ *
+ */
+int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
+    FILE*        inm;
+    MMG5_pPoint  ppt;
+    MMG5_pTetra  pt;
+    MMG5_hgeom  *ph;
+    _MMG5_wfile  w;
+    MMG5_int     k,na,nc,np,nr,nre;
+    int          i;
+    int          bin;
+    char         data[128];
+
+    mesh->ver = 2;
+    if ( !(inm = _MMG5_openMeshOut(mesh,data,&bin)) )  return(0);
 
-    }
     /* vertices */
-    np = nc = na = nr = nre = 0;
+    np = nc = nre = 0;
     for (k=1; k<=mesh->np; k++) {
         ppt = &mesh->point[k];
         if ( MG_VOK(ppt) ) {
@@ -799,271 +1541,46 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
             if ( ppt->tag & MG_REQ )  nre++;
         }
     }
-
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nVertices\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",np);
-    } else {
-        binch = 4; //Vertices
-        fwrite(&binch,sw,1,inm);
-        bpos += 12+(1+3*mesh->ver)*4*np; //NullPos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&np,sw,1,inm);
-    }
-    for (k=1; k<=mesh->np; k++) {
-        ppt = &mesh->point[k];
-        if ( MG_VOK(ppt) ) {
-            if(!bin) {
-                fprintf(inm,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
-            } else {
-                fwrite((unsigned char*)&ppt->c[0],sd,1,inm);
-                fwrite((unsigned char*)&ppt->c[1],sd,1,inm);
-                fwrite((unsigned char*)&ppt->c[2],sd,1,inm);
-                ppt->ref = abs(ppt->ref);
-                fwrite((unsigned char*)&ppt->ref,sw,1,inm);
-            }
-        }
+    if ( !_MMG5_wopen(mesh,&w,inm,bin,_MMG5_wsizMesh(np,4*mesh->xt,6*mesh->xt,mesh->ne),
+                      MG_MAX(3LL*np,mesh->ne)) ) {
+        fclose(inm);
+        return(0);
     }
+    _MMG5_wsection(mesh,&w,&_MMG5_kwVer,1,mesh->np,0);
 
     /* corners+required */
-    if ( nc ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nCorners\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nc);
-        } else {
-            binch = 13; //
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+4*nc; //NullPos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nc,sw,1,inm);
-        }
-
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( MG_VOK(ppt) && ppt->tag & MG_CRN ) {
-                if(!bin) {
-                    fprintf(inm,"%d \n",ppt->tmp);
-                } else {
-                    fwrite(&ppt->tmp,sw,1,inm);
-                }
-            }
-        }
-    }
-    if ( nre ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nRequiredVertices\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nre);
-        } else {
-            binch = 15; //
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+4*nre; //NullPos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nre,sw,1,inm);
-        }
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( MG_VOK(ppt) && ppt->tag & MG_REQ ) {
-                if(!bin) {
-                    fprintf(inm,"%d \n",ppt->tmp);
-                } else {
-                    fwrite(&ppt->tmp,sw,1,inm);
-                }
-            }
-        }
-    }
+    w.tag = MG_CRN;
+    _MMG5_wsection(mesh,&w,&_MMG5_kwCrn,1,mesh->np,0);
+    w.tag = MG_REQ;
+    _MMG5_wsection(mesh,&w,&_MMG5_kwVerReq,1,mesh->np,0);
 
-    nn = nt = 0;
     if ( mesh->xp ) {
-        /* Count tangents and normals */
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  continue;
-            else if ( (ppt->tag & MG_BDY)
-                      && (!(ppt->tag & MG_GEO) || (ppt->tag & MG_NOM)) )
-                nn++;
-            if ( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) ) nt++;
-        }
-
-        /* write normals */
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nNormals\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nn);
-        } else {
-            binch = 60; //normals
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+(3*mesh->ver)*4*nn; //Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nn,sw,1,inm);
-        }
-
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  continue;
-            else if ( (ppt->tag & MG_BDY)
-                      && (!(ppt->tag & MG_GEO) || (ppt->tag & MG_NOM)) ) {
-                pxp = &mesh->xpoint[ppt->xp];
-                if(!bin) {
-                    fprintf(inm,"%.15lg %.15lg %.15lg \n",pxp->n1[0],pxp->n1[1],pxp->n1[2]);
-                } else {
-                    fwrite((unsigned char*)&pxp->n1[0],sd,1,inm);
-                    fwrite((unsigned char*)&pxp->n1[1],sd,1,inm);
-                    fwrite((unsigned char*)&pxp->n1[2],sd,1,inm);
-                }
-            }
-        }
-
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nNormalAtVertices\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nn);
-        } else {
-            binch = 20; //normalatvertices
-            fwrite(&binch,sw,1,inm);
-            bpos += 12 + 2*4*nn;//Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nn,sw,1,inm);
-        }
-        nn = 0;
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  continue;
-            else if ( (ppt->tag & MG_BDY)
-                      && (!(ppt->tag & MG_GEO) || (ppt->tag & MG_NOM)) ) {
-                if(!bin) {
-                    fprintf(inm,"%d %d\n",ppt->tmp,++nn);
-                } else {
-                    fwrite(&ppt->tmp,sw,1,inm);
-                    ++nn;
-                    fwrite(&nn,sw,1,inm);
-                }
-            }
-        }
-
-        if ( nt ) {
-            /* Write tangents */
-            if(!bin) {
-                strcpy(&chaine[0],"\n\nTangents\n");
-                fprintf(inm,"%s",chaine);
-                fprintf(inm,"%d\n",nt);
-            } else {
-                binch = 59; //tangent
-                fwrite(&binch,sw,1,inm);
-                bpos += 12+(3*mesh->ver)*4*nt; //Pos
-                fwrite(&bpos,sw,1,inm);
-                fwrite(&nt,sw,1,inm);
-            }
-
-            for (k=1; k<=mesh->np; k++) {
-                ppt = &mesh->point[k];
-                if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  continue;
-                else if ( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) ) {
-                    pxp = &mesh->xpoint[ppt->xp];
-                    if(!bin) {
-                        fprintf(inm,"%.15lg %.15lg %.15lg \n",pxp->t[0],pxp->t[1],pxp->t[2]);
-                    } else {
-                        fwrite((unsigned char*)&pxp->t[0],sd,1,inm);
-                        fwrite((unsigned char*)&pxp->t[1],sd,1,inm);
-                        fwrite((unsigned char*)&pxp->t[2],sd,1,inm);
-                    }
-                }
-            }
-
-
-            if(!bin) {
-                strcpy(&chaine[0],"\n\nTangentAtVertices\n");
-                fprintf(inm,"%s",chaine);
-                fprintf(inm,"%d\n",nt);
-            } else {
-                binch = 61; //tangentatvertices
-                fwrite(&binch,sw,1,inm);
-                bpos += 12 + 2*4*nt;//Pos
-                fwrite(&bpos,sw,1,inm);
-                fwrite(&nt,sw,1,inm);
-            }
-            nt = 0;
-            for (k=1; k<=mesh->np; k++) {
-                ppt = &mesh->point[k];
-                if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  continue;
-                else if ( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) ) {
-                    if(!bin) {
-                        fprintf(inm,"%d %d\n",ppt->tmp,++nn);
-                    } else {
-                        fwrite(&ppt->tmp,sw,1,inm);
-                        ++nn;
-                        fwrite(&(nn),sw,1,inm);
-                    }
-                }
-            }
-        }
+        /* normals and tangents */
+        _MMG5_wsection(mesh,&w,&_MMG5_kwNor,1,mesh->np,0);
+        _MMG5_wsection(mesh,&w,&_MMG5_kwNorAt,1,mesh->np,0);
+        _MMG5_wsection(mesh,&w,&_MMG5_kwTan,1,mesh->np,0);
+        _MMG5_wsection(mesh,&w,&_MMG5_kwTanAt,1,mesh->np,0);
     }
     _MMG5_DEL_MEM(mesh,mesh->xpoint,(mesh->xpmax+1)*sizeof(MMG5_xPoint));
     mesh->xp = 0;
 
     /* boundary mesh */
     /* tria + required tria */
-    mesh->nt = ntreq = 0;
+    na = nr = 0;
+    mesh->nt = 0;
     if ( mesh->tria )
         _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
 
     _MMG5_chkNumberOfTri(mesh);
     if ( _MMG5_bdryTria(mesh) ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nTriangles\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d \n",mesh->nt);
-        } else {
-            binch = 6; //Triangles
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+16*mesh->nt; //Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&mesh->nt,sw,1,inm);
-        }
-        for (k=1; k<=mesh->nt; k++) {
-            ptt = &mesh->tria[k];
-            if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ )  ntreq++;
-            if(!bin) {
-                fprintf(inm,"%d %d %d %d\n",mesh->point[ptt->v[0]].tmp,mesh->point[ptt->v[1]].tmp
-                        ,mesh->point[ptt->v[2]].tmp,ptt->ref);
-            } else {
-                fwrite(&mesh->point[ptt->v[0]].tmp,sw,1,inm);
-                fwrite(&mesh->point[ptt->v[1]].tmp,sw,1,inm);
-                fwrite(&mesh->point[ptt->v[2]].tmp,sw,1,inm);
-                fwrite(&ptt->ref,sw,1,inm);
-            }
-        }
-        if ( ntreq ) {
-            if(!bin) {
-                strcpy(&chaine[0],"\n\nRequiredTriangles\n");
-                fprintf(inm,"%s",chaine);
-                fprintf(inm,"%d \n",ntreq);
-            } else {
-                binch = 17; //ReqTriangles
-                fwrite(&binch,sw,1,inm);
-                bpos += 12+4*ntreq; //Pos
-                fwrite(&bpos,sw,1,inm);
-                fwrite(&ntreq,sw,1,inm);
-            }
-            for (k=0; k<=mesh->nt; k++) {
-                ptt = &mesh->tria[k];
-                if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ ) {
-                    if(!bin) {
-                        fprintf(inm,"%d \n",k);
-                    } else {
-                        fwrite(&k,sw,1,inm);
-                    }
-                }
-            }
-        }
+        _MMG5_wsection(mesh,&w,&_MMG5_kwTri,1,mesh->nt,0);
+        _MMG5_wsection(mesh,&w,&_MMG5_kwTriReq,1,mesh->nt,0);
 
         /* Release memory before htab allocation */
         if ( mesh->adjt )
-            _MMG5_DEL_MEM(mesh,mesh->adjt,(3*mesh->nt+4)*sizeof(int));
+            _MMG5_DEL_MEM(mesh,mesh->adjt,(3*mesh->nt+4)*sizeof(MMG5_int));
         if ( mesh->adja )
-            _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+            _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(MMG5_int));
 
         /* build hash table for edges */
         if ( mesh->htab.geom )
@@ -1071,7 +1588,6 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
 
         /* in the wost case (all edges are marked), we will have around 1 edge per *
          * triangle (we count edges only one time) */
-        na = nr = nedreq = 0;
         mesh->memCur += (long long)((3*mesh->nt+2)*sizeof(MMG5_hgeom));
         if ( (mesh->memCur) > (mesh->memMax) ) {
             mesh->memCur -= (long long)((3*mesh->nt+2)*sizeof(MMG5_hgeom));
@@ -1091,90 +1607,21 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
                     }
                 }
             }
-            /* edges + ridges + required edges */
+            /* edges + ridges + required edges: the hash table is packed since
+             * it is released just after */
             for (k=0; k<=mesh->htab.max; k++) {
                 ph = &mesh->htab.geom[k];
                 if ( !ph->a )  continue;
-                na++;
                 if ( ph->tag & MG_GEO )  nr++;
-                if ( ph->tag & MG_REQ )  nedreq++;
-            }
-            if ( na ) {
-                if(!bin) {
-                    strcpy(&chaine[0],"\n\nEdges\n");
-                    fprintf(inm,"%s",chaine);
-                    fprintf(inm,"%d\n",na);
-                } else {
-                    binch = 5; //Edges
-                    fwrite(&binch,sw,1,inm);
-                    bpos += 12 + 3*4*na;//Pos
-                    fwrite(&bpos,sw,1,inm);
-                    fwrite(&na,sw,1,inm);
-                }
-                for (k=0; k<=mesh->htab.max; k++) {
-                    ph = &mesh->htab.geom[k];
-                    if ( !ph->a )  continue;
-                    if(!bin) {
-                        fprintf(inm,"%d %d %d \n",mesh->point[ph->a].tmp,mesh->point[ph->b].tmp,ph->ref);
-                    } else {
-                        fwrite(&mesh->point[ph->a].tmp,sw,1,inm);
-                        fwrite(&mesh->point[ph->b].tmp,sw,1,inm);
-                        fwrite(&ph->ref,sw,1,inm);
-                    }
-                }
-                if ( nr ) {
-                    if(!bin) {
-                        strcpy(&chaine[0],"\n\nRidges\n");
-                        fprintf(inm,"%s",chaine);
-                        fprintf(inm,"%d\n",nr);
-                    } else {
-                        binch = 14; //Ridges
-                        fwrite(&binch,sw,1,inm);
-                        bpos += 12 + 4*nr;//Pos
-                        fwrite(&bpos,sw,1,inm);
-                        fwrite(&nr,sw,1,inm);
-                    }
-                    na = 0;
-                    for (k=0; k<=mesh->htab.max; k++) {
-                        ph = &mesh->htab.geom[k];
-                        if ( !ph->a )  continue;
-                        na++;
-                        if ( ph->tag & MG_GEO )  {
-                            if(!bin) {
-                                fprintf(inm,"%d \n",na);
-                            } else {
-                                fwrite(&na,sw,1,inm);
-                            }
-                        }
-                    }
-                }
-                if ( nedreq ) {
-                    if(!bin) {
-                        strcpy(&chaine[0],"\n\nRequiredEdges\n");
-                        fprintf(inm,"%s",chaine);
-                        fprintf(inm,"%d\n",nedreq);
-                    } else {
-                        binch = 16; //RequiredEdges
-                        fwrite(&binch,sw,1,inm);
-                        bpos += 12 + 4*nedreq;//Pos
-                        fwrite(&bpos,sw,1,inm);
-                        fwrite(&nedreq,sw,1,inm);
-                    }
-                    na = 0;
-                    for (k=0; k<=mesh->htab.max; k++) {
-                        ph = &mesh->htab.geom[k];
-                        if ( !ph->a )  continue;
-                        na++;
-                        if ( ph->tag & MG_REQ )  {
-                            if(!bin) {
-                                fprintf(inm,"%d \n",na);
-                            } else {
-                                fwrite(&na,sw,1,inm);
-                            }
-                        }
-                    }
-                }
+                mesh->htab.geom[na++] = *ph;
             }
+            w.data = mesh->htab.geom;
+            _MMG5_wsection(mesh,&w,&_MMG5_kwHEdg,0,na-1,0);
+            w.tag = MG_GEO;
+            _MMG5_wsection(mesh,&w,&_MMG5_kwHRid,0,na-1,0);
+            w.tag = MG_REQ;
+            _MMG5_wsection(mesh,&w,&_MMG5_kwHEdgReq,0,na-1,0);
+            w.data = NULL;
             //_MMG5_freeXTets(mesh);
             _MMG5_DEL_MEM(mesh,mesh->htab.geom,(mesh->htab.max+1)*sizeof(MMG5_hgeom));
         }
@@ -1183,95 +1630,26 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
     } //fin if bdrytria....
 
     /* tetrahedra */
-    ne = nereq = 0;
-    for (k=1; k<=mesh->ne; k++) {
-        pt = &mesh->tetra[k];
-        if ( !MG_EOK(pt) ) continue;
-        ne++;
-        if ( pt->tag & MG_REQ ){
-            nereq++;
-        }
-    }
-
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nTetrahedra\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",ne);
-    } else {
-        binch = 8; //Tetra
-        fwrite(&binch,sw,1,inm);
-        bpos += 12 + 20*ne;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite((unsigned char*)&ne,sw,1,inm);
-    }
-    for (k=1; k<=mesh->ne; k++) {
-        pt = &mesh->tetra[k];
-        if ( MG_EOK(pt) ) {
-            if(!bin) {
-                fprintf(inm,"%d %d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
-                        ,mesh->point[pt->v[2]].tmp,mesh->point[pt->v[3]].tmp,pt->ref);
-            } else {
-                fwrite(&mesh->point[pt->v[0]].tmp,sw,1,inm);
-                fwrite(&mesh->point[pt->v[1]].tmp,sw,1,inm);
-                fwrite(&mesh->point[pt->v[2]].tmp,sw,1,inm);
-                fwrite(&mesh->point[pt->v[3]].tmp,sw,1,inm);
-                fwrite(&pt->ref,sw,1,inm);
-            }
-        }
-    }
-
-    if ( nereq ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nRequiredTetrahedra\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nereq);
-        } else {
-            binch = 12; //RequiredTetra
-            fwrite(&binch,sw,1,inm);
-            bpos += 12 + 4*nereq;//Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nereq,sw,1,inm);
-        }
-        ne = 0;
-        for (k=1; k<=mesh->ne; k++) {
-            pt = &mesh->tetra[k];
-            if ( !MG_EOK(pt) ) continue;
-            ne++;
-            if ( pt->tag & MG_REQ ) {
-                if(!bin) {
-                    fprintf(inm,"%d \n",ne);
-                } else {
-                    fwrite(&ne,sw,1,inm);
-                }
-            }
-        }
-    }
+    _MMG5_wsection(mesh,&w,&_MMG5_kwTet,1,mesh->ne,0);
+    _MMG5_wsection(mesh,&w,&_MMG5_kwTetReq,1,mesh->ne,0);
 
     if ( mesh->info.imprim ) {
-        fprintf(stdout,"     NUMBER OF VERTICES   %8d   CORNERS %8d\n",np,nc+nre);
+        fprintf(stdout,"     NUMBER OF VERTICES   %8" MMG5_PRId "   CORNERS %8" MMG5_PRId "\n",np,nc+nre);
         if ( na )
-            fprintf(stdout,"     NUMBER OF EDGES      %8d   RIDGES  %8d\n",na,nr);
+            fprintf(stdout,"     NUMBER OF EDGES      %8" MMG5_PRId "   RIDGES  %8" MMG5_PRId "\n",na,nr);
         if ( mesh->nt )
-            fprintf(stdout,"     NUMBER OF TRIANGLES  %8d\n",mesh->nt);
-        fprintf(stdout,"     NUMBER OF ELEMENTS   %8d\n",mesh->ne);
+            fprintf(stdout,"     NUMBER OF TRIANGLES  %8" MMG5_PRId "\n",mesh->nt);
+        fprintf(stdout,"     NUMBER OF ELEMENTS   %8" MMG5_PRId "\n",mesh->ne);
     }
 
     /*fin fichier*/
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nEnd\n");
-        fprintf(inm,"%s",chaine);
-    } else {
-        binch = 54; //End
-        fwrite(&binch,sw,1,inm);
-    }
-    fclose(inm);
-    return(1);
+    return(_MMG5_wclose(mesh,&w));
 }
 
 /**
  * \param mesh pointer toward the mesh structure.
  * \return 0 if failed, 1 otherwise.
- * \remark Function call through the function pointer \ref MMG5_saveMesh.
+ * \remark Function call through \ref MMG5_saveMesh.
  *
  * Save mesh data without adjacency and xtetra tables (for library version).
  *
@@ -1279,58 +1657,14 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
 int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
     FILE        *inm;
     MMG5_pPoint  ppt;
-    MMG5_pTetra  pt;
-    MMG5_pTria   ptt;
-    int          k,nc,np,ne,nr,nre,nedreq,ntreq,nereq;
-    int          bin,binch,bpos,na;
-    char         data[128],chaine[128],*ptr;
+    _MMG5_wfile  w;
+    MMG5_int     k,nc,np,nr,nre;
+    int          bin;
+    char         data[128];
 
     mesh->ver = 2;
-    bin = 0;
-    strcpy(data,mesh->nameout);
-    ptr = strstr(data,".mesh");
-    if ( !ptr ) {
-        strcat(data,".meshb");
-        if( !(inm = fopen(data,"wb")) ) {
-            ptr  = strstr(data,".mesh");
-            *ptr = '\0';
-            strcat(data,".mesh");
-            if( !(inm = fopen(data,"w")) ) {
-                fprintf(stderr,"  ** UNABLE TO OPEN %s.\n",data);
-                return(0);
-            }
-        } else {
-            bin = 1;
-        }
-    }
-    else {
-        ptr = strstr(data,".meshb");
-        if( ptr ) bin = 1;
-        if( !(inm = fopen(data,"w")) ) {
-            fprintf(stderr,"  ** UNABLE TO OPEN %s.\n",data);
-            return(0);
-        }
-    }
-    fprintf(stdout,"  %%%% %s OPENED\n",data);
-    /*entete fichier*/
-    if(!bin) {
-        strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-        fprintf(inm,"%s",chaine);
-        strcpy(&chaine[0],"\n\nDimension 3\n");
-        fprintf(inm,"%s ",chaine);
-    } else {
-        binch = 1; //MeshVersionFormatted
-        fwrite(&binch,sw,1,inm);
-        binch = 2; //version
-        fwrite(&binch,sw,1,inm);
-        binch = 3; //Dimension
-        fwrite(&binch,sw,1,inm);
-        bpos = 20; //Pos
-        fwrite(&bpos,sw,1,inm);
-        binch = 3;
-        fwrite(&binch,sw,1,inm);
+    if ( !(inm = _MMG5_openMeshOut(mesh,data,&bin)) )  return(0);
 
-    }
     /* vertices */
     np = nc = nre = 0;
     for (k=1; k<=mesh->np; k++) {
@@ -1341,292 +1675,50 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
             if ( ppt->tag & MG_REQ )  nre++;
         }
     }
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nVertices\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",np);
-    } else {
-        binch = 4; //Vertices
-        fwrite(&binch,sw,1,inm);
-        bpos += 12+(1+3*mesh->ver)*4*np; //NullPos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&np,sw,1,inm);
-    }
-    for (k=1; k<=mesh->np; k++) {
-        ppt = &mesh->point[k];
-        if ( MG_VOK(ppt) ) {
-            if(!bin) {
-                fprintf(inm,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
-            } else {
-                fwrite((unsigned char*)&ppt->c[0],sd,1,inm);
-                fwrite((unsigned char*)&ppt->c[1],sd,1,inm);
-                fwrite((unsigned char*)&ppt->c[2],sd,1,inm);
-                ppt->ref = abs(ppt->ref);
-                fwrite((unsigned char*)&ppt->ref,sw,1,inm);
-            }
-        }
+    if ( !_MMG5_wopen(mesh,&w,inm,bin,_MMG5_wsizMesh(np,mesh->nt,mesh->na,mesh->ne),
+                      MG_MAX(3LL*np,mesh->ne)) ) {
+        fclose(inm);
+        return(0);
     }
+    _MMG5_wsection(mesh,&w,&_MMG5_kwVer,1,mesh->np,0);
 
     /* corners+required */
-    if ( nc ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nCorners\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nc);
-        } else {
-            binch = 13; //
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+4*nc; //NullPos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nc,sw,1,inm);
-        }
+    w.tag = MG_CRN;
+    _MMG5_wsection(mesh,&w,&_MMG5_kwCrn,1,mesh->np,0);
+    w.tag = MG_REQ;
+    _MMG5_wsection(mesh,&w,&_MMG5_kwVerReq,1,mesh->np,0);
 
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( MG_VOK(ppt) && ppt->tag & MG_CRN ) {
-                if(!bin) {
-                    fprintf(inm,"%d \n",ppt->tmp);
-                } else {
-                    fwrite(&ppt->tmp,sw,1,inm);
-                }
-            }
-        }
-    }
-    if ( nre ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nRequiredVertices\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nre);
-        } else {
-            binch = 15; //
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+4*nre; //NullPos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nre,sw,1,inm);
-        }
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( MG_VOK(ppt) && ppt->tag & MG_REQ ) {
-                if(!bin) {
-                    fprintf(inm,"%d \n",ppt->tmp);
-                } else {
-                    fwrite(&ppt->tmp,sw,1,inm);
-                }
-            }
-        }
-    }
     /* boundary mesh */
     /* tria + required tria */
-    ntreq = 0;
     if ( mesh->nt ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nTriangles\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d \n",mesh->nt);
-        } else {
-            binch = 6; //Triangles
-            fwrite(&binch,sw,1,inm);
-            bpos += 12+16*mesh->nt; //Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&mesh->nt,sw,1,inm);
-        }
-        for (k=1; k<=mesh->nt; k++) {
-            ptt = &mesh->tria[k];
-            if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ )  ntreq++;
-            if(!bin) {
-                fprintf(inm,"%d %d %d %d\n",mesh->point[ptt->v[0]].tmp,mesh->point[ptt->v[1]].tmp
-                        ,mesh->point[ptt->v[2]].tmp,ptt->ref);
-            } else {
-                fwrite(&mesh->point[ptt->v[0]].tmp,sw,1,inm);
-                fwrite(&mesh->point[ptt->v[1]].tmp,sw,1,inm);
-                fwrite(&mesh->point[ptt->v[2]].tmp,sw,1,inm);
-                fwrite(&ptt->ref,sw,1,inm);
-            }
-        }
-        if ( ntreq ) {
-            if(!bin) {
-                strcpy(&chaine[0],"\n\nRequiredTriangles\n");
-                fprintf(inm,"%s",chaine);
-                fprintf(inm,"%d \n",ntreq);
-            } else {
-                binch = 17; //ReqTriangles
-                fwrite(&binch,sw,1,inm);
-                bpos += 12+4*ntreq; //Pos
-                fwrite(&bpos,sw,1,inm);
-                fwrite(&ntreq,sw,1,inm);
-            }
-            for (k=0; k<=mesh->nt; k++) {
-                ptt = &mesh->tria[k];
-                if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ ) {
-                    if(!bin) {
-                        fprintf(inm,"%d \n",k);
-                    } else {
-                        fwrite(&k,sw,1,inm);
-                    }
-                }
-            }
-        }
+        _MMG5_wsection(mesh,&w,&_MMG5_kwTri,1,mesh->nt,0);
+        _MMG5_wsection(mesh,&w,&_MMG5_kwTriReq,1,mesh->nt,0);
     }
 
-    nr = nedreq = 0;
+    /* edges + ridges + required edges */
+    nr = 0;
     if ( mesh->na ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nEdges\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",mesh->na);
-        } else {
-            binch = 5; //Edges
-            fwrite(&binch,sw,1,inm);
-            bpos += 12 + 3*4*mesh->na;//Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&mesh->na,sw,1,inm);
-        }
-        for (k=1; k<=mesh->na; k++) {
-            if(!bin) {
-                fprintf(inm,"%d %d %d \n",mesh->point[mesh->edge[k].a].tmp,
-                        mesh->point[mesh->edge[k].b].tmp,mesh->edge[k].ref);
-            } else {
-                fwrite(&mesh->point[mesh->edge[k].a].tmp,sw,1,inm);
-                fwrite(&mesh->point[mesh->edge[k].b].tmp,sw,1,inm);
-                fwrite(&mesh->edge[k].ref,sw,1,inm);
-            }
-            if ( mesh->edge[k].tag & MG_GEO ) nr++;
-            if ( mesh->edge[k].tag & MG_REQ ) nedreq++;
-        }
-
-        if ( nr ) {
-            if(!bin) {
-                strcpy(&chaine[0],"\n\nRidges\n");
-                fprintf(inm,"%s",chaine);
-                fprintf(inm,"%d\n",nr);
-            } else {
-                binch = 14; //Ridges
-                fwrite(&binch,sw,1,inm);
-                bpos += 12 + 4*nr;//Pos
-                fwrite(&bpos,sw,1,inm);
-                fwrite(&nr,sw,1,inm);
-            }
-            na = 0;
-            for (k=1; k<=mesh->na; k++) {
-                na++;
-                if ( mesh->edge[k].tag & MG_GEO ) {
-                    if(!bin) {
-                        fprintf(inm,"%d \n",na);
-                    } else {
-                        fwrite(&na,sw,1,inm);
-                    }
-                }
-            }
-        }
-        if ( nedreq ) {
-            if(!bin) {
-                strcpy(&chaine[0],"\n\nRequiredEdges\n");
-                fprintf(inm,"%s",chaine);
-                fprintf(inm,"%d\n",nedreq);
-            } else {
-                binch = 16; //RequiredEdges
-                fwrite(&binch,sw,1,inm);
-                bpos += 12 + 4*nedreq;//Pos
-                fwrite(&bpos,sw,1,inm);
-                fwrite(&nedreq,sw,1,inm);
-            }
-            na = 0;
-            for (k=1; k<=mesh->na; k++) {
-                na++;
-                if (  mesh->edge[k].tag & MG_REQ ) {
-                    if(!bin) {
-                        fprintf(inm,"%d \n",na);
-                    } else {
-                        fwrite(&na,sw,1,inm);
-                    }
-                }
-            }
-        }
+        _MMG5_wsection(mesh,&w,&_MMG5_kwEdg,1,mesh->na,0);
+        w.tag = MG_GEO;
+        nr = _MMG5_wsection(mesh,&w,&_MMG5_kwRid,1,mesh->na,0);
+        w.tag = MG_REQ;
+        _MMG5_wsection(mesh,&w,&_MMG5_kwEdgReq,1,mesh->na,0);
     }
 
     /* tetrahedra */
-    ne = nereq = 0;
-    for (k=1; k<=mesh->ne; k++) {
-        pt = &mesh->tetra[k];
-        if ( !MG_EOK(pt) ) continue;
-        ne++;
-        if ( pt->tag & MG_REQ ){
-            nereq++;
-        }
-    }
-
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nTetrahedra\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",ne);
-    } else {
-        binch = 8; //Tetra
-        fwrite(&binch,sw,1,inm);
-        bpos += 12 + 20*ne;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite((unsigned char*)&ne,sw,1,inm);
-    }
-    for (k=1; k<=mesh->ne; k++) {
-        pt = &mesh->tetra[k];
-        if ( MG_EOK(pt) ) {
-            if(!bin) {
-                fprintf(inm,"%d %d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
-                        ,mesh->point[pt->v[2]].tmp,mesh->point[pt->v[3]].tmp,pt->ref);
-            } else {
-                fwrite(&mesh->point[pt->v[0]].tmp,sw,1,inm);
-                fwrite(&mesh->point[pt->v[1]].tmp,sw,1,inm);
-                fwrite(&mesh->point[pt->v[2]].tmp,sw,1,inm);
-                fwrite(&mesh->point[pt->v[3]].tmp,sw,1,inm);
-                fwrite(&pt->ref,sw,1,inm);
-            }
-        }
-    }
-
-    if ( nereq ) {
-        if(!bin) {
-            strcpy(&chaine[0],"\n\nRequiredTetrahedra\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nereq);
-        } else {
-            binch = 12; //RequiredTetra
-            fwrite(&binch,sw,1,inm);
-            bpos += 12 + 4*nereq;//Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nereq,sw,1,inm);
-        }
-        ne = 0;
-        for (k=1; k<=mesh->ne; k++) {
-            pt = &mesh->tetra[k];
-            if ( !MG_EOK(pt) ) continue;
-            ne++;
-            if ( pt->tag & MG_REQ ) {
-                if(!bin) {
-                    fprintf(inm,"%d \n",ne);
-                } else {
-                    fwrite(&ne,sw,1,inm);
-                }
-            }
-        }
-    }
+    _MMG5_wsection(mesh,&w,&_MMG5_kwTet,1,mesh->ne,0);
+    _MMG5_wsection(mesh,&w,&_MMG5_kwTetReq,1,mesh->ne,0);
 
     if ( mesh->info.imprim ) {
-        fprintf(stdout,"     NUMBER OF VERTICES   %8d   CORNERS %8d\n",np,nc+nre);
+        fprintf(stdout,"     NUMBER OF VERTICES   %8" MMG5_PRId "   CORNERS %8" MMG5_PRId "\n",np,nc+nre);
         if ( mesh->na )
-            fprintf(stdout,"     NUMBER OF EDGES      %8d   RIDGES  %8d\n",mesh->na,nr);
+            fprintf(stdout,"     NUMBER OF EDGES      %8" MMG5_PRId "   RIDGES  %8" MMG5_PRId "\n",mesh->na,nr);
         if ( mesh->nt )
-            fprintf(stdout,"     NUMBER OF TRIANGLES  %8d\n",mesh->nt);
-        fprintf(stdout,"     NUMBER OF ELEMENTS   %8d\n",mesh->ne);
+            fprintf(stdout,"     NUMBER OF TRIANGLES  %8" MMG5_PRId "\n",mesh->nt);
+        fprintf(stdout,"     NUMBER OF ELEMENTS   %8" MMG5_PRId "\n",mesh->ne);
     }
     /*fin fichier*/
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nEnd\n");
-        fprintf(inm,"%s",chaine);
-    } else {
-        binch = 54; //End
-        fwrite(&binch,sw,1,inm);
-    }
-    fclose(inm);
-    return(1);
+    return(_MMG5_wclose(mesh,&w));
 }
 
 /**
@@ -1638,14 +1730,29 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
  *
  */
 int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
+    return(_MMG5_loadMet(mesh,met,1));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param fast 1 to read ASCII files with \ref _MMG5_loadMetAscii, 0 to
+ * read them with the stdio functions.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Load metric field.
+ *
+ */
+int _MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met,int fast) {
     FILE       *inm;
     float       fbuf[6];
     double      dbuf[6];
     int         binch,bdim,iswp;
-    int         k,bin,bpos;
+    MMG5_int    k,iadr;
+    int         i,bin,bpos,mapped;
     long        posnp;
-    char        *ptr,data[128],chaine[128];
-    //  int         i;
+    size_t      len;
+    char        *ptr,*buf,data[128],chaine[128];
 
     if ( !met->namein )  return(0);
     posnp = 0;
@@ -1678,6 +1785,12 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
     }
     fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+    if ( fast && !bin && (buf = _MMG5_mapFile(inm,&len,&mapped)) ) {
+        fclose(inm);
+        k = _MMG5_loadMetAscii(mesh,met,buf,len);
+        _MMG5_unmapFile(buf,len,mapped);
+        return((int)k);
+    }
 
     /* read solution or metric */
     if(!bin) {
@@ -1691,7 +1804,7 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
                 }
                 continue;
             } else if(!strncmp(chaine,"SolAtVertices",strlen("SolAtVertices"))) {
-                fscanf(inm,"%d",&met->np);
+                fscanf(inm,"%" MMG5_SCNd,&met->np);
                 fscanf(inm,"%d",&met->type);
                 if(met->type!=1) {
                     fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",met->type);
@@ -1728,8 +1841,7 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
             } else if(binch==62) {  //SolAtVertices
                 fread(&binch,sw,1,inm); //NulPos
                 if(iswp) binch=_MMG5_swapbin(binch);
-                fread(&met->np,sw,1,inm);
-                if(iswp) met->np=_MMG5_swapbin(met->np);
+                _MMG5_freadi(inm,iswp,&met->np);
                 fread(&met->type,sw,1,inm); //nb sol
                 if(iswp) met->type=_MMG5_swapbin(met->type);
                 if(met->type!=1) {
@@ -1753,9 +1865,12 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
         fprintf(stdout,"  ** MISSING DATA. No solution.\n");
         return(1);
     }
-    if(met->size!=1) {
-        fprintf(stdout,"  ** DATA ANISO IGNORED %d \n",met->size);
+    /* type of the solution: 1 for a scalar, 3 for a symmetric tensor */
+    if ( met->size == 3 )
         met->size = 6;
+    else if ( met->size != 1 ) {
+        fprintf(stdout,"  ** DATA TYPE IGNORED %d \n",met->size);
+        met->size = 1;
         return(-1);
     }
 
@@ -1800,27 +1915,39 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
             }
         }
     }
-    /* anisotropic metric */
-    /*else {
-      if ( met->ver == GmfFloat ) {
-      for (k=1; k<=met->np; k++) {
-      GmfGetLin(inm,GmfSolAtVertices,fbuf);
-      tmpf    = fbuf[2];
-      fbuf[2] = fbuf[3];
-      fbuf[3] = tmpf;
-      for (i=0; i<6; i++)  met->m[6*k+1+i] = fbuf[i];
-      }
-      }
-      else {
-      for (k=1; k<=met->np; k++) {
-      GmfGetLin(inm,GmfSolAtVertices,dbuf);
-      tmpd    = dbuf[2];
-      dbuf[2] = dbuf[3];
-      dbuf[3] = tmpd;
-      for (i=0; i<met->size; i++)  met->m[6*k+1+i] = dbuf[i];
-      }
-      }
-      }*/
+    /* anisotropic metric (m11 m12 m22 m13 m23 m33 in the file) */
+    else {
+        for (k=1; k<=met->np; k++) {
+            iadr = (k-1)*met->size + 1;
+            if ( met->ver == 1 ) {
+                for (i=0; i<6; i++) {
+                    if(!bin){
+                        fscanf(inm,"%f",&fbuf[i]);
+                    } else {
+                        fread(&fbuf[i],sw,1,inm);
+                        if(iswp) fbuf[i]=_MMG5_swapf(fbuf[i]);
+                    }
+                    dbuf[i] = fbuf[i];
+                }
+            }
+            else {
+                for (i=0; i<6; i++) {
+                    if(!bin){
+                        fscanf(inm,"%lf",&dbuf[i]);
+                    } else {
+                        fread(&dbuf[i],sd,1,inm);
+                        if(iswp) dbuf[i]=_MMG5_swapd(dbuf[i]);
+                    }
+                }
+            }
+            met->m[iadr]   = dbuf[0];
+            met->m[iadr+1] = dbuf[1];
+            met->m[iadr+2] = dbuf[3];
+            met->m[iadr+3] = dbuf[2];
+            met->m[iadr+4] = dbuf[4];
+            met->m[iadr+5] = dbuf[5];
+        }
+    }
     met->npi = met->np;
     fclose(inm);
     return(1);
@@ -1836,13 +1963,12 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
  */
 int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
     FILE*        inm;
-    MMG5_pPoint  ppt;
-    char        *ptr,data[128],chaine[128];
-    int          binch,bpos,bin,np,k,typ;
+    _MMG5_wfile  w;
+    char        *ptr,data[128];
+    int          typ;
 
     if ( !met->m )  return(-1);
     met->ver = 2;
-    bin = 0;
     strcpy(data,met->nameout);
     ptr = strstr(data,".mesh");
     if ( ptr )  *ptr = '\0';
@@ -1855,30 +1981,9 @@ int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
     fprintf(stdout,"  %%%% %s OPENED\n",data);
 
     /*entete fichier*/
-    binch=bpos=0;
-    if(!bin) {
-        strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-        fprintf(inm,"%s",chaine);
-        strcpy(&chaine[0],"\n\nDimension 3\n");
-        fprintf(inm,"%s ",chaine);
-    } else {
-        binch = 1; //MeshVersionFormatted
-        fwrite(&binch,sw,1,inm);
-        binch = 2; //version
-        fwrite(&binch,sw,1,inm);
-        binch = 3; //Dimension
-        fwrite(&binch,sw,1,inm);
-        bpos = 20; //Pos
-        fwrite(&bpos,sw,1,inm);
-        binch = 3;
-        fwrite(&binch,sw,1,inm);
-
-    }
-
-    np = 0;
-    for (k=1; k<=mesh->np; k++) {
-        ppt = &mesh->point[k];
-        if ( MG_VOK(ppt) )  np++;
+    if ( !_MMG5_wopen(mesh,&w,inm,0,0,0) ) {
+        fclose(inm);
+        return(0);
     }
 
     if(met->size==1) {
@@ -1887,60 +1992,10 @@ int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
         typ = 3;
     }
 
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nSolAtVertices\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",np);
-        fprintf(inm,"%d %d\n",1,typ);
-    } else {
-        binch = 62; //Vertices
-        fwrite(&binch,sw,1,inm);
-        bpos += 20+(met->size*met->ver)*4*np; //Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&np,sw,1,inm);
-        binch = 1; //nb sol
-        fwrite(&binch,sw,1,inm);
-        binch = typ; //typ sol
-        fwrite(&binch,sw,1,inm);
-    }
+    /* write metric */
+    w.data = met;
+    _MMG5_wsection(mesh,&w,met->size==1 ? &_MMG5_kwSol : &_MMG5_kwSolAni,1,mesh->np,typ);
 
-    /* write isotropic metric */
-    if ( met->size == 1 ) {
-        for (k=1; k<=mesh->np; k++) {
-            ppt = &mesh->point[k];
-            if ( MG_VOK(ppt) ) {
-                if(!bin) {
-                    fprintf(inm,"%.15lg \n ",met->m[k]);
-                } else {
-                    fwrite((unsigned char*)&met->m[k],sd,1,inm);
-                }
-            }
-        }
-    }
-    /* write anisotropic metric */
-    /*else {
-      typtab[0] = 3;
-      nbm = 1;
-      GmfSetKwd(outm,GmfSolAtVertices,np,nbm,typtab);
-      for (k=1; k<=mesh->np; k++) {
-      ppt = &mesh->point[k];
-      if ( MG_VOK(ppt) ) {
-      for (i=0; i<met->size; i++)  dbuf[i] = met->m[met->size*(k)+1+i];
-      tmp = dbuf[2];
-      dbuf[2] = dbuf[3];
-      dbuf[3] = tmp;
-      GmfSetLin(outm,GmfSolAtVertices,dbuf);
-      }
-      }
-      }*/
     /*fin fichier*/
-    if(!bin) {
-        strcpy(&chaine[0],"\n\nEnd\n");
-        fprintf(inm,"%s",chaine);
-    } else {
-        binch = 54; //End
-        fwrite(&binch,sw,1,inm);
-    }
-    fclose(inm);
-    return(1);
+    return(_MMG5_wclose(mesh,&w));
 }
@@ -0,0 +1,808 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/inout_ascii.c
+ * \brief Fast readers for the ASCII mesh and solution files.
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The file is mapped in memory (see \ref _MMG5_mapFile) and cut into
+ * chunks on line boundaries. A first parallel pass counts the tokens of
+ * each chunk and locates the keywords, the sections are then identified
+ * sequentially from the keywords and a second parallel pass converts the
+ * tokens of each chunk into the mesh arrays with a hand-written number
+ * scanner. Comments (from '#' to the end of the line) are skipped. The
+ * chunks are processed concurrently with the \a USE_OPENMP flag.
+ *
+ */
+
+#include "mmg3d.h"
+#include <stdint.h>
+
+#if (defined(__APPLE__) && defined(__MACH__)) || defined(__unix__) || defined(__unix) || defined(unix)
+#define _MMG5_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/** Number of chunks per thread */
+#define _MMG5_ACHK_THR 8
+/** Minimal size of a chunk (in bytes) */
+#define _MMG5_ACHK_MIN (1<<20)
+
+/* type of the sections */
+#define _MMG5_ASEC_VER 0 /**< Vertices */
+#define _MMG5_ASEC_TRI 1 /**< Triangles */
+#define _MMG5_ASEC_TET 2 /**< Tetrahedra */
+#define _MMG5_ASEC_EDG 3 /**< Edges */
+#define _MMG5_ASEC_LST 4 /**< list of indices (required entities, corners...) */
+#define _MMG5_ASEC_SOL 5 /**< SolAtVertices */
+
+#define _MMG5_ISSPC(c) ((c)==' ' || (c)=='\n' || (c)=='\t' || (c)=='\r' \
+                        || (c)=='\v' || (c)=='\f')
+
+/** Keyword (token beginning with a letter) found by the first pass */
+typedef struct {
+    int64_t     tok; /*!< index of the token (in the chunk, then in the file) */
+    const char *pos; /*!< address of the token */
+} _MMG5_akw;
+
+/** Chunk of the file, beginning at a line start */
+typedef struct {
+    const char *beg,*end; /*!< range of the chunk */
+    int64_t     tok0;     /*!< index of the first token of the chunk */
+    int64_t     ntok;     /*!< number of tokens of the chunk */
+    int         nkw,kwmax;
+    _MMG5_akw  *kw;       /*!< keywords of the chunk */
+} _MMG5_achunk;
+
+/** Data section: tokens beg to end-1 are stored in records of T values */
+typedef struct {
+    int64_t beg,end;
+    int     typ,T;
+    int     lid;  /*!< list index of the _MMG5_ASEC_LST sections */
+    MMG5_int *lst; /*!< destination of the _MMG5_ASEC_LST sections */
+} _MMG5_asec;
+
+/**
+ * \param inm pointer toward the opened file.
+ * \param len pointer toward the file size.
+ * \param mapped pointer toward the flag saying if the file is mapped.
+ * \return the file content, NULL if failed.
+ *
+ * Map the file in memory, or read it in a single call if it can not be
+ * mapped. The content is always followed by a nul byte (the mapping is
+ * used only if the file does not end on a page boundary). On failure, the
+ * file is rewound to be read with the stdio functions.
+ *
+ */
+char *_MMG5_mapFile(FILE *inm,size_t *len,int *mapped) {
+    char        *buf;
+    long         siz;
+#ifdef _MMG5_MMAP
+    struct stat  st;
+    long         pag;
+
+    *mapped = 0;
+    if ( !fstat(fileno(inm),&st) && S_ISREG(st.st_mode) && st.st_size > 0 ) {
+        *len = (size_t)st.st_size;
+        pag  = sysconf(_SC_PAGESIZE);
+        if ( pag > 0 && *len % pag ) {
+            buf = mmap(NULL,*len,PROT_READ,MAP_PRIVATE,fileno(inm),0);
+            if ( buf != MAP_FAILED ) {
+#ifdef MADV_SEQUENTIAL
+                madvise(buf,*len,MADV_SEQUENTIAL);
+#endif
+                *mapped = 1;
+                return(buf);
+            }
+        }
+    }
+#else
+    *mapped = 0;
+#endif
+
+    buf = NULL;
+    if ( !fseek(inm,0,SEEK_END) && (siz = ftell(inm)) > 0 ) {
+        *len = (size_t)siz;
+        rewind(inm);
+        buf = (char*)malloc(*len+1);
+        if ( buf && fread(buf,1,*len,inm) != *len )
+            _MMG5_SAFE_FREE(buf);
+        if ( buf )  buf[*len] = '\0';
+    }
+    if ( !buf )  rewind(inm);
+    return(buf);
+}
+
+/**
+ * \param buf file content given by \ref _MMG5_mapFile.
+ * \param len file size.
+ * \param mapped 1 if the file is mapped.
+ *
+ * Release the file content.
+ *
+ */
+void _MMG5_unmapFile(char *buf,size_t len,int mapped) {
+#ifdef _MMG5_MMAP
+    if ( mapped ) {
+        munmap(buf,len);
+        return;
+    }
+#endif
+    free(buf);
+}
+
+/** Skip the blanks and the comments. */
+static inline const char *_MMG5_askip(const char *p,const char *end) {
+    while ( p < end ) {
+        if ( _MMG5_ISSPC(*p) )
+            p++;
+        else if ( *p == '#' ) {
+            while ( p < end && *p != '\n' )  p++;
+        }
+        else
+            break;
+    }
+    return(p);
+}
+
+/** Return the end of the token beginning at \a p. */
+static inline const char *_MMG5_atokend(const char *p,const char *end) {
+    while ( p < end && !_MMG5_ISSPC(*p) )  p++;
+    return(p);
+}
+
+/** Maximal length of a token given to the real scanners of the C library */
+#define _MMG5_ATOKLEN  128
+
+/**
+ * \param p token.
+ * \param e end of the token.
+ * \param tok buffer of \ref _MMG5_ATOKLEN characters.
+ * \return \a tok.
+ *
+ * Copy the token in \a tok and terminate it: the file buffer may be a
+ * memory mapping without terminating character, thus a token at the end of
+ * the file cannot be given directly to strtod/strtof.
+ *
+ */
+static inline char *_MMG5_atokcpy(const char *p,const char *e,char *tok) {
+    size_t n;
+
+    n = MG_MIN((size_t)(e-p),(size_t)(_MMG5_ATOKLEN-1));
+    memcpy(tok,p,n);
+    tok[n] = '\0';
+    return(tok);
+}
+
+/**
+ * \param p token.
+ * \param e end of the token.
+ * \return the integer value of the token.
+ *
+ * Integer scanner.
+ *
+ */
+static inline MMG5_int _MMG5_atoi(const char *p,const char *e) {
+    MMG5_int v;
+    int      neg;
+
+    neg = 0;
+    if ( p < e && (*p == '-' || *p == '+') ) {
+        neg = (*p == '-');
+        p++;
+    }
+    v = 0;
+    while ( p < e && *p >= '0' && *p <= '9' )
+        v = 10*v + (*p++ - '0');
+
+    return(neg ? -v : v);
+}
+
+/**
+ * \param p token.
+ * \param e end of the token.
+ * \return the real value of the token.
+ *
+ * Real scanner. Values with at most 19 significant digits whose mantissa
+ * is exactly representable and with a decimal exponent in [-22,22] are
+ * computed with a single correctly rounded operation, giving the same
+ * value as strtod; other values are given to strtod.
+ *
+ */
+static inline double _MMG5_atod(const char *p,const char *e) {
+    static const double p10[23] = {
+        1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+        1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22 };
+    const char *q;
+    char        tok[_MMG5_ATOKLEN];
+    uint64_t    m;
+    double      d;
+    int         neg,eneg,nd,ex,ee,dig;
+
+    q   = p;
+    neg = 0;
+    if ( q < e && (*q == '-' || *q == '+') ) {
+        neg = (*q == '-');
+        q++;
+    }
+    m = 0;
+    nd = ex = dig = 0;
+    while ( q < e && *q >= '0' && *q <= '9' ) {
+        m = 10*m + (*q++ - '0');
+        if ( m )  nd++;
+        dig = 1;
+    }
+    if ( q < e && *q == '.' ) {
+        q++;
+        while ( q < e && *q >= '0' && *q <= '9' ) {
+            m = 10*m + (*q++ - '0');
+            if ( m )  nd++;
+            ex--;
+            dig = 1;
+        }
+    }
+    if ( q < e && (*q == 'e' || *q == 'E') ) {
+        q++;
+        eneg = 0;
+        if ( q < e && (*q == '-' || *q == '+') ) {
+            eneg = (*q == '-');
+            q++;
+        }
+        ee = 0;
+        while ( q < e && *q >= '0' && *q <= '9' ) {
+            if ( ee < 10000 )  ee = 10*ee + (*q - '0');
+            q++;
+        }
+        ex += eneg ? -ee : ee;
+    }
+
+    if ( !dig || q != e || nd > 19 || m > ((uint64_t)1<<53) || ex < -22 || ex > 22 )
+        return(strtod(_MMG5_atokcpy(p,e,tok),NULL));
+
+    d = (double)m;
+    d = ex < 0 ? d / p10[-ex] : d * p10[ex];
+    return(neg ? -d : d);
+}
+
+/**
+ * \param p token.
+ * \param e end of the token.
+ * \return the single precision value of the token.
+ *
+ * Real scanner for the files of version 1.
+ *
+ */
+static inline float _MMG5_atof(const char *p,const char *e) {
+    char tok[_MMG5_ATOKLEN];
+
+    return(strtof(_MMG5_atokcpy(p,e,tok),NULL));
+}
+
+/**
+ * \param ch pointer toward the chunk.
+ * \return 1 if success, 0 if fail.
+ *
+ * First pass: count the tokens of the chunk and store the keywords.
+ *
+ */
+static int _MMG5_acount(_MMG5_achunk *ch) {
+    const char *p;
+    _MMG5_akw  *tmp;
+    int64_t     n;
+
+    n = 0;
+    p = ch->beg;
+    while ( (p = _MMG5_askip(p,ch->end)) < ch->end ) {
+        if ( (*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z') ) {
+            if ( ch->nkw == ch->kwmax ) {
+                ch->kwmax = ch->kwmax ? 2*ch->kwmax : 16;
+                tmp = (_MMG5_akw*)realloc(ch->kw,ch->kwmax*sizeof(_MMG5_akw));
+                if ( !tmp )  return(0);
+                ch->kw = tmp;
+            }
+            ch->kw[ch->nkw].tok = n;
+            ch->kw[ch->nkw].pos = p;
+            ch->nkw++;
+        }
+        n++;
+        p = _MMG5_atokend(p,ch->end);
+    }
+    ch->ntok = n;
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure (for solution files).
+ * \param ch pointer toward the chunk.
+ * \param sec sections sorted by increasing token index.
+ * \param nsec number of sections.
+ *
+ * Second pass: convert the tokens of the chunk that belong to a section.
+ *
+ */
+static void _MMG5_aparse(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_achunk *ch,
+                         _MMG5_asec *sec,int nsec) {
+    _MMG5_asec  *s,*send;
+    MMG5_pPoint  ppt;
+    const char  *p,*q;
+    int64_t      g;
+    MMG5_int     r;
+    int          f;
+
+    send = sec + nsec;
+    g = ch->tok0;
+    for (s=sec; s<send && s->end<=g; s++) ;
+    if ( s == send )  return;
+    r = f = 0;
+    if ( g > s->beg ) {
+        r = (MMG5_int)((g - s->beg) / s->T);
+        f = (int)((g - s->beg) % s->T);
+    }
+
+    p = ch->beg;
+    while ( (p = _MMG5_askip(p,ch->end)) < ch->end ) {
+        q = _MMG5_atokend(p,ch->end);
+        if ( g >= s->beg ) {
+            switch ( s->typ ) {
+            case _MMG5_ASEC_VER:
+                ppt = &mesh->point[r+1];
+                if ( f < 3 )
+                    ppt->c[f] = mesh->ver < 2 ? (double)_MMG5_atof(p,q) : _MMG5_atod(p,q);
+                else {
+                    ppt->ref = (int)_MMG5_atoi(p,q);
+                    ppt->tag = MG_NUL;
+                    ppt->tmp = 0;
+                }
+                break;
+            case _MMG5_ASEC_TRI:
+                if ( f < 3 )
+                    mesh->tria[r+1].v[f] = _MMG5_atoi(p,q);
+                else
+                    mesh->tria[r+1].ref = (int)_MMG5_atoi(p,q);
+                break;
+            case _MMG5_ASEC_TET:
+                if ( f < 4 )
+                    mesh->tetra[r+1].v[f] = _MMG5_atoi(p,q);
+                else
+                    mesh->tetra[r+1].ref = (int)_MMG5_atoi(p,q);
+                break;
+            case _MMG5_ASEC_EDG:
+                if ( f == 0 )
+                    mesh->edge[r+1].a = _MMG5_atoi(p,q);
+                else if ( f == 1 )
+                    mesh->edge[r+1].b = _MMG5_atoi(p,q);
+                else
+                    mesh->edge[r+1].ref = (int)_MMG5_atoi(p,q);
+                break;
+            case _MMG5_ASEC_LST:
+                s->lst[r] = _MMG5_atoi(p,q);
+                break;
+            case _MMG5_ASEC_SOL:
+                met->m[s->T*r+f+1] = met->ver == 1 ? (double)_MMG5_atof(p,q) : _MMG5_atod(p,q);
+                break;
+            }
+            if ( ++f == s->T ) {
+                f = 0;
+                r++;
+            }
+            if ( g+1 == s->end ) {
+                if ( ++s == send )  return;
+                r = f = 0;
+            }
+        }
+        g++;
+        p = q;
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param buf file content.
+ * \param len file size.
+ * \param nchunk pointer toward the number of chunks.
+ * \param nkw pointer toward the number of keywords.
+ * \param kw pointer toward the keywords of the file (to free).
+ * \param ntok pointer toward the number of tokens of the file.
+ * \return the chunks of the file (to free), NULL if failed.
+ *
+ * Cut the file in chunks on line boundaries and run the first pass.
+ *
+ */
+static _MMG5_achunk *_MMG5_achunks(MMG5_pMesh mesh,const char *buf,size_t len,
+                                   int *nchunk,int *nkw,_MMG5_akw **kw,
+                                   int64_t *ntok) {
+    _MMG5_achunk *ch;
+    const char   *p,*end;
+    int           c,i,n,nthr,ier;
+
+    nthr = MG_MAX(1,mesh->info.threads);
+    n    = MG_MIN(_MMG5_ACHK_THR*nthr,(int)(len/_MMG5_ACHK_MIN)+1);
+    _MMG5_SAFE_CALLOC(ch,n,_MMG5_achunk);
+
+    end = buf + len;
+    p   = buf;
+    for (c=0; c<n; c++) {
+        ch[c].beg = p;
+        if ( c == n-1 )
+            p = end;
+        else {
+            p = MG_MAX(p,buf + (len/n)*(c+1));
+            p = memchr(p,'\n',end-p);
+            p = p ? p+1 : end;
+        }
+        ch[c].end = p;
+    }
+
+    ier = 1;
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,1) reduction(&&:ier)
+#endif
+    for (c=0; c<n; c++)
+        ier = _MMG5_acount(&ch[c]) && ier;
+
+    /* global token indices */
+    *nkw  = 0;
+    *ntok = 0;
+    for (c=0; c<n; c++) {
+        ch[c].tok0 = *ntok;
+        *ntok     += ch[c].ntok;
+        *nkw      += ch[c].nkw;
+    }
+    *kw = NULL;
+    if ( ier && *nkw ) {
+        *kw = (_MMG5_akw*)malloc(*nkw*sizeof(_MMG5_akw));
+        if ( !*kw )  ier = 0;
+    }
+    *nkw = 0;
+    for (c=0; c<n; c++) {
+        for (i=0; ier && i<ch[c].nkw; i++) {
+            (*kw)[*nkw].tok = ch[c].tok0 + ch[c].kw[i].tok;
+            (*kw)[*nkw].pos = ch[c].kw[i].pos;
+            (*nkw)++;
+        }
+        free(ch[c].kw);
+        ch[c].kw = NULL;
+    }
+    if ( !ier ) {
+        fprintf(stdout,"  ## Error: unable to allocate the keywords table.\n");
+        free(*kw);
+        _MMG5_SAFE_FREE(ch);
+        return(NULL);
+    }
+    *nchunk = n;
+    return(ch);
+}
+
+/**
+ * \param kw keyword.
+ * \param end end of the file.
+ * \param name keyword name.
+ * \return 1 if the token at \a kw is exactly \a name.
+ *
+ */
+static inline int _MMG5_akwis(const char *kw,const char *end,const char *name) {
+    size_t l;
+
+    l = strlen(name);
+    return( (size_t)(end-kw) >= l && !strncmp(kw,name,l) &&
+            (kw+l == end || _MMG5_ISSPC(kw[l])) );
+}
+
+/**
+ * \param p pointer toward the current position (moved after the token).
+ * \param end end of the file.
+ * \param val pointer toward the integer value.
+ * \return 1 if success, 0 if the file ends.
+ *
+ * Read the next integer token (keyword header).
+ *
+ */
+static int _MMG5_anexti(const char **p,const char *end,MMG5_int *val) {
+    const char *q;
+
+    *p = _MMG5_askip(*p,end);
+    if ( *p >= end )  return(0);
+    q    = _MMG5_atokend(*p,end);
+    *val = _MMG5_atoi(*p,q);
+    *p   = q;
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param buf file content (see \ref _MMG5_mapFile).
+ * \param len file size.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read ASCII mesh data.
+ *
+ */
+int _MMG5_loadMeshAscii(MMG5_pMesh mesh,const char *buf,size_t len) {
+    _MMG5_achunk *ch;
+    _MMG5_akw    *kw;
+    _MMG5_asec    sec[_MMG5_LST_NUM+4];
+    const char   *p,*end;
+    int64_t       ntok,last;
+    MMG5_int      *lst[_MMG5_LST_NUM],nlst[_MMG5_LST_NUM],n;
+    int           nchunk,nkw,nsec,i,k,l,typ,T,ier;
+    static const char *lname[_MMG5_LST_NUM] = {
+        "RequiredVertices","Corners","RequiredTriangles",
+        "RequiredEdges","Ridges","RequiredTetrahedra" };
+    static const char *ename[4] = { "Vertices","Triangles","Tetrahedra","Edges" };
+    static const int   eT[4]    = { 4,4,5,3 };
+#ifdef USE_OPENMP
+    int           nthr;
+#endif
+
+    end = buf + len;
+    ch  = _MMG5_achunks(mesh,buf,len,&nchunk,&nkw,&kw,&ntok);
+    if ( !ch )  return(0);
+
+    memset(lst,0,_MMG5_LST_NUM*sizeof(MMG5_int*));
+    memset(nlst,0,_MMG5_LST_NUM*sizeof(MMG5_int));
+    mesh->npi = mesh->nti = mesh->nei = mesh->nai = 0;
+    ier  = 0;
+    nsec = 0;
+    last = 0;
+
+    /* sections */
+    for (k=0; k<nkw; k++) {
+        p   = kw[k].pos;
+        typ = -1;
+        T   = 1;
+        l   = -1;
+        for (i=0; i<4; i++)
+            if ( _MMG5_akwis(p,end,ename[i]) ) {
+                typ = i;
+                T   = eT[i];
+            }
+        for (i=0; i<_MMG5_LST_NUM; i++)
+            if ( _MMG5_akwis(p,end,lname[i]) ) {
+                typ = _MMG5_ASEC_LST;
+                l   = i;
+            }
+        if ( typ < 0 && !_MMG5_akwis(p,end,"End")
+             && !_MMG5_akwis(p,end,"MeshVersionFormatted")
+             && !_MMG5_akwis(p,end,"Dimension") )
+            continue;
+
+        if ( kw[k].tok < last ) {
+            fprintf(stdout,"  ** BAD NUMBER OF ENTITIES BEFORE KEYWORD %.20s.\n",p);
+            goto free;
+        }
+        if ( _MMG5_akwis(p,end,"End") )  break;
+
+        p = _MMG5_atokend(p,end);
+        if ( !_MMG5_anexti(&p,end,&n) ) {
+            fprintf(stdout,"  ** UNEXPECTED END OF FILE.\n");
+            goto free;
+        }
+        last = kw[k].tok + 2;
+        if ( _MMG5_akwis(kw[k].pos,end,"MeshVersionFormatted") ) {
+            mesh->ver = (int)n;
+            continue;
+        }
+        if ( _MMG5_akwis(kw[k].pos,end,"Dimension") ) {
+            mesh->dim = (int)n;
+            if ( mesh->dim != 3 ) {
+                fprintf(stdout,"BAD DIMENSION : %d\n",mesh->dim);
+                goto free;
+            }
+            continue;
+        }
+        if ( n < 0 ) {
+            fprintf(stdout,"  ** BAD NUMBER OF ENTITIES: %" MMG5_PRId ".\n",n);
+            goto free;
+        }
+        last += (int64_t)n*T;
+
+        /* only the first occurrence of a section is read */
+        for (i=0; i<nsec; i++)
+            if ( sec[i].typ == typ && sec[i].lid == l )  break;
+        if ( i < nsec || !n )  continue;
+
+        sec[nsec].beg = kw[k].tok + 2;
+        sec[nsec].end = last;
+        sec[nsec].typ = typ;
+        sec[nsec].T   = T;
+        sec[nsec].lid = l;
+        sec[nsec].lst = NULL;
+        if ( typ == _MMG5_ASEC_LST )
+            nlst[l] = n;
+        else if ( typ == _MMG5_ASEC_VER )
+            mesh->npi = n;
+        else if ( typ == _MMG5_ASEC_TRI )
+            mesh->nti = n;
+        else if ( typ == _MMG5_ASEC_TET )
+            mesh->nei = n;
+        else
+            mesh->nai = n;
+        nsec++;
+    }
+    if ( last > ntok ) {
+        fprintf(stdout,"  ** UNEXPECTED END OF FILE.\n");
+        goto free;
+    }
+
+    if ( !mesh->npi || !mesh->nei ) {
+        fprintf(stdout,"  ** MISSING DATA.\n");
+        fprintf(stdout," Check that your mesh contains points and tetrahedra.\n");
+        fprintf(stdout," Exit program.\n");
+        goto free;
+    }
+
+    /* memory allocation */
+    mesh->np = mesh->npi;
+    mesh->nt = mesh->nti;
+    mesh->ne = mesh->nei;
+    mesh->na = mesh->nai;
+    if ( !_MMG5_zaldy(mesh) )  goto free;
+    if (mesh->npmax < mesh->np || mesh->ntmax < mesh->nt || mesh->nemax < mesh->ne)
+        goto free;
+
+    for (i=0; i<nsec; i++) {
+        if ( sec[i].typ != _MMG5_ASEC_LST )  continue;
+        l = sec[i].lid;
+        _MMG5_SAFE_MALLOC(lst[l],nlst[l],MMG5_int);
+        sec[i].lst = lst[l];
+    }
+
+    /* conversion */
+#ifdef USE_OPENMP
+    nthr = MG_MAX(1,mesh->info.threads);
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,1)
+#endif
+    for (k=0; k<nchunk; k++)
+        _MMG5_aparse(mesh,NULL,&ch[k],sec,nsec);
+
+    ier = _MMG5_loadMeshEnd(mesh,lst,nlst);
+
+free:
+    for (l=0; l<_MMG5_LST_NUM; l++)
+        if ( lst[l] )  _MMG5_SAFE_FREE(lst[l]);
+    free(kw);
+    _MMG5_SAFE_FREE(ch);
+    return(ier);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param buf file content (see \ref _MMG5_mapFile).
+ * \param len file size.
+ * \return -1 if the metric is ignored, 0 if failed, 1 otherwise (same
+ * values as \ref MMG5_loadMet).
+ *
+ * Read ASCII solution data.
+ *
+ */
+int _MMG5_loadMetAscii(MMG5_pMesh mesh,MMG5_pSol met,const char *buf,size_t len) {
+    _MMG5_achunk *ch;
+    _MMG5_akw    *kw;
+    _MMG5_asec    sec;
+    const char   *p,*end;
+    int64_t       ntok;
+    double        tmp;
+    MMG5_int      n,iadr;
+    int           nchunk,nkw,k,ier;
+#ifdef USE_OPENMP
+    int           nthr;
+#endif
+
+    end = buf + len;
+    ch  = _MMG5_achunks(mesh,buf,len,&nchunk,&nkw,&kw,&ntok);
+    if ( !ch )  return(0);
+
+    ier = 1;
+    sec.beg = sec.end = 0;
+    for (k=0; k<nkw; k++) {
+        p = kw[k].pos;
+        if ( _MMG5_akwis(p,end,"End") )  break;
+        if ( _MMG5_akwis(p,end,"Dimension") ) {
+            p = _MMG5_atokend(p,end);
+            if ( !_MMG5_anexti(&p,end,&n) )  break;
+            met->dim = (int)n;
+            if ( met->dim != 3 ) {
+                fprintf(stdout,"BAD SOL DIMENSION : %d\n",met->dim);
+                goto free;
+            }
+        }
+        else if ( _MMG5_akwis(p,end,"SolAtVertices") ) {
+            p = _MMG5_atokend(p,end);
+            if ( !_MMG5_anexti(&p,end,&met->np) )  break;
+            if ( !_MMG5_anexti(&p,end,&n) )  break;
+            met->type = (int)n;
+            if ( met->type != 1 ) {
+                fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",met->type);
+                goto free;
+            }
+            if ( !_MMG5_anexti(&p,end,&n) )  break;
+            met->size = (int)n;
+            sec.beg = kw[k].tok + 4;
+            break;
+        }
+    }
+
+    if ( !met->np ) {
+        fprintf(stdout,"  ** MISSING DATA. No solution.\n");
+        goto free;
+    }
+    /* type of the solution: 1 for a scalar, 3 for a symmetric tensor */
+    if ( met->size == 3 )
+        met->size = 6;
+    else if ( met->size != 1 ) {
+        fprintf(stdout,"  ** DATA TYPE IGNORED %d \n",met->size);
+        met->size = 1;
+        ier = -1;
+        goto free;
+    }
+    sec.end = sec.beg + (int64_t)met->np*met->size;
+    sec.typ = _MMG5_ASEC_SOL;
+    sec.T   = met->size;
+    sec.lid = -1;
+    sec.lst = NULL;
+    if ( !sec.beg || sec.end > ntok ) {
+        fprintf(stdout,"  ** UNEXPECTED END OF FILE.\n");
+        ier = 0;
+        goto free;
+    }
+
+    met->npi = met->np;
+
+    /* mem alloc */
+    if ( met->m )  _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
+    met->npmax = mesh->npmax;
+
+    _MMG5_ADD_MEM(mesh,(met->size*met->npmax+1)*sizeof(double),"initial solution",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(met->m,met->size*met->npmax+1,double);
+
+    /* conversion */
+#ifdef USE_OPENMP
+    nthr = MG_MAX(1,mesh->info.threads);
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,1)
+#endif
+    for (k=0; k<nchunk; k++)
+        _MMG5_aparse(mesh,met,&ch[k],&sec,1);
+
+    /* m11 m12 m22 m13 m23 m33 in the file */
+    if ( met->size == 6 ) {
+        for (n=1; n<=met->np; n++) {
+            iadr = (n-1)*met->size + 1;
+            tmp            = met->m[iadr+2];
+            met->m[iadr+2] = met->m[iadr+3];
+            met->m[iadr+3] = tmp;
+        }
+    }
+
+free:
+    free(kw);
+    _MMG5_SAFE_FREE(ch);
+    return(ier);
+}
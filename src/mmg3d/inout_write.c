@@ -0,0 +1,328 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/inout_write.c
+ * \brief Buffered writers for the mesh and solution files.
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * A section is written by rounds: at each round, the entities are cut into
+ * one chunk of \ref _MMG5_WCHUNK entities per thread, each chunk is
+ * formatted in the buffer of its thread by the formatting function of the
+ * section (see \ref _MMG5_wfunc) and the buffers are written in order. The
+ * chunks are formatted concurrently with the \a USE_OPENMP flag. Binary
+ * files larger than 2 GB are written with the version 3 of the format
+ * (64 bits positions) and, with the \a MMG5_INT64 flag, meshes with more
+ * than 2^31 entities with the version 4 (64 bits integers).
+ *
+ */
+
+#include "mmg3d.h"
+#include <stdint.h>
+
+/** Number of entities formatted by a thread at each round */
+#define _MMG5_WCHUNK 16384
+/** Maximal size of a formatted entity (in bytes) */
+#define _MMG5_WMAXB  192
+
+/**
+ * \param w pointer toward the output file.
+ * \param buf data to write.
+ * \param siz size of the data.
+ *
+ * Write \a siz bytes and update the file position.
+ *
+ */
+static void _MMG5_wput(_MMG5_wfile *w,const void *buf,size_t siz) {
+    if ( !siz )  return;
+    if ( fwrite(buf,1,siz,w->out) != siz )  w->err = 1;
+    w->pos += siz;
+}
+
+/**
+ * \param w pointer toward the output file.
+ * \param out output buffer.
+ * \param val value to write.
+ * \param sep separator written after the value (ASCII only).
+ * \return the number of written bytes.
+ *
+ * Format an integer (\a w->isz bytes in binary).
+ *
+ */
+int _MMG5_wint(_MMG5_wfile *w,char *out,MMG5_int val,const char *sep) {
+    char               tmp[24];
+    unsigned long long u;
+    int                n,i;
+    int32_t            v32;
+    int64_t            v64;
+
+    if ( w->bin ) {
+        if ( w->isz == 8 ) {
+            v64 = val;
+            memcpy(out,&v64,8);
+            return(8);
+        }
+        v32 = (int32_t)val;
+        memcpy(out,&v32,4);
+        return(4);
+    }
+
+    n = 0;
+    if ( val < 0 ) {
+        out[n++] = '-';
+        u = -(unsigned long long)val;
+    }
+    else  u = val;
+    i = 0;
+    do {
+        tmp[i++] = '0' + u%10;
+        u /= 10;
+    } while ( u );
+    while ( i )  out[n++] = tmp[--i];
+    while ( *sep )  out[n++] = *sep++;
+    return(n);
+}
+
+/**
+ * \param w pointer toward the output file.
+ * \param out output buffer.
+ * \param val value to write.
+ * \param sep separator written after the value (ASCII only).
+ * \return the number of written bytes.
+ *
+ * Format a double (with 15 significant digits in ASCII).
+ *
+ */
+int _MMG5_wdbl(_MMG5_wfile *w,char *out,double val,const char *sep) {
+    int n;
+
+    if ( w->bin ) {
+        memcpy(out,&val,8);
+        return(8);
+    }
+    n = snprintf(out,32,"%.15lg",val);
+    while ( *sep )  out[n++] = *sep++;
+    return(n);
+}
+
+/**
+ * \param w pointer toward the output file.
+ * \param val value to write.
+ * \param siz number of bytes.
+ *
+ * Write an integer or a position of a binary file.
+ *
+ */
+static void _MMG5_wbin(_MMG5_wfile *w,long long val,int siz) {
+    int32_t v32;
+    int64_t v64;
+
+    if ( siz == 8 ) {
+        v64 = val;
+        _MMG5_wput(w,&v64,8);
+    }
+    else {
+        v32 = (int32_t)val;
+        _MMG5_wput(w,&v32,4);
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param w pointer toward the output file.
+ * \param out opened file.
+ * \param bin 1 if the file is binary.
+ * \param siz upper bound of the size of the binary file.
+ * \param nmax upper bound of the integers to write.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Allocate the formatting buffers and write the file header.
+ *
+ */
+int _MMG5_wopen(MMG5_pMesh mesh,_MMG5_wfile *w,FILE *out,int bin,long long siz,
+                long long nmax) {
+    char head[64];
+    int  k;
+
+    memset(w,0,sizeof(_MMG5_wfile));
+    w->out  = out;
+    w->bin  = bin;
+    w->ver  = ( bin && siz > INT_MAX ) ? 3 : 2;
+    w->isz  = 4;
+#ifdef MMG5_INT64
+    if ( nmax > INT_MAX ) {
+        w->ver = 4;
+        w->isz = 8;
+    }
+#endif
+    w->psz  = w->ver > 2 ? 8 : 4;
+    w->nthr = MG_MAX(1,mesh->info.threads);
+
+    w->buf = (char**)calloc(w->nthr,sizeof(char*));
+    if ( !w->buf )  return(0);
+    for (k=0; k<w->nthr; k++) {
+        w->buf[k] = (char*)malloc(_MMG5_WCHUNK*_MMG5_WMAXB);
+        if ( !w->buf[k] ) {
+            fprintf(stdout,"  ## Error: unable to allocate the output buffers.\n");
+            while ( k-- )  free(w->buf[k]);
+            free(w->buf);
+            return(0);
+        }
+    }
+
+    if ( !bin ) {
+        k = snprintf(head,64,"MeshVersionFormatted %d\n\n\nDimension 3\n ",w->ver);
+        _MMG5_wput(w,head,k);
+    }
+    else {
+        _MMG5_wbin(w,1,4);
+        _MMG5_wbin(w,w->ver,4);
+        _MMG5_wbin(w,3,4);
+        _MMG5_wbin(w,w->pos+w->psz+4,w->psz);
+        _MMG5_wbin(w,3,4);
+    }
+    return(!w->err);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param w pointer toward the output file.
+ * \return 0 if a write failed, 1 otherwise.
+ *
+ * Write the end of file, release the buffers and close the file.
+ *
+ */
+int _MMG5_wclose(MMG5_pMesh mesh,_MMG5_wfile *w) {
+    int k;
+
+    if ( !w->bin )
+        _MMG5_wput(w,"\n\nEnd\n",6);
+    else
+        _MMG5_wbin(w,54,4);
+
+    for (k=0; k<w->nthr; k++)
+        free(w->buf[k]);
+    free(w->buf);
+    if ( fclose(w->out) )  w->err = 1;
+    if ( w->err )
+        fprintf(stdout,"  ## Error: unable to write the output file.\n");
+    return(!w->err);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param w pointer toward the output file.
+ * \param kwd section to write.
+ * \param beg first entity.
+ * \param end last entity.
+ * \param typ type of the solution (solution files only).
+ * \return the number of written entities.
+ *
+ * Write the entities \a beg to \a end selected by the formatting function
+ * of the section.
+ *
+ */
+MMG5_int _MMG5_wsection(MMG5_pMesh mesh,_MMG5_wfile *w,const _MMG5_wkwd *kwd,
+                        MMG5_int beg,MMG5_int end,int typ) {
+    long long  nxt;
+    size_t    *len;
+    char       head[256];
+    MMG5_int  *cnt,*first,n,idx,b,e,i,k;
+    int        c,m,nc;
+
+    /* number of written entities */
+    n = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(w->nthr) reduction(+:n)
+#endif
+    for (k=beg; k<=end; k++)
+        if ( kwd->f(mesh,w,k,0,NULL) & _MMG5_WSEL )  n++;
+    if ( !n && kwd->opt )  return(0);
+
+    /* header */
+    if ( !w->bin ) {
+        m = snprintf(head,256,"\n\n%s\n%" MMG5_PRId "%s",kwd->name,n,kwd->nsep);
+        if ( kwd->nsol )  m += snprintf(head+m,256-m,"%d %d\n",kwd->nsol,typ);
+        _MMG5_wput(w,head,m);
+    }
+    else {
+        nxt = w->pos + 4 + w->psz + w->isz + (kwd->nsol ? 8 : 0)
+            + (long long)n*(kwd->nint*w->isz + 8*kwd->ndbl);
+        _MMG5_wbin(w,kwd->kw,4);
+        _MMG5_wbin(w,nxt,w->psz);
+        _MMG5_wbin(w,n,w->isz);
+        if ( kwd->nsol ) {
+            _MMG5_wbin(w,kwd->nsol,4);
+            _MMG5_wbin(w,typ,4);
+        }
+    }
+    if ( !n )  return(0);
+
+    nc = w->nthr;
+    _MMG5_SAFE_MALLOC(cnt,2*nc,MMG5_int);
+    _MMG5_SAFE_MALLOC(len,nc,size_t);
+    first = &cnt[nc];
+
+    idx = 0;
+    for (b=beg; b<=end; b+=nc*_MMG5_WCHUNK) {
+        /* numbered entities of each chunk */
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nc) private(k,e)
+#endif
+        for (c=0; c<nc; c++) {
+            cnt[c] = 0;
+            e = MG_MIN(end,b+(c+1)*_MMG5_WCHUNK-1);
+            for (k=b+c*_MMG5_WCHUNK; k<=e; k++)
+                if ( kwd->f(mesh,w,k,0,NULL) & _MMG5_WBASE )  cnt[c]++;
+        }
+        for (c=0; c<nc; c++) {
+            first[c] = idx;
+            idx += cnt[c];
+        }
+
+        /* formatting */
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nc) private(i,k,e,m)
+#endif
+        for (c=0; c<nc; c++) {
+            len[c] = 0;
+            i = first[c];
+            e = MG_MIN(end,b+(c+1)*_MMG5_WCHUNK-1);
+            for (k=b+c*_MMG5_WCHUNK; k<=e; k++) {
+                m = kwd->f(mesh,w,k,0,NULL);
+                if ( m & _MMG5_WBASE )  i++;
+                if ( m & _MMG5_WSEL )
+                    len[c] += kwd->f(mesh,w,k,i,w->buf[c]+len[c]);
+            }
+        }
+
+        for (c=0; c<nc; c++)
+            _MMG5_wput(w,w->buf[c],len[c]);
+    }
+
+    _MMG5_SAFE_FREE(cnt);
+    _MMG5_SAFE_FREE(len);
+    return(n);
+}
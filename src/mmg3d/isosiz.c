@@ -35,8 +35,6 @@
 
 #include "mmg3d.h"
 
-extern char   ddb;
-
 #define MAXLEN    1.0e9
 #define A64TH     0.015625
 #define A16TH     0.0625
@@ -45,7 +43,7 @@ extern char   ddb;
 
 /** Define isotropic size at regular point nump, whose surfacic ball is provided */
 static double
-_MMG5_defsizreg(MMG5_pMesh mesh,MMG5_pSol met,int nump,int *lists,
+_MMG5_defsizreg(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int nump,MMG5_int *lists,
           int ilists, double hausd) {
     MMG5_pTetra       pt;
     MMG5_pxTetra      pxt;
@@ -55,13 +53,14 @@ _MMG5_defsizreg(MMG5_pMesh mesh,MMG5_pSol met,int nump,int *lists,
     double       ux,uy,uz,det2d,h,isqhmin,isqhmax,ll,lmin,lmax,hnm,s;
     double       *n,*t,r[3][3],lispoi[3*_MMG5_LMAX+1],intm[3],b0[3],b1[3],c[3],tAA[6],tAb[3],d[3];
     double       kappa[2],vp[2][2];
-    int          k,na,nb,ntempa,ntempb,iel,ip0;
+    MMG5_int     na,nb,ntempa,ntempb,iel,ip0;
+    int          k;
     char         iface,i,j,i0;
 
     p0 = &mesh->point[nump];
 
     if ( !p0->xp || MG_EDG(p0->tag) || (p0->tag & MG_NOM) || (p0->tag & MG_REQ))  {
-        fprintf(stdout,"    ## Func. _MMG5_defsizreg : wrong point qualification : xp ? %d\n",p0->xp);
+        fprintf(stdout,"    ## Func. _MMG5_defsizreg : wrong point qualification : xp ? %" MMG5_PRId "\n",p0->xp);
         return(0);
     }
     isqhmin = 1.0 / (mesh->info.hmin*mesh->info.hmin);
@@ -395,7 +394,8 @@ int _MMG5_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pPoint    p0,p1;
     double    hp,v[3],b0[3],b1[3],b0p0[3],b1b0[3],p1b1[3],hausd;
     double    secder0[3],secder1[3],kappa,tau[3],gammasec[3],ntau2,intau,ps,lm,*n;
-    int       lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv,k,ip0,ip1,l;
+    MMG5_int  lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],k,ip0,ip1;
+    int       ilists,ilistv,l;
     char      i,j,ia,ised,i0,i1;
     MMG5_pPar      par;
 
@@ -552,12 +552,32 @@ int _MMG5_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param ip1 first extremity of the edge.
+ * \param ip2 second extremity of the edge.
+ * \param ip new point.
+ * \param s parameter of the new point along the edge (0 at \a ip1).
+ * \return 1.
+ *
+ * Linear interpolation of the size at the point \a ip of parameter \a s
+ * along the edge \f$[ip1,ip2]\f$.
+ *
+ */
+int _MMG5_intmet_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ip1,MMG5_int ip2,
+                     MMG5_int ip,double s) {
+    met->m[ip] = (1.0-s)*met->m[ip1] + s*met->m[ip2];
+    return(1);
+}
+
 /** Enforce mesh gradation by truncating size map */
 int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pTetra    pt;
     MMG5_pPoint    p0,p1;
     double    l,hn;
-    int       ip0,ip1,it,maxit,nu,nup,k;
+    MMG5_int  ip0,ip1,nu,nup,k;
+    int       it,maxit;
     char      i,j,ia,i0,i1;
 
     if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
@@ -566,7 +586,8 @@ int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
     for (k=1; k<=mesh->np; k++)
         mesh->point[k].flag = mesh->base;
 
-    it = nup = 0;
+    it  = 0;
+    nup = 0;
     maxit = 100;
     do {
         mesh->base++;
@@ -616,6 +637,6 @@ int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
     while( ++it < maxit && nu > 0 );
 
     if ( abs(mesh->info.imprim) > 3 )
-        fprintf(stdout,"     gradation: %7d updated, %d iter.\n",nup,it);
+        fprintf(stdout,"     gradation: %7" MMG5_PRId " updated, %d iter.\n",nup,it);
     return(1);
 }
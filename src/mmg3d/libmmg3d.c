@@ -42,14 +42,26 @@
 #include "shared_func.h"
 
 /**
- * Pack the mesh \a mesh and its associated metric \a met and return \a val.
+ * Release the entities frozen by a local remeshing (if any, \a local being
+ * the state of the local remeshing), pack the mesh \a mesh and its associated
+ * metric \a met and return \a val.
  */
-#define _MMG5_RETURN_AND_PACK(mesh,met,val)do         \
+#define _MMG5_RETURN_AND_PACK(mesh,met,local,val)do   \
     {                                           \
+        _MMG5_unfreeze(mesh,local);                  \
         MMG5_packMesh(mesh,met);                     \
         return(val);                            \
     }while(0)
 
+/**
+ * States of a local remeshing (see \ref MMG5_mmg3dlib_local): the tetra out of
+ * the region to remesh are marked by the \a MG_FRZ tag, which is kept by the
+ * packing of the tetra table, then frozen after the analysis of the mesh.
+ */
+#define _MMG5_LOC_NONE    0 /**< remeshing of the whole mesh */
+#define _MMG5_LOC_REGION  1 /**< tetra out of the region marked */
+#define _MMG5_LOC_FROZEN  2 /**< tetra out of the region frozen */
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -67,23 +79,23 @@ void MMG5_Free_all(MMG5_pMesh mesh,MMG5_pSol met
 }
 
 /**
- * \param mesh pointer toward the mesh structure (unused).
+ * \param mesh pointer toward the mesh structure.
  *
  * Set pointer for MMG5_saveMesh function.
  *
  */
 void MMG5_Set_saveFunc(MMG5_pMesh mesh) {
-    MMG5_saveMesh = _MMG5_saveLibraryMesh;
+    mesh->saveMesh = _MMG5_saveLibraryMesh;
 }
 
 /** Free adja, xtetra and xpoint tables */
 static inline
 void MMG5_Free_topoTables(MMG5_pMesh mesh) {
-    int k;
+    MMG5_int k;
 
     mesh->xp = 0;
     if ( mesh->adja )
-        _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+        _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(MMG5_int));
 
     _MMG5_freeXTets(mesh);
 
@@ -109,8 +121,9 @@ int MMG5_packMesh(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pTetra   pt,ptnew;
     MMG5_pPoint   ppt,pptnew;
     MMG5_hgeom   *ph;
-    int     np,nc,nr, k,ne,nbl,imet,imetnew,i;
-    int     iadr,iadrnew,iadrv,*adjav,*adja,*adjanew,voy;
+    MMG5_int np,nc,nr, k,ne,nbl,imet,imetnew;
+    MMG5_int iadr,iadrnew,iadrv,*adjav,*adja,*adjanew;
+    int      i,voy;
 
     /* compact vertices */
     np = nc = nr = 0;
@@ -270,12 +283,287 @@ int MMG5_packMesh(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_Free_topoTables(mesh);
 
     if ( mesh->info.imprim ) {
-        fprintf(stdout,"     NUMBER OF VERTICES   %8d   CORNERS %8d\n",mesh->np,nc);
+        fprintf(stdout,"     NUMBER OF VERTICES   %8" MMG5_PRId "   CORNERS %8" MMG5_PRId "\n",mesh->np,nc);
         if ( mesh->na )
-            fprintf(stdout,"     NUMBER OF EDGES      %8d   RIDGES  %8d\n",mesh->na,nr);
+            fprintf(stdout,"     NUMBER OF EDGES      %8" MMG5_PRId "   RIDGES  %8" MMG5_PRId "\n",mesh->na,nr);
         if ( mesh->nt )
-            fprintf(stdout,"     NUMBER OF TRIANGLES  %8d\n",mesh->nt);
-        fprintf(stdout,"     NUMBER OF ELEMENTS   %8d\n",mesh->ne);
+            fprintf(stdout,"     NUMBER OF TRIANGLES  %8" MMG5_PRId "\n",mesh->nt);
+        fprintf(stdout,"     NUMBER OF ELEMENTS   %8" MMG5_PRId "\n",mesh->ne);
+    }
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param eltab table of the elements to remesh.
+ * \param nlayers number of layers of neighbours added to the elements.
+ * \return the number of tetra to remesh.
+ *
+ * Mark with the \a MG_FRZ tag the tetra out of the region to remesh: the
+ * region is made of the tetra of \a eltab, then \a nlayers times of the tetra
+ * sharing a vertex with the region.
+ *
+ */
+static inline
+MMG5_int _MMG5_locRegion(MMG5_pMesh mesh,int *eltab,int nlayers) {
+    MMG5_pTetra   pt;
+    MMG5_int      k,nreg;
+    int           l,i;
+
+    nreg = 0;
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        if ( eltab[k] )  nreg++;
+        else  pt->tag |= MG_FRZ;
+    }
+
+    for (k=1; k<=mesh->np; k++)
+        mesh->point[k].flag = 0;
+
+    for (l=1; l<=nlayers; l++) {
+        for (k=1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            if ( !MG_EOK(pt) || (pt->tag & MG_FRZ) )  continue;
+            for (i=0; i<4; i++)
+                mesh->point[pt->v[i]].flag = l;
+        }
+        for (k=1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            if ( !MG_EOK(pt) || !(pt->tag & MG_FRZ) )  continue;
+            for (i=0; i<4; i++) {
+                if ( mesh->point[pt->v[i]].flag == l ) {
+                    pt->tag &= ~MG_FRZ;
+                    nreg++;
+                    break;
+                }
+            }
+        }
+    }
+    return(nreg);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward a tetra.
+ * \return 1 if the tetra is required and has no vertex of a tetra to remesh
+ * (vertices flagged with \a mesh->base), 0 otherwise.
+ *
+ */
+static inline
+int _MMG5_isFarFrz(MMG5_pMesh mesh,MMG5_pTetra pt) {
+    int   i;
+
+    if ( !MG_EOK(pt) || !(pt->tag & MG_REQ) )  return(0);
+    for (i=0; i<4; i++)
+        if ( mesh->point[pt->v[i]].flag == mesh->base )  return(0);
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return the number of frozen tetra.
+ *
+ * Freeze the tetra marked by \ref _MMG5_locRegion (the tag \a MG_FRZ is
+ * removed from the ones already required). The tetra without vertex in
+ * common with the tetra to remesh are never reached by the remeshing
+ * operators: they are moved to the beginning of the tetra table and skipped
+ * by the remeshing sweeps (see \a mesh->nefrz). The vertices and the boundary
+ * edges (in the whole shell of the edges, as for the required tetra in
+ * \ref _MMG5_bdryUpdate) of the other ones are set required; the \a MG_FRZ
+ * tag is added to the edges and to the \a tagdel field of the vertices whose
+ * required tag is set here.
+ *
+ */
+static inline
+MMG5_int _MMG5_freeze(MMG5_pMesh mesh) {
+    MMG5_pTetra   pt,pt1;
+    MMG5_pxTetra  pxt;
+    MMG5_pPoint   ppt;
+    MMG5_Tetra    tmp;
+    MMG5_int      *perm,*adja,*adja1,k,k1,nf,nfar,nhol,aux;
+    int           i,j,ia;
+
+    /* frozen tetra and vertices of the tetra to remesh */
+    ++mesh->base;
+    nf = nhol = 0;
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) ) {
+            nhol++;
+            continue;
+        }
+        if ( pt->tag & MG_FRZ ) {
+            nf++;
+            if ( pt->tag & MG_REQ )  pt->tag &= ~MG_FRZ;
+            else  pt->tag |= MG_REQ;
+        }
+        else if ( !(pt->tag & MG_REQ) ) {
+            for (i=0; i<4; i++)
+                mesh->point[pt->v[i]].flag = mesh->base;
+        }
+    }
+
+    /* vertices and boundary edges of the frozen tetra of the interface */
+    nfar = 0;
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( _MMG5_isFarFrz(mesh,pt) ) {
+            nfar++;
+            continue;
+        }
+        if ( !MG_EOK(pt) || !(pt->tag & MG_FRZ) )  continue;
+
+        for (i=0; i<4; i++) {
+            ppt = &mesh->point[pt->v[i]];
+            if ( ppt->tag & MG_REQ )  continue;
+            ppt->tag    |= MG_REQ;
+            ppt->tagdel |= MG_FRZ;
+        }
+
+        if ( !pt->xt )  continue;
+        pxt = &mesh->xtetra[pt->xt];
+        for (i=0; i<4; i++) {
+            if ( !(pxt->ftag[i] & MG_BDY) )  continue;
+            for (j=0; j<3; j++) {
+                ia = _MMG5_iarf[i][j];
+                if ( pxt->tag[ia] & MG_REQ )  continue;
+                _MMG5_settag(mesh,k,ia,MG_REQ|MG_FRZ,0);
+            }
+        }
+    }
+
+    /* move the far frozen tetra to the beginning of the table (the table is
+     * packed by the analysis, the nil chain is not updated here) */
+    mesh->nefrz = 0;
+    if ( !nfar || nhol )  return(nf);
+
+    _MMG5_ADD_MEM(mesh,(mesh->ne+1)*sizeof(MMG5_int),"frozen tetra",
+                  fprintf(stdout,"  ## Warning: no tetra skipped by the remeshing sweeps.\n");
+                  return(nf));
+    _MMG5_SAFE_CALLOC(perm,mesh->ne+1,MMG5_int);
+    for (k=1; k<=mesh->ne; k++)  perm[k] = k;
+
+    k  = 1;
+    k1 = mesh->ne;
+    while ( 1 ) {
+        while ( k < k1 && _MMG5_isFarFrz(mesh,&mesh->tetra[k]) )     k++;
+        while ( k < k1 && !_MMG5_isFarFrz(mesh,&mesh->tetra[k1]) )   k1--;
+        if ( k >= k1 )  break;
+
+        pt  = &mesh->tetra[k];
+        pt1 = &mesh->tetra[k1];
+        memcpy(&tmp,pt,sizeof(MMG5_Tetra));
+        memcpy(pt,pt1,sizeof(MMG5_Tetra));
+        memcpy(pt1,&tmp,sizeof(MMG5_Tetra));
+
+        adja  = &mesh->adja[4*(k-1)+1];
+        adja1 = &mesh->adja[4*(k1-1)+1];
+        for (i=0; i<4; i++) {
+            aux      = adja[i];
+            adja[i]  = adja1[i];
+            adja1[i] = aux;
+        }
+        perm[k]  = k1;
+        perm[k1] = k;
+        k++;
+        k1--;
+    }
+
+    for (k=1; k<=4*mesh->ne; k++) {
+        if ( !mesh->adja[k] )  continue;
+        mesh->adja[k] = 4*perm[mesh->adja[k]/4] + mesh->adja[k]%4;
+    }
+    mesh->nefrz = nfar;
+
+    _MMG5_DEL_MEM(mesh,perm,(mesh->ne+1)*sizeof(MMG5_int));
+    return(nf);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return the number of entities still tagged \a MG_FRZ.
+ *
+ * Check that the tags set by a local remeshing have all been removed.
+ *
+ */
+static inline
+MMG5_int _MMG5_chkfrz(MMG5_pMesh mesh) {
+    MMG5_pTetra   pt;
+    MMG5_pxTetra  pxt;
+    MMG5_int      k,nc;
+    int           ia;
+
+    nc = 0;
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        if ( pt->tag & MG_FRZ )  nc++;
+        if ( !pt->xt )  continue;
+        pxt = &mesh->xtetra[pt->xt];
+        for (ia=0; ia<6; ia++)
+            if ( pxt->tag[ia] & MG_FRZ )  nc++;
+    }
+    for (k=1; k<=mesh->np; k++) {
+        if ( !MG_VOK(&mesh->point[k]) )  continue;
+        if ( mesh->point[k].tagdel & MG_FRZ )  nc++;
+    }
+    return(nc);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param local state of the local remeshing.
+ * \return 1 if success, 0 if some frozen entities are left.
+ *
+ * Remove the tags set by \ref _MMG5_locRegion and \ref _MMG5_freeze. The
+ * frozen entities are found from their \a MG_FRZ tag, thus independently of
+ * their numbers; the edge tags being copied by the remeshing operators, the
+ * frozen edges are released in all the tetra.
+ *
+ */
+static inline
+int _MMG5_unfreeze(MMG5_pMesh mesh,int local) {
+    MMG5_pTetra   pt;
+    MMG5_pxTetra  pxt;
+    MMG5_pPoint   ppt;
+    MMG5_int      k,nc;
+    int           i,ia;
+
+    if ( local == _MMG5_LOC_NONE )  return(1);
+
+    mesh->nefrz = 0;
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        if ( local == _MMG5_LOC_REGION ) {
+            pt->tag &= ~MG_FRZ;
+            continue;
+        }
+
+        if ( pt->tag & MG_FRZ ) {
+            pt->tag &= ~(MG_REQ|MG_FRZ);
+            for (i=0; i<4; i++) {
+                ppt = &mesh->point[pt->v[i]];
+                if ( !(ppt->tagdel & MG_FRZ) )  continue;
+                ppt->tag    &= ~MG_REQ;
+                ppt->tagdel &= ~MG_FRZ;
+            }
+        }
+
+        if ( !pt->xt )  continue;
+        pxt = &mesh->xtetra[pt->xt];
+        for (ia=0; ia<6; ia++) {
+            if ( pxt->tag[ia] & MG_FRZ )
+                pxt->tag[ia] &= ~(MG_REQ|MG_FRZ);
+        }
+    }
+
+    nc = _MMG5_chkfrz(mesh);
+    if ( nc ) {
+        fprintf(stdout,"  ## Error: %" MMG5_PRId " entities still frozen after"
+                " the local remeshing.\n",nc);
+        return(0);
     }
     return(1);
 }
@@ -283,29 +571,25 @@ int MMG5_packMesh(MMG5_pMesh mesh,MMG5_pSol met) {
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
+ * \param local state of the local remeshing (\a _MMG5_LOC_NONE to remesh
+ * the whole mesh).
  * \return Return \ref MMG5_SUCCESS if success.
  * \return Return \ref MMG5_LOWFAILURE if failed but a conform mesh is saved.
  * \return Return \ref MMG5_STRONGFAILURE if failed and we can't save the mesh.
  *
- * Main program for the library .
+ * Remeshing driver of \ref MMG5_mmg3dlib and \ref MMG5_mmg3dlib_local.
  *
  */
-int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
-    ) {
+static
+int _MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met,int local) {
     mytime    ctim[TIMEMAX];
+    MMG5_int  nf;
     char      stim[32];
 
     fprintf(stdout,"  -- MMG3d, Release %s (%s) \n",MG_VER,MG_REL);
     fprintf(stdout,"     %s\n",MG_CPY);
     fprintf(stdout,"     %s %s\n",__DATE__,__TIME__);
 
-    signal(SIGABRT,_MMG5_excfun);
-    signal(SIGFPE,_MMG5_excfun);
-    signal(SIGILL,_MMG5_excfun);
-    signal(SIGSEGV,_MMG5_excfun);
-    signal(SIGTERM,_MMG5_excfun);
-    signal(SIGINT,_MMG5_excfun);
-
     tminit(ctim,TIMEMAX);
     chrono(ON,&(ctim[0]));
 
@@ -321,11 +605,8 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
     if ( met->np && (met->np != mesh->np) ) {
         fprintf(stdout,"  ## WARNING: WRONG SOLUTION NUMBER. IGNORED\n");
         _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
-        met->np = 0;
-    }
-    else if ( met->size!=1 ) {
-        fprintf(stdout,"  ## ERROR: ANISOTROPIC METRIC NOT IMPLEMENTED.\n");
-        return(MMG5_STRONGFAILURE);
+        met->np   = 0;
+        met->size = 1;
     }
 
     chrono(OFF,&(ctim[1]));
@@ -352,16 +633,24 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
 #ifdef DEBUG
     if ( !met->np && !_MMG5_DoSol(mesh,met,&mesh->info) ) {
         if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-        _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+        _MMG5_RETURN_AND_PACK(mesh,met,local,MMG5_LOWFAILURE);
     }
 #endif
     if ( !_MMG5_analys(mesh) ) {
         if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-        _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+        _MMG5_RETURN_AND_PACK(mesh,met,local,MMG5_LOWFAILURE);
     }
 
     if ( mesh->info.imprim > 4 && !mesh->info.iso && met->m ) _MMG5_prilen(mesh,met);
 
+    if ( local == _MMG5_LOC_REGION ) {
+        nf = _MMG5_freeze(mesh);
+        local = _MMG5_LOC_FROZEN;
+        if ( mesh->info.imprim )
+            fprintf(stdout,"     LOCAL REMESHING: %8" MMG5_PRId " ELEMENTS FROZEN"
+                    " (%" MMG5_PRId " OUT OF THE SWEEPS)\n",nf,mesh->nefrz);
+    }
+
     chrono(OFF,&(ctim[2]));
     printim(ctim[2].gdif,stim);
     if ( mesh->info.imprim )
@@ -376,7 +665,7 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
     if ( !_MMG5_scotchCall(mesh,met) )
     {
         if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-        _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+        _MMG5_RETURN_AND_PACK(mesh,met,local,MMG5_LOWFAILURE);
     }
 
 
@@ -387,7 +676,7 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
             return(MMG5_STRONGFAILURE);
         }
         if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-        _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+        _MMG5_RETURN_AND_PACK(mesh,met,local,MMG5_LOWFAILURE);
     }
 #else
     /** Patterns in iso mode, delauney otherwise */
@@ -398,7 +687,7 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
                 return(MMG5_STRONGFAILURE);
             }
             if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-            _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+            _MMG5_RETURN_AND_PACK(mesh,met,local,MMG5_LOWFAILURE);
         }
     }
     else {
@@ -408,7 +697,7 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
                 return(MMG5_STRONGFAILURE);
             }
             if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-            _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+            _MMG5_RETURN_AND_PACK(mesh,met,local,MMG5_LOWFAILURE);
         }
     }
 
@@ -418,6 +707,11 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
     printim(ctim[3].gdif,stim);
     if ( mesh->info.imprim )
         fprintf(stdout,"  -- PHASE 2 COMPLETED.     %s\n",stim);
+    if ( mesh->info.imprim > 4 && mesh->ctrealloc.call ) {
+        printim(mesh->ctrealloc.gdif,stim);
+        fprintf(stdout,"     %8d TABLE REALLOCATIONS  %s\n",
+                mesh->ctrealloc.call,stim);
+    }
     fprintf(stdout,"\n  %s\n   END OF MODULE MMG3d: IMB-LJLL \n  %s\n",MG_STR,MG_STR);
 
     /* save file */
@@ -428,6 +722,8 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
     chrono(ON,&(ctim[1]));
     if ( mesh->info.imprim )  fprintf(stdout,"\n  -- MESH PACKED UP\n");
     if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
+    if ( !_MMG5_unfreeze(mesh,local) )
+        _MMG5_RETURN_AND_PACK(mesh,met,_MMG5_LOC_NONE,MMG5_LOWFAILURE);
     if ( !MMG5_packMesh(mesh,met) )     return(MMG5_STRONGFAILURE);
     chrono(OFF,&(ctim[1]));
 
@@ -436,3 +732,67 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
     fprintf(stdout,"\n   MMG3DLIB: ELAPSED TIME  %s\n",stim);
     return(MMG5_SUCCESS);
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \return Return \ref MMG5_SUCCESS if success.
+ * \return Return \ref MMG5_LOWFAILURE if failed but a conform mesh is saved.
+ * \return Return \ref MMG5_STRONGFAILURE if failed and we can't save the mesh.
+ *
+ * Main program for the library .
+ *
+ */
+int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
+    ) {
+    return(_MMG5_mmg3dlib(mesh,met,_MMG5_LOC_NONE));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param eltab table of the elements to remesh (\f$eltab[k]\neq0\f$ for the
+ * tetra \a k, \a eltab contains at least \f$mesh->ne+1\f$ elements).
+ * \param nlayers number of layers of neighbours remeshed with the elements
+ * of \a eltab.
+ * \return Return \ref MMG5_SUCCESS if success.
+ * \return Return \ref MMG5_LOWFAILURE if failed but a conform mesh is saved.
+ * \return Return \ref MMG5_STRONGFAILURE if failed and we can't save the mesh.
+ *
+ * Remesh the tetra of \a eltab and the \a nlayers layers of tetra around them
+ * (each layer being made of the tetra sharing a vertex with the previous
+ * ones). The other tetra and their vertices are frozen during the remeshing
+ * and released before returning; the renumbering of the mesh is disabled and
+ * the remeshing sweeps skip the frozen tetra far from the region. These far
+ * tetra are moved to the beginning of the tetra table (see \ref _MMG5_freeze)
+ * and the mesh is packed before returning, thus the tetra and the vertices
+ * are renumbered.
+ *
+ */
+int MMG5_mmg3dlib_local(MMG5_pMesh mesh,MMG5_pSol met,int *eltab,int nlayers) {
+    MMG5_int      nreg;
+    int           renum,ier;
+
+    if ( mesh->info.iso ) {
+        fprintf(stdout,"  ## Error: local remeshing not available in level-set"
+                " discretization mode.\n");
+        return(MMG5_STRONGFAILURE);
+    }
+
+    nreg = _MMG5_locRegion(mesh,eltab,nlayers);
+    if ( mesh->info.imprim )
+        fprintf(stdout,"  -- LOCAL REMESHING: %" MMG5_PRId " ELEMENTS OVER %"
+                MMG5_PRId " (%d LAYERS)\n",nreg,mesh->ne,nlayers);
+
+    ier = MMG5_SUCCESS;
+    if ( nreg ) {
+        renum = mesh->info.renum;
+        mesh->info.renum = 0;
+        ier = _MMG5_mmg3dlib(mesh,met,_MMG5_LOC_REGION);
+        mesh->info.renum = renum;
+    }
+    else
+        _MMG5_unfreeze(mesh,_MMG5_LOC_REGION);
+
+    return(ier);
+}
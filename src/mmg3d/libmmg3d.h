@@ -33,8 +33,36 @@
 #ifndef _MMG3DLIB_H
 #define _MMG3DLIB_H
 
+#include <limits.h>
+#include <stdint.h>
+#include <inttypes.h>
 #include "chrono.h"
 
+/**
+ * \typedef MMG5_int
+ *
+ * Type of the indices of the mesh entities: 64 bits integers if the library
+ * is compiled with the \a MMG5_INT64 flag (CMake option \a MMG_INT64), int
+ * otherwise. The applications linked with the library must be compiled with
+ * the same flag. \a MMG5_PRId and \a MMG5_SCNd are the matching printf and
+ * scanf formats, \a MMG5_INTMAX is the largest index and \a MMG5_INTSIZE the
+ * size in bytes of a \ref MMG5_int (the kind of the Fortran integers).
+ *
+ */
+#ifdef MMG5_INT64
+typedef int64_t MMG5_int;
+#define MMG5_PRId    PRId64
+#define MMG5_SCNd    SCNd64
+#define MMG5_INTMAX  INT64_MAX
+#define MMG5_INTSIZE 8
+#else
+typedef int MMG5_int;
+#define MMG5_PRId    "d"
+#define MMG5_SCNd    "d"
+#define MMG5_INTMAX  INT_MAX
+#define MMG5_INTSIZE 4
+#endif
+
 /**
  * \def MMG5_SUCCESS
  *
@@ -102,7 +130,7 @@ enum MMG5_Param
     MMG5_IPARAM_noswap,            /*!< [1/0], Avoid/allow edge or face flipping */
     MMG5_IPARAM_nomove,            /*!< [1/0], Avoid/allow point relocation */
     MMG5_IPARAM_numberOfLocalParam,/*!< [n], Number of local parameters */
-    MMG5_IPARAM_renum,             /*!< [1/0], Turn on/off point relocation with Scotch */
+    MMG5_IPARAM_renum,             /*!< [0/1/2/3], No renumbering, renumbering with Scotch, along a Hilbert or a Morton curve */
     MMG5_IPARAM_bucket,            /*!< [n], Specify the size of the bucket per dimension (DELAUNAY) */
     MMG5_DPARAM_angleDetection,    /*!< [val], Value for angle detection */
     MMG5_DPARAM_hmin,              /*!< [val], Minimal mesh size */
@@ -110,6 +138,9 @@ enum MMG5_Param
     MMG5_DPARAM_hausd,             /*!< [val], Control global Hausdorff distance (on all the boundary surfaces of the mesh) */
     MMG5_DPARAM_hgrad,             /*!< [val], Control gradation */
     MMG5_DPARAM_ls,                /*!< [val], Value of level-set (not use for now) */
+    MMG5_IPARAM_threads,           /*!< [n], Number of threads used by the read-only analysis passes of the remeshing (edge lengths, delaunay cavities) and by the file readers and writers (DELAUNAY, needs OpenMP) */
+    MMG5_IPARAM_queue,             /*!< [1/0], Turn on/off the processing of the edges by length order (DELAUNAY) */
+    MMG5_IPARAM_growth,            /*!< [1/0], Geometric growth of the tables or growth by \a mesh->gap only */
     MMG5_PARAM_size,               /*!< [n], Number of parameters */
   };
 
@@ -135,13 +166,13 @@ typedef MMG5_Par * MMG5_pPar;
 typedef struct {
   double   c[3]; /*!< Coordinates of point */
   int      ref; /*!< Reference of point */
-  int      xp; /*!< Surface point number */
-  int      tmp; /*!< Index of point in the saved mesh (we don't count
+  MMG5_int xp; /*!< Surface point number */
+  MMG5_int tmp; /*!< Index of point in the saved mesh (we don't count
                    the unused points)*/
-  int      flag; /*!< Flag to know if we have already treated the point */
+  MMG5_int flag; /*!< Flag to know if we have already treated the point */
   char     tag; /*!< Contains binary flags : if \f$tag=23=16+4+2+1\f$, then
                    the point is \a MG_REF, \a MG_GEO, \a MG_REQ and \a MG_BDY */
-  char     tagdel; /*!< Tag for delaunay */
+  unsigned char tagdel; /*!< Tag for delaunay */
 } MMG5_Point;
 typedef MMG5_Point * MMG5_pPoint;
 
@@ -161,7 +192,7 @@ typedef MMG5_xPoint * MMG5_pxPoint;
  * \brief Structure to store edges of a MMG3D mesh.
  */
 typedef struct {
-  int      a,b; /*!< Extremities of the edge */
+  MMG5_int a,b; /*!< Extremities of the edge */
   int      ref; /*!< Reference of the edge */
   char     tag; /*!< Binary flags */
 } MMG5_Edge;
@@ -172,7 +203,7 @@ typedef MMG5_Edge * MMG5_pEdge;
  * \brief Structure to store triangles of a MMG3D mesh.
  */
 typedef struct {
-  int      v[3]; /*!< Vertices of the triangle */
+  MMG5_int v[3]; /*!< Vertices of the triangle */
   int      ref; /*!< Reference of the triangle */
   int      base;
   int      edg[3]; /*!< edg[i] contains the ref of the \f$i^{th}\f$ edge
@@ -188,14 +219,14 @@ typedef MMG5_Tria * MMG5_pTria;
  * \brief Structure to store tetrahedra of a MMG3D mesh.
  */
 typedef struct {
-  int      v[4]; /*!< Vertices of the tetrahedron */
+  MMG5_int v[4]; /*!< Vertices of the tetrahedron */
   int      ref; /*!< Reference of the tetrahedron */
   int      base;
   int      mark; /*!< Used for delaunay */
-  int      xt; /*!< Index of the surface \ref MMG5_xTetra associated to
+  MMG5_int xt; /*!< Index of the surface \ref MMG5_xTetra associated to
                   the tetrahedron*/
   int      flag;
-  char     tag;
+  unsigned char tag; /*!< Binary flags */
   double   qual; /*!< Quality of the element */
 } MMG5_Tetra;
 typedef MMG5_Tetra * MMG5_pTetra;
@@ -211,8 +242,8 @@ typedef struct {
                       \f$i^{th}\f$ edge of the tetrahedron */
   char     ftag[4]; /*!< ftag[i] contains the tag associated to the
                        \f$i^{th}\f$ face of the tetrahedron */
-  char     tag[6]; /*!< tag[i] contains the tag associated to the
-                      \f$i^{th}\f$ edge of the tetrahedron */
+  unsigned char tag[6]; /*!< tag[i] contains the tag associated to the
+                           \f$i^{th}\f$ edge of the tetrahedron */
   char     ori; /*!< Orientation of the triangles of the tetrahedron:
                   the $\f$i^{th}\f$ bit of ori is set to 0 when the
                   \f$i^{th}\f$ face is bad orientated */
@@ -224,12 +255,14 @@ typedef MMG5_xTetra * MMG5_pxTetra;
  * \brief To store geometric edges.
  */
 typedef struct {
-  int   a,b,ref,nxt;
-  char  tag;
+  MMG5_int a,b;
+  int      ref;
+  MMG5_int nxt;
+  char     tag;
 } MMG5_hgeom;
 
 typedef struct {
-  int         siz,max,nxt;
+  MMG5_int    siz,max,nxt;
   MMG5_hgeom  *geom;
 } MMG5_HGeom;
 
@@ -244,33 +277,58 @@ typedef struct {
   char          imprim,ddebug,badkal,iso,fem;
   unsigned char noinsert, noswap, nomove;
   int           bucket;
+  int           threads;
+  unsigned char queue;
+  unsigned char growth;
   MMG5_pPar     par;
 } MMG5_Info;
 
+/**
+ * \struct MMG5_sol
+ * \brief MMG3D Solution structure (for solution or metric).
+ */
+typedef struct {
+  int       ver; /* Version of the solution file */
+  int       dim; /* Dimension of the solution file*/
+  MMG5_int  np; /* Number of points of the solution */
+  MMG5_int  npmax; /* Maximum number of points */
+  MMG5_int  npi; /* Temporary number of points (internal use only) */
+  int       size; /* Number of solutions per entity */
+  int       type; /* Type of the solution (scalar, vectorial of tensorial) */
+  double   *m; /*!< Solution values */
+  char     *namein; /*!< Input solution file name */
+  char     *nameout; /*!< Output solution file name */
+} MMG5_Sol;
+typedef MMG5_Sol * MMG5_pSol;
+
 /**
  * \struct MMG5_Mesh
  * \brief MMG3D mesh structure.
  */
-typedef struct {
+typedef struct MMG5_Mesh_s {
   int       ver; /*!< Version of the mesh file */
   int       dim; /*!< Dimension of the mesh */
   int       type; /*!< Type of the mesh */
   long long memMax; /*!< Maximum memory available */
   long long memCur; /*!< Current memory used */
   double    gap; /*!< Gap for table reallocation */
-  int       npi,nti,nai,nei,np,na,nt,ne,npmax,namax,ntmax,nemax,xpmax,xtmax;
+  mytime    ctrealloc; /*!< Time spent in the table reallocations, \a
+                            ctrealloc.call is their number */
+  MMG5_int  npi,nti,nai,nei,np,na,nt,ne,npmax,namax,ntmax,nemax,xpmax,xtmax;
   int       base; /*!< Used with \a flag to know if an entity has been
                      treated */
   int       mark; /*!< Flag for delaunay (to know if an entity has
                      been treated) */
-  int       xp,xt; /*!< Number of surfaces points/triangles */
-  int       npnil; /*!< Index of first unused point */
-  int       nenil; /*!< Index of first unused element */
-  int      *adja; /*!< Table of tetrahedron adjacency: if
+  MMG5_int  xp,xt; /*!< Number of surfaces points/triangles */
+  MMG5_int  npnil; /*!< Index of first unused point */
+  MMG5_int  nenil; /*!< Index of first unused element */
+  MMG5_int  nefrz; /*!< The tetra 1 to \a nefrz are frozen by a local
+                     remeshing and ignored by the remeshing sweeps */
+  MMG5_int *adja; /*!< Table of tetrahedron adjacency: if
                      \f$adjt[4*i+1+j]=4*k+l\f$ then the \f$i^{th}\f$ and
                      \f$k^th\f$ tetrahedra are adjacent and share their
                      faces \a j and \a l (resp.) */
-  int      *adjt; /*!< Table of triangles adjacency: if
+  MMG5_int *adjt; /*!< Table of triangles adjacency: if
                      \f$adjt[3*i+1+j]=3*k+l\f$ then the \f$i^{th}\f$ and
                      \f$k^th\f$ triangles are adjacent and share their
                      edges \a j and \a l (resp.) */
@@ -285,27 +343,19 @@ typedef struct {
   MMG5_pEdge     edge; /*!< Pointer toward the \ref MMG5_Edge structure */
   MMG5_HGeom     htab; /*!< \ref MMG5_HGeom structure */
   MMG5_Info      info; /*!< \ref MMG5_Info structure */
+
+  /* Functions depending on the metric type, stored in the mesh so different
+   * meshes may be adapted concurrently (internal use only) */
+  double (*caltet)(struct MMG5_Mesh_s*,MMG5_pSol,MMG5_int,MMG5_int,MMG5_int,MMG5_int); /*!< Quality of a tetrahedron */
+  double (*lenedg)(struct MMG5_Mesh_s*,MMG5_pSol,MMG5_int,MMG5_int); /*!< Length of an edge */
+  int    (*intmet)(struct MMG5_Mesh_s*,MMG5_pSol,MMG5_int,MMG5_int,MMG5_int,double); /*!< Interpolation of the metric along an edge */
+  int    (*defsiz)(struct MMG5_Mesh_s*,MMG5_pSol); /*!< Definition of the size map */
+  int    (*gradsiz)(struct MMG5_Mesh_s*,MMG5_pSol); /*!< Gradation of the size map */
+  double (*lenedgCoor)(double*,double*,double*,double*); /*!< Length of an edge given by its extremities */
+  int    (*saveMesh)(struct MMG5_Mesh_s*); /*!< Save the mesh (see \ref MMG5_Set_saveFunc) */
 } MMG5_Mesh;
 typedef MMG5_Mesh  * MMG5_pMesh;
 
-/**
- * \struct MMG5_sol
- * \brief MMG3D Solution structure (for solution or metric).
- */
-typedef struct {
-  int       ver; /* Version of the solution file */
-  int       dim; /* Dimension of the solution file*/
-  int       np; /* Number of points of the solution */
-  int       npmax; /* Maximum number of points */
-  int       npi; /* Temporary number of points (internal use only) */
-  int       size; /* Number of solutions per entity */
-  int       type; /* Type of the solution (scalar, vectorial of tensorial) */
-  double   *m; /*!< Solution values */
-  char     *namein; /*!< Input solution file name */
-  char     *nameout; /*!< Output solution file name */
-} MMG5_Sol;
-typedef MMG5_Sol * MMG5_pSol;
-
 /*----------------------------- functions header -----------------------------*/
 /** Initialization functions */
 /* init structures */
@@ -388,7 +438,7 @@ int  MMG5_Set_outputSolName(MMG5_pMesh mesh,MMG5_pSol sol, char* solout);
  * Set the solution number, dimension and type.
  *
  */
-int  MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int typSol);
+int  MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, MMG5_int np, int typSol);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param np number of vertices.
@@ -402,7 +452,7 @@ int  MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int
  * whole mesh to realloc it at the new size
  *
  */
-int  MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na);
+int  MMG5_Set_meshSize(MMG5_pMesh mesh, MMG5_int np, MMG5_int ne, MMG5_int nt, MMG5_int na);
 
 /* init structure datas */
 /**
@@ -419,7 +469,7 @@ int  MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na);
  *
  */
 int  MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1,
-                     double c2, int ref,int pos);
+                     double c2, int ref,MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of tetrahedron.
@@ -434,8 +484,8 @@ int  MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1,
  * \a ref at position \a pos in mesh structure.
  *
  */
-int  MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1,
-                          int v2, int v3, int ref, int pos);
+int  MMG5_Set_tetrahedron(MMG5_pMesh mesh, MMG5_int v0, MMG5_int v1,
+                          MMG5_int v2, MMG5_int v3, int ref, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of triangle.
@@ -449,8 +499,8 @@ int  MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1,
  * at position \a pos in mesh structure.
  *
  */
-int  MMG5_Set_triangle(MMG5_pMesh mesh, int v0, int v1,
-                       int v2, int ref,int pos);
+int  MMG5_Set_triangle(MMG5_pMesh mesh, MMG5_int v0, MMG5_int v1,
+                       MMG5_int v2, int ref,MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first extremity of the edge.
@@ -463,7 +513,57 @@ int  MMG5_Set_triangle(MMG5_pMesh mesh, int v0, int v1,
  * position \a pos in mesh structure
  *
  */
-int  MMG5_Set_edge(MMG5_pMesh mesh, int v0, int v1, int ref,int pos);
+int  MMG5_Set_edge(MMG5_pMesh mesh, MMG5_int v0, MMG5_int v1, int ref,MMG5_int pos);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices table of the points coor. The coordinates of the
+ * \f$i^{th}\f$ point are stored in vertices[(i-1)*3]\@3.
+ * \param refs table of points references (may be NULL).
+ * The ref of the \f$i^th\f$ point is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set vertices coordinates and references in mesh structure in one pass.
+ *
+ */
+int  MMG5_Set_vertices(MMG5_pMesh mesh, double *vertices,int *refs);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra vertices of the tetras of the mesh. Vertices of the
+ * \f$i^{th}\f$ tetra are stored in tetra[(i-1)*4]\@4.
+ * \param refs table of the tetrahedra references (may be NULL).
+ * References of the \f$i^{th}\f$ tetra is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set vertices and references of all the mesh tetrahedra in one pass.
+ * Badly oriented tetrahedra are reoriented and counted only once for
+ * the whole array.
+ *
+ */
+int  MMG5_Set_tetrahedra(MMG5_pMesh mesh, MMG5_int *tetra, int *refs);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tria pointer toward the table of the triangles vertices.
+ * Vertices of the \f$i^{th}\f$ tria are stored in tria[(i-1)*3]\@3.
+ * \param refs pointer toward the table of the triangle references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ tria.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set vertices and references of all the mesh triangles in one pass.
+ *
+ */
+int  MMG5_Set_triangles(MMG5_pMesh mesh, MMG5_int *tria, int *refs);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param edges pointer toward the table of the edges extremities.
+ * Extremities of the \f$i^{th}\f$ edge are stored in edges[(i-1)*2]\@2.
+ * \param refs pointer toward the table of the edges references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ edge.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set extremities and references of all the mesh edges in one pass.
+ *
+ */
+int  MMG5_Set_edges(MMG5_pMesh mesh, MMG5_int *edges, int *refs);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pos vertex index.
@@ -472,7 +572,7 @@ int  MMG5_Set_edge(MMG5_pMesh mesh, int v0, int v1, int ref,int pos);
  * Set corner at point \a pos.
  *
  */
-int  MMG5_Set_corner(MMG5_pMesh mesh, int pos);
+int  MMG5_Set_corner(MMG5_pMesh mesh, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pos vertex index.
@@ -481,7 +581,7 @@ int  MMG5_Set_corner(MMG5_pMesh mesh, int pos);
  * Set point \a pos as required.
  *
  */
-int  MMG5_Set_requiredVertex(MMG5_pMesh mesh, int pos);
+int  MMG5_Set_requiredVertex(MMG5_pMesh mesh, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pos element index.
@@ -490,7 +590,7 @@ int  MMG5_Set_requiredVertex(MMG5_pMesh mesh, int pos);
  * Set element \a pos as required.
  *
  */
-int  MMG5_Set_requiredTetrahedron(MMG5_pMesh mesh, int pos);
+int  MMG5_Set_requiredTetrahedron(MMG5_pMesh mesh, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pos triangle index.
@@ -499,7 +599,7 @@ int  MMG5_Set_requiredTetrahedron(MMG5_pMesh mesh, int pos);
  * Set triangle \a pos as required.
  *
  */
-int  MMG5_Set_requiredTriangle(MMG5_pMesh mesh, int pos);
+int  MMG5_Set_requiredTriangle(MMG5_pMesh mesh, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pos edge index.
@@ -508,7 +608,7 @@ int  MMG5_Set_requiredTriangle(MMG5_pMesh mesh, int pos);
  * Set ridge at edge \a pos.
  *
  */
-int  MMG5_Set_ridge(MMG5_pMesh mesh, int pos);
+int  MMG5_Set_ridge(MMG5_pMesh mesh, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pos edge index.
@@ -517,7 +617,7 @@ int  MMG5_Set_ridge(MMG5_pMesh mesh, int pos);
  * Set edge \a k as required.
  *
  */
-int  MMG5_Set_requiredEdge(MMG5_pMesh mesh, int pos);
+int  MMG5_Set_requiredEdge(MMG5_pMesh mesh, MMG5_int pos);
 /**
  * \param met pointer toward the sol structure.
  * \param s solution scalar value.
@@ -527,7 +627,24 @@ int  MMG5_Set_requiredEdge(MMG5_pMesh mesh, int pos);
  * Set scalar value \a s at position \a pos in solution structure
  *
  */
-int  MMG5_Set_scalarSol(MMG5_pSol met, double s,int pos);
+int  MMG5_Set_scalarSol(MMG5_pSol met, double s,MMG5_int pos);
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 value of the tensorial solution at position (1,1) in the tensor.
+ * \param m12 value of the tensorial solution at position (1,2) in the tensor.
+ * \param m13 value of the tensorial solution at position (1,3) in the tensor.
+ * \param m22 value of the tensorial solution at position (2,2) in the tensor.
+ * \param m23 value of the tensorial solution at position (2,3) in the tensor.
+ * \param m33 value of the tensorial solution at position (3,3) in the tensor.
+ * \param pos position of the solution in the mesh (begin to 1).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set tensorial values at position \a pos in solution structure (the
+ * solution size must be set with the \a MMG5_Tensor type).
+ *
+ */
+int  MMG5_Set_tensorSol(MMG5_pSol met, double m11,double m12, double m13,
+                        double m22,double m23, double m33, MMG5_int pos);
 /**
  * \param mesh pointer toward the mesh structure.
  *
@@ -598,7 +715,7 @@ int  MMG5_Set_localParameter(MMG5_pMesh mesh, MMG5_pSol sol, int typ, int ref, d
  * Get the number of vertices, tetrahedra, triangles and edges of the mesh.
  *
  */
-int  MMG5_Get_meshSize(MMG5_pMesh mesh, int* np, int* ne, int* nt, int* na);
+int  MMG5_Get_meshSize(MMG5_pMesh mesh, MMG5_int* np, MMG5_int* ne, MMG5_int* nt, MMG5_int* na);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param sol pointer toward the sol structure.
@@ -610,8 +727,23 @@ int  MMG5_Get_meshSize(MMG5_pMesh mesh, int* np, int* ne, int* nt, int* na);
  * Get the solution number, dimension and type.
  *
  */
-int  MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, int* np,
+int  MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, MMG5_int* np,
                       int* typSol);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np pointer toward the estimated final number of vertices.
+ * \param ne pointer toward the estimated final number of tetrahedra.
+ * \return 1 if success, 0 if the size map is undefined (no metric and no
+ * \a hmax value): \a np and \a ne are then the current mesh sizes.
+ *
+ * Estimate the sizes of the adapted mesh by integration of the metric over
+ * the input mesh (see \ref MMG5_IPARAM_threads), for example to plan the
+ * memory of a run. Must be called once the mesh and the metric are set.
+ *
+ */
+int  MMG5_Get_estimatedSize(MMG5_pMesh mesh, MMG5_pSol met, MMG5_int* np,
+                            MMG5_int* ne);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param c0 pointer toward the coordinate of the point along the first dimension.
@@ -642,7 +774,7 @@ int  MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* r
  * next tetra of mesh.
  *
  */
-int  MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
+int  MMG5_Get_tetrahedron(MMG5_pMesh mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, MMG5_int* v3,
                           int* ref, int* isRequired);
 /**
  * \param mesh pointer toward the mesh structure.
@@ -657,7 +789,7 @@ int  MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
  * triangle of mesh.
  *
  */
-int  MMG5_Get_triangle(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* ref,
+int  MMG5_Get_triangle(MMG5_pMesh mesh, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, int* ref,
                        int* isRequired);
 /**
  * \param mesh pointer toward the mesh structure.
@@ -671,8 +803,77 @@ int  MMG5_Get_triangle(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* ref,
  * Get extremities \a e0, \a e1 and reference \a ref of next edge of mesh.
  *
  */
-int  MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref,
+int  MMG5_Get_edge(MMG5_pMesh mesh, MMG5_int* e0, MMG5_int* e1, int* ref,
                    int* isRidge, int* isRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices pointer toward the table of the points coordinates.
+ * The coordinates of the \f$i^{th}\f$ point are stored in
+ * vertices[(i-1)*3]\@3.
+ * \param refs pointer to the table of the point references (may be NULL).
+ * The ref of the \f$i^th\f$ point is stored in refs[i-1].
+ * \param areCorners pointer toward the table of the flags saying if
+ * points are corners (may be NULL).
+ * areCorners[i-1]=1 if the \f$i^{th}\f$ point is corner.
+ * \param areRequired pointer toward the table of flags saying if points
+ * are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ point is required.
+ * \return 1.
+ *
+ * Get the coordinates and references of all the mesh vertices in one pass.
+ *
+ */
+int  MMG5_Get_vertices(MMG5_pMesh mesh, double* vertices, int* refs,
+                      int* areCorners, int* areRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra pointer toward the table of the tetrahedra vertices.
+ * Vertices of the \f$i^{th}\f$ tetra are stored in tetra[(i-1)*4]\@4.
+ * \param refs pointer toward the table of the tetrahedron references
+ * (may be NULL). References of the \f$i^{th}\f$ tetra is stored in refs[i-1].
+ * \param areRequired pointer toward the table of the flags saying if the
+ * tetrahedra are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ tetra is required.
+ * \return 1.
+ *
+ * Get vertices and references of all the mesh tetrahedra in one pass.
+ *
+ */
+int  MMG5_Get_tetrahedra(MMG5_pMesh mesh, MMG5_int* tetra, int* refs, int* areRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tria pointer toward the table of the triangles vertices.
+ * Vertices of the \f$i^{th}\f$ tria are stored in tria[(i-1)*3]\@3.
+ * \param refs pointer toward the table of the triangles references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ tria.
+ * \param areRequired pointer toward table of the flags saying if
+ * triangles are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ tria is required.
+ * \return 1.
+ *
+ * Get vertices and references of all the mesh triangles in one pass.
+ *
+ */
+int  MMG5_Get_triangles(MMG5_pMesh mesh, MMG5_int* tria, int* refs, int* areRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param edges pointer toward the table of the edges extremities.
+ * Extremities of the \f$i^{th}\f$ edge are stored in edges[(i-1)*2]\@2.
+ * \param refs pointer toward the table of the edges references
+ * (may be NULL). refs[i-1] is the ref of the \f$i^{th}\f$ edge.
+ * \param areRidges pointer toward the table of the flags saying if the
+ * edges are ridges (may be NULL).
+ * areRidges[i-1]=1 if the \f$i^{th}\f$ edge is ridge.
+ * \param areRequired pointer toward the table of the flags saying if the
+ * edges are required (may be NULL).
+ * areRequired[i-1]=1 if the \f$i^{th}\f$ edge is required.
+ * \return 1.
+ *
+ * Get extremities and references of all the mesh edges in one pass.
+ *
+ */
+int  MMG5_Get_edges(MMG5_pMesh mesh, MMG5_int* edges, int* refs,
+                   int* areRidges, int* areRequired);
 /**
  * \param met pointer toward the sol structure.
  * \param s pointer toward the scalar solution value.
@@ -682,6 +883,21 @@ int  MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref,
  *
  */
 int  MMG5_Get_scalarSol(MMG5_pSol met, double* s);
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 pointer toward the position (1,1) in the solution tensor.
+ * \param m12 pointer toward the position (1,2) in the solution tensor.
+ * \param m13 pointer toward the position (1,3) in the solution tensor.
+ * \param m22 pointer toward the position (2,2) in the solution tensor.
+ * \param m23 pointer toward the position (2,3) in the solution tensor.
+ * \param m33 pointer toward the position (3,3) in the solution tensor.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get tensorial solution of next vertex of mesh.
+ *
+ */
+int  MMG5_Get_tensorSol(MMG5_pSol met, double *m11,double *m12, double *m13,
+                        double *m22,double *m23, double *m33);
 
 /** input/output functions */
 /**
@@ -699,7 +915,7 @@ int  MMG5_loadMesh(MMG5_pMesh mesh);
  * Save mesh data.
  *
  */
-int  (*MMG5_saveMesh)(MMG5_pMesh mesh);
+int  MMG5_saveMesh(MMG5_pMesh mesh);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -758,6 +974,30 @@ void MMG5_Free_names(MMG5_pMesh mesh, MMG5_pSol met);
  *
  */
 int  MMG5_mmg3dlib(MMG5_pMesh mesh, MMG5_pSol sol);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param eltab table of the elements to remesh (\f$eltab[k]\neq0\f$ for the
+ * tetra \a k, \a eltab contains at least \f$mesh->ne+1\f$ elements).
+ * \param nlayers number of layers of neighbours remeshed with the elements
+ * of \a eltab.
+ * \return Return \ref MMG5_SUCCESS if success,
+ * \ref MMG5_LOWFAILURE if fail but a conform mesh is saved or
+ * \ref MMG5_STRONGFAILURE if fail and we can't save the mesh.
+ *
+ * Local remeshing: only the elements of \a eltab (as filled by \ref
+ * MMG5_mmg3dcheck, \ref MMG5_searchqua or \ref MMG5_searchlen) and
+ * \a nlayers layers of neighbours are remeshed, the rest of the mesh is
+ * kept unchanged.
+ *
+ * \warning the mesh is renumbered: the tetrahedra without vertex in common
+ * with the remeshed ones are moved to the beginning of the tetrahedra table
+ * during the remeshing and the mesh is packed at the end, thus the indices
+ * of the unchanged vertices and tetrahedra (and of \a eltab) do not match
+ * the input ones.
+ *
+ */
+int  MMG5_mmg3dlib_local(MMG5_pMesh mesh, MMG5_pSol sol, int *eltab, int nlayers);
 
 /** for PAMPA library */
 /** Options management */
@@ -876,8 +1116,9 @@ int  MMG5_searchlen(MMG5_pMesh mesh, MMG5_pSol met, double lmin, double lmax, in
  * (so we are on a boundary face).
  *
  */
-int MMG5_Get_adjaTet(MMG5_pMesh mesh,int kel, int* v0, int* v1, int* v2, int* v3);
+int MMG5_Get_adjaTet(MMG5_pMesh mesh,MMG5_int kel, MMG5_int* v0, MMG5_int* v1, MMG5_int* v2, MMG5_int* v3);
 /**
+ * \param mesh pointer toward the mesh structure.
  * \param ca pointer toward the coordinates of the first edge's extremity.
  * \param cb pointer toward the coordinates of the second edge's extremity.
  * \param ma pointer toward the metric associated to the first edge's extremity.
@@ -890,7 +1131,7 @@ int MMG5_Get_adjaTet(MMG5_pMesh mesh,int kel, int* v0, int* v1, int* v2, int* v3
  * prescription.
  *
  */
-double (*MMG5_lenedgCoor)(double *ca,double *cb,double *sa,double *sb);
+double MMG5_lenedgCoor(MMG5_pMesh mesh,double *ca,double *cb,double *sa,double *sb);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param pack we pack the mesh at function begining if \f$pack=1\f$.
@@ -900,11 +1141,11 @@ double (*MMG5_lenedgCoor)(double *ca,double *cb,double *sa,double *sb);
  * mesh and to 1 for a mesh that need to be packed.
  *
  */
-int  (*MMG5_hashTetra)(MMG5_pMesh mesh, int pack);
+int  MMG5_hashTetra(MMG5_pMesh mesh, int pack);
 
 /** To associate function pointers without calling MMG5_mmg3dlib */
 /**
- * \param mesh pointer toward the mesh structure (unused).
+ * \param mesh pointer toward the mesh structure.
  * \note Developped for the PaMPA library interface.
  *
  * Set pointer for MMG5_saveMesh function.
@@ -916,18 +1157,19 @@ void  MMG5_Set_saveFunc(MMG5_pMesh mesh);
  * \param met pointer toward the sol structure (unused).
  * \note Developped for the PaMPA library interface.
  *
- * Set function pointers for caltet, lenedg, defsiz and gradsiz.
+ * Set function pointers for caltet, lenedg, intmet, defsiz and gradsiz.
  *
  */
 void  MMG5_setfunc(MMG5_pMesh mesh,MMG5_pSol met);
 /**
- * \param mesh pointer toward the mesh structure (unused).
- * \param met pointer toward the sol structure (unused).
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
  * \warning Copy of the \ref setfunc function of the \ref mmg3d/shared_func.h
  * file.
  * \note Developped for the PaMPA library interface.
  *
- * Set function pointers for lenedgeCoor, hashTetra and saveMesh.
+ * Set function pointers for caltet, lenedg, intmet, defsiz, gradsiz, lenedgeCoor and
+ * saveMesh.
  *
  */
 void  MMG5_pampa_setfunc(MMG5_pMesh mesh,MMG5_pSol met);
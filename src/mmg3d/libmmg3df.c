@@ -98,3 +98,16 @@ FORTRAN_NAME(MMG5_MMG3DLIB,mmg5_mmg3dlib,(MMG5_pMesh *mesh,MMG5_pSol *met
 
     return;
 }
+
+/**
+ * See \ref MMG5_mmg3dlib_local function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_MMG3DLIB_LOCAL,mmg5_mmg3dlib_local,(MMG5_pMesh *mesh,MMG5_pSol *met,
+                                                      int *eltab,int *nlayers,
+                                                      int* retval),
+             (mesh,met,eltab,nlayers,retval)){
+
+    *retval = MMG5_mmg3dlib_local(*mesh,*met,eltab,*nlayers);
+
+    return;
+}
@@ -584,11 +584,15 @@ int _MMG5_renumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
  * (renumerotation success of renumerotation fail but the mesh is still
  *  conformal).
  *
- * Call scotch renumbering.
+ * Call scotch renumbering, or the space filling curve renumbering (see
+ * \ref _MMG5_sfcCall) for the \a -rn 2 and 3 values.
  *
  **/
 int _MMG5_scotchCall(MMG5_pMesh mesh, MMG5_pSol met)
 {
+    if ( mesh->info.renum >= _MMG5_RENUM_HILBERT )
+        return(_MMG5_sfcCall(mesh,met,NULL));
+
 #ifdef USE_SCOTCH
     /*check enough vertex to renum*/
     if ( mesh->info.renum && (mesh->np/2. > _MMG5_BOXSIZE) && mesh->np>100000 ) {
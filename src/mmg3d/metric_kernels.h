@@ -0,0 +1,248 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/metric_kernels.h
+ * \brief Inlined metric kernels and instantiation of the remeshing drivers.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The \a mesh->caltet and \a mesh->lenedg pointers select the iso or
+ * anisotropic kernels at runtime, thus the kernels cannot be inlined in the
+ * loops calling them. The hot drivers are rather written once in a template
+ * file and instantiated for each metric type: the template file is included
+ * after the definition of \a _MMG5_TMET to \a iso or \a ani, the
+ * \a _MMG5_TNAME, \a _MMG5_TCALTET and \a _MMG5_TLENEDG macros then name the
+ * instance and call the kernels of this metric type directly. The choice of
+ * the instance is made once per sweep by the caller.
+ *
+ */
+
+#ifndef _MMG5_METRIC_KERNELS_H
+#define _MMG5_METRIC_KERNELS_H
+
+#define _MMG5_TCAT2(a,b)    a##_##b
+#define _MMG5_TCAT3(a,b,c)  a##_##b##_##c
+#define _MMG5_TXCAT2(a,b)   _MMG5_TCAT2(a,b)
+#define _MMG5_TXCAT3(a,b,c) _MMG5_TCAT3(a,b,c)
+
+/** name of the instance of the function \a f for the metric \a _MMG5_TMET */
+#define _MMG5_TNAME(f) _MMG5_TXCAT2(f,_MMG5_TMET)
+
+/** inlined quality of the metric \a _MMG5_TMET */
+#define _MMG5_TCALTET(mesh,met,ia,ib,ic,id)                             \
+    (_MMG5_TXCAT3(_MMG5_caltet,_MMG5_TMET,inl)((mesh),(met),(ia),(ib),(ic),(id)))
+
+/** inlined length of the metric \a _MMG5_TMET */
+#define _MMG5_TLENEDG(mesh,met,ia,ib)                                   \
+    (_MMG5_TXCAT3(_MMG5_lenedg,_MMG5_TMET,inl)((mesh),(met),(ia),(ib)))
+
+/** 1 if the batched kernels of simd.c evaluate the quality and the length of
+ * the metric \a _MMG5_TMET (use in a \a \#if), 0 otherwise */
+#define _MMG5_TBATCH  _MMG5_TXCAT2(_MMG5_ISBATCH,_MMG5_TMET)
+#define _MMG5_ISBATCH_iso 1
+#define _MMG5_ISBATCH_ani 0
+
+/** Length of edge [ip1,ip2] according to the anisotropic metric (Simpson
+ * formula, the metric at the midpoint being the mean of the end metrics) */
+static inline
+double _MMG5_lenedg_ani_inl(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ip1,
+                            MMG5_int ip2) {
+    MMG5_pPoint   p1,p2;
+    double   *m1,*m2,ux,uy,uz,dd1,dd2;
+
+    p1 = &mesh->point[ip1];
+    p2 = &mesh->point[ip2];
+    m1 = &met->m[(ip1-1)*met->size+1];
+    m2 = &met->m[(ip2-1)*met->size+1];
+
+    ux = p2->c[0] - p1->c[0];
+    uy = p2->c[1] - p1->c[1];
+    uz = p2->c[2] - p1->c[2];
+
+    dd1 =      m1[0]*ux*ux + m1[3]*uy*uy + m1[5]*uz*uz \
+        + 2.0*(m1[1]*ux*uy + m1[2]*ux*uz + m1[4]*uy*uz);
+    dd2 =      m2[0]*ux*ux + m2[3]*uy*uy + m2[5]*uz*uz \
+        + 2.0*(m2[1]*ux*uy + m2[2]*ux*uz + m2[4]*uy*uz);
+    if ( dd1 <= 0.0 || dd2 <= 0.0 )  return(0.0);
+
+    return( (sqrt(dd1) + sqrt(dd2) + 4.0*sqrt(0.5*(dd1+dd2))) / 6.0 );
+}
+
+/** Length of edge [ip1,ip2] according to the size prescription */
+static inline
+double _MMG5_lenedg_iso_inl(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ip1,
+                            MMG5_int ip2) {
+    MMG5_pPoint   p1,p2;
+    double   h1,h2,l,r,len;
+
+    p1 = &mesh->point[ip1];
+    p2 = &mesh->point[ip2];
+    h1 = met->m[ip1];
+    h2 = met->m[ip2];
+    l = (p2->c[0]-p1->c[0])*(p2->c[0]-p1->c[0]) + (p2->c[1]-p1->c[1])*(p2->c[1]-p1->c[1]) \
+        + (p2->c[2]-p1->c[2])*(p2->c[2]-p1->c[2]);
+    l = sqrt(l);
+    r = h2 / h1 - 1.0;
+    len = fabs(r) < _MMG5_EPS ? l / h1 : l / (h2-h1) * log(r+1.0);
+
+    return(len);
+}
+
+/** Isotropic quality of the tetra (ia,ib,ic,id) */
+static inline
+double _MMG5_caltet_iso_inl(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ia,
+                            MMG5_int ib,MMG5_int ic,MMG5_int id) {
+    double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
+    double     vol,v1,v2,v3,rap;
+    double    *a,*b,*c,*d;
+
+    a = mesh->point[ia].c;
+    b = mesh->point[ib].c;
+    c = mesh->point[ic].c;
+    d = mesh->point[id].c;
+
+    /* volume */
+    abx = b[0] - a[0];
+    aby = b[1] - a[1];
+    abz = b[2] - a[2];
+    rap = abx*abx + aby*aby + abz*abz;
+
+    acx = c[0] - a[0];
+    acy = c[1] - a[1];
+    acz = c[2] - a[2];
+    rap += acx*acx + acy*acy + acz*acz;
+
+    adx = d[0] - a[0];
+    ady = d[1] - a[1];
+    adz = d[2] - a[2];
+    rap += adx*adx + ady*ady + adz*adz;
+
+    v1  = acy*adz - acz*ady;
+    v2  = acz*adx - acx*adz;
+    v3  = acx*ady - acy*adx;
+    vol = abx * v1 + aby * v2 + abz * v3;
+    if ( vol < _MMG5_EPSD2 )  return(0.0);
+
+    bcx = c[0] - b[0];
+    bcy = c[1] - b[1];
+    bcz = c[2] - b[2];
+    rap += bcx*bcx + bcy*bcy + bcz*bcz;
+
+    bdx = d[0] - b[0];
+    bdy = d[1] - b[1];
+    bdz = d[2] - b[2];
+    rap += bdx*bdx + bdy*bdy + bdz*bdz;
+
+    cdx = d[0] - c[0];
+    cdy = d[1] - c[1];
+    cdz = d[2] - c[2];
+    rap += cdx*cdx + cdy*cdy + cdz*cdz;
+    if ( rap < _MMG5_EPSD2 )  return(0.0);
+
+    /* quality = vol / len^3/2 */
+    rap = rap * sqrt(rap);
+    return(vol / rap);
+}
+
+/** Anisotropic quality of the tetra (ia,ib,ic,id): same measure as the
+ * isotropic quality, computed in the mean metric of the vertices (the
+ * vertex 0, used by the operators to check a new position, has no metric) */
+static inline
+double _MMG5_caltet_ani_inl(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ia,
+                            MMG5_int ib,MMG5_int ic,MMG5_int id) {
+    double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
+    double     vol,v1,v2,v3,rap,det,mm[6],*m;
+    double    *a,*b,*c,*d;
+    MMG5_int   v[4];
+    int        i,j,n;
+
+    a  = mesh->point[ia].c;
+    b  = mesh->point[ib].c;
+    c  = mesh->point[ic].c;
+    d  = mesh->point[id].c;
+
+    /* mean metric */
+    v[0] = ia;  v[1] = ib;  v[2] = ic;  v[3] = id;
+    memset(mm,0,6*sizeof(double));
+    n = 0;
+    for (j=0; j<4; j++) {
+        if ( !v[j] )  continue;
+        m = &met->m[(v[j]-1)*met->size+1];
+        for (i=0; i<6; i++)  mm[i] += m[i];
+        n++;
+    }
+    if ( !n )  return(0.0);
+    for (i=0; i<6; i++)  mm[i] /= n;
+    det = mm[0] * (mm[3]*mm[5] - mm[4]*mm[4]) \
+        - mm[1] * (mm[1]*mm[5] - mm[2]*mm[4]) \
+        + mm[2] * (mm[1]*mm[4] - mm[2]*mm[3]);
+    if ( det < _MMG5_EPSD2 )  return(0.0);
+
+    /* volume */
+    abx = b[0] - a[0];
+    aby = b[1] - a[1];
+    abz = b[2] - a[2];
+
+    acx = c[0] - a[0];
+    acy = c[1] - a[1];
+    acz = c[2] - a[2];
+
+    adx = d[0] - a[0];
+    ady = d[1] - a[1];
+    adz = d[2] - a[2];
+
+    v1  = acy*adz - acz*ady;
+    v2  = acz*adx - acx*adz;
+    v3  = acx*ady - acy*adx;
+    vol = abx * v1 + aby * v2 + abz * v3;
+    if ( vol < _MMG5_EPSD2 )  return(0.0);
+    vol *= sqrt(det);
+
+    bcx = c[0] - b[0];
+    bcy = c[1] - b[1];
+    bcz = c[2] - b[2];
+
+    bdx = d[0] - b[0];
+    bdy = d[1] - b[1];
+    bdz = d[2] - b[2];
+
+    cdx = d[0] - c[0];
+    cdy = d[1] - c[1];
+    cdz = d[2] - c[2];
+
+    /* length of the edges in the metric */
+    rap  = mm[0]*(abx*abx + acx*acx + adx*adx + bcx*bcx + bdx*bdx + cdx*cdx);
+    rap += mm[3]*(aby*aby + acy*acy + ady*ady + bcy*bcy + bdy*bdy + cdy*cdy);
+    rap += mm[5]*(abz*abz + acz*acz + adz*adz + bcz*bcz + bdz*bdz + cdz*cdz);
+    rap += 2.0*mm[1]*(abx*aby + acx*acy + adx*ady + bcx*bcy + bdx*bdy + cdx*cdy);
+    rap += 2.0*mm[2]*(abx*abz + acx*acz + adx*adz + bcx*bcz + bdx*bdz + cdx*cdz);
+    rap += 2.0*mm[4]*(aby*abz + acy*acz + ady*adz + bcy*bcz + bdy*bdz + cdy*cdz);
+    if ( rap < _MMG5_EPSD2 )  return(0.0);
+
+    /* quality = vol / len^3/2 */
+    rap = rap * sqrt(rap);
+    return(vol / rap);
+}
+
+#endif
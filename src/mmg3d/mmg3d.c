@@ -51,13 +51,13 @@ void MMG5_Free_all(MMG5_pMesh mesh,MMG5_pSol met
 }
 
 /**
- * \param mesh pointer toward the mesh structure (unused).
+ * \param mesh pointer toward the mesh structure.
  *
  * Set pointer for MMG5_saveMesh function.
  *
  */
 void MMG5_Set_saveFunc(MMG5_pMesh mesh) {
-    MMG5_saveMesh = _MMG5_saveAllMesh;
+    mesh->saveMesh = _MMG5_saveAllMesh;
 }
 
 /**
@@ -132,10 +132,8 @@ int main(int argc,char *argv[]) {
     else if ( ier > 0 && met.np != mesh.np ) {
         fprintf(stdout,"  ## WARNING: WRONG SOLUTION NUMBER. IGNORED\n");
         _MMG5_DEL_MEM(&mesh,met.m,(met.size*met.npmax+1)*sizeof(double));
-        met.np = 0;
-    } else if ( met.size!=1 ) {
-        fprintf(stdout,"  ## ERROR: ANISOTROPIC METRIC NOT IMPLEMENTED.\n");
-        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        met.np   = 0;
+        met.size = 1;
     }
     if ( !MMG5_parsop(&mesh,&met) )
         _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
@@ -240,6 +238,11 @@ int main(int argc,char *argv[]) {
     printim(MMG5_ctim[3].gdif,stim);
     if ( mesh.info.imprim )
         fprintf(stdout,"  -- PHASE 2 COMPLETED.     %s\n",stim);
+    if ( mesh.info.imprim > 4 && mesh.ctrealloc.call ) {
+        printim(mesh.ctrealloc.gdif,stim);
+        fprintf(stdout,"     %8d TABLE REALLOCATIONS  %s\n",
+                mesh.ctrealloc.call,stim);
+    }
     fprintf(stdout,"\n  %s\n   END OF MODULE MMG3d: IMB-LJLL \n  %s\n",MG_STR,MG_STR);
 
     /* save file */
@@ -0,0 +1,836 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+#ifndef _MMG3D_H
+#define _MMG3D_H
+
+/* Warning: never ever use assert() with a function,
+   the option -DNDEBUG suppress all assert()*/
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <string.h>
+#include <signal.h>
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+#if (defined(__APPLE__) && defined(__MACH__))
+#include <sys/sysctl.h>
+#elif defined(__unix__) || defined(__unix) || defined(unix)
+#include <unistd.h>
+#endif
+
+#include "libmmg3d.h"
+
+#define MG_VER   "5.0.;0"" c"
+#define MG_REL   "Jul. 6, 2012"
+#define MG_CPY   "Copyright (c) IMB-LJLL, 2004-"
+#define MG_STR   "&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&"
+
+/* Macros */
+#define MG_MAX(a,b) (((a) > (b)) ? (a) : (b))
+#define MG_MIN(a,b) (((a) < (b)) ? (a) : (b))
+#define MG_ABS(a)   (((a) < 0) ? -(a) : (a))
+
+#define MG_SMSGN(a,b)  (((double)(a)*(double)(b) > (0.0)) ? (1) : (0))
+
+/** Free allocated pointers of mesh and sol structure and return value val */
+#define _MMG5_RETURN_AND_FREE(mesh,met,val)do       \
+    {                                               \
+        MMG5_Free_all(mesh,met);                    \
+        return(val);                                \
+    }while(0)
+
+/** Error message when lack of memory */
+#define _MMG5_INCREASE_MEM_MESSAGE() do                         \
+    {                                                           \
+        printf("  ## Check the mesh size or increase maximal"); \
+        printf(" authorized memory with the -m option.\n");     \
+    } while(0)
+
+/** Check if used memory overflow maximal authorized memory.
+    Execute the command law if lack of memory. */
+#define _MMG5_CHK_MEM(mesh,size,string,law) do                          \
+    {                                                                   \
+        if ( ((mesh)->memCur) > ((mesh)->memMax) ||                     \
+             ((mesh)->memCur < 0 )) {                                   \
+            fprintf(stdout,"  ## Error:");                              \
+            fprintf(stdout," unable to allocate %s.\n",string);         \
+            fprintf(stdout,"  ## Check the mesh size or ");             \
+            fprintf(stdout,"increase maximal authorized memory with the -m option.\n"); \
+            (mesh)->memCur -= (long long)(size);                        \
+            law;                                                        \
+        }                                                               \
+    }while(0)
+
+/** Free pointer ptr of mesh structure and compute the new used memory.
+    size is the size of the pointer */
+#define _MMG5_DEL_MEM(mesh,ptr,size) do         \
+    {                                           \
+        (mesh)->memCur -= (long long)(size);    \
+        free(ptr);                              \
+        ptr = NULL;                             \
+    }while(0)
+
+/** Increment memory counter memCur and check if we don't overflow
+    the maximum authorizied memory memMax. */
+#define _MMG5_ADD_MEM(mesh,size,message,law) do \
+    {                                           \
+        (mesh)->memCur += (long long)(size);    \
+        _MMG5_CHK_MEM(mesh,size,message,law);   \
+    }while(0)
+
+/** Safe deallocation */
+#define _MMG5_SAFE_FREE(ptr) do                 \
+    {                                           \
+        free(ptr);                              \
+        ptr = NULL;                             \
+    }while(0)
+
+
+/** Safe allocation with calloc */
+#define _MMG5_SAFE_CALLOC(ptr,size,type) do             \
+    {                                                   \
+        ptr = (type *)calloc((size),sizeof(type));      \
+        if ( !ptr ) {                                   \
+            perror("  ## Memory problem: calloc");      \
+            exit(EXIT_FAILURE);                         \
+        }                                               \
+    }while(0)
+
+/** Safe allocation with malloc */
+#define _MMG5_SAFE_MALLOC(ptr,size,type) do             \
+    {                                                   \
+        ptr = (type *)malloc((size)*sizeof(type));      \
+        if ( !ptr ) {                                   \
+            perror("  ## Memory problem: malloc");      \
+            exit(EXIT_FAILURE);                         \
+        }                                               \
+    }while(0)
+
+/** Safe reallocation */
+#define _MMG5_SAFE_REALLOC(ptr,size,type,message) do            \
+    {                                                           \
+        type* tmp;                                              \
+        tmp = (type *)realloc((ptr),(size)*sizeof(type));       \
+        if ( !tmp ) {                                           \
+            _MMG5_SAFE_FREE(ptr);                               \
+            perror(" ## Memory problem: realloc");              \
+            exit(EXIT_FAILURE);                                 \
+        }                                                       \
+                                                                \
+        if ( abs(mesh->info.imprim) > 6 || mesh->info.ddebug )  \
+            fprintf(stdout,                                     \
+                    "  ## Warning: %s:%d: %s reallocation.\n",  \
+                    __FILE__,__LINE__,message);                 \
+                                                                \
+                                                                \
+        (ptr) = tmp;                                            \
+    }while(0)
+
+/** safe reallocation with memset at 0 for the new values of tab */
+#define _MMG5_SAFE_RECALLOC(ptr,prevSize,newSize,type,message) do   \
+    {                                                               \
+        type* tmp;                                                  \
+                                                                    \
+        tmp = (type *)realloc((ptr),(newSize)*sizeof(type));        \
+        if ( !tmp ) {                                               \
+            _MMG5_SAFE_FREE(ptr);                                   \
+            perror(" ## Memory problem: realloc");                  \
+            exit(EXIT_FAILURE);                                     \
+        }                                                           \
+                                                                    \
+        if ( abs(mesh->info.imprim) > 6 || mesh->info.ddebug )      \
+            fprintf(stdout,                                         \
+                    "  ## Warning: %s:%d: %s reallocation.\n",      \
+                    __FILE__,__LINE__,message);                     \
+                                                                    \
+        (ptr) = tmp;                                                \
+        if ( (newSize) > (prevSize) )                               \
+            memset(&(ptr)[prevSize],0,                              \
+                   ((newSize)-(prevSize))*sizeof(type));            \
+    }while(0)
+
+/** Number of new entities wanted when a table of size size is enlarged:
+    wantedGap*size with the legacy policy (\a -nogrowth), at least
+    _MMG5_GROWTH*size with the geometric one so that the number of
+    reallocations (and copies) stays logarithmic in the final size. */
+#define _MMG5_GROWGAP(mesh,wantedGap,size)                              \
+    ((MMG5_int)(((mesh)->info.growth ?                                  \
+                 MG_MAX((double)(wantedGap),_MMG5_GROWTH) :             \
+                 (double)(wantedGap))*(double)(size)))
+
+/** Enlarge the table ptr of type type to the size initSize+_MMG5_GROWGAP
+    if possible or at maximum available size (memMax) if not. Execute the
+    command law if reallocation failed. Memset to 0 for the new values of
+    table. Not timed: see _MMG5_TAB_RECALLOC. */
+#define _MMG5_TAB_GROW(mesh,ptr,initSize,wantedGap,type,message,law) do \
+    {                                                                   \
+        MMG5_int gap;                                                   \
+                                                                        \
+        gap = _MMG5_GROWGAP(mesh,wantedGap,initSize);                   \
+        if ( (mesh->memMax-mesh->memCur) <                              \
+             (long long) (gap*sizeof(type)) ) {                         \
+            gap = (MMG5_int)((mesh->memMax-mesh->memCur)/sizeof(type)); \
+            if(gap<1) {                                                 \
+                fprintf(stdout,"  ## Error:");                          \
+                fprintf(stdout," unable to allocate %s.\n",message);    \
+                fprintf(stdout,"  ## Check the mesh size or ");         \
+                fprintf(stdout,"increase maximal authorized memory with the -m option.\n"); \
+                law;                                                    \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        _MMG5_ADD_MEM(mesh,gap*sizeof(type),message,law);               \
+        _MMG5_SAFE_RECALLOC((ptr),initSize+1,initSize+gap+1,type,message); \
+        initSize = initSize+gap;                                        \
+    }while(0)
+
+/** Reallocation of ptr of type type at size (initSize+_MMG5_GROWGAP)
+    if possible or at maximum available size if not. Execute the command law
+    if reallocation failed. Memset to 0 for the new values of table. */
+#define _MMG5_TAB_RECALLOC(mesh,ptr,initSize,wantedGap,type,message,law) do \
+    {                                                                   \
+        chrono(ON,&mesh->ctrealloc);                                    \
+        _MMG5_TAB_GROW(mesh,ptr,initSize,wantedGap,type,message,law);   \
+        chrono(OFF,&mesh->ctrealloc);                                   \
+    }while(0);
+
+
+/** Reallocation of point table and sol table and creation
+    of point ip with coordinates o and tag tag*/
+#define _MMG5_POINT_REALLOC(mesh,sol,ip,wantedGap,law,o,tag ) do        \
+    {                                                                   \
+        MMG5_int klink;                                                 \
+                                                                        \
+        chrono(ON,&mesh->ctrealloc);                                    \
+        _MMG5_TAB_GROW(mesh,mesh->point,mesh->npmax,wantedGap,MMG5_Point, \
+                       "larger point table",law);                       \
+                                                                        \
+        mesh->npnil = mesh->np+1;                                       \
+        for (klink=mesh->npnil; klink<mesh->npmax-1; klink++)           \
+            mesh->point[klink].tmp  = klink+1;                          \
+                                                                        \
+        /* solution */                                                  \
+        if ( sol->m ) {                                                 \
+            _MMG5_ADD_MEM(mesh,sol->size*(mesh->npmax-sol->npmax)*sizeof(double), \
+                    "larger solution",law);                             \
+            _MMG5_SAFE_REALLOC(sol->m,sol->size*mesh->npmax+1,double,"larger solution"); \
+        }                                                               \
+        sol->npmax = mesh->npmax;                                       \
+        chrono(OFF,&mesh->ctrealloc);                                   \
+                                                                        \
+        /* We try again to add the point */                             \
+        ip = _MMG5_newPt(mesh,o,tag);                                   \
+        if ( !ip ) {law;}                                               \
+    }while(0)
+
+/** Reallocation of point table, sol table and bucket table and creation
+    of point ip with coordinates o and tag tag*/
+#define _MMG5_POINT_AND_BUCKET_REALLOC(mesh,sol,ip,wantedGap,law,o,tag ) do \
+    {                                                                   \
+        MMG5_int klink,gap;                                             \
+                                                                        \
+        chrono(ON,&mesh->ctrealloc);                                    \
+        gap = _MMG5_GROWGAP(mesh,wantedGap,mesh->npmax);                \
+        if ( (mesh->memMax-mesh->memCur) <                              \
+             (long long) (gap*(sizeof(MMG5_Point)+sizeof(MMG5_int))) ) { \
+            gap = (MMG5_int)((mesh->memMax-mesh->memCur)/               \
+                (sizeof(MMG5_Point)+sizeof(MMG5_int)));                 \
+            if(gap < 1) {                                               \
+                fprintf(stdout,"  ## Error:");                          \
+                fprintf(stdout," unable to allocate %s.\n","larger point/bucket table"); \
+                fprintf(stdout,"  ## Check the mesh size or ");         \
+                fprintf(stdout,"increase maximal authorized memory with the -m option.\n"); \
+                law;                                                    \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        _MMG5_ADD_MEM(mesh,gap*(sizeof(MMG5_Point)+sizeof(MMG5_int)),   \
+                "point and bucket",law);                                \
+        _MMG5_SAFE_RECALLOC(mesh->point,mesh->npmax+1,                  \
+                            mesh->npmax+gap+1,MMG5_Point,"larger point table"); \
+        _MMG5_SAFE_RECALLOC(bucket->link,mesh->npmax+1,                 \
+                      mesh->npmax+gap+1,MMG5_int,"larger bucket table"); \
+        mesh->npmax = mesh->npmax+gap;                                  \
+                                                                        \
+        mesh->npnil = mesh->np+1;                                       \
+        for (klink=mesh->npnil; klink<mesh->npmax-1; klink++)           \
+            mesh->point[klink].tmp  = klink+1;                          \
+                                                                        \
+        /* solution */                                                  \
+        if ( sol->m ) {                                                 \
+            _MMG5_ADD_MEM(mesh,sol->size*(mesh->npmax-sol->npmax)*sizeof(double), \
+                    "larger solution",law);                             \
+            _MMG5_SAFE_REALLOC(sol->m,sol->size*mesh->npmax+1,double,"larger solution"); \
+        }                                                               \
+        sol->npmax = mesh->npmax;                                       \
+        chrono(OFF,&mesh->ctrealloc);                                   \
+                                                                        \
+        /* We try again to add the point */                             \
+        ip = _MMG5_newPt(mesh,o,tag);                                   \
+        if ( !ip ) {law;}                                               \
+    }while(0)
+
+/** Reallocation of tetra table and creation
+    of tetra jel */
+#define _MMG5_TETRA_REALLOC(mesh,jel,wantedGap,law ) do                 \
+    {                                                                   \
+        MMG5_int klink,oldSiz;                                          \
+                                                                        \
+        chrono(ON,&mesh->ctrealloc);                                    \
+        oldSiz = mesh->nemax;                                           \
+        _MMG5_TAB_GROW(mesh,mesh->tetra,mesh->nemax,wantedGap,MMG5_Tetra, \
+                       "larger tetra table",law);                       \
+                                                                        \
+        mesh->nenil = mesh->ne+1;                                       \
+        for (klink=mesh->nenil; klink<mesh->nemax-1; klink++)           \
+            mesh->tetra[klink].v[3]  = klink+1;                         \
+                                                                        \
+        if ( mesh->adja ) {                                             \
+            /* adja table */                                            \
+            _MMG5_ADD_MEM(mesh,4*(mesh->nemax-oldSiz)*sizeof(MMG5_int), \
+                          "larger adja table",law);                     \
+            _MMG5_SAFE_RECALLOC(mesh->adja,4*mesh->ne+5,4*mesh->nemax+5,MMG5_int \
+                                ,"larger adja table");                  \
+        }                                                               \
+        chrono(OFF,&mesh->ctrealloc);                                   \
+                                                                        \
+        /* We try again to add the point */                             \
+        jel = _MMG5_newElt(mesh);                                       \
+        if ( !jel ) {law;}                                              \
+    }while(0)
+
+/* numerical accuracy */
+#define _MMG5_ALPHAD    20.7846096908265    //0.04811252243247      /* 12*sqrt(3) */
+#define _MMG5_LLONG     2.5//2.0   // 1.414213562373
+#define _MMG5_LSHRT     0.3  // 0.707106781186
+#define _MMG5_LOPTL     1.3
+#define _MMG5_LOPTS     0.6
+#define _MMG5_ANGEDG    0.707106781186548   /*0.573576436351046 */
+#define _MMG5_ANGLIM   -0.999999
+#define _MMG5_SQR32     0.866025403784
+#define _MMG5_ATHIRD    0.333333333333
+#define _MMG5_EPSD      1.e-30
+#define _MMG5_EPSD2     1.0e-200
+#define _MMG5_EPS       1.e-06
+#define _MMG5_LMAX      10240
+#define _MMG5_BADKAL    0.2
+#define _MMG5_NULKAL    1.e-30
+
+#define _MMG5_NPMAX  1000000 //200000
+#define _MMG5_NAMAX   200000 //40000
+#define _MMG5_NTMAX  2000000 //400000
+#define _MMG5_NEMAX  6000000 //1200000
+
+#define _MMG5_MEMMAX  800 //160
+#define _MMG5_BOXSIZE 500
+#define _MMG5_GROWTH  0.5 /**< minimal relative growth of the reallocated tables */
+
+/* values of info.renum */
+#define _MMG5_RENUM_SCOTCH  1 /**< renumbering with Scotch */
+#define _MMG5_RENUM_HILBERT 2 /**< renumbering along a Hilbert curve */
+#define _MMG5_RENUM_MORTON  3 /**< renumbering along a Morton curve */
+
+/* reordering during the adaptation loop (see _MMG5_locality) */
+#define _MMG5_LOCWIN   4096 /**< index distance of two neighbours considered as far */
+#define _MMG5_LOCALITY 0.25 /**< ratio of far neighbours triggering a reordering */
+
+/* final size estimation (see _MMG5_countelt) */
+#define _MMG5_VOLUNIT 0.117851130197758 /**< volume of the unit regular tetra (sqrt(2)/12) */
+#define _MMG5_NECOEF  1.6 /**< number of tetra per unit regular tetra volume */
+#define _MMG5_NENP    5.8 /**< number of tetra per vertex */
+#define _MMG5_PRESIZE 1.2 /**< margin of the preallocated tables */
+
+/* lists of indices filled by the fast mesh readers (see _MMG5_loadMeshEnd) */
+#define _MMG5_LST_VERREQ 0 /**< required vertices */
+#define _MMG5_LST_CRN    1 /**< corners */
+#define _MMG5_LST_TRIREQ 2 /**< required triangles */
+#define _MMG5_LST_EDGREQ 3 /**< required edges */
+#define _MMG5_LST_RID    4 /**< ridges */
+#define _MMG5_LST_TETREQ 5 /**< required tetrahedra */
+#define _MMG5_LST_NUM    6
+
+#define _MMG5_WBASE 1 /**< numbered entity (see _MMG5_wfunc) */
+#define _MMG5_WSEL  2 /**< written entity (see _MMG5_wfunc) */
+
+#ifndef M_PI
+#define M_PI            3.14159265358979323846   /**< pi   */
+#define M_PI_2          1.57079632679489661923   /**< pi/2 */
+#endif
+
+/* tags */
+#define  MG_NOTAG     (0)
+#define  MG_REF       (1 << 0)        /**< 1  edge reference  */
+#define  MG_GEO       (1 << 1)        /**< 2  geometric ridge */
+#define  MG_REQ       (1 << 2)        /**< 4  required entity */
+#define  MG_NOM       (1 << 3)        /**< 8  non manifold    */
+#define  MG_BDY       (1 << 4)        /**< 16  boundary entity */
+#define  MG_CRN       (1 << 5)        /**< 32  corner         */
+#define  MG_NUL       (1 << 6)        /**< 64  vertex removed */
+#define  MG_FRZ       (1 << 7)        /**< 128 frozen entity (tetra, edge, tagdel) */
+
+#define MG_PLUS    2
+#define MG_MINUS   3
+#define MG_ISO    10
+
+#define MG_VOK(ppt)      (ppt && ((ppt)->tag < MG_NUL)) /**< Vertex OK */
+#define MG_EOK(pt)       (pt && ((pt)->v[0] > 0))       /**< Element OK */
+#define MG_EDG(tag)      ((tag & MG_GEO) || (tag & MG_REF)) /**< Edge or Ridge */
+#define MG_SIN(tag)      ((tag & MG_CRN) || (tag & MG_REQ)) /**< Corner or Required */
+
+#define MG_SET(flag,bit) ((flag) |= (1 << (bit)))  /**< bit number bit is set to 1 */
+#define MG_CLR(flag,bit) ((flag) &= ~(1 << (bit))) /**< bit number bit is set to 0 */
+#define MG_GET(flag,bit) ((flag) & (1 << (bit)))   /**< return bit number bit value */
+
+extern unsigned char _MMG5_inxt2[3];   /**< next vertex of triangle: {1,2,0} */
+extern unsigned char _MMG5_iprv2[3];   /**< previous vertex of triangle: {2,0,1} */
+extern unsigned char _MMG5_inxt3[7];   /**< next vertex of tetra: {1,2,3,0,1,2,3} */
+extern unsigned char _MMG5_iprv3[7];   /**< previous vertex of tetra: {3,0,1,2,3,0,1} */
+extern unsigned char _MMG5_idir[4][3]; /**< idir[i] : vertices of face opposite to vertex i */
+extern          char _MMG5_idirinv[4][4]; /**< idirinv[i][j] : num of the jth point in the ith face */
+extern unsigned char _MMG5_iarf[4][3]; /**< iarf[i]: edges of face opposite to vertex i */
+extern unsigned char _MMG5_iarfinv[4][6]; /**< num of the j^th edge in the i^th face */
+extern unsigned char _MMG5_iare[6][2]; /**< vertices of extremities of the edges of the tetra */
+extern unsigned char _MMG5_ifar[6][2]; /**< ifar[i][]: faces sharing the ith edge of the tetra */
+extern unsigned char _MMG5_isar[6][2]; /**< isar[i][]: vertices of extremities of the edge opposite to the ith edge */
+extern unsigned char _MMG5_arpt[4][3]; /**< arpt[i]: edges passing through vertex i */
+
+
+typedef struct {
+    double  b[10][3]; /**< Bezier basis functions */
+    double  n[6][3],t[6][3]; /**< normals and tangents at points */
+    MMG5_pPoint  p[3];
+} _MMG5_Bezier;
+typedef _MMG5_Bezier * _MMG5_pBezier;
+
+/** used to hash edges */
+/** Unsigned integer of the size of the indices (hash keys) */
+#ifdef MMG5_INT64
+typedef uint64_t     _MMG5_uint;
+#else
+typedef unsigned int _MMG5_uint;
+#endif
+
+typedef struct {
+    MMG5_int a,b,nxt;
+    MMG5_int s,k; /** k = point along edge a b */
+} _MMG5_hedge;
+
+typedef struct {
+    MMG5_int     siz,max,nxt;
+    _MMG5_hedge  *item;
+} _MMG5_Hash;
+
+/** Key of an edge of \ref _MMG5_EdgeMap: (min,max) vertices packed in 64
+ * bits, or stored side by side with 64 bits indices */
+#ifdef MMG5_INT64
+typedef struct {
+    MMG5_int a,b;
+} _MMG5_ekey;
+#else
+typedef unsigned long long _MMG5_ekey;
+#endif
+
+/** open-addressing hash table of edges (linear probing) */
+typedef struct {
+    MMG5_int            siz;  /**< size of the table */
+    MMG5_int            nitem;/**< number of stored edges */
+    _MMG5_ekey         *key;  /**< (min,max) vertices, min=0 if empty slot */
+    MMG5_int           *val;  /**< value stored along the edges */
+} _MMG5_EdgeMap;
+
+/* batches of the vectorized kernels (see simd.c) */
+#define _MMG5_BATCH        64 /**< maximal number of entities of a batch */
+#define _MMG5_SIMD_SCALAR  0  /**< scalar kernels */
+#define _MMG5_SIMD_SSE2    1  /**< SSE2 kernels (2 lanes) */
+#define _MMG5_SIMD_AVX2    2  /**< AVX2 kernels (4 lanes) */
+#define _MMG5_SIMD_AVX512  3  /**< AVX-512 kernels (8 lanes) */
+
+/** batch of tetrahedra: x[j][k] is the first coordinate of the vertex j of
+ * the k-th tetrahedron */
+typedef struct {
+    double  x[4][_MMG5_BATCH],y[4][_MMG5_BATCH],z[4][_MMG5_BATCH];
+    int     n; /**< number of tetrahedra */
+} _MMG5_TetBatch;
+typedef _MMG5_TetBatch * _MMG5_pTetBatch;
+
+/** batch of edges with the isotropic sizes at their extremities */
+typedef struct {
+    double  x[2][_MMG5_BATCH],y[2][_MMG5_BATCH],z[2][_MMG5_BATCH];
+    double  h[2][_MMG5_BATCH];
+    int     n; /**< number of edges */
+} _MMG5_EdgBatch;
+typedef _MMG5_EdgBatch * _MMG5_pEdgBatch;
+
+/** kernels of an instruction set */
+typedef struct {
+    void (*orvol)(_MMG5_pTetBatch,double*);
+    void (*caltet)(_MMG5_pTetBatch,double*);
+    void (*lenedg)(_MMG5_pEdgBatch,double*);
+} _MMG5_SimdKer;
+
+/** add the tetrahedron of vertices coordinates \a c0, \a c1, \a c2, \a c3
+ * to the batch \a b */
+#define _MMG5_BATCH_TET(b,c0,c1,c2,c3) do                               \
+    {                                                                   \
+        int _k = (b)->n++;                                              \
+        (b)->x[0][_k] = (c0)[0]; (b)->y[0][_k] = (c0)[1]; (b)->z[0][_k] = (c0)[2]; \
+        (b)->x[1][_k] = (c1)[0]; (b)->y[1][_k] = (c1)[1]; (b)->z[1][_k] = (c1)[2]; \
+        (b)->x[2][_k] = (c2)[0]; (b)->y[2][_k] = (c2)[1]; (b)->z[2][_k] = (c2)[2]; \
+        (b)->x[3][_k] = (c3)[0]; (b)->y[3][_k] = (c3)[1]; (b)->z[3][_k] = (c3)[2]; \
+    }while(0)
+
+/** add the edge of extremities \a c0, \a c1 of sizes \a h0, \a h1 to the
+ * batch \a b */
+#define _MMG5_BATCH_EDG(b,c0,c1,h0,h1) do                               \
+    {                                                                   \
+        int _k = (b)->n++;                                              \
+        (b)->x[0][_k] = (c0)[0]; (b)->y[0][_k] = (c0)[1]; (b)->z[0][_k] = (c0)[2]; \
+        (b)->x[1][_k] = (c1)[0]; (b)->y[1][_k] = (c1)[1]; (b)->z[1][_k] = (c1)[2]; \
+        (b)->h[0][_k] = (h0);    (b)->h[1][_k] = (h1);                  \
+    }while(0)
+
+/** output file of the buffered writers (see inout_write.c) */
+typedef struct {
+    FILE       *out;
+    char      **buf;  /**< formatting buffer of each thread */
+    void       *data; /**< entities read by the formatting functions */
+    long long   pos;  /**< current position in the binary file */
+    int         bin;  /**< 1 for a binary file */
+    int         ver;  /**< file version (3: 64 bits positions, 4: 64 bits integers) */
+    int         isz;  /**< size of the binary integers */
+    int         psz;  /**< size of the binary positions */
+    int         nthr; /**< number of threads */
+    int         tag;  /**< tag selecting the entities of a list section */
+    int         err;  /**< 1 if a write failed */
+} _MMG5_wfile;
+
+/** formatting function of a section: if \a out is NULL, return
+ * _MMG5_WBASE if entity \a k is numbered and _MMG5_WSEL if it is written,
+ * else write entity \a k of index \a idx in \a out and return the number
+ * of bytes written */
+typedef int (*_MMG5_wfunc)(MMG5_pMesh,_MMG5_wfile*,MMG5_int k,MMG5_int idx,char *out);
+
+/** section of a mesh or solution file */
+typedef struct {
+    const char  *name; /**< keyword (ASCII) */
+    const char  *nsep; /**< separator after the number of entities (ASCII) */
+    int          kw;   /**< keyword code (binary) */
+    int          nint; /**< number of integers per entity (binary) */
+    int          ndbl; /**< number of doubles per entity (binary) */
+    int          nsol; /**< number of solutions (solution files only) */
+    int          opt;  /**< 1 if the section is not written when empty */
+    _MMG5_wfunc  f;
+} _MMG5_wkwd;
+
+/** filter of the points too close to each other: uniform grid of \a size^3
+ * cells or, for strongly graded size maps, sparse grids of cells whose size
+ * depends on the local size of the points (adaptive mode) */
+typedef struct {
+    int       size;
+    MMG5_int *head;
+    MMG5_int *link;
+    /* adaptive mode */
+    int                 nlev;  /**< number of levels (0: uniform grid) */
+    int                 levs;  /**< bit l set if level l contains points */
+    int                 hsiz;  /**< size of the hash table of cells */
+    int                 hnum;  /**< number of cells in the hash table */
+    unsigned long long *hkey;  /**< level and indices of the cells */
+    MMG5_int           *hhead; /**< first point of the cells */
+    MMG5_pSol           met;   /**< size map used to choose the levels */
+} _MMG5_Bucket;
+typedef _MMG5_Bucket * _MMG5_pBucket;
+
+/** circumsphere of a tetrahedron, valid while its vertices and quality are
+ * unchanged */
+typedef struct {
+    double  c[3],rad; /**< center and squared radius (rad<0: flat element) */
+    double  qual;     /**< quality of the element at the computation */
+    MMG5_int v[4];    /**< vertices of the element at the computation */
+} _MMG5_Sphere;
+
+/** scratch memory reused by the delaunay kernel between insertions */
+typedef struct {
+    _MMG5_Hash    hedg;    /**< hash table of the internal faces of the ball */
+    MMG5_int     *ielnum;  /**< new elements of the ball */
+    MMG5_int     *list;    /**< cavity list */
+    _MMG5_Sphere *sph;     /**< circumsphere cache (may be NULL) */
+    MMG5_int      nsph;    /**< size of the circumsphere cache */
+    long long     nhit,nmiss; /**< cache hits and misses */
+    int           cas;     /**< type of the last cavity correction */
+    int           npuiss,nvol,npres,npd; /**< statistics of the kernel */
+} _MMG5_Scratch;
+typedef _MMG5_Scratch * _MMG5_pScratch;
+
+/* bucket */
+_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh ,MMG5_pSol ,int );
+void    _MMG5_freeBucket(MMG5_pMesh ,_MMG5_pBucket );
+int     _MMG5_permBucket(MMG5_pMesh ,_MMG5_pBucket ,MMG5_int *,MMG5_int );
+int     _MMG5_addBucket(MMG5_pMesh ,_MMG5_pBucket ,MMG5_int );
+int     _MMG5_delBucket(MMG5_pMesh ,_MMG5_pBucket ,MMG5_int );
+int     _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,MMG5_int ip);
+int     _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,MMG5_int ip);
+#define _MMG5_buckin(mesh,sol,bucket,ip)                                \
+    ((sol)->size == 1 ? _MMG5_buckin_iso((mesh),(sol),(bucket),(ip))    \
+                      : _MMG5_buckin_ani((mesh),(sol),(bucket),(ip)))
+/* prototypes */
+void   _MMG5_rotmatrix(double n[3],double r[3][3]);
+double _MMG5_det3pt1vec(double c0[3],double c1[3],double c2[3],double v[3]);
+double _MMG5_det4pt(double c0[3],double c1[3],double c2[3],double c3[3]);
+double _MMG5_orvol(MMG5_pPoint point,MMG5_int *v);
+int _MMG5_directsurfball(MMG5_pMesh mesh, MMG5_int ip, MMG5_int *list, int ilist, double n[3]);
+
+MMG5_int _MMG5_newPt(MMG5_pMesh mesh,double c[3],char tag);
+MMG5_int _MMG5_newElt(MMG5_pMesh mesh);
+void _MMG5_delElt(MMG5_pMesh mesh,MMG5_int iel);
+void _MMG5_delPt(MMG5_pMesh mesh,MMG5_int ip);
+int  _MMG5_zaldy(MMG5_pMesh mesh);
+int  _MMG5_presize(MMG5_pMesh mesh,MMG5_pSol met);
+void _MMG5_freeXTets(MMG5_pMesh mesh);
+char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_pTria pt,char ori);
+int  _MMG5_chkNumberOfTri(MMG5_pMesh mesh);
+void _MMG5_tet2tri(MMG5_pMesh mesh,MMG5_int k,char ie,MMG5_Tria *ptt);
+int    _MMG5_bezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori);
+int    _MMG5_BezierTgt(double c1[3],double c2[3],double n1[3],double n2[3],double t1[3],double t2[3]);
+double _MMG5_BezierGeod(double c1[3], double c2[3], double t1[3], double t2[3]);
+int  _MMG5_bezierInt(_MMG5_pBezier pb,double uv[2],double o[3],double no[3],double to[3]);
+int  _MMG5_BezierReg(MMG5_pMesh mesh,MMG5_int ip0, MMG5_int ip1, double s, double v[3], double *o, double *no);
+int  _MMG5_BezierRef(MMG5_pMesh mesh,MMG5_int ip0, MMG5_int ip1, double s, double *o, double *no, double *to);
+int  _MMG5_BezierEdge(MMG5_pMesh mesh,MMG5_int ip0, MMG5_int ip1, double b0[3], double b1[3],char isrid, double v[3]);
+int  _MMG5_BezierRidge(MMG5_pMesh mesh,MMG5_int ip0, MMG5_int ip1, double s, double *o, double *no1, double *no2, double *to);
+int  _MMG5_BezierNom(MMG5_pMesh mesh,MMG5_int ip0,MMG5_int ip1,double s,double *o,double *no,double *to);
+int  _MMG5_norface(MMG5_pMesh mesh ,MMG5_int k, int iface, double v[3]);
+int  _MMG5_boulen(MMG5_pMesh mesh,MMG5_int start,int ip,double *nn);
+int  _MMG5_bouler(MMG5_pMesh mesh,MMG5_int start,int ip,MMG5_int *list,int *ng,int *nr);
+int  _MMG5_boulenm(MMG5_pMesh mesh, MMG5_int start, int ip, int iface, double n[3],double t[3]);
+int  _MMG5_boulec(MMG5_pMesh mesh,MMG5_int start,int ip,double *tt);
+int  _MMG5_boulevolp(MMG5_pMesh mesh, MMG5_int start, int ip, MMG5_int * list);
+int  _MMG5_boulesurfvolp(MMG5_pMesh mesh,MMG5_int start,int ip,int iface,MMG5_int *listv,int *ilistv,MMG5_int *lists,int*ilists);
+int  _MMG5_startedgsurfball(MMG5_pMesh mesh,MMG5_int nump,MMG5_int numq,MMG5_int *list,int ilist);
+int  _MMG5_srcbdy(MMG5_pMesh mesh,MMG5_int start,int ia);
+int  _MMG5_coquil(MMG5_pMesh mesh, MMG5_int start, int ia, MMG5_int * list);
+int  _MMG5_coquilface(MMG5_pMesh mesh, MMG5_int start, int ia, MMG5_int * list, MMG5_int * it1, MMG5_int *it2);
+int  _MMG5_settag(MMG5_pMesh,MMG5_int,int,int,int);
+int  _MMG5_deltag(MMG5_pMesh,MMG5_int,int,int);
+int  _MMG5_chkcol_int(MMG5_pMesh ,MMG5_pSol met,MMG5_int,char,char,MMG5_int *,char typchk);
+int  _MMG5_chkcol_int_iso(MMG5_pMesh ,MMG5_pSol met,MMG5_int,char,char,MMG5_int *,char typchk);
+int  _MMG5_chkcol_int_ani(MMG5_pMesh ,MMG5_pSol met,MMG5_int,char,char,MMG5_int *,char typchk);
+int  _MMG5_chkcol_ball(MMG5_pMesh ,MMG5_pSol met,MMG5_int,char,char,MMG5_int *,int,char typchk);
+int  _MMG5_chkcol_ball_iso(MMG5_pMesh ,MMG5_pSol met,MMG5_int,char,char,MMG5_int *,int,char typchk);
+int  _MMG5_chkcol_ball_ani(MMG5_pMesh ,MMG5_pSol met,MMG5_int,char,char,MMG5_int *,int,char typchk);
+int  _MMG5_chkcol_bdy(MMG5_pMesh,MMG5_pSol,MMG5_int,char,char,MMG5_int *);
+int  _MMG5_chkmanicoll(MMG5_pMesh mesh,MMG5_int k,int iface,int iedg,MMG5_int ndepmin,MMG5_int ndepplus,char isminp,char isplp);
+int  _MMG5_chkmani(MMG5_pMesh mesh);
+MMG5_int _MMG5_colver(MMG5_pMesh,MMG5_pSol,MMG5_int *,int,char);
+int  _MMG5_analys(MMG5_pMesh mesh);
+int  _MMG5_hashTetra(MMG5_pMesh mesh, int pack);
+void _MMG5_paktet(MMG5_pMesh mesh);
+int  _MMG5_hashTria(MMG5_pMesh mesh);
+int  _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int a,MMG5_int b,MMG5_int k);
+MMG5_int _MMG5_hashGet(_MMG5_Hash *hash,MMG5_int a,MMG5_int b);
+int  _MMG5_hashPop(_MMG5_Hash *hash,MMG5_int a,MMG5_int b);
+int  _MMG5_hashNew(MMG5_pMesh mesh, _MMG5_Hash *hash,MMG5_int hsiz,MMG5_int hmax);
+MMG5_int _MMG5_hashPendFace(MMG5_pMesh mesh,_MMG5_Hash *hash,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int code);
+int  _MMG5_hashPendDel(_MMG5_Hash *hash,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int code);
+int  _MMG5_edgeMapNew(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int nedge);
+void _MMG5_edgeMapFree(MMG5_pMesh mesh,_MMG5_EdgeMap *map);
+int  _MMG5_edgeMapAdd(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int a,MMG5_int b,MMG5_int val);
+int  _MMG5_edgeMapBulk(MMG5_pMesh mesh,_MMG5_EdgeMap *map,MMG5_int n,MMG5_int *edg,MMG5_int *val);
+MMG5_int _MMG5_edgeMapGet(_MMG5_EdgeMap *map,MMG5_int a,MMG5_int b);
+int  _MMG5_edgeMapPop(_MMG5_EdgeMap *map,MMG5_int a,MMG5_int b);
+int  _MMG5_edgeMapNext(_MMG5_EdgeMap *map,MMG5_int *pos,MMG5_int *a,MMG5_int *b,MMG5_int *val);
+const _MMG5_SimdKer *_MMG5_simdKernels(int isa);
+void _MMG5_batchOrvol(_MMG5_pTetBatch b,double *vol);
+void _MMG5_batchCaltet(_MMG5_pTetBatch b,double *qual);
+void _MMG5_batchLenedg(_MMG5_pEdgBatch b,double *len);
+int  _MMG5_hPop(MMG5_HGeom *hash,MMG5_int a,MMG5_int b,int *ref,char *tag);
+int  _MMG5_hTag(MMG5_HGeom *hash,MMG5_int a,MMG5_int b,int ref,char tag);
+int  _MMG5_hGet(MMG5_HGeom *hash,MMG5_int a,MMG5_int b,int *ref,char *tag);
+void _MMG5_hEdge(MMG5_pMesh mesh,MMG5_int a,MMG5_int b,int ref,char tag);
+int  _MMG5_hNew(MMG5_HGeom *hash,MMG5_int hsiz,MMG5_int hmax,int secure);
+int  _MMG5_hGeom(MMG5_pMesh mesh);
+int  _MMG5_bdryTria(MMG5_pMesh );
+int  _MMG5_bdryIso(MMG5_pMesh );
+int  _MMG5_bdrySet(MMG5_pMesh );
+int  _MMG5_bdryUpdate(MMG5_pMesh );
+int  _MMG5_bdryPerm(MMG5_pMesh );
+int  _MMG5_chkmsh(MMG5_pMesh,int,MMG5_int);
+int  _MMG5_chkfemtopo(MMG5_pMesh mesh);
+int  _MMG5_cntbdypt(MMG5_pMesh mesh, MMG5_int nump);
+long long _MMG5_memSize(void);
+void _MMG5_memOption(MMG5_pMesh mesh);
+int  _MMG5_mmg3d1_pattern(MMG5_pMesh ,MMG5_pSol );
+int  _MMG5_mmg3d1_delone(MMG5_pMesh ,MMG5_pSol );
+int  _MMG5_mmg3d2(MMG5_pMesh ,MMG5_pSol );
+int  _MMG5_split1_sim(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6]);
+void _MMG5_split1(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+int  _MMG5_split1b(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,MMG5_int ip,int cas);
+int  _MMG5_split2sf_sim(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6]);
+void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+int  _MMG5_split3_sim(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6]);
+void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+void _MMG5_split6(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend);
+int  _MMG5_split4bar(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,_MMG5_Hash *pend);
+int  _MMG5_simbulgept(MMG5_pMesh mesh,MMG5_pSol met, MMG5_int *list, int ilist, double o[3]);
+int  _MMG5_dichoto1b(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,double o[3],double ro[3]);
+void _MMG5_nsort(int ,double *,char *);
+int  _MMG5_nortri(MMG5_pMesh mesh,MMG5_pTria pt,double *n);
+double _MMG5_orcal(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int iel);
+void   _MMG5_tetqua(MMG5_pMesh mesh,MMG5_pSol met);
+int    _MMG5_movintpt_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list, int ilist, int improve);
+int    _MMG5_movintpt_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list, int ilist, int improve);
+int    _MMG5_movbdyregpt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv, int ilistv, MMG5_int *lists, int ilists);
+int    _MMG5_movbdyrefpt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv, int ilistv, MMG5_int *lists, int ilists);
+int    _MMG5_movbdynompt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv, int ilistv, MMG5_int *lists, int ilists);
+int    _MMG5_movbdyridpt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv, int ilistv, MMG5_int *lists, int ilists);
+double _MMG5_caltri(MMG5_pMesh mesh,MMG5_pTria ptt);
+int  _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met);
+int  _MMG5_unscaleMesh(MMG5_pMesh mesh,MMG5_pSol met);
+int  _MMG5_chkswpbdy(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ilist,MMG5_int it1,MMG5_int it2);
+int  _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,MMG5_int it1,_MMG5_pBucket bucket);
+int  _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int nconf, int ilist, MMG5_int *list,_MMG5_pBucket bucket);
+MMG5_int _MMG5_chkswpgen(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int start, int ia, int *ilist, MMG5_int *list,double crit);
+MMG5_int _MMG5_chkswpgen_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int start, int ia, int *ilist, MMG5_int *list,double crit);
+MMG5_int _MMG5_chkswpgen_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int start, int ia, int *ilist, MMG5_int *list,double crit);
+int  _MMG5_srcface(MMG5_pMesh mesh,MMG5_int n0,MMG5_int n1,MMG5_int n2);
+int  _MMG5_bouleext(MMG5_pMesh mesh, MMG5_int start, int ip, int iface, MMG5_int *listv, int *ilistv, MMG5_int *lists, int*ilists);
+int _MMG5_chkptonbdy(MMG5_pMesh,MMG5_int);
+int _MMG5_norpts(MMG5_pMesh,MMG5_int,MMG5_int,MMG5_int,double *);
+double _MMG5_orcal_poi(double a[3],double b[3],double c[3],double d[3]);
+int _MMG5_countelt(MMG5_pMesh mesh,MMG5_pSol sol,double *weightelt,
+                   MMG5_int *npcible,MMG5_int *necible);
+int _MMG5_trydisp(MMG5_pMesh,double *,short);
+int _MMG5_dichodisp(MMG5_pMesh,double *);
+int _MMG5_lapantilap(MMG5_pMesh,double *);
+int _MMG5_ppgdisp(MMG5_pMesh,double *);
+int _MMG5_denoisbdy(MMG5_pMesh);
+int _MMG5_eigensym(double m[3],double lambda[2],double vp[2][2]);
+int _MMG5_sys33sym(double a[6], double b[3], double r[3]);
+void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met);
+MMG5_int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met);
+int _MMG5_prilen(MMG5_pMesh mesh,MMG5_pSol met);
+int _MMG5_DoSol(MMG5_pMesh mesh,MMG5_pSol met);
+/* useful functions to debug */
+MMG5_int _MMG5_indElt(MMG5_pMesh mesh,MMG5_int kel);
+MMG5_int _MMG5_indPt(MMG5_pMesh mesh,MMG5_int kp);
+void _MMG5_printTria(MMG5_pMesh mesh,char* fileName);
+void _MMG5_printTetra(MMG5_pMesh mesh,char* fileName);
+int  _MMG5_saveAllMesh(MMG5_pMesh mesh);
+int  _MMG5_saveLibraryMesh(MMG5_pMesh mesh);
+int  _MMG5_loadMesh(MMG5_pMesh mesh,int fast);
+int  _MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met,int fast);
+int  _MMG5_loadMeshEnd(MMG5_pMesh mesh,MMG5_int *lst[],MMG5_int nlst[]);
+int  _MMG5_loadMeshAscii(MMG5_pMesh mesh,const char *buf,size_t len);
+int  _MMG5_loadMetAscii(MMG5_pMesh mesh,MMG5_pSol met,const char *buf,size_t len);
+char *_MMG5_mapFile(FILE *inm,size_t *len,int *mapped);
+void _MMG5_unmapFile(char *buf,size_t len,int mapped);
+int  _MMG5_wopen(MMG5_pMesh mesh,_MMG5_wfile *w,FILE *out,int bin,long long siz,long long nmax);
+int  _MMG5_wclose(MMG5_pMesh mesh,_MMG5_wfile *w);
+MMG5_int _MMG5_wsection(MMG5_pMesh mesh,_MMG5_wfile *w,const _MMG5_wkwd *kwd,MMG5_int beg,MMG5_int end,int typ);
+int  _MMG5_wint(_MMG5_wfile *w,char *out,MMG5_int val,const char *sep);
+int  _MMG5_wdbl(_MMG5_wfile *w,char *out,double val,const char *sep);
+
+#ifdef USE_SCOTCH
+int _MMG5_renumbering(int vertBoxNbr, MMG5_pMesh mesh, MMG5_pSol sol);
+#endif
+int _MMG5_scotchCall(MMG5_pMesh mesh, MMG5_pSol sol);
+int _MMG5_sfcRenum(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *perm,int type);
+int _MMG5_sfcCall(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket);
+double _MMG5_locality(MMG5_pMesh mesh);
+int _MMG5_sfcReorder(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket);
+
+int    _MMG5_meancur(MMG5_pMesh mesh,MMG5_int np,double c[3],int ilist,MMG5_int *list,double h[3]);
+double _MMG5_surftri(MMG5_pMesh,MMG5_int,MMG5_int);
+double _MMG5_timestepMCF(MMG5_pMesh,double);
+int    _MMG5_bdyMCF(MMG5_pMesh);
+double _MMG5_volint(MMG5_pMesh);
+
+/* Delaunay functions*/
+int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int ip,MMG5_int *list,int ilist,
+                 _MMG5_pScratch scr);
+int _MMG5_delone_size(MMG5_pMesh mesh,MMG5_int *list,int ilist,int base,int *nxt);
+void _MMG5_delone_fill(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int ip,MMG5_int *list,
+                       int ilist,int base,_MMG5_Hash *hedg,MMG5_int *ielnum,
+                       MMG5_int ixt);
+_MMG5_pScratch _MMG5_newScratch(MMG5_pMesh mesh);
+void _MMG5_freeScratch(MMG5_pMesh mesh,_MMG5_pScratch scr);
+void _MMG5_growScratch(MMG5_pMesh mesh,_MMG5_pScratch scr);
+int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int iel,MMG5_int ip,MMG5_int *list,int lon,
+                 _MMG5_pScratch scr);
+int _MMG5_cavity_iso(MMG5_pMesh mesh,_MMG5_pScratch scr,double *c0,int base,
+                     MMG5_int *list,int lon,int *preg,int reg,int mark0,int *cas);
+int _MMG5_cavity_ani(MMG5_pMesh mesh,_MMG5_pScratch scr,double *c0,double *mp,
+                     int base,MMG5_int *list,int lon,int *preg,int reg,int mark0,
+                     int *cas);
+#ifdef USE_OPENMP
+int _MMG5_regions(MMG5_pMesh mesh,_MMG5_pBucket bucket,int shift,int **preg);
+int _MMG5_delone_mt(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                    _MMG5_pScratch scr,double lopt,MMG5_int *ifilt,MMG5_int *ns,int *warn);
+#endif
+int _MMG5_cenrad_iso(MMG5_pMesh mesh,double *ct,double *c,double *rad);
+int _MMG5_cenrad_ani(MMG5_pMesh mesh,double *ct,double *m,double *c,double *rad);
+
+/*mmg3d1.c*/
+void _MMG5_tet2tri(MMG5_pMesh mesh,MMG5_int k,char ie,MMG5_Tria *ptt);
+int  _MMG5_dichoto(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int *vx);
+/** Find acceptable position for split1b, passing the shell of considered edge, starting from o */
+int _MMG5_dichoto1b(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,double o[3],double ro[3]);
+/** return edges of (virtual) triangle pt that need to be split w/r Hausdorff criterion */
+char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_Tria *pt,char ori);
+int  _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) ;
+MMG5_int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin);
+MMG5_int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket);
+MMG5_int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket);
+
+/* pointers */
+double _MMG5_caltet_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int id);
+double _MMG5_caltet_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int id);
+double _MMG5_lenedg_ani(MMG5_pMesh ,MMG5_pSol ,MMG5_int ,MMG5_int );
+double _MMG5_lenedg_iso(MMG5_pMesh ,MMG5_pSol ,MMG5_int ,MMG5_int );
+double _MMG5_lenedgCoor_ani(double*, double*, double*, double*);
+double _MMG5_lenedgCoor_iso(double*, double*, double*, double*);
+int    _MMG5_defsiz_iso(MMG5_pMesh,MMG5_pSol );
+int    _MMG5_defsiz_ani(MMG5_pMesh ,MMG5_pSol );
+int    _MMG5_gradsiz_iso(MMG5_pMesh ,MMG5_pSol );
+int    _MMG5_gradsiz_ani(MMG5_pMesh ,MMG5_pSol );
+int    _MMG5_intmet_iso(MMG5_pMesh,MMG5_pSol,MMG5_int,MMG5_int,MMG5_int,double);
+int    _MMG5_intmet_ani(MMG5_pMesh,MMG5_pSol,MMG5_int,MMG5_int,MMG5_int,double);
+
+/* the pointers are stored in the mesh (see _MMG5_setfunc) */
+#define _MMG5_caltet(mesh,met,ia,ib,ic,id)                      \
+    ((mesh)->caltet((mesh),(met),(ia),(ib),(ic),(id)))
+#define _MMG5_lenedg(mesh,met,ia,ib) ((mesh)->lenedg((mesh),(met),(ia),(ib)))
+#define _MMG5_defsiz(mesh,met)       ((mesh)->defsiz((mesh),(met)))
+#define _MMG5_gradsiz(mesh,met)      ((mesh)->gradsiz((mesh),(met)))
+#define _MMG5_intmet(mesh,met,ip1,ip2,ip,s)                     \
+    ((mesh)->intmet((mesh),(met),(ip1),(ip2),(ip),(s)))
+
+#endif
@@ -37,8 +37,7 @@
  */
 
 #include "mmg3d.h"
-
-char  ddb;
+#include "metric_kernels.h"
 
 /**
  * \param mesh pointer toward the mesh structure.
@@ -49,7 +48,7 @@ char  ddb;
  * Set triangle corresponding to face ie of tetra k.
  *
  */
-void _MMG5_tet2tri(MMG5_pMesh mesh,int k,char ie,MMG5_Tria *ptt) {
+void _MMG5_tet2tri(MMG5_pMesh mesh,MMG5_int k,char ie,MMG5_Tria *ptt) {
     MMG5_pTetra  pt;
     MMG5_pxTetra pxt;
     char    i;
@@ -85,12 +84,13 @@ void _MMG5_tet2tri(MMG5_pMesh mesh,int k,char ie,MMG5_Tria *ptt) {
  * Find acceptable position for splitting.
  *
  */
-int _MMG5_dichoto(MMG5_pMesh mesh,MMG5_pSol met,int k,int *vx) {
+int _MMG5_dichoto(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int *vx) {
     MMG5_pTetra  pt;
     MMG5_pPoint  pa,pb,ps;
     double  o[6][3],p[6][3];
     float   to,tp,t;
-    int     ia,ib,ier,it,maxit;
+    MMG5_int ia,ib;
+    int     ier,it,maxit;
     char    i;
 
     pt = &mesh->tetra[k];
@@ -163,6 +163,7 @@ int _MMG5_dichoto(MMG5_pMesh mesh,MMG5_pSol met,int k,int *vx) {
 
 /**
  * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
  * \param *list pointer toward the shell of edge.
  * \param ret double of the number of tetrahedra in the shell.
  * \param o[3] initial guess for coordinates of new point.
@@ -173,10 +174,11 @@ int _MMG5_dichoto(MMG5_pMesh mesh,MMG5_pSol met,int k,int *vx) {
  * considered edge, starting from o point.
  *
  */
-int _MMG5_dichoto1b(MMG5_pMesh mesh,int *list,int ret,double o[3],double ro[3]) {
+int _MMG5_dichoto1b(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,double o[3],double ro[3]) {
     MMG5_pTetra  pt;
     MMG5_pPoint  p0,p1;
-    int     iel,np,nq,it,maxit;
+    MMG5_int iel,np,nq;
+    int     it,maxit;
     double  m[3],c[3],tp,to,t;
     char    ia,ier;
 
@@ -205,7 +207,7 @@ int _MMG5_dichoto1b(MMG5_pMesh mesh,int *list,int ret,double o[3],double ro[3])
         c[1] = m[1] + t*(o[1]-m[1]);
         c[2] = m[2] + t*(o[2]-m[2]);
 
-        ier = _MMG5_simbulgept(mesh,list,ret,c);
+        ier = _MMG5_simbulgept(mesh,met,list,ret,c);
         if ( ier )
             to = t;
         else
@@ -236,7 +238,7 @@ char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_Tria *pt,char ori) {
     MMG5_xPoint  *pxp;
     double   n[3][3],t[3][3],nt[3],*n1,*n2,t1[3],t2[3];
     double   ps,ps2,ux,uy,uz,ll,il,alpha,dis,hma2,hausd;
-    int      ia,ib,ic;
+    MMG5_int ia,ib,ic;
     char     i,i1,i2;
     MMG5_pPar     par;
 
@@ -406,17 +408,19 @@ char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_Tria *pt,char ori) {
  * approximation.
  *
  */
-int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
+MMG5_int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
     MMG5_pTetra   pt;
     MMG5_pxTetra  pxt;
-    int      k,it,list[_MMG5_LMAX+2],ilist,ret,it1,it2,ns,nns,maxit;
+    MMG5_int k,list[_MMG5_LMAX+2],it1,it2,ns,nns;
+    int      it,ilist,ret,maxit;
     char     i,j,ia,ier;
 
-    it = nns = 0;
+    it  = 0;
+    nns = 0;
     maxit = 2;
     do {
         ns = 0;
-        for (k=1; k<=mesh->ne; k++) {
+        for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
             pt = &mesh->tetra[k];
             if ( (!MG_EOK(pt)) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
             else if ( !pt->xt ) continue;
@@ -433,7 +437,7 @@ int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
                     if ( ret < 0 )  return(-1);
                     /* CAUTION: trigger collapse with 2 elements */
                     if ( ilist <= 1 )  continue;
-                    ier = _MMG5_chkswpbdy(mesh,list,ilist,it1,it2);
+                    ier = _MMG5_chkswpbdy(mesh,met,list,ilist,it1,it2);
                     if ( ier ) {
                         ier = _MMG5_swpbdy(mesh,met,list,ret,it1,bucket);
                         if ( ier > 0 )  ns++;
@@ -448,11 +452,19 @@ int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
     }
     while ( ++it < maxit && ns > 0 );
     if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nns > 0 )
-        fprintf(stdout,"     %8d edge swapped\n",nns);
+        fprintf(stdout,"     %8" MMG5_PRId " edge swapped\n",nns);
 
     return(nns);
 }
 
+#define _MMG5_TMET iso
+#include "mmg3d1_tpl.h"
+#undef  _MMG5_TMET
+
+#define _MMG5_TMET ani
+#include "mmg3d1_tpl.h"
+#undef  _MMG5_TMET
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
@@ -460,48 +472,14 @@ int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
  * \param bucket pointer toward the bucket structure in delaunay mode and
  * toward the \a NULL pointer otherwise
  *
- * Internal edge flipping.
+ * Internal edge flipping: call the instance of the sweep matching the metric
+ * type.
  *
  */
-int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket) {
-    MMG5_pTetra   pt;
-    MMG5_pxTetra  pxt;
-    int      list[_MMG5_LMAX+2],ilist,k,it,nconf,maxit,ns,nns,ier;
-    char     i;
-
-    maxit = 2;
-    it = nns = 0;
-
-    do {
-        ns = 0;
-        for (k=1; k<=mesh->ne; k++) {
-            pt = &mesh->tetra[k];
-            if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
-            if ( pt->qual > 0.0288675 /*0.6/_MMG5_ALPHAD*/ )  continue;
-
-            for (i=0; i<6; i++) {
-                /* Prevent swap of a ref or tagged edge */
-                if ( pt->xt ) {
-                    pxt = &mesh->xtetra[pt->xt];
-                    if ( pxt->edg[i] || pxt->tag[i] ) continue;
-                }
-
-                nconf = _MMG5_chkswpgen(mesh,k,i,&ilist,list,crit);
-                if ( nconf ) {
-                    ier = _MMG5_swpgen(mesh,met,nconf,ilist,list,bucket);
-                    if ( ier > 0 )  ns++;
-                    else if ( ier < 0 ) return(-1);
-                    break;
-                }
-            }
-        }
-        nns += ns;
-    }
-    while ( ++it < maxit && ns > 0 );
-    if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nns > 0 )
-        fprintf(stdout,"     %8d edge swapped\n",nns);
-
-    return(nns);
+MMG5_int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket) {
+    if ( met->size < 6 )
+        return(_MMG5_swptet_iso(mesh,met,crit,bucket));
+    return(_MMG5_swptet_ani(mesh,met,crit,bucket));
 }
 
 /**
@@ -510,126 +488,14 @@ int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket)
  * \param maxitin maximum number of iteration.
  * \return -1 if failed, number of moved points otherwise.
  *
- * Analyze tetrahedra and move points so as to make mesh more uniform.
- * In delaunay mode, a negative maxitin means that we don't move internal nodes.
+ * Move points so as to make mesh more uniform: call the instance of the sweep
+ * matching the metric type.
  *
  */
-int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
-    MMG5_pTetra        pt;
-    MMG5_pPoint        ppt;
-    MMG5_pxTetra       pxt;
-    double        *n;
-    int           i,k,ier,nm,nnm,ns,lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv,it;
-    int           improve;
-    unsigned char j,i0,base;
-    int           internal,maxit;
-
-    if ( maxitin<0 ) {
-        internal = 0;
-        maxit = abs(maxitin);
-    } else {
-        internal=1;
-        maxit = maxitin;
-    }
-
-    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
-        fprintf(stdout,"  ** OPTIMIZING MESH\n");
-
-    base = 1;
-    for (k=1; k<=mesh->np; k++)
-        mesh->point[k].flag = base;
-
-    it = nnm = 0;
-    do {
-        base++;
-        nm = ns = 0;
-        for (k=1; k<=mesh->ne; k++) {
-            pt = &mesh->tetra[k];
-            if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
-
-            /* point j on face i */
-            for (i=0; i<4; i++) {
-                for (j=0; j<3; j++) {
-                    if ( pt->xt ) {
-                        pxt = &mesh->xtetra[pt->xt];
-                        if ( pxt->tag[_MMG5_iarf[i][j]] & MG_REQ )  continue;
-                    }
-                    else  pxt = 0;
-                    i0  = _MMG5_idir[i][j];
-                    ppt = &mesh->point[pt->v[i0]];
-                    if ( ppt->flag == base )  continue;
-                    else if ( MG_SIN(ppt->tag) )  continue;
-
-                    if ( maxit != 1 ) {
-                        ppt->flag = base;
-                        improve   = 1;
-                    }
-                    else {
-                        improve = 0;
-                    }
-                    ier = 0;
-                    if ( ppt->tag & MG_BDY ) {
-                        /* Catch a boundary point by a boundary face */
-                        if ( !pt->xt || !(MG_BDY & pxt->ftag[i]) )  continue;
-                        else if( ppt->tag & MG_NOM ){
-                            if( mesh->adja[4*(k-1)+1+i] ) continue;
-                            if( !(ier=_MMG5_bouleext(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )  continue;
-                            else if ( ier>0 )
-                                ier = _MMG5_movbdynompt(mesh,listv,ilistv,lists,ilists);
-                            else
-                                return(-1);
-                        }
-                        else if ( ppt->tag & MG_GEO ) {
-                            if ( !(ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )
-                                continue;
-                            else if ( ier>0 )
-                                ier = _MMG5_movbdyridpt(mesh,listv,ilistv,lists,ilists);
-                            else
-                                return(-1);
-                        }
-                        else if ( ppt->tag & MG_REF ) {
-                            if ( !(ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )
-                                continue;
-                            else if ( ier>0 )
-                                ier = _MMG5_movbdyrefpt(mesh,listv,ilistv,lists,ilists);
-                            else
-                                return(-1);
-                        }
-                        else {
-                            if ( !(ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )
-                                continue;
-                            else if ( ier<0 )
-                                return(-1);
-
-                            n = &(mesh->xpoint[ppt->xp].n1[0]);
-                            if ( !_MMG5_directsurfball(mesh, pt->v[i0],lists,ilists,n) )  continue;
-                            ier = _MMG5_movbdyregpt(mesh,listv,ilistv,lists,ilists);
-                            if ( ier )  ns++;
-                        }
-                    }
-                    else if ( internal ) {
-                        ilistv = _MMG5_boulevolp(mesh,k,i0,listv);
-                        if ( !ilistv )  continue;
-                        ier = _MMG5_movintpt(mesh,listv,ilistv,improve);
-                    }
-                    if ( ier ) {
-                        nm++;
-                        if(maxit==1){
-                            ppt->flag = base;
-                        }
-                    }
-                }
-            }
-        }
-        nnm += nm;
-        if ( mesh->info.ddebug )  fprintf(stdout,"     %8d moved, %d geometry\n",nm,ns);
-    }
-    while( ++it < maxit && nm > 0 );
-
-    if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nnm )
-        fprintf(stdout,"     %8d vertices moved, %d iter.\n",nnm,it);
-
-    return(nnm);
+MMG5_int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
+    if ( met->size < 6 )
+        return(_MMG5_movtet_iso(mesh,met,maxitin));
+    return(_MMG5_movtet_ani(mesh,met,maxitin));
 }
 
 /**
@@ -642,14 +508,15 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
  * Attempt to collapse small edges.
  *
  */
-static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
+static MMG5_int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
     MMG5_pTetra     pt;
     MMG5_pxTetra    pxt;
     MMG5_pPoint     p0,p1;
     double     ll,ux,uy,uz,hmi2;
-    int        k,nc,list[_MMG5_LMAX+2],ilist,base,nnm;
+    MMG5_int   k,nc,list[_MMG5_LMAX+2],nnm;
+    int        ilist,base;
     char       i,j,tag,ip,iq,isnm;
-    int        ier;
+    MMG5_int   ier;
 
     nc = nnm = 0;
     hmi2 = mesh->info.hmin*mesh->info.hmin;
@@ -658,7 +525,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
     for (k=1; k<=mesh->np; k++)
         mesh->point[k].flag = 0;
 
-    for (k=1; k<=mesh->ne; k++) {
+    for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
         base = ++mesh->base;
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )   continue;
@@ -699,7 +566,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                         if ( mesh->adja[4*(k-1)+1+i] )  continue;
                     }
                     if ( (tag & MG_REQ) || p0->tag > tag )  continue;
-                    ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
+                    ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
                 }
                 /* internal face */
                 else {
@@ -709,7 +576,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                 }
 
                 if ( ilist > 0 ) {
-                    ier = _MMG5_colver(mesh,list,ilist,iq);
+                    ier = _MMG5_colver(mesh,met,list,ilist,iq);
                     if ( ier < 0 ) return(-1);
                     else if ( ier ) {
                         _MMG5_delPt(mesh,ier);
@@ -727,7 +594,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
         }
     }
     if ( nc > 0 && (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) )
-        fprintf(stdout,"     %8d vertices removed, %8d non manifold,\n",nc,nnm);
+        fprintf(stdout,"     %8" MMG5_PRId " vertices removed, %8" MMG5_PRId " non manifold,\n",nc,nnm);
 
     return(nc);
 }
@@ -735,6 +602,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
+ * \param pend hash table of the faces waiting for their neighbour.
  * \param typchk type of checking permformed for edge length (hmax or _MMG5_LLONG criterion).
  * \return -1 if failed.
  * \return number of new points.
@@ -742,23 +610,25 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
  * Analyze volume tetra and split if needed.
  *
  */
-static int
-_MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
+static MMG5_int
+_MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_Hash *pend,char typchk) {
     MMG5_pTetra   pt;
     MMG5_pPoint   p1,p2;
     MMG5_xTetra  *pxt;
-    _MMG5_Hash     hash;
+    _MMG5_EdgeMap  hash;
     double   ll,o[3],ux,uy,uz,hma2;
-    int      vx[6],k,ip,ip1,ip2,nap,ns,ne,memlack;
+    MMG5_int vx[6],k,ip,ip1,ip2,nap,ns,ne;
+    int      memlack;
     char     i,j,ia;
 
     /** 1. analysis */
-    if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) )  return(-1);
-    memlack = ns = nap = 0;
+    if ( !_MMG5_edgeMapNew(mesh,&hash,7*mesh->np) )  return(-1);
+    memlack = 0;
+    ns = nap = 0;
     hma2 = _MMG5_LLONG*_MMG5_LLONG*mesh->info.hmax*mesh->info.hmax;
 
     /* Hash all boundary and required edges, and put ip = -1 in hash structure */
-    for (k=1; k<=mesh->ne; k++) {
+    for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) )  continue;
 
@@ -768,7 +638,7 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                 ip1 = pt->v[_MMG5_iare[i][0]];
                 ip2 = pt->v[_MMG5_iare[i][1]];
                 ip  = -1;
-                if ( !_MMG5_hashEdge(mesh,&hash,ip1,ip2,ip) )  return(-1);
+                if ( !_MMG5_edgeMapAdd(mesh,&hash,ip1,ip2,ip) )  return(-1);
             }
             continue;
         }
@@ -782,7 +652,7 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                     ip1 = pt->v[_MMG5_idir[i][_MMG5_inxt2[j]]];
                     ip2 = pt->v[_MMG5_idir[i][_MMG5_iprv2[j]]];
                     ip  = -1;
-                    if ( !_MMG5_hashEdge(mesh,&hash,ip1,ip2,ip) )  return(-1);
+                    if ( !_MMG5_edgeMapAdd(mesh,&hash,ip1,ip2,ip) )  return(-1);
                 }
                 break;
             }
@@ -790,7 +660,7 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
     }
 
     /** 2. Set flags and split internal edges */
-    for (k=1; k<=mesh->ne; k++) {
+    for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) )  continue;
         pt->flag = 0;
@@ -806,7 +676,7 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
             }
             else  pxt = 0;
             if ( (p1->tag & MG_BDY) && (p2->tag & MG_BDY) ) {
-                ip = _MMG5_hashGet(&hash,ip1,ip2);
+                ip = _MMG5_edgeMapGet(&hash,ip1,ip2);
             }
             else {
                 if (typchk == 1) {
@@ -815,12 +685,12 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                     uz = p2->c[2] - p1->c[2];
                     ll = ux*ux + uy*uy + uz*uz;
                     if ( ll > hma2 )
-                        ip = _MMG5_hashGet(&hash,ip1,ip2);
+                        ip = _MMG5_edgeMapGet(&hash,ip1,ip2);
                 }
                 else if ( typchk == 2 ) {
                     ll = _MMG5_lenedg(mesh,met,ip1,ip2);
                     if ( ll > _MMG5_LLONG )
-                        ip = _MMG5_hashGet(&hash,ip1,ip2);
+                        ip = _MMG5_edgeMapGet(&hash,ip1,ip2);
                 }
             }
             if ( ip < 0 ) continue;
@@ -845,15 +715,15 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                 }
 
                 if ( met->m )
-                    met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-                if ( !_MMG5_hashEdge(mesh,&hash,ip1,ip2,ip) )  return(-1);
+                    _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+                if ( !_MMG5_edgeMapAdd(mesh,&hash,ip1,ip2,ip) )  return(-1);
                 MG_SET(pt->flag,i);
                 nap++;
             }
         }
     }
     if ( !nap )  {
-        _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+        _MMG5_edgeMapFree(mesh,&hash);
         return(0);
     }
 
@@ -861,79 +731,79 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
 split:
     ns = 0;
     ne = mesh->ne;
-    for (k=1; k<=ne; k++) {
+    for (k=mesh->nefrz+1; k<=ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
-        memset(vx,0,6*sizeof(int));
+        memset(vx,0,6*sizeof(MMG5_int));
         pt->flag = 0;
         for (ia=0,i=0; i<3; i++) {
             for (j=i+1; j<4; j++,ia++) {
                 if ( pt->xt && (mesh->xtetra[pt->xt].tag[ia] & MG_REQ) ) continue;
-                vx[ia] = _MMG5_hashGet(&hash,pt->v[i],pt->v[j]);
+                vx[ia] = _MMG5_edgeMapGet(&hash,pt->v[i],pt->v[j]);
                 if ( vx[ia] > 0 )  MG_SET(pt->flag,ia);
             }
         }
 
         switch (pt->flag) {
         case 1: case 2: case 4: case 8: case 16: case 32: /* 1 edge split */
-            _MMG5_split1(mesh,met,k,vx);
+            _MMG5_split1(mesh,met,k,vx,pend);
             ns++;
             break;
         case 48: case 24: case 40: case 6: case 34: case 36:
         case 20: case 5: case 17: case 9: case 3: case 10: /* 2 edges (same face) split */
-            _MMG5_split2sf(mesh,met,k,vx);
+            _MMG5_split2sf(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 33: case 18: case 12: /* 2 opposite edges split */
-            _MMG5_split2(mesh,met,k,vx);
+            _MMG5_split2(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 11: case 21: case 38: case 56: /* 3 edges on the same faces splitted */
-            _MMG5_split3(mesh,met,k,vx);
+            _MMG5_split3(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 7: case 25: case 42: case 52: /* 3 edges on conic configuration splitted */
-            _MMG5_split3cone(mesh,met,k,vx);
+            _MMG5_split3cone(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 35: case 19: case 13: case 37: case 22: case 28: case 26:
         case 14: case 49: case 50: case 44: case 41: /* 3 edges on opposite configuration splitted */
-            _MMG5_split3op(mesh,met,k,vx);
+            _MMG5_split3op(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 23: case 29: case 53: case 60: case 57: case 58:
         case 27: case 15: case 43: case 39: case 54: case 46: /* 4 edges with 3 lying on the same face splitted */
-            _MMG5_split4sf(mesh,met,k,vx);
+            _MMG5_split4sf(mesh,met,k,vx,pend);
             ns++;
             break;
 
             /* 4 edges with no 3 lying on the same face splitted */
         case 30: case 45: case 51:
-            _MMG5_split4op(mesh,met,k,vx);
+            _MMG5_split4op(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 62: case 61: case 59: case 55: case 47: case 31: /* 5 edges split */
-            _MMG5_split5(mesh,met,k,vx);
+            _MMG5_split5(mesh,met,k,vx,pend);
             ns++;
             break;
 
         case 63: /* 6 edges split */
-            _MMG5_split6(mesh,met,k,vx);
+            _MMG5_split6(mesh,met,k,vx,pend);
             ns++;
             break;
         }
     }
 
     if ( (mesh->info.ddebug || abs(mesh->info.imprim) > 5) && ns > 0 )
-        fprintf(stdout,"     %7d splitted\n",nap);
+        fprintf(stdout,"     %7" MMG5_PRId " splitted\n",nap);
 
-    _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+    _MMG5_edgeMapFree(mesh,&hash);
     if ( memlack )  return(-1);
     return(nap);
 }
@@ -941,6 +811,7 @@ split:
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
+ * \param pend hash table of the faces waiting for their neighbour.
  * \param typchk type of checking permformed for edge length (hmax or _MMG5_LLONG criterion).
  * \return -1 if failed.
  * \return number of new points.
@@ -948,25 +819,26 @@ split:
  * Analyze tetra and split on geometric criterion.
  *
  */
-static int
-_MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
+static MMG5_int
+_MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_Hash *pend,char typchk) {
     MMG5_pTetra   pt;
     MMG5_pPoint   ppt,p1,p2;
     MMG5_Tria     ptt;
     MMG5_xTetra  *pxt;
     MMG5_xPoint  *pxp;
     _MMG5_Bezier  pb;
-    _MMG5_Hash    hash;
+    _MMG5_EdgeMap hash;
     double   o[3],no[3],to[3],dd,len;
-    int      vx[6],k,ip,ic,it,nap,nc,ni,ne,npinit,ns,ip1,ip2,ier;
+    MMG5_int vx[6],k,ip,nap,nc,ni,ne,npinit,ns,ip1,ip2;
+    int      ier,ic,it;
     char     i,j,ia,i1,i2;
     static double uv[3][2] = { {0.5,0.5}, {0.,0.5}, {0.5,0.} };
 
     /** 1. analysis of boundary elements */
-    if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) ) return(-1);
+    if ( !_MMG5_edgeMapNew(mesh,&hash,7*mesh->np) ) return(-1);
     ns = nap = 0;
     npinit=mesh->np;
-    for (k=1; k<=mesh->ne; k++) {
+    for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || !pt->xt )  continue;
 
@@ -1019,7 +891,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
             i2  = _MMG5_iare[ia][1];
             ip1 = pt->v[i1];
             ip2 = pt->v[i2];
-            ip  = _MMG5_hashGet(&hash,ip1,ip2);
+            ip  = _MMG5_edgeMapGet(&hash,ip1,ip2);
 
             if ( ip > 0 && !(ptt.tag[j] & MG_GEO) )  continue;
 
@@ -1042,12 +914,12 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                     pb.p[1] = &mesh->point[ptt.v[1]];
                     pb.p[2] = &mesh->point[ptt.v[2]];
                 }
-                if ( !_MMG5_hashEdge(mesh,&hash,ip1,ip2,ip) )  return(-1);
+                if ( !_MMG5_edgeMapAdd(mesh,&hash,ip1,ip2,ip) )  return(-1);
                 ppt = &mesh->point[ip];
                 p1  = &mesh->point[ip1];
                 p2  = &mesh->point[ip2];
                 if ( met->m )
-                    met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+                    _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
                 if ( MG_EDG(ptt.tag[j]) || (ptt.tag[j] & MG_NOM) )
                     ppt->ref = ptt.edg[j] ? ptt.edg[j] : ptt.ref;
                 else
@@ -1082,14 +954,14 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
         }
     }
     if ( !ns ) {
-        _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+        _MMG5_edgeMapFree(mesh,&hash);
         return(ns);
     }
 
     /** 2. check if split by adjacent; besides, a triangle may have been splitted and not its adjacent
         (thus, the associated n2 may not exist) : update this normal if need be */
     nc = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
         pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
@@ -1108,7 +980,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
                 else if ( ptt.tag[j] & MG_REQ )           continue;
                 ip1 = pt->v[_MMG5_iare[ia][0]];
                 ip2 = pt->v[_MMG5_iare[ia][1]];
-                ip  = _MMG5_hashGet(&hash,ip1,ip2);
+                ip  = _MMG5_edgeMapGet(&hash,ip1,ip2);
                 if ( ip > 0 ) {
 
                     MG_SET(pt->flag,ia);
@@ -1131,7 +1003,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
         }
     }
     if ( mesh->info.ddebug && nc ) {
-        fprintf(stdout,"     %d added\n",nc);
+        fprintf(stdout,"     %" MMG5_PRId " added\n",nc);
         fflush(stdout);
     }
 
@@ -1142,15 +1014,15 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
     it = 1;
     do {
         ni = nc = 0;
-        for (k=1; k<=mesh->ne; k++) {
+        for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
             pt = &mesh->tetra[k];
             if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || !pt->flag )  continue;
-            memset(vx,0,6*sizeof(int));
+            memset(vx,0,6*sizeof(MMG5_int));
             pt->flag = ic = 0;
             for (ia=0,i=0; i<3; i++) {
                 for (j=i+1; j<4; j++,ia++) {
                     if ( pt->xt && (mesh->xtetra[pt->xt].tag[ia] & MG_REQ) )  continue;
-                    vx[ia] = _MMG5_hashGet(&hash,pt->v[i],pt->v[j]);
+                    vx[ia] = _MMG5_edgeMapGet(&hash,pt->v[i],pt->v[j]);
                     if ( vx[ia] > 0 ) {
                         MG_SET(pt->flag,ia);
                         if ( mesh->point[vx[ia]].flag > 2 )  ic = 1;
@@ -1194,44 +1066,44 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
     }
     while( nc > 0 && ++it < 20 );
     if ( mesh->info.ddebug && nc ) {
-        fprintf(stdout,"     %d corrected, %d invalid\n",nc,ni);
+        fprintf(stdout,"     %" MMG5_PRId " corrected, %" MMG5_PRId " invalid\n",nc,ni);
         fflush(stdout);
     }
 
     /** 4. splitting */
     ns = 0;
     ne = mesh->ne;
-    for (k=1; k<=ne; k++) {
+    for (k=mesh->nefrz+1; k<=ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || !pt->flag || (pt->tag & MG_REQ) )  continue;
-        memset(vx,0,6*sizeof(int));
+        memset(vx,0,6*sizeof(MMG5_int));
         for (ia=0,i=0; i<3; i++) {
             for (j=i+1; j<4; j++,ia++) {
                 if ( MG_GET(pt->flag,ia) )  {
-                    vx[ia] = _MMG5_hashGet(&hash,pt->v[i],pt->v[j]);
+                    vx[ia] = _MMG5_edgeMapGet(&hash,pt->v[i],pt->v[j]);
                     assert(vx[ia]);
                 }
             }
         }
         switch (pt->flag) {
         case 1: case 2: case 4: case 8: case 16: case 32:  /* 1 edge split */
-            _MMG5_split1(mesh,met,k,vx);
+            _MMG5_split1(mesh,met,k,vx,pend);
             ns++;
             break;
         case 11: case 21: case 38: case 56: /* 1 face (3 edges) subdivided */
-            _MMG5_split3(mesh,met,k,vx);
+            _MMG5_split3(mesh,met,k,vx,pend);
             ns++;
             break;
         default:
-            _MMG5_split2sf(mesh,met,k,vx);
+            _MMG5_split2sf(mesh,met,k,vx,pend);
             ns++;
             break;
         }
     }
     if ( (mesh->info.ddebug || abs(mesh->info.imprim) > 5) && ns > 0 )
-        fprintf(stdout,"       %7d elements splitted\n",nap);
+        fprintf(stdout,"       %7" MMG5_PRId " elements splitted\n",nap);
 
-    _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+    _MMG5_edgeMapFree(mesh,&hash);
     return(nap);
 }
 
@@ -1240,21 +1112,22 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
+ * \param pend hash table of the faces waiting for their neighbour.
  * \return -1 if failed.
  * \return number of new points.
  *
  * Split tetra into 4 when more than 1 boundary face.
  *
  */
-static int _MMG5_anatet4(MMG5_pMesh mesh, MMG5_pSol met) {
+static MMG5_int _MMG5_anatet4(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_Hash *pend) {
     MMG5_pTetra      pt;
     MMG5_pPoint      ppt;
     MMG5_pxTetra     pxt;
-    int         k,ns;
+    MMG5_int    k,ns;
     char        nf,j;
 
     ns = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
         nf = 0;
@@ -1264,7 +1137,7 @@ static int _MMG5_anatet4(MMG5_pMesh mesh, MMG5_pSol met) {
                 if ( pxt->ftag[j] & MG_BDY )  nf++;
         }
         if ( nf > 1 ) {
-            if ( !_MMG5_split4bar(mesh,met,k) ) return(-1);
+            if ( !_MMG5_split4bar(mesh,met,k,pend) ) return(-1);
             ns++;
         }
         else {
@@ -1274,13 +1147,13 @@ static int _MMG5_anatet4(MMG5_pMesh mesh, MMG5_pSol met) {
                 if ( ppt->tag & MG_BDY )  nf++;
             }
             if ( nf == 4 ) {
-                if ( !_MMG5_split4bar(mesh,met,k) ) return(-1);
+                if ( !_MMG5_split4bar(mesh,met,k,pend) ) return(-1);
                 ns++;
             }
         }
     }
     if ( (mesh->info.ddebug || abs(mesh->info.imprim) > 5) && ns > 0 )
-        fprintf(stdout,"     %7d boundary elements splitted\n",ns);
+        fprintf(stdout,"     %7" MMG5_PRId " boundary elements splitted\n",ns);
     return(ns);
 }
 
@@ -1297,25 +1170,32 @@ static int _MMG5_anatet4(MMG5_pMesh mesh, MMG5_pSol met) {
  *
  */
 int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
-    int     ier,nc,ns,nf,nnc,nns,nnf,it,maxit;
+    _MMG5_Hash  pend;
+    MMG5_int    ier,nc,ns,nf,nnc,nns,nnf,k;
+    int         it,maxit;
 
     /* analyze tetras : initial splitting */
     nns = nnc = nnf = it = 0;
     maxit = 5;
     mesh->gap = 0.5;
     do {
-        /* memory free */
-        _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+        /* adjacency is updated by the splitting routines */
+        if ( !mesh->adja && !_MMG5_hashTetra(mesh,1) ) {
+            fprintf(stdout,"  ## Hashing problem. Exit program.\n");
+            return(0);
+        }
 
         if ( !mesh->info.noinsert ) {
+            if ( !_MMG5_hashNew(mesh,&pend,MG_MAX(mesh->ne/8,100),MG_MAX(mesh->ne/2,300)) )
+                return(0);
 
             /* split tetra with more than 2 bdry faces */
-            ier = _MMG5_anatet4(mesh,met);
+            ier = _MMG5_anatet4(mesh,met,&pend);
             if ( ier < 0 )  return(0);
             ns = ier;
 
             /* analyze surface tetras */
-            ier = _MMG5_anatets(mesh,met,typchk);
+            ier = _MMG5_anatets(mesh,met,&pend,typchk);
 
             if ( ier < 0 ) {
                 fprintf(stdout,"  ## Unable to complete surface mesh. Exit program.\n");
@@ -1324,20 +1204,34 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
             ns += ier;
             if ( patternMode ) {
                 /* analyze internal tetras */
-                ier = _MMG5_anatetv(mesh,met,typchk);
+                ier = _MMG5_anatetv(mesh,met,&pend,typchk);
                 if ( ier < 0 ) {
                     fprintf(stdout,"  ## Unable to complete volume mesh. Exit program.\n");
                     return(0);
                 }
                 ns += ier;
             }
+
+            /* a face without neighbour split: rebuild the whole table */
+            for (k=1; k<=4*mesh->ne; k++)
+                if ( mesh->adja[k] < 0 )  break;
+            if ( k <= 4*mesh->ne ) {
+                if ( mesh->info.ddebug )
+                    fprintf(stdout,"  ## Warning: non conforming split, adjacency rebuilt.\n");
+                _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(MMG5_int));
+            }
+            _MMG5_DEL_MEM(mesh,pend.item,(pend.max+1)*sizeof(_MMG5_hedge));
         }
         else  ns = 0;
 
-        if ( !_MMG5_hashTetra(mesh,1) ) {
-            fprintf(stdout,"  ## Hashing problem. Exit program.\n");
-            return(0);
+        if ( !mesh->adja ) {
+            if ( !_MMG5_hashTetra(mesh,1) ) {
+                fprintf(stdout,"  ## Hashing problem. Exit program.\n");
+                return(0);
+            }
         }
+        else
+            _MMG5_paktet(mesh);
         if ( typchk == 2 && it == maxit-1 )  mesh->info.fem = 1;
 
         /* collapse short edges */
@@ -1371,13 +1265,13 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
         nns += ns;
         nnf += nf;
         if ( (abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && ns+nc+nf > 0 )
-            fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped\n",ns,nc,nf);
-        if ( it > 3 && abs(nc-ns) < 0.1 * MG_MAX(nc,ns) )  break;
+            fprintf(stdout,"     %8" MMG5_PRId " splitted, %8" MMG5_PRId " collapsed, %8" MMG5_PRId " swapped\n",ns,nc,nf);
+        if ( it > 3 && MG_ABS(nc-ns) < 0.1 * MG_MAX(nc,ns) )  break;
     }
     while ( ++it < maxit && ns+nc+nf > 0 );
 
     if ( (abs(mesh->info.imprim) < 4 || mesh->info.ddebug ) && nns+nnc > 0 )
-        fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped, %d iter.\n",nns,nnc,nnf,it);
+        fprintf(stdout,"     %8" MMG5_PRId " splitted, %8" MMG5_PRId " collapsed, %8" MMG5_PRId " swapped, %d iter.\n",nns,nnc,nnf,it);
 
     return(1);
 }
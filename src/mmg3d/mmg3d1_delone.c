@@ -32,699 +32,1043 @@
  * Perform volume and surface mesh adaptation in delaunay mode (\a
  * PATTERN preprocessor flag set to OFF).
  *
- * \todo Clean the boucle for (code copy...)
  */
 #include "mmg3d.h"
-
-char  ddb;
+#include "metric_kernels.h"
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 #define _MMG5_LOPTL_MMG5_DEL     1.41
 #define _MMG5_LOPTS_MMG5_DEL     0.6
+/** maximal number of successive operations on the edges of a ball during one
+ * sweep of the \a -queue mode */
+#define _MMG5_QGEN               2
+
+/** Stamp of a tetrahedron: copy of its vertices and of its quality, used to
+ * detect if the tetrahedron has been modified since the stamp computation. */
+typedef struct {
+    double   qual; /**< quality of the tetrahedron */
+    MMG5_int v[4]; /**< vertices of the tetrahedron, v[0]=0 if not stamped */
+} _MMG5_Stamp;
+typedef _MMG5_Stamp * _MMG5_pStamp;
 
-int MMG_npuiss,MMG_nvol,MMG_npres,MMG_npd;
+/**
+ * \param st pointer toward the stamp.
+ * \param pt pointer toward the tetrahedron.
+ *
+ * Stamp the tetrahedron \a pt.
+ *
+ */
+static inline void
+_MMG5_setStamp(_MMG5_pStamp st,MMG5_pTetra pt) {
+    memcpy(st->v,pt->v,4*sizeof(MMG5_int));
+    st->qual = pt->qual;
+}
 
+/**
+ * \param st pointer toward the stamp.
+ * \param pt pointer toward the tetrahedron.
+ * \return 1 if \a st is a stamp of the tetrahedron \a pt in its current
+ * state, 0 otherwise.
+ *
+ */
+static inline int
+_MMG5_chkStamp(_MMG5_pStamp st,MMG5_pTetra pt) {
+    if ( !st->v[0] || st->qual != pt->qual )  return(0);
+    return( !memcmp(st->v,pt->v,4*sizeof(MMG5_int)) );
+}
 
+#ifdef USE_OPENMP
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
- * \param bucket pointer toward the bucket structure.
  * \param ne number of elements.
- * \param ifilt pointer to store the number of vertices filtered by the bucket.
- * \param ns pointer to store the number of vertices insertions.
- * \param nc pointer to store the number of collapse.
- * \param warn pointer to store a flag that warn the user in case of
- * reallocation difficulty.
- * \param it iteration index.
- * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
- * the mesh, 1 otherwise.
+ * \param stamp table of element stamps.
  *
- * \ref adpsplcol loop: split edges longer than \ref _MMG5_LOPTL_MMG5_DEL and
- * collapse edges shorter than \ref _MMG5_LOPTS_MMG5_DEL.
+ * Multithreaded analysis of the tetrahedra before the \ref _MMG5_boucle_for
+ * sweep: \a stamp[k] receives the stamp of the tetrahedron \a k if none of
+ * its edges can be splitted or collapsed, it is reset otherwise. Tetrahedra
+ * whose stamp is still valid are not analyzed again. This step only read the
+ * mesh, thus the tetrahedra are shared between threads without locks. The
+ * splits and collapses themselves are performed by the sequential sweep.
  *
  */
-static inline int
-_MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
-                 int* ifilt,int* ns,int* nc,int* warn,int it) {
+static void
+_MMG5_stampOkTets(MMG5_pMesh mesh, MMG5_pSol met,MMG5_int ne,_MMG5_pStamp stamp) {
     MMG5_pTetra     pt;
     MMG5_pxTetra    pxt;
-    MMG5_Tria       ptt;
-    MMG5_pPoint     p0,p1,ppt;
-    MMG5_pxPoint    pxp;
-    double     dd,len,lmax,o[3],to[3],ro[3],no1[3],no2[3],v[3];
-    int        k,ip,ip1,ip2,list[_MMG5_LMAX+2],ilist,ref;
-    char       imax,tag,j,i,i1,i2,ifa0,ifa1;
-    int        lon,ret,ier;
-    double     lmin;
-    int        imin,iq;
-    int        ii;
-    double     lmaxtet,lmintet;
-    int        imaxtet,imintet;
+    double          len;
+    MMG5_int        k;
+    int             ii,nreq;
 
-    for (k=1; k<=ne; k++) {
+#pragma omp parallel for num_threads(mesh->info.threads) schedule(static) \
+    private(pt,pxt,len,ii,nreq)
+    for (k=mesh->nefrz+1; k<=ne; k++) {
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt)  || (pt->tag & MG_REQ) )   continue;
+        if ( _MMG5_chkStamp(&stamp[k],pt) )  continue;
+        stamp[k].v[0] = 0;
 
-        pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
-
-        /* 1) find longest and shortest edge  and try to manage it*/
-        imax = -1; lmax = 0.0;
-        imin = -1; lmin = DBL_MAX;
+        pxt  = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+        nreq = 0;
         for (ii=0; ii<6; ii++) {
-            if ( pt->xt && (pxt->tag[ii] & MG_REQ) )  continue;
-            ip1  = _MMG5_iare[ii][0];
-            ip2  = _MMG5_iare[ii][1];
-            len = _MMG5_lenedg(mesh,met,pt->v[ip1],pt->v[ip2]);
-            if ( len > lmax ) {
-                lmax = len;
-                imax = ii;
+            if ( pt->xt && (pxt->tag[ii] & MG_REQ) ) {
+                nreq++;
+                continue;
             }
+            len = _MMG5_lenedg(mesh,met,pt->v[_MMG5_iare[ii][0]],
+                               pt->v[_MMG5_iare[ii][1]]);
+            if ( len >= _MMG5_LOPTL_MMG5_DEL || len <= _MMG5_LOPTS_MMG5_DEL )
+                break;
+        }
+        /* all the edges are required: let the sweep warn the user */
+        if ( ii < 6 || nreq == 6 )  continue;
+
+        _MMG5_setStamp(&stamp[k],pt);
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param start index of the tetrahedron.
+ * \param ip local index of the vertex in \a start.
+ * \param list pointer to store the ball of the vertex.
+ * \param preg region of each point (see \ref _MMG5_regions).
+ * \param r region of the tetrahedron \a start.
+ * \return the size of the ball, 0 if an element of the ball has a boundary
+ * face or does not belong to the region \a r, or if the ball is too large.
+ *
+ * Ball of an internal vertex of the region \a r, in the order of \ref
+ * _MMG5_boulevolp. The elements already visited are searched in the list
+ * instead of being flagged, the flags of the elements being shared between
+ * threads.
+ *
+ */
+static int
+_MMG5_boulevolp_reg(MMG5_pMesh mesh,MMG5_int start,int ip,MMG5_int *list,
+                    int *preg,int r) {
+    MMG5_pTetra  pt1;
+    MMG5_int     *adja,nump,k,k1;
+    int          ilist,cur,m;
+    char         i,j,l;
+
+    nump  = mesh->tetra[start].v[ip];
+    list[0] = 4*start + ip;
+    ilist = 1;
+
+    cur = 0;
+    while ( cur < ilist ) {
+        k = list[cur] / 4;
+        i = list[cur] % 4;
+        adja = &mesh->adja[4*(k-1)+1];
+
+        for (l=0; l<3; l++) {
+            i  = _MMG5_inxt3[i];
+            k1 = adja[i] / 4;
+            if ( !k1 )  return(0);
+            for (m=0; m<ilist; m++)
+                if ( list[m]/4 == k1 )  break;
+            if ( m < ilist )  continue;
+
+            pt1 = &mesh->tetra[k1];
+            if ( pt1->xt || (pt1->tag & MG_REQ) )  return(0);
+            for (j=0; j<4; j++)
+                if ( preg[pt1->v[j]] != r )  return(0);
+            for (j=0; j<4; j++)
+                if ( pt1->v[j] == nump )  break;
+            assert(j<4);
+            /* overflow */
+            if ( ilist > _MMG5_LMAX-3 )  return(0);
+            list[ilist++] = 4*k1+j;
+        }
+        cur++;
+    }
+    return(ilist);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param nc pointer toward the number of collapses.
+ * \return -1 if fail, 1 otherwise.
+ *
+ * Concurrent collapse of the shortest internal edges of the tetrahedra,
+ * before the \ref _MMG5_boucle_for sweep. Each thread checks the collapses
+ * of the tetrahedra of its regions (see \ref _MMG5_regions): a collapse is
+ * kept if the ball of the removed vertex lies in the region and meets no
+ * ball of a collapse kept before, so the kept collapses are independent.
+ * They are then performed in the order of the tetrahedra since the free
+ * lists of the mesh are not shared between threads. The other edges are
+ * left to the sequential sweep. Each region has its own part of the ball
+ * buffer, so the kept collapses don't depend on the thread that checks them.
+ *
+ */
+static int
+_MMG5_colelt_mt(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,MMG5_int *nc) {
+    MMG5_pTetra   pt;
+    MMG5_pPoint   p0,p1;
+    double        len,lmin;
+    MMG5_int     *work,*cand,*coff,*clon,*cnt,*used,*buf;
+    MMG5_int      k,c,ne,ncand,cap,nwork,ier,ncol;
+    int          *preg;
+    int           r,l,ilist,nreg,nthr,ret;
+    MMG5_int      list[_MMG5_LMAX+2];
+    char         *cedg,*lock,i,j,ie,imin;
+
+    nthr = mesh->info.threads;
+    ne   = mesh->ne;
+
+    nreg = _MMG5_regions(mesh,bucket,0,&preg);
+    if ( !nreg )  return(1);
+
+    /* shortest edge to collapse in each internal tetra of a region */
+    _MMG5_ADD_MEM(mesh,2*(ne+1)*sizeof(char),"edges to collapse",
+                  _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+                  return(1));
+    _MMG5_SAFE_MALLOC(cedg,2*(ne+1),char);
+    lock = &cedg[ne+1];
+
+#pragma omp parallel for num_threads(nthr) schedule(static) \
+    private(pt,p0,p1,len,lmin,imin,ie,i,j,r)
+    for (k=1; k<=ne; k++) {
+        cedg[k] = -1;
+        lock[k] = 0;
+        if ( k <= mesh->nefrz )  continue;
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || pt->xt )  continue;
+        r = preg[pt->v[0]];
+        if ( preg[pt->v[1]] != r || preg[pt->v[2]] != r || preg[pt->v[3]] != r )
+            continue;
+
+        imin = -1; lmin = DBL_MAX;
+        for (ie=0; ie<6; ie++) {
+            len = _MMG5_lenedg(mesh,met,pt->v[_MMG5_iare[ie][0]],
+                               pt->v[_MMG5_iare[ie][1]]);
             if ( len < lmin ) {
                 lmin = len;
-                imin = ii;
+                imin = ie;
             }
         }
-        if ( imax==-1 )
-            fprintf(stdout,"%s:%d: Warning: all edges of tetra %d are boundary and required\n",
-                    __FILE__,__LINE__,k);
-        if ( imin==-1 )
-            fprintf(stdout,"%s:%d: Warning: all edges of tetra %d are boundary and required\n",
-                    __FILE__,__LINE__,k);
-
-        if ( lmax >= _MMG5_LOPTL_MMG5_DEL )  {
-            /* proceed edges according to lengths */
-            ifa0 = _MMG5_ifar[imax][0];
-            ifa1 = _MMG5_ifar[imax][1];
-            i  = (pt->xt && (pxt->ftag[ifa1] & MG_BDY)) ? ifa1 : ifa0;
-            j  = _MMG5_iarfinv[i][imax];
-            i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
-            i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
-            ip1 = pt->v[i1];
-            ip2 = pt->v[i2];
-            p0  = &mesh->point[ip1];
-            p1  = &mesh->point[ip2];
-
-            /* Case of a boundary face */
-            if ( pt->xt && (pxt->ftag[i] & MG_BDY) ) {
-                if ( !(MG_GET(pxt->ori,i)) ) continue;
-                ref = pxt->edg[_MMG5_iarf[i][j]];
-                tag = pxt->tag[_MMG5_iarf[i][j]];
-                if ( tag & MG_REQ )  continue;
-                tag |= MG_BDY;
-                ilist = _MMG5_coquil(mesh,k,imax,list);
-                if ( !ilist )  continue;
-                else if ( ilist<0 ) return(-1);
-                if ( tag & MG_NOM ){
-                    if( !_MMG5_BezierNom(mesh,ip1,ip2,0.5,o,no1,to) )
-                        continue;
-                    else if ( MG_SIN(p0->tag) && MG_SIN(p1->tag) ) {
-                        _MMG5_tet2tri(mesh,k,i,&ptt);
-                        _MMG5_nortri(mesh,&ptt,no1);
-                        if ( !MG_GET(pxt->ori,i) ) {
-                            no1[0] *= -1.0;
-                            no1[1] *= -1.0;
-                            no1[2] *= -1.0;
-                        }
-                    }
-                }
-                else if ( tag & MG_GEO ) {
-                    if ( !_MMG5_BezierRidge(mesh,ip1,ip2,0.5,o,no1,no2,to) )
-                        continue;
-                    if ( MG_SIN(p0->tag) && MG_SIN(p1->tag) ) {
-                        _MMG5_tet2tri(mesh,k,i,&ptt);
-                        _MMG5_nortri(mesh,&ptt,no1);
-                        no2[0] = to[1]*no1[2] - to[2]*no1[1];
-                        no2[1] = to[2]*no1[0] - to[0]*no1[2];
-                        no2[2] = to[0]*no1[1] - to[1]*no1[0];
-                        dd = no2[0]*no2[0] + no2[1]*no2[1] + no2[2]*no2[2];
-                        if ( dd > _MMG5_EPSD2 ) {
-                            dd = 1.0 / sqrt(dd);
-                            no2[0] *= dd;
-                            no2[1] *= dd;
-                            no2[2] *= dd;
-                        }
-                    }
-                }
-                else if ( tag & MG_REF ) {
-                    if ( !_MMG5_BezierRef(mesh,ip1,ip2,0.5,o,no1,to) )
-                        goto collapse;
-                }
-                else {
-                    if ( !_MMG5_norface(mesh,k,i,v) )  goto collapse;
-                    if ( !_MMG5_BezierReg(mesh,ip1,ip2,0.5,v,o,no1) ) goto collapse;
+        if ( lmin > _MMG5_LOPTS_MMG5_DEL )  continue;
+
+        /* same vertex as the sequential sweep (see _MMG5_colEdg_delone) */
+        i  = _MMG5_ifar[imin][0];
+        j  = _MMG5_iarfinv[i][imin];
+        p0 = &mesh->point[pt->v[_MMG5_idir[i][_MMG5_inxt2[j]]]];
+        p1 = &mesh->point[pt->v[_MMG5_idir[i][_MMG5_iprv2[j]]]];
+        if ( (p0->tag > p1->tag) || (p0->tag & (MG_REQ | MG_BDY)) )  continue;
+        cedg[k] = imin;
+    }
 
-                }
-                ier = _MMG5_simbulgept(mesh,list,ilist,o);
-                if ( !ier ) {
-                    ier = _MMG5_dichoto1b(mesh,list,ilist,o,ro);
-                    memcpy(o,ro,3*sizeof(double));
-                }
-                ip = _MMG5_newPt(mesh,o,tag);
-
-                if ( !ip ) {
-                    /* reallocation of point table */
-                    if ( bucket ) {
-                        _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
-                                                 *warn=1;
-                                                 goto collapse,
-                                                 o,tag);
-                    }
-                    else {
-                        printf("ERROR: function not available in delaunay mode. Exiting\n");
-                        exit(EXIT_FAILURE);
-                    }
-                }
+    ncand = 0;
+    for (k=mesh->nefrz+1; k<=ne; k++)
+        if ( cedg[k] >= 0 )  ncand++;
+    if ( !ncand ) {
+        _MMG5_DEL_MEM(mesh,cedg,2*(ne+1)*sizeof(char));
+        _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+        return(1);
+    }
 
-                if ( met->m )
-                    met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+    /* work arrays: candidates sorted by region, balls of the candidates,
+     * balls of each region */
+    nwork = 3*ncand+2*nreg+1+32*(ncand+nreg);
+    _MMG5_ADD_MEM(mesh,nwork*sizeof(MMG5_int),"concurrent collapses",
+                  _MMG5_DEL_MEM(mesh,cedg,2*(ne+1)*sizeof(char));
+                  _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+                  return(1));
+    _MMG5_SAFE_CALLOC(work,nwork,MMG5_int);
+    cand = work;
+    coff = &cand[ncand];
+    clon = &coff[ncand];
+    cnt  = &clon[ncand];
+    used = &cnt[nreg+1];
+    buf  = &used[nreg];
+
+    for (k=mesh->nefrz+1; k<=ne; k++)
+        if ( cedg[k] >= 0 )  cnt[preg[mesh->tetra[k].v[0]]+1]++;
+    for (r=0; r<nreg; r++)
+        cnt[r+1] += cnt[r];
+    for (k=mesh->nefrz+1; k<=ne; k++)
+        if ( cedg[k] >= 0 )  cand[cnt[preg[mesh->tetra[k].v[0]]]++] = k;
+    for (r=nreg; r>0; r--)
+        cnt[r] = cnt[r-1];
+    cnt[0] = 0;
+
+    /* concurrent check of the collapses */
+#pragma omp parallel for num_threads(nthr) schedule(dynamic,1) \
+    private(c,k,cap,imin,i,j,ilist,l,list)
+    for (r=0; r<nreg; r++) {
+        cap = 32*(cnt[r+1]-cnt[r]+1);
+        for (c=cnt[r]; c<cnt[r+1]; c++) {
+            k = cand[c];
+            if ( lock[k] )  continue;
+
+            imin  = cedg[k];
+            i     = _MMG5_ifar[imin][0];
+            j     = _MMG5_iarfinv[i][imin];
+            ilist = _MMG5_boulevolp_reg(mesh,k,_MMG5_idir[i][_MMG5_inxt2[j]],
+                                        list,preg,r);
+            if ( !ilist )  continue;
+            for (l=0; l<ilist; l++)
+                if ( lock[list[l]/4] )  break;
+            if ( l < ilist || used[r]+ilist > cap )  continue;
+            if ( _MMG5_chkcol_ball(mesh,met,k,i,j,list,ilist,2) <= 0 )  continue;
+
+            for (l=0; l<ilist; l++)
+                lock[list[l]/4] = 1;
+            coff[c] = 32*(cnt[r]+r) + used[r];
+            clon[c] = ilist;
+            memcpy(&buf[coff[c]],list,ilist*sizeof(MMG5_int));
+            used[r] += ilist;
+        }
+    }
 
-                ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
+    /* sequential collapses */
+    ret  = 1;
+    ncol = 0;
+    for (c=0; c<ncand; c++) {
+        if ( !clon[c] )  continue;
+        k    = cand[c];
+        imin = cedg[k];
+        i    = _MMG5_ifar[imin][0];
+        j    = _MMG5_iarfinv[i][imin];
+        ier  = _MMG5_colver(mesh,met,&buf[coff[c]],(int)clon[c],
+                            _MMG5_idir[i][_MMG5_iprv2[j]]);
+        if ( ier < 0 ) {
+            ret = -1;
+            break;
+        }
+        else if ( ier ) {
+            _MMG5_delBucket(mesh,bucket,ier);
+            _MMG5_delPt(mesh,ier);
+            ncol++;
+        }
+    }
+    *nc += ncol;
 
-                /* if we realloc memory in _MMG5_split1b pt and pxt pointers are not valid */
-                pt = &mesh->tetra[k];
-                pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+    if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+        fprintf(stdout,"     %8" MMG5_PRId " concurrent collapses, %8" MMG5_PRId " deferred\n",
+                ncol,ncand-ncol);
 
-                if ( ier < 0 ) {
-                    fprintf(stdout,"  ## Error: unable to split.\n");
-                    _MMG5_delPt(mesh,ip);
-                    return(-1);
-                }
-                else if ( !ier ) {
-                    _MMG5_delPt(mesh,ip);
-                    goto collapse;
-                } else {
-                    (*ns)++;
-
-                    ppt = &mesh->point[ip];
-                    if ( MG_EDG(tag) || (tag & MG_NOM) )
-                        ppt->ref = ref;
-                    else
-                        ppt->ref = pxt->ref[i];
-                    ppt->tag = tag;
-                    if ( met->m )
-                        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-
-                    pxp = &mesh->xpoint[ppt->xp];
-                    if ( tag & MG_NOM ){
-                        memcpy(pxp->n1,no1,3*sizeof(double));
-                        memcpy(pxp->t,to,3*sizeof(double));
-                    }
-                    else if ( tag & MG_GEO ) {
-                        memcpy(pxp->n1,no1,3*sizeof(double));
-                        memcpy(pxp->n2,no2,3*sizeof(double));
-                        memcpy(pxp->t,to,3*sizeof(double));
-                    }
-                    else if ( tag & MG_REF ) {
-                        memcpy(pxp->n1,no1,3*sizeof(double));
-                        memcpy(pxp->t,to,3*sizeof(double));
-                    }
-                    else
-                        memcpy(pxp->n1,no1,3*sizeof(double));
+    _MMG5_DEL_MEM(mesh,work,nwork*sizeof(MMG5_int));
+    _MMG5_DEL_MEM(mesh,cedg,2*(ne+1)*sizeof(char));
+    _MMG5_DEL_MEM(mesh,preg,(mesh->np+1)*sizeof(int));
+    return(ret);
+}
+#endif
+
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param k index of the tetrahedron.
+ * \param imax local index of the edge to split.
+ * \param ifilt pointer to store the number of vertices filtered by the bucket.
+ * \param warn pointer to store a flag that warn the user in case of
+ * reallocation difficulty.
+ * \param kip pointer to store the new vertex as \a 4*k+i, \a i being its local
+ * index in the tetrahedron \a k (may be NULL).
+ * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
+ * the mesh, 1 if the edge is splitted, 2 if the split is rejected but the
+ * collapse of an edge may be tried, 3 if the edge can't be processed.
+ *
+ * Split the edge \a imax of the tetrahedron \a k: by bulging the midpoint on
+ * the surface for a boundary edge, by a pattern split for an internal edge of
+ * a boundary tetrahedron and by the delaunay kernel otherwise.
+ *
+ */
+static int
+_MMG5_splitEdg_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                      _MMG5_pScratch scr,MMG5_int k,int imax,MMG5_int *ifilt,int *warn,
+                      MMG5_int *kip) {
+    MMG5_pTetra     pt;
+    MMG5_pxTetra    pxt;
+    MMG5_Tria       ptt;
+    MMG5_pPoint     p0,p1,ppt;
+    MMG5_pxPoint    pxp;
+    double     dd,o[3],to[3],ro[3],no1[3],no2[3],v[3];
+    MMG5_int   ip,ip1,ip2,*list;
+    int        ilist,ref,lon,ret,ier;
+    char       tag,j,i,i1,i2,ifa0,ifa1;
+
+    list = scr->list;
+    pt   = &mesh->tetra[k];
+    pxt  = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+
+    ifa0 = _MMG5_ifar[imax][0];
+    ifa1 = _MMG5_ifar[imax][1];
+    i  = (pt->xt && (pxt->ftag[ifa1] & MG_BDY)) ? ifa1 : ifa0;
+    j  = _MMG5_iarfinv[i][imax];
+    i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
+    i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
+    ip1 = pt->v[i1];
+    ip2 = pt->v[i2];
+    p0  = &mesh->point[ip1];
+    p1  = &mesh->point[ip2];
+
+    /* Case of a boundary face */
+    if ( pt->xt && (pxt->ftag[i] & MG_BDY) ) {
+        if ( !(MG_GET(pxt->ori,i)) ) return(3);
+        ref = pxt->edg[_MMG5_iarf[i][j]];
+        tag = pxt->tag[_MMG5_iarf[i][j]];
+        if ( tag & MG_REQ )  return(3);
+        tag |= MG_BDY;
+        ilist = _MMG5_coquil(mesh,k,imax,list);
+        if ( !ilist )  return(3);
+        else if ( ilist<0 ) return(-1);
+        if ( tag & MG_NOM ){
+            if( !_MMG5_BezierNom(mesh,ip1,ip2,0.5,o,no1,to) )
+                return(3);
+            else if ( MG_SIN(p0->tag) && MG_SIN(p1->tag) ) {
+                _MMG5_tet2tri(mesh,k,i,&ptt);
+                _MMG5_nortri(mesh,&ptt,no1);
+                if ( !MG_GET(pxt->ori,i) ) {
+                    no1[0] *= -1.0;
+                    no1[1] *= -1.0;
+                    no1[2] *= -1.0;
                 }
-                continue;
             }
-            else if(pt->xt){
-                if ( (p0->tag & MG_BDY) && (p1->tag & MG_BDY) ) {
-                    continue;
+        }
+        else if ( tag & MG_GEO ) {
+            if ( !_MMG5_BezierRidge(mesh,ip1,ip2,0.5,o,no1,no2,to) )
+                return(3);
+            if ( MG_SIN(p0->tag) && MG_SIN(p1->tag) ) {
+                _MMG5_tet2tri(mesh,k,i,&ptt);
+                _MMG5_nortri(mesh,&ptt,no1);
+                no2[0] = to[1]*no1[2] - to[2]*no1[1];
+                no2[1] = to[2]*no1[0] - to[0]*no1[2];
+                no2[2] = to[0]*no1[1] - to[1]*no1[0];
+                dd = no2[0]*no2[0] + no2[1]*no2[1] + no2[2]*no2[2];
+                if ( dd > _MMG5_EPSD2 ) {
+                    dd = 1.0 / sqrt(dd);
+                    no2[0] *= dd;
+                    no2[1] *= dd;
+                    no2[2] *= dd;
                 }
-                ilist = _MMG5_coquil(mesh,k,imax,list);
-                if ( !ilist )    continue;
-                else if ( ilist<0 ) return(-1);
-                o[0] = 0.5*(p0->c[0] + p1->c[0]);
-                o[1] = 0.5*(p0->c[1] + p1->c[1]);
-                o[2] = 0.5*(p0->c[2] + p1->c[2]);
-                ip = _MMG5_newPt(mesh,o,MG_NOTAG);
-
-                if ( !ip )  {
-                    /* reallocation of point table */
-                    if ( bucket ) {
-                        _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
-                                                 *warn=1;
-                                                 goto collapse,
-                                                 o,MG_NOTAG);
-                    }
-                    else {
-                        printf("ERROR: function not available in delaunay mode. Exiting\n");
-                        exit(EXIT_FAILURE);
-                    }
+            }
+        }
+        else if ( tag & MG_REF ) {
+            if ( !_MMG5_BezierRef(mesh,ip1,ip2,0.5,o,no1,to) )
+                return(2);
+        }
+        else {
+            if ( !_MMG5_norface(mesh,k,i,v) )  return(2);
+            if ( !_MMG5_BezierReg(mesh,ip1,ip2,0.5,v,o,no1) ) return(2);
+        }
+        ier = _MMG5_simbulgept(mesh,met,list,ilist,o);
+        if ( !ier ) {
+            ier = _MMG5_dichoto1b(mesh,met,list,ilist,o,ro);
+            memcpy(o,ro,3*sizeof(double));
+        }
+        ip = _MMG5_newPt(mesh,o,tag);
+
+        if ( !ip ) {
+            /* reallocation of point table */
+            if ( bucket ) {
+                _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
+                                               *warn=1;
+                                               return(2),
+                                               o,tag);
+            }
+            else {
+                printf("ERROR: function not available in delaunay mode. Exiting\n");
+                exit(EXIT_FAILURE);
+            }
+        }
 
-                }
+        if ( met->m )
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
-                if ( met->m )
-                    met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+        ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
 
-                ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
-                if ( ier < 0 ) {
-                    fprintf(stdout,"  ## Error: unable to split.\n");
-                    _MMG5_delPt(mesh,ip);
-                    return(-1);
-                }
-                else if ( !ier ) {
-                    _MMG5_delPt(mesh,ip);
-                    goto collapse;
-                }
-                else {
-                    ppt = &mesh->point[ip];
-                    met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
-                    _MMG5_addBucket(mesh,bucket,ip);
-                    (*ns)++;
-                    continue;
-                }
+        /* if we realloc memory in _MMG5_split1b pt and pxt pointers are not valid */
+        pt = &mesh->tetra[k];
+        pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
 
-                /* Case of an internal face */
-            } else {
-                ilist = _MMG5_coquil(mesh,k,imax,list);
-                if ( !ilist )    continue;
-                else if ( ilist<0 ) return(-1);
-                else if(ilist%2) goto collapse; //bdry edge
-                o[0] = 0.5*(p0->c[0] + p1->c[0]);
-                o[1] = 0.5*(p0->c[1] + p1->c[1]);
-                o[2] = 0.5*(p0->c[2] + p1->c[2]);
-                ip = _MMG5_newPt(mesh,o,MG_NOTAG);
-
-                if ( !ip )  {
-                    /* reallocation of point table */
-                    if ( bucket ) {
-                        _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
-                                                 *warn=1;
-                                                 goto collapse,
-                                                 o,MG_NOTAG);
-                    }
-                    else {
-                        printf("ERROR: function not available in delaunay mode. Exiting\n");
-                        exit(EXIT_FAILURE);
-                    }
-                }
+        if ( ier < 0 ) {
+            fprintf(stdout,"  ## Error: unable to split.\n");
+            _MMG5_delPt(mesh,ip);
+            return(-1);
+        }
+        else if ( !ier ) {
+            _MMG5_delPt(mesh,ip);
+            return(2);
+        }
 
-                if ( met->m )
-                    met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-
-                /* Delaunay */
-                if ( !_MMG5_buckin_iso(mesh,met,bucket,ip) ) {
-                    _MMG5_delPt(mesh,ip);
-                    (*ifilt)++;
-                    goto collapse;
-                } else {
-                    lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2);
-                    if ( lon < 1 ) {
-                        MMG_npd++;
-                        _MMG5_delPt(mesh,ip);
-                        goto collapse;
-                    } else {
-                        ret = _MMG5_delone(mesh,met,ip,list,lon);
-                        if ( ret > 0 ) {
-                            ppt = &mesh->point[ip];
-                            met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
-
-                            _MMG5_addBucket(mesh,bucket,ip);
-                            (*ns)++;
-                            continue;
-                        }
-                        else if ( ret == 0 ) {
-                            MMG_npd++;
-                            _MMG5_delPt(mesh,ip);
-                            goto collapse;//continue;
-                        }
-                        else { /*allocation problem ==> saveMesh*/
-                            _MMG5_delPt(mesh,ip);
-                            return(0);
-                        }
-                    }
-                }
-            }
+        ppt = &mesh->point[ip];
+        if ( MG_EDG(tag) || (tag & MG_NOM) )
+            ppt->ref = ref;
+        else
+            ppt->ref = pxt->ref[i];
+        ppt->tag = tag;
+        if ( met->m )
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+
+        pxp = &mesh->xpoint[ppt->xp];
+        if ( tag & MG_NOM ){
+            memcpy(pxp->n1,no1,3*sizeof(double));
+            memcpy(pxp->t,to,3*sizeof(double));
         }
-    collapse:
-        if(lmin <= _MMG5_LOPTS_MMG5_DEL) {
-            ifa0 = _MMG5_ifar[imin][0];
-            ifa1 = _MMG5_ifar[imin][1];
-            i  =  (pt->xt && (pxt->ftag[ifa1] & MG_BDY)) ? ifa1 : ifa0;
-            j  = _MMG5_iarfinv[i][imin];
-            i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
-            i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
-            ip = pt->v[i1];
-            iq = pt->v[i2];
-            p0 = &mesh->point[ip];
-            p1 = &mesh->point[iq];
-
-            if ( (p0->tag > p1->tag) || (p0->tag & MG_REQ) )  continue;
-
-            /* Case of a boundary face */
-            ilist = 0;
-            if ( pt->xt && (pxt->ftag[i] & MG_BDY) ) {
-                tag = pxt->tag[_MMG5_iarf[i][j]];
-                if ( tag & MG_REQ )  continue;
-                tag |= MG_BDY;
-                if ( p0->tag > tag )   continue;
-                if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-                ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
-                if ( ilist > 0 ) {
-                    ier = _MMG5_colver(mesh,list,ilist,i2);
-
-                    if ( ier < 0 ) return(-1);
-                    else if(ier) {
-                        _MMG5_delPt(mesh,ier);
-                        (*nc)++;
-                        continue;
-                    }
-                }
-                else if (ilist < 0 )  return(-1);
+        else if ( tag & MG_GEO ) {
+            memcpy(pxp->n1,no1,3*sizeof(double));
+            memcpy(pxp->n2,no2,3*sizeof(double));
+            memcpy(pxp->t,to,3*sizeof(double));
+        }
+        else if ( tag & MG_REF ) {
+            memcpy(pxp->n1,no1,3*sizeof(double));
+            memcpy(pxp->t,to,3*sizeof(double));
+        }
+        else
+            memcpy(pxp->n1,no1,3*sizeof(double));
+    }
+    else if(pt->xt){
+        if ( (p0->tag & MG_BDY) && (p1->tag & MG_BDY) ) {
+            return(3);
+        }
+        ilist = _MMG5_coquil(mesh,k,imax,list);
+        if ( !ilist )    return(3);
+        else if ( ilist<0 ) return(-1);
+        o[0] = 0.5*(p0->c[0] + p1->c[0]);
+        o[1] = 0.5*(p0->c[1] + p1->c[1]);
+        o[2] = 0.5*(p0->c[2] + p1->c[2]);
+        ip = _MMG5_newPt(mesh,o,MG_NOTAG);
+
+        if ( !ip )  {
+            /* reallocation of point table */
+            if ( bucket ) {
+                _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
+                                               *warn=1;
+                                               return(2),
+                                               o,MG_NOTAG);
             }
-            /* Case of an internal face */
             else {
-                if ( p0->tag & MG_BDY )  continue;
-                ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
-                if ( ilist > 0 ) {
-                    ier = _MMG5_colver(mesh,list,ilist,i2);
-                    if ( ilist < 0 ) continue;
-                    if ( ier < 0 ) return(-1);
-                    else if(ier) {
-                        _MMG5_delBucket(mesh,bucket,ier);
-                        _MMG5_delPt(mesh,ier);
-                        (*nc)++;
-                        continue;
-                    }
-                }
-                else if (ilist < 0 )  return(-1);
+                printf("ERROR: function not available in delaunay mode. Exiting\n");
+                exit(EXIT_FAILURE);
             }
-        } //end if lmin < _MMG5_LOPTS_MMG5_DEL
+        }
 
-        /*2) longest and shortest edges are stucked => try another edges*/
-        imaxtet = imax;
-        imintet = imin;
-        lmaxtet = lmax;
-        lmintet = lmin;
-        for (ii=0; ii<6; ii++) {
-            if ( pt->xt && (pxt->tag[ii] & MG_REQ) )  continue;
-            if ( (ii==imintet) && (lmintet < _MMG5_LOPTS_MMG5_DEL)) continue;
-            if ( (ii==imaxtet) && (lmaxtet > _MMG5_LOPTL_MMG5_DEL) ) continue;
-
-            ip1  = _MMG5_iare[ii][0];
-            ip2  = _MMG5_iare[ii][1];
-            len = _MMG5_lenedg(mesh,met,pt->v[ip1],pt->v[ip2]);
-
-            imax = ii;
-            lmax = len;
-            imin = ii;
-            lmin = len;
-            if ( lmax >= _MMG5_LOPTL_MMG5_DEL )  {
-                /* proceed edges according to lengths */
-                ifa0 = _MMG5_ifar[imax][0];
-                ifa1 = _MMG5_ifar[imax][1];
-                i  = (pt->xt && (pxt->ftag[ifa1] & MG_BDY)) ? ifa1 : ifa0;
-                j  = _MMG5_iarfinv[i][imax];
-                i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
-                i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
-                ip1 = pt->v[i1];
-                ip2 = pt->v[i2];
-                p0  = &mesh->point[ip1];
-                p1  = &mesh->point[ip2];
-
-                /* Case of a boundary face */
-                if ( pt->xt && (pxt->ftag[i] & MG_BDY) ) {
-                    if ( !(MG_GET(pxt->ori,i)) ) continue;
-                    ref = pxt->edg[_MMG5_iarf[i][j]];
-                    tag = pxt->tag[_MMG5_iarf[i][j]];
-                    if ( tag & MG_REQ )  continue;
-                    tag |= MG_BDY;
-                    ilist = _MMG5_coquil(mesh,k,imax,list);
-                    if ( !ilist )  continue;
-                    else if ( ilist<0 ) return(-1);
-                    if ( tag & MG_NOM ){
-                        if( !_MMG5_BezierNom(mesh,ip1,ip2,0.5,o,no1,to) )
-                            continue;
-                        else if ( MG_SIN(p0->tag) && MG_SIN(p1->tag) ) {
-                            _MMG5_tet2tri(mesh,k,i,&ptt);
-                            _MMG5_nortri(mesh,&ptt,no1);
-                            if ( !MG_GET(pxt->ori,i) ) {
-                                no1[0] *= -1.0;
-                                no1[1] *= -1.0;
-                                no1[2] *= -1.0;
-                            }
-                        }
-                    }
-                    else if ( tag & MG_GEO ) {
-                        if ( !_MMG5_BezierRidge(mesh,ip1,ip2,0.5,o,no1,no2,to) )
-                            continue;
-                        if ( MG_SIN(p0->tag) && MG_SIN(p1->tag) ) {
-                            _MMG5_tet2tri(mesh,k,i,&ptt);
-                            _MMG5_nortri(mesh,&ptt,no1);
-                            no2[0] = to[1]*no1[2] - to[2]*no1[1];
-                            no2[1] = to[2]*no1[0] - to[0]*no1[2];
-                            no2[2] = to[0]*no1[1] - to[1]*no1[0];
-                            dd = no2[0]*no2[0] + no2[1]*no2[1] + no2[2]*no2[2];
-                            if ( dd > _MMG5_EPSD2 ) {
-                                dd = 1.0 / sqrt(dd);
-                                no2[0] *= dd;
-                                no2[1] *= dd;
-                                no2[2] *= dd;
-                            }
-                        }
-                    }
-                    else if ( tag & MG_REF ) {
-                        if ( !_MMG5_BezierRef(mesh,ip1,ip2,0.5,o,no1,to) )
-                            goto collapse2;
-                    }
-                    else {
-                        if ( !_MMG5_norface(mesh,k,i,v) )  goto collapse2;
-                        if ( !_MMG5_BezierReg(mesh,ip1,ip2,0.5,v,o,no1) ) goto collapse2;
-
-                    }
-                    ier = _MMG5_simbulgept(mesh,list,ilist,o);
-                    if ( !ier ) {
-                        ier = _MMG5_dichoto1b(mesh,list,ilist,o,ro);
-                        memcpy(o,ro,3*sizeof(double));
-                    }
-                    ip = _MMG5_newPt(mesh,o,tag);
-
-                    if ( !ip ){
-                        /* reallocation of point table */
-                        if ( bucket ) {
-                            _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
-                                                     *warn=1;
-                                                     goto collapse2//break
-                                                     ,o,tag);
-                        }
-                        else {
-                            printf("ERROR: function not available in delaunay mode. Exiting\n");
-                            exit(EXIT_FAILURE);
-                        }
-                    }
-
-                    if ( met->m )
-                        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-
-                    ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
-                    /* if we realloc memory in _MMG5_split1b pt and pxt pointers are not valid */
-                    pt = &mesh->tetra[k];
-                    pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
-
-                    if ( ier < 0 ) {
-                        fprintf(stdout,"  ## Error: unable to split.\n");
-                        return(-1);
-                    }
-                    else if ( !ier ) {
-                        _MMG5_delPt(mesh,ip);
-                        goto collapse2;//continue;
-                    } else {
-                        (*ns)++;
-                        //_MMG5_addBucket(mesh,bucket,ip);
-
-                        ppt = &mesh->point[ip];
-                        if ( MG_EDG(tag) || (tag & MG_NOM) )
-                            ppt->ref = ref;
-                        else
-                            ppt->ref = pxt->ref[i];
-                        ppt->tag = tag;
-                        if ( met->m )
-                            met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-
-                        pxp = &mesh->xpoint[ppt->xp];
-                        if ( tag & MG_NOM ){
-                            memcpy(pxp->n1,no1,3*sizeof(double));
-                            memcpy(pxp->t,to,3*sizeof(double));
-                        }
-                        else if ( tag & MG_GEO ) {
-                            memcpy(pxp->n1,no1,3*sizeof(double));
-                            memcpy(pxp->n2,no2,3*sizeof(double));
-                            memcpy(pxp->t,to,3*sizeof(double));
-                        }
-                        else if ( tag & MG_REF ) {
-                            memcpy(pxp->n1,no1,3*sizeof(double));
-                            memcpy(pxp->t,to,3*sizeof(double));
-                        }
-                        else
-                            memcpy(pxp->n1,no1,3*sizeof(double));
-                    }
-                    break;//imax continue;
-                }
-                else if(pt->xt){
-                    if ( (p0->tag & MG_BDY) && (p1->tag & MG_BDY) ) {
-                        continue;
-                    }
-                    ilist = _MMG5_coquil(mesh,k,imax,list);
-                    if ( !ilist )    continue;
-                    else if ( ilist<0 ) return(-1);
-                    o[0] = 0.5*(p0->c[0] + p1->c[0]);
-                    o[1] = 0.5*(p0->c[1] + p1->c[1]);
-                    o[2] = 0.5*(p0->c[2] + p1->c[2]);
-                    ip = _MMG5_newPt(mesh,o,MG_NOTAG);
-
-                    if ( !ip )  {
-                        /* reallocation of point table */
-                        if ( bucket ) {
-                            _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
-                                                     *warn=1;
-                                                     goto collapse2
-                                                     ,o,MG_NOTAG);
-                        }
-                        else {
-                            printf("ERROR: function not available in delaunay mode. Exiting\n");
-                            exit(EXIT_FAILURE);
-                        }
-                    }
-
-                    if ( met->m )
-                        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-
-                    ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
-                    if ( ier < 0 ) {
-                        fprintf(stdout,"  ## Error: unable to split.\n");
-                        _MMG5_delPt(mesh,ip);
-                        return(-1);
-                    }
-                    else if ( !ier ) {
-                        _MMG5_delPt(mesh,ip);
-                        goto collapse2;
-                    }
-                    else {
-                        ppt = &mesh->point[ip];
-                        met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
-                        _MMG5_addBucket(mesh,bucket,ip);
-                        (*ns)++;
-                        break;//imax continue;
-                    }
-                    printf("on doit pas passer la\n");
-                    /* Case of an internal face */
-                } else {
-                    ilist = _MMG5_coquil(mesh,k,imax,list);
-                    if ( !ilist )    continue;
-                    else if ( ilist<0 ) return(-1);
-                    else if(ilist%2) goto collapse2; //bdry edge
-                    o[0] = 0.5*(p0->c[0] + p1->c[0]);
-                    o[1] = 0.5*(p0->c[1] + p1->c[1]);
-                    o[2] = 0.5*(p0->c[2] + p1->c[2]);
-                    ip = _MMG5_newPt(mesh,o,MG_NOTAG);
-
-                    if ( !ip )  {
-                        /* reallocation of point table */
-                        if ( bucket ) {
-                            _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
-                                                     *warn=1;
-                                                     goto collapse2,
-                                                     o,MG_NOTAG);
-                        } else {
-                            printf("ERROR: function not available in delaunay mode. Exiting\n");
-                            exit(EXIT_FAILURE);
-                        }
-                    }
-
-                    if ( met->m )
-                        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
-
-                    if ( /*lmax>4 &&*/ /*it &&*/  !_MMG5_buckin_iso(mesh,met,bucket,ip) ) {
-                        _MMG5_delPt(mesh,ip);
-                        (*ifilt)++;
-                        goto collapse2;
-                    } else {
-                        lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2);
-                        if ( lon < 1 ) {
-                            MMG_npd++;
-                            _MMG5_delPt(mesh,ip);
-                            goto collapse2;
-                        } else {
-                            ret = _MMG5_delone(mesh,met,ip,list,lon);
-                            if ( ret > 0 ) {
-                                ppt = &mesh->point[ip];
-                                met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
-
-                                _MMG5_addBucket(mesh,bucket,ip);
-                                (*ns)++;
-                                break;//imax continue;
-                            }
-                            else if ( ret == 0 ) {
-                                MMG_npd++;
-                                _MMG5_delPt(mesh,ip);
-                                goto collapse2;//continue;
-                            }
-                            else { /*allocation problem ==> savemesh*/
-                                _MMG5_delPt(mesh,ip);
-                                return(0);
-                            }
-                        }
-                    }
-                }
-            }
-        collapse2:
-            if(lmin > _MMG5_LOPTS_MMG5_DEL) continue;
-            ifa0 = _MMG5_ifar[imin][0];
-            ifa1 = _MMG5_ifar[imin][1];
-            i  =  (pt->xt && (pxt->ftag[ifa1] & MG_BDY)) ? ifa1 : ifa0;
-            j  = _MMG5_iarfinv[i][imin];
-            i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
-            i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
-            ip = pt->v[i1];
-            iq = pt->v[i2];
-            p0 = &mesh->point[ip];
-            p1 = &mesh->point[iq];
-
-            if ( (p0->tag > p1->tag) || (p0->tag & MG_REQ) )  continue;
-
-            /* Case of a boundary face */
-            ilist = 0;
-            if ( pt->xt && (pxt->ftag[i] & MG_BDY) ) {
-                tag = pxt->tag[_MMG5_iarf[i][j]];
-                if ( tag & MG_REQ )  continue;
-                tag |= MG_BDY;
-                if ( p0->tag > tag )   continue;
-                if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-                ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
-                if ( ilist > 0 ) {
-                    ier = _MMG5_colver(mesh,list,ilist,i2);
-                    if ( ier < 0 ) return(-1);
-                    else if(ier) {
-                        _MMG5_delPt(mesh,ier);
-                        (*nc)++;
-                        break;
-                    }
-                }
-                else if (ilist < 0 )  return(-1);
+        if ( met->m )
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+
+        ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
+        if ( ier < 0 ) {
+            fprintf(stdout,"  ## Error: unable to split.\n");
+            _MMG5_delPt(mesh,ip);
+            return(-1);
+        }
+        else if ( !ier ) {
+            _MMG5_delPt(mesh,ip);
+            return(2);
+        }
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+        _MMG5_addBucket(mesh,bucket,ip);
+    }
+    /* Case of an internal face */
+    else {
+        ilist = _MMG5_coquil(mesh,k,imax,list);
+        if ( !ilist )    return(3);
+        else if ( ilist<0 ) return(-1);
+        else if(ilist%2) return(2); //bdry edge
+        o[0] = 0.5*(p0->c[0] + p1->c[0]);
+        o[1] = 0.5*(p0->c[1] + p1->c[1]);
+        o[2] = 0.5*(p0->c[2] + p1->c[2]);
+        ip = _MMG5_newPt(mesh,o,MG_NOTAG);
+
+        if ( !ip )  {
+            /* reallocation of point table */
+            if ( bucket ) {
+                _MMG5_POINT_AND_BUCKET_REALLOC(mesh,met,ip,mesh->gap,
+                                               *warn=1;
+                                               return(2),
+                                               o,MG_NOTAG);
             }
-            /* Case of an internal face */
             else {
-                if ( p0->tag & MG_BDY )  continue;
-                ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
-                if ( ilist > 0 ) {
-                    ier = _MMG5_colver(mesh,list,ilist,i2);
-                    if ( ilist < 0 ) continue;
-                    if ( ier < 0 ) return(-1);
-                    else if(ier) {
-                        _MMG5_delBucket(mesh,bucket,ier);
-                        _MMG5_delPt(mesh,ier);
-                        (*nc)++;
-                        break;
-                    }
-                }
-                else if (ilist < 0 )  return(-1);
+                printf("ERROR: function not available in delaunay mode. Exiting\n");
+                exit(EXIT_FAILURE);
             }
-        }//end for ii
+        }
+
+        if ( met->m )
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+
+        /* Delaunay */
+        if ( !_MMG5_buckin(mesh,met,bucket,ip) ) {
+            _MMG5_delPt(mesh,ip);
+            (*ifilt)++;
+            return(2);
+        }
+        lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2,scr);
+        if ( lon < 1 ) {
+            scr->npd++;
+            _MMG5_delPt(mesh,ip);
+            return(2);
+        }
+        ret = _MMG5_delone(mesh,met,ip,list,lon,scr);
+        if ( ret == 0 ) {
+            scr->npd++;
+            _MMG5_delPt(mesh,ip);
+            return(2);
+        }
+        else if ( ret < 0 ) {
+            /* allocation problem ==> saveMesh */
+            _MMG5_delPt(mesh,ip);
+            return(0);
+        }
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+        _MMG5_addBucket(mesh,bucket,ip);
+        /* the new tetra of the cavity hold the new point */
+        if ( kip ) {
+            pt = &mesh->tetra[scr->ielnum[1]];
+            for (j=0; j<4; j++)
+                if ( pt->v[j] == ip )  break;
+            *kip = j<4 ? 4*scr->ielnum[1]+j : 0;
+        }
+        return(1);
     }
 
+    /* split1b: the tetra of the shell hold the new point */
+    if ( kip ) {
+        pt = &mesh->tetra[list[0]/6];
+        for (j=0; j<4; j++)
+            if ( pt->v[j] == ip )  break;
+        *kip = j<4 ? 4*(list[0]/6)+j : 0;
+    }
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param list ball of the collapsed vertex.
+ * \param ilist size of the ball.
+ * \param iq remaining vertex.
+ * \return \a 4*k+i if the vertex \a iq is the vertex \a i of the tetrahedron
+ * \a k of the ball, 0 if not found.
+ *
+ * Must be called after \a _MMG5_colver: the entries of the ball that were
+ * negated by the collapse refer to deleted tetrahedra and are skipped.
+ */
+static inline MMG5_int
+_MMG5_colVer_kept(MMG5_pMesh mesh,MMG5_int *list,int ilist,MMG5_int iq) {
+    MMG5_pTetra  pt;
+    int          l;
+    char         i;
+
+    for (l=0; l<ilist; l++) {
+        /* shell of the collapsed edge: negated by _MMG5_colver, deleted */
+        if ( list[l] <= 0 )  continue;
+        pt = &mesh->tetra[list[l]/4];
+        if ( !MG_EOK(pt) )  continue;
+        for (i=0; i<4; i++)
+            if ( pt->v[i] == iq )  return(4*(list[l]/4)+i);
+    }
+    return(0);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
  * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param k index of the tetrahedron.
+ * \param imin local index of the edge to collapse.
+ * \param kip pointer to store the remaining vertex as \a 4*k+i, \a i being
+ * its local index in the tetrahedron \a k (may be NULL).
+ * \return -1 if fail, 1 if the edge is collapsed, 2 if the collapse is
+ * rejected by the geometric checks, 3 if the edge can't be collapsed.
+ *
+ * Collapse the edge \a imin of the tetrahedron \a k.
+ *
+ */
+static int
+_MMG5_colEdg_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                    _MMG5_pScratch scr,MMG5_int k,int imin,MMG5_int *kip) {
+    MMG5_pTetra     pt;
+    MMG5_pxTetra    pxt;
+    MMG5_pPoint     p0,p1;
+    MMG5_int   ip,iq,*list,ier;
+    int        ilist;
+    char       tag,j,i,i1,i2,ifa0,ifa1;
+
+    list = scr->list;
+    pt   = &mesh->tetra[k];
+    pxt  = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+
+    ifa0 = _MMG5_ifar[imin][0];
+    ifa1 = _MMG5_ifar[imin][1];
+    i  =  (pt->xt && (pxt->ftag[ifa1] & MG_BDY)) ? ifa1 : ifa0;
+    j  = _MMG5_iarfinv[i][imin];
+    i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
+    i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
+    ip = pt->v[i1];
+    iq = pt->v[i2];
+    p0 = &mesh->point[ip];
+    p1 = &mesh->point[iq];
+    if ( kip )  *kip = 0;
+
+    if ( (p0->tag > p1->tag) || (p0->tag & MG_REQ) )  return(3);
+
+    /* Case of a boundary face */
+    ilist = 0;
+    if ( pt->xt && (pxt->ftag[i] & MG_BDY) ) {
+        tag = pxt->tag[_MMG5_iarf[i][j]];
+        if ( tag & MG_REQ )  return(3);
+        tag |= MG_BDY;
+        if ( p0->tag > tag )   return(3);
+        if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) return(3);
+        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
+        if ( ilist > 0 ) {
+            ier = _MMG5_colver(mesh,met,list,ilist,i2);
+            if ( ier < 0 ) return(-1);
+            else if(ier) {
+                _MMG5_delPt(mesh,ier);
+                if ( kip )  *kip = _MMG5_colVer_kept(mesh,list,ilist,iq);
+                return(1);
+            }
+        }
+        else if (ilist < 0 )  return(-1);
+    }
+    /* Case of an internal face */
+    else {
+        if ( p0->tag & MG_BDY )  return(3);
+        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
+        if ( ilist > 0 ) {
+            ier = _MMG5_colver(mesh,met,list,ilist,i2);
+            if ( ier < 0 ) return(-1);
+            else if(ier) {
+                _MMG5_delBucket(mesh,bucket,ier);
+                _MMG5_delPt(mesh,ier);
+                if ( kip )  *kip = _MMG5_colVer_kept(mesh,list,ilist,iq);
+                return(1);
+            }
+        }
+        else if (ilist < 0 )  return(-1);
+    }
+    return(2);
+}
+
+#define _MMG5_TMET iso
+#include "mmg3d1_delone_tpl.h"
+#undef  _MMG5_TMET
+
+#define _MMG5_TMET ani
+#include "mmg3d1_delone_tpl.h"
+#undef  _MMG5_TMET
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param ne number of elements.
+ * \param ifilt pointer to store the number of vertices filtered by the bucket.
+ * \param ns pointer to store the number of vertices insertions.
+ * \param nc pointer to store the number of collapse.
+ * \param warn pointer to store a flag that warn the user in case of
+ * reallocation difficulty.
+ * \param it iteration index.
+ * \param stamp table of element stamps (may be NULL).
+ * \param nvis pointer to store the number of analyzed tetrahedra.
+ * \param nmod pointer to store the number of tetrahedra whose analysis leads
+ * to a split or a collapse.
+ * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
+ * the mesh, 1 otherwise.
+ *
+ * Call the instance of the \ref adpsplcol loop matching the metric type.
+ *
+ */
+static inline int
+_MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,
+                 _MMG5_pScratch scr,MMG5_int ne,
+                 MMG5_int* ifilt,MMG5_int* ns,MMG5_int* nc,int* warn,int it,
+                 _MMG5_pStamp stamp,MMG5_int *nvis,MMG5_int *nmod) {
+    if ( met->size < 6 )
+        return(_MMG5_boucle_for_iso(mesh,met,bucket,scr,ne,ifilt,ns,nc,warn,it,
+                                    stamp,nvis,nmod));
+    return(_MMG5_boucle_for_ani(mesh,met,bucket,scr,ne,ifilt,ns,nc,warn,it,
+                                stamp,nvis,nmod));
+}
+
+/** Edge of the priority queues of \ref _MMG5_boucle_queue. */
+typedef struct {
+    double   key; /**< length of the edge (opposite length for the splits) */
+    MMG5_int a,b; /**< extremities of the edge */
+    MMG5_int k;   /**< tetrahedron holding the edge when it is pushed */
+    int      gen; /**< number of operations leading to the edge in the sweep */
+} _MMG5_qedge;
+
+/** Binary heap of edges, the smallest key being on top. */
+typedef struct {
+    MMG5_int      siz,n;
+    _MMG5_qedge  *item;
+} _MMG5_Heap;
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param heap pointer toward the heap.
+ * \param key key of the edge.
+ * \param a first extremity of the edge.
+ * \param b second extremity of the edge.
+ * \param k tetrahedron holding the edge.
+ * \param gen generation of the edge.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Insert the edge \a ab in the heap.
+ *
+ */
+static int
+_MMG5_heapPush(MMG5_pMesh mesh,_MMG5_Heap *heap,double key,MMG5_int a,MMG5_int b,MMG5_int k,
+               int gen) {
+    _MMG5_qedge  *q;
+    MMG5_int      i,p,siz;
+
+    if ( heap->n == heap->siz ) {
+        siz = MG_MAX(1024,2*heap->siz);
+        _MMG5_ADD_MEM(mesh,(siz-heap->siz)*sizeof(_MMG5_qedge),"edge queue",
+                      return(0));
+        if ( !heap->item )
+            _MMG5_SAFE_MALLOC(heap->item,siz,_MMG5_qedge);
+        else
+            _MMG5_SAFE_REALLOC(heap->item,siz,_MMG5_qedge,"edge queue");
+        heap->siz = siz;
+    }
+    q = heap->item;
+    i = heap->n++;
+    while ( i > 0 ) {
+        p = (i-1)/2;
+        if ( q[p].key <= key )  break;
+        q[i] = q[p];
+        i    = p;
+    }
+    q[i].key = key;
+    q[i].a   = a;
+    q[i].b   = b;
+    q[i].k   = k;
+    q[i].gen = gen;
+    return(1);
+}
+
+/**
+ * \param heap pointer toward the heap.
+ * \param e pointer to store the edge of smallest key.
+ * \return 0 if the heap is empty, 1 otherwise.
+ *
+ * Remove the edge of smallest key from the heap.
+ *
+ */
+static int
+_MMG5_heapPop(_MMG5_Heap *heap,_MMG5_qedge *e) {
+    _MMG5_qedge  *q,last;
+    MMG5_int      i,c;
+
+    if ( !heap->n )  return(0);
+    q    = heap->item;
+    *e   = q[0];
+    last = q[--heap->n];
+    i    = 0;
+    while ( (c = 2*i+1) < heap->n ) {
+        if ( c+1 < heap->n && q[c+1].key < q[c].key )  c++;
+        if ( last.key <= q[c].key )  break;
+        q[i] = q[c];
+        i    = c;
+    }
+    q[i] = last;
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param map edges stored in the heaps.
+ * \param hspl heap of the edges to split.
+ * \param hcol heap of the edges to collapse.
+ * \param k index of the tetrahedron.
+ * \param gen generation of the pushed edges.
+ * \return 0 if the tetrahedron has no edge to split or collapse, 1 otherwise.
+ *
+ * Push the edges of the tetrahedron \a k that are too long in \a hspl and the
+ * edges that are too short in \a hcol. An edge is stored only once. If the
+ * memory is lacking the edge is not stored: it will be processed by the next
+ * sweep.
+ *
+ */
+static int
+_MMG5_queueTet(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_EdgeMap *map,
+               _MMG5_Heap *hspl,_MMG5_Heap *hcol,MMG5_int k,int gen) {
+    MMG5_pTetra   pt;
+    MMG5_pxTetra  pxt;
+    double        len;
+    MMG5_int      ia,ib;
+    int           ier;
+    char          i;
+
+    pt  = &mesh->tetra[k];
+    pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+    ier = 0;
+    for (i=0; i<6; i++) {
+        if ( pt->xt && (pxt->tag[i] & MG_REQ) )  continue;
+        ia  = pt->v[_MMG5_iare[i][0]];
+        ib  = pt->v[_MMG5_iare[i][1]];
+        len = _MMG5_lenedg(mesh,met,ia,ib);
+        if ( len < _MMG5_LOPTL_MMG5_DEL && len > _MMG5_LOPTS_MMG5_DEL )  continue;
+        ier = 1;
+        if ( _MMG5_edgeMapGet(map,ia,ib) )  continue;
+        if ( len >= _MMG5_LOPTL_MMG5_DEL ) {
+            if ( !_MMG5_heapPush(mesh,hspl,-len,ia,ib,k,gen) )  continue;
+        }
+        else if ( !_MMG5_heapPush(mesh,hcol,len,ia,ib,k,gen) )  continue;
+        if ( !_MMG5_edgeMapAdd(mesh,map,ia,ib,1) ) {
+            /* the edge may be pushed twice: it will be rejected at the
+             * second pop */
+            continue;
+        }
+    }
+    return(ier);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param e edge popped from a heap.
+ * \return the local index of the edge \a e in the tetrahedron \a e->k, -1 if
+ * the edge is no longer in this tetrahedron.
+ */
+static int
+_MMG5_queueEdg(MMG5_pMesh mesh,_MMG5_qedge *e) {
+    MMG5_pTetra   pt;
+    MMG5_pxTetra  pxt;
+    MMG5_int      ia,ib;
+    char          i;
+
+    pt = &mesh->tetra[e->k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  return(-1);
+    pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+    for (i=0; i<6; i++) {
+        ia = pt->v[_MMG5_iare[i][0]];
+        ib = pt->v[_MMG5_iare[i][1]];
+        if ( (ia==e->a && ib==e->b) || (ia==e->b && ib==e->a) ) {
+            if ( pt->xt && (pxt->tag[i] & MG_REQ) )  return(-1);
+            return(i);
+        }
+    }
+    return(-1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param ne number of elements.
+ * \param ifilt pointer to store the number of vertices filtered by the bucket.
+ * \param ns pointer to store the number of vertices insertions.
+ * \param nc pointer to store the number of collapse.
+ * \param warn pointer to store a flag that warn the user in case of
+ * reallocation difficulty.
+ * \param stamp table of element stamps (may be NULL).
+ * \param nvis pointer to store the number of analyzed tetrahedra.
+ * \param nmod pointer to store the number of tetrahedra whose analysis leads
+ * to a split or a collapse.
+ * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
+ * the mesh, 1 otherwise.
+ *
+ * \ref adpsplcol loop processing the edges by length order (\a -queue
+ * option): the edges longer than \ref _MMG5_LOPTL_MMG5_DEL are splitted
+ * longest first, then the edges shorter than \ref _MMG5_LOPTS_MMG5_DEL are
+ * collapsed shortest first. After each operation, the edges of the modified
+ * tetrahedra are pushed in the queues, so the edges created by a split or a
+ * collapse are processed in the same sweep.
+ *
+ */
+static int
+_MMG5_boucle_queue(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,
+                   _MMG5_pScratch scr,MMG5_int ne,
+                   MMG5_int* ifilt,MMG5_int* ns,MMG5_int* nc,int* warn,
+                   _MMG5_pStamp stamp,MMG5_int *nvis,MMG5_int *nmod) {
+    MMG5_pTetra    pt;
+    _MMG5_EdgeMap  map;
+    _MMG5_Heap     hspl,hcol;
+    _MMG5_qedge    e;
+    MMG5_int       list[_MMG5_LMAX+2],k,kip;
+    int            ilist,l,ier,pass;
+    char           i;
+
+    if ( !_MMG5_edgeMapNew(mesh,&map,7*mesh->np) )
+        return(_MMG5_boucle_for(mesh,met,bucket,scr,ne,ifilt,ns,nc,warn,0,
+                                stamp,nvis,nmod));
+    memset(&hspl,0,sizeof(_MMG5_Heap));
+    memset(&hcol,0,sizeof(_MMG5_Heap));
+
+    /* initial queues */
+    for (k=mesh->nefrz+1; k<=ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+        if ( stamp && _MMG5_chkStamp(&stamp[k],pt) )  continue;
+        (*nvis)++;
+        if ( !_MMG5_queueTet(mesh,met,&map,&hspl,&hcol,k,0) && stamp )
+            _MMG5_setStamp(&stamp[k],pt);
+    }
+
+    ier = 1;
+    /* the collapses may create long edges and the splits short ones */
+    for (pass=0; pass<3 && (hspl.n || hcol.n); pass++) {
+        /* 1) split the longest edges first */
+        while ( _MMG5_heapPop(&hspl,&e) ) {
+            _MMG5_edgeMapPop(&map,e.a,e.b);
+            i = _MMG5_queueEdg(mesh,&e);
+            if ( i < 0 )  continue;
+
+            ier = _MMG5_splitEdg_delone(mesh,met,bucket,scr,e.k,i,ifilt,warn,&kip);
+            if ( ier < 1 )  goto end;
+            else if ( ier != 1 )  continue;
+            (*ns)++;
+
+            /* local update: edges of the ball of the new point */
+            if ( !kip || e.gen >= _MMG5_QGEN )  continue;
+            ilist = _MMG5_boulevolp(mesh,kip/4,kip%4,list);
+            for (l=0; l<ilist; l++)
+                _MMG5_queueTet(mesh,met,&map,&hspl,&hcol,list[l]/4,e.gen+1);
+        }
+
+        /* 2) collapse the shortest edges first */
+        while ( _MMG5_heapPop(&hcol,&e) ) {
+            _MMG5_edgeMapPop(&map,e.a,e.b);
+            i = _MMG5_queueEdg(mesh,&e);
+            if ( i < 0 )  continue;
+
+            ier = _MMG5_colEdg_delone(mesh,met,bucket,scr,e.k,i,&kip);
+            if ( ier < 0 )  goto end;
+            else if ( ier != 1 )  continue;
+            (*nc)++;
+
+            /* local update: edges of the ball of the remaining point */
+            if ( !kip || e.gen >= _MMG5_QGEN )  continue;
+            ilist = _MMG5_boulevolp(mesh,kip/4,kip%4,list);
+            for (l=0; l<ilist; l++)
+                _MMG5_queueTet(mesh,met,&map,&hspl,&hcol,list[l]/4,e.gen+1);
+        }
+    }
+    ier = 1;
+
+end:
+    _MMG5_edgeMapFree(mesh,&map);
+    if ( hspl.item )
+        _MMG5_DEL_MEM(mesh,hspl.item,hspl.siz*sizeof(_MMG5_qedge));
+    if ( hcol.item )
+        _MMG5_DEL_MEM(mesh,hcol.item,hcol.siz*sizeof(_MMG5_qedge));
+    *nmod = *ns + *nc;
+    return(ier);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param warn pointer to store a flag that warn the user in case of
+ * reallocation difficulty.
  * \return -1 if fail and we dont try to end the remesh process,
  * 0 if fail but we try to end the remesh process and 1 if success.
  *
@@ -733,26 +1077,101 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
  *
  */
 static int
-_MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
-    int        ifilt,ne,ier;
-    int        ns,nc,it,nnc,nns,nnf,nnm,maxit,nf,nm;
+_MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                _MMG5_pScratch scr,int* warn) {
+    MMG5_int   ifilt,ne;
+    int        ier;
+    MMG5_int   ns,nc,nnc,nns,nnf,nnm,nf,nm,nvis,nmod,nstamp;
+    int        it,maxit;
     double     maxgap;
+    _MMG5_pStamp stamp;
+
+    /* stamps of the tetra without edge to split or collapse */
+    stamp  = NULL;
+    nstamp = 0;
 
     /* Iterative mesh modifications */
-    it = nnc = nns = nnf = nnm = 0;
+    it  = 0;
+    nnc = nns = nnf = nnm = 0;
     maxit = 10;
     mesh->gap = maxgap = 0.5;
-    MMG_npuiss = MMG_nvol = MMG_npres = MMG_npd = 0;
+    scr->npuiss = scr->nvol = scr->npres = scr->npd = 0;
     do {
+        /* restore the memory locality lost by the use of the free lists */
+        if ( it ) {
+            ier = _MMG5_sfcReorder(mesh,met,bucket);
+            if ( !ier ) {
+                if ( stamp )
+                    _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
+                return(-1);
+            }
+            else if ( ier == 2 && stamp )
+                memset(stamp,0,(nstamp+1)*sizeof(_MMG5_Stamp));
+        }
+
         if ( !mesh->info.noinsert ) {
+            /* the tetra table may have grown */
+            _MMG5_growScratch(mesh,scr);
+            if ( mesh->nemax > nstamp ) {
+                ier = 1;
+                _MMG5_ADD_MEM(mesh,(mesh->nemax-nstamp)*sizeof(_MMG5_Stamp),
+                              "tetra stamps",ier = 0);
+                if ( ier ) {
+                    if ( !stamp )
+                        _MMG5_SAFE_CALLOC(stamp,mesh->nemax+1,_MMG5_Stamp);
+                    else
+                        _MMG5_SAFE_RECALLOC(stamp,nstamp+1,mesh->nemax+1,
+                                            _MMG5_Stamp,"tetra stamps");
+                    nstamp = mesh->nemax;
+                }
+                else if ( stamp ) {
+                    _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
+                    nstamp = 0;
+                }
+            }
             *warn=0;
             ns = nc = 0;
             nf = nm = 0;
+            nvis = nmod = 0;
             ifilt = 0;
             ne = mesh->ne;
-            ier = _MMG5_boucle_for(mesh,met,bucket,ne,&ifilt,&ns,&nc,warn,it);
+#ifdef USE_OPENMP
+            if ( mesh->info.threads > 1 ) {
+                /* concurrent insertion in the regions, the remaining edges
+                 * are processed by the sequential sweep */
+                ier = _MMG5_delone_mt(mesh,met,bucket,scr,_MMG5_LOPTL_MMG5_DEL,
+                                      &ifilt,&ns,warn);
+                if(ier<0) exit(EXIT_FAILURE);
+                else if(!ier) {
+                    if ( stamp )
+                        _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
+                    return(-1);
+                }
+
+                /* concurrent collapses in the regions */
+                if ( _MMG5_colelt_mt(mesh,met,bucket,&nc) < 0 )
+                    exit(EXIT_FAILURE);
+
+                if ( stamp )
+                    _MMG5_stampOkTets(mesh,met,ne,stamp);
+            }
+#endif
+            if ( mesh->info.queue )
+                ier = _MMG5_boucle_queue(mesh,met,bucket,scr,ne,&ifilt,&ns,&nc,
+                                         warn,stamp,&nvis,&nmod);
+            else
+                ier = _MMG5_boucle_for(mesh,met,bucket,scr,ne,&ifilt,&ns,&nc,
+                                       warn,it,stamp,&nvis,&nmod);
             if(ier<0) exit(EXIT_FAILURE);
-            else if(!ier) return(-1);
+            else if(!ier) {
+                if ( stamp )
+                    _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
+                return(-1);
+            }
+
+            if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+                fprintf(stdout,"     %8" MMG5_PRId " analyzed, %8" MMG5_PRId " modified, %8" MMG5_PRId " skipped\n",
+                        nvis,nmod,ne-nvis);
         } /* End conditional loop on mesh->info.noinsert */
         else  ns = nc = ifilt = 0;
 
@@ -760,6 +1179,8 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
             nf = _MMG5_swpmsh(mesh,met,bucket);
             if ( nf < 0 ) {
                 fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
+                if ( stamp )
+                    _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
                 return(0);
             }
             nnf += nf;
@@ -770,6 +1191,8 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
             }
             if ( nf < 0 ) {
                 fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
+                if ( stamp )
+                    _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
                 return(0);
             }
         }
@@ -780,6 +1203,8 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
             nm = _MMG5_movtet(mesh,met,-1);
             if ( nm < 0 ) {
                 fprintf(stdout,"  ## Unable to improve mesh.\n");
+                if ( stamp )
+                    _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
                 return(0);
             }
         }
@@ -797,13 +1222,16 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
 
 
         if ( ((abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && ns+nc > 0) )
-            fprintf(stdout,"     %8d filtered %8d splitted, %8d collapsed, %8d swapped, %8d moved\n",ifilt,ns,nc,nf,nm);
-        if ( ns < 10 && abs(nc-ns) < 3 )  break;
-        else if ( it > 3 && abs(nc-ns) < 0.3 * MG_MAX(nc,ns) )  break;
+            fprintf(stdout,"     %8" MMG5_PRId " filtered %8" MMG5_PRId " splitted, %8" MMG5_PRId " collapsed, %8" MMG5_PRId " swapped, %8" MMG5_PRId " moved\n",ifilt,ns,nc,nf,nm);
+        if ( ns < 10 && MG_ABS(nc-ns) < 3 )  break;
+        else if ( it > 3 && MG_ABS(nc-ns) < 0.3 * MG_MAX(nc,ns) )  break;
 
     }
     while( ++it < maxit && nc+ns > 0 );
 
+    if ( stamp )
+        _MMG5_DEL_MEM(mesh,stamp,(nstamp+1)*sizeof(_MMG5_Stamp));
+
     return(1);
 }
 
@@ -818,11 +1246,13 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
  */
 static int
 _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
-    int it,nnm,nnf,maxit,nm,nf;
+    MMG5_int nnm,nnf,nm,nf;
+    int      it,maxit;
     double declic;
 
     /* shape optim */
-    it = nnm = nnf = 0;
+    it  = 0;
+    nnm = nnf = 0;
     maxit = 4;
     declic = 1.053;
     do {
@@ -861,7 +1291,7 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
 
         if ( (abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && nf+nm > 0 ){
             fprintf(stdout,"                                            ");
-            fprintf(stdout,"%8d swapped, %8d moved\n",nf,nm);
+            fprintf(stdout,"%8" MMG5_PRId " swapped, %8" MMG5_PRId " moved\n",nf,nm);
         }
     }
     while( ++it < maxit && nm+nf > 0 );
@@ -877,7 +1307,7 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
     nnm += nm;
     if ( (abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && nm > 0 )
         fprintf(stdout,"                                            ");
-    fprintf(stdout,"                  %8d moved\n",nm);
+    fprintf(stdout,"                  %8" MMG5_PRId " moved\n",nm);
 
     return(1);
 }
@@ -886,6 +1316,7 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
  * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
  * \return 0 if failed, 1 otherwise.
  *
  * Analyze tetrahedra and split long / collapse short, according to
@@ -893,8 +1324,9 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
  *
  */
 static int
-_MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
-    int      nnf,ns,nf;
+_MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,
+                    _MMG5_pScratch scr) {
+    MMG5_int nnf,ns,nf;
     int      warn;
 
     /*initial swap*/
@@ -921,7 +1353,7 @@ _MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
     /* Iterative mesh modifications */
     warn = 0;
 
-    ns = _MMG5_adpsplcol(mesh,met,bucket,&warn);
+    ns = _MMG5_adpsplcol(mesh,met,bucket,scr,&warn);
 
     if ( ns < 0 ) {
         fprintf(stdout,"  ## Unable to complete mesh. Exit program.\n");
@@ -937,8 +1369,12 @@ _MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
         return(0);
     }
 
-    /* renumerotation if available */
-    if ( !_MMG5_scotchCall(mesh,met) )
+    /* renumerotation if available (the bucket points are renumbered too) */
+    if ( mesh->info.renum >= _MMG5_RENUM_HILBERT ) {
+        if ( !_MMG5_sfcCall(mesh,met,bucket) )
+            return(0);
+    }
+    else if ( !_MMG5_scotchCall(mesh,met) )
         return(0);
 
     if(!_MMG5_optet(mesh,met,bucket)) return(0);
@@ -955,7 +1391,8 @@ _MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
  *
  */
 int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
-    _MMG5_pBucket bucket;
+    _MMG5_pBucket  bucket;
+    _MMG5_pScratch scr;
 
     if ( abs(mesh->info.imprim) > 3 )
         fprintf(stdout,"  ** MESH ANALYSIS\n");
@@ -969,6 +1406,9 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( abs(mesh->info.imprim) > 3 || mesh->info.ddebug )
         fprintf(stdout,"  ** GEOMETRIC MESH\n");
 
+    /* qualities in the anisotropic metric */
+    _MMG5_tetqua(mesh,met);
+
     if ( !_MMG5_anatet(mesh,met,1,0) ) {
         fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
         return(0);
@@ -992,6 +1432,7 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
         fprintf(stdout,"  ## Gradation problem. Exit program.\n");
         return(0);
     }
+    _MMG5_tetqua(mesh,met);
     if ( !_MMG5_anatet(mesh,met,2,0) ) {
         fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
         return(0);
@@ -1006,14 +1447,32 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( !_MMG5_scotchCall(mesh,met) )
         return(0);
 
+    /* preallocation of the tables (and bucket) at the predicted final size */
+    _MMG5_presize(mesh,met);
+
     /* CEC : create filter */
-    bucket = _MMG5_newBucket(mesh,mesh->info.bucket); //M_MAX(mesh->mesh->info.bucksiz,BUCKSIZ));
+    bucket = _MMG5_newBucket(mesh,met,mesh->info.bucket); //M_MAX(mesh->mesh->info.bucksiz,BUCKSIZ));
     if ( !bucket )  return(0);
 
-    if ( !_MMG5_adptet_delone(mesh,met,bucket) ) {
+    /* memory reused by the delaunay kernel */
+    scr = _MMG5_newScratch(mesh);
+    if ( !scr ) {
+        _MMG5_freeBucket(mesh,bucket);
+        return(0);
+    }
+
+    if ( !_MMG5_adptet_delone(mesh,met,bucket,scr) ) {
         fprintf(stdout,"  ## Unable to adapt. Exit program.\n");
+        _MMG5_freeScratch(mesh,scr);
+        _MMG5_freeBucket(mesh,bucket);
         return(0);
     }
+    if ( (abs(mesh->info.imprim) > 4 || mesh->info.ddebug) && scr->sph )
+        fprintf(stdout,"     circumsphere cache: %lld hits, %lld misses (%.1f%%)\n",
+                scr->nhit,scr->nmiss,
+                100.*scr->nhit/MG_MAX(1,scr->nhit+scr->nmiss));
+    _MMG5_freeScratch(mesh,scr);
+    _MMG5_freeBucket(mesh,bucket);
 
 #ifdef DEBUG
     puts("---------------------Fin adptet-----------------");
@@ -1030,10 +1489,5 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
         return(0);
     }
 
-    /*free bucket*/
-    _MMG5_DEL_MEM(mesh,bucket->head,(bucket->size*bucket->size*bucket->size+1)*sizeof(int));
-    _MMG5_DEL_MEM(mesh,bucket->link,(mesh->npmax+1)*sizeof(int));
-    _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
-
     return(1);
 }
@@ -0,0 +1,186 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/mmg3d1_delone_tpl.h
+ * \brief Sweeps of mmg3d1_delone.c, instantiated for each metric type.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by mmg3d1_delone.c after the definition of
+ * \a _MMG5_TMET (see metric_kernels.h).
+ *
+ */
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param scr pointer toward the scratch memory of the delaunay kernel.
+ * \param ne number of elements.
+ * \param ifilt pointer to store the number of vertices filtered by the bucket.
+ * \param ns pointer to store the number of vertices insertions.
+ * \param nc pointer to store the number of collapse.
+ * \param warn pointer to store a flag that warn the user in case of
+ * reallocation difficulty.
+ * \param it iteration index.
+ * \param stamp table of element stamps (may be NULL).
+ * \param nvis pointer to store the number of analyzed tetrahedra.
+ * \param nmod pointer to store the number of tetrahedra whose analysis leads
+ * to a split or a collapse.
+ * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
+ * the mesh, 1 otherwise.
+ *
+ * \ref adpsplcol loop: split edges longer than \ref _MMG5_LOPTL_MMG5_DEL and
+ * collapse edges shorter than \ref _MMG5_LOPTS_MMG5_DEL. A tetrahedron
+ * without edge to split or collapse is stamped; it is skipped by the next
+ * sweeps as long as it is not modified (by a split, a collapse, a swap or a
+ * move), thus only the dirty tetrahedra are analyzed.
+ *
+ */
+static int
+_MMG5_TNAME(_MMG5_boucle_for)(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,
+                                _MMG5_pScratch scr,MMG5_int ne,
+                                MMG5_int* ifilt,MMG5_int* ns,MMG5_int* nc,
+                                int* warn,int it,_MMG5_pStamp stamp,
+                                MMG5_int *nvis,MMG5_int *nmod) {
+    MMG5_pTetra     pt;
+    MMG5_pxTetra    pxt;
+    double     len,lmax;
+    MMG5_int   k,ip1,ip2;
+    int        ier;
+    char       imax;
+    double     lmin;
+    int        imin;
+    int        ii;
+    double     lmaxtet,lmintet;
+    int        imaxtet,imintet;
+    MMG5_int   nop;
+
+    nop  = *ns + *nc;
+    for (k=mesh->nefrz+1; k<=ne; k++) {
+        /* the previous analyzed tetra has been modified */
+        if ( *ns + *nc != nop ) {
+            nop = *ns + *nc;
+            (*nmod)++;
+        }
+
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt)  || (pt->tag & MG_REQ) )   continue;
+
+        /* unmodified tetra without edge to split or collapse */
+        if ( stamp && _MMG5_chkStamp(&stamp[k],pt) )  continue;
+        (*nvis)++;
+
+        pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+
+        /* 1) find longest and shortest edge  and try to manage it*/
+        imax = -1; lmax = 0.0;
+        imin = -1; lmin = DBL_MAX;
+        for (ii=0; ii<6; ii++) {
+            if ( pt->xt && (pxt->tag[ii] & MG_REQ) )  continue;
+            ip1  = _MMG5_iare[ii][0];
+            ip2  = _MMG5_iare[ii][1];
+            len = _MMG5_TLENEDG(mesh,met,pt->v[ip1],pt->v[ip2]);
+            if ( len > lmax ) {
+                lmax = len;
+                imax = ii;
+            }
+            if ( len < lmin ) {
+                lmin = len;
+                imin = ii;
+            }
+        }
+        if ( imax==-1 )
+            fprintf(stdout,"%s:%d: Warning: all edges of tetra %" MMG5_PRId " are boundary and required\n",
+                    __FILE__,__LINE__,k);
+        if ( imin==-1 )
+            fprintf(stdout,"%s:%d: Warning: all edges of tetra %" MMG5_PRId " are boundary and required\n",
+                    __FILE__,__LINE__,k);
+        else if ( lmax < _MMG5_LOPTL_MMG5_DEL && lmin > _MMG5_LOPTS_MMG5_DEL ) {
+            /* nothing to do: skipped until modified */
+            if ( stamp )  _MMG5_setStamp(&stamp[k],pt);
+            continue;
+        }
+
+        if ( lmax >= _MMG5_LOPTL_MMG5_DEL )  {
+            /* proceed edges according to lengths */
+            ier = _MMG5_splitEdg_delone(mesh,met,bucket,scr,k,imax,ifilt,warn,NULL);
+            if ( ier < 1 )  return(ier);
+            else if ( ier == 1 ) {
+                (*ns)++;
+                continue;
+            }
+            else if ( ier == 3 )  continue;
+        }
+        if(lmin <= _MMG5_LOPTS_MMG5_DEL) {
+            ier = _MMG5_colEdg_delone(mesh,met,bucket,scr,k,imin,NULL);
+            if ( ier < 0 )  return(-1);
+            else if ( ier == 1 ) {
+                (*nc)++;
+                continue;
+            }
+            else if ( ier == 3 )  continue;
+        } //end if lmin < _MMG5_LOPTS_MMG5_DEL
+
+        /*2) longest and shortest edges are stucked => try another edges*/
+        pt  = &mesh->tetra[k];
+        pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+        imaxtet = imax;
+        imintet = imin;
+        lmaxtet = lmax;
+        lmintet = lmin;
+        for (ii=0; ii<6; ii++) {
+            if ( pt->xt && (pxt->tag[ii] & MG_REQ) )  continue;
+            if ( (ii==imintet) && (lmintet < _MMG5_LOPTS_MMG5_DEL)) continue;
+            if ( (ii==imaxtet) && (lmaxtet > _MMG5_LOPTL_MMG5_DEL) ) continue;
+
+            ip1  = _MMG5_iare[ii][0];
+            ip2  = _MMG5_iare[ii][1];
+            len = _MMG5_TLENEDG(mesh,met,pt->v[ip1],pt->v[ip2]);
+
+            if ( len >= _MMG5_LOPTL_MMG5_DEL )  {
+                /* proceed edges according to lengths */
+                ier = _MMG5_splitEdg_delone(mesh,met,bucket,scr,k,ii,ifilt,warn,NULL);
+                pt  = &mesh->tetra[k];
+                pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+                if ( ier < 1 )  return(ier);
+                else if ( ier == 1 ) {
+                    (*ns)++;
+                    break;
+                }
+                else if ( ier == 3 )  continue;
+            }
+            if(len > _MMG5_LOPTS_MMG5_DEL) continue;
+            ier = _MMG5_colEdg_delone(mesh,met,bucket,scr,k,ii,NULL);
+            if ( ier < 0 )  return(-1);
+            else if ( ier == 1 ) {
+                (*nc)++;
+                break;
+            }
+        }//end for ii
+    }
+    if ( *ns + *nc != nop )  (*nmod)++;
+
+    return(1);
+}
@@ -48,14 +48,15 @@
  * Split edges of length bigger than _MMG5_LOPTL.
  *
  */
-static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
+static MMG5_int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
     MMG5_pTetra     pt;
     MMG5_pxTetra    pxt;
     MMG5_Tria       ptt;
     MMG5_pPoint     p0,p1,ppt;
     MMG5_pxPoint    pxp;
     double     dd,len,lmax,o[3],to[3],ro[3],no1[3],no2[3],v[3];
-    int        k,ip,ip1,ip2,list[_MMG5_LMAX+2],ilist,ns,ref,ier;
+    MMG5_int   k,ip,ip1,ip2,list[_MMG5_LMAX+2],ns;
+    int        ilist,ref,ier;
     char       imax,tag,j,i,i1,i2,ifa0,ifa1;
 
     *warn=0;
@@ -78,7 +79,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
             }
         }
         if ( imax==-1 )
-            fprintf(stdout,"%s:%d: Warning: all edges of tetra %d are required or of length null.\n",
+            fprintf(stdout,"%s:%d: Warning: all edges of tetra %" MMG5_PRId " are required or of length null.\n",
                     __FILE__,__LINE__,k);
         if ( lmax < _MMG5_LOPTL )  continue;
 
@@ -145,9 +146,9 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
                 if ( !_MMG5_BezierReg(mesh,ip1,ip2,0.5,v,o,no1) )
                     continue;
             }
-            ier = _MMG5_simbulgept(mesh,list,ilist,o);
+            ier = _MMG5_simbulgept(mesh,met,list,ilist,o);
             if ( !ier ) {
-                ier = _MMG5_dichoto1b(mesh,list,ilist,o,ro);
+                ier = _MMG5_dichoto1b(mesh,met,list,ilist,o,ro);
                 memcpy(o,ro,3*sizeof(double));
             }
             ip = _MMG5_newPt(mesh,o,tag);
@@ -160,7 +161,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
             }
             //CECILE
             if ( met->m )
-                met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+                _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
             //CECILE
             ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
             /* if we realloc memory in _MMG5_split1b pt and pxt pointers are not valid */
@@ -182,7 +183,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
             else
                 ppt->ref = pxt->ref[i];
             if ( met->m )
-                met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+                _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
             pxp = &mesh->xpoint[ppt->xp];
             if ( tag & MG_NOM ){
@@ -223,7 +224,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
             }
             //CECILE
             if ( met->m )
-                met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+                _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
             //CECILE
             ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
             if ( ier < 0 ) {
@@ -235,7 +236,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
             }
             else {
                 ppt = &mesh->point[ip];
-                met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
+                _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
                 ns++;
             }
         }
@@ -254,14 +255,15 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
  * Collapse edges of length smaller than _MMG5_LOPTS.
  *
  */
-static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
+static MMG5_int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pTetra     pt;
     MMG5_pxTetra    pxt;
     MMG5_pPoint     p0,p1;
     double     len,lmin;
-    int        k,ip,iq,list[_MMG5_LMAX+2],ilist,nc;
+    MMG5_int   k,ip,iq,list[_MMG5_LMAX+2],nc;
+    int        ilist;
     char       imin,tag,j,i,i1,i2,ifa0,ifa1;
-    int        ier;
+    MMG5_int   ier;
 
     nc = 0;
     for (k=1; k<=mesh->ne; k++) {
@@ -283,7 +285,7 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
             }
         }
         if ( imin==-1 )
-            fprintf(stdout,"%s:%d: Warning: all edges of tetra %d are boundary and required\n",
+            fprintf(stdout,"%s:%d: Warning: all edges of tetra %" MMG5_PRId " are boundary and required\n",
                     __FILE__,__LINE__,k);
         if ( lmin > _MMG5_LOPTS )  continue;
 
@@ -308,7 +310,7 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
             tag |= MG_BDY;
             if ( p0->tag > tag )   continue;
             if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-            ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
+            ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
         }
         /* Case of an internal face */
         else {
@@ -316,7 +318,7 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
             ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
         }
         if ( ilist > 0 ) {
-            ier = _MMG5_colver(mesh,list,ilist,i2);
+            ier = _MMG5_colver(mesh,met,list,ilist,i2);
             if ( ier < 0 )  return(-1);
             else if ( ier ) {
                 _MMG5_delPt(mesh,ier);
@@ -339,12 +341,14 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
  *
  */
 static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
-    int      it,nnc,nns,nnf,nnm,maxit,nc,ns,nf,nm;
+    MMG5_int nnc,nns,nnf,nnm,nc,ns,nf,nm;
+    int      it,maxit;
     int      warn;
     double   maxgap;
 
     /* Iterative mesh modifications */
-    it = nnc = nns = nnf = nnm = warn = 0;
+    it = warn = 0;
+    nnc = nns = nnf = nnm = 0;
     maxit = 10;
     mesh->gap = maxgap = 0.5;
     do {
@@ -411,9 +415,9 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
             mesh->gap -= mesh->gap/(double)maxit;
 
         if ( (abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && ns+nc > 0 )
-            fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped, %8d moved\n",ns,nc,nf,nm);
-        if ( ns < 10 && abs(nc-ns) < 3 )  break;
-        else if ( it > 3 && abs(nc-ns) < 0.3 * MG_MAX(nc,ns) )  break;
+            fprintf(stdout,"     %8" MMG5_PRId " splitted, %8" MMG5_PRId " collapsed, %8" MMG5_PRId " swapped, %8" MMG5_PRId " moved\n",ns,nc,nf,nm);
+        if ( ns < 10 && MG_ABS(nc-ns) < 3 )  break;
+        else if ( it > 3 && MG_ABS(nc-ns) < 0.3 * MG_MAX(nc,ns) )  break;
     }
     while( ++it < maxit && nc+ns > 0 );
 
@@ -469,7 +473,7 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
 
         if ( (abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && nf+nm > 0 ){
             fprintf(stdout,"                                            ");
-            fprintf(stdout,"%8d swapped, %8d moved\n",nf,nm);
+            fprintf(stdout,"%8" MMG5_PRId " swapped, %8" MMG5_PRId " moved\n",nf,nm);
         }
     }
     while( ++it < maxit && nm+nf > 0 );
@@ -486,12 +490,12 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
 
     if ( (abs(mesh->info.imprim) > 3 || mesh->info.ddebug) && nm > 0 ){
         fprintf(stdout,"                                            ");
-        fprintf(stdout,"                  %8d moved\n",nm);
+        fprintf(stdout,"                  %8" MMG5_PRId " moved\n",nm);
     }
 
 
     if ( abs(mesh->info.imprim) < 4 && (nnc > 0 || nns > 0) )
-        fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped, %8d moved, %d iter. \n",
+        fprintf(stdout,"     %8" MMG5_PRId " splitted, %8" MMG5_PRId " collapsed, %8" MMG5_PRId " swapped, %8" MMG5_PRId " moved, %d iter. \n",
                 nns,nnc,nnf,nnm,it);
 
     return(1);
@@ -519,6 +523,9 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( abs(mesh->info.imprim) > 3 || mesh->info.ddebug )
         fprintf(stdout,"  ** GEOMETRIC MESH\n");
 
+    /* qualities in the anisotropic metric */
+    _MMG5_tetqua(mesh,met);
+
     if ( !_MMG5_anatet(mesh,met,1,1) ) {
         fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
         return(0);
@@ -542,6 +549,7 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
         fprintf(stdout,"  ## Gradation problem. Exit program.\n");
         return(0);
     }
+    _MMG5_tetqua(mesh,met);
 
     if ( !_MMG5_anatet(mesh,met,2,1) ) {
         fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
@@ -552,6 +560,9 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( !_MMG5_scotchCall(mesh,met) )
         return(0);
 
+    /* preallocation of the tables at the predicted final size */
+    _MMG5_presize(mesh,met);
+
 #ifdef DEBUG
     puts("---------------------------Fin anatet---------------------");
     _MMG5_outqua(mesh,met);
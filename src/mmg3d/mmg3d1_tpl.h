@@ -0,0 +1,220 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/mmg3d1_tpl.h
+ * \brief Swap and relocation sweeps of mmg3d1.c, instantiated for each metric
+ * type.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by mmg3d1.c after the definition of
+ * \a _MMG5_TMET (see metric_kernels.h).
+ *
+ */
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param crit coefficient of quality improvment.
+ * \param bucket pointer toward the bucket structure in delaunay mode and
+ * toward the \a NULL pointer otherwise
+ *
+ * Internal edge flipping.
+ *
+ */
+static MMG5_int
+_MMG5_TNAME(_MMG5_swptet)(MMG5_pMesh mesh,MMG5_pSol met,double crit,
+                           _MMG5_pBucket bucket) {
+    MMG5_pTetra   pt;
+    MMG5_pxTetra  pxt;
+    MMG5_int list[_MMG5_LMAX+2],k,nconf,ns,nns;
+    int      ilist,it,maxit,ier;
+    char     i;
+
+    maxit = 2;
+    it  = 0;
+    nns = 0;
+
+    do {
+        ns = 0;
+        for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+            if ( pt->qual > 0.0288675 /*0.6/_MMG5_ALPHAD*/ )  continue;
+
+            for (i=0; i<6; i++) {
+                /* Prevent swap of a ref or tagged edge */
+                if ( pt->xt ) {
+                    pxt = &mesh->xtetra[pt->xt];
+                    if ( pxt->edg[i] || pxt->tag[i] ) continue;
+                }
+
+                nconf = _MMG5_TNAME(_MMG5_chkswpgen)(mesh,met,k,i,&ilist,list,crit);
+                if ( nconf ) {
+                    ier = _MMG5_swpgen(mesh,met,nconf,ilist,list,bucket);
+                    if ( ier > 0 )  ns++;
+                    else if ( ier < 0 ) return(-1);
+                    break;
+                }
+            }
+        }
+        nns += ns;
+    }
+    while ( ++it < maxit && ns > 0 );
+    if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nns > 0 )
+        fprintf(stdout,"     %8" MMG5_PRId " edge swapped\n",nns);
+
+    return(nns);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param maxitin maximum number of iteration.
+ * \return -1 if failed, number of moved points otherwise.
+ *
+ * Analyze tetrahedra and move points so as to make mesh more uniform.
+ * In delaunay mode, a negative maxitin means that we don't move internal nodes.
+ *
+ */
+static MMG5_int
+_MMG5_TNAME(_MMG5_movtet)(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
+    MMG5_pTetra        pt;
+    MMG5_pPoint        ppt;
+    MMG5_pxTetra       pxt;
+    double        *n;
+    MMG5_int      k,nm,nnm,ns,lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2];
+    int           i,ier,ilists,ilistv,it;
+    int           improve;
+    unsigned char j,i0,base;
+    int           internal,maxit;
+
+    if ( maxitin<0 ) {
+        internal = 0;
+        maxit = abs(maxitin);
+    } else {
+        internal=1;
+        maxit = maxitin;
+    }
+
+    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+        fprintf(stdout,"  ** OPTIMIZING MESH\n");
+
+    base = 1;
+    for (k=1; k<=mesh->np; k++)
+        mesh->point[k].flag = base;
+
+    it  = 0;
+    nnm = 0;
+    do {
+        base++;
+        nm = ns = 0;
+        for (k=mesh->nefrz+1; k<=mesh->ne; k++) {
+            pt = &mesh->tetra[k];
+            if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
+
+            /* point j on face i */
+            for (i=0; i<4; i++) {
+                for (j=0; j<3; j++) {
+                    if ( pt->xt ) {
+                        pxt = &mesh->xtetra[pt->xt];
+                        if ( pxt->tag[_MMG5_iarf[i][j]] & MG_REQ )  continue;
+                    }
+                    else  pxt = 0;
+                    i0  = _MMG5_idir[i][j];
+                    ppt = &mesh->point[pt->v[i0]];
+                    if ( ppt->flag == base )  continue;
+                    else if ( MG_SIN(ppt->tag) )  continue;
+
+                    if ( maxit != 1 ) {
+                        ppt->flag = base;
+                        improve   = 1;
+                    }
+                    else {
+                        improve = 0;
+                    }
+                    ier = 0;
+                    if ( ppt->tag & MG_BDY ) {
+                        /* Catch a boundary point by a boundary face */
+                        if ( !pt->xt || !(MG_BDY & pxt->ftag[i]) )  continue;
+                        else if( ppt->tag & MG_NOM ){
+                            if( mesh->adja[4*(k-1)+1+i] ) continue;
+                            if( !(ier=_MMG5_bouleext(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )  continue;
+                            else if ( ier>0 )
+                                ier = _MMG5_movbdynompt(mesh,met,listv,ilistv,lists,ilists);
+                            else
+                                return(-1);
+                        }
+                        else if ( ppt->tag & MG_GEO ) {
+                            if ( !(ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )
+                                continue;
+                            else if ( ier>0 )
+                                ier = _MMG5_movbdyridpt(mesh,met,listv,ilistv,lists,ilists);
+                            else
+                                return(-1);
+                        }
+                        else if ( ppt->tag & MG_REF ) {
+                            if ( !(ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )
+                                continue;
+                            else if ( ier>0 )
+                                ier = _MMG5_movbdyrefpt(mesh,met,listv,ilistv,lists,ilists);
+                            else
+                                return(-1);
+                        }
+                        else {
+                            if ( !(ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists)) )
+                                continue;
+                            else if ( ier<0 )
+                                return(-1);
+
+                            n = &(mesh->xpoint[ppt->xp].n1[0]);
+                            if ( !_MMG5_directsurfball(mesh, pt->v[i0],lists,ilists,n) )  continue;
+                            ier = _MMG5_movbdyregpt(mesh,met,listv,ilistv,lists,ilists);
+                            if ( ier )  ns++;
+                        }
+                    }
+                    else if ( internal ) {
+                        ilistv = _MMG5_boulevolp(mesh,k,i0,listv);
+                        if ( !ilistv )  continue;
+                        ier = _MMG5_TNAME(_MMG5_movintpt)(mesh,met,listv,ilistv,improve);
+                    }
+                    if ( ier ) {
+                        nm++;
+                        if(maxit==1){
+                            ppt->flag = base;
+                        }
+                    }
+                }
+            }
+        }
+        nnm += nm;
+        if ( mesh->info.ddebug )  fprintf(stdout,"     %8" MMG5_PRId " moved, %" MMG5_PRId " geometry\n",nm,ns);
+    }
+    while( ++it < maxit && nm > 0 );
+
+    if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nnm )
+        fprintf(stdout,"     %8" MMG5_PRId " vertices moved, %d iter.\n",nnm,it);
+
+    return(nnm);
+}
@@ -35,8 +35,6 @@
 
 #include "mmg3d.h"
 
-extern char  ddb;
-
 /**
  * \remark Not used.
  *
@@ -74,19 +72,21 @@ _MMG5_invsl(double A[3][3],double b[3],double r[3]) {
 
 /** Check ball of point np, return 0 if a nonmanifold situation is created */
 static int
-_MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
+_MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_int k,int indp) {
     MMG5_pTetra   pt,pt1;
     double   v,v0,v1,v2;
-    int      *adja,list[_MMG5_LMAX+1],bdy[_MMG5_LMAX+1],ibdy,np,ilist,base,cur,iel,jel,res,l;
+    MMG5_int *adja,list[_MMG5_LMAX+1],bdy[_MMG5_LMAX+1],np,iel,jel;
+    MMG5_int  res;
+    int       ibdy,ilist,base,cur,l;
     char     i,i0,i1,i2,j0,j1,j2,j,ip,nzeros,nopp,nsame;
 
     pt = &mesh->tetra[k];
     np = pt->v[indp];
     if ( fabs(sol->m[np]) > _MMG5_EPSD2 )  return(1);
 
-    memset(bdy,0,(_MMG5_LMAX+1)*sizeof(int));
+    memset(bdy,0,(_MMG5_LMAX+1)*sizeof(MMG5_int));
 
-    memset(list,0,(_MMG5_LMAX+1)*sizeof(int));
+    memset(list,0,(_MMG5_LMAX+1)*sizeof(MMG5_int));
 
     /* Sign of a starting point in ball of np */
     for (j=0; j<3; j++) {
@@ -94,7 +94,7 @@ _MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
         if ( sol->m[pt->v[ip]] != 0.0 )  break;
     }
     if ( j == 3) {
-        fprintf(stdout,"  *** Problem in function _MMG5_ismaniball : tetra %d : 4 null values",k);
+        fprintf(stdout,"  *** Problem in function _MMG5_ismaniball : tetra %" MMG5_PRId " : 4 null values",k);
         exit(EXIT_FAILURE);
     }
 
@@ -208,7 +208,7 @@ _MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
     base = ++mesh->base;
     pt->flag = base;
 
-    memset(list,0,(_MMG5_LMAX+1)*sizeof(int));
+    memset(list,0,(_MMG5_LMAX+1)*sizeof(MMG5_int));
     ilist = cur = 0;
     list[ilist] = res;
     ilist++;
@@ -301,7 +301,7 @@ _MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
 static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
     MMG5_pTetra   pt;
     MMG5_pPoint   p0;
-    int      k,nc,ns,ip;
+    MMG5_int k,nc,ns,ip;
     char     i;
 
     /* create tetra adjacency */
@@ -320,7 +320,7 @@ static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
         p0 = &mesh->point[k];
         if ( !MG_VOK(p0) ) continue;
         if ( fabs(sol->m[k]) < _MMG5_EPS ) {
-            if ( mesh->info.ddebug )  fprintf(stdout,"  Snapping value %d ; previous value : %E\n",k,fabs(sol->m[k]));
+            if ( mesh->info.ddebug )  fprintf(stdout,"  Snapping value %" MMG5_PRId " ; previous value : %E\n",k,fabs(sol->m[k]));
             tmp[k] = ( fabs(sol->m[k]) < _MMG5_EPSD ) ? (-100.0*_MMG5_EPS) : sol->m[k];
             p0->flag = 1;
             sol->m[k] = 0.0;
@@ -346,21 +346,21 @@ static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
         }
     }
     if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && ns+nc > 0 )
-        fprintf(stdout,"     %8d points snapped, %d corrected\n",ns,nc);
+        fprintf(stdout,"     %8" MMG5_PRId " points snapped, %" MMG5_PRId " corrected\n",ns,nc);
 
     /* memory free */
-    _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+    _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(MMG5_int));
     return(1);
 }
 
 /** Proceed to discretization of the implicit function carried by sol into mesh, once values
     of sol have been snapped/checked */
-static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
+static MMG5_int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
     MMG5_pTetra   pt;
     MMG5_pPoint   p0,p1;
     _MMG5_Hash     hash;
     double   c[3],v0,v1,s;
-    int      vx[6],nb,k,ip0,ip1,np,ns,ne;
+    MMG5_int vx[6],nb,k,ip0,ip1,np,ns,ne;
     char     ia;
     /* Commented because unused */
     /*MMG5_pPoint  p[4];*/
@@ -515,30 +515,30 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
         pt = &mesh->tetra[k];
         if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
         pt->flag = 0;
-        memset(vx,0,6*sizeof(int));
+        memset(vx,0,6*sizeof(MMG5_int));
         for (ia=0; ia<6; ia++) {
             vx[ia] = _MMG5_hashGet(&hash,pt->v[_MMG5_iare[ia][0]],pt->v[_MMG5_iare[ia][1]]);
             if ( vx[ia] )  MG_SET(pt->flag,ia);
         }
         switch (pt->flag) {
         case 1: case 2: case 4: case 8: case 16: case 32: /* 1 edge split */
-            _MMG5_split1(mesh,sol,k,vx);
+            _MMG5_split1(mesh,sol,k,vx,NULL);
             ns++;
             break;
 
         case 48: case 24: case 40: case 6: case 34: case 36:
         case 20: case 5: case 17: case 9: case 3: case 10: /* 2 edges (same face) split */
-            _MMG5_split2sf(mesh,sol,k,vx);
+            _MMG5_split2sf(mesh,sol,k,vx,NULL);
             ns++;
             break;
 
         case 7: case 25: case 42: case 52: /* 3 edges on conic configuration splitted */
-            _MMG5_split3cone(mesh,sol,k,vx);
+            _MMG5_split3cone(mesh,sol,k,vx,NULL);
             ns++;
             break;
 
         case 30: case 45: case 51:
-            _MMG5_split4op(mesh,sol,k,vx);
+            _MMG5_split4op(mesh,sol,k,vx,NULL);
             ns++;
             break;
 
@@ -548,7 +548,7 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
         }
     }
     if ( (mesh->info.ddebug || abs(mesh->info.imprim) > 5) && ns > 0 )
-        fprintf(stdout,"     %7d splitted\n",ns);
+        fprintf(stdout,"     %7" MMG5_PRId " splitted\n",ns);
 
     _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
     return(ns);
@@ -558,7 +558,7 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
 /** Set references to tets according to the sign of the level set function */
 static int _MMG5_setref_ls(MMG5_pMesh mesh, MMG5_pSol sol) {
     MMG5_pTetra   pt;
-    int      k,ip;
+    MMG5_int k,ip;
     char     nmns,npls,nz,i;
 
     for (k=1; k<=mesh->ne; k++) {
@@ -588,10 +588,11 @@ static int _MMG5_setref_ls(MMG5_pMesh mesh, MMG5_pSol sol) {
 
 /** Check whether implicit surface is orientable in ball of point ip in tet iel ;
     Beware : may return 0 when implicit boundary is tangent to outer boundary */
-int _MMG5_chkmaniball(MMG5_pMesh mesh, int start, char ip){
+int _MMG5_chkmaniball(MMG5_pMesh mesh, MMG5_int start, char ip){
     MMG5_pTetra    pt,pt1;
-    int       ref,base,ilist,nump,k,cur,k1,nref;
-    int       *adja,list[_MMG5_LMAX+2];
+    MMG5_int  nump,k,k1;
+    int       ref,base,ilist,cur,nref;
+    MMG5_int  *adja,list[_MMG5_LMAX+2];
     char      i,l,j;
 
     base = ++mesh->base;
@@ -681,7 +682,7 @@ int _MMG5_chkmaniball(MMG5_pMesh mesh, int start, char ip){
         pt = &mesh->tetra[k];
         if( pt->ref == ref ) {
             fprintf(stdout,"   *** Topological problem:");
-            fprintf(stdout," non manifold surface at point %d \n",nump);
+            fprintf(stdout," non manifold surface at point %" MMG5_PRId " \n",nump);
             return(0);
         }
     }
@@ -692,8 +693,9 @@ int _MMG5_chkmaniball(MMG5_pMesh mesh, int start, char ip){
 /** Check whether implicit surface enclosed in volume is orientable */
 int _MMG5_chkmani(MMG5_pMesh mesh){
     MMG5_pTetra    pt,pt1;
-    int       k,iel,ref;
-    int       *adja;
+    MMG5_int  k,iel;
+    int       ref;
+    MMG5_int  *adja;
     char      i,j,ip,cnt;
 
     for(k=1; k<=mesh->np; k++){
@@ -718,7 +720,7 @@ int _MMG5_chkmani(MMG5_pMesh mesh){
             }
         }
         if ( cnt == 4 ) {
-            fprintf(stdout,"Tetra %d : 4 boundary faces \n",k);
+            fprintf(stdout,"Tetra %" MMG5_PRId " : 4 boundary faces \n",k);
             //return(0);
         }
     }
@@ -752,8 +754,8 @@ int _MMG5_chkmani(MMG5_pMesh mesh){
     test w.r.t. _MMG5_chkmani) */
 int _MMG5_chkmani2(MMG5_pMesh mesh,MMG5_pSol sol) {
     MMG5_pTetra    pt,pt1;
-    int       k,iel;
-    int       *adja;
+    MMG5_int  k,iel;
+    MMG5_int  *adja;
     char      i,j,ip,cnt;
 
     for(k=1; k<=mesh->np; k++){
@@ -770,7 +772,7 @@ int _MMG5_chkmani2(MMG5_pMesh mesh,MMG5_pSol sol) {
             if( sol->m[pt->v[j]] == 0.0 ) cnt++;
         }
         if(cnt == 4) {
-            fprintf(stdout,"Problem in tetra %d : 4 vertices on implicit boundary",k);
+            fprintf(stdout,"Problem in tetra %" MMG5_PRId " : 4 vertices on implicit boundary",k);
             exit(EXIT_FAILURE);
         }
     }
@@ -791,7 +793,7 @@ int _MMG5_chkmani2(MMG5_pMesh mesh,MMG5_pSol sol) {
                 ip = _MMG5_idir[i][j];
 
                 if(!_MMG5_chkmaniball(mesh,k,ip)){
-                    fprintf(stdout,"Non orientable implicit surface : ball of point %d\n",pt->v[ip]);
+                    fprintf(stdout,"Non orientable implicit surface : ball of point %" MMG5_PRId "\n",pt->v[ip]);
                     exit(EXIT_FAILURE);
                 }
             }
@@ -803,10 +805,11 @@ int _MMG5_chkmani2(MMG5_pMesh mesh,MMG5_pSol sol) {
 
 /** Check whether collapse of point np to nq does not create a non manifold situation at nq
     ndepmin, ndepplus = tetra of ref minus, plus in ball of np, not in shell of (np,nq). */
-int _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int ndepplus,char isminp,char isplp) {
+int _MMG5_chkmanicoll(MMG5_pMesh mesh,MMG5_int k,int iface,int iedg,MMG5_int ndepmin,MMG5_int ndepplus,char isminp,char isplp) {
     MMG5_pTetra    pt,pt1;
-    int       nump,numq,ilist,ref,cur,stor,iel,jel,base,ndepmq,ndeppq;
-    int       list[_MMG5_LMAX+2],*adja,*adja1;
+    MMG5_int  nump,numq,stor,iel,jel,ndepmq,ndeppq;
+    int       ilist,ref,cur,base;
+    MMG5_int  list[_MMG5_LMAX+2],*adja,*adja1;
     char      i,j,ip,jp,iq,jq,voy,indp,indq,isminq,isplq,ismin,ispl;
 
     ilist = 0;
@@ -879,7 +882,7 @@ int _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int n
             cur++;
         }
 
-        memset(list,0,(_MMG5_LMAX+2)*sizeof(int));
+        memset(list,0,(_MMG5_LMAX+2)*sizeof(MMG5_int));
         ilist = 0;
     }
 
@@ -1255,7 +1258,7 @@ int _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int n
                 /* Only tets of the shell of (np,nq) can be added, unless future ball is non manifold */
                 if ( indq == -1 ) {
                     fprintf(stdout,"On devrait passer ici TRES rarement : ");
-                    fprintf(stdout,"tetra numero %d =  %d %d %d %d , sa ref = %d\n",
+                    fprintf(stdout,"tetra numero %" MMG5_PRId " =  %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " , sa ref = %d\n",
                             jel,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3],pt1->ref);
                     return(0);
                 }
@@ -1295,7 +1298,7 @@ int _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int n
                 /* Only tets of the shell of (np,nq) can be added, unless future ball is non manifold */
                 if ( indp == -1 ) {
                     fprintf(stdout,"On devrait passer ici TRES rarement : ");
-                    fprintf(stdout,"tetra numero %d =  %d %d %d %d , sa ref = %d\n",
+                    fprintf(stdout,"tetra numero %" MMG5_PRId " =  %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " , sa ref = %d\n",
                             jel,pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3],pt1->ref);
                     return(0);
                 }
@@ -1362,7 +1365,7 @@ int _MMG5_mmg3d2(MMG5_pMesh mesh,MMG5_pSol sol) {
         return(0);
     }
 
-    _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+    _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(MMG5_int));
     _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
     mesh->nt = 0;
 
@@ -34,75 +34,18 @@
  */
 
 #include "mmg3d.h"
+#include "metric_kernels.h"
 
+#define _MMG5_TMET iso
+#include "movpt_tpl.h"
+#undef  _MMG5_TMET
 
-/** Move internal point */
-int _MMG5_movintpt(MMG5_pMesh mesh,int *list,int ilist,int improve) {
-    MMG5_pTetra               pt,pt0;
-    MMG5_pPoint               p0,p1,p2,p3,ppt0;
-    double               vol,totvol;
-    double               calold,calnew,callist[ilist];
-    int                  k,iel,i0;
-
-    pt0    = &mesh->tetra[0];
-    ppt0 = &mesh->point[0];
-    ppt0->c[0] = ppt0->c[1] = ppt0->c[2] = 0.0;
-
-    /* Coordinates of optimal point */
-    calold = DBL_MAX;
-    totvol = 0.0;
-    for (k=0; k<ilist; k++) {
-        iel = list[k] / 4;
-        pt = &mesh->tetra[iel];
-        p0 = &mesh->point[pt->v[0]];
-        p1 = &mesh->point[pt->v[1]];
-        p2 = &mesh->point[pt->v[2]];
-        p3 = &mesh->point[pt->v[3]];
-        vol= _MMG5_det4pt(p0->c,p1->c,p2->c,p3->c);
-        totvol += vol;
-        /* barycenter */
-        ppt0->c[0] += 0.25 * vol*(p0->c[0] + p1->c[0] + p2->c[0] + p3->c[0]);
-        ppt0->c[1] += 0.25 * vol*(p0->c[1] + p1->c[1] + p2->c[1] + p3->c[1]);
-        ppt0->c[2] += 0.25 * vol*(p0->c[2] + p1->c[2] + p2->c[2] + p3->c[2]);
-        calold = MG_MIN(calold, pt->qual);
-    }
-    if ( totvol < _MMG5_EPSD2 )  return(0);
-    totvol = 1.0 / totvol;
-    ppt0->c[0] *= totvol;
-    ppt0->c[1] *= totvol;
-    ppt0->c[2] *= totvol;
-
-    /* Check new position validity */
-    calnew = DBL_MAX;
-    for (k=0; k<ilist; k++) {
-        iel = list[k] / 4;
-        i0  = list[k] % 4;
-        pt  = &mesh->tetra[iel];
-        memcpy(pt0,pt,sizeof(MMG5_Tetra));
-        pt0->v[i0] = 0;
-        callist[k] = _MMG5_orcal(mesh,0);
-        if ( callist[k] < _MMG5_EPSD2 )        return(0);
-        calnew = MG_MIN(calnew,callist[k]);
-    }
-    if ( calold < _MMG5_NULKAL && calnew <= calold )    return(0);
-    else if (calnew < _MMG5_NULKAL) return(0);
-    else if ( improve && calnew < 0.9 * calold )     return(0);
-    else if ( calnew < 0.3 * calold )     return(0);
-
-    /* update position */
-    p0 = &mesh->point[pt->v[i0]];
-    p0->c[0] = ppt0->c[0];
-    p0->c[1] = ppt0->c[1];
-    p0->c[2] = ppt0->c[2];
-    for (k=0; k<ilist; k++) {
-        (&mesh->tetra[list[k]/4])->qual=callist[k];
-    }
-
-    return(1);
-}
+#define _MMG5_TMET ani
+#include "movpt_tpl.h"
+#undef  _MMG5_TMET
 
 /** Move boundary regular point, whose volumic and surfacic balls are passed */
-int _MMG5_movbdyregpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilists) {
+int _MMG5_movbdyregpt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv,int ilistv,MMG5_int *lists,int ilists) {
     MMG5_pTetra                pt,pt0;
     MMG5_pxTetra               pxt;
     MMG5_pPoint                p0,p1,p2,ppt0;
@@ -112,7 +55,9 @@ int _MMG5_movbdyregpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilist
     double                *n,r[3][3],lispoi[3*_MMG5_LMAX+1],ux,uy,uz,det2d,detloc,oppt[2],step,lambda[3];
     double                ll,m[2],uv[2],o[3],no[3],to[3];
     double                calold,calnew,caltmp,callist[ilistv];
-    int                   k,kel,iel,l,n0,na,nb,ntempa,ntempb,ntempc,nut,nxp;
+    MMG5_int              k,iel,n0,na,nb,ntempa,ntempb,ntempc,nxp;
+    MMG5_int              kel;
+    int                   l,nut;
     unsigned char         i0,iface,i;
 
     step = 0.1;
@@ -431,7 +376,7 @@ int _MMG5_movbdyregpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilist
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[i0] = 0;
         calold = MG_MIN(calold, pt->qual);
-        callist[l]=_MMG5_orcal(mesh,0);
+        callist[l]=_MMG5_orcal(mesh,met,0);
         if ( callist[l] < _MMG5_EPSD )        return(0);
         calnew = MG_MIN(calnew,callist[l]);
     }
@@ -455,7 +400,7 @@ int _MMG5_movbdyregpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilist
 }
 
 /** Move boundary reference point, whose volumic and surfacic balls are passed */
-int _MMG5_movbdyrefpt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int ilists){
+int _MMG5_movbdyrefpt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv, int ilistv, MMG5_int *lists, int ilists){
     MMG5_pTetra                pt,pt0;
     MMG5_pxTetra               pxt;
     MMG5_pPoint                p0,p1,p2,ppt0;
@@ -463,7 +408,8 @@ int _MMG5_movbdyrefpt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int i
     MMG5_pxPoint               pxp;
     double                step,ll1old,ll2old,o[3],no[3],to[3];
     double                calold,calnew,caltmp,callist[ilistv];
-    int                   l,iel,ip0,ipa,ipb,iptmpa,iptmpb,it1,it2,ip1,ip2,ip,nxp;
+    MMG5_int              iel,ip0,ipa,ipb,iptmpa,iptmpb,it1,it2,ip1,ip2,ip,nxp;
+    int                   l;
     unsigned char         i,i0,ie,iface,iface1,iface2,iea,ieb,ie1,ie2;
     char                  tag;
 
@@ -707,7 +653,7 @@ int _MMG5_movbdyrefpt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int i
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[i0] = 0;
         calold = MG_MIN(calold, pt->qual);
-        callist[l] = _MMG5_orcal(mesh,0);
+        callist[l] = _MMG5_orcal(mesh,met,0);
         if ( callist[l] < _MMG5_EPSD )        return(0);
         calnew = MG_MIN(calnew,callist[l]);
     }
@@ -737,7 +683,7 @@ int _MMG5_movbdyrefpt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int i
 
 
 /** Move boundary non manifold point, whose volumic and (exterior) surfacic balls are passed */
-int _MMG5_movbdynompt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int ilists){
+int _MMG5_movbdynompt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv, int ilistv, MMG5_int *lists, int ilists){
     MMG5_pTetra       pt,pt0;
     MMG5_pxTetra      pxt;
     MMG5_pPoint       p0,p1,p2,ppt0;
@@ -745,7 +691,8 @@ int _MMG5_movbdynompt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int i
     MMG5_Tria         tt;
     double       step,ll1old,ll2old,calold,calnew,caltmp,callist[ilistv];
     double       o[3],no[3],to[3];
-    int          ip0,ip1,ip2,ip,iel,ipa,ipb,l,iptmpa,iptmpb,it1,it2,nxp;
+    MMG5_int     ip0,ip1,ip2,ip,iel,ipa,ipb,iptmpa,iptmpb,it1,it2,nxp;
+    int          l;
     char         iface,i,i0,iea,ieb,ie,tag,ie1,ie2,iface1,iface2;
 
     step = 0.1;
@@ -988,7 +935,7 @@ int _MMG5_movbdynompt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int i
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[i0] = 0;
         calold = MG_MIN(calold, pt->qual);
-        callist[l]= _MMG5_orcal(mesh,0);
+        callist[l]= _MMG5_orcal(mesh,met,0);
         if ( callist[l] < _MMG5_EPSD )        return(0);
         calnew = MG_MIN(calnew,callist[l]);
     }
@@ -1017,7 +964,7 @@ int _MMG5_movbdynompt(MMG5_pMesh mesh, int *listv, int ilistv, int *lists, int i
 }
 
 /** Move boundary ridge point, whose volumic and surfacic balls are passed */
-int _MMG5_movbdyridpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilists) {
+int _MMG5_movbdyridpt(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *listv,int ilistv,MMG5_int *lists,int ilists) {
     MMG5_pTetra               pt,pt0;
     MMG5_pxTetra              pxt;
     MMG5_pPoint               p0,p1,p2,ppt0;
@@ -1025,7 +972,8 @@ int _MMG5_movbdyridpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilist
     MMG5_pxPoint              pxp;
     double               step,ll1old,ll2old,o[3],no1[3],no2[3],to[3];
     double               calold,calnew,caltmp,callist[ilistv];
-    int                  l,iel,ip0,ipa,ipb,iptmpa,iptmpb,it1,it2,ip1,ip2,ip,nxp;
+    MMG5_int             iel,ip0,ipa,ipb,iptmpa,iptmpb,it1,it2,ip1,ip2,ip,nxp;
+    int                  l;
     unsigned char        i,i0,ie,iface,iface1,iface2,iea,ieb,ie1,ie2;
     char                 tag;
 
@@ -1277,7 +1225,7 @@ int _MMG5_movbdyridpt(MMG5_pMesh mesh,int *listv,int ilistv,int *lists,int ilist
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[i0] = 0;
         calold = MG_MIN(calold, pt->qual);
-        callist[l]=_MMG5_orcal(mesh,0);
+        callist[l]=_MMG5_orcal(mesh,met,0);
         if ( callist[l] < _MMG5_EPSD )        return(0);
         calnew = MG_MIN(calnew,callist[l]);
     }
@@ -0,0 +1,133 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/movpt_tpl.h
+ * \brief Relocation of the internal points of movpt.c, instantiated for each
+ * metric type.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by movpt.c after the definition of
+ * \a _MMG5_TMET (see metric_kernels.h).
+ *
+ */
+
+/** Move internal point */
+int _MMG5_TNAME(_MMG5_movintpt)(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ilist,int improve) {
+    MMG5_pTetra               pt;
+    MMG5_pPoint               p0,p1,p2,p3,ppt0;
+    _MMG5_TetBatch            b;
+    double               vol[_MMG5_BATCH],totvol;
+    double               calold,calnew,callist[ilist];
+    MMG5_int             iel,ip;
+    int                  k,k0,i0;
+#if _MMG5_TBATCH
+    double              *c[4];
+    int                  j;
+#else
+    MMG5_int             v[4];
+#endif
+
+    /* moved vertex */
+    ip   = mesh->tetra[list[0]/4].v[list[0]%4];
+    ppt0 = &mesh->point[0];
+    ppt0->c[0] = ppt0->c[1] = ppt0->c[2] = 0.0;
+
+    /* Coordinates of optimal point */
+    calold = DBL_MAX;
+    totvol = 0.0;
+    for (k0=0; k0<ilist; k0+=_MMG5_BATCH) {
+        b.n = 0;
+        for (k=k0; k<ilist && k<k0+_MMG5_BATCH; k++) {
+            pt = &mesh->tetra[list[k]/4];
+            _MMG5_BATCH_TET(&b,mesh->point[pt->v[0]].c,mesh->point[pt->v[1]].c,
+                            mesh->point[pt->v[2]].c,mesh->point[pt->v[3]].c);
+        }
+        _MMG5_batchOrvol(&b,vol);
+
+        for (k=k0; k<ilist && k<k0+_MMG5_BATCH; k++) {
+            iel = list[k] / 4;
+            pt = &mesh->tetra[iel];
+            p0 = &mesh->point[pt->v[0]];
+            p1 = &mesh->point[pt->v[1]];
+            p2 = &mesh->point[pt->v[2]];
+            p3 = &mesh->point[pt->v[3]];
+            totvol += vol[k-k0];
+            /* barycenter */
+            ppt0->c[0] += 0.25 * vol[k-k0]*(p0->c[0] + p1->c[0] + p2->c[0] + p3->c[0]);
+            ppt0->c[1] += 0.25 * vol[k-k0]*(p0->c[1] + p1->c[1] + p2->c[1] + p3->c[1]);
+            ppt0->c[2] += 0.25 * vol[k-k0]*(p0->c[2] + p1->c[2] + p2->c[2] + p3->c[2]);
+            calold = MG_MIN(calold, pt->qual);
+        }
+    }
+    if ( totvol < _MMG5_EPSD2 )  return(0);
+    totvol = 1.0 / totvol;
+    ppt0->c[0] *= totvol;
+    ppt0->c[1] *= totvol;
+    ppt0->c[2] *= totvol;
+
+    /* Check new position validity */
+    calnew = DBL_MAX;
+    for (k0=0; k0<ilist; k0+=_MMG5_BATCH) {
+        b.n = 0;
+        for (k=k0; k<ilist && k<k0+_MMG5_BATCH; k++) {
+            iel = list[k] / 4;
+            i0  = list[k] % 4;
+            pt  = &mesh->tetra[iel];
+#if _MMG5_TBATCH
+            for (j=0; j<4; j++)
+                c[j] = j == i0 ? ppt0->c : mesh->point[pt->v[j]].c;
+            _MMG5_BATCH_TET(&b,c[0],c[1],c[2],c[3]);
+#else
+            /* the point 0 holds the new position */
+            memcpy(v,pt->v,4*sizeof(MMG5_int));
+            v[i0] = 0;
+            callist[k] = _MMG5_TCALTET(mesh,met,v[0],v[1],v[2],v[3]);
+#endif
+        }
+#if _MMG5_TBATCH
+        if ( b.n )  _MMG5_batchCaltet(&b,&callist[k0]);
+#endif
+
+        for (k=k0; k<ilist && k<k0+_MMG5_BATCH; k++) {
+            if ( callist[k] < _MMG5_EPSD2 )        return(0);
+            calnew = MG_MIN(calnew,callist[k]);
+        }
+    }
+    if ( calold < _MMG5_NULKAL && calnew <= calold )    return(0);
+    else if (calnew < _MMG5_NULKAL) return(0);
+    else if ( improve && calnew < 0.9 * calold )     return(0);
+    else if ( calnew < 0.3 * calold )     return(0);
+
+    /* update position */
+    p0 = &mesh->point[ip];
+    p0->c[0] = ppt0->c[0];
+    p0->c[1] = ppt0->c[1];
+    p0->c[2] = ppt0->c[2];
+    for (k=0; k<ilist; k++) {
+        (&mesh->tetra[list[k]/4])->qual=callist[k];
+    }
+
+    return(1);
+}
@@ -47,7 +47,7 @@ static inline
 void _MMG5_pampa_warnOrientation(MMG5_pMesh mesh) {
     if ( mesh->xt ) {
         if ( mesh->xt != mesh->ne ) {
-            fprintf(stdout,"  ## Warning: %d tetra on %d reoriented.\n",
+            fprintf(stdout,"  ## Warning: %" MMG5_PRId " tetra on %" MMG5_PRId " reoriented.\n",
                     mesh->xt,mesh->ne);
             fprintf(stdout,"  Your mesh may be non-conform.\n");
         }
@@ -59,48 +59,61 @@ void _MMG5_pampa_warnOrientation(MMG5_pMesh mesh) {
 }
 
 /**
- * \param sigid signal number.
- * \warning Copy of the \a excfun function of the \ref mmg3d/shared_func.h
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \warning Copy of the \a setfunc function of the \ref mmg3d/shared_func.h
  * file.
  *
- * Signal handling: specify error messages depending from catched signal.
+ * Set function pointers for caltet, lenedg, intmet, defsiz, gradsiz, lenedgeCoor and
+ * saveMesh.
  *
  */
-static inline
-void _MMG5_pampa_excfun(int sigid) {
-    fprintf(stdout,"\n Unexpected error:");  fflush(stdout);
-    switch(sigid) {
-    case SIGABRT:
-        fprintf(stdout,"  *** potential lack of memory.\n");  break;
-    case SIGFPE:
-        fprintf(stdout,"  Floating-point exception\n"); break;
-    case SIGILL:
-        fprintf(stdout,"  Illegal instruction\n"); break;
-    case SIGSEGV:
-        fprintf(stdout,"  Segmentation fault\n");  break;
-    case SIGTERM:
-    case SIGINT:
-        fprintf(stdout,"  Program killed\n");  break;
+void MMG5_pampa_setfunc(MMG5_pMesh mesh,MMG5_pSol met) {
+    if ( met->size < 6 ) {
+        mesh->caltet     = _MMG5_caltet_iso;
+        mesh->lenedg     = _MMG5_lenedg_iso;
+        mesh->intmet     = _MMG5_intmet_iso;
+        mesh->defsiz     = _MMG5_defsiz_iso;
+        mesh->gradsiz    = _MMG5_gradsiz_iso;
+        mesh->lenedgCoor = _MMG5_lenedgCoor_iso;
     }
-    exit(EXIT_FAILURE);
+    else {
+        mesh->caltet     = _MMG5_caltet_ani;
+        mesh->lenedg     = _MMG5_lenedg_ani;
+        mesh->intmet     = _MMG5_intmet_ani;
+        mesh->defsiz     = _MMG5_defsiz_ani;
+        mesh->gradsiz    = _MMG5_gradsiz_ani;
+        mesh->lenedgCoor = _MMG5_lenedgCoor_ani;
+    }
+    mesh->saveMesh = _MMG5_saveLibraryMesh;
 }
 
 /**
  * \param mesh pointer toward the mesh structure.
- * \param met pointer toward the sol structure.
- * \warning Copy of the \a setfunc function of the \ref mmg3d/shared_func.h
- * file.
+ * \param ca pointer toward the coordinates of the first edge's extremity.
+ * \param cb pointer toward the coordinates of the second edge's extremity.
+ * \param sa pointer toward the metric associated to the first edge's extremity.
+ * \param sb pointer toward the metric associated to the second edge's extremity.
+ * \return edge length.
  *
- * Set function pointers for lenedgeCoor, _MMG5_hashTetra and saveMesh.
+ * Compute length of edge \f$[ca,cb]\f$ with the function set by \ref
+ * MMG5_pampa_setfunc.
  *
  */
-void MMG5_pampa_setfunc(MMG5_pMesh mesh,MMG5_pSol met) {
-    if ( met->size < 6 )
-        MMG5_lenedgCoor = _MMG5_lenedgCoor_iso;
-    else
-        MMG5_lenedgCoor = _MMG5_lenedgCoor_ani;
-    MMG5_hashTetra = _MMG5_hashTetra;
-    MMG5_saveMesh = _MMG5_saveLibraryMesh;
+double MMG5_lenedgCoor(MMG5_pMesh mesh,double *ca,double *cb,double *sa,double *sb) {
+    return(mesh->lenedgCoor(ca,cb,sa,sb));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pack we pack the mesh at function begining if \f$pack=1\f$.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Create table of adjacency.
+ *
+ */
+int MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
+    return(_MMG5_hashTetra(mesh,pack));
 }
 /* END COPY */
 
@@ -123,7 +136,7 @@ void MMG5_pampa_setfunc(MMG5_pMesh mesh,MMG5_pSol met) {
  * (so we are on a boundary face).
  *
  */
-int MMG5_Get_adjaTet(MMG5_pMesh mesh, int kel, int *v0, int *v1, int *v2, int *v3) {
+int MMG5_Get_adjaTet(MMG5_pMesh mesh, MMG5_int kel, MMG5_int *v0, MMG5_int *v1, MMG5_int *v2, MMG5_int *v3) {
 
     if ( ! mesh->adja ) {
         if (! _MMG5_hashTetra(mesh, 0))
@@ -169,11 +182,16 @@ void _MMG5_usage(char *prog) {
     fprintf(stdout,"-noswap      no edge or face flipping\n");
     fprintf(stdout,"-nomove      no point relocation\n");
     fprintf(stdout,"-noinsert    no point insertion/deletion \n");
+    fprintf(stdout,"-nogrowth    tables grown by the iteration gap only\n");
 #ifndef PATTERN
     fprintf(stdout,"-bucket val  Specify the size of bucket per dimension \n");
+    fprintf(stdout,"-nt     val  Number of threads for the edge and cavity analysis and the file I/O\n");
+    fprintf(stdout,"-queue       split/collapse the edges by length order \n");
 #endif
 #ifdef USE_SCOTCH
-    fprintf(stdout,"-rn [n]      Turn on or off the renumbering using SCOTCH [1/0] \n");
+    fprintf(stdout,"-rn [n]      Renumbering: none, SCOTCH, Hilbert or Morton curve [0/1/2/3] \n");
+#else
+    fprintf(stdout,"-rn [n]      Renumbering: none, Hilbert or Morton curve [0/2/3] \n");
 #endif
     exit(EXIT_FAILURE);
 }
@@ -299,6 +317,23 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met
                     if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_nomove,1) )
                         exit(EXIT_FAILURE);
                 }
+                else if( !strcmp(argv[i],"-nogrowth") ) {
+                    if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_growth,0) )
+                        exit(EXIT_FAILURE);
+                }
+#ifndef PATTERN
+                else if ( !strcmp(argv[i],"-nt") ) {
+                    if ( ++i < argc && isdigit(argv[i][0]) ) {
+                        if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_threads,
+                                                  atoi(argv[i])) )
+                            exit(EXIT_FAILURE);
+                    }
+                    else {
+                        fprintf(stderr,"Missing argument option %s\n",argv[i-1]);
+                        _MMG5_usage(argv[0]);
+                    }
+                }
+#endif
                 break;
             case 'o':
                 if ( !strcmp(argv[i],"-out") ) {
@@ -312,7 +347,14 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met
                     }
                 }
                 break;
-#ifdef USE_SCOTCH
+#ifndef PATTERN
+            case 'q':
+                if ( !strcmp(argv[i],"-queue") ) {
+                    if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_queue,1) )
+                        exit(EXIT_FAILURE);
+                }
+                break;
+#endif
             case 'r':
                 if ( !strcmp(argv[i],"-rn") ) {
                     if ( ++i < argc ) {
@@ -331,7 +373,6 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met
                     }
                 }
                 break;
-#endif
             case 's':
                 if ( !strcmp(argv[i],"-sol") ) {
                     if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
@@ -532,13 +573,6 @@ int MMG5_mmg3dcheck(MMG5_pMesh mesh,MMG5_pSol met,
     fprintf(stdout,"     %s\n",MG_CPY);
     fprintf(stdout,"    %s %s\n",__DATE__,__TIME__);
 
-    signal(SIGABRT,_MMG5_pampa_excfun);
-    signal(SIGFPE,_MMG5_pampa_excfun);
-    signal(SIGILL,_MMG5_pampa_excfun);
-    signal(SIGSEGV,_MMG5_pampa_excfun);
-    signal(SIGTERM,_MMG5_pampa_excfun);
-    signal(SIGINT,_MMG5_pampa_excfun);
-
     tminit(ctim,TIMEMAX);
     chrono(ON,&(ctim[0]));
 
@@ -550,11 +584,8 @@ int MMG5_mmg3dcheck(MMG5_pMesh mesh,MMG5_pSol met,
     if ( met->np && (met->np != mesh->np) ) {
         fprintf(stdout,"  ## WARNING: WRONG SOLUTION NUMBER. IGNORED\n");
         _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
-        met->np = 0;
-    }
-    else if ( met->size!=1 ) {
-        fprintf(stdout,"  ## ERROR: ANISOTROPIC METRIC NOT IMPLEMENTED.\n");
-        return(MMG5_STRONGFAILURE);
+        met->np   = 0;
+        met->size = 1;
     }
 
     chrono(OFF,&(ctim[1]));
@@ -596,7 +627,7 @@ int MMG5_mmg3dcheck(MMG5_pMesh mesh,MMG5_pSol met,
 void MMG5_searchqua(MMG5_pMesh mesh,MMG5_pSol met,double critmin, int *eltab) {
     MMG5_pTetra   pt;
     double   rap;
-    int      k;
+    MMG5_int k;
 
     for (k=1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
@@ -628,13 +659,13 @@ void MMG5_searchqua(MMG5_pMesh mesh,MMG5_pSol met,double critmin, int *eltab) {
 int MMG5_searchlen(MMG5_pMesh mesh, MMG5_pSol met, double lmin,
                    double lmax, int *eltab) {
     MMG5_pTetra          pt;
-    _MMG5_Hash           hash;
+    _MMG5_EdgeMap        hash;
     double          len;
-    int             k,np,nq;
+    MMG5_int        k,np,nq;
     char            ia,i0,i1,ier;
 
     /* Hash all edges in the mesh */
-    if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) )  return(0);
+    if ( !_MMG5_edgeMapNew(mesh,&hash,7*mesh->np) )  return(0);
 
     for(k=1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
@@ -646,8 +677,8 @@ int MMG5_searchlen(MMG5_pMesh mesh, MMG5_pSol met, double lmin,
             np = pt->v[i0];
             nq = pt->v[i1];
 
-            if(!_MMG5_hashEdge(mesh,&hash,np,nq,0)){
-                fprintf(stdout,"%s:%d: Error: function _MMG5_hashEdge return 0\n",
+            if(!_MMG5_edgeMapAdd(mesh,&hash,np,nq,0)){
+                fprintf(stdout,"%s:%d: Error: function _MMG5_edgeMapAdd return 0\n",
                         __FILE__,__LINE__);
                 exit(EXIT_FAILURE);
             }
@@ -666,7 +697,7 @@ int MMG5_searchlen(MMG5_pMesh mesh, MMG5_pSol met, double lmin,
             nq = pt->v[i1];
 
             /* Remove edge from hash ; ier = 1 if edge has been found */
-            ier = _MMG5_hashPop(&hash,np,nq);
+            ier = _MMG5_edgeMapPop(&hash,np,nq);
             if( ier ) {
                 len = _MMG5_lenedg(mesh,met,np,nq);
 
@@ -677,7 +708,7 @@ int MMG5_searchlen(MMG5_pMesh mesh, MMG5_pSol met, double lmin,
             }
         }
     }
-    _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+    _MMG5_edgeMapFree(mesh,&hash);
     return(1);
 }
 
@@ -722,5 +753,17 @@ inline double _MMG5_lenedgCoor_iso(double *ca,double *cb,double *ma,double *mb)
  *
  */
 inline double _MMG5_lenedgCoor_ani(double *ca,double *cb,double *sa,double *sb) {
-    return(0.0);
+    double   ux,uy,uz,dd1,dd2;
+
+    ux = cb[0] - ca[0];
+    uy = cb[1] - ca[1];
+    uz = cb[2] - ca[2];
+
+    dd1 =      sa[0]*ux*ux + sa[3]*uy*uy + sa[5]*uz*uz \
+        + 2.0*(sa[1]*ux*uy + sa[2]*ux*uz + sa[4]*uy*uz);
+    dd2 =      sb[0]*ux*ux + sb[3]*uy*uy + sb[5]*uz*uz \
+        + 2.0*(sb[1]*ux*uy + sb[2]*ux*uz + sb[4]*uy*uz);
+    if ( dd1 <= 0.0 || dd2 <= 0.0 )  return(0.0);
+
+    return( (sqrt(dd1) + sqrt(dd2) + 4.0*sqrt(0.5*(dd1+dd2))) / 6.0 );
 }
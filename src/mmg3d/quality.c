@@ -34,29 +34,15 @@
  */
 
 #include "mmg3d.h"
+#include "metric_kernels.h"
 
-extern char ddb;
-
-inline double _MMG5_lenedg_ani(MMG5_pMesh mesh,MMG5_pSol met,int ip1,int ip2) {
-    return(0.0);
+inline double _MMG5_lenedg_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ip1,MMG5_int ip2) {
+    return(_MMG5_lenedg_ani_inl(mesh,met,ip1,ip2));
 }
 
 /** Compute length of edge [ip1,ip2] according to the size prescription */
-inline double _MMG5_lenedg_iso(MMG5_pMesh mesh,MMG5_pSol met,int ip1,int ip2) {
-    MMG5_pPoint   p1,p2;
-    double   h1,h2,l,r,len;
-
-    p1 = &mesh->point[ip1];
-    p2 = &mesh->point[ip2];
-    h1 = met->m[ip1];
-    h2 = met->m[ip2];
-    l = (p2->c[0]-p1->c[0])*(p2->c[0]-p1->c[0]) + (p2->c[1]-p1->c[1])*(p2->c[1]-p1->c[1]) \
-        + (p2->c[2]-p1->c[2])*(p2->c[2]-p1->c[2]);
-    l = sqrt(l);
-    r = h2 / h1 - 1.0;
-    len = fabs(r) < _MMG5_EPS ? l / h1 : l / (h2-h1) * log(r+1.0);
-
-    return(len);
+inline double _MMG5_lenedg_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ip1,MMG5_int ip2) {
+    return(_MMG5_lenedg_iso_inl(mesh,met,ip1,ip2));
 }
 
 
@@ -93,14 +79,18 @@ inline double _MMG5_caltri(MMG5_pMesh mesh,MMG5_pTria ptt) {
     return(sqrt(cal) / rap);
 }
 
-/** compute tetra oriented quality of iel (return 0.0 when element is inverted) */
-inline double _MMG5_orcal(MMG5_pMesh mesh,int iel) {
+/** compute tetra oriented quality of iel (return 0.0 when element is
+    inverted), in the metric if it is anisotropic, euclidean otherwise */
+inline double _MMG5_orcal(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int iel) {
     MMG5_pTetra     pt;
     double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
     double     vol,v1,v2,v3,rap;
     double     *a,*b,*c,*d;
 
     pt = &mesh->tetra[iel];
+    if ( met && met->m && met->size == 6 )
+        return(_MMG5_caltet_ani_inl(mesh,met,pt->v[0],pt->v[1],pt->v[2],pt->v[3]));
+
     a = mesh->point[pt->v[0]].c;
     b = mesh->point[pt->v[1]].c;
     c = mesh->point[pt->v[2]].c;
@@ -151,64 +141,30 @@ inline double _MMG5_orcal(MMG5_pMesh mesh,int iel) {
     return(vol / rap);
 }
 
+/** Compute the quality of the tetra in the anisotropic metric (the qualities
+    computed at the loading of the mesh being euclidean) */
+void _MMG5_tetqua(MMG5_pMesh mesh,MMG5_pSol met) {
+    MMG5_pTetra   pt;
+    MMG5_int      k;
 
-/** compute tetra quality iso */
-inline double _MMG5_caltet_iso(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id) {
-    double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
-    double     vol,v1,v2,v3,rap;
-    double    *a,*b,*c,*d;
-
-    a = mesh->point[ia].c;
-    b = mesh->point[ib].c;
-    c = mesh->point[ic].c;
-    d = mesh->point[id].c;
-
-    /* volume */
-    abx = b[0] - a[0];
-    aby = b[1] - a[1];
-    abz = b[2] - a[2];
-    rap = abx*abx + aby*aby + abz*abz;
-
-    acx = c[0] - a[0];
-    acy = c[1] - a[1];
-    acz = c[2] - a[2];
-    rap += acx*acx + acy*acy + acz*acz;
-
-    adx = d[0] - a[0];
-    ady = d[1] - a[1];
-    adz = d[2] - a[2];
-    rap += adx*adx + ady*ady + adz*adz;
-
-    v1  = acy*adz - acz*ady;
-    v2  = acz*adx - acx*adz;
-    v3  = acx*ady - acy*adx;
-    vol = abx * v1 + aby * v2 + abz * v3;
-    if ( vol < _MMG5_EPSD2 )  return(0.0);
-
-    bcx = c[0] - b[0];
-    bcy = c[1] - b[1];
-    bcz = c[2] - b[2];
-    rap += bcx*bcx + bcy*bcy + bcz*bcz;
+    if ( !met->m || met->size != 6 )  return;
 
-    bdx = d[0] - b[0];
-    bdy = d[1] - b[1];
-    bdz = d[2] - b[2];
-    rap += bdx*bdx + bdy*bdy + bdz*bdz;
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        pt->qual = _MMG5_orcal(mesh,met,k);
+    }
+}
 
-    cdx = d[0] - c[0];
-    cdy = d[1] - c[1];
-    cdz = d[2] - c[2];
-    rap += cdx*cdx + cdy*cdy + cdz*cdz;
-    if ( rap < _MMG5_EPSD2 )  return(0.0);
 
-    /* quality = vol / len^3/2 */
-    rap = rap * sqrt(rap);
-    return(vol / rap);
+/** compute tetra quality iso */
+inline double _MMG5_caltet_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int id) {
+    return(_MMG5_caltet_iso_inl(mesh,met,ia,ib,ic,id));
 }
 
 
-inline double _MMG5_caltet_ani(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id) {
-    return(0.0);
+inline double _MMG5_caltet_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int ia,MMG5_int ib,MMG5_int ic,MMG5_int id) {
+    return(_MMG5_caltet_ani_inl(mesh,met,ia,ib,ic,id));
 }
 
 
@@ -283,13 +239,14 @@ unsigned char inxt[7]    = { 1,2,0,1,2,0,1 };
 /**
  * \warning Not used.
  */
-int _MMG5_typelt(MMG5_pMesh mesh,int iel,int *item) {
+int _MMG5_typelt(MMG5_pMesh mesh,MMG5_int iel,int *item) {
     MMG5_pTetra    pt;
     MMG5_pPoint    pa,pb,pc,pd;
     double    abx,aby,abz,acx,acy,acz,adx,ady,adz,v1,v2,v3,vol;
     double    bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz,h[6],volchk,ssmall;
     double    s[4],dd,rapmin,rapmax,surmin,surmax;
-    int       i,k,ia,ib,ic,id,isur,isurmax,isurmin,iarmax,iarmin;
+    MMG5_int  ia,ib,ic,id;
+    int       i,k,isur,isurmax,isurmin,iarmax,iarmin;
     int       nobtus,naigu,aigu;
     short     i0,i1,i2;
     double lmoy;
@@ -525,12 +482,14 @@ int _MMG5_typelt(MMG5_pMesh mesh,int iel,int *item) {
 /**
  * \warning Not used.
  */
-int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
+MMG5_int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pTetra   pt;
     double   kal;
-    int      k,it,maxit,nd/*,item[2],typ*/;
+    MMG5_int k,nd/*,item[2],typ*/;
+    int      it,maxit;
     /*int      ntyp[10];*/
-    int      list[_MMG5_LMAX+2],i,ilist,nconf,ns;
+    MMG5_int list[_MMG5_LMAX+2],nconf,ns;
+    int      i,ilist;
 
     it = 0;
     maxit = 3;
@@ -549,7 +508,7 @@ int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
             /*treat bad elt*/
             /*1) try to swp one edge*/
             for(i=0 ; i<6 ; i++) {
-                nconf = _MMG5_chkswpgen(mesh,k,i,&ilist,list,1.01);
+                nconf = _MMG5_chkswpgen(mesh,met,k,i,&ilist,list,1.01);
                 if ( nconf ) {
                     ns++;
                     if(!_MMG5_swpgen(mesh,met,nconf,ilist,list,NULL)) return(-1);
@@ -562,7 +521,7 @@ int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
           if ( ntyp[k] )
           printf("  optim [%d]      = %5d  %6.2f %%\n",k,ntyp[k],100.0*ntyp[k]/nd);
         */if ( ns > 0 )
-            fprintf(stdout,"     %8d edge swapped\n",ns);
+            fprintf(stdout,"     %8" MMG5_PRId " edge swapped\n",ns);
     }
     while ( ++it < maxit && nd > 0 );
     return(nd);
@@ -573,7 +532,8 @@ int _MMG5_prilen(MMG5_pMesh mesh, MMG5_pSol met) {
     MMG5_pTetra          pt;
     _MMG5_Hash           hash;
     double          len,avlen,dned,lmin,lmax;
-    int             k,np,nq,amin,bmin,amax,bmax,ned,hl[9];
+    MMG5_int        k,np,nq,amin,bmin,amax,bmax,ned;
+    int             hl[9];
     char            ia,i0,i1,ier,i;
     static double   bd[9]= {0.0, 0.3, 0.6, 0.7071, 0.9, 1.3, 1.4142, 2.0, 5.0};
     //{0.0, 0.2, 0.5, 0.7071, 0.9, 1.111, 1.4142, 2.0, 5.0};
@@ -652,11 +612,11 @@ int _MMG5_prilen(MMG5_pMesh mesh, MMG5_pSol met) {
     dned = (double)ned;
     avlen = avlen / dned;
 
-    fprintf(stdout,"\n  -- RESULTING EDGE LENGTHS  %d\n",ned);
+    fprintf(stdout,"\n  -- RESULTING EDGE LENGTHS  %" MMG5_PRId "\n",ned);
     fprintf(stdout,"     AVERAGE LENGTH         %12.4f\n",avlen);
-    fprintf(stdout,"     SMALLEST EDGE LENGTH   %12.4f   %6d %6d\n",
+    fprintf(stdout,"     SMALLEST EDGE LENGTH   %12.4f   %6" MMG5_PRId " %6" MMG5_PRId "\n",
             lmin,amin,bmin);
-    fprintf(stdout,"     LARGEST  EDGE LENGTH   %12.4f   %6d %6d \n",
+    fprintf(stdout,"     LARGEST  EDGE LENGTH   %12.4f   %6" MMG5_PRId " %6" MMG5_PRId " \n",
             lmax,amax,bmax);
 
     if ( hl[3]+hl[4]+hl[5] )
@@ -692,7 +652,8 @@ int _MMG5_prilen(MMG5_pMesh mesh, MMG5_pSol met) {
 void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pTetra    pt;
     double   rap,rapmin,rapmax,rapavg,med,good;
-    int      i,k,iel,ok,ir,imax,nex,his[5];
+    MMG5_int k,iel,ok,nex;
+    int      i,ir,imax,his[5];
 
     rapmin  = 2.0;
     rapmax  = 0.0;
@@ -728,8 +689,8 @@ void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met) {
     }
 
 #ifndef DEBUG
-    fprintf(stdout,"\n  -- MESH QUALITY   %d\n",mesh->ne - nex);
-    fprintf(stdout,"     BEST   %8.6f  AVRG.   %8.6f  WRST.   %8.6f (%d)\n",
+    fprintf(stdout,"\n  -- MESH QUALITY   %" MMG5_PRId "\n",mesh->ne - nex);
+    fprintf(stdout,"     BEST   %8.6f  AVRG.   %8.6f  WRST.   %8.6f (%" MMG5_PRId ")\n",
             rapmax,rapavg / (mesh->ne-nex),rapmin,iel);
 #else
     fprintf(stdout,"     BEST   %e  AVRG.   %e  WRST.   %e (%d)\n => %d %d %d %d\n",
@@ -765,233 +726,77 @@ void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met) {
 }
 
 /**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param weightelt if not NULL, estimated number of final tetrahedra inside
+ * each element (size ne+1).
+ * \param npcible pointer toward the estimated final number of vertices.
+ * \param necible pointer toward the estimated final number of tetrahedra.
+ * \return 1 if success, 0 if the size map is undefined.
  *
- * Approximation of the final number of vertex.
+ * Approximation of the final numbers of vertices and tetrahedra: the volume
+ * of each tetrahedron in the metric (mean of the vertex densities
+ * \f$h^{-3}\f$ or \f$\sqrt{det(M)}\f$ times the euclidean volume) is divided
+ * by the volume of the unit regular tetrahedron. Elements are independent
+ * and processed concurrently with the \a USE_OPENMP flag. Without size map,
+ * the constant size \a hmax is used if provided.
  *
- * \warning Not used.
  */
-int _MMG5_countelt(MMG5_pMesh mesh,MMG5_pSol sol, double *weightelt, long *npcible) {
+int _MMG5_countelt(MMG5_pMesh mesh,MMG5_pSol sol,double *weightelt,
+                   MMG5_int *npcible,MMG5_int *necible) {
     MMG5_pTetra pt;
-    double  len;
-    int    k,ia,ipa,ipb,lon,l;
-    //int   npbdry;
-    int    *pdel,lenint,loc,nedel,longen;
-    int      isbdry;
-    double   dned,dnface,dnint/*,dnins*/,w,lenavg,lent[6];
-    double   dnpdel,dnadd,leninv,dnaddloc,dnpdelloc;
-    int   list[_MMG5_LMAX],ddebug,ib;
-    long  nptot;
-    //FILE *inm;
-
-    pdel = (int*) calloc(mesh->np+1,sizeof(int));
-    nptot = (long) mesh->np;
-
-    // svg des poids
-    // npbdry = 0;
-    // inm = fopen("poid.sol","w");
-    // fprintf(inm,"MeshVersionFormatted 2\n Dimension 3 \n SolAtTetrahedra \n %d\n 1 1 \n",mesh->ne);
-
-    // substraction of the half of the number of bdry vertex to avoid the surestimation due of the interface
-    // for (k=1; k<=mesh->np; k++) {
-    //   if(mesh->point[k].tag & MG_BDY) npbdry++;
-    // }
-    // nptot -= 0.5*npbdry;
-
-    dnadd = dnpdel = 0;
+    double      *m,dens,h,vol,nunit;
+    MMG5_int    k,ip;
+    int         i;
+#ifdef USE_OPENMP
+    int         nthr;
+#endif
 
+    if ( sol && sol->m )
+        h = 0.;
+    else if ( mesh->info.hmax > 0. && mesh->info.hmax < FLT_MAX )
+        h = mesh->info.hmax;
+    else
+        return(0);
+
+    nunit = 0.;
+#ifdef USE_OPENMP
+    nthr  = MG_MAX(1,mesh->info.threads);
+#pragma omp parallel for num_threads(nthr) schedule(static)     \
+    private(pt,m,dens,vol,ip,i) reduction(+:nunit)
+#endif
     for (k=1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
-        if ( !pt->v[0] )  continue;
-        if(0 && k==250343) ddebug = 1;
-        else ddebug = 0;
-
-        if(ddebug) printf("on traite %d %e\n",k,_MMG5_ALPHAD*pt->qual);
-
-        /*longueur moyenne*/
-        lenavg = 0;
-        for(ib=0 ; ib<6 ; ib++) {
-            ipa = _MMG5_iare[ib][0];
-            ipb = _MMG5_iare[ib][1];
-            lent[ib] = _MMG5_lenedg(mesh,sol,pt->v[ipa],pt->v[ipb]);
-            lenavg+=lent[ib];
-        }
-        lenavg /= 6.;
-
-        w = 0;
-        if(weightelt)
-            weightelt[k] = 0;
-        nedel = 0;
-
-        for (ia=0; ia<6; ia++) {
-            //lon = MMG5_coquil(mesh,k,ia,&list);
-            longen = _MMG5_coquil(mesh,k,ia,list);
-            lon = longen/2;
-            isbdry = 0;//longen%2;
-            if(!lon) continue;
-            /* if ( isbdry )  { */
-            /*    assert(longen%2); */
-            /*    //printf("_MMG5_coquil %d\n",longen/2); */
-            /*    continue; */
-            /* } */
-            //assert(!(longen%2));
-            for (l=1; l<lon; l++)
-                if ( list[l] < 6*k )  break;
-
-            if ( l < lon )  {
-                loc = 1;
-                //continue;
-            } else {
-                loc = 0;
-            }
-
-            dnaddloc = 0;
-            dnpdelloc = 0;
-
-            len = lent[ia];
-
-            if(ddebug) printf("len %e\n",len);
-            if(len > 3) {
-                loc = 0;
-                len = lenavg;
-                lenint = ((int) len);
-                if(fabs(lenint -len) > 0.5) lenint++;
-                //POURQUOI SURESTIMER ???lenint++;
-                //nb de point a inserer sur l'arete : longueur - 1
-                dned = lenint - 1;
-                //nb de point a l'interieur de la face si toutes les aretes sont coupees le meme nb de fois
-                dnface = (lenint+2)*(lenint+1) / 2. - 3 - 3*dned;
-                //nb de point a l'interieur du tetra si toutes les aretes sont coupees le meme nb de fois
-                dnint = (lenint+3)*(lenint+2)*(lenint+1) / 6. - 4 - 4*dnface - 6*dned;
-                //nb de point a inserer pour cette arete de ce tetra : on divise par lon
-                // dnins = dned*(1./lon) + (dnface/3. + dnint/6.);//(dnface/12. + dnint/6.);
-                if(!isbdry) {
-                    //nb points sur l'arete +
-                    //lon*(2/3 nb point sur la face (ie 1/3 de face et 2 faces adj a l'arete) + 1/6 nb de point interne)
-                    dnaddloc = dned + lon*(2*dnface/3. + dnint/6.);
-                } else {
-                    dnaddloc = 0.5*(dned + lon*(2*dnface/3. + dnint/6.));
-                }
-                dnaddloc *= 1./lon;
-                if(!loc) {
-                    if(_MMG5_ALPHAD * pt->qual >= 0.5) /*on ne compte les points internes que pour les (tres) bons tetras*/
-                        dnaddloc = dnaddloc;
-                    else if(_MMG5_ALPHAD * pt->qual >= 1./5.)
-                        dnaddloc = dned / lon + 2*dnface/3.;
-                    else
-                        dnaddloc = dned / lon ;
-                    //rajout de 30% parce que 1) on vise des longueurs de 0.7 et
-                    //2) on ne tient pas compte du fait qu'on divise tjs par 2 dans la generation
-                    if( (_MMG5_ALPHAD*pt->qual <= 1./50.) )
-                        dnaddloc = 0;
-                    else  if((_MMG5_ALPHAD*pt->qual <= 1./10.) )
-                        dnaddloc =  0.2*dnaddloc; //CEDRIC : essayer 0.3 0.4
-                    else if((len > 10) && (_MMG5_ALPHAD*pt->qual >= 1./1.5) ) //on sous-estime uniquement pour les tres bons
-                        dnaddloc = dnaddloc*0.3 + dnaddloc; //CEDRIC : essayer 0.3 ?
-                    else if(len < 6 && len>3) //CEDRIC : essayer len < 3,4, 6,7 mais aussi en commentant le test sur len puis pour la qual > 3, 5,8
-                        dnaddloc = 0.7*dnaddloc; //CEDRIC : essayer 0.9 0.7 0.6
-
-
-                    dnadd += dnaddloc;
-                }
-            } else if(len > 2.8) {
-                if(!isbdry) {
-                    dnaddloc = 2.;
-                } else {
-                    dnaddloc = 1;
-                }
-                if(!loc){
-                    if(!isbdry) {
-                        dnadd += 2.;
-                    } else {
-                        dnadd++;
-                    }
-                }
-                // dnins = 2;
-            } else if(len > 1.41) {
-                if(!isbdry)
-                    dnaddloc = 1;
-                if(!loc) {
-                    if(!isbdry) dnadd += 1.;
-                }
-                // dnins = 1;
-            } else if(len < 0.6) {
-                nedel = 1;
-
-                leninv = 1./len;
-                if(pt->v[ipa]<pt->v[ipb]) {
-                    if(!pdel[pt->v[ipa]]) {
-                        if(!isbdry) {
-                            dnpdelloc = (leninv - 1.)/leninv;
-                        } else {
-                            dnpdelloc = 0.5*(leninv - 1.)/leninv;
-                        }
-                        if(!loc) {
-                            dnpdel+=dnpdelloc;
-                            pdel[pt->v[ipa]]=1;
-                        }
-                    } else if(!pdel[pt->v[ipb]]) {
-                        if(!isbdry) {
-                            dnpdelloc = (leninv - 1.)/leninv;
-                        } else {
-                            dnpdelloc = 0.5*(leninv - 1.)/leninv;
-                        }
-                        if(!loc) {
-                            dnpdel +=dnpdelloc;
-                            pdel[pt->v[ipb]]=1;
-                        }
-                    }
-                } else {
-                    if(!pdel[pt->v[ipb]]) {
-                        if(!isbdry) {
-                            dnpdelloc = (leninv - 1.)/leninv;
-                        } else {
-                            dnpdelloc = 0.5*(leninv - 1.)/leninv;
-                        }
-                        if(!loc) {
-                            dnpdel+=dnpdelloc;
-                            pdel[pt->v[ipb]]=1;
-                        }
-                    } else if(!pdel[pt->v[ipa]]) {
-                        if(!isbdry) {
-                            dnpdelloc = (leninv - 1.)/leninv;
-                        } else {
-                            dnpdelloc = 0.5*(leninv - 1.)/leninv;
-                        }
-                        if(!loc) {
-                            dnpdel+=dnpdelloc;
-                            pdel[pt->v[ipa]]=1;
-                        }
-                    }
-                }
-                //ndel++;
+        if ( weightelt )  weightelt[k] = 0.;
+        if ( !MG_EOK(pt) )  continue;
+
+        vol = fabs(_MMG5_orvol(mesh->point,pt->v))/6.;
+        if ( h > 0. )
+            dens = 1./(h*h*h);
+        else {
+            dens = 0.;
+            for (i=0; i<4; i++) {
+                ip = pt->v[i];
+                m  = &sol->m[(ip-1)*sol->size+1];
+                if ( sol->size == 1 )
+                    dens += 1./(m[0]*m[0]*m[0]);
+                else
+                    dens += sqrt(fabs(m[0]*(m[3]*m[5]-m[4]*m[4])
+                                      - m[1]*(m[1]*m[5]-m[2]*m[4])
+                                      + m[2]*(m[1]*m[4]-m[2]*m[3])));
             }
+            dens *= 0.25;
+        }
+        vol *= _MMG5_NECOEF*dens/_MMG5_VOLUNIT;
+        if ( weightelt )  weightelt[k] = vol;
+        nunit += vol;
+    }
 
-            //pour cette arete de ce tetra :
-            //PHASE 1 = dnaddloc + nedel (on compte un si arete trop petite)
-            //PHASE 2 = dnaddloc
-            if(ddebug) printf("on ajoute %e\n",dnaddloc);
-            w += (2*dnaddloc);//1./lon*(2*dnaddloc + dnpdelloc);
-
-        }/*for ia*/
-        if(ddebug) printf("on soustrait %d\n",nedel);
-
-        w += 0.5*nedel;
-
-        //si l'elt ne doit pas etre ni splitte ni collapse est ce qu'on le compte ???
-        //if(w==0) w+=1;
-
-        //fprintf(inm,"%e\n",w);
-        if(weightelt)
-            weightelt[k] = 10*w;
-    } /*For k*/
-
-
-    nptot += (long) dnadd - (long) dnpdel;
-    *npcible = nptot;
-    fprintf(stdout,"ESTIMATION OF THE FINAL NUMBER OF NODES : %ld  _MMG5_ADD %f  _MMG5_DEL %f\n",nptot,dnadd,dnpdel);
-
-    free(pdel);
+    *necible = (MMG5_int)MG_MAX(1.,nunit);
+    *npcible = (MMG5_int)MG_MAX(4.,nunit/_MMG5_NENP);
+    if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+        fprintf(stdout,"     ESTIMATED FINAL SIZE: %" MMG5_PRId " VERTICES, %"
+                MMG5_PRId " TETRAHEDRA\n",*npcible,*necible);
 
-    //fclose(inm);
     return(1);
 }
@@ -0,0 +1,535 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/renum.c
+ * \brief Renumbering of the mesh along a space filling curve.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * Points are sorted by the Hilbert (or Morton) index of their position and
+ * tetrahedra by the index of their barycenter, so that entities close in
+ * space are close in memory. The metric, the \a xpoint and \a xtetra tables
+ * and the adjacency table are permuted consistently. The keys and the
+ * permutations are computed concurrently with the \a USE_OPENMP flag.
+ *
+ */
+
+#include "mmg3d.h"
+
+/** number of bits of the grid coordinates along each axis */
+#define _MMG5_SFCBITS 21
+
+/**
+ * \param x coordinate on the grid.
+ * \return \a x with two zero bits inserted between its bits.
+ *
+ * Spread the 21 lower bits of \a x for the Morton interleaving.
+ *
+ */
+static inline unsigned long long _MMG5_sfcSpread(unsigned long long x) {
+    x &= 0x1fffffULL;
+    x  = (x | x << 32) & 0x1f00000000ffffULL;
+    x  = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x  = (x | x << 8)  & 0x100f00f00f00f00fULL;
+    x  = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+    x  = (x | x << 2)  & 0x1249249249249249ULL;
+    return(x);
+}
+
+/**
+ * \param X coordinates on the grid (modified).
+ * \param type \ref _MMG5_RENUM_HILBERT or \ref _MMG5_RENUM_MORTON.
+ * \return the index of the cell \a X along the curve.
+ *
+ * Index of a cell of the \f$2^{21}\f$ grid along the Hilbert curve
+ * (J. Skilling, Programming the Hilbert curve, 2004) or the Morton curve.
+ *
+ */
+static inline
+unsigned long long _MMG5_sfcKey(unsigned int X[3],int type) {
+    unsigned int M,P,Q,t;
+    int          i;
+
+    if ( type == _MMG5_RENUM_HILBERT ) {
+        M = 1u << (_MMG5_SFCBITS-1);
+
+        /* inverse undo of the rotations */
+        for (Q=M; Q>1; Q>>=1) {
+            P = Q-1;
+            for (i=0; i<3; i++) {
+                if ( X[i] & Q )
+                    X[0] ^= P;
+                else {
+                    t     = (X[0] ^ X[i]) & P;
+                    X[0] ^= t;
+                    X[i] ^= t;
+                }
+            }
+        }
+        /* gray encode */
+        X[1] ^= X[0];
+        X[2] ^= X[1];
+        t = 0;
+        for (Q=M; Q>1; Q>>=1)
+            if ( X[2] & Q )  t ^= Q-1;
+        for (i=0; i<3; i++)  X[i] ^= t;
+    }
+
+    return( (_MMG5_sfcSpread(X[0]) << 2) | (_MMG5_sfcSpread(X[1]) << 1)
+            | _MMG5_sfcSpread(X[2]) );
+}
+
+/**
+ * \param n number of keys.
+ * \param key keys to sort (overwritten).
+ * \param idx entities associated to the keys (sorted with the keys).
+ * \param wkey work table of size n.
+ * \param widx work table of size n.
+ *
+ * Stable radix sort of the pairs (key,idx) by increasing keys, 8 bits per
+ * pass. Passes on bytes that are the same for all the keys are skipped.
+ * The sorted pairs are returned in \a key and \a idx.
+ *
+ */
+static void
+_MMG5_sfcSort(MMG5_int n,unsigned long long *key,MMG5_int *idx,
+              unsigned long long *wkey,MMG5_int *widx) {
+    unsigned long long *tk,*key0;
+    MMG5_int           *ti,*idx0,cnt[256],sum,k;
+    int                 sh,b;
+
+    if ( n < 2 )  return;
+
+    key0 = key;
+    idx0 = idx;
+    for (sh=0; sh<64; sh+=8) {
+        memset(cnt,0,256*sizeof(MMG5_int));
+        for (k=0; k<n; k++)
+            cnt[(key[k] >> sh) & 0xff]++;
+        if ( cnt[(key[0] >> sh) & 0xff] == n )  continue;
+
+        sum = 0;
+        for (b=0; b<256; b++) {
+            k      = cnt[b];
+            cnt[b] = sum;
+            sum   += k;
+        }
+        for (k=0; k<n; k++) {
+            b = (int)((key[k] >> sh) & 0xff);
+            wkey[cnt[b]] = key[k];
+            widx[cnt[b]] = idx[k];
+            cnt[b]++;
+        }
+        tk = key;  key = wkey;  wkey = tk;
+        ti = idx;  idx = widx;  widx = ti;
+    }
+    /* odd number of passes: sorted pairs are in the work tables */
+    if ( key != key0 ) {
+        memcpy(key0,key,n*sizeof(unsigned long long));
+        memcpy(idx0,idx,n*sizeof(MMG5_int));
+    }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param perm if not NULL, table of size np+1 filled with the new index of
+ * each point (0 for unused points).
+ * \param type \ref _MMG5_RENUM_HILBERT or \ref _MMG5_RENUM_MORTON.
+ * \return 2 if the mesh has been renumbered, 1 if the renumbering is skipped
+ * for lack of memory (the mesh and \a perm are unchanged).
+ *
+ * Renumber the points and the tetrahedra of the mesh along the space filling
+ * curve \a type. Unused points and tetrahedra are
+ * removed from the tables. The adjacency table, if any, is permuted.
+ *
+ * The memory of all the work tables is reserved before any table of the
+ * mesh is modified, thus the renumbering cannot stop halfway.
+ *
+ */
+int _MMG5_sfcRenum(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *perm,int type) {
+    MMG5_pPoint         ppt,point;
+    MMG5_pTetra         pt,tetra;
+    MMG5_pxPoint        xpoint;
+    MMG5_pxTetra        xtetra;
+    unsigned long long *key,*wkey;
+    double              min[3],max[3],dd[3],c[3],*m;
+    MMG5_int           *idx,*widx,*np2,*ne2,*adja,np,ne,nxp,nxt,k,iel,i0,siz;
+    long long           mem,memw;
+    unsigned int        X[3];
+    int                 i,j;
+#ifdef USE_OPENMP
+    int                 nthr;
+
+    nthr = MG_MAX(1,mesh->info.threads);
+#endif
+    siz  = MG_MAX(mesh->np,mesh->ne)+1;
+
+    /* reservation of the work tables: the new indices, then the sort tables
+     * or one of the permutation tables at a time */
+    mem  = (long long)(mesh->np+mesh->ne+2)*sizeof(MMG5_int);
+    memw = (long long)2*siz*(sizeof(unsigned long long)+sizeof(MMG5_int));
+    memw = MG_MAX(memw,(long long)(mesh->np+1)*sizeof(MMG5_Point));
+    if ( met && met->m )
+        memw = MG_MAX(memw,(long long)(mesh->np+1)*met->size*sizeof(double));
+    if ( mesh->xp )
+        memw = MG_MAX(memw,(long long)(mesh->xp+1)*sizeof(MMG5_xPoint));
+    memw = MG_MAX(memw,(long long)(mesh->ne+1)*sizeof(MMG5_Tetra));
+    if ( mesh->xt )
+        memw = MG_MAX(memw,(long long)(mesh->xt+1)*sizeof(MMG5_xTetra));
+    if ( mesh->adja )
+        memw = MG_MAX(memw,(long long)(4*mesh->ne+5)*sizeof(MMG5_int));
+    mem += memw;
+
+    _MMG5_ADD_MEM(mesh,mem,"renumbering",return(1));
+    _MMG5_SAFE_MALLOC(key,siz,unsigned long long);
+    _MMG5_SAFE_MALLOC(wkey,siz,unsigned long long);
+    _MMG5_SAFE_MALLOC(idx,siz,MMG5_int);
+    _MMG5_SAFE_MALLOC(widx,siz,MMG5_int);
+    _MMG5_SAFE_CALLOC(np2,mesh->np+1,MMG5_int);
+    _MMG5_SAFE_CALLOC(ne2,mesh->ne+1,MMG5_int);
+
+    /* bounding box of the used points */
+    for (i=0; i<3; i++) {
+        min[i] =  DBL_MAX;
+        max[i] = -DBL_MAX;
+    }
+    for (k=1; k<=mesh->np; k++) {
+        ppt = &mesh->point[k];
+        if ( !MG_VOK(ppt) )  continue;
+        for (i=0; i<3; i++) {
+            min[i] = MG_MIN(min[i],ppt->c[i]);
+            max[i] = MG_MAX(max[i],ppt->c[i]);
+        }
+    }
+    for (i=0; i<3; i++)
+        dd[i] = ((1 << _MMG5_SFCBITS)-1) / MG_MAX(max[i]-min[i],_MMG5_EPSD);
+
+    /* 1. points: keys, sort and new indices */
+    np = 0;
+    for (k=1; k<=mesh->np; k++)
+        if ( MG_VOK(&mesh->point[k]) )  idx[np++] = k;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) private(ppt,X,i)
+#endif
+    for (k=0; k<np; k++) {
+        ppt = &mesh->point[idx[k]];
+        for (i=0; i<3; i++)
+            X[i] = (unsigned int)(dd[i]*(ppt->c[i]-min[i]));
+        key[k] = _MMG5_sfcKey(X,type);
+    }
+    _MMG5_sfcSort(np,key,idx,wkey,widx);
+    for (k=0; k<np; k++)
+        np2[idx[k]] = k+1;
+
+    /* 2. tetrahedra: keys of the barycenters, sort and new indices */
+    ne = 0;
+    for (k=1; k<=mesh->ne; k++)
+        if ( MG_EOK(&mesh->tetra[k]) )  idx[ne++] = k;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) \
+    private(pt,X,c,i,j)
+#endif
+    for (k=0; k<ne; k++) {
+        pt = &mesh->tetra[idx[k]];
+        for (i=0; i<3; i++) {
+            c[i] = 0.;
+            for (j=0; j<4; j++)  c[i] += mesh->point[pt->v[j]].c[i];
+            X[i] = (unsigned int)(dd[i]*(0.25*c[i]-min[i]));
+        }
+        key[k] = _MMG5_sfcKey(X,type);
+    }
+    _MMG5_sfcSort(ne,key,idx,wkey,widx);
+    for (k=0; k<ne; k++)
+        ne2[idx[k]] = k+1;
+
+    _MMG5_SAFE_FREE(key);
+    _MMG5_SAFE_FREE(wkey);
+    _MMG5_SAFE_FREE(widx);
+    _MMG5_SAFE_FREE(idx);
+
+    /* 3. permutation of the points, the metric and the xpoints */
+    _MMG5_SAFE_CALLOC(point,np+1,MMG5_Point);
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static)
+#endif
+    for (k=1; k<=mesh->np; k++)
+        if ( np2[k] )  memcpy(&point[np2[k]],&mesh->point[k],sizeof(MMG5_Point));
+    memcpy(&mesh->point[1],&point[1],np*sizeof(MMG5_Point));
+    _MMG5_SAFE_FREE(point);
+
+    if ( met && met->m ) {
+        _MMG5_SAFE_CALLOC(m,(np+1)*met->size,double);
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static)
+#endif
+        for (k=1; k<=mesh->np; k++)
+            if ( np2[k] )
+                memcpy(&m[(np2[k]-1)*met->size+1],&met->m[(k-1)*met->size+1],
+                       met->size*sizeof(double));
+        memcpy(&met->m[1],&m[1],np*met->size*sizeof(double));
+        _MMG5_SAFE_FREE(m);
+    }
+
+    if ( mesh->xp ) {
+        _MMG5_SAFE_CALLOC(xpoint,mesh->xp+1,MMG5_xPoint);
+        nxp = 0;
+        for (k=1; k<=np; k++) {
+            ppt = &mesh->point[k];
+            if ( !ppt->xp )  continue;
+            memcpy(&xpoint[++nxp],&mesh->xpoint[ppt->xp],sizeof(MMG5_xPoint));
+            ppt->xp = nxp;
+        }
+        memcpy(&mesh->xpoint[1],&xpoint[1],nxp*sizeof(MMG5_xPoint));
+        memset(&mesh->xpoint[nxp+1],0,(mesh->xp-nxp)*sizeof(MMG5_xPoint));
+        _MMG5_SAFE_FREE(xpoint);
+        mesh->xp = nxp;
+    }
+
+    /* 4. permutation of the tetrahedra, the xtetra and the adjacency */
+    _MMG5_SAFE_CALLOC(tetra,ne+1,MMG5_Tetra);
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) private(pt,j)
+#endif
+    for (k=1; k<=mesh->ne; k++) {
+        if ( !ne2[k] )  continue;
+        pt = &tetra[ne2[k]];
+        memcpy(pt,&mesh->tetra[k],sizeof(MMG5_Tetra));
+        for (j=0; j<4; j++)  pt->v[j] = np2[pt->v[j]];
+    }
+    memcpy(&mesh->tetra[1],&tetra[1],ne*sizeof(MMG5_Tetra));
+    _MMG5_SAFE_FREE(tetra);
+
+    if ( mesh->xt ) {
+        _MMG5_SAFE_CALLOC(xtetra,mesh->xt+1,MMG5_xTetra);
+        nxt = 0;
+        for (k=1; k<=ne; k++) {
+            pt = &mesh->tetra[k];
+            if ( !pt->xt )  continue;
+            memcpy(&xtetra[++nxt],&mesh->xtetra[pt->xt],sizeof(MMG5_xTetra));
+            pt->xt = nxt;
+        }
+        memcpy(&mesh->xtetra[1],&xtetra[1],nxt*sizeof(MMG5_xTetra));
+        /* the freed entries may be reused without being cleared */
+        memset(&mesh->xtetra[nxt+1],0,(mesh->xt-nxt)*sizeof(MMG5_xTetra));
+        _MMG5_SAFE_FREE(xtetra);
+        mesh->xt = nxt;
+    }
+
+    if ( mesh->adja ) {
+        _MMG5_SAFE_CALLOC(adja,4*ne+5,MMG5_int);
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(static) private(iel,i0,j)
+#endif
+        for (k=1; k<=mesh->ne; k++) {
+            if ( !ne2[k] )  continue;
+            i0 = 4*(ne2[k]-1)+1;
+            for (j=0; j<4; j++) {
+                iel = mesh->adja[4*(k-1)+1+j];
+                adja[i0+j] = iel ? 4*ne2[iel/4] + iel%4 : 0;
+            }
+        }
+        memcpy(&mesh->adja[1],&adja[1],4*ne*sizeof(MMG5_int));
+        memset(&mesh->adja[4*ne+1],0,4*(mesh->ne-ne)*sizeof(MMG5_int));
+        _MMG5_SAFE_FREE(adja);
+    }
+
+    if ( perm )  memcpy(perm,np2,(mesh->np+1)*sizeof(MMG5_int));
+    _MMG5_SAFE_FREE(np2);
+    _MMG5_SAFE_FREE(ne2);
+    mesh->memCur -= mem;
+
+    /* 5. free entities */
+    if ( np < mesh->np )
+        memset(&mesh->point[np+1],0,(mesh->np-np)*sizeof(MMG5_Point));
+    if ( ne < mesh->ne )
+        memset(&mesh->tetra[ne+1],0,(mesh->ne-ne)*sizeof(MMG5_Tetra));
+    mesh->np = np;
+    mesh->ne = ne;
+
+    for (k=1; k<=mesh->np; k++)
+        mesh->point[k].tmp = 0;
+    mesh->npnil = mesh->np < mesh->npmax ? mesh->np+1 : 0;
+    mesh->nenil = mesh->ne < mesh->nemax ? mesh->ne+1 : 0;
+    if ( mesh->npnil )
+        for (k=mesh->npnil; k<mesh->npmax-1; k++)
+            mesh->point[k].tmp  = k+1;
+    if ( mesh->nenil )
+        for (k=mesh->nenil; k<mesh->nemax-1; k++)
+            mesh->tetra[k].v[3] = k+1;
+
+    return(2);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure (may be NULL): its
+ * points are renumbered.
+ * \param type \ref _MMG5_RENUM_HILBERT or \ref _MMG5_RENUM_MORTON.
+ * \return 0 if fail, 1 if the renumbering is skipped for lack of memory (the
+ * mesh and the bucket are unchanged), 2 if the mesh has been renumbered.
+ *
+ * Renumber the mesh along the curve \a type and update the bucket. The
+ * memory used by the update of the bucket is reserved with the permutation
+ * table, before the mesh is renumbered.
+ *
+ */
+static int
+_MMG5_sfcPerm(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket,int type) {
+    MMG5_int  *perm,siz;
+    int        ier;
+
+    perm = NULL;
+    siz  = mesh->np+1;
+    if ( bucket ) {
+        _MMG5_ADD_MEM(mesh,2*siz*sizeof(MMG5_int),"renumbering",return(1));
+        _MMG5_SAFE_CALLOC(perm,siz,MMG5_int);
+    }
+
+    ier = _MMG5_sfcRenum(mesh,met,perm,type);
+
+    if ( bucket ) {
+        /* release the memory reserved for _MMG5_permBucket */
+        mesh->memCur -= (long long)siz*sizeof(MMG5_int);
+        if ( ier == 2 && !_MMG5_permBucket(mesh,bucket,perm,siz-1) ) {
+            fprintf(stdout,"  ## Unable to renumber the bucket.\n");
+            ier = 0;
+        }
+        _MMG5_DEL_MEM(mesh,perm,siz*sizeof(MMG5_int));
+    }
+
+    if ( ier == 2 && mesh->info.ddebug )  _MMG5_chkmsh(mesh,1,0);
+
+    return(ier);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure (may be NULL): its
+ * points are renumbered.
+ * \return 0 if fail (non conformal mesh), 1 otherwise.
+ *
+ * Renumbering of the mesh along a space filling curve (\a -rn 2 or 3) at the
+ * places where the Scotch renumbering is called.
+ *
+ */
+int _MMG5_sfcCall(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
+    mytime     ctim;
+    char       stim[32];
+    int        ier;
+
+    if ( mesh->info.renum < _MMG5_RENUM_HILBERT )  return(1);
+    if ( mesh->np/2. <= _MMG5_BOXSIZE )  return(1);
+
+    if ( mesh->info.imprim > 5 ) {
+        fprintf(stdout,"  -- RENUMBERING (%s CURVE). \n",
+                mesh->info.renum == _MMG5_RENUM_HILBERT ? "HILBERT" : "MORTON");
+        chrono(RESET,&ctim);
+        chrono(ON,&ctim);
+    }
+
+    ier = _MMG5_sfcPerm(mesh,met,bucket,mesh->info.renum);
+    if ( !ier )  return(0);
+
+    if ( mesh->info.imprim > 5 ) {
+        chrono(OFF,&ctim);
+        printim(ctim.gdif,stim);
+        if ( ier == 1 )
+            fprintf(stdout,"  -- PHASE RENUMBERING SKIPPED.       %s\n",stim);
+        else
+            fprintf(stdout,"  -- PHASE RENUMBERING COMPLETED.     %s\n",stim);
+    }
+    return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return the ratio of far neighbours.
+ *
+ * Locality of the tetrahedra in memory: ratio of the adjacencies between two
+ * tetrahedra whose indices differ by more than \ref _MMG5_LOCWIN. The new
+ * tetrahedra are taken from the free list so this ratio increases along the
+ * adaptation loop.
+ *
+ */
+double _MMG5_locality(MMG5_pMesh mesh) {
+    MMG5_pTetra  pt;
+    MMG5_int     k,iel,*adja,nadj,nfar;
+    int          i;
+
+    if ( !mesh->adja )  return(0.);
+
+    nadj = nfar = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(MG_MAX(1,mesh->info.threads)) \
+    private(pt,adja,iel,i) reduction(+:nadj,nfar)
+#endif
+    for (k=1; k<=mesh->ne; k++) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) )  continue;
+        adja = &mesh->adja[4*(k-1)+1];
+        for (i=0; i<4; i++) {
+            iel = adja[i] / 4;
+            if ( !iel )  continue;
+            nadj++;
+            if ( MG_ABS(iel-k) > _MMG5_LOCWIN )  nfar++;
+        }
+    }
+    return( nadj ? (double)nfar/(double)nadj : 0. );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure (may be NULL).
+ * \return 0 if fail, 1 if the mesh is unchanged, 2 if it has been reordered.
+ *
+ * Reordering between two iterations of the adaptation loop: if the ratio of
+ * far neighbours (\ref _MMG5_locality) exceeds \ref _MMG5_LOCALITY, the mesh
+ * is renumbered along the curve asked by \a -rn (the Hilbert curve for the
+ * Scotch renumbering, that is too expensive to be called here).
+ *
+ */
+int _MMG5_sfcReorder(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
+    double  loc;
+    int     type,ier;
+
+    if ( !mesh->info.renum )  return(1);
+    if ( mesh->np/2. <= _MMG5_BOXSIZE )  return(1);
+
+    loc = _MMG5_locality(mesh);
+    if ( loc <= _MMG5_LOCALITY )  return(1);
+
+    type = mesh->info.renum == _MMG5_RENUM_SCOTCH ?
+        _MMG5_RENUM_HILBERT : mesh->info.renum;
+    ier = _MMG5_sfcPerm(mesh,met,bucket,type);
+    if ( ier == 2 && abs(mesh->info.imprim) > 4 )
+        fprintf(stdout,"     reordering (%.1f%% of far neighbours)\n",100.*loc);
+
+    return(ier);
+}
@@ -37,8 +37,9 @@
 
 int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pPoint    ppt;
-  double    dd;
-  int       i,k;
+  double    dd,d1;
+  MMG5_int  k,iadr;
+  int       i;
   MMG5_pPar      par;
 
   /* compute bounding box */
@@ -85,6 +86,14 @@ int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
     for (k=1; k<=mesh->np; k++)
       met->m[k] *= dd;
   }
+  /* normalize metrics: M is scaled by 1/dd^2 */
+  else if ( met->m ) {
+    d1 = 1.0 / (dd*dd);
+    for (k=1; k<=mesh->np; k++) {
+      iadr = (k-1)*met->size + 1;
+      for (i=0; i<met->size; i++)  met->m[iadr+i] *= d1;
+    }
+  }
 
   /* normalize local parameters */
   for (k=0; k<mesh->info.npar; k++) {
@@ -97,8 +106,9 @@ int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
 
 int _MMG5_unscaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pPoint     ppt;
-  double     dd;
-  int        k;
+  double     dd,d1;
+  MMG5_int   k,iadr;
+  int        i;
   MMG5_pPar       par;
 
   /* de-normalize coordinates */
@@ -112,12 +122,22 @@ int _MMG5_unscaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
   }
 
   /* unscale sizes */
-  if(met->m){
+  if ( met->size == 1 && met->m ) {
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) )	met->m[k] *= dd;
     }
   }
+  /* unscale metrics */
+  else if ( met->m ) {
+    d1 = 1.0 / (dd*dd);
+    for (k=1; k<=mesh->np; k++) {
+      ppt = &mesh->point[k];
+      if ( !MG_VOK(ppt) )  continue;
+      iadr = (k-1)*met->size + 1;
+      for (i=0; i<met->size; i++)  met->m[iadr+i] *= d1;
+    }
+  }
 
   /* unscale paramter values */
   mesh->info.hmin  *= dd;
@@ -72,7 +72,7 @@ static inline
 void _MMG5_warnOrientation(MMG5_pMesh mesh) {
     if ( mesh->xt ) {
         if ( mesh->xt != mesh->ne ) {
-            fprintf(stdout,"  ## Warning: %d tetra on %d reoriented.\n",
+            fprintf(stdout,"  ## Warning: %" MMG5_PRId " tetra on %" MMG5_PRId " reoriented.\n",
                     mesh->xt,mesh->ne);
             fprintf(stdout,"  Your mesh may be non-conform.\n");
         }
@@ -117,15 +117,17 @@ void _MMG5_excfun(int sigid) {
  */
 void _MMG5_setfunc(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( met->size < 6 ) {
-        _MMG5_caltet  = _MMG5_caltet_iso;
-        _MMG5_lenedg  = _MMG5_lenedg_iso;
-        _MMG5_defsiz  = _MMG5_defsiz_iso;
-        _MMG5_gradsiz = _MMG5_gradsiz_iso;
+        mesh->caltet  = _MMG5_caltet_iso;
+        mesh->lenedg  = _MMG5_lenedg_iso;
+        mesh->intmet  = _MMG5_intmet_iso;
+        mesh->defsiz  = _MMG5_defsiz_iso;
+        mesh->gradsiz = _MMG5_gradsiz_iso;
     }
     else {
-        _MMG5_caltet = _MMG5_caltet_ani;
-        _MMG5_lenedg = _MMG5_lenedg_ani;
-        /*defsiz = defsiz_ani;
-          gradsiz = gradsiz_ani;*/
+        mesh->caltet  = _MMG5_caltet_ani;
+        mesh->lenedg  = _MMG5_lenedg_ani;
+        mesh->intmet  = _MMG5_intmet_ani;
+        mesh->defsiz  = _MMG5_defsiz_ani;
+        mesh->gradsiz = _MMG5_gradsiz_ani;
     }
 }
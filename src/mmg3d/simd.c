@@ -0,0 +1,313 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/simd.c
+ * \brief Batched quality, volume and length kernels.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The candidate configurations of the shell and ball operators are gathered
+ * in batches (\ref _MMG5_TetBatch, \ref _MMG5_EdgBatch) and evaluated
+ * together with SSE2, AVX2 or AVX-512 instructions. The instruction set is
+ * chosen on the host CPU when the library is loaded. The vectorized
+ * kernels perform the operations of the scalar ones in the same order and
+ * this file is compiled without contraction of the multiply-add operations,
+ * so the results do not depend on the instruction set.
+ *
+ */
+
+#include "mmg3d.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _MMG5_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define _MMG5_VCAT2(a,b) a##b
+#define _MMG5_VCAT(a,b)  _MMG5_VCAT2(a,b)
+#define _MMG5_VNAME(f)   _MMG5_VCAT(_MMG5_VCAT(_MMG5_,f),_MMG5_VSUF)
+
+/** oriented volume of the \a k-th tetra of the batch */
+static inline double _MMG5_orvolLane(_MMG5_pTetBatch b,int k) {
+    double m00,m10,m20,m01,m11,m21,m02,m12,m22;
+
+    m00 = b->x[1][k] - b->x[0][k]; m01 = b->x[2][k] - b->x[0][k]; m02 = b->x[3][k] - b->x[0][k];
+    m10 = b->y[1][k] - b->y[0][k]; m11 = b->y[2][k] - b->y[0][k]; m12 = b->y[3][k] - b->y[0][k];
+    m20 = b->z[1][k] - b->z[0][k]; m21 = b->z[2][k] - b->z[0][k]; m22 = b->z[3][k] - b->z[0][k];
+
+    return( m02*(m10*m21 - m20*m11) -m12*(m00*m21-m20*m01) + m22*(m00*m11-m10*m01) );
+}
+
+/** quality of the \a k-th tetra of the batch */
+static inline double _MMG5_caltetLane(_MMG5_pTetBatch b,int k) {
+    double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
+    double     vol,v1,v2,v3,rap;
+
+    abx = b->x[1][k] - b->x[0][k];
+    aby = b->y[1][k] - b->y[0][k];
+    abz = b->z[1][k] - b->z[0][k];
+    rap = abx*abx + aby*aby + abz*abz;
+
+    acx = b->x[2][k] - b->x[0][k];
+    acy = b->y[2][k] - b->y[0][k];
+    acz = b->z[2][k] - b->z[0][k];
+    rap += acx*acx + acy*acy + acz*acz;
+
+    adx = b->x[3][k] - b->x[0][k];
+    ady = b->y[3][k] - b->y[0][k];
+    adz = b->z[3][k] - b->z[0][k];
+    rap += adx*adx + ady*ady + adz*adz;
+
+    v1  = acy*adz - acz*ady;
+    v2  = acz*adx - acx*adz;
+    v3  = acx*ady - acy*adx;
+    vol = abx * v1 + aby * v2 + abz * v3;
+    if ( vol < _MMG5_EPSD2 )  return(0.0);
+
+    bcx = b->x[2][k] - b->x[1][k];
+    bcy = b->y[2][k] - b->y[1][k];
+    bcz = b->z[2][k] - b->z[1][k];
+    rap += bcx*bcx + bcy*bcy + bcz*bcz;
+
+    bdx = b->x[3][k] - b->x[1][k];
+    bdy = b->y[3][k] - b->y[1][k];
+    bdz = b->z[3][k] - b->z[1][k];
+    rap += bdx*bdx + bdy*bdy + bdz*bdz;
+
+    cdx = b->x[3][k] - b->x[2][k];
+    cdy = b->y[3][k] - b->y[2][k];
+    cdz = b->z[3][k] - b->z[2][k];
+    rap += cdx*cdx + cdy*cdy + cdz*cdz;
+    if ( rap < _MMG5_EPSD2 )  return(0.0);
+
+    /* quality = vol / len^3/2 */
+    rap = rap * sqrt(rap);
+    return(vol / rap);
+}
+
+/** isotropic length of the \a k-th edge of the batch */
+static inline double _MMG5_lenedgLane(_MMG5_pEdgBatch b,int k) {
+    double   h1,h2,l,r;
+
+    h1 = b->h[0][k];
+    h2 = b->h[1][k];
+    l = (b->x[1][k]-b->x[0][k])*(b->x[1][k]-b->x[0][k])
+        + (b->y[1][k]-b->y[0][k])*(b->y[1][k]-b->y[0][k])
+        + (b->z[1][k]-b->z[0][k])*(b->z[1][k]-b->z[0][k]);
+    l = sqrt(l);
+    r = h2 / h1 - 1.0;
+    return( fabs(r) < _MMG5_EPS ? l / h1 : l / (h2-h1) * log(r+1.0) );
+}
+
+/* scalar kernels */
+static void _MMG5_orvol_scalar(_MMG5_pTetBatch b,double *vol) {
+    int k;
+    for (k=0; k<b->n; k++)  vol[k] = _MMG5_orvolLane(b,k);
+}
+static void _MMG5_caltet_scalar(_MMG5_pTetBatch b,double *qual) {
+    int k;
+    for (k=0; k<b->n; k++)  qual[k] = _MMG5_caltetLane(b,k);
+}
+static void _MMG5_lenedg_scalar(_MMG5_pEdgBatch b,double *len) {
+    int k;
+    for (k=0; k<b->n; k++)  len[k] = _MMG5_lenedgLane(b,k);
+}
+
+#ifdef _MMG5_SIMD_X86
+/* SSE2 kernels */
+#define _MMG5_VD          __m128d
+#define _MMG5_VW          2
+#define _MMG5_VTGT        __attribute__((target("sse2")))
+#define _MMG5_VSUF        _sse2
+#define _MMG5_VLOAD(p)    _mm_loadu_pd(p)
+#define _MMG5_VSTORE(p,a) _mm_storeu_pd(p,a)
+#define _MMG5_VSET1(x)    _mm_set1_pd(x)
+#define _MMG5_VADD(a,b)   _mm_add_pd(a,b)
+#define _MMG5_VSUB(a,b)   _mm_sub_pd(a,b)
+#define _MMG5_VMUL(a,b)   _mm_mul_pd(a,b)
+#define _MMG5_VDIV(a,b)   _mm_div_pd(a,b)
+#define _MMG5_VSQRT(a)    _mm_sqrt_pd(a)
+#define _MMG5_VZLT(q,a,b) _mm_andnot_pd(_mm_cmplt_pd(a,b),q)
+#include "simd_kernels.h"
+#undef _MMG5_VD
+#undef _MMG5_VW
+#undef _MMG5_VTGT
+#undef _MMG5_VSUF
+#undef _MMG5_VLOAD
+#undef _MMG5_VSTORE
+#undef _MMG5_VSET1
+#undef _MMG5_VADD
+#undef _MMG5_VSUB
+#undef _MMG5_VMUL
+#undef _MMG5_VDIV
+#undef _MMG5_VSQRT
+#undef _MMG5_VZLT
+
+/* AVX2 kernels */
+#define _MMG5_VD          __m256d
+#define _MMG5_VW          4
+#define _MMG5_VTGT        __attribute__((target("avx2")))
+#define _MMG5_VSUF        _avx2
+#define _MMG5_VLOAD(p)    _mm256_loadu_pd(p)
+#define _MMG5_VSTORE(p,a) _mm256_storeu_pd(p,a)
+#define _MMG5_VSET1(x)    _mm256_set1_pd(x)
+#define _MMG5_VADD(a,b)   _mm256_add_pd(a,b)
+#define _MMG5_VSUB(a,b)   _mm256_sub_pd(a,b)
+#define _MMG5_VMUL(a,b)   _mm256_mul_pd(a,b)
+#define _MMG5_VDIV(a,b)   _mm256_div_pd(a,b)
+#define _MMG5_VSQRT(a)    _mm256_sqrt_pd(a)
+#define _MMG5_VZLT(q,a,b) _mm256_andnot_pd(_mm256_cmp_pd(a,b,_CMP_LT_OQ),q)
+#include "simd_kernels.h"
+#undef _MMG5_VD
+#undef _MMG5_VW
+#undef _MMG5_VTGT
+#undef _MMG5_VSUF
+#undef _MMG5_VLOAD
+#undef _MMG5_VSTORE
+#undef _MMG5_VSET1
+#undef _MMG5_VADD
+#undef _MMG5_VSUB
+#undef _MMG5_VMUL
+#undef _MMG5_VDIV
+#undef _MMG5_VSQRT
+#undef _MMG5_VZLT
+
+/* AVX-512 kernels */
+#define _MMG5_VD          __m512d
+#define _MMG5_VW          8
+#define _MMG5_VTGT        __attribute__((target("avx512f")))
+#define _MMG5_VSUF        _avx512
+#define _MMG5_VLOAD(p)    _mm512_loadu_pd(p)
+#define _MMG5_VSTORE(p,a) _mm512_storeu_pd(p,a)
+#define _MMG5_VSET1(x)    _mm512_set1_pd(x)
+#define _MMG5_VADD(a,b)   _mm512_add_pd(a,b)
+#define _MMG5_VSUB(a,b)   _mm512_sub_pd(a,b)
+#define _MMG5_VMUL(a,b)   _mm512_mul_pd(a,b)
+#define _MMG5_VDIV(a,b)   _mm512_div_pd(a,b)
+#define _MMG5_VSQRT(a)    _mm512_sqrt_pd(a)
+#define _MMG5_VZLT(q,a,b)                                               \
+    _mm512_mask_mov_pd(q,_mm512_cmp_pd_mask(a,b,_CMP_LT_OQ),_mm512_setzero_pd())
+#include "simd_kernels.h"
+#undef _MMG5_VD
+#undef _MMG5_VW
+#undef _MMG5_VTGT
+#undef _MMG5_VSUF
+#undef _MMG5_VLOAD
+#undef _MMG5_VSTORE
+#undef _MMG5_VSET1
+#undef _MMG5_VADD
+#undef _MMG5_VSUB
+#undef _MMG5_VMUL
+#undef _MMG5_VDIV
+#undef _MMG5_VSQRT
+#undef _MMG5_VZLT
+#endif
+
+/** kernels of each instruction set */
+static const _MMG5_SimdKer _MMG5_simdKer[_MMG5_SIMD_AVX512+1] = {
+    { _MMG5_orvol_scalar,_MMG5_caltet_scalar,_MMG5_lenedg_scalar },
+#ifdef _MMG5_SIMD_X86
+    { _MMG5_orvol_sse2,  _MMG5_caltet_sse2,  _MMG5_lenedg_sse2   },
+    { _MMG5_orvol_avx2,  _MMG5_caltet_avx2,  _MMG5_lenedg_avx2   },
+    { _MMG5_orvol_avx512,_MMG5_caltet_avx512,_MMG5_lenedg_avx512 },
+#endif
+};
+
+/** kernels of the host CPU, only written by \ref _MMG5_simdHostInit */
+static const _MMG5_SimdKer *_MMG5_simdHost = &_MMG5_simdKer[_MMG5_SIMD_SCALAR];
+
+/**
+ * \param isa instruction set (\ref _MMG5_SIMD_SCALAR ...
+ * \ref _MMG5_SIMD_AVX512).
+ * \return 1 if the host CPU supports \a isa, 0 otherwise.
+ */
+static int _MMG5_simdSupports(int isa) {
+#ifdef _MMG5_SIMD_X86
+    switch ( isa ) {
+    case _MMG5_SIMD_SCALAR:  return(1);
+    case _MMG5_SIMD_SSE2:    return(__builtin_cpu_supports("sse2"));
+    case _MMG5_SIMD_AVX2:    return(__builtin_cpu_supports("avx2"));
+    case _MMG5_SIMD_AVX512:  return(__builtin_cpu_supports("avx512f"));
+    }
+    return(0);
+#else
+    return(isa == _MMG5_SIMD_SCALAR);
+#endif
+}
+
+#ifdef _MMG5_SIMD_X86
+/**
+ * Select the best instruction set of the host CPU. It runs once, when the
+ * library is loaded, thus the concurrent remeshings only read
+ * \ref _MMG5_simdHost.
+ *
+ */
+__attribute__((constructor))
+static void _MMG5_simdHostInit(void) {
+    int isa;
+
+    __builtin_cpu_init();
+    for (isa=_MMG5_SIMD_AVX512; isa>_MMG5_SIMD_SCALAR; isa--)
+        if ( _MMG5_simdSupports(isa) )  break;
+    _MMG5_simdHost = &_MMG5_simdKer[isa];
+}
+#endif
+
+/**
+ * \param isa instruction set (\ref _MMG5_SIMD_SCALAR ...
+ * \ref _MMG5_SIMD_AVX512).
+ * \return the kernels of \a isa, NULL if the host CPU does not support it.
+ *
+ * Kernels of a given instruction set, to compare them with the ones used by
+ * \ref _MMG5_batchOrvol, \ref _MMG5_batchCaltet and \ref _MMG5_batchLenedg.
+ *
+ */
+const _MMG5_SimdKer *_MMG5_simdKernels(int isa) {
+    if ( isa < _MMG5_SIMD_SCALAR || isa > _MMG5_SIMD_AVX512 )  return(NULL);
+    return( _MMG5_simdSupports(isa) ? &_MMG5_simdKer[isa] : NULL );
+}
+
+/**
+ * \param b batch of tetrahedra.
+ * \param vol computed oriented volumes (see \ref _MMG5_det4pt).
+ */
+void _MMG5_batchOrvol(_MMG5_pTetBatch b,double *vol) {
+    _MMG5_simdHost->orvol(b,vol);
+}
+
+/**
+ * \param b batch of tetrahedra.
+ * \param qual computed isotropic qualities (see \ref _MMG5_orcal).
+ */
+void _MMG5_batchCaltet(_MMG5_pTetBatch b,double *qual) {
+    _MMG5_simdHost->caltet(b,qual);
+}
+
+/**
+ * \param b batch of edges.
+ * \param len computed isotropic lengths (see \ref _MMG5_lenedg_iso).
+ */
+void _MMG5_batchLenedg(_MMG5_pEdgBatch b,double *len) {
+    _MMG5_simdHost->lenedg(b,len);
+}
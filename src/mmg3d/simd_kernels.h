@@ -0,0 +1,158 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/simd_kernels.h
+ * \brief Vectorized kernels, instantiated by simd.c for each instruction set.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by simd.c after the definition of the vector type
+ * \a _MMG5_VD, of its width \a _MMG5_VW, of the target attribute
+ * \a _MMG5_VTGT, of the suffix \a _MMG5_VSUF of the function names and of the
+ * vector operations. The operations are performed in the order of the
+ * scalar kernels so that the results are identical.
+ *
+ */
+
+/** oriented volumes of the tetra of the batch (see _MMG5_det4pt) */
+static _MMG5_VTGT
+void _MMG5_VNAME(orvol)(_MMG5_pTetBatch b,double *vol) {
+    _MMG5_VD   m00,m10,m20,m01,m11,m21,m02,m12,m22,det;
+    int        k,n;
+
+    n = b->n - b->n % _MMG5_VW;
+    for (k=0; k<n; k+=_MMG5_VW) {
+        m00 = _MMG5_VSUB(_MMG5_VLOAD(&b->x[1][k]),_MMG5_VLOAD(&b->x[0][k]));
+        m01 = _MMG5_VSUB(_MMG5_VLOAD(&b->x[2][k]),_MMG5_VLOAD(&b->x[0][k]));
+        m02 = _MMG5_VSUB(_MMG5_VLOAD(&b->x[3][k]),_MMG5_VLOAD(&b->x[0][k]));
+        m10 = _MMG5_VSUB(_MMG5_VLOAD(&b->y[1][k]),_MMG5_VLOAD(&b->y[0][k]));
+        m11 = _MMG5_VSUB(_MMG5_VLOAD(&b->y[2][k]),_MMG5_VLOAD(&b->y[0][k]));
+        m12 = _MMG5_VSUB(_MMG5_VLOAD(&b->y[3][k]),_MMG5_VLOAD(&b->y[0][k]));
+        m20 = _MMG5_VSUB(_MMG5_VLOAD(&b->z[1][k]),_MMG5_VLOAD(&b->z[0][k]));
+        m21 = _MMG5_VSUB(_MMG5_VLOAD(&b->z[2][k]),_MMG5_VLOAD(&b->z[0][k]));
+        m22 = _MMG5_VSUB(_MMG5_VLOAD(&b->z[3][k]),_MMG5_VLOAD(&b->z[0][k]));
+
+        det = _MMG5_VSUB(_MMG5_VMUL(m02,_MMG5_VSUB(_MMG5_VMUL(m10,m21),
+                                                   _MMG5_VMUL(m20,m11))),
+                         _MMG5_VMUL(m12,_MMG5_VSUB(_MMG5_VMUL(m00,m21),
+                                                   _MMG5_VMUL(m20,m01))));
+        det = _MMG5_VADD(det,_MMG5_VMUL(m22,_MMG5_VSUB(_MMG5_VMUL(m00,m11),
+                                                       _MMG5_VMUL(m10,m01))));
+        _MMG5_VSTORE(&vol[k],det);
+    }
+    for (; k<b->n; k++)  vol[k] = _MMG5_orvolLane(b,k);
+}
+
+/** qualities of the tetra of the batch (see _MMG5_caltet_iso) */
+static _MMG5_VTGT
+void _MMG5_VNAME(caltet)(_MMG5_pTetBatch b,double *qual) {
+    _MMG5_VD   abx,aby,abz,acx,acy,acz,adx,ady,adz,ux,uy,uz;
+    _MMG5_VD   vol,v1,v2,v3,rap;
+    int        k,n;
+
+#define _MMG5_VDIFF(u,c,i,j)                                            \
+    u = _MMG5_VSUB(_MMG5_VLOAD(&b->c[j][k]),_MMG5_VLOAD(&b->c[i][k]))
+#define _MMG5_VNORM2(ux,uy,uz)                                          \
+    _MMG5_VADD(_MMG5_VADD(_MMG5_VMUL(ux,ux),_MMG5_VMUL(uy,uy)),_MMG5_VMUL(uz,uz))
+
+    n = b->n - b->n % _MMG5_VW;
+    for (k=0; k<n; k+=_MMG5_VW) {
+        _MMG5_VDIFF(abx,x,0,1);
+        _MMG5_VDIFF(aby,y,0,1);
+        _MMG5_VDIFF(abz,z,0,1);
+        rap = _MMG5_VNORM2(abx,aby,abz);
+
+        _MMG5_VDIFF(acx,x,0,2);
+        _MMG5_VDIFF(acy,y,0,2);
+        _MMG5_VDIFF(acz,z,0,2);
+        rap = _MMG5_VADD(rap,_MMG5_VNORM2(acx,acy,acz));
+
+        _MMG5_VDIFF(adx,x,0,3);
+        _MMG5_VDIFF(ady,y,0,3);
+        _MMG5_VDIFF(adz,z,0,3);
+        rap = _MMG5_VADD(rap,_MMG5_VNORM2(adx,ady,adz));
+
+        v1  = _MMG5_VSUB(_MMG5_VMUL(acy,adz),_MMG5_VMUL(acz,ady));
+        v2  = _MMG5_VSUB(_MMG5_VMUL(acz,adx),_MMG5_VMUL(acx,adz));
+        v3  = _MMG5_VSUB(_MMG5_VMUL(acx,ady),_MMG5_VMUL(acy,adx));
+        vol = _MMG5_VADD(_MMG5_VADD(_MMG5_VMUL(abx,v1),_MMG5_VMUL(aby,v2)),
+                         _MMG5_VMUL(abz,v3));
+
+        _MMG5_VDIFF(ux,x,1,2);
+        _MMG5_VDIFF(uy,y,1,2);
+        _MMG5_VDIFF(uz,z,1,2);
+        rap = _MMG5_VADD(rap,_MMG5_VNORM2(ux,uy,uz));
+
+        _MMG5_VDIFF(ux,x,1,3);
+        _MMG5_VDIFF(uy,y,1,3);
+        _MMG5_VDIFF(uz,z,1,3);
+        rap = _MMG5_VADD(rap,_MMG5_VNORM2(ux,uy,uz));
+
+        _MMG5_VDIFF(ux,x,2,3);
+        _MMG5_VDIFF(uy,y,2,3);
+        _MMG5_VDIFF(uz,z,2,3);
+        rap = _MMG5_VADD(rap,_MMG5_VNORM2(ux,uy,uz));
+
+        /* quality = vol / len^3/2, 0 for the inverted or null elements */
+        v1 = _MMG5_VDIV(vol,_MMG5_VMUL(rap,_MMG5_VSQRT(rap)));
+        v1 = _MMG5_VZLT(v1,vol,_MMG5_VSET1(_MMG5_EPSD2));
+        v1 = _MMG5_VZLT(v1,rap,_MMG5_VSET1(_MMG5_EPSD2));
+        _MMG5_VSTORE(&qual[k],v1);
+    }
+#undef _MMG5_VDIFF
+#undef _MMG5_VNORM2
+
+    for (; k<b->n; k++)  qual[k] = _MMG5_caltetLane(b,k);
+}
+
+/** isotropic lengths of the edges of the batch (see _MMG5_lenedg_iso) */
+static _MMG5_VTGT
+void _MMG5_VNAME(lenedg)(_MMG5_pEdgBatch b,double *len) {
+    _MMG5_VD   ux,uy,uz,l,h1,h2,r;
+    double     sr[_MMG5_VW],sl[_MMG5_VW];
+    int        i,k,n;
+
+    n = b->n - b->n % _MMG5_VW;
+    for (k=0; k<n; k+=_MMG5_VW) {
+        ux = _MMG5_VSUB(_MMG5_VLOAD(&b->x[1][k]),_MMG5_VLOAD(&b->x[0][k]));
+        uy = _MMG5_VSUB(_MMG5_VLOAD(&b->y[1][k]),_MMG5_VLOAD(&b->y[0][k]));
+        uz = _MMG5_VSUB(_MMG5_VLOAD(&b->z[1][k]),_MMG5_VLOAD(&b->z[0][k]));
+        l  = _MMG5_VADD(_MMG5_VADD(_MMG5_VMUL(ux,ux),_MMG5_VMUL(uy,uy)),
+                        _MMG5_VMUL(uz,uz));
+        l  = _MMG5_VSQRT(l);
+        h1 = _MMG5_VLOAD(&b->h[0][k]);
+        h2 = _MMG5_VLOAD(&b->h[1][k]);
+        r  = _MMG5_VSUB(_MMG5_VDIV(h2,h1),_MMG5_VSET1(1.0));
+        _MMG5_VSTORE(&len[k],_MMG5_VDIV(l,h1));
+        _MMG5_VSTORE(sr,r);
+        _MMG5_VSTORE(sl,l);
+
+        /* varying size: scalar logarithm */
+        for (i=0; i<_MMG5_VW; i++) {
+            if ( fabs(sr[i]) < _MMG5_EPS )  continue;
+            len[k+i] = sl[i] / (b->h[1][k+i]-b->h[0][k+i]) * log(sr[i]+1.0);
+        }
+    }
+    for (; k<b->n; k++)  len[k] = _MMG5_lenedgLane(b,k);
+}
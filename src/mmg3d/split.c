@@ -35,8 +35,6 @@
 
 #include "mmg3d.h"
 
-extern char  ddb;
-
 /** Table that associates to each (even) permutation of the 4 vertices of a tetrahedron
  *  the corresponding permutation of its edges. Labels :
  *  0  : [0,1,2,3]
@@ -59,8 +57,132 @@ unsigned char permedge[12][6] = {
     {3,0,4,1,5,2}, {4,3,0,5,2,1}, {1,3,5,0,2,4}, {3,5,1,4,0,2},
     {5,1,3,2,4,0}, {2,5,4,1,0,3}, {4,2,5,0,3,1}, {5,4,2,3,1,0} };
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pend hash table of the faces waiting for their neighbour.
+ * \param v0 vertices of the tetra before the split.
+ * \param vx new points along the edges of the tetra (NULL if none).
+ * \param newtet tetras created by the split (\a newtet[0] is the splitted one).
+ * \param ntet number of tetras in \a newtet.
+ *
+ * Local update of the adjacency table after the split of a tetra. A face
+ * shared by two new tetras is paired inside the set, a face lying on a face
+ * of the initial tetra is paired with the neighbour across this face if it
+ * is unchanged, otherwise with the matching face of the neighbour split
+ * (stored in \a pend by the first split of the two). Such a face is marked
+ * by a -1 adjacency until it is paired. Nothing is done if the adjacency table
+ * is not allocated.
+ *
+ */
+static void
+_MMG5_splitAdja(MMG5_pMesh mesh,_MMG5_Hash *pend,MMG5_int v0[4],MMG5_int vx[6],
+                MMG5_int *newtet,int ntet) {
+    MMG5_pTetra   pt;
+    MMG5_int      adj0[4],fv[32][3],code[32],*adja,kk,w,tmp,ier;
+    int           j,l,m;
+    unsigned char msk[32],done[32],i,ii,ia;
+
+    if ( !mesh->adja )  return;
+    assert ( pend );
+    memcpy(adj0,&mesh->adja[4*(newtet[0]-1)+1],4*sizeof(MMG5_int));
+
+    /* pending faces of the initial tetra are replaced by the new ones */
+    for (i=0; i<4; i++) {
+        if ( adj0[i] >= 0 )  continue;
+        _MMG5_hashPendDel(pend,v0[_MMG5_idir[i][0]],v0[_MMG5_idir[i][1]],
+                          v0[_MMG5_idir[i][2]],4*newtet[0]+i);
+    }
+
+    /* sorted vertices of the faces and vertices of the initial tetra they hold */
+    for (l=0; l<ntet; l++) {
+        pt = &mesh->tetra[newtet[l]];
+        for (i=0; i<4; i++) {
+            m       = 4*l+i;
+            msk[m]  = 0;
+            done[m] = 0;
+            code[m] = 4*newtet[l]+i;
+            for (j=0; j<3; j++) {
+                w = pt->v[_MMG5_idir[i][j]];
+                fv[m][j] = w;
+                for (ii=0; ii<4; ii++)
+                    if ( w == v0[ii] )  break;
+                if ( ii < 4 ) {
+                    msk[m] |= 1<<ii;
+                    continue;
+                }
+                for (ia=0; vx && ia<6; ia++)
+                    if ( w == vx[ia] )  break;
+                if ( vx && ia < 6 )
+                    msk[m] |= (1<<_MMG5_iare[ia][0]) | (1<<_MMG5_iare[ia][1]);
+                else
+                    msk[m] = 15;
+            }
+            if ( fv[m][0] > fv[m][1] ) { tmp = fv[m][0]; fv[m][0] = fv[m][1]; fv[m][1] = tmp; }
+            if ( fv[m][1] > fv[m][2] ) { tmp = fv[m][1]; fv[m][1] = fv[m][2]; fv[m][2] = tmp; }
+            if ( fv[m][0] > fv[m][1] ) { tmp = fv[m][0]; fv[m][0] = fv[m][1]; fv[m][1] = tmp; }
+        }
+    }
+
+    for (m=0; m<4*ntet; m++) {
+        if ( done[m] )  continue;
+        done[m] = 1;
+        adja = &mesh->adja[4*(code[m]/4-1)+1];
+        adja[code[m]%4] = 0;
+
+        /* internal face */
+        if ( msk[m] == 15 ) {
+            for (l=m+1; l<4*ntet; l++) {
+                if ( done[l] || msk[l] != 15 )  continue;
+                if ( fv[l][0] == fv[m][0] && fv[l][1] == fv[m][1] && fv[l][2] == fv[m][2] )
+                    break;
+            }
+            if ( l < 4*ntet ) {
+                done[l] = 1;
+                adja[code[m]%4] = code[l];
+                mesh->adja[4*(code[l]/4-1)+1+code[l]%4] = code[m];
+            }
+            continue;
+        }
+
+        /* face lying on the face j of the initial tetra */
+        for (j=0; j<4; j++)
+            if ( !(msk[m] & (1<<j)) )  break;
+        if ( !adj0[j] )  continue;
+
+        if ( adj0[j] > 0 ) {
+            kk = adj0[j] / 4;
+            ii = adj0[j] % 4;
+            pt = &mesh->tetra[kk];
+            for (i=0; i<3; i++) {
+                w = pt->v[_MMG5_idir[ii][i]];
+                if ( w != fv[m][0] && w != fv[m][1] && w != fv[m][2] )  break;
+            }
+            if ( i == 3 ) {
+                adja[code[m]%4] = adj0[j];
+                mesh->adja[4*(kk-1)+1+ii] = code[m];
+                continue;
+            }
+        }
+
+        /* the neighbour is (or will be) splitted too */
+        ier = _MMG5_hashPendFace(mesh,pend,fv[m][0],fv[m][1],fv[m][2],code[m]);
+        if ( ier < 0 ) {
+            printf("  ## Error: unable to store a pending face.\n");
+            _MMG5_INCREASE_MEM_MESSAGE();
+            printf("  Exit program.\n");
+            exit(EXIT_FAILURE);
+        }
+        else if ( ier > 0 ) {
+            adja[code[m]%4] = ier;
+            mesh->adja[4*(ier/4-1)+1+ier%4] = code[m];
+        }
+        else
+            adja[code[m]%4] = -1;
+    }
+}
+
 /** simulate split 1 edge of tetra : return 0 if split leads to invalid situation, else 1 */
-int _MMG5_split1_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+int _MMG5_split1_sim(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6]) {
     MMG5_pTetra   pt,pt0;
     double   vold,vnew;
     unsigned char tau[4],*taued;
@@ -113,16 +235,17 @@ int _MMG5_split1_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
 }
 
 /** split 1 edge of tetra */
-void _MMG5_split1(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split1(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra   pt,pt1;
     MMG5_xTetra   xt,xt1;
     MMG5_pxTetra  pxt0;
-    int      iel;
+    MMG5_int iel,newtet[2],v0[4];
     char     i,isxt,isxt1;
     unsigned char tau[4],*taued;
 
     /* create a new tetra */
     pt  = &mesh->tetra[k];
+    memcpy(v0,pt->v,4*sizeof(MMG5_int));
     iel = _MMG5_newElt(mesh);
     if ( !iel ) {
         _MMG5_TETRA_REALLOC(mesh,iel,mesh->gap,
@@ -228,18 +351,23 @@ nextstep1:
         }
     }
     /* Quality update */
-    pt->qual=_MMG5_orcal(mesh,k);
-    pt1->qual=_MMG5_orcal(mesh,iel);
+    pt->qual=_MMG5_orcal(mesh,met,k);
+    pt1->qual=_MMG5_orcal(mesh,met,iel);
+
+    /* Adjacency update */
+    newtet[0] = k;  newtet[1] = iel;
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,2);
 }
 
 /** Simulate at the same time creation and bulging of one point, with new position o,
     to be inserted at an edge, whose shell is passed :
     return 0 if final position is invalid, 1 if all checks are ok */
-int _MMG5_simbulgept(MMG5_pMesh mesh,int *list,int ret,double o[3]) {
+int _MMG5_simbulgept(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,double o[3]) {
     MMG5_pTetra    pt,pt0;
     MMG5_pPoint    ppt0;
     double    calold,calnew,caltmp;
-    int       k,iel,ilist;
+    MMG5_int  iel;
+    int       k,ilist;
     char      ie,ia,ib;
 
     ilist = ret / 2;
@@ -260,13 +388,13 @@ int _MMG5_simbulgept(MMG5_pMesh mesh,int *list,int ret,double o[3]) {
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[ia] = 0;
         calold = MG_MIN(calold,pt->qual);
-        caltmp = _MMG5_orcal(mesh,0);
+        caltmp = _MMG5_orcal(mesh,met,0);
         if ( caltmp < _MMG5_EPSD )  return(0);
         calnew = MG_MIN(calnew,caltmp);
 
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[ib] = 0;
-        caltmp = _MMG5_orcal(mesh,0);
+        caltmp = _MMG5_orcal(mesh,met,0);
         if ( caltmp < _MMG5_EPSD )  return(0);
         calnew = MG_MIN(calnew,caltmp);
     }
@@ -279,12 +407,13 @@ int _MMG5_simbulgept(MMG5_pMesh mesh,int *list,int ret,double o[3]) {
 
 /** Split edge list[0]%6, whose shell list is passed, introducing point ip
     Beware : shell has to be enumerated in ONLY ONE TRAVEL (always same sense) */
-int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int cas){
+int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,MMG5_int *list, int ret, MMG5_int ip,int cas){
     MMG5_pTetra         pt,pt1;
     MMG5_xTetra         xt,xt1;
     MMG5_pxTetra        pxt0;
-    int            ilist,k,open,iel,jel,*newtet,nump,*adja,j;
-    int            *adjan,nei2,nei3,mel;
+    MMG5_int       iel,jel,*newtet,nump,*adja;
+    int            ilist,k,open,j;
+    MMG5_int       *adjan,nei2,nei3,mel;
     char           ie,tau[4],isxt,isxt1,i,voy;
     unsigned char  *taued;
     double         lmin,lmax,len;
@@ -320,7 +449,7 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
         if ( j < ilist )  return(0);
     }
 
-    _MMG5_SAFE_CALLOC(newtet,ilist,int);
+    _MMG5_SAFE_CALLOC(newtet,ilist,MMG5_int);
 
     iel = list[0] / 6;
     ie  = list[0] % 6;
@@ -360,7 +489,7 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
                           _MMG5_INCREASE_MEM_MESSAGE();
                           k--;
                           for ( ; k>=0 ; --k ) {
-                              _MMG5_delElt(mesh,abs(newtet[k]));
+                              _MMG5_delElt(mesh,MG_ABS(newtet[k]));
                           }
                           return(-1));
             pt  = &mesh->tetra[iel];
@@ -495,8 +624,8 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
             adjan[voy] = 4*jel + tau[0];
         }
         /* Quality update */
-        pt->qual=_MMG5_orcal(mesh,iel);
-        pt1->qual=_MMG5_orcal(mesh,jel);
+        pt->qual=_MMG5_orcal(mesh,met,iel);
+        pt1->qual=_MMG5_orcal(mesh,met,jel);
 
         _MMG5_SAFE_FREE(newtet);
         return(1);
@@ -785,8 +914,8 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
             adjan[voy] = 4*jel + tau[0];
         }
         /* Quality update */
-        pt->qual=_MMG5_orcal(mesh,iel);
-        pt1->qual=_MMG5_orcal(mesh,jel);
+        pt->qual=_MMG5_orcal(mesh,met,iel);
+        pt1->qual=_MMG5_orcal(mesh,met,jel);
     }
 
     _MMG5_SAFE_FREE(newtet);
@@ -794,7 +923,7 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
 }
 
 /** Simulate split of two edges that belong to a common face */
-int _MMG5_split2sf_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
+int _MMG5_split2sf_sim(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6]){
     MMG5_pTetra        pt,pt0;
     double   vold,vnew;
     unsigned char tau[4],*taued,imin;
@@ -895,12 +1024,14 @@ int _MMG5_split2sf_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
 }
 
 /** Split of two edges that belong to a common face : 1 tetra becomes 3 */
-void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
+void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend){
     MMG5_pTetra        pt[3];
     MMG5_xTetra        xt[3];
     MMG5_pxTetra       pxt0;
-    int           iel,i;
-    int           newtet[3];
+    MMG5_int  iel;
+    int       i;
+    MMG5_int  newtet[3];
+    MMG5_int  v0[4];
     char          flg,imin,firstxt,isxt[3];
     unsigned char tau[4],*taued;
 
@@ -908,6 +1039,7 @@ void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
     flg   = pt[0]->flag;
     pt[0]->flag = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     iel = _MMG5_newElt(mesh);
     if ( !iel ) {
@@ -1099,19 +1231,23 @@ void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
         }
     }
     /* Quality update */
-    pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-    pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-    pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
+    pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+    pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+    pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
 
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,3);
 }
 
 /** Split of two OPPOSITE edges */
-void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra   pt[4];
     MMG5_xTetra   xt[4];
     MMG5_pxTetra  pxt0;
-    int      i,iel;
-    int      newtet[4];
+    MMG5_int  iel;
+    int       i;
+    MMG5_int  newtet[4];
+    MMG5_int  v0[4];
     char     flg,firstxt,isxt[4];
     unsigned char tau[4],*taued;
 
@@ -1119,6 +1255,7 @@ void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     flg   = pt[0]->flag;
     pt[0]->flag = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     iel = _MMG5_newElt(mesh);
     if ( !iel ) {
@@ -1289,15 +1426,17 @@ void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     /* Quality update */
-    pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-    pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-    pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-    pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+    pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+    pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+    pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+    pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,4);
 }
 
 /** Simulate split of 1 face (3 edges) */
-int _MMG5_split3_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+int _MMG5_split3_sim(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6]) {
     MMG5_pTetra    pt,pt0;
     double    vold,vnew;
     unsigned char tau[4],*taued;
@@ -1358,12 +1497,14 @@ int _MMG5_split3_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
 }
 
 /** 1 face (3 edges) subdivided */
-void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra    pt[4];
     MMG5_xTetra    xt[4];
     MMG5_pxTetra   pxt0;
-    int       iel,i;
-    int       newtet[4];
+    MMG5_int  iel;
+    int       i;
+    MMG5_int  newtet[4];
+    MMG5_int  v0[4];
     char      flg,firstxt,isxt[4];
     unsigned char tau[4],*taued;
 
@@ -1371,6 +1512,7 @@ void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     flg   = pt[0]->flag;
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     /* create 3 new tetras */
     iel = _MMG5_newElt(mesh);
@@ -1540,20 +1682,24 @@ void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     /* Quality update */
-    pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-    pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-    pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-    pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+    pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+    pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+    pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+    pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,4);
 }
 
 /** Split 3 edge in cone configuration */
-void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra    pt[4];
     MMG5_xTetra    xt[4];
     MMG5_pxTetra   pxt0;
-    int       iel,i;
-    int       newtet[4];
+    MMG5_int  iel;
+    int       i;
+    MMG5_int  newtet[4];
+    MMG5_int  v0[4];
     char      flg,firstxt,isxt[4],ia,ib;
     unsigned char tau[4],*taued;
 
@@ -1561,6 +1707,7 @@ void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     flg = pt[0]->flag;
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     /* create 3 new tetras */
     iel = _MMG5_newElt(mesh);
@@ -1882,20 +2029,23 @@ void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     /* Quality update */
-    pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-    pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-    pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-    pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+    pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+    pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+    pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+    pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,4);
 }
 
-void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, int k, int vx[6]){
+void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, MMG5_int k, MMG5_int vx[6],_MMG5_Hash *pend){
     MMG5_pTetra        pt[5];
     MMG5_xTetra        xt[5];
     MMG5_pxTetra       pxt0;
     char          flg;
-    int           iel;
-    int           newtet[5];
+    MMG5_int  iel;
+    MMG5_int  newtet[5];
+    MMG5_int  v0[4];
     unsigned char imin12,imin03,tau[4],*taued,sym[4],symed[6],ip0,ip1,ip2,ip3,ie0,ie1;
     unsigned char ie2,ie3,ie4,ie5,isxt[5],firstxt,i;
 
@@ -1903,6 +2053,7 @@ void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, int k, int vx[6]){
     flg = pt[0]->flag;
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     // To avoid warning about potentially uninitialized value for newtet[4]
     newtet[4] = 0;
@@ -2430,46 +2581,55 @@ void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, int k, int vx[6]){
         }
     }
     /* Quality update */
-    pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-    pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-    pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-    pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+    pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+    pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+    pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+    pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
     if ( !((imin12 == ip1) && (imin03 == ip3)) ) {
-        pt[4]->qual=_MMG5_orcal(mesh,newtet[4]);
+        pt[4]->qual=_MMG5_orcal(mesh,met,newtet[4]);
     }
 
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,
+                    ((imin12 == ip1) && (imin03 == ip3)) ? 4 : 5);
 }
 
 /** Split a tetra in 4 tetras by introducing its barycenter
     FOR NOW : flags, that tell which edge should be split, are not updated (erased) : UPDATE NEEDED ?*/
-int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
+int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, MMG5_int k,_MMG5_Hash *pend) {
     MMG5_pTetra   pt[4];
     MMG5_pPoint   ppt;
     MMG5_xTetra   xt[4];
     MMG5_pxTetra  pxt0;
-    double   o[3],hnew;
-    int      i,ib,iel;
-    int      newtet[4];
+    double   o[3],hnew[6];
+    MMG5_int  ib,iel;
+    int       i,j;
+    MMG5_int  newtet[4];
+    MMG5_int  v0[4];
     unsigned char isxt[4],firstxt;
 
     pt[0] = &mesh->tetra[k];
     pt[0]->flag = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     o[0] = o[1] = o[2] = 0.0;
-    hnew = 0.0;
+    memset(hnew,0,6*sizeof(double));
     for (i=0; i<4; i++) {
         ib    = pt[0]->v[i];
         ppt   = &mesh->point[ib];
         o[0] += ppt->c[0];
         o[1] += ppt->c[1];
         o[2] += ppt->c[2];
-        if ( met->m )  hnew += met->m[ib];
+        if ( met->m ) {
+            for (j=0; j<met->size; j++)
+                hnew[j] += met->m[(ib-1)*met->size+1+j];
+        }
     }
     o[0] *= 0.25;
     o[1] *= 0.25;
     o[2] *= 0.25;
-    hnew *= 0.25;
+    for (j=0; j<6; j++)  hnew[j] *= 0.25;
 
     ib = _MMG5_newPt(mesh,o,0);
     if ( !ib ) {
@@ -2479,7 +2639,8 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
                       return(0)
                       ,o,0);
     }
-    if ( met->m )  met->m[ib] = hnew;
+    if ( met->m )
+        memcpy(&met->m[(ib-1)*met->size+1],hnew,met->size*sizeof(double));
 
     /* create 3 new tetras */
     iel = _MMG5_newElt(mesh);
@@ -2634,21 +2795,26 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
         }
     }
     /* Quality update */
-    pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-    pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-    pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-    pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+    pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+    pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+    pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+    pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
+
+
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,NULL,newtet,4);
 
     return(1);
 }
 
 /** Split 4 edges in a configuration when 3 lie on the same face */
-void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra    pt[6];
     MMG5_xTetra    xt[6];
     MMG5_pxTetra   pxt0;
-    int       iel;
-    int       newtet[6];
+    MMG5_int  iel;
+    MMG5_int  newtet[6];
+    MMG5_int  v0[4];
     char      flg,firstxt,isxt[6],imin12,imin23,j,i;
     unsigned char tau[4],*taued;
 
@@ -2656,6 +2822,7 @@ void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     flg = pt[0]->flag;
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     /* Set permutation of vertices : reference configuration : 23 */
     tau[0] = 0 ; tau[1] = 1 ; tau[2] = 2 ; tau[3] = 3;
@@ -2915,17 +3082,21 @@ void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     for (i=0; i<6; i++) {
-        pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+        pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
+
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,6);
 }
 
 /** Split 4 edges in a configuration when no 3 edges lie on the same face */
-void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra        pt[6];
     MMG5_xTetra        xt[6];
     MMG5_pxTetra       pxt0;
-    int           iel;
-    int           newtet[6];
+    MMG5_int  iel;
+    MMG5_int  newtet[6];
+    MMG5_int  v0[4];
     char          flg,firstxt,isxt[6],i,j,imin01,imin23;
     unsigned char tau[4],*taued;
 
@@ -2933,6 +3104,7 @@ void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     flg = pt[0]->flag;
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     /* Set permutation of vertices : reference configuration 30 */
     tau[0] = 0 ; tau[1] = 1 ; tau[2] = 2 ; tau[3] = 3;
@@ -3165,17 +3337,22 @@ void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     for (i=0; i<6; i++) {
-        pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+        pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
+
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,6);
 }
 
 /** Split 5 edges */
-void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra    pt[7];
     MMG5_xTetra    xt[7];
     MMG5_pxTetra   pxt0;
-    int       iel,i,j;
-    int       newtet[7];
+    MMG5_int  iel;
+    int       i,j;
+    MMG5_int  newtet[7];
+    MMG5_int  v0[4];
     char      flg,firstxt,isxt[7],imin;
     unsigned char tau[4],*taued;
 
@@ -3183,6 +3360,7 @@ void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     flg = pt[0]->flag;
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     /* create 6 new tetras */
     for (i=1; i<7; i++) {
@@ -3414,22 +3592,28 @@ void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     for (i=0; i<7; i++) {
-        pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+        pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
+
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,7);
 }
 
 /** split all faces (6 edges) */
-void _MMG5_split6(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
+void _MMG5_split6(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int k,MMG5_int vx[6],_MMG5_Hash *pend) {
     MMG5_pTetra    pt[8];
     MMG5_xTetra    xt0,xt;
     MMG5_pxTetra   pxt;
-    int       i,j,iel,nxt0;
-    int       newtet[8];
+    MMG5_int  iel,nxt0;
+    int       i,j;
+    MMG5_int  newtet[8];
+    MMG5_int  v0[4];
     char      isxt0,isxt;
 
     pt[0]  = &mesh->tetra[k];
     pt[0]->flag  = 0;
     newtet[0]=k;
+    memcpy(v0,pt[0]->v,4*sizeof(MMG5_int));
 
     nxt0 = pt[0]->xt;
     pxt = &mesh->xtetra[nxt0];
@@ -3771,6 +3955,9 @@ void _MMG5_split6(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
         }
     }
     for (i=0; i<8; i++) {
-        pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+        pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
+
+    /* Adjacency update */
+    _MMG5_splitAdja(mesh,pend,v0,vx,newtet,8);
 }
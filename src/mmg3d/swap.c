@@ -34,10 +34,9 @@
 
 #include "mmg3d.h"
 
-extern char ddb;
-
 /**
  * \param mesh pointer toward the mesh structure
+ * \param met pointer toward the metric structure
  * \param list pointer toward the shell of the edge
  * \param ilist pointer toward the size of the shell of the edge
  * \param it1 first element of the open shell
@@ -49,14 +48,15 @@ extern char ddb;
  * provided).
  *
  */
-int _MMG5_chkswpbdy(MMG5_pMesh mesh,int *list,int ilist,int it1,int it2) {
+int _MMG5_chkswpbdy(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ilist,MMG5_int it1,MMG5_int it2) {
     MMG5_pTetra   pt,pt0;
     MMG5_pxTetra  pxt;
     MMG5_pPoint   p0,p1,ppt0;
     MMG5_Tria     tt1,tt2;
     double   b0[3],b1[3],v[3],c[3],ux,uy,uz,ps,disnat,dischg;
     double   cal1,cal2,calnat,calchg,calold,calnew,caltmp,hausd;
-    int      iel,iel1,iel2,np,nq,na1,na2,k,nminus,nplus;
+    MMG5_int iel,iel1,iel2,np,nq,na1,na2;
+    int      k,nminus,nplus;
     char     ifa1,ifa2,ia,ip,iq,ia1,ia2,j,isshell;
     MMG5_pPar     par;
 
@@ -214,19 +214,19 @@ int _MMG5_chkswpbdy(MMG5_pMesh mesh,int *list,int ilist,int it1,int it2) {
 
         /* 2 elts resulting from split and collapse */
         pt0->v[ip] = 0;
-        if ( _MMG5_orcal(mesh,0) < _MMG5_NULKAL )  return(0);
+        if ( _MMG5_orcal(mesh,met,0) < _MMG5_NULKAL )  return(0);
         if ( !isshell ) {
             pt0->v[ip] = na1;
-            caltmp = _MMG5_orcal(mesh,0);
+            caltmp = _MMG5_orcal(mesh,met,0);
             calnew = MG_MIN(calnew,caltmp);
         }
         memcpy(pt0,pt,sizeof(MMG5_Tetra));
         pt0->v[iq] = 0;
-        if ( _MMG5_orcal(mesh,0) < _MMG5_NULKAL )  return(0);
+        if ( _MMG5_orcal(mesh,met,0) < _MMG5_NULKAL )  return(0);
 
         if ( !isshell ) {
             pt0->v[iq] = na1;
-            caltmp = _MMG5_orcal(mesh,0);
+            caltmp = _MMG5_orcal(mesh,met,0);
             calnew = MG_MIN(calnew,caltmp);
         }
     }
@@ -248,15 +248,16 @@ int _MMG5_chkswpbdy(MMG5_pMesh mesh,int *list,int ilist,int it1,int it2) {
  * Swap boundary edge whose shell is provided.
  *
  */
-int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,_MMG5_pBucket bucket) {
+int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int *list,int ret,MMG5_int it1,_MMG5_pBucket bucket) {
     MMG5_pTetra   pt,pt1;
     MMG5_pPoint   p0,p1;
-    int      iel,iel1,ilist,np,nq,nm;
+    MMG5_int iel,iel1,np,nq,nm;
+    int      ilist;
     double   c[3];
     char     ia,iface1,j,ipa,im;
-    int      ier;
+    MMG5_int ier;
 #ifndef NDEBUG
-    int      na;
+    MMG5_int na;
 #endif
 
     iel = list[0] / 6;
@@ -310,7 +311,7 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,_MMG5_p
                           ,c,MG_BDY);
         }
     }
-    if ( met->m )  met->m[nm] = 0.5 *(met->m[np]+met->m[nq]);
+    if ( met->m )  _MMG5_intmet(mesh,met,np,nq,nm,0.5);
     ier = _MMG5_split1b(mesh,met,list,ret,nm,0);
     /* pointer adress may change if we need to realloc memory during split */
     pt  = &mesh->tetra[iel];
@@ -323,7 +324,7 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,_MMG5_p
     else if ( !ier )  return(0);
 
     /* Collapse m on na after taking (new) ball of m */
-    memset(list,0,(_MMG5_LMAX+2)*sizeof(int));
+    memset(list,0,(_MMG5_LMAX+2)*sizeof(MMG5_int));
     for (j=0; j<3; j++) {
         im = _MMG5_idir[iface1][j];
         if ( pt1->v[im] == nm )  break;
@@ -338,7 +339,7 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,_MMG5_p
     assert(list[0]/4 == iel1);
     assert(pt1->v[ipa] == na);
 
-    ier = _MMG5_colver(mesh,list,ilist,ipa);
+    ier = _MMG5_colver(mesh,met,list,ilist,ipa);
     if ( ier < 0 ) {
         fprintf(stdout,"  ## Warning: unable to swap boundary edge.\n");
         return(-1);
@@ -348,5 +349,5 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,_MMG5_p
         ier = 1;
     }
 
-    return(ier);
+    return((int)ier);
 }
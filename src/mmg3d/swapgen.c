@@ -33,9 +33,19 @@
  */
 
 #include "mmg3d.h"
+#include "metric_kernels.h"
+
+#define _MMG5_TMET iso
+#include "swapgen_tpl.h"
+#undef  _MMG5_TMET
+
+#define _MMG5_TMET ani
+#include "swapgen_tpl.h"
+#undef  _MMG5_TMET
 
 /**
  * \param mesh pointer toward the mesh structure
+ * \param met pointer toward the metric structure
  * \param start tetrahedra in which the swap should be performed
  * \param ia edge that we want to swap
  * \param ilist pointer to store the size of the shell of the edge
@@ -44,145 +54,13 @@
  * \return 0 if fail, the index of point corresponding to the swapped
  * configuration otherwise (\f$4*k+i\f$).
  *
- * Check whether swap of edge \a ia in \a start should be performed, and
- * return \f$4*k+i\f$ the index of point corresponding to the swapped
- * configuration. The shell of edge is built during the process.
+ * Call the instance of \ref _MMG5_chkswpgen_iso matching the metric type.
  *
  */
-int _MMG5_chkswpgen(MMG5_pMesh mesh,int start,int ia,int *ilist,int *list,double crit) {
-    MMG5_pTetra    pt,pt0;
-    MMG5_pPoint    p0;
-    double    calold,calnew,caltmp;
-    int       na,nb,np,adj,piv,npol,refdom,k,l,iel;
-    int       *adja,pol[_MMG5_LMAX+2];
-    char      i,ipa,ipb,ip,ier;
-
-    pt  = &mesh->tetra[start];
-    refdom = pt->ref;
-
-    pt0 = &mesh->tetra[0];
-    na  = pt->v[_MMG5_iare[ia][0]];
-    nb  = pt->v[_MMG5_iare[ia][1]];
-    calold = pt->qual;
-
-
-    /* Store shell of ia in list, and associated pseudo polygon in pol */
-    (*ilist) = 0;
-    npol = 0;
-    list[(*ilist)] = 6*start+ia;
-    (*ilist)++;
-    adja = &mesh->adja[4*(start-1)+1];
-    adj  = adja[_MMG5_ifar[ia][0]] / 4;      // start travelling by face (ia,0)
-    piv  = pt->v[_MMG5_ifar[ia][1]];
-    pol[npol] = 4*start + _MMG5_ifar[ia][1];
-    npol++;
-
-    while ( adj && adj != start ) {
-        pt = &mesh->tetra[adj];
-        if ( pt->tag & MG_REQ ) return(0);
-
-        /* Edge is on a boundary between two different domains */
-        if ( pt->ref != refdom )  return(0);
-        calold = MG_MIN(calold, pt->qual);
-        /* identification of edge number in tetra adj */
-        for (i=0; i<6; i++) {
-            ipa = _MMG5_iare[i][0];
-            ipb = _MMG5_iare[i][1];
-            if ( (pt->v[ipa] == na && pt->v[ipb] == nb) ||
-                 (pt->v[ipa] == nb && pt->v[ipb] == na))  break;
-        }
-        assert(i<6);
-        list[(*ilist)] = 6*adj +i;
-        (*ilist)++;
-        /* overflow */
-        if ( (*ilist) > _MMG5_LMAX-3 )  return(0);
-
-        /* set new triangle for travel */
-        adja = &mesh->adja[4*(adj-1)+1];
-        if ( pt->v[ _MMG5_ifar[i][0] ] == piv ) {
-            pol[npol] = 4*adj + _MMG5_ifar[i][1];
-            npol++;
-            adj = adja[ _MMG5_ifar[i][0] ] / 4;
-            piv = pt->v[ _MMG5_ifar[i][1] ];
-        }
-        else {
-            assert(pt->v[ _MMG5_ifar[i][1] ] == piv);
-            pol[npol] = 4*adj + _MMG5_ifar[i][0];
-            npol++;
-            adj = adja[ _MMG5_ifar[i][1] ] /4;
-            piv = pt->v[ _MMG5_ifar[i][0] ];
-        }
-    }
-    //CECILE : je vois pas pourquoi ca ameliore de faire ce test
-    //plus rapide mais du coup on elimine des swap...
-    //4/01/14 commentaire
-    //if ( calold*_MMG5_ALPHAD > 0.5 )  return(0);
-
-    /* Prevent swap of an external boundary edge */
-    if ( !adj )  return(0);
-
-    assert(npol == (*ilist)); // du coup, apres on pourra virer npol
-
-    /* Find a configuration that enhances the worst quality within the shell */
-    for (k=0; k<npol; k++) {
-        iel = pol[k] / 4;
-        ip  = pol[k] % 4;
-        np  = mesh->tetra[iel].v[ip];
-        calnew = 1.0;
-        ier = 1;
-
-        if ( mesh->info.fem ) {
-            p0 = &mesh->point[np];
-            if ( p0->tag & MG_BDY ) {
-                for (l=0; l<npol;l++) {
-                    if ( k < npol-1 ) {
-                        if ( l == k || l == k+1 )  continue;
-                    }
-                    else {
-                        if ( l == npol-1 || l == 0 )  continue;
-                    }
-                    iel = pol[l] / 4;
-                    ip  = pol[l] % 4;
-                    pt = &mesh->tetra[iel];
-                    p0 = &mesh->point[pt->v[ip]];
-                    if ( p0->tag & MG_BDY ) {
-                        ier = 0;
-                        break;
-                    }
-                }
-            }
-            if ( !ier )  continue;
-            ier = 1;
-        }
-
-        for (l=0; l<(*ilist); l++) {
-            /* Do not consider tets of the shell of collapsed edge */
-            if ( k < npol-1 ) {
-                if ( l == k || l == k+1 )  continue;
-            }
-            else {
-                if ( l == npol-1 || l == 0 )  continue;
-            }
-            iel = list[l] / 6;
-            i   = list[l] % 6;
-            pt  = &mesh->tetra[iel];
-
-            /* First tetra obtained from iel */
-            memcpy(pt0,pt,sizeof(MMG5_Tetra));
-            pt0->v[_MMG5_iare[i][0]] = np;
-            caltmp = _MMG5_orcal(mesh,0);
-            calnew = MG_MIN(calnew,caltmp);
-            /* Second tetra obtained from iel */
-            memcpy(pt0,pt,sizeof(MMG5_Tetra));
-            pt0->v[_MMG5_iare[i][1]] = np;
-            caltmp = _MMG5_orcal(mesh,0);
-            calnew = MG_MIN(calnew,caltmp);
-            ier = (calnew > crit*calold);
-            if ( !ier )  break;
-        }
-        if ( ier )  return(pol[k]);
-    }
-    return(0);
+MMG5_int _MMG5_chkswpgen(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int start,int ia,int *ilist,MMG5_int *list,double crit) {
+    if ( met->size < 6 )
+        return(_MMG5_chkswpgen_iso(mesh,met,start,ia,ilist,list,crit));
+    return(_MMG5_chkswpgen_ani(mesh,met,start,ia,ilist,list,crit));
 }
 
 /**
@@ -199,13 +77,14 @@ int _MMG5_chkswpgen(MMG5_pMesh mesh,int start,int ia,int *ilist,int *list,double
  * Perform swap of edge whose shell is passed according to configuration nconf.
  *
  */
-int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,_MMG5_pBucket bucket) {
+int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int nconf,int ilist,MMG5_int *list,_MMG5_pBucket bucket) {
     MMG5_pTetra    pt;
     MMG5_pPoint    p0,p1;
-    int       iel,na,nb,np,nball,ret,start;
+    MMG5_int  iel,na,nb,np,start;
+    int       nball,ret;
     double    m[3];
     char      ia,ip,iq;
-    int       ier;
+    MMG5_int  ier;
 
     iel = list[0] / 6;
     ia  = list[0] % 6;
@@ -238,7 +117,7 @@ int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,_MM
                           ,m,0);
         }
     }
-    if ( met->m )  met->m[np] = 0.5*(met->m[na]+met->m[nb]);
+    if ( met->m )  _MMG5_intmet(mesh,met,na,nb,np,0.5);
 
     /** First step : split of edge (na,nb) */
     ret = 2*ilist + 0;
@@ -262,10 +141,10 @@ int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,_MM
     }
     assert(ip<4);
 
-    memset(list,0,(_MMG5_LMAX+2)*sizeof(int));
+    memset(list,0,(_MMG5_LMAX+2)*sizeof(MMG5_int));
     nball = _MMG5_boulevolp(mesh,start,ip,list);
 
-    ier = _MMG5_colver(mesh,list,nball,iq);
+    ier = _MMG5_colver(mesh,met,list,nball,iq);
     if ( ier < 0 ) {
         fprintf(stdout,"  ## Warning: unable to swap internal edge.\n");
         return(-1);
@@ -0,0 +1,217 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/swapgen_tpl.h
+ * \brief Check of the swaps of swapgen.c, instantiated for each metric type.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by swapgen.c after the definition of
+ * \a _MMG5_TMET (see metric_kernels.h).
+ *
+ */
+
+/**
+ * \param mesh pointer toward the mesh structure
+ * \param met pointer toward the metric structure
+ * \param start tetrahedra in which the swap should be performed
+ * \param ia edge that we want to swap
+ * \param ilist pointer to store the size of the shell of the edge
+ * \param list pointer to store the shell of the edge
+ * \param crit improvment coefficient
+ * \return 0 if fail, the index of point corresponding to the swapped
+ * configuration otherwise (\f$4*k+i\f$).
+ *
+ * Check whether swap of edge \a ia in \a start should be performed, and
+ * return \f$4*k+i\f$ the index of point corresponding to the swapped
+ * configuration. The shell of edge is built during the process.
+ *
+ */
+MMG5_int _MMG5_TNAME(_MMG5_chkswpgen)(MMG5_pMesh mesh,MMG5_pSol met,MMG5_int start,int ia,int *ilist,MMG5_int *list,double crit) {
+    MMG5_pTetra    pt;
+    MMG5_pPoint    p0;
+#if _MMG5_TBATCH
+    _MMG5_TetBatch b;
+    double    qual[_MMG5_BATCH],*c[4];
+    int       j;
+#else
+    MMG5_int  v[4];
+#endif
+    double    calold,calnew;
+    MMG5_int  na,nb,np,adj,piv,iel;
+    int       npol,refdom,k,l;
+    MMG5_int  *adja,pol[_MMG5_LMAX+2];
+    char      i,ipa,ipb,ip,ier;
+
+    pt  = &mesh->tetra[start];
+    refdom = pt->ref;
+
+    na  = pt->v[_MMG5_iare[ia][0]];
+    nb  = pt->v[_MMG5_iare[ia][1]];
+    calold = pt->qual;
+
+
+    /* Store shell of ia in list, and associated pseudo polygon in pol */
+    (*ilist) = 0;
+    npol = 0;
+    list[(*ilist)] = 6*start+ia;
+    (*ilist)++;
+    adja = &mesh->adja[4*(start-1)+1];
+    adj  = adja[_MMG5_ifar[ia][0]] / 4;      // start travelling by face (ia,0)
+    piv  = pt->v[_MMG5_ifar[ia][1]];
+    pol[npol] = 4*start + _MMG5_ifar[ia][1];
+    npol++;
+
+    while ( adj && adj != start ) {
+        pt = &mesh->tetra[adj];
+        if ( pt->tag & MG_REQ ) return(0);
+
+        /* Edge is on a boundary between two different domains */
+        if ( pt->ref != refdom )  return(0);
+        calold = MG_MIN(calold, pt->qual);
+        /* identification of edge number in tetra adj */
+        for (i=0; i<6; i++) {
+            ipa = _MMG5_iare[i][0];
+            ipb = _MMG5_iare[i][1];
+            if ( (pt->v[ipa] == na && pt->v[ipb] == nb) ||
+                 (pt->v[ipa] == nb && pt->v[ipb] == na))  break;
+        }
+        assert(i<6);
+        list[(*ilist)] = 6*adj +i;
+        (*ilist)++;
+        /* overflow */
+        if ( (*ilist) > _MMG5_LMAX-3 )  return(0);
+
+        /* set new triangle for travel */
+        adja = &mesh->adja[4*(adj-1)+1];
+        if ( pt->v[ _MMG5_ifar[i][0] ] == piv ) {
+            pol[npol] = 4*adj + _MMG5_ifar[i][1];
+            npol++;
+            adj = adja[ _MMG5_ifar[i][0] ] / 4;
+            piv = pt->v[ _MMG5_ifar[i][1] ];
+        }
+        else {
+            assert(pt->v[ _MMG5_ifar[i][1] ] == piv);
+            pol[npol] = 4*adj + _MMG5_ifar[i][0];
+            npol++;
+            adj = adja[ _MMG5_ifar[i][1] ] /4;
+            piv = pt->v[ _MMG5_ifar[i][0] ];
+        }
+    }
+    //CECILE : je vois pas pourquoi ca ameliore de faire ce test
+    //plus rapide mais du coup on elimine des swap...
+    //4/01/14 commentaire
+    //if ( calold*_MMG5_ALPHAD > 0.5 )  return(0);
+
+    /* Prevent swap of an external boundary edge */
+    if ( !adj )  return(0);
+
+    assert(npol == (*ilist)); // du coup, apres on pourra virer npol
+
+    /* Find a configuration that enhances the worst quality within the shell */
+    for (k=0; k<npol; k++) {
+        iel = pol[k] / 4;
+        ip  = pol[k] % 4;
+        np  = mesh->tetra[iel].v[ip];
+        calnew = 1.0;
+        ier = 1;
+
+        if ( mesh->info.fem ) {
+            p0 = &mesh->point[np];
+            if ( p0->tag & MG_BDY ) {
+                for (l=0; l<npol;l++) {
+                    if ( k < npol-1 ) {
+                        if ( l == k || l == k+1 )  continue;
+                    }
+                    else {
+                        if ( l == npol-1 || l == 0 )  continue;
+                    }
+                    iel = pol[l] / 4;
+                    ip  = pol[l] % 4;
+                    pt = &mesh->tetra[iel];
+                    p0 = &mesh->point[pt->v[ip]];
+                    if ( p0->tag & MG_BDY ) {
+                        ier = 0;
+                        break;
+                    }
+                }
+            }
+            if ( !ier )  continue;
+            ier = 1;
+        }
+
+#if _MMG5_TBATCH
+        b.n = 0;
+#endif
+        for (l=0; l<(*ilist); l++) {
+            /* Do not consider tets of the shell of collapsed edge */
+            if ( k < npol-1 ) {
+                if ( l == k || l == k+1 )  continue;
+            }
+            else {
+                if ( l == npol-1 || l == 0 )  continue;
+            }
+            iel = list[l] / 6;
+            i   = list[l] % 6;
+            pt  = &mesh->tetra[iel];
+
+#if _MMG5_TBATCH
+            /* First and second tetra obtained from iel */
+            for (j=0; j<4; j++)  c[j] = mesh->point[pt->v[j]].c;
+            c[_MMG5_iare[i][0]] = mesh->point[np].c;
+            _MMG5_BATCH_TET(&b,c[0],c[1],c[2],c[3]);
+            c[_MMG5_iare[i][0]] = mesh->point[pt->v[_MMG5_iare[i][0]]].c;
+            c[_MMG5_iare[i][1]] = mesh->point[np].c;
+            _MMG5_BATCH_TET(&b,c[0],c[1],c[2],c[3]);
+
+            if ( b.n > _MMG5_BATCH-2 ) {
+                _MMG5_batchCaltet(&b,qual);
+                for (j=0; j<b.n; j++)  calnew = MG_MIN(calnew,qual[j]);
+                b.n = 0;
+                ier = (calnew > crit*calold);
+                if ( !ier )  break;
+            }
+#else
+            /* First and second tetra obtained from iel */
+            memcpy(v,pt->v,4*sizeof(MMG5_int));
+            v[_MMG5_iare[i][0]] = np;
+            calnew = MG_MIN(calnew,_MMG5_TCALTET(mesh,met,v[0],v[1],v[2],v[3]));
+            v[_MMG5_iare[i][0]] = pt->v[_MMG5_iare[i][0]];
+            v[_MMG5_iare[i][1]] = np;
+            calnew = MG_MIN(calnew,_MMG5_TCALTET(mesh,met,v[0],v[1],v[2],v[3]));
+            ier = (calnew > crit*calold);
+            if ( !ier )  break;
+#endif
+        }
+#if _MMG5_TBATCH
+        if ( ier && b.n ) {
+            _MMG5_batchCaltet(&b,qual);
+            for (j=0; j<b.n; j++)  calnew = MG_MIN(calnew,qual[j]);
+            ier = (calnew > crit*calold);
+        }
+#endif
+        if ( ier )  return(pol[k]);
+    }
+    return(0);
+}
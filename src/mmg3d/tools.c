@@ -35,8 +35,6 @@
 
 #include "mmg3d.h"
 
-extern char ddb;
-
 /** naive (increasing) sorting algorithm, for very small tabs ; permutation is stored in perm */
 inline void _MMG5_nsort(int n,double *val,char *perm){
     int   i,j,aux;
@@ -117,7 +115,7 @@ inline double _MMG5_det4pt(double c0[3],double c1[3],double c2[3],double c3[3])
 }
 
 /** Compute oriented volume of a tetrahedron */
-inline double _MMG5_orvol(MMG5_pPoint point,int *v) {
+inline double _MMG5_orvol(MMG5_pPoint point,MMG5_int *v) {
     MMG5_pPoint  p0,p1,p2,p3;
 
     p0 = &point[v[0]];
@@ -129,7 +127,7 @@ inline double _MMG5_orvol(MMG5_pPoint point,int *v) {
 }
 
 /** Compute normal to face iface of tetra k, exterior to tetra k */
-inline int _MMG5_norface(MMG5_pMesh mesh,int k,int iface,double n[3]) {
+inline int _MMG5_norface(MMG5_pMesh mesh,MMG5_int k,int iface,double n[3]) {
     MMG5_pTetra     pt;
     MMG5_pPoint     p0,p1,p2;
     double     ux,uy,uz,vx,vy,vz,norm;
@@ -161,7 +159,7 @@ inline int _MMG5_norface(MMG5_pMesh mesh,int k,int iface,double n[3]) {
 }
 
 /** compute face normal */
-inline int _MMG5_norpts(MMG5_pMesh mesh,int ip1,int ip2, int ip3,double *n) {
+inline int _MMG5_norpts(MMG5_pMesh mesh,MMG5_int ip1,MMG5_int ip2, MMG5_int ip3,double *n) {
     MMG5_pPoint   p1,p2,p3;
     double   dd,abx,aby,abz,acx,acy,acz,det;
 
@@ -287,8 +285,9 @@ inline int _MMG5_eigensym(double m[3],double lambda[2],double vp[2][2]) {
 /** If need be, invert the travelling sense of surfacic ball so that it is travelled in
     the direct sense with respect to direction n anchored at point ip (ip = global num.):
     return 2 = orientation reversed, 1 otherwise */
-inline int _MMG5_directsurfball(MMG5_pMesh mesh, int ip, int *list, int ilist, double n[3]){
-    int             j,aux,iel;
+inline int _MMG5_directsurfball(MMG5_pMesh mesh, MMG5_int ip, MMG5_int *list, int ilist, double n[3]){
+    MMG5_int        aux,iel;
+    int             j;
     double          nt[3],ps;
     unsigned char   iface;
 
@@ -311,9 +310,10 @@ inline int _MMG5_directsurfball(MMG5_pMesh mesh, int ip, int *list, int ilist, d
 /** If need be, reorder the surfacic ball of point ip, so that its first element has
     edge (p,q) (nump,q = global num) as edge _MMG5_iprv2[ip] of face iface.
     return 2 = orientation reversed, 1 otherwise */
-int _MMG5_startedgsurfball(MMG5_pMesh mesh,int nump,int numq,int *list,int ilist) {
+int _MMG5_startedgsurfball(MMG5_pMesh mesh,MMG5_int nump,MMG5_int numq,MMG5_int *list,int ilist) {
     MMG5_pTetra          pt;
-    int             iel,tmp,l;
+    MMG5_int        iel,tmp;
+    int             l;
     unsigned char   iface,ip,ipt;
 
     iel = list[0]/4;
@@ -348,7 +348,7 @@ int _MMG5_startedgsurfball(MMG5_pMesh mesh,int nump,int numq,int *list,int ilist
 
 /** Compute point located at parameter value step from point ip0, as well as interpolate
     of normals, tangent for a RIDGE edge */
-inline int _MMG5_BezierRidge(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,double *no1,double *no2,double *to){
+inline int _MMG5_BezierRidge(MMG5_pMesh mesh,MMG5_int ip0,MMG5_int ip1,double s,double *o,double *no1,double *no2,double *to){
     MMG5_pPoint    p0,p1;
     double    ux,uy,uz,n01[3],n02[3],n11[3],n12[3],t0[3],t1[3];
     double    ps,ps2,b0[3],b1[3],bn[3],ll,il,ntemp[3],dd,alpha;
@@ -512,7 +512,7 @@ inline int _MMG5_BezierRidge(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,
 
 /** Compute point located at parameter value step from point ip0, as well as interpolate
     of normals, tangent for a REF edge */
-inline int _MMG5_BezierRef(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,double *no,double *to) {
+inline int _MMG5_BezierRef(MMG5_pMesh mesh,MMG5_int ip0,MMG5_int ip1,double s,double *o,double *no,double *to) {
     MMG5_pPoint          p0,p1;
     double          ux,uy,uz,n01[3],n02[3],n11[3],n12[3],ntemp[3],t0[3],t1[3];
     double          ps,b0[3],b1[3],bn[3],ll,il,dd,alpha,ps2;
@@ -667,7 +667,7 @@ inline int _MMG5_BezierRef(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,do
 
 /** Compute point located at parameter value step from point ip0, as well as interpolate
     of normals, tangent for a NOM edge */
-inline int _MMG5_BezierNom(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,double *no,double *to) {
+inline int _MMG5_BezierNom(MMG5_pMesh mesh,MMG5_int ip0,MMG5_int ip1,double s,double *o,double *no,double *to) {
     MMG5_pPoint      p0,p1;
     double      ux,uy,uz,il,ll,ps,alpha,dd;
     double      t0[3],t1[3],b0[3],b1[3],n0[3],n1[3],bn[3];
@@ -809,7 +809,7 @@ inline int _MMG5_BezierNom(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,do
 
 /** Compute point located at parameter value step from point ip0, as well as interpolate
     of normals, tangent for a regular edge ; v = ref vector (normal) for choice of normals if need be */
-inline int _MMG5_BezierReg(MMG5_pMesh mesh,int ip0, int ip1, double s, double v[3], double *o, double *no){
+inline int _MMG5_BezierReg(MMG5_pMesh mesh,MMG5_int ip0, MMG5_int ip1, double s, double v[3], double *o, double *no){
     MMG5_pPoint p0,p1;
     double b0[3],b1[3],bn[3],t0[3],t1[3],np0[3],np1[3],alpha,ux,uy,uz,ps1,ps2,ll,il,dd,*n1,*n2;
 
@@ -975,7 +975,8 @@ int _MMG5_DoSol(MMG5_pMesh mesh,MMG5_pSol met) {
     MMG5_pTetra     pt;
     MMG5_pPoint     p1,p2;
     double     ux,uy,uz,dd;
-    int        i,k,ia,ib,ipa,ipb;
+    MMG5_int   k,ipa,ipb;
+    int        i,ia,ib;
     int       *mark;
 
     _MMG5_SAFE_CALLOC(mark,mesh->np+1,int);
@@ -1030,9 +1031,9 @@ int _MMG5_DoSol(MMG5_pMesh mesh,MMG5_pSol met) {
 }
 
 /** find the element number in packed numerotation */
-int _MMG5_indElt(MMG5_pMesh mesh, int kel) {
+MMG5_int _MMG5_indElt(MMG5_pMesh mesh, MMG5_int kel) {
     MMG5_pTetra pt;
-    int    ne, k;
+    MMG5_int ne, k;
 
     ne = 0;
     for (k=1; k<=mesh->ne; k++) {
@@ -1046,9 +1047,9 @@ int _MMG5_indElt(MMG5_pMesh mesh, int kel) {
 }
 
 /** find the point number in packed numerotation */
-int _MMG5_indPt(MMG5_pMesh mesh, int kp) {
+MMG5_int _MMG5_indPt(MMG5_pMesh mesh, MMG5_int kp) {
     MMG5_pPoint ppt;
-    int    np, k;
+    MMG5_int np, k;
 
     np = 0;
     for (k=1; k<=mesh->ne; k++) {
@@ -1064,15 +1065,15 @@ int _MMG5_indPt(MMG5_pMesh mesh, int kp) {
 /** Debug function (not use in clean code): print mesh->tria structure */
 void _MMG5_printTria(MMG5_pMesh mesh,char* fileName) {
     MMG5_pTria ptt;
-    int   k;
+    MMG5_int k;
     FILE  *inm;
 
     inm = fopen(fileName,"w");
 
-    fprintf(inm,"----------> %d TRIANGLES <----------\n",mesh->nt);
+    fprintf(inm,"----------> %" MMG5_PRId " TRIANGLES <----------\n",mesh->nt);
     for(k=1; k<=mesh->nt; k++) {
         ptt = &mesh->tria[k];
-        fprintf(inm,"num %d -> %d %d %d\n",k,ptt->v[0],ptt->v[1],
+        fprintf(inm,"num %" MMG5_PRId " -> %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,ptt->v[0],ptt->v[1],
                 ptt->v[2]);
         fprintf(inm,"ref   -> %d\n",ptt->ref);
         fprintf(inm,"tag   -> %d %d %d\n",ptt->tag[0],ptt->tag[1],ptt->tag[2]);
@@ -1087,17 +1088,17 @@ void _MMG5_printTria(MMG5_pMesh mesh,char* fileName) {
 void _MMG5_printTetra(MMG5_pMesh mesh,char* fileName) {
     MMG5_pTetra  pt;
     MMG5_pxTetra pxt;
-    int     k;
+    MMG5_int k;
     FILE    *inm;
 
     inm = fopen(fileName,"w");
 
-    fprintf(inm,"----------> %d _MMG5_TETRAHEDRAS <----------\n",mesh->ne);
+    fprintf(inm,"----------> %" MMG5_PRId " _MMG5_TETRAHEDRAS <----------\n",mesh->ne);
     for(k=1; k<=mesh->ne; k++) {
         pt = &mesh->tetra[k];
-        fprintf(inm,"num %d -> %d %d %d %d\n",k,pt->v[0],pt->v[1],
+        fprintf(inm,"num %" MMG5_PRId " -> %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId " %" MMG5_PRId "\n",k,pt->v[0],pt->v[1],
                 pt->v[2],pt->v[3]);
-        fprintf(inm,"ref,tag,xt  -> %d %d %d\n",pt->ref,pt->tag,pt->xt);
+        fprintf(inm,"ref,tag,xt  -> %d %d %" MMG5_PRId "\n",pt->ref,pt->tag,pt->xt);
         if ( pt->xt ) {
             pxt = &mesh->xtetra[pt->xt];
             fprintf(inm,"tag   -> %d %d %d %d %d %d\n",pxt->tag[0],pxt->tag[1],
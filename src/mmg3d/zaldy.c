@@ -36,9 +36,9 @@
 #include "mmg3d.h"
 
 /** get new point address */
-int _MMG5_newPt(MMG5_pMesh mesh,double c[3],char tag) {
+MMG5_int _MMG5_newPt(MMG5_pMesh mesh,double c[3],char tag) {
     MMG5_pPoint  ppt;
-    int     curpt;
+    MMG5_int curpt;
 
     if ( !mesh->npnil )  return(0);
     curpt = mesh->npnil;
@@ -69,7 +69,7 @@ int _MMG5_newPt(MMG5_pMesh mesh,double c[3],char tag) {
     return(curpt);
 }
 
-void _MMG5_delPt(MMG5_pMesh mesh,int ip) {
+void _MMG5_delPt(MMG5_pMesh mesh,MMG5_int ip) {
     MMG5_pPoint   ppt;
     MMG5_xPoint  *pxp;
 
@@ -88,8 +88,8 @@ void _MMG5_delPt(MMG5_pMesh mesh,int ip) {
 }
 
 /** get new elt address */
-int _MMG5_newElt(MMG5_pMesh mesh) {
-    int     curiel;
+MMG5_int _MMG5_newElt(MMG5_pMesh mesh) {
+    MMG5_int curiel;
 
     if ( !mesh->nenil )  return(0);
     curiel = mesh->nenil;
@@ -103,20 +103,20 @@ int _MMG5_newElt(MMG5_pMesh mesh) {
 }
 
 
-void _MMG5_delElt(MMG5_pMesh mesh,int iel) {
+void _MMG5_delElt(MMG5_pMesh mesh,MMG5_int iel) {
     MMG5_pTetra   pt;
-    int      iadr;
+    MMG5_int iadr;
 
     pt = &mesh->tetra[iel];
     if ( !MG_EOK(pt) ) {
-        fprintf(stdout,"  ## INVALID ELEMENT %d.\n",iel);
+        fprintf(stdout,"  ## INVALID ELEMENT %" MMG5_PRId ".\n",iel);
         exit(EXIT_FAILURE);
     }
     memset(pt,0,sizeof(MMG5_Tetra));
     pt->v[3] = mesh->nenil;
     iadr = 4*(iel-1) + 1;
     if ( mesh->adja )
-        memset(&mesh->adja[iadr],0,4*sizeof(int));
+        memset(&mesh->adja[iadr],0,4*sizeof(MMG5_int));
     mesh->nenil = iel;
     if ( iel == mesh->ne ) {
         while ( !MG_EOK((&mesh->tetra[mesh->ne])) )  mesh->ne--;
@@ -146,7 +146,8 @@ long long _MMG5_memSize (void) {
 /** memory repartition for the -m option */
 void _MMG5_memOption(MMG5_pMesh mesh) {
     long long  million = 1048576L;
-    int        ctri,npask,bytes,memtmp;
+    MMG5_int   npask,memtmp;
+    int        ctri,bytes;
 
     mesh->memMax = _MMG5_memSize();
 
@@ -182,7 +183,7 @@ void _MMG5_memOption(MMG5_pMesh mesh) {
          * warning: we exceed memory in saveMesh when we call _MMG5_hNew */
         bytes = sizeof(MMG5_Point) + sizeof(MMG5_xPoint) +
             6*sizeof(MMG5_Tetra) + ctri*sizeof(MMG5_xTetra) +
-            4*6*sizeof(int) + ctri*3*sizeof(int) +
+            4*6*sizeof(MMG5_int) + ctri*3*sizeof(MMG5_int) +
             sizeof(MMG5_Sol)+4*sizeof(_MMG5_hedge);
 #ifdef USE_SCOTCH
         /* bytes = bytes + vertTab + edgeTab + PermVrtTab *
@@ -203,7 +204,7 @@ void _MMG5_memOption(MMG5_pMesh mesh) {
             memtmp = MG_MAX(memtmp, mesh->ne * bytes /(6*(int)million) + 38);
             mesh->memMax = (long long) memtmp+1;
             fprintf(stdout,"  ## ERROR: asking for %d Mo of memory ",mesh->info.mem);
-            fprintf(stdout,"is not enough to load mesh. You need to ask %d Mo minimum\n",
+            fprintf(stdout,"is not enough to load mesh. You need to ask %" MMG5_PRId " Mo minimum\n",
                     memtmp+1);
         }
         if(mesh->info.mem < 39) {
@@ -219,9 +220,9 @@ void _MMG5_memOption(MMG5_pMesh mesh) {
                 mesh->memMax/million);
 
     if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug ) {
-        fprintf(stdout,"  _MMG5_NPMAX    %d\n",mesh->npmax);
-        fprintf(stdout,"  _MMG5_NTMAX    %d\n",mesh->ntmax);
-        fprintf(stdout,"  _MMG5_NEMAX    %d\n",mesh->nemax);
+        fprintf(stdout,"  _MMG5_NPMAX    %" MMG5_PRId "\n",mesh->npmax);
+        fprintf(stdout,"  _MMG5_NTMAX    %" MMG5_PRId "\n",mesh->ntmax);
+        fprintf(stdout,"  _MMG5_NEMAX    %" MMG5_PRId "\n",mesh->nemax);
     }
 
     return;
@@ -229,7 +230,7 @@ void _MMG5_memOption(MMG5_pMesh mesh) {
 
 /** allocate main structure */
 int _MMG5_zaldy(MMG5_pMesh mesh) {
-    int     k;
+    MMG5_int k;
 
     _MMG5_memOption(mesh);
 
@@ -266,6 +267,99 @@ int _MMG5_zaldy(MMG5_pMesh mesh) {
     return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 1.
+ *
+ * Enlarge the point, metric, tetra and adjacency tables to the final sizes
+ * predicted by \ref _MMG5_countelt (plus a _MMG5_PRESIZE margin) so that the
+ * adaptation loops do not have to reallocate them. The tables are kept as is
+ * if the prediction is smaller than their current size or does not fit in
+ * the authorized memory. The new entities are linked at the tail of the
+ * lists of the empty points and tetra, so the holes of the tables are still
+ * reused first (the last slot of the previous table is left out of the list,
+ * it may already be its tail).
+ *
+ */
+int _MMG5_presize(MMG5_pMesh mesh,MMG5_pSol met) {
+    long long bytes;
+    MMG5_int  np,ne,k,k0;
+    int       msiz;
+
+    if ( !_MMG5_countelt(mesh,met,NULL,&np,&ne) )  return(1);
+
+    np   = MG_MAX(mesh->npmax,(MMG5_int)(_MMG5_PRESIZE*np));
+    ne   = MG_MAX(mesh->nemax,(MMG5_int)(_MMG5_PRESIZE*ne));
+    msiz = met->m ? met->size : 0;
+    if ( np == mesh->npmax && ne == mesh->nemax )  return(1);
+
+    bytes  = (long long)(np-mesh->npmax)*(sizeof(MMG5_Point)+msiz*sizeof(double));
+    bytes += (long long)(ne-mesh->nemax)*
+        (sizeof(MMG5_Tetra)+(mesh->adja ? 4*sizeof(MMG5_int) : 0));
+    if ( mesh->memCur + bytes > mesh->memMax ) {
+        if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+            fprintf(stdout,"     not enough memory to preallocate the tables\n");
+        return(1);
+    }
+
+    chrono(ON,&mesh->ctrealloc);
+    if ( np > mesh->npmax ) {
+        _MMG5_ADD_MEM(mesh,(np-mesh->npmax)*sizeof(MMG5_Point),"points",return(1));
+        _MMG5_SAFE_RECALLOC(mesh->point,mesh->npmax+1,np+1,MMG5_Point,"points");
+
+        /* link the new points at the tail of the list of the empty points */
+        k0 = mesh->npmax+1;
+        mesh->npmax = np;
+        if ( k0 < mesh->npmax-1 ) {
+            for (k=k0; k<mesh->npmax-1; k++)
+                mesh->point[k].tmp  = k+1;
+            if ( !mesh->npnil )
+                mesh->npnil = k0;
+            else {
+                for (k=mesh->npnil; mesh->point[k].tmp; k=mesh->point[k].tmp) ;
+                mesh->point[k].tmp = k0;
+            }
+        }
+
+        if ( met->m ) {
+            _MMG5_ADD_MEM(mesh,msiz*(np-met->npmax)*sizeof(double),"metric",return(1));
+            _MMG5_SAFE_REALLOC(met->m,msiz*np+1,double,"metric");
+        }
+        met->npmax = np;
+    }
+    if ( ne > mesh->nemax ) {
+        _MMG5_ADD_MEM(mesh,(ne-mesh->nemax)*sizeof(MMG5_Tetra),"tetrahedra",return(1));
+        _MMG5_SAFE_RECALLOC(mesh->tetra,mesh->nemax+1,ne+1,MMG5_Tetra,"tetrahedra");
+        if ( mesh->adja ) {
+            _MMG5_ADD_MEM(mesh,4*(ne-mesh->nemax)*sizeof(MMG5_int),"adjacency",
+                          return(1));
+            _MMG5_SAFE_RECALLOC(mesh->adja,4*mesh->ne+5,4*ne+5,MMG5_int,"adjacency");
+        }
+
+        /* link the new tetra at the tail of the list of the empty tetra */
+        k0 = mesh->nemax+1;
+        mesh->nemax = ne;
+        if ( k0 < mesh->nemax-1 ) {
+            for (k=k0; k<mesh->nemax-1; k++)
+                mesh->tetra[k].v[3] = k+1;
+            if ( !mesh->nenil )
+                mesh->nenil = k0;
+            else {
+                for (k=mesh->nenil; mesh->tetra[k].v[3]; k=mesh->tetra[k].v[3]) ;
+                mesh->tetra[k].v[3] = k0;
+            }
+        }
+    }
+    chrono(OFF,&mesh->ctrealloc);
+
+    if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug ) {
+        fprintf(stdout,"  _MMG5_NPMAX    %" MMG5_PRId "\n",mesh->npmax);
+        fprintf(stdout,"  _MMG5_NEMAX    %" MMG5_PRId "\n",mesh->nemax);
+    }
+    return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  *
@@ -274,7 +368,7 @@ int _MMG5_zaldy(MMG5_pMesh mesh) {
  */
 void _MMG5_freeXTets(MMG5_pMesh mesh) {
     MMG5_pTetra pt;
-    int    k;
+    MMG5_int k;
 
     for (k=1; k<=mesh->ne; k++) {
         pt     = &mesh->tetra[k];
@@ -34,6 +34,7 @@
  */
 
 #include "mmgs.h"
+#include "metric_kernels.h"
 #include <math.h>
 
 extern Info   info;
@@ -43,20 +44,7 @@ extern Info   info;
 
 /* Compute length of edge [ip1 ip2] according to the prescribed size */
 double lenedg_iso(pMesh mesh,pSol met,int ip1,int ip2,char isedg) {
-    pPoint   p1,p2;
-    double   h1,h2,r,l,len;
-
-    p1 = &mesh->point[ip1];
-    p2 = &mesh->point[ip2];
-    l = (p2->c[0]-p1->c[0])*(p2->c[0]-p1->c[0]) + (p2->c[1]-p1->c[1])*(p2->c[1]-p1->c[1]) \
-        + (p2->c[2]-p1->c[2])*(p2->c[2]-p1->c[2]);
-    l  = sqrt(l);
-    h1 = met->m[ip1];
-    h2 = met->m[ip2];
-    r  = h2 / h1 - 1.0;
-    len = fabs(r) < EPS ? l / h1 : l / (h2-h1) * log(r+1.0);
-
-    return(len);
+    return(lenedg_iso_inl(mesh,met,ip1,ip2,isedg));
 }
 
 /* Define isotropic size map at all vertices of the mesh, associated with geometric approx ;
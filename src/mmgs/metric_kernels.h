@@ -0,0 +1,80 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmgs/metric_kernels.h
+ * \brief Inlined metric kernels and instantiation of the remeshing drivers.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The \a lenedg, \a intmet, \a movintpt and \a movridpt pointers select the
+ * iso or anisotropic functions at runtime. The hot drivers are rather
+ * written once in a template file, included after the definition of
+ * \a MS_TMET to \a iso or \a ani: \a MS_TNAME names the instance and the
+ * other macros call the functions of this metric type directly (the
+ * isotropic length being inlined).
+ */
+
+#ifndef _METRIC_KERNELS_H
+#define _METRIC_KERNELS_H
+
+#define MS_TCAT2(a,b)    a##_##b
+#define MS_TCAT3(a,b,c)  a##_##b##_##c
+#define MS_TXCAT2(a,b)   MS_TCAT2(a,b)
+#define MS_TXCAT3(a,b,c) MS_TCAT3(a,b,c)
+
+/* instance of the function f for the metric MS_TMET */
+#define MS_TNAME(f)  MS_TXCAT2(f,MS_TMET)
+
+/* functions of the metric MS_TMET */
+#define MS_TLENEDG(mesh,met,ip1,ip2,isedg)                              \
+    (MS_TXCAT3(lenedg,MS_TMET,inl)((mesh),(met),(ip1),(ip2),(isedg)))
+#define MS_TINTMET    MS_TXCAT2(intmet,MS_TMET)
+#define MS_TMOVINTPT  MS_TXCAT2(movintpt,MS_TMET)
+#define MS_TMOVRIDPT  MS_TXCAT2(movridpt,MS_TMET)
+
+/* Compute length of edge [ip1 ip2] according to the prescribed size */
+static inline double lenedg_iso_inl(pMesh mesh,pSol met,int ip1,int ip2,char isedg) {
+    pPoint   p1,p2;
+    double   h1,h2,r,l,len;
+
+    p1 = &mesh->point[ip1];
+    p2 = &mesh->point[ip2];
+    l = (p2->c[0]-p1->c[0])*(p2->c[0]-p1->c[0]) + (p2->c[1]-p1->c[1])*(p2->c[1]-p1->c[1]) \
+        + (p2->c[2]-p1->c[2])*(p2->c[2]-p1->c[2]);
+    l  = sqrt(l);
+    h1 = met->m[ip1];
+    h2 = met->m[ip2];
+    r  = h2 / h1 - 1.0;
+    len = fabs(r) < EPS ? l / h1 : l / (h2-h1) * log(r+1.0);
+
+    return(len);
+}
+
+/* Compute length of edge [ip1 ip2] according to the prescribed metric (the
+   ridge metrics make the kernel too large to be inlined) */
+static inline double lenedg_ani_inl(pMesh mesh,pSol met,int ip1,int ip2,char isedg) {
+    return(lenedg_ani(mesh,met,ip1,ip2,isedg));
+}
+
+#endif
@@ -0,0 +1,292 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmgs/mmgs1_tpl.h
+ * \brief Drivers of mmgs1.c, instantiated for each metric type.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * This file is included by mmgs1.c after the definition of \a MS_TMET (see
+ * metric_kernels.h).
+ */
+
+/* Analyze triangles and move points to make mesh more uniform */
+static int MS_TNAME(movtri)(pMesh mesh,pSol met,int maxit) {
+    pTria    pt;
+    pPoint   ppt;
+    int      it,k,ier,base,nm,ns,nnm,list[LMAX+2],ilist;
+    char     i;
+
+    if ( abs(info.imprim) > 5 || info.ddebug )
+        fprintf(stdout,"  ** OPTIMIZING MESH\n");
+
+    base = 1;
+    for (k=1; k<=mesh->np; k++)  mesh->point[k].flag = base;
+
+    it = nnm = 0;
+    do {
+        base++;
+        nm = ns = 0;
+        for (k=1; k<=mesh->nt; k++) {
+            pt = &mesh->tria[k];
+            if ( !MS_EOK(pt) || pt->ref < 0 )   continue;
+
+            for (i=0; i<3; i++) {
+                ppt = &mesh->point[pt->v[i]];
+
+                if ( ppt->flag == base || MS_SIN(ppt->tag) || ppt->tag & MS_NOM )
+                    continue;
+                ier = 0;
+                ilist = boulet(mesh,k,i,list);
+
+                if ( MS_EDG(ppt->tag) ) {
+                    ier = MS_TMOVRIDPT(mesh,met,list,ilist);
+                    if ( ier )  ns++;
+                }
+                else
+                    ier = MS_TMOVINTPT(mesh,met,list,ilist);
+                if ( ier ) {
+                    nm++;
+                    ppt->flag = base;
+                }
+            }
+        }
+        nnm += nm;
+        if ( info.ddebug )  fprintf(stdout,"     %8d moved, %d geometry\n",nm,ns);
+    }
+    while ( ++it < maxit && nm > 0);
+
+    if ( (abs(info.imprim) > 5 || info.ddebug) && nnm > 0 )
+        fprintf(stdout,"     %8d vertices moved, %d iter.\n",nnm,it);
+
+    return(nnm);
+}
+
+/* analyze triangles and split if needed */
+static int MS_TNAME(anaelt)(pMesh mesh,pSol met,char typchk) {
+    pTria    pt;
+    pPoint   ppt,p1,p2;
+    Hash     hash;
+    Bezier   pb;
+    pGeom    go;
+    double   s,o[3],no[3],to[3],dd,len;
+    int      vx[3],i,j,ip,ip1,ip2,ier,k,ns,nc,nt;
+    char     i1,i2;
+    static double uv[3][2] = { {0.5,0.5}, {0.,0.5}, {0.5,0.} };
+
+    hashNew(&hash,mesh->np);
+    ns = 0;
+    s  = 0.5;
+    for (k=1; k<=mesh->nt; k++) {
+        pt = &mesh->tria[k];
+        if ( !MS_EOK(pt) || pt->ref < 0 )  continue;
+        if ( MS_SIN(pt->tag[0]) || MS_SIN(pt->tag[1]) || MS_SIN(pt->tag[2]) )  continue;
+
+        /* check element cut */
+        pt->flag = 0;
+        if ( typchk == 1 ) {
+            if ( !chkedg(mesh,k) )  continue;
+        }
+        else if ( typchk == 2 ) {
+            for (i=0; i<3; i++) {
+                i1 = inxt[i];
+                i2 = iprv[i];
+                len = MS_TLENEDG(mesh,met,pt->v[i1],pt->v[i2],0);
+                if ( len > LLONG )  MS_SET(pt->flag,i);
+            }
+            if ( !pt->flag )  continue;
+        }
+        ns++;
+
+        /* geometric support */
+        ier = bezierCP(mesh,k,&pb);
+        assert(ier);
+        if ( !ier )  continue;
+
+        /* scan edges to split */
+        for (i=0; i<3; i++) {
+            if ( !MS_GET(pt->flag,i) )  continue;
+            i1  = inxt[i];
+            i2  = iprv[i];
+            ip1 = pt->v[i1];
+            ip2 = pt->v[i2];
+            ip = hashGet(&hash,ip1,ip2);
+            if ( !MS_EDG(pt->tag[i]) && ip > 0 )  continue;
+
+            /* new point along edge */
+            bezierInt(&pb,uv[i],o,no,to);
+            if ( !ip ) {
+                ip = newPt(mesh,o,MS_EDG(pt->tag[i]) ? to : no);
+                assert(ip);
+                hashEdge(&hash,ip1,ip2,ip);
+                p1  = &mesh->point[ip1];
+                p2  = &mesh->point[ip2];
+                ppt = &mesh->point[ip];
+
+                if ( MS_EDG(pt->tag[i]) ) {
+                    ++mesh->ng;
+                    assert(mesh->ng < mesh->ngmax);
+                    ppt->tag = pt->tag[i];
+                    if ( p1->ref == pt->edg[i] || p2->ref == pt->edg[i] )
+                        ppt->ref = pt->edg[i];
+                    ppt->ig  = mesh->ng;
+                    go = &mesh->geom[mesh->ng];
+                    memcpy(go->n1,no,3*sizeof(double));
+
+                    dd = go->n1[0]*ppt->n[0] + go->n1[1]*ppt->n[1] + go->n1[2]*ppt->n[2];
+                    ppt->n[0] -= dd*go->n1[0];
+                    ppt->n[1] -= dd*go->n1[1];
+                    ppt->n[2] -= dd*go->n1[2];
+                    dd = ppt->n[0]*ppt->n[0] + ppt->n[1]*ppt->n[1] + ppt->n[2]*ppt->n[2];
+                    if ( dd > EPSD2 ) {
+                        dd = 1.0 / sqrt(dd);
+                        ppt->n[0] *= dd;
+                        ppt->n[1] *= dd;
+                        ppt->n[2] *= dd;
+                    }
+                }
+                if ( met->m ) {
+                    if ( typchk == 1 )
+                        intmet33(mesh,met,ip1,ip2,ip,s);
+                    else
+                        MS_TINTMET(mesh,met,k,i,ip,s);
+                }
+            }
+            else if ( pt->tag[i] & MS_GEO ) {
+                ppt = &mesh->point[ip];
+                go  = &mesh->geom[ppt->ig];
+                memcpy(go->n2,no,3*sizeof(double));
+
+                /* a computation of the tangent with respect to these two normals is possible */
+                ppt->n[0] = go->n1[1]*go->n2[2] - go->n1[2]*go->n2[1];
+                ppt->n[1] = go->n1[2]*go->n2[0] - go->n1[0]*go->n2[2];
+                ppt->n[2] = go->n1[0]*go->n2[1] - go->n1[1]*go->n2[0];
+                dd = ppt->n[0]*ppt->n[0] + ppt->n[1]*ppt->n[1] + ppt->n[2]*ppt->n[2];
+                if ( dd > EPSD2 ) {
+                    dd = 1.0 / sqrt(dd);
+                    ppt->n[0] *= dd;
+                    ppt->n[1] *= dd;
+                    ppt->n[2] *= dd;
+                }
+            }
+        }
+    }
+    if ( !ns ) {
+        free(hash.item);
+        return(ns);
+    }
+
+    /* step 2. checking if split by adjacent */
+    for (k=1; k<=mesh->nt; k++) {
+        pt = &mesh->tria[k];
+        if ( !MS_EOK(pt) || pt->ref < 0 )  continue;
+        else if ( pt->flag == 7 )  continue;
+
+        /* geometric support */
+        ier = bezierCP(mesh,k,&pb);
+        assert(ier);
+        if ( !ier )  continue;
+        nc = 0;
+
+        for (i=0; i<3; i++) {
+            i1 = inxt[i];
+            i2 = inxt[i1];
+            if ( !MS_GET(pt->flag,i) && !MS_SIN(pt->tag[i]) ) {
+                ip = hashGet(&hash,pt->v[i1],pt->v[i2]);
+                if ( ip > 0 ) {
+                    MS_SET(pt->flag,i);
+                    nc++;
+                    if ( pt->tag[i] & MS_GEO ) {
+                        /* new point along edge */
+                        ier = bezierInt(&pb,uv[i],o,no,to);
+                        assert(ier);
+                        if ( !ier )  continue;
+
+                        ppt = &mesh->point[ip];
+                        go  = &mesh->geom[ppt->ig];
+                        memcpy(go->n2,no,3*sizeof(double));
+
+                        /* a computation of the tangent with respect to these two normals is possible */
+                        ppt->n[0] = go->n1[1]*go->n2[2] - go->n1[2]*go->n2[1];
+                        ppt->n[1] = go->n1[2]*go->n2[0] - go->n1[0]*go->n2[2];
+                        ppt->n[2] = go->n1[0]*go->n2[1] - go->n1[1]*go->n2[0];
+                        dd = ppt->n[0]*ppt->n[0] + ppt->n[1]*ppt->n[1] + ppt->n[2]*ppt->n[2];
+                        if ( dd > EPSD2 ) {
+                            dd = 1.0 / sqrt(dd);
+                            ppt->n[0] *= dd;
+                            ppt->n[1] *= dd;
+                            ppt->n[2] *= dd;
+                        }
+                    }
+                }
+            }
+        }
+        if ( nc > 0 )  ++ns;
+    }
+    if ( info.ddebug && ns ) {
+        fprintf(stdout,"     %d analyzed  %d proposed\n",mesh->nt,ns);
+        fflush(stdout);
+    }
+
+    /* step 3. splitting */
+    ns = 0;
+    nt = mesh->nt;
+    for (k=1; k<=nt; k++) {
+        pt = &mesh->tria[k];
+        if ( !MS_EOK(pt) || pt->ref < 0 )  continue;
+        else if ( pt->flag == 0 )  continue;
+
+        j  = -1;
+        vx[0] = vx[1] = vx[2] = 0;
+        for (i=0; i<3; i++) {
+            i1 = inxt[i];
+            i2 = inxt[i1];
+            if ( MS_GET(pt->flag,i) ) {
+                vx[i] = hashGet(&hash,pt->v[i1],pt->v[i2]);
+                assert(vx[i]);
+                j = i;
+            }
+        }
+        if ( pt->flag == 1 || pt->flag == 2 || pt->flag == 4 ) {
+            ier = split1(mesh,met,k,j,vx);
+            assert(ier);
+            if ( ier )  ns++;
+        }
+        else if ( pt->flag == 7 ) {
+            ier = split3(mesh,met,k,vx);
+            assert(ier);
+            if ( ier )  ns++;
+        }
+        else {
+            ier = split2(mesh,met,k,vx);
+            assert(ier);
+            if ( ier )  ns++;
+        }
+    }
+    if ( (info.ddebug || abs(info.imprim) > 5) && ns > 0 )
+        fprintf(stdout,"     %7d splitted\n",ns);
+    free(hash.item);
+
+    return(ns);
+}